@@ -0,0 +1,65 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2000, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TGeoBVHFinder
+#define ROOT_TGeoBVHFinder
+
+#ifndef ROOT_TGeoVoxelFinder
+#include "TGeoVoxelFinder.h"
+#endif
+
+/*************************************************************************
+ * TGeoBVHFinder - finder class using a bounding volume hierarchy of the
+ *   daughter bounding boxes instead of slices on the three axes
+ *
+ *************************************************************************/
+
+class TGeoBVHFinder : public TGeoVoxelFinder
+{
+protected:
+   Int_t             fNnodes;         // number of nodes in the hierarchy
+   Int_t             fNlimits;        // length of array of node limits (6*fNnodes)
+   Int_t             fNitems;         // length of array of daughter indices
+   Int_t             fDepth;          // depth of the hierarchy
+   Double_t         *fLimits;         //[fNlimits] xmin,xmax,ymin,ymax,zmin,zmax per node
+   Int_t            *fSkip;           //[fNnodes] next node index when the subtree is skipped
+   Int_t            *fFirst;          //[fNnodes] first daughter index in fItems (leaves)
+   Int_t            *fNleaf;          //[fNnodes] number of daughters in leaf, 0 for internal nodes
+   Int_t            *fItems;          //[fNitems] daughter indices ordered by leaf
+
+   Int_t               BuildNode(Int_t first, Int_t n, Int_t depth);
+   void                ClearHierarchy();
+   Int_t               SplitNode(Int_t first, Int_t n, const Double_t *limits);
+   Double_t            SAHCost() const;
+
+private:
+   TGeoBVHFinder(const TGeoBVHFinder&); // Not implemented
+   TGeoBVHFinder& operator=(const TGeoBVHFinder&); // Not implemented
+
+public :
+   TGeoBVHFinder();
+   TGeoBVHFinder(TGeoVolume *vol);
+   virtual ~TGeoBVHFinder();
+
+   virtual Double_t    Efficiency();
+   virtual void        FindOverlaps(Int_t inode) const;
+   virtual Int_t      *GetCheckList(const Double_t *point, Int_t &nelem, TGeoStateInfo &td);
+   virtual Int_t      *GetNextCandidates(const Double_t *point, Int_t &ncheck, TGeoStateInfo &td);
+   Int_t               GetDepth() const {return fDepth;}
+   Int_t               GetNnodes() const {return fNnodes;}
+   virtual Int_t      *GetNextVoxel(const Double_t *point, const Double_t *dir, Int_t &ncheck, TGeoStateInfo &td);
+   virtual void        Print(Option_t *option="") const;
+   virtual void        SortCrossedVoxels(const Double_t *point, const Double_t *dir, TGeoStateInfo &td);
+   virtual void        Voxelize(Option_t *option="");
+
+   ClassDef(TGeoBVHFinder, 1)          // bounding volume hierarchy finder
+};
+
+#endif
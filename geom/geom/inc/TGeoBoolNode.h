@@ -15,6 +15,9 @@
 #ifndef ROOT_TObject
 #include "TObject.h"
 #endif
+#ifndef ROOT_TGeoThreadSlots
+#include "TGeoThreadSlots.h"
+#endif
 
 //////////////////////////////////////////////////////////////////////////////
 //                                                                          //
@@ -60,8 +63,7 @@ protected:
    Int_t             fNpoints;        //! number of points on the mesh
    Double_t         *fPoints;         //! array of mesh points
 
-   mutable std::vector<ThreadData_t*> fThreadData; //! Navigation data per thread
-   mutable Int_t                      fThreadSize; //! Size for the navigation data array
+   mutable TGeoThreadSlots            fThreadData; //! Navigation data per thread
 // methods
    Bool_t            MakeBranch(const char *expr, Bool_t left);
 public:
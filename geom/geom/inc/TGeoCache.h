@@ -45,6 +45,7 @@ protected:
    TGeoNode           **fNodeBranch;    // last node branch stored
    TGeoHMatrix        **fMatrixBranch;  // global matrices for last branch
    TGeoHMatrix        **fMatPtr;        // array of matrix pointers
+   Int_t               *fDivBranch;     // division index of each node of the branch (-1 if not a division cell)
 
    TGeoCacheState(const TGeoCacheState&); 
    TGeoCacheState& operator=(const TGeoCacheState&);
@@ -56,6 +57,12 @@ public:
 
    void                 SetState(Int_t level, Int_t startlevel, Int_t nmany, Bool_t ovlp, Double_t *point=0);
    Bool_t               GetState(Int_t &level, Int_t &nmany, Double_t *point) const;
+   Int_t                GetLevel() const {return fLevel;}
+   TGeoHMatrix         *GetMatrix() const;
+   Int_t                GetNmany() const {return fNmany;}
+   TGeoNode            *GetNode() const {return fNodeBranch[fLevel-fStart];}
+   Int_t                GetDivIndex(Int_t level) const {return fDivBranch[level-fStart];}
+   Bool_t               IsSameBranch(Int_t level, TGeoNode **branch) const;
 
    ClassDef(TGeoCacheState, 0)       // class storing the cache state
 };
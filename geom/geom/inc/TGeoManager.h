@@ -103,12 +103,9 @@ private :
    // Map of navigatorr arrays per thread
    typedef std::map<Long_t, TGeoNavigatorArray *>   NavigatorsMap_t;
    typedef NavigatorsMap_t::iterator                NavigatorsMapIt_t;
-   typedef std::map<Long_t, Int_t>                  ThreadsMap_t;
-   typedef ThreadsMap_t::const_iterator             ThreadsMapIt_t;
    
    NavigatorsMap_t       fNavigators;       //! Map between thread id's and navigator arrays
-   static ThreadsMap_t  *fgThreadId;        //! Thread id's map
-   static Int_t          fgNumThreads;      //! Number of registered threads
+   static Int_t          fgNavigatorsEpoch; //! Incremented each time navigator arrays are deleted
    static Bool_t         fgLockNavigators;   //! Lock existing navigators
    TGeoNavigator        *fCurrentNavigator; //! current navigator
    TGeoVolume           *fCurrentVolume;    //! current volume
@@ -132,9 +129,12 @@ private :
    Int_t                *fKeyPNEId;         //[fSizePNEId] array of uid values for PN entries
    Int_t                *fValuePNEId;       //[fSizePNEId] array of pointers to PN entries with ID's
    Int_t                 fMaxThreads;       //! Max number of threads
+   Int_t                 fNvoxelThreads;    //! Number of threads used to voxelize the geometry
    Bool_t                fMultiThread;      //! Flag for multi-threading
+   Bool_t                fUseBVH;           //! Flag to voxelize all volumes using bounding volume hierarchies
 //--- private methods
 
+   TGeoNavigatorArray   *FindNavigators() const;
    Bool_t                IsLoopingVolumes() const     {return fLoopVolumes;}
    void                  Init();
    Bool_t                InitArrayPNE() const;
@@ -142,6 +142,8 @@ private :
    void                  SetLoopVolumes(Bool_t flag=kTRUE) {fLoopVolumes=flag;}
    void                  UpdateElements();
    void                  Voxelize(Option_t *option = 0);
+   static void          *VoxelizeLoop(void *arg);
+   void                  VoxelizeVolume(TGeoVolume *vol, Option_t *option);
 
 public:
    // constructors
@@ -451,6 +453,11 @@ public:
    static TGeoManager    *Import(const char *filename, const char *name="", Option_t *option="");
    static Bool_t          IsLocked();
    Bool_t                 IsStreamingVoxels() const {return fStreamVoxels;}
+   Bool_t                 IsUsingBVH() const {return fUseBVH;}
+   void                   SetUseBVH(Bool_t flag=kTRUE) {fUseBVH = flag;}
+   void                   SetStreamingVoxels(Bool_t flag=kTRUE) {fStreamVoxels = flag;}
+   Int_t                  GetVoxelizationThreads() const {return fNvoxelThreads;}
+   void                   SetVoxelizationThreads(Int_t nthreads) {fNvoxelThreads = nthreads;}
    Bool_t                 IsCleaning() const {return fIsGeomCleaning;}
 
    //--- list getters
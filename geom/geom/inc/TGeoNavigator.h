@@ -44,6 +44,8 @@ protected:
    Int_t                 GetTouchedCluster(Int_t start, Double_t *point, Int_t *check_list,
                                            Int_t ncheck, Int_t *result);
    TGeoNode             *CrossDivisionCell();
+   void                  RecordHistory();
+   TGeoNode             *RelocateFromHistory(const TGeoNode *skipnode);
    void                  SafetyOverlaps();
 
 private :
@@ -63,6 +65,10 @@ private :
    Int_t                 fOverlapSize;      //! current size of fOverlapClusters
    Int_t                 fOverlapMark;      //! current recursive position in fOverlapClusters
    Int_t                *fOverlapClusters;  //! internal array for overlaps
+   Int_t                 fHistorySize;      //! maximum number of states in the navigation history
+   Int_t                 fHistoryEntries;   //! number of states currently in the history
+   Long64_t              fNhistoryHits;     //! number of boundary crossings relocated from history
+   Long64_t              fNhistoryMisses;   //! number of boundary crossings not found in history
    Bool_t                fSearchOverlaps;   //! flag set when an overlapping cluster is searched
    Bool_t                fCurrentOverlapping; //! flags the type of the current node
    Bool_t                fStartSafe;        //! flag a safe start for point classification
@@ -83,6 +89,7 @@ private :
    TGeoNode             *fNextNode;         //! next node that will be crossed
    TGeoNode             *fForcedNode;       //! current point is supposed to be inside this node
    TGeoCacheState       *fBackupState;      //! backup state
+   TGeoCacheState      **fHistory;          //! recently visited states, most recent first
    TGeoHMatrix          *fCurrentMatrix;    //! current stored global matrix
    TGeoHMatrix          *fGlobalMatrix;     //! current pointer to cached global matrix
    TGeoHMatrix          *fDivMatrix;        //! current local matrix of the selected division cell
@@ -148,6 +155,13 @@ public :
    Bool_t                 IsOnBoundary() const         {return fIsOnBoundary;}
    Bool_t                 IsNullStep() const           {return fIsNullStep;}
    void                   SetCheckingOverlaps(Bool_t flag=kTRUE) {fSearchOverlaps = flag;}
+   //--- navigation history
+   void                   ClearHistory() {fHistoryEntries = 0;}
+   Long64_t               GetHistoryHits() const       {return fNhistoryHits;}
+   Long64_t               GetHistoryMisses() const     {return fNhistoryMisses;}
+   Int_t                  GetHistorySize() const       {return fHistorySize;}
+   void                   ResetHistoryCounters()       {fNhistoryHits = fNhistoryMisses = 0;}
+   void                   SetHistorySize(Int_t nstates);
    void                   SetOutside(Bool_t flag=kTRUE) {fIsOutside = flag;}
    //--- modeler state getters/setters
    void                   DoBackupState();
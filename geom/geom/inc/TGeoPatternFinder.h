@@ -19,6 +19,9 @@
 #ifndef ROOT_TGeoVolume
 #include "TGeoVolume.h"
 #endif
+#ifndef ROOT_TGeoThreadSlots
+#include "TGeoThreadSlots.h"
+#endif
 
 
 class TGeoMatrix;
@@ -58,8 +61,7 @@ protected :
    Int_t               fDivIndex;       // index of first div. node
    TGeoVolume         *fVolume;         // volume to which applies
 
-   mutable std::vector<ThreadData_t*> fThreadData; //! Vector of thread private transient data
-   mutable Int_t                      fThreadSize; //! Size of the thread vector
+   mutable TGeoThreadSlots            fThreadData; //! Thread private transient data
 
 protected:
    TGeoPatternFinder(const TGeoPatternFinder&); 
@@ -0,0 +1,60 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2000, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TGeoThreadSlots
+#define ROOT_TGeoThreadSlots
+
+#ifndef ROOT_Rtypes
+#include "Rtypes.h"
+#endif
+
+////////////////////////////////////////////////////////////////////////////
+//                                                                        //
+// TGeoThreadSlots - per-thread pointers indexed by TGeoManager::ThreadId //
+//                                                                        //
+////////////////////////////////////////////////////////////////////////////
+
+class TGeoThreadSlots {
+public:
+   enum { kBlockSize = 16 };
+
+private:
+   struct Block_t {
+      void    *fSlot[kBlockSize]; // Pointers of kBlockSize consecutive threads
+      Block_t *fNext;             // Next block
+   };
+
+   Block_t              *fFirst;  // First block of slots
+   Int_t                 fSize;   // Number of slots in all blocks
+
+   TGeoThreadSlots(const TGeoThreadSlots&);            // not implemented
+   TGeoThreadSlots& operator=(const TGeoThreadSlots&); // not implemented
+
+public:
+   TGeoThreadSlots() : fFirst(0), fSize(0) {}
+   ~TGeoThreadSlots() {Clear();}
+
+   void                 *Get(Int_t tid) const;
+   void                 *&At(Int_t tid);
+   void                  Clear();
+   Int_t                 GetSize() const {return fSize;}
+   void                  Reserve(Int_t nthreads);
+};
+
+//______________________________________________________________________________
+inline void *TGeoThreadSlots::Get(Int_t tid) const
+{
+// Pointer of thread tid, 0 if no slot was created for this thread.
+   Block_t *block = fFirst;
+   for (; block && tid >= kBlockSize; tid -= kBlockSize) block = block->fNext;
+   return block ? block->fSlot[tid] : 0;
+}
+
+#endif
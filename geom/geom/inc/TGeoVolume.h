@@ -41,6 +41,9 @@
 #ifndef ROOT_TGeoShape
 #include "TGeoShape.h"
 #endif
+#ifndef ROOT_TGeoThreadSlots
+#include "TGeoThreadSlots.h"
+#endif
 
 // forward declarations
 class TH2F;
@@ -143,6 +146,7 @@ public:
    Bool_t          IsAdded()     const {return TObject::TestBit(kVolumeAdded);}
    Bool_t          IsReplicated() const {return TObject::TestBit(kVolumeReplicated);}
    Bool_t          IsSelected() const  {return TObject::TestBit(kVolumeSelected);}
+   Bool_t          IsBVHVoxels() const {return TGeoAtt::TestAttBit(TGeoAtt::kUseBVH);}
    Bool_t          IsCylVoxels() const {return TObject::TestBit(kVoxelsCyl);}
    Bool_t          IsXYZVoxels() const {return TObject::TestBit(kVoxelsXYZ);}
    Bool_t          IsTopVolume() const;
@@ -207,6 +211,7 @@ public:
    void            SetAdded()      {TObject::SetBit(kVolumeAdded);}
    void            SetReplicated() {TObject::SetBit(kVolumeReplicated);}
    void            SetCurrentPoint(Double_t x, Double_t y, Double_t z);
+   void            SetBVHVoxels(Bool_t flag=kTRUE) {TGeoAtt::SetAttBit(TGeoAtt::kUseBVH, flag);}
    void            SetCylVoxels(Bool_t flag=kTRUE) {TObject::SetBit(kVoxelsCyl, flag); TObject::SetBit(kVoxelsXYZ, !flag);}
    void            SetNodes(TObjArray *nodes) {fNodes = nodes; TObject::SetBit(kVolumeImportNodes);}
    void            SetShape(const TGeoShape *shape);
@@ -314,8 +319,7 @@ public:
    virtual void  CreateThreadData(Int_t nthreads);
 
 protected:
-   mutable std::vector<ThreadData_t*> fThreadData; //! Thread specific data vector
-   mutable Int_t                      fThreadSize; //! Thread vector size
+   mutable TGeoThreadSlots            fThreadData; //! Thread specific data
 
 public:
    TGeoVolumeAssembly();
@@ -15,6 +15,9 @@
 #ifndef ROOT_TGeoBBox
 #include "TGeoBBox.h"
 #endif
+#ifndef ROOT_TGeoThreadSlots
+#include "TGeoThreadSlots.h"
+#endif
   
 class TGeoPolygon;
 
@@ -58,8 +61,7 @@ protected:
    Double_t             *fX0;    //[fNz] array of X offsets (for each Z)
    Double_t             *fY0;    //[fNz] array of Y offsets (for each Z)
 
-   mutable std::vector<ThreadData_t*> fThreadData; //! Navigation data per thread
-   mutable Int_t                      fThreadSize; //! size of thread-specific array
+   mutable TGeoThreadSlots            fThreadData; //! Navigation data per thread
    TGeoXtru(const TGeoXtru&); 
    TGeoXtru& operator=(const TGeoXtru&);
 
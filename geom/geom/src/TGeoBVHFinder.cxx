@@ -0,0 +1,515 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2000, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+// TGeoBVHFinder - voxel finder based on a bounding volume hierarchy (BVH)
+//
+// The slice-based TGeoVoxelFinder performs well when daughters are regularly
+// distributed along the axes, but the number of candidates per slice grows
+// quickly for volumes containing thousands of unevenly distributed or
+// rotated daughters. This finder organizes the bounding boxes of the
+// daughters (in the mother reference frame) in a binary tree built using
+// the surface area heuristic (SAH). The tree is flattened in depth-first
+// order: each node stores its limits and the index of the next node to be
+// visited when its subtree is skipped, so queries are a forward walk of
+// contiguous arrays without recursion nor per-thread stacks.
+//
+// The finder is used instead of the default one for volumes flagged via
+// TGeoVolume::SetBVHVoxels() or for all volumes if TGeoManager::SetUseBVH()
+// was called before closing the geometry. It is transparent for navigation:
+// TGeoNavigator::FindNode and FindNextBoundary use the same interface as
+// for TGeoVoxelFinder.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include "TGeoBVHFinder.h"
+
+#include "TMath.h"
+#include "TGeoBBox.h"
+#include "TGeoNode.h"
+#include "TGeoVolume.h"
+#include "TGeoStateInfo.h"
+#include "TGeoManager.h"
+
+ClassImp(TGeoBVHFinder)
+
+namespace {
+   const Int_t    kBVHNbins    = 16;   // number of bins used to evaluate SAH splits
+   const Int_t    kBVHMaxLeaf  = 4;    // leaves with more daughters are always split
+   const Double_t kBVHTraverse = 1.;   // cost of traversing a node relative to a box test
+
+   //___________________________________________________________________________
+   inline Double_t BoxArea(const Double_t *lim)
+   {
+   // Surface area of the box defined by xmin,xmax,ymin,ymax,zmin,zmax
+      Double_t dx = lim[1]-lim[0];
+      Double_t dy = lim[3]-lim[2];
+      Double_t dz = lim[5]-lim[4];
+      return 2.*(dx*dy+dy*dz+dz*dx);
+   }
+
+   //___________________________________________________________________________
+   inline void ResetLimits(Double_t *lim)
+   {
+   // Make an empty box
+      lim[0] = lim[2] = lim[4] = TGeoShape::Big();
+      lim[1] = lim[3] = lim[5] = -TGeoShape::Big();
+   }
+
+   //___________________________________________________________________________
+   inline void GrowLimits(Double_t *lim, const Double_t *box)
+   {
+   // Extend limits with a daughter box stored as dx,dy,dz,ox,oy,oz
+      for (Int_t i=0; i<3; i++) {
+         if (box[i+3]-box[i] < lim[2*i])   lim[2*i]   = box[i+3]-box[i];
+         if (box[i+3]+box[i] > lim[2*i+1]) lim[2*i+1] = box[i+3]+box[i];
+      }
+   }
+
+   //___________________________________________________________________________
+   inline void MergeLimits(Double_t *lim, const Double_t *other)
+   {
+   // Extend limits with another set of limits
+      for (Int_t i=0; i<3; i++) {
+         if (other[2*i]   < lim[2*i])   lim[2*i]   = other[2*i];
+         if (other[2*i+1] > lim[2*i+1]) lim[2*i+1] = other[2*i+1];
+      }
+   }
+
+   //___________________________________________________________________________
+   inline Bool_t CrossesLimits(const Double_t *lim, const Double_t *point, const TGeoStateInfo &td, Double_t step)
+   {
+   // Slab test of the current ray against the limits, within [0, step]
+      Double_t tmin = -TGeoShape::Tolerance();
+      Double_t tmax = step + TGeoShape::Tolerance();
+      Double_t t1, t2;
+      for (Int_t i=0; i<3; i++) {
+         if (!td.fVoxInc[i]) {
+            if (point[i]<lim[2*i] || point[i]>lim[2*i+1]) return kFALSE;
+            continue;
+         }
+         t1 = (lim[2*i]-point[i])*td.fVoxInvdir[i];
+         t2 = (lim[2*i+1]-point[i])*td.fVoxInvdir[i];
+         if (td.fVoxInc[i]<0) {
+            Double_t tmp = t1;
+            t1 = t2;
+            t2 = tmp;
+         }
+         if (t1 > tmin) tmin = t1;
+         if (t2 < tmax) tmax = t2;
+         if (tmin > tmax) return kFALSE;
+      }
+      return kTRUE;
+   }
+}
+
+//_____________________________________________________________________________
+TGeoBVHFinder::TGeoBVHFinder()
+              :TGeoVoxelFinder(),
+               fNnodes(0),
+               fNlimits(0),
+               fNitems(0),
+               fDepth(0),
+               fLimits(0),
+               fSkip(0),
+               fFirst(0),
+               fNleaf(0),
+               fItems(0)
+{
+// Default constructor
+}
+
+//_____________________________________________________________________________
+TGeoBVHFinder::TGeoBVHFinder(TGeoVolume *vol)
+              :TGeoVoxelFinder(vol),
+               fNnodes(0),
+               fNlimits(0),
+               fNitems(0),
+               fDepth(0),
+               fLimits(0),
+               fSkip(0),
+               fFirst(0),
+               fNleaf(0),
+               fItems(0)
+{
+// Constructor. The hierarchy is built at the first voxelization.
+}
+
+//_____________________________________________________________________________
+TGeoBVHFinder::~TGeoBVHFinder()
+{
+// Destructor
+   ClearHierarchy();
+}
+
+//_____________________________________________________________________________
+void TGeoBVHFinder::ClearHierarchy()
+{
+// Delete the arrays describing the hierarchy.
+   delete [] fLimits;
+   delete [] fSkip;
+   delete [] fFirst;
+   delete [] fNleaf;
+   delete [] fItems;
+   fLimits = 0;
+   fSkip = fFirst = fNleaf = fItems = 0;
+   fNnodes = fNlimits = fNitems = fDepth = 0;
+}
+
+//_____________________________________________________________________________
+Int_t TGeoBVHFinder::BuildNode(Int_t first, Int_t n, Int_t depth)
+{
+// Build the subtree for daughters fItems[first, first+n) in depth-first order.
+// Returns the index of the created node.
+   Int_t inode = fNnodes++;
+   if (depth > fDepth) fDepth = depth;
+   Double_t *lim = &fLimits[6*inode];
+   ResetLimits(lim);
+   for (Int_t i=first; i<first+n; i++) GrowLimits(lim, &fBoxes[6*fItems[i]]);
+   fFirst[inode] = first;
+   fNleaf[inode] = 0;
+   Int_t nleft = (n>1)?SplitNode(first, n, lim):0;
+   if (!nleft) {
+      fNleaf[inode] = n;
+      fSkip[inode] = inode+1;
+      return inode;
+   }
+   BuildNode(first, nleft, depth+1);
+   BuildNode(first+nleft, n-nleft, depth+1);
+   fSkip[inode] = fNnodes;
+   return inode;
+}
+
+//_____________________________________________________________________________
+Int_t TGeoBVHFinder::SplitNode(Int_t first, Int_t n, const Double_t *limits)
+{
+// Find the best split of daughters fItems[first, first+n) according to the
+// binned surface area heuristic and partition them accordingly. Returns the
+// number of daughters going to the left child, 0 if a leaf is cheaper.
+   Double_t cmin[3], cmax[3];
+   Int_t i, j, axis, id;
+   for (j=0; j<3; j++) {
+      cmin[j] = TGeoShape::Big();
+      cmax[j] = -TGeoShape::Big();
+   }
+   for (i=first; i<first+n; i++) {
+      const Double_t *box = &fBoxes[6*fItems[i]];
+      for (j=0; j<3; j++) {
+         if (box[j+3] < cmin[j]) cmin[j] = box[j+3];
+         if (box[j+3] > cmax[j]) cmax[j] = box[j+3];
+      }
+   }
+   Double_t area = BoxArea(limits);
+   if (area < TGeoShape::Tolerance()) area = TGeoShape::Tolerance();
+   Double_t bestcost = n;
+   Int_t bestaxis = -1;
+   Int_t bestbin = -1;
+   Int_t count[kBVHNbins];
+   Double_t binlim[6*kBVHNbins];
+   Double_t rarea[kBVHNbins];
+   Int_t rcount[kBVHNbins];
+   Double_t acc[6];
+   for (axis=0; axis<3; axis++) {
+      Double_t extent = cmax[axis]-cmin[axis];
+      if (extent < TGeoShape::Tolerance()) continue;
+      Double_t scale = kBVHNbins/extent;
+      for (j=0; j<kBVHNbins; j++) {
+         count[j] = 0;
+         ResetLimits(&binlim[6*j]);
+      }
+      for (i=first; i<first+n; i++) {
+         const Double_t *box = &fBoxes[6*fItems[i]];
+         Int_t ibin = Int_t(scale*(box[axis+3]-cmin[axis]));
+         if (ibin >= kBVHNbins) ibin = kBVHNbins-1;
+         count[ibin]++;
+         GrowLimits(&binlim[6*ibin], box);
+      }
+      // Sweep from the right to get the area and count right of each plane
+      ResetLimits(acc);
+      Int_t nacc = 0;
+      for (j=kBVHNbins-1; j>0; j--) {
+         if (count[j]) {
+            MergeLimits(acc, &binlim[6*j]);
+            nacc += count[j];
+         }
+         rcount[j] = nacc;
+         rarea[j] = (nacc)?BoxArea(acc):0.;
+      }
+      // Sweep from the left and evaluate the cost of the split after bin j
+      ResetLimits(acc);
+      nacc = 0;
+      for (j=0; j<kBVHNbins-1; j++) {
+         if (count[j]) {
+            MergeLimits(acc, &binlim[6*j]);
+            nacc += count[j];
+         }
+         if (!nacc || !rcount[j+1]) continue;
+         Double_t cost = kBVHTraverse + (nacc*BoxArea(acc) + rcount[j+1]*rarea[j+1])/area;
+         if (cost < bestcost) {
+            bestcost = cost;
+            bestaxis = axis;
+            bestbin = j;
+         }
+      }
+   }
+   if (bestaxis < 0) return 0;
+   if (n <= kBVHMaxLeaf && bestcost >= n) return 0;
+   // Partition the daughters in place
+   Double_t scale = kBVHNbins/(cmax[bestaxis]-cmin[bestaxis]);
+   Int_t ileft = first;
+   Int_t iright = first+n-1;
+   while (ileft <= iright) {
+      id = fItems[ileft];
+      Int_t ibin = Int_t(scale*(fBoxes[6*id+bestaxis+3]-cmin[bestaxis]));
+      if (ibin >= kBVHNbins) ibin = kBVHNbins-1;
+      if (ibin <= bestbin) {
+         ileft++;
+      } else {
+         fItems[ileft] = fItems[iright];
+         fItems[iright--] = id;
+      }
+   }
+   Int_t nleft = ileft-first;
+   if (!nleft || nleft==n) nleft = n/2;
+   return nleft;
+}
+
+//_____________________________________________________________________________
+Double_t TGeoBVHFinder::SAHCost() const
+{
+// Expected cost of a point query relative to testing all daughter boxes.
+   if (!fNnodes) return 0.;
+   Double_t area = BoxArea(fLimits);
+   if (area < TGeoShape::Tolerance()) return 0.;
+   Double_t cost = 0.;
+   for (Int_t inode=0; inode<fNnodes; inode++) {
+      Double_t weight = BoxArea(&fLimits[6*inode])/area;
+      cost += weight*((fNleaf[inode])?fNleaf[inode]:kBVHTraverse);
+   }
+   return cost;
+}
+
+//_____________________________________________________________________________
+Double_t TGeoBVHFinder::Efficiency()
+{
+//--- Compute voxelization efficiency, i.e. the ratio between the number of
+//    daughters and the expected number of box tests for a point query.
+   printf("BVH efficiency for %s\n", fVolume->GetName());
+   if (NeedRebuild()) {
+      Voxelize();
+      fVolume->FindOverlaps();
+   }
+   Double_t cost = SAHCost();
+   Double_t eff = 0.;
+   if (cost>0) eff = Double_t(fVolume->GetNdaughters())/cost;
+   printf("Nodes : %i  depth : %i  expected box tests : %g\n", fNnodes, fDepth, cost);
+   printf("Total efficiency : %g\n", eff);
+   return eff;
+}
+
+//_____________________________________________________________________________
+void TGeoBVHFinder::FindOverlaps(Int_t inode) const
+{
+// Create the list of nodes for which the bboxes overlap with inode's bbox,
+// using the hierarchy to discard distant daughters.
+   if (!fBoxes) return;
+   if (!fNnodes) {
+      TGeoVoxelFinder::FindOverlaps(inode);
+      return;
+   }
+   Double_t lim[6];
+   ResetLimits(lim);
+   GrowLimits(lim, &fBoxes[6*inode]);
+   Int_t nd = fVolume->GetNdaughters();
+   Int_t *otmp = new Int_t[nd];
+   Int_t novlp = 0;
+   Int_t ibvh = 0;
+   Int_t i, j;
+   while (ibvh < fNnodes) {
+      const Double_t *blim = &fLimits[6*ibvh];
+      if (lim[1]<blim[0] || lim[0]>blim[1] || lim[3]<blim[2] ||
+          lim[2]>blim[3] || lim[5]<blim[4] || lim[4]>blim[5]) {
+         ibvh = fSkip[ibvh];
+         continue;
+      }
+      for (i=fFirst[ibvh]; i<fFirst[ibvh]+fNleaf[ibvh]; i++) {
+         Int_t ib = fItems[i];
+         if (ib == inode) continue; // everyone overlaps with itself
+         const Double_t *box = &fBoxes[6*ib];
+         for (j=0; j<3; j++) {
+            if ((lim[2*j+1]-box[j+3]+box[j])*(box[j+3]+box[j]-lim[2*j]) <= 0.) break;
+         }
+         if (j==3) otmp[novlp++] = ib;
+      }
+      ibvh++;
+   }
+   TGeoNode *node = fVolume->GetNode(inode);
+   if (!novlp) {
+      delete [] otmp;
+      node->SetOverlaps(0, 0);
+      return;
+   }
+   // Keep the same ordering as the default finder
+   std::sort(otmp, otmp+novlp);
+   Int_t *ovlps = new Int_t[novlp];
+   memcpy(ovlps, otmp, novlp*sizeof(Int_t));
+   delete [] otmp;
+   node->SetOverlaps(ovlps, novlp);
+}
+
+//_____________________________________________________________________________
+Int_t *TGeoBVHFinder::GetCheckList(const Double_t *point, Int_t &nelem, TGeoStateInfo &td)
+{
+// Get the list of daughter indices for which point is inside their bbox.
+   if (NeedRebuild()) {
+      Voxelize();
+      fVolume->FindOverlaps();
+   }
+   nelem = 0;
+   Int_t inode = 0;
+   Int_t i;
+   while (inode < fNnodes) {
+      const Double_t *lim = &fLimits[6*inode];
+      if (point[0]<lim[0] || point[0]>lim[1] || point[1]<lim[2] ||
+          point[1]>lim[3] || point[2]<lim[4] || point[2]>lim[5]) {
+         inode = fSkip[inode];
+         continue;
+      }
+      for (i=fFirst[inode]; i<fFirst[inode]+fNleaf[inode]; i++) {
+         const Double_t *box = &fBoxes[6*fItems[i]];
+         if (TMath::Abs(point[0]-box[3]) > box[0]) continue;
+         if (TMath::Abs(point[1]-box[4]) > box[1]) continue;
+         if (TMath::Abs(point[2]-box[5]) > box[2]) continue;
+         td.fVoxCheckList[nelem++] = fItems[i];
+      }
+      inode++;
+   }
+   if (!nelem) return 0;
+   // Candidates are returned in increasing order as for the slice finder,
+   // which matters for the treatment of overlapping nodes.
+   if (nelem > 1) std::sort(td.fVoxCheckList, td.fVoxCheckList+nelem);
+   return td.fVoxCheckList;
+}
+
+//_____________________________________________________________________________
+Int_t *TGeoBVHFinder::GetNextCandidates(const Double_t * /*point*/, Int_t &ncheck, TGeoStateInfo & /*td*/)
+{
+// All candidates along the ray are collected by SortCrossedVoxels.
+   ncheck = 0;
+   return 0;
+}
+
+//_____________________________________________________________________________
+Int_t *TGeoBVHFinder::GetNextVoxel(const Double_t * /*point*/, const Double_t * /*dir*/, Int_t &ncheck, TGeoStateInfo &td)
+{
+// Get the list of candidates crossed by the current ray. The full list is
+// returned at the first call after SortCrossedVoxels.
+   ncheck = 0;
+   if (td.fVoxCurrent) return 0;
+   td.fVoxCurrent++;
+   ncheck = td.fVoxNcandidates;
+   if (!ncheck) return 0;
+   return td.fVoxCheckList;
+}
+
+//_____________________________________________________________________________
+void TGeoBVHFinder::SortCrossedVoxels(const Double_t *point, const Double_t *dir, TGeoStateInfo &td)
+{
+// Collect the daughters having the bounding box crossed by the ray starting
+// from point along dir within the current proposed step.
+   if (NeedRebuild()) {
+      Voxelize();
+      fVolume->FindOverlaps();
+   }
+   td.fVoxCurrent = 0;
+   td.fVoxNcandidates = 0;
+   for (Int_t i=0; i<3; i++) {
+      td.fVoxInc[i] = 0;
+      td.fVoxInvdir[i] = TGeoShape::Big();
+      if (TMath::Abs(dir[i])<1E-10) continue;
+      td.fVoxInc[i] = (dir[i]>0)?1:-1;
+      td.fVoxInvdir[i] = 1./dir[i];
+   }
+   Double_t step = fVolume->GetGeoManager()->GetStep();
+   Double_t lim[6];
+   Int_t inode = 0;
+   while (inode < fNnodes) {
+      if (!CrossesLimits(&fLimits[6*inode], point, td, step)) {
+         inode = fSkip[inode];
+         continue;
+      }
+      for (Int_t i=fFirst[inode]; i<fFirst[inode]+fNleaf[inode]; i++) {
+         ResetLimits(lim);
+         GrowLimits(lim, &fBoxes[6*fItems[i]]);
+         if (CrossesLimits(lim, point, td, step)) td.fVoxCheckList[td.fVoxNcandidates++] = fItems[i];
+      }
+      inode++;
+   }
+}
+
+//_____________________________________________________________________________
+void TGeoBVHFinder::Print(Option_t *option) const
+{
+// Print the hierarchy. Option "a" dumps all nodes.
+   if (NeedRebuild()) {
+      TGeoBVHFinder *vox = (TGeoBVHFinder*)this;
+      vox->Voxelize();
+      fVolume->FindOverlaps();
+   }
+   Int_t nleaves = 0;
+   Int_t inode;
+   for (inode=0; inode<fNnodes; inode++) if (fNleaf[inode]) nleaves++;
+   printf("BVH for volume %s (nd=%i)\n", fVolume->GetName(), fVolume->GetNdaughters());
+   printf("nodes : %i  leaves : %i  depth : %i  SAH cost : %g\n", fNnodes, nleaves, fDepth, SAHCost());
+   TString opt(option);
+   opt.ToLower();
+   if (!opt.Contains("a")) return;
+   for (inode=0; inode<fNnodes; inode++) {
+      const Double_t *lim = &fLimits[6*inode];
+      printf("node %i : x=(%g, %g) y=(%g, %g) z=(%g, %g) skip=%i", inode,
+             lim[0], lim[1], lim[2], lim[3], lim[4], lim[5], fSkip[inode]);
+      if (fNleaf[inode]) {
+         printf(" daughters :");
+         for (Int_t i=fFirst[inode]; i<fFirst[inode]+fNleaf[inode]; i++) printf(" %i", fItems[i]);
+      }
+      printf("\n");
+   }
+}
+
+//_____________________________________________________________________________
+void TGeoBVHFinder::Voxelize(Option_t * /*option*/)
+{
+// Build the hierarchy for the attached volume.
+   // If the volume is an assembly, make sure the bbox is computed.
+   if (fVolume->IsAssembly()) fVolume->GetShape()->ComputeBBox();
+   Int_t nd = fVolume->GetNdaughters();
+   TGeoVolume *vd;
+   Int_t i;
+   for (i=0; i<nd; i++) {
+      vd = fVolume->GetNode(i)->GetVolume();
+      if (vd->IsAssembly()) vd->GetShape()->ComputeBBox();
+   }
+   BuildVoxelLimits();
+   ClearHierarchy();
+   if (nd) {
+      Int_t maxnodes = 2*nd-1;
+      fNitems = nd;
+      fItems  = new Int_t[nd];
+      for (i=0; i<nd; i++) fItems[i] = i;
+      fLimits = new Double_t[6*maxnodes];
+      fSkip   = new Int_t[maxnodes];
+      fFirst  = new Int_t[maxnodes];
+      fNleaf  = new Int_t[maxnodes];
+      BuildNode(0, nd, 1);
+      fNlimits = 6*fNnodes;
+   }
+   SetNeedRebuild(kFALSE);
+}
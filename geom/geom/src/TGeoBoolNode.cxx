@@ -65,55 +65,34 @@ TGeoBoolNode::ThreadData_t::~ThreadData_t()
 //______________________________________________________________________________
 TGeoBoolNode::ThreadData_t& TGeoBoolNode::GetThreadData() const
 {
+// Get the data of the calling thread, allocating it on first use. Slots for
+// new thread ordinals are appended without moving the existing ones, so each
+// thread only writes its own slot.
    Int_t tid = TGeoManager::ThreadId();
-/*
-   TThread::Lock();
-   if (tid >= fThreadSize) {
-      Error("GetThreadData", "Thread id=%d bigger than maximum declared thread number %d. \nUse TGeoManager::SetMaxThreads properly !!!",
-             tid, fThreadSize);
-   }          
-   if (tid >= fThreadSize)
-   {
-      fThreadData.resize(tid + 1);
-      fThreadSize = tid + 1;
+   ThreadData_t *td = (ThreadData_t*)fThreadData.Get(tid);
+   if (!td) {
+      td = new ThreadData_t;
+      fThreadData.At(tid) = td;
    }
-   if (fThreadData[tid] == 0)
-   {
-   if (fThreadData[tid] == 0)
-      fThreadData[tid] = new ThreadData_t;
-   }   
-   TThread::UnLock();
-*/
-   return *fThreadData[tid];
+   return *td;
 }
 
 //______________________________________________________________________________
 void TGeoBoolNode::ClearThreadData() const
 {
    TThread::Lock();
-   std::vector<ThreadData_t*>::iterator i = fThreadData.begin();
-   while (i != fThreadData.end())
-   {
-      delete *i;
-      ++i;
-   }
-   fThreadData.clear();
-   fThreadSize = 0;
+   for (Int_t tid=0; tid<fThreadData.GetSize(); tid++) delete (ThreadData_t*)fThreadData.Get(tid);
+   fThreadData.Clear();
    TThread::UnLock();
 }
 
 //______________________________________________________________________________
 void TGeoBoolNode::CreateThreadData(Int_t nthreads)
 {
-// Create thread data for n threads max.
+// Reserve thread data slots for n threads. The data is created lazily and
+// further slots are added for higher thread ordinals.
    TThread::Lock();
-   fThreadData.resize(nthreads);
-   fThreadSize = nthreads;
-   for (Int_t tid=0; tid<nthreads; tid++) {
-      if (fThreadData[tid] == 0) {
-         fThreadData[tid] = new ThreadData_t;
-      }
-   }
+   fThreadData.Reserve(nthreads);
    // Propagate to components
    if (fLeft)  fLeft->CreateThreadData(nthreads);
    if (fRight) fRight->CreateThreadData(nthreads);
@@ -138,7 +117,6 @@ TGeoBoolNode::TGeoBoolNode()
    fRightMat = 0;
    fNpoints  = 0;
    fPoints   = 0;
-   fThreadSize = 0;
    CreateThreadData(1);
 }
 
@@ -152,7 +130,6 @@ TGeoBoolNode::TGeoBoolNode(const char *expr1, const char *expr2)
    fRightMat = 0;
    fNpoints  = 0;
    fPoints   = 0;
-   fThreadSize = 0;
    CreateThreadData(1);
    if (!MakeBranch(expr1, kTRUE)) {
       return;
@@ -171,7 +148,6 @@ TGeoBoolNode::TGeoBoolNode(TGeoShape *left, TGeoShape *right, TGeoMatrix *lmat,
    fLeftMat = lmat;
    fNpoints  = 0;
    fPoints   = 0;
-   fThreadSize = 0;
    CreateThreadData(1);
    if (!fLeftMat) fLeftMat = gGeoIdentity;
    else fLeftMat->RegisterYourself();
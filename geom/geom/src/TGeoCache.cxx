@@ -140,12 +140,12 @@ void TGeoNodeCache::BuildIdArray()
 //_____________________________________________________________________________
 void TGeoNodeCache::BuildInfoBranch()
 {
-// Bulds info branch. Navigation is possible only after this step.
-   if (!fInfoBranch) fInfoBranch  = new TGeoStateInfo*[fGeoInfoStackSize];
-   else if (fInfoBranch[0]) return;
-   for (Int_t i=0; i<fGeoInfoStackSize; i++) {
-      fInfoBranch[i] = new TGeoStateInfo();
-   }   
+// Bulds info branch. Navigation is possible only after this step. The state
+// info objects themselves are created on demand by GetInfo, so that a
+// navigator only pays for the depth it actually uses.
+   if (fInfoBranch) return;
+   fInfoBranch  = new TGeoStateInfo*[fGeoInfoStackSize];
+   memset(fInfoBranch, 0, fGeoInfoStackSize*sizeof(TGeoStateInfo*));
 }
 
 //_____________________________________________________________________________
@@ -301,12 +301,12 @@ TGeoStateInfo *TGeoNodeCache::GetInfo()
    if (fInfoLevel==fGeoInfoStackSize-1) {
       TGeoStateInfo **infoBranch = new TGeoStateInfo*[2*fGeoInfoStackSize];
       memcpy(infoBranch, fInfoBranch, fGeoInfoStackSize*sizeof(TGeoStateInfo*));
-      for (Int_t i=fGeoInfoStackSize; i<2*fGeoInfoStackSize; i++)
-         infoBranch[i] = new TGeoStateInfo();
+      memset(infoBranch+fGeoInfoStackSize, 0, fGeoInfoStackSize*sizeof(TGeoStateInfo*));
       delete [] fInfoBranch;
       fInfoBranch = infoBranch;
       fGeoInfoStackSize *= 2;
    }
+   if (!fInfoBranch[fInfoLevel]) fInfoBranch[fInfoLevel] = new TGeoStateInfo();
    return fInfoBranch[fInfoLevel++];
 }   
 
@@ -435,6 +435,7 @@ TGeoCacheState::TGeoCacheState()
    fNodeBranch = 0;
    fMatrixBranch = 0;
    fMatPtr = 0;
+   fDivBranch = 0;
 }
 
 //_____________________________________________________________________________
@@ -451,9 +452,11 @@ TGeoCacheState::TGeoCacheState(Int_t capacity)
    fNodeBranch = new TGeoNode *[capacity];
    fMatrixBranch = new TGeoHMatrix *[capacity];
    fMatPtr = new TGeoHMatrix *[capacity];
+   fDivBranch = new Int_t[capacity];
    for (Int_t i=0; i<capacity; i++) {
       fMatrixBranch[i] = new TGeoHMatrix("global");
       fNodeBranch[i] = 0;
+      fDivBranch[i] = -1;
    }   
 }
 
@@ -473,10 +476,12 @@ TGeoCacheState::TGeoCacheState(const TGeoCacheState& gcs) :
    fNodeBranch = new TGeoNode *[fCapacity];
    fMatrixBranch = new TGeoHMatrix *[fCapacity];
    fMatPtr = new TGeoHMatrix *[fCapacity];
+   fDivBranch = new Int_t[fCapacity];
    for (i=0; i<fCapacity; i++) {
       fNodeBranch[i] = gcs.fNodeBranch[i];
       fMatrixBranch[i] = new TGeoHMatrix(*gcs.fMatrixBranch[i]);
       fMatPtr[i] = gcs.fMatPtr[i];
+      fDivBranch[i] = gcs.fDivBranch[i];
    }
 }
 
@@ -497,10 +502,12 @@ TGeoCacheState& TGeoCacheState::operator=(const TGeoCacheState& gcs)
       fNodeBranch = new TGeoNode *[fCapacity];
       fMatrixBranch = new TGeoHMatrix *[fCapacity];
       fMatPtr = new TGeoHMatrix *[fCapacity];
+      fDivBranch = new Int_t[fCapacity];
       for (i=0; i<fCapacity; i++) {
          fNodeBranch[i] = gcs.fNodeBranch[i];
          fMatrixBranch[i] = new TGeoHMatrix(*gcs.fMatrixBranch[i]);
          fMatPtr[i] = gcs.fMatPtr[i];
+         fDivBranch[i] = gcs.fDivBranch[i];
       }
    }
    return *this;
@@ -517,6 +524,7 @@ TGeoCacheState::~TGeoCacheState()
       delete [] fNodeBranch;
       delete [] fMatrixBranch;
       delete [] fMatPtr;
+      delete [] fDivBranch;
    }
 }
 
@@ -534,6 +542,10 @@ void TGeoCacheState::SetState(Int_t level, Int_t startlevel, Int_t nmany, Bool_t
    Int_t nelem = level+1-fStart;
    memcpy(fNodeBranch, node_branch+fStart, nelem*sizeof(TGeoNode *));
    memcpy(fMatPtr, mat_branch+fStart, nelem*sizeof(TGeoHMatrix *));
+   for (Int_t i=0; i<nelem; i++) {
+      TGeoNode *node = fNodeBranch[i];
+      fDivBranch[i] = (node && node->IsOffset())?node->GetIndex():-1;
+   }
    TGeoHMatrix *last = 0;
    TGeoHMatrix *current;
    for (Int_t i=0; i<nelem; i++) {
@@ -546,6 +558,30 @@ void TGeoCacheState::SetState(Int_t level, Int_t startlevel, Int_t nmany, Bool_t
    if (point) memcpy(fPoint, point, 3*sizeof(Double_t));
 }
 
+//_____________________________________________________________________________
+TGeoHMatrix *TGeoCacheState::GetMatrix() const
+{
+// Global matrix of the deepest node of the stored branch. Matrices shared
+// between consecutive levels are only stored once.
+   Int_t i = fLevel-fStart;
+   while (i>0 && fMatPtr[i]==fMatPtr[i-1]) i--;
+   return fMatrixBranch[i];
+}
+
+//_____________________________________________________________________________
+Bool_t TGeoCacheState::IsSameBranch(Int_t level, TGeoNode **branch) const
+{
+// Check if the stored branch is identical to the given one, starting from
+// the top node. For the cells of divisions the division index is compared
+// as well.
+   if (fStart || level!=fLevel) return kFALSE;
+   for (Int_t i=level; i>=0; i--) {
+      if (fNodeBranch[i]!=branch[i]) return kFALSE;
+      if (fDivBranch[i]>=0 && fDivBranch[i]!=branch[i]->GetIndex()) return kFALSE;
+   }
+   return kTRUE;
+}
+
 //_____________________________________________________________________________
 Bool_t TGeoCacheState::GetState(Int_t &level, Int_t &nmany, Double_t *point) const
 {
@@ -138,7 +138,9 @@
 // and must not be positioned - it represents the global reference frame. After
 // building the full geometry tree, the geometry must be closed
 // (see TGeoManager::CloseGeometry()). Voxelization can be redone per volume after
-// this process.
+// this process. Volumes containing many unevenly distributed daughters can be
+// voxelized using a bounding volume hierarchy instead of slices, either per
+// volume (TGeoVolume::SetBVHVoxels()) or globally (TGeoManager::SetUseBVH()).
 //
 //
 //   Below is the general scheme of the manager class.
@@ -288,6 +290,13 @@
 #include "TClass.h"
 #include "TThread.h"
 #include "ThreadLocalStorage.h"
+#include "TAtomicCount.h"
+#include "TGeoThreadSlots.h"
+#ifdef R__WIN32
+#include "Windows4Root.h"
+#else
+#include <pthread.h>
+#endif
 
 #include "TGeoVoxelFinder.h"
 #include "TGeoElement.h"
@@ -332,14 +341,113 @@ Int_t  TGeoManager::fgVerboseLevel = 1;
 Int_t  TGeoManager::fgMaxLevel = 1;
 Int_t  TGeoManager::fgMaxDaughters = 1;
 Int_t  TGeoManager::fgMaxXtruVert = 1;
-Int_t  TGeoManager::fgNumThreads   = 0;
-TGeoManager::ThreadsMap_t *TGeoManager::fgThreadId = 0;
+Int_t  TGeoManager::fgNavigatorsEpoch = 0;
+
+// Registration counter for thread ordinals. TAtomicCount only reports the
+// value after an atomic decrement, so the counter runs downwards and the n-th
+// new ordinal is n-1.
+static TAtomicCount gGeoThreadsCount(0);
+// Incremented each time the thread ordinals are reset
+static Int_t gGeoThreadsEpoch = 0;
+
+// Ordinals of exited threads are given to new threads. Each ordinal handed
+// out has a state which is 1 while the ordinal is free and 0 while a thread
+// owns it. A thread claims a free ordinal by decrementing its state: only the
+// decrement from 1 to 0 succeeds, any other one is reverted. This needs
+// neither a lock nor a compare and swap, which TAtomicCount does not provide.
+// The states are never moved or deleted while threads run.
+struct TGeoThreadState_t {
+   TAtomicCount fFree;   // 1 if the ordinal is free
+   TGeoThreadState_t() : fFree(0) {}
+};
+static TGeoThreadSlots gGeoThreadStates;
+
+// Ordinal owned by a thread, kept in thread local storage with a destructor
+// which gives the ordinal back when the thread exits.
+struct TGeoThreadOrdinal_t {
+   Int_t fTid;     // ordinal, -1 if none
+   Int_t fEpoch;   // epoch in which the ordinal was obtained
+};
+
+//_____________________________________________________________________________
+static void ReleaseGeoThreadOrdinal(TGeoThreadOrdinal_t *ord)
+{
+// Give back the ordinal of a thread, unless the ordinals were reset since.
+   if (ord->fTid > -1 && ord->fEpoch == gGeoThreadsEpoch) {
+      TGeoThreadState_t *state = (TGeoThreadState_t*)gGeoThreadStates.Get(ord->fTid);
+      if (state) ++state->fFree;
+   }
+   ord->fTid = -1;
+}
+
+#ifdef R__WIN32
+static DWORD gGeoThreadKey = FLS_OUT_OF_INDEXES;
+
+//_____________________________________________________________________________
+static VOID NTAPI GeoThreadExit(PVOID arg)
+{
+// Called by the system for each exiting thread with an ordinal.
+   if (!arg) return;
+   ReleaseGeoThreadOrdinal((TGeoThreadOrdinal_t*)arg);
+   delete (TGeoThreadOrdinal_t*)arg;
+}
+
+//_____________________________________________________________________________
+static TGeoThreadOrdinal_t *GetGeoThreadOrdinal()
+{
+// Ordinal record of the calling thread.
+   if (gGeoThreadKey == FLS_OUT_OF_INDEXES) {
+      TThread::Lock();
+      if (gGeoThreadKey == FLS_OUT_OF_INDEXES) gGeoThreadKey = FlsAlloc(GeoThreadExit);
+      TThread::UnLock();
+   }
+   TGeoThreadOrdinal_t *ord = (TGeoThreadOrdinal_t*)FlsGetValue(gGeoThreadKey);
+   if (!ord) {
+      ord = new TGeoThreadOrdinal_t;
+      ord->fTid = -1;
+      ord->fEpoch = -1;
+      FlsSetValue(gGeoThreadKey, ord);
+   }
+   return ord;
+}
+#else
+static pthread_key_t  gGeoThreadKey;
+static pthread_once_t gGeoThreadKeyOnce = PTHREAD_ONCE_INIT;
+
+//_____________________________________________________________________________
+static void GeoThreadExit(void *arg)
+{
+// Called by the system for each exiting thread with an ordinal.
+   ReleaseGeoThreadOrdinal((TGeoThreadOrdinal_t*)arg);
+   delete (TGeoThreadOrdinal_t*)arg;
+}
+
+//_____________________________________________________________________________
+static void GeoThreadKeyCreate()
+{
+   pthread_key_create(&gGeoThreadKey, GeoThreadExit);
+}
+
+//_____________________________________________________________________________
+static TGeoThreadOrdinal_t *GetGeoThreadOrdinal()
+{
+// Ordinal record of the calling thread.
+   pthread_once(&gGeoThreadKeyOnce, GeoThreadKeyCreate);
+   TGeoThreadOrdinal_t *ord = (TGeoThreadOrdinal_t*)pthread_getspecific(gGeoThreadKey);
+   if (!ord) {
+      ord = new TGeoThreadOrdinal_t;
+      ord->fTid = -1;
+      ord->fEpoch = -1;
+      pthread_setspecific(gGeoThreadKey, ord);
+   }
+   return ord;
+}
+#endif
 
 //_____________________________________________________________________________
 TGeoManager::TGeoManager()
 {
 // Default constructor.
-   if (!fgThreadId) fgThreadId = new TGeoManager::ThreadsMap_t;
    if (TClass::IsCallingNew() == TClass::kDummyNew) {
       fTimeCut = kFALSE;
       fTmin = 0.;
@@ -404,6 +512,8 @@ TGeoManager::TGeoManager()
       fValuePNEId = 0;
       fMultiThread = kFALSE;
       fMaxThreads = 0;
+      fUseBVH = kFALSE;
+      fNvoxelThreads = 1;
       ClearThreadsMap();
    } else {
       Init();
@@ -437,7 +547,6 @@ void TGeoManager::Init()
    }
 
    gGeoManager = this;
-   if (!fgThreadId) fgThreadId = new TGeoManager::ThreadsMap_t;
    fTimeCut = kFALSE;
    fTmin = 0.;
    fTmax = 999.;
@@ -501,6 +610,8 @@ void TGeoManager::Init()
    fValuePNEId = 0;
    fMultiThread = kFALSE;
    fMaxThreads = 0;
+   fUseBVH = kFALSE;
+   fNvoxelThreads = 1;
    ClearThreadsMap();
 }
 
@@ -569,12 +680,13 @@ TGeoManager::TGeoManager(const TGeoManager& gm) :
   fKeyPNEId(0),
   fValuePNEId(0),
   fMaxThreads(0),
-  fMultiThread(kFALSE)
+  fNvoxelThreads(gm.fNvoxelThreads),
+  fMultiThread(kFALSE),
+  fUseBVH(gm.fUseBVH)
 {
    //copy constructor
    for(Int_t i=0; i<256; i++)
       fPdgId[i]=gm.fPdgId[i];
-   if (!fgThreadId) fgThreadId = new TGeoManager::ThreadsMap_t;
    ClearThreadsMap();
 }
 
@@ -582,7 +694,6 @@ TGeoManager::TGeoManager(const TGeoManager& gm) :
 TGeoManager& TGeoManager::operator=(const TGeoManager& gm)
 {
    //assignment operator
-   if (!fgThreadId) fgThreadId = new TGeoManager::ThreadsMap_t;
    if(this!=&gm) {
       TNamed::operator=(gm);
       fPhimin=gm.fPhimin;
@@ -650,6 +761,8 @@ TGeoManager& TGeoManager::operator=(const TGeoManager& gm)
       fValuePNEId = 0;
       fMultiThread = kFALSE;
       fMaxThreads = 0;
+      fUseBVH = gm.fUseBVH;
+      fNvoxelThreads = gm.fNvoxelThreads;
       ClearThreadsMap();
       ClearThreadData();
    }
@@ -811,54 +924,80 @@ Int_t TGeoManager::AddVolume(TGeoVolume *volume)
 TGeoNavigator *TGeoManager::AddNavigator()
 {
 // Add a navigator in the list of navigators. If it is the first one make it
-// current navigator.
-   if (fMultiThread) TThread::Lock();
+// current navigator. In multi-threaded mode the global lock is only taken the
+// first time a thread adds a navigator, to register its navigator array.
 //   if (fgLockNavigators) {
 //      Error("AddNavigator", "Navigators are locked. Use SetNavigatorsLock(false) first.");
 //      return 0;
 //   }
-   Long_t threadId = (fMultiThread)?TThread::SelfId():999;
-   NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
-   TGeoNavigatorArray *array = 0;
-   if (it != fNavigators.end()) array = it->second;
-   else {
-      array = new TGeoNavigatorArray(this);
-      fNavigators.insert(NavigatorsMap_t::value_type(threadId, array));
+   TGeoNavigatorArray *array = FindNavigators();
+   if (!array) {
+      if (fMultiThread) TThread::Lock();
+      Long_t threadId = (fMultiThread)?TThread::SelfId():999;
+      NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
+      if (it != fNavigators.end()) array = it->second;
+      else {
+         array = new TGeoNavigatorArray(this);
+         fNavigators.insert(NavigatorsMap_t::value_type(threadId, array));
+      }
+      if (fMultiThread) TThread::UnLock();
    }
+   // The navigator array is private to the calling thread
    TGeoNavigator *nav = array->AddNavigator();
    if (fClosed) nav->GetCache()->BuildInfoBranch();
-   if (fMultiThread) TThread::UnLock();
    return nav;
 }   
 
-TTHREAD_TLS_DECLARE(TGeoNavigator*, tnav);
+TTHREAD_TLS_DECLARE(const TGeoManager*, tnavowner);
+TTHREAD_TLS_DECLARE(TGeoNavigatorArray*, tnavarray);
+TTHREAD_TLS_DECLARE(Int_t, tnavepoch);
+
+//_____________________________________________________________________________
+TGeoNavigatorArray *TGeoManager::FindNavigators() const
+{
+// Find the navigator array of the calling thread. In multi-threaded mode the
+// array is cached in thread local storage, so the map of navigators is only
+// searched (under lock) the first time a thread asks for it. The cache is
+// invalidated when navigators are cleared or the number of threads changes.
+   if (!fMultiThread) {
+      NavigatorsMap_t::const_iterator it = fNavigators.find(999);
+      if (it == fNavigators.end()) return 0;
+      return it->second;
+   }
+   TTHREAD_TLS_INIT(const TGeoManager*,tnavowner,0);
+   TTHREAD_TLS_INIT(TGeoNavigatorArray*,tnavarray,0);
+   TTHREAD_TLS_INIT(Int_t,tnavepoch,-1);
+   if (TTHREAD_TLS_GET(const TGeoManager*,tnavowner) == this &&
+       TTHREAD_TLS_GET(Int_t,tnavepoch) == fgNavigatorsEpoch)
+      return TTHREAD_TLS_GET(TGeoNavigatorArray*,tnavarray);
+   TGeoNavigatorArray *array = 0;
+   TThread::Lock();
+   NavigatorsMap_t::const_iterator it = fNavigators.find(TThread::SelfId());
+   if (it != fNavigators.end()) array = it->second;
+   TThread::UnLock();
+   // Do not cache a missing array, AddNavigator will register it
+   if (!array) return 0;
+   TTHREAD_TLS_SET(const TGeoManager*,tnavowner,this);
+   TTHREAD_TLS_SET(TGeoNavigatorArray*,tnavarray,array);
+   TTHREAD_TLS_SET(Int_t,tnavepoch,fgNavigatorsEpoch);
+   return array;
+}
 
 //_____________________________________________________________________________
 TGeoNavigator *TGeoManager::GetCurrentNavigator() const
 {
 // Returns current navigator for the calling thread.
-   TTHREAD_TLS_INIT(TGeoNavigator*,tnav,0);
    if (!fMultiThread) return fCurrentNavigator;
-   TGeoNavigator *nav = TTHREAD_TLS_GET(TGeoNavigator*,tnav);
-   if (nav) return nav;
-   Long_t threadId = TThread::SelfId();
-   NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
-   if (it == fNavigators.end()) return 0;
-   TGeoNavigatorArray *array = it->second;
-   nav = array->GetCurrentNavigator();
-   TTHREAD_TLS_SET(TGeoNavigator*,tnav,nav);
-   return nav;
+   TGeoNavigatorArray *array = FindNavigators();
+   if (!array) return 0;
+   return array->GetCurrentNavigator();
 }
 
 //_____________________________________________________________________________
 TGeoNavigatorArray *TGeoManager::GetListOfNavigators() const
 {
 // Get list of navigators for the calling thread.
-   Long_t threadId = (fMultiThread)?TThread::SelfId():999;
-   NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
-   if (it == fNavigators.end()) return 0;
-   TGeoNavigatorArray *array = it->second;
-   return array;
+   return FindNavigators();
 }
 
 //_____________________________________________________________________________
@@ -866,12 +1005,11 @@ Bool_t TGeoManager::SetCurrentNavigator(Int_t index)
 {
 // Switch to another existing navigator for the calling thread.
    Long_t threadId = (fMultiThread)?TThread::SelfId():999;
-   NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
-   if (it == fNavigators.end()) {
+   TGeoNavigatorArray *array = FindNavigators();
+   if (!array) {
       Error("SetCurrentNavigator", "No navigator defined for thread %ld\n", threadId);
       return kFALSE;
    }   
-   TGeoNavigatorArray *array = it->second;
    TGeoNavigator *nav = array->SetCurrentNavigator(index);
    if (!nav) {
       Error("SetCurrentNavigator", "Navigator %d not existing for thread %ld\n", index, threadId);
@@ -900,6 +1038,7 @@ void TGeoManager::ClearNavigators()
       if (arr) delete arr;
    }
    fNavigators.clear();   
+   fgNavigatorsEpoch++;
    if (fMultiThread) TThread::UnLock();
 }
 
@@ -914,6 +1053,7 @@ void TGeoManager::RemoveNavigator(const TGeoNavigator *nav)
       if (arr) {
          if ((TGeoNavigator*)arr->Remove((TObject*)nav)) {
             delete nav;
+            if (fMultiThread) TThread::UnLock();
             return;
          }
       }   
@@ -925,12 +1065,16 @@ void TGeoManager::RemoveNavigator(const TGeoNavigator *nav)
 //_____________________________________________________________________________
 void TGeoManager::SetMaxThreads(Int_t nthreads)
 {
-// Set maximum number of threads for navigation.
+// Set the number of threads for which thread data is reserved in advance and
+// switch to multi-threaded navigation. More threads may use the geometry, the
+// data for further thread ordinals is added on first use.
    if (fMaxThreads) {
       ClearThreadsMap();
       ClearThreadData();
    }
    fMaxThreads = nthreads;
+   // Navigator arrays are keyed differently in multi-threaded mode
+   fgNavigatorsEpoch++;
    if (fMaxThreads>0) {
       fMultiThread = kTRUE;
       CreateThreadData();
@@ -950,7 +1094,9 @@ void TGeoManager::ClearThreadData() const
 //______________________________________________________________________________
 void TGeoManager::CreateThreadData() const
 {
-// Create thread private data for all geometry objects.
+// Create thread private data for all geometry objects. Only the per-thread
+// slots are reserved here, the data itself is allocated by each thread on
+// first use so that memory scales with the number of active threads.
    if (!fMaxThreads) return;
    TThread::Lock();
    TIter next(fVolumes);
@@ -963,35 +1109,54 @@ void TGeoManager::CreateThreadData() const
 void TGeoManager::ClearThreadsMap()
 {
 // Clear the current map of threads. This will be filled again by the calling
-// threads via ThreadId calls.
+// threads via ThreadId calls. No thread may use the geometry meanwhile.
    TThread::Lock();
-   if (!fgThreadId->empty()) fgThreadId->clear();
-   fgNumThreads = 0;
+   for (Int_t i=0; i<gGeoThreadStates.GetSize(); i++) {
+      TGeoThreadState_t *state = (TGeoThreadState_t*)gGeoThreadStates.Get(i);
+      if (state) state->fFree.Set(0);
+   }
+   gGeoThreadsCount.Set(0);
+   gGeoThreadsEpoch++;
    TThread::UnLock();
 }
 
 TTHREAD_TLS_DECLARE(Int_t, tid);
+TTHREAD_TLS_DECLARE(Int_t, tidepoch);
 
 //_____________________________________________________________________________
 Int_t TGeoManager::ThreadId()
 {
 // Translates the current thread id to an ordinal number. This can be used to
-// manage data which is pspecific for a given thread.
-//   static __thread Int_t tid = -1;
-//   if (tid > -1) return tid;
+// manage data which is pspecific for a given thread. Threads register on
+// their first call without taking any lock. A registering thread takes the
+// ordinal of a thread which has exited if there is one, otherwise a new
+// one, so the ordinals stay below the number of threads running at the same
+// time.
    TTHREAD_TLS_INIT(Int_t,tid,-1);
+   TTHREAD_TLS_INIT(Int_t,tidepoch,-1);
    Int_t ttid = TTHREAD_TLS_GET(Int_t,tid);
-   if (ttid > -1) return ttid;
+   if (ttid > -1 && TTHREAD_TLS_GET(Int_t,tidepoch) == gGeoThreadsEpoch) return ttid;
    if (gGeoManager && !gGeoManager->IsMultiThread()) return 0;
-   TGeoManager::ThreadsMapIt_t it = fgThreadId->find(TThread::SelfId());
-   if (it != fgThreadId->end()) return it->second;
-   // Map needs to be updated.
-   TThread::Lock();
-   (*fgThreadId)[TThread::SelfId()] = fgNumThreads;
-   TTHREAD_TLS_SET(Int_t,tid,fgNumThreads);
-   fgNumThreads++;
-   TThread::UnLock();
-   return fgNumThreads-1;
+   TGeoThreadOrdinal_t *ord = GetGeoThreadOrdinal();
+   ReleaseGeoThreadOrdinal(ord);
+   ttid = -1;
+   Int_t nordinals = -Int_t(gGeoThreadsCount.Get());
+   for (Int_t i=0; i<nordinals && ttid<0; i++) {
+      TGeoThreadState_t *state = (TGeoThreadState_t*)gGeoThreadStates.Get(i);
+      if (!state) continue;
+      if (--state->fFree == 0) ttid = i;
+      else ++state->fFree;
+   }
+   if (ttid < 0) {
+      ttid = -Int_t(--gGeoThreadsCount) - 1;
+      // a state left from before the last reset is already owned (0)
+      if (!gGeoThreadStates.Get(ttid)) gGeoThreadStates.At(ttid) = new TGeoThreadState_t;
+   }
+   ord->fTid = ttid;
+   ord->fEpoch = gGeoThreadsEpoch;
+   TTHREAD_TLS_SET(Int_t,tid,ttid);
+   TTHREAD_TLS_SET(Int_t,tidepoch,gGeoThreadsEpoch);
+   return ttid;
 }
    
 //_____________________________________________________________________________
@@ -1877,8 +2042,10 @@ Int_t TGeoManager::GetMaxXtruVert()
 //_____________________________________________________________________________
 Int_t TGeoManager::GetNumThreads()
 {
-// Returns number of threads that were set to use geometry.
-   return fgNumThreads;
+// Returns the number of thread ordinals handed out. Ordinals of exited threads
+// are reused, so this follows the number of threads using the geometry at the
+// same time rather than the number of threads ever started.
+   return -Int_t(gGeoThreadsCount.Get());
 }   
 
 //_____________________________________________________________________________
@@ -2723,23 +2890,100 @@ void TGeoManager::RestoreMasterVolume()
    if (fTopVolume == fMasterVolume) return;
    if (fMasterVolume) SetTopVolume(fMasterVolume);
 }
+namespace {
+   // Work shared between the voxelization threads
+   struct TGeoVoxelizeTask_t {
+      TGeoManager *fGeoManager;  // geometry being closed
+      TObjArray   *fVolumes;     // volumes to be voxelized
+      Option_t    *fOption;      // voxelization option
+      Int_t        fNext;        // index of the next volume to process
+   };
+}
+
 //_____________________________________________________________________________
 void TGeoManager::Voxelize(Option_t *option)
 {
-// Voxelize all non-divided volumes.
+// Voxelize all non-divided volumes. If more than one voxelization thread was
+// requested via SetVoxelizationThreads, the volumes are processed in
+// parallel. Assemblies and volumes having assembly daughters are processed
+// first, sequentially, since their bounding boxes depend on other volumes.
    TGeoVolume *vol;
 //   TGeoVoxelFinder *vox = 0;
-   if (!fStreamVoxels && fgVerboseLevel>0) Info("Voxelize","Voxelizing...");
+   if ((!fIsGeomReading || !fStreamVoxels) && fgVerboseLevel>0) Info("Voxelize","Voxelizing...");
 //   Int_t nentries = fVolumes->GetSize();
+   Int_t nthreads = fNvoxelThreads;
+   if (fStreamVoxels && fIsGeomReading) nthreads = 1;
+   TObjArray parallel;
    TIter next(fVolumes);
    while ((vol = (TGeoVolume*)next())) {
       if (!fIsGeomReading) vol->SortNodes();
-      if (!fStreamVoxels) {
-         vol->Voxelize(option);
+      if (nthreads>1 && !vol->IsAssembly()) {
+         Bool_t hasAssembly = kFALSE;
+         Int_t nd = vol->GetNdaughters();
+         for (Int_t i=0; i<nd; i++) {
+            if (vol->GetNode(i)->GetVolume()->IsAssembly()) {
+               hasAssembly = kTRUE;
+               break;
+            }
+         }
+         if (!hasAssembly) {
+            parallel.Add(vol);
+            continue;
+         }
       }
-      if (!fIsGeomReading) vol->FindOverlaps();
+      VoxelizeVolume(vol, option);
+   }
+   Int_t nvol = parallel.GetEntriesFast();
+   if (!nvol) return;
+   if (nthreads > nvol) nthreads = nvol;
+   if (fgVerboseLevel>0) Info("Voxelize","Voxelizing %d volumes using %d threads", nvol, nthreads);
+   TGeoVoxelizeTask_t task;
+   task.fGeoManager = this;
+   task.fVolumes = &parallel;
+   task.fOption = option;
+   task.fNext = 0;
+   TThread **threads = new TThread*[nthreads];
+   Int_t i;
+   for (i=0; i<nthreads; i++) {
+      threads[i] = new TThread(TGeoManager::VoxelizeLoop, (void*)&task);
+      threads[i]->Run();
+   }
+   for (i=0; i<nthreads; i++) {
+      threads[i]->Join();
+      delete threads[i];
+   }
+   delete [] threads;
+}
+
+//_____________________________________________________________________________
+void *TGeoManager::VoxelizeLoop(void *arg)
+{
+// Thread function voxelizing the volumes of a shared task until exhaustion.
+   TGeoVoxelizeTask_t *task = (TGeoVoxelizeTask_t*)arg;
+   Int_t nvol = task->fVolumes->GetEntriesFast();
+   while (1) {
+      TThread::Lock();
+      Int_t ivol = task->fNext++;
+      TThread::UnLock();
+      if (ivol >= nvol) break;
+      TGeoVolume *vol = (TGeoVolume*)task->fVolumes->UncheckedAt(ivol);
+      task->fGeoManager->VoxelizeVolume(vol, task->fOption);
    }
+   return 0;
 }
+
+//_____________________________________________________________________________
+void TGeoManager::VoxelizeVolume(TGeoVolume *vol, Option_t *option)
+{
+// Voxelize and find the overlaps of a single volume, having its nodes already
+// sorted. Only the volume itself and its nodes are modified.
+   // Voxels may have been retrieved from file
+   if (!fIsGeomReading || !fStreamVoxels) {
+      vol->Voxelize(option);
+   }
+   if (!fIsGeomReading) vol->FindOverlaps();
+}
+
 //_____________________________________________________________________________
 void TGeoManager::ModifiedPad() const
 {
@@ -55,6 +55,10 @@ TGeoNavigator::TGeoNavigator()
                fOverlapSize(0),
                fOverlapMark(0),
                fOverlapClusters(0),
+               fHistorySize(0),
+               fHistoryEntries(0),
+               fNhistoryHits(0),
+               fNhistoryMisses(0),
                fSearchOverlaps(kFALSE),
                fCurrentOverlapping(kFALSE),
                fStartSafe(kFALSE),
@@ -75,6 +79,7 @@ TGeoNavigator::TGeoNavigator()
                fNextNode(0),
                fForcedNode(0),
                fBackupState(0),
+               fHistory(0),
                fCurrentMatrix(0),
                fGlobalMatrix(0),
                fDivMatrix(0),
@@ -104,6 +109,10 @@ TGeoNavigator::TGeoNavigator(TGeoManager* geom)
                fOverlapSize(1000),
                fOverlapMark(0),
                fOverlapClusters(0),
+               fHistorySize(0),
+               fHistoryEntries(0),
+               fNhistoryHits(0),
+               fNhistoryMisses(0),
                fSearchOverlaps(kFALSE),
                fCurrentOverlapping(kFALSE),
                fStartSafe(kTRUE),
@@ -124,6 +133,7 @@ TGeoNavigator::TGeoNavigator(TGeoManager* geom)
                fNextNode(0),
                fForcedNode(0),
                fBackupState(0),
+               fHistory(0),
                fCurrentMatrix(0),
                fGlobalMatrix(0),
                fDivMatrix(0),
@@ -162,6 +172,10 @@ TGeoNavigator::TGeoNavigator(const TGeoNavigator& gm)
                fOverlapSize(gm.fOverlapSize),
                fOverlapMark(gm.fOverlapMark),
                fOverlapClusters(gm.fOverlapClusters),
+               fHistorySize(0),
+               fHistoryEntries(0),
+               fNhistoryHits(0),
+               fNhistoryMisses(0),
                fSearchOverlaps(gm.fSearchOverlaps),
                fCurrentOverlapping(gm.fCurrentOverlapping),
                fStartSafe(gm.fStartSafe),
@@ -182,6 +196,7 @@ TGeoNavigator::TGeoNavigator(const TGeoNavigator& gm)
                fNextNode(gm.fNextNode),
                fForcedNode(gm.fForcedNode),
                fBackupState(gm.fBackupState),
+               fHistory(0),
                fCurrentMatrix(gm.fCurrentMatrix),
                fGlobalMatrix(gm.fGlobalMatrix),
                fPath(gm.fPath)               
@@ -236,6 +251,11 @@ TGeoNavigator& TGeoNavigator::operator=(const TGeoNavigator& gm)
       fNextNode = gm.fNextNode;
       fForcedNode = gm.fForcedNode;
       fBackupState = gm.fBackupState;
+      fHistorySize = 0;
+      fHistoryEntries = 0;
+      fNhistoryHits = 0;
+      fNhistoryMisses = 0;
+      fHistory = 0;
       fCurrentMatrix = gm.fCurrentMatrix;
       fGlobalMatrix = gm.fGlobalMatrix;
       fPath = gm.fPath;
@@ -260,6 +280,7 @@ TGeoNavigator::~TGeoNavigator()
    if (fCache) delete fCache;
    if (fBackupState) delete fBackupState;
    if (fOverlapClusters) delete [] fOverlapClusters;
+   SetHistorySize(0);
 }
    
 //_____________________________________________________________________________
@@ -582,7 +603,10 @@ TGeoNode *TGeoNavigator::CrossBoundaryAndLocate(Bool_t downwards, TGeoNode *skip
    fPoint[0] += extra*fDirection[0];
    fPoint[1] += extra*fDirection[1];
    fPoint[2] += extra*fDirection[2];
-   TGeoNode *current = SearchNode(downwards, skipnode);
+   TGeoNode *current = 0;
+   // When exiting, try first the recently visited locations
+   if (!downwards && fHistoryEntries) current = RelocateFromHistory(skipnode);
+   if (!current) current = SearchNode(downwards, skipnode);
    fForcedNode = 0;
    fPoint[0] -= extra*fDirection[0];
    fPoint[1] -= extra*fDirection[1];
@@ -595,6 +619,7 @@ TGeoNode *TGeoNavigator::CrossBoundaryAndLocate(Bool_t downwards, TGeoNode *skip
          current = fCurrentNode;
          nextindex = fCurrentNode->GetVolume()->GetNextNodeIndex();
       }
+      if (fHistorySize) RecordHistory();
       return current;   
    }   
      
@@ -611,8 +636,101 @@ TGeoNode *TGeoNavigator::CrossBoundaryAndLocate(Bool_t downwards, TGeoNode *skip
       }
       return fCurrentNode;
    }
+   if (fHistorySize) RecordHistory();
    return current;
 }   
+
+//_____________________________________________________________________________
+TGeoNode *TGeoNavigator::RelocateFromHistory(const TGeoNode *skipnode)
+{
+// Try to locate the current point, just pushed across the boundary of
+// SKIPNODE, in one of the recently visited states. The stored global matrix
+// is used directly, so neither the path matrices nor the voxels of the mother
+// volumes need to be recomputed. If the point is found inside a stored node,
+// the state is restored and the search continues only downwards from there.
+// Returns 0 if no stored state contains the point.
+   if (fNmany || fGeometry->IsActivityEnabled()) return 0;
+   // Cache states are restored through the current navigator
+   if (fGeometry->GetCurrentNavigator() != this) return 0;
+   Double_t local[3];
+   for (Int_t i=0; i<fHistoryEntries; i++) {
+      TGeoCacheState *state = fHistory[i];
+      TGeoNode *node = state->GetNode();
+      if (node == skipnode) continue;
+      TGeoVolume *vol = node->GetVolume();
+      if (vol->IsAssembly()) continue;
+      state->GetMatrix()->MasterToLocal(fPoint, local);
+      if (!vol->Contains(local)) continue;
+      fNhistoryHits++;
+      fCurrentOverlapping = fCache->RestoreState(fNmany, state);
+      fCurrentNode = fCache->GetNode();
+      fGlobalMatrix = fCache->GetCurrentMatrix();
+      fLevel = fCache->GetLevel();
+      // Make the divisions on the restored branch point to the stored cells
+      TGeoNode **branch = (TGeoNode**)fCache->GetBranch();
+      for (Int_t level=1; level<=fLevel; level++) {
+         Int_t idiv = state->GetDivIndex(level);
+         if (idiv<0) continue;
+         TGeoPatternFinder *finder = branch[level]->GetFinder();
+         finder->cd(idiv-finder->GetDivIndex());
+      }
+      fIsSameLocation = kFALSE;
+      fNextDaughterIndex = -2;
+      if (!vol->GetNdaughters()) return fCurrentNode;
+      return SearchNode(kTRUE, skipnode);
+   }
+   fNhistoryMisses++;
+   return 0;
+}
+
+//_____________________________________________________________________________
+void TGeoNavigator::RecordHistory()
+{
+// Store the current state as the most recent one in the navigation history.
+// States that are already stored are just moved in front, otherwise the least
+// recently used one is replaced. States having overlapping nodes on their
+// branch are not stored.
+   if (!fHistorySize || fIsOutside || fNmany || !fCurrentNode) return;
+   if (fGeometry->GetCurrentNavigator() != this) return;
+   TGeoNode **branch = (TGeoNode**)fCache->GetBranch();
+   Int_t i;
+   for (i=0; i<fHistoryEntries; i++) {
+      if (fHistory[i]->IsSameBranch(fLevel, branch)) break;
+   }
+   if (i==0 && fHistoryEntries) return;
+   Bool_t found = (i<fHistoryEntries)?kTRUE:kFALSE;
+   if (!found) {
+      if (fHistoryEntries<fHistorySize) fHistoryEntries++;
+      i = fHistoryEntries-1;
+   }   
+   TGeoCacheState *state = fHistory[i];
+   for (; i>0; i--) fHistory[i] = fHistory[i-1];
+   fHistory[0] = state;
+   if (!found) state->SetState(fLevel, 0, fNmany, fCurrentOverlapping);
+}
+
+//_____________________________________________________________________________
+void TGeoNavigator::SetHistorySize(Int_t nstates)
+{
+// Set the number of recently visited states kept by the navigator. When a
+// track exits a node, these states are checked first before searching the
+// geometry tree upwards, which saves most of the voxel lookups for tracks
+// moving around in a small region (e.g. showers in calorimeter cells). Use
+// GetHistoryHits/GetHistoryMisses to monitor the efficiency. A size of 0
+// (default) disables the history.
+   if (fHistory) {
+      for (Int_t i=0; i<fHistorySize; i++) delete fHistory[i];
+      delete [] fHistory;
+      fHistory = 0;
+   }
+   fHistorySize = (nstates>0)?nstates:0;
+   fHistoryEntries = 0;
+   if (!fHistorySize) return;
+   Int_t nlevel = fGeometry->GetMaxLevel();
+   if (nlevel<=0) nlevel = 100;
+   fHistory = new TGeoCacheState*[fHistorySize];
+   for (Int_t i=0; i<fHistorySize; i++) fHistory[i] = new TGeoCacheState(nlevel+1);
+}
    
 //_____________________________________________________________________________
 TGeoNode *TGeoNavigator::FindNextBoundary(Double_t stepmax, const char *path, Bool_t frombdr)
@@ -2444,6 +2562,8 @@ void TGeoNavigator::ResetAll()
       fCache = 0;
       BuildCache(dummy,nodeid);
    }
+   // History states are sized according to the geometry depth
+   if (fHistorySize) SetHistorySize(fHistorySize);
 }
 
 ClassImp(TGeoNavigatorArray)
@@ -69,57 +69,35 @@ TGeoPatternFinder::ThreadData_t::~ThreadData_t()
 //______________________________________________________________________________
 TGeoPatternFinder::ThreadData_t& TGeoPatternFinder::GetThreadData() const
 {
+// Get the data of the calling thread, allocating it on first use. Slots for
+// new thread ordinals are appended without moving the existing ones, so each
+// thread only writes its own slot.
    Int_t tid = TGeoManager::ThreadId();
-/*
-   if (tid >= fThreadSize) {
-      Error("GetThreadData", "Thread id=%d bigger than maximum declared thread number %d. \nUse TGeoManager::SetMaxThreads properly !!!",
-             tid, fThreadSize);
-   }          
-
-   TThread::Lock();
-   if (tid >= fThreadSize)
-   {
-      fThreadData.resize(tid + 1);
-      fThreadSize = tid + 1;
+   ThreadData_t *td = (ThreadData_t*)fThreadData.Get(tid);
+   if (!td) {
+      td = new ThreadData_t;
+      td->fMatrix = CreateMatrix();
+      fThreadData.At(tid) = td;
    }
-   if (fThreadData[tid] == 0)
-   {
-      fThreadData[tid] = new ThreadData_t;
-      fThreadData[tid]->fMatrix = CreateMatrix();
-   }
-   TThread::UnLock();
-*/
-   return *fThreadData[tid];
+   return *td;
 }
 
 //______________________________________________________________________________
 void TGeoPatternFinder::ClearThreadData() const
 {
    TThread::Lock();
-   std::vector<ThreadData_t*>::iterator i = fThreadData.begin();
-   while (i != fThreadData.end())
-   {
-      delete *i;
-      ++i;
-   }
-   fThreadData.clear();
-   fThreadSize = 0;
+   for (Int_t tid=0; tid<fThreadData.GetSize(); tid++) delete (ThreadData_t*)fThreadData.Get(tid);
+   fThreadData.Clear();
    TThread::UnLock();
 }
 
 //______________________________________________________________________________
 void TGeoPatternFinder::CreateThreadData(Int_t nthreads)
 {
-// Create thread data for n threads max.
+// Reserve thread data slots for n threads. The data is created lazily and
+// further slots are added for higher thread ordinals.
    TThread::Lock();
-   fThreadData.resize(nthreads);
-   fThreadSize = nthreads;
-   for (Int_t tid=0; tid<nthreads; tid++) {
-      if (fThreadData[tid] == 0) {
-         fThreadData[tid] = new ThreadData_t;
-         fThreadData[tid]->fMatrix = CreateMatrix();
-      }
-   }   
+   fThreadData.Reserve(nthreads);
    TThread::UnLock();
 }
 
@@ -133,7 +111,6 @@ TGeoPatternFinder::TGeoPatternFinder()
    fStart      = 0;
    fEnd        = 0;
    fVolume     = 0;
-   fThreadSize = 0;
 }
 
 //_____________________________________________________________________________
@@ -146,7 +123,6 @@ TGeoPatternFinder::TGeoPatternFinder(TGeoVolume *vol, Int_t ndiv)
    fStep       = 0;
    fStart      = 0;
    fEnd        = 0;
-   fThreadSize = 0;
 }
 
 //_____________________________________________________________________________
@@ -157,7 +133,8 @@ TGeoPatternFinder::TGeoPatternFinder(const TGeoPatternFinder& pf) :
   fEnd(pf.fEnd),
   fNdivisions(pf.fNdivisions),
   fDivIndex(pf.fDivIndex),
-  fVolume(pf.fVolume)
+  fVolume(pf.fVolume),
+  fThreadData()
 { 
    //copy constructor
 }
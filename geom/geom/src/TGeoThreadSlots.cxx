@@ -0,0 +1,71 @@
+// @(#)root/geom:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2000, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+// TGeoThreadSlots
+//
+//   Pointers to thread private data, indexed by the thread ordinal returned
+// by TGeoManager::ThreadId. The slots are kept in a chain of fixed size
+// blocks. Blocks are only appended, never moved or freed while threads are
+// running, so a thread can read and write its own slot without lock while
+// another thread appends blocks for higher ordinals. Appending is done
+// under TThread::Lock. The pointed objects are owned by the caller.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "TGeoThreadSlots.h"
+#include "TThread.h"
+
+//______________________________________________________________________________
+void *&TGeoThreadSlots::At(Int_t tid)
+{
+// Slot of thread tid, the blocks up to this thread are created if needed.
+   if (tid >= fSize) Reserve(tid+1);
+   Block_t *block = fFirst;
+   for (; tid >= kBlockSize; tid -= kBlockSize) block = block->fNext;
+   return block->fSlot[tid];
+}
+
+//______________________________________________________________________________
+void TGeoThreadSlots::Clear()
+{
+// Delete all blocks. The pointed objects must have been deleted by the
+// owner and no thread may use the slots any more.
+   while (fFirst) {
+      Block_t *next = fFirst->fNext;
+      delete fFirst;
+      fFirst = next;
+   }
+   fSize = 0;
+}
+
+//______________________________________________________________________________
+void TGeoThreadSlots::Reserve(Int_t nthreads)
+{
+// Create the blocks for nthreads threads. A new block is fully initialized
+// before it is linked to the chain.
+   if (nthreads <= fSize) return;
+   TThread::Lock();
+   Block_t **last = &fFirst;
+   Int_t size = 0;
+   while (*last) {
+      last = &(*last)->fNext;
+      size += kBlockSize;
+   }
+   while (size < nthreads) {
+      Block_t *block = new Block_t;
+      for (Int_t i=0; i<kBlockSize; i++) block->fSlot[i] = 0;
+      block->fNext = 0;
+      *last = block;
+      last = &block->fNext;
+      size += kBlockSize;
+   }
+   fSize = size;
+   TThread::UnLock();
+}
@@ -355,6 +355,7 @@
 #include "TGeoScaledShape.h"
 #include "TGeoCompositeShape.h"
 #include "TGeoVoxelFinder.h"
+#include "TGeoBVHFinder.h"
 
 ClassImp(TGeoVolume)
 
@@ -1590,7 +1591,8 @@ TGeoVolume *TGeoVolume::CloneVolume() const
    // copy voxels
    TGeoVoxelFinder *voxels = 0;
    if (fVoxels) {
-      voxels = new TGeoVoxelFinder(vol);
+      if (fVoxels->InheritsFrom(TGeoBVHFinder::Class())) voxels = new TGeoBVHFinder(vol);
+      else                                                voxels = new TGeoVoxelFinder(vol);
       vol->SetVoxelFinder(voxels);
    }   
    // copy option, uid
@@ -2129,8 +2131,10 @@ void TGeoVolume::Voxelize(Option_t *option)
       if (!TObject::TestBit(kVolumeClone)) delete fVoxels;
       fVoxels = 0;
    }   
-   // Create the voxels structure
-   fVoxels = new TGeoVoxelFinder(this);
+   // Create the voxels structure. A bounding volume hierarchy is used instead
+   // of slices if requested for this volume or for the whole geometry.
+   if (IsBVHVoxels() || fGeoManager->IsUsingBVH()) fVoxels = new TGeoBVHFinder(this);
+   else                                             fVoxels = new TGeoVoxelFinder(this);
    fVoxels->Voxelize(option);
    if (fVoxels) {
       if (fVoxels->IsInvalid()) {
@@ -2524,20 +2528,16 @@ TGeoVolumeAssembly::ThreadData_t::~ThreadData_t()
 //______________________________________________________________________________
 TGeoVolumeAssembly::ThreadData_t& TGeoVolumeAssembly::GetThreadData() const
 {
+// Get the data of the calling thread, allocating it on first use. Slots for
+// new thread ordinals are appended without moving the existing ones, so each
+// thread only writes its own slot.
    Int_t tid = TGeoManager::ThreadId();
-/*
-   TThread::Lock();
-   if (tid >= fThreadSize)
-   {
-      Error("GetThreadData", "Thread id=%d bigger than maximum declared thread number %d. \nUse TGeoManager::SetMaxThreads properly !!!",
-             tid, fThreadSize);        
-      fThreadData.resize(tid + 1);
-      fThreadSize = tid + 1;
+   ThreadData_t *td = (ThreadData_t*)fThreadData.Get(tid);
+   if (!td) {
+      td = new ThreadData_t;
+      fThreadData.At(tid) = td;
    }
-   if (fThreadData[tid] == 0) fThreadData[tid] = new ThreadData_t;
-   TThread::UnLock();
-*/
-   return *fThreadData[tid];
+   return *td;
 }
 
 //______________________________________________________________________________
@@ -2545,29 +2545,18 @@ void TGeoVolumeAssembly::ClearThreadData() const
 {
    TThread::Lock();
    TGeoVolume::ClearThreadData();
-   std::vector<ThreadData_t*>::iterator i = fThreadData.begin();
-   while (i != fThreadData.end())
-   {
-      delete *i;
-      ++i;
-   }
-   fThreadData.clear();
-   fThreadSize = 0;
+   for (Int_t tid=0; tid<fThreadData.GetSize(); tid++) delete (ThreadData_t*)fThreadData.Get(tid);
+   fThreadData.Clear();
    TThread::UnLock();
 }
 
 //______________________________________________________________________________
 void TGeoVolumeAssembly::CreateThreadData(Int_t nthreads)
 {
+// Reserve thread data slots for n threads. The data is created lazily and
+// further slots are added for higher thread ordinals.
    TThread::Lock();
-   // Create assembly thread data here
-   fThreadData.resize(nthreads);
-   fThreadSize = nthreads;
-   for (Int_t tid=0; tid<nthreads; tid++) {
-      if (fThreadData[tid] == 0) {
-         fThreadData[tid] = new ThreadData_t;
-      }
-   } 
+   fThreadData.Reserve(nthreads);
    TGeoVolume:: CreateThreadData(nthreads);
    TThread::UnLock();
 }
@@ -2575,25 +2564,25 @@ void TGeoVolumeAssembly::CreateThreadData(Int_t nthreads)
 //______________________________________________________________________________
 Int_t TGeoVolumeAssembly::GetCurrentNodeIndex() const
 {
-   return fThreadData[TGeoManager::ThreadId()]->fCurrent;
+   return GetThreadData().fCurrent;
 }
 
 //______________________________________________________________________________
 Int_t TGeoVolumeAssembly::GetNextNodeIndex() const
 {
-   return fThreadData[TGeoManager::ThreadId()]->fNext;
+   return GetThreadData().fNext;
 }
 
 //______________________________________________________________________________
 void TGeoVolumeAssembly::SetCurrentNodeIndex(Int_t index)
 {
-   fThreadData[TGeoManager::ThreadId()]->fCurrent = index;
+   GetThreadData().fCurrent = index;
 }
 
 //______________________________________________________________________________
 void TGeoVolumeAssembly::SetNextNodeIndex(Int_t index)
 {
-   fThreadData[TGeoManager::ThreadId()]->fNext = index;
+   GetThreadData().fNext = index;
 }
 
 //_____________________________________________________________________________
@@ -2601,7 +2590,6 @@ TGeoVolumeAssembly::TGeoVolumeAssembly()
                    :TGeoVolume()
 {
 // Default constructor
-   fThreadSize = 0;
    CreateThreadData(1);
 }
 
@@ -2615,7 +2603,6 @@ TGeoVolumeAssembly::TGeoVolumeAssembly(const char *name)
    fName = fName.Strip();
    fShape = new TGeoShapeAssembly(this);
    if (fGeoManager) fNumber = fGeoManager->AddVolume(this);
-   fThreadSize = 0;
    CreateThreadData(1);
 }
 
@@ -2670,7 +2657,8 @@ TGeoVolume *TGeoVolumeAssembly::CloneVolume() const
    // copy voxels
    TGeoVoxelFinder *voxels = 0;
    if (fVoxels) {
-      voxels = new TGeoVoxelFinder(vol);
+      if (fVoxels->InheritsFrom(TGeoBVHFinder::Class())) voxels = new TGeoBVHFinder(vol);
+      else                                                voxels = new TGeoVoxelFinder(vol);
       vol->SetVoxelFinder(voxels);
    }   
    // copy option, uid
@@ -2751,7 +2739,8 @@ TGeoVolumeAssembly *TGeoVolumeAssembly::MakeAssemblyFromVolume(TGeoVolume *volor
    // copy voxels
    TGeoVoxelFinder *voxels = 0;
    if (volorig->GetVoxels()) {
-      voxels = new TGeoVoxelFinder(vol);
+      if (volorig->GetVoxels()->InheritsFrom(TGeoBVHFinder::Class())) voxels = new TGeoBVHFinder(vol);
+      else                                                            voxels = new TGeoVoxelFinder(vol);
       vol->SetVoxelFinder(voxels);
    }   
    // copy option, uid
@@ -82,76 +82,42 @@ TGeoXtru::ThreadData_t::~ThreadData_t()
 //______________________________________________________________________________
 TGeoXtru::ThreadData_t& TGeoXtru::GetThreadData() const
 {
-   if (!fThreadSize) ((TGeoXtru*)this)->CreateThreadData(1);
+// Get the data of the calling thread, allocating it on first use. Slots for
+// new thread ordinals are appended without moving the existing ones, so each
+// thread only writes its own slot.
    Int_t tid = TGeoManager::ThreadId();
-/*
-   TThread::Lock();
-   if (tid >= fThreadSize) {
-      Error("GetThreadData", "Thread id=%d bigger than maximum declared thread number %d. \nUse TGeoManager::SetMaxThreads properly !!!",
-             tid, fThreadSize);
-   }          
-   if (tid >= fThreadSize)
-   {
-      fThreadData.resize(tid + 1);
-      fThreadSize = tid + 1;
-   }
-   if (fThreadData[tid] == 0)
-   {
-      fThreadData[tid] = new ThreadData_t;
-      ThreadData_t &td = *fThreadData[tid];
-
-      td.fXc = new Double_t [fNvert];
-      td.fYc = new Double_t [fNvert];
-      memcpy(td.fXc, fX, fNvert*sizeof(Double_t));
-      memcpy(td.fYc, fY, fNvert*sizeof(Double_t));
-      td.fPoly = new TGeoPolygon(fNvert);
-      td.fPoly->SetXY(td.fXc, td.fYc); // initialize with current coordinates
-      td.fPoly->FinishPolygon();
-      if (tid == 0 && td.fPoly->IsIllegalCheck()) {
+   ThreadData_t *td = (ThreadData_t*)fThreadData.Get(tid);
+   if (!td) {
+      td = new ThreadData_t;
+      td->fXc = new Double_t [fNvert];
+      td->fYc = new Double_t [fNvert];
+      memcpy(td->fXc, fX, fNvert*sizeof(Double_t));
+      memcpy(td->fYc, fY, fNvert*sizeof(Double_t));
+      td->fPoly = new TGeoPolygon(fNvert);
+      td->fPoly->SetXY(td->fXc, td->fYc); // initialize with current coordinates
+      td->fPoly->FinishPolygon();
+      if (tid == 0 && td->fPoly->IsIllegalCheck()) {
          Error("DefinePolygon", "Shape %s of type XTRU has an illegal polygon.", GetName());
       }      
+      fThreadData.At(tid) = td;
    }
-   TThread::UnLock();
-*/
-   return *fThreadData[tid];
+   return *td;
 }
 
 //______________________________________________________________________________
 void TGeoXtru::ClearThreadData() const
 {
-   std::vector<ThreadData_t*>::iterator i = fThreadData.begin();
-   while (i != fThreadData.end())
-   {
-      delete *i;
-      ++i;
-   }
-   fThreadData.clear();
-   fThreadSize = 0;
+   for (Int_t tid=0; tid<fThreadData.GetSize(); tid++) delete (ThreadData_t*)fThreadData.Get(tid);
+   fThreadData.Clear();
 }
 
 //______________________________________________________________________________
 void TGeoXtru::CreateThreadData(Int_t nthreads)
 {
-// Create thread data for n threads max.
+// Reserve thread data slots for n threads. The data is created lazily and
+// further slots are added for higher thread ordinals.
    TThread::Lock();
-   fThreadData.resize(nthreads);
-   fThreadSize = nthreads;
-   for (Int_t tid=0; tid<nthreads; tid++) {
-      if (fThreadData[tid] == 0) {
-         fThreadData[tid] = new ThreadData_t;
-         ThreadData_t &td = *fThreadData[tid];
-         td.fXc = new Double_t [fNvert];
-         td.fYc = new Double_t [fNvert];
-         memcpy(td.fXc, fX, fNvert*sizeof(Double_t));
-         memcpy(td.fYc, fY, fNvert*sizeof(Double_t));
-         td.fPoly = new TGeoPolygon(fNvert);
-         td.fPoly->SetXY(td.fXc, td.fYc); // initialize with current coordinates
-         td.fPoly->FinishPolygon();
-         if (tid == 0 && td.fPoly->IsIllegalCheck()) {
-            Error("DefinePolygon", "Shape %s of type XTRU has an illegal polygon.", GetName());
-         }      
-      }
-   }   
+   fThreadData.Reserve(nthreads);
    TThread::UnLock();
 }
 
@@ -182,8 +148,7 @@ TGeoXtru::TGeoXtru()
           fScale(0),
           fX0(0),
           fY0(0),
-          fThreadData(0),
-          fThreadSize(0)
+          fThreadData()
 {
 // dummy ctor
    SetShapeBit(TGeoShape::kGeoXtru);
@@ -201,8 +166,7 @@ TGeoXtru::TGeoXtru(Int_t nz)
           fScale(new Double_t[nz]),
           fX0(new Double_t[nz]),
           fY0(new Double_t[nz]),
-          fThreadData(0),
-          fThreadSize(0)         
+          fThreadData()
 {
 // Default constructor
    SetShapeBit(TGeoShape::kGeoXtru);
@@ -225,8 +189,7 @@ TGeoXtru::TGeoXtru(Double_t *param)
           fScale(0),
           fX0(0),
           fY0(0),
-          fThreadData(0),
-          fThreadSize(0)         
+          fThreadData()
 {
 // Default constructor in GEANT3 style
 // param[0] = nz  // number of z planes
@@ -256,8 +219,7 @@ TGeoXtru::TGeoXtru(const TGeoXtru& xt) :
   fScale(0),
   fX0(0),
   fY0(0),
-  fThreadData(0),
-  fThreadSize(0)
+  fThreadData()
 { 
    //copy constructor
 }
@@ -277,7 +239,6 @@ TGeoXtru& TGeoXtru::operator=(const TGeoXtru& xt)
       fScale=0;
       fX0=0;
       fY0=0;
-      fThreadSize=0;
    } 
    return *this;
 }
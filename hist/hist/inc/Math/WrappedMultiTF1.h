@@ -124,6 +124,9 @@ private:
       return fFunc->EvalPar(x,p); 
    }
 
+   /// evaluate function on a batch of points (direct implementation for the 1D built-in functions)
+   void DoEvalParVec(unsigned int n, const double * const * x, unsigned int stride, const double * p, double * fval) const; 
+
    /// evaluate the partial derivative with respect to the parameter
    double DoParameterDerivative(const double * x, const double * p, unsigned int ipar) const; 
 
@@ -137,6 +137,9 @@ private:
       return fFunc->EvalPar(fX, p ); 
    }
 
+   /// evaluate function on a batch of points (direct implementation for the built-in functions)
+   void DoEvalParVec(unsigned int n, const double * x, unsigned int stride, const double * p, double * fval) const; 
+
    /// return the function derivatives w.r.t. x 
    double DoDerivative( double  x  ) const;
 
@@ -12,6 +12,7 @@
 
 #include "Math/WrappedTF1.h"
 #include "Math/WrappedMultiTF1.h"
+#include "TMath.h"
 
 #include <cmath>
 
@@ -24,6 +25,73 @@ namespace Math {
 double WrappedTF1::fgEps      = 0.001; 
 double WrappedMultiTF1::fgEps = 0.001; 
 
+namespace { 
+
+bool EvalBuiltinParVec(TF1 & f, unsigned int n, const double * x, unsigned int stride, const double * p, double * fval) { 
+   // evaluate on a batch of points the one-dimensional built-in functions of TFormula 
+   // (gaus, expo, landau and polN), using the same expressions as TFormula::EvalPar, but 
+   // without the formula interpreter and with loops which can be vectorized by the compiler.
+   // Return false if the function is not one of them 
+
+   if (f.GetMethodCall() || f.GetNdim() != 1) return false; 
+   int number = f.GetNumber(); 
+   if (number == 100 && f.GetNpar() == 3) { 
+      // gaus (or gausn): same as p[0]*TMath::Gaus(x,p[1],p[2],norm) 
+      double constant = p[0]; 
+      double mean = p[1]; 
+      double sigma = p[2]; 
+      if (sigma == 0) { 
+         for (unsigned int i = 0; i < n; ++i) fval[i] = constant * 1.e30; 
+         return true; 
+      }
+      if (f.IsNormalized() ) { 
+         double norm = 2.50662827463100024*sigma; //sqrt(2*Pi)=2.50662827463100024
+         for (unsigned int i = 0; i < n; ++i) { 
+            double arg = (x[i*stride]-mean)/sigma; 
+            fval[i] = constant * (std::exp(-0.5*arg*arg)/norm); 
+         }
+      }
+      else { 
+         for (unsigned int i = 0; i < n; ++i) { 
+            double arg = (x[i*stride]-mean)/sigma; 
+            fval[i] = constant * std::exp(-0.5*arg*arg); 
+         }
+      }
+      return true; 
+   }
+   if (number == 200 && f.GetNpar() == 2) { 
+      // expo 
+      for (unsigned int i = 0; i < n; ++i) 
+         fval[i] = std::exp(p[0]+p[1]*x[i*stride]); 
+      return true; 
+   }
+   if (number >= 300 && number < 310 && f.GetNpar() == number - 299) { 
+      // polN: sum the terms in the same order as TFormula 
+      int npar = f.GetNpar(); 
+      for (unsigned int i = 0; i < n; ++i) { 
+         double xx = x[i*stride]; 
+         double result = 0; 
+         double xpow = 1; 
+         for (int j = 0; j < npar; ++j) { 
+            result += xpow*p[j]; 
+            xpow *= xx; 
+         }
+         fval[i] = result; 
+      }
+      return true; 
+   }
+   if (number == 400 && f.GetNpar() == 3) { 
+      // landau (or landaun) 
+      bool norm = f.IsNormalized(); 
+      for (unsigned int i = 0; i < n; ++i) 
+         fval[i] = p[0]*TMath::Landau(x[i*stride],p[1],p[2],norm); 
+      return true; 
+   }
+   return false; 
+}
+
+}
+
 
 WrappedTF1::WrappedTF1 ( TF1 & f  )  : 
    fLinear(false), 
@@ -124,6 +192,14 @@ double WrappedTF1::DoParameterDerivative(double x, const double * p, unsigned in
    }
 }
 
+void WrappedTF1::DoEvalParVec(unsigned int n, const double * x, unsigned int stride, const double * p, double * fval) const { 
+   // evaluate the function on a batch of points 
+   // use a direct implementation for the built-in functions (gaus, expo, landau and polN)
+   if (EvalBuiltinParVec(*fFunc, n, x, stride, p, fval) ) return; 
+   for (unsigned int i = 0; i < n; ++i) 
+      fval[i] = DoEvalPar(x[i*stride], p); 
+}
+
 void WrappedTF1::SetDerivPrecision(double eps) { fgEps = eps; }
 
 double WrappedTF1::GetDerivPrecision( ) { return fgEps; }
@@ -230,6 +306,18 @@ double WrappedMultiTF1::DoParameterDerivative(const double * x, const double * p
    }
 }
 
+void WrappedMultiTF1::DoEvalParVec(unsigned int n, const double * const * x, unsigned int stride, const double * p, double * fval) const { 
+   // evaluate the function on a batch of points 
+   // use a direct implementation for the one-dimensional built-in functions (gaus, expo, landau and polN)
+   if (fDim == 1 && EvalBuiltinParVec(*fFunc, n, x[0], stride, p, fval) ) return; 
+   std::vector<double> xc(fDim); 
+   for (unsigned int i = 0; i < n; ++i) { 
+      for (unsigned int j = 0; j < fDim; ++j) 
+         xc[j] = x[j][i*stride]; 
+      fval[i] = DoEvalPar(&xc.front(), p); 
+   }
+}
+
 void WrappedMultiTF1::SetDerivPrecision(double eps) { fgEps = eps; }
 
 double WrappedMultiTF1::GetDerivPrecision( ) { return fgEps; }
@@ -49,6 +49,9 @@ namespace ROOT {
               In general is found to be more efficient to copy the data. 
               In case of really large data sets for limiting memory consumption then the other option can be used
               Specialized constructor exists for data up to 3 dimensions. 
+              The copied data are stored by point; after having inserted all the points they can be 
+              re-arranged by column (one aligned array for each coordinate, value and error) using 
+              StoreByColumns. This is convenient for evaluating the model function on batches of points. 
 
               When the data are copying in the number of points can be set later (or re-set) using Initialize and 
               the data are inserted one by one using the Add method. 
@@ -157,9 +160,25 @@ public :
     */
    unsigned int DataSize() const { 
       if (fDataVector) return fDataVector->Size(); 
+      if (fDataColumns) return fDataColumns->Size() * fPointSize; 
       return 0; 
    }
 
+   /**
+      re-arrange the copied data by column: an array (aligned for vectorized access) is created for each 
+      coordinate, for the value and for the errors and the data vector stored by point is released. 
+      The stored values are not changed, so the results of the fits are the same. 
+      Return false in case of external data (which are already accessed by column). 
+      Points cannot be added when the data are stored by column; Initialize and Resize 
+      re-arrange them by point.
+    */
+   bool StoreByColumns(); 
+
+   /**
+      query if the data are stored by columns
+    */
+   bool HasColumns() const { return fDataColumns != 0; }
+
    /**
       flag to control if data provides error on the coordinates
     */
@@ -226,16 +245,37 @@ public :
    const double * Coords(unsigned int ipoint) const { 
       if (fDataVector) 
          return &((fDataVector->Data())[ ipoint*fPointSize ] );
+      if (fDataColumns) 
+         return (fDim == 1) ? fDataColumns->Column(0) + ipoint : ColumnPoint(ipoint); 
       
       return fDataWrapper->Coords(ipoint);
    }
 
+   /**
+      fill x (array of size NDim()) with the pointers to the coordinates of the point ipoint. 
+      The coordinate icoord of the point ipoint+k is x[icoord][k*stride], where stride is 
+      the returned value. Used for evaluating the model function on a batch of points 
+    */
+   unsigned int CoordArrays(unsigned int ipoint, const double ** x) const { 
+      if (fDataVector) { 
+         const double * xp = &((fDataVector->Data())[ ipoint*fPointSize ] );
+         for (unsigned int icoord = 0; icoord < fDim; ++icoord) 
+            x[icoord] = xp + icoord; 
+         return fPointSize; 
+      }
+      for (unsigned int icoord = 0; icoord < fDim; ++icoord) 
+         x[icoord] = (fDataColumns) ? fDataColumns->Column(icoord) + ipoint : fDataWrapper->CoordArray(icoord) + ipoint; 
+      return 1; 
+   }
+
    /**
       return the value for the given fit point
     */
    double Value(unsigned int ipoint) const { 
       if (fDataVector)       
          return (fDataVector->Data())[ ipoint*fPointSize + fDim ];
+      if (fDataColumns) 
+         return fDataColumns->Column(fDim)[ipoint]; 
      
       return fDataWrapper->Value(ipoint);
    }
@@ -260,6 +300,16 @@ public :
          }
          return eval; // case of coord errors
       }
+      if (fDataColumns) { 
+         ErrorType type = GetErrorType(); 
+         if (type == kNoError ) return 1; 
+         double eval = fDataColumns->Column(fPointSize-1)[ipoint]; 
+         if (type == kValueError ) 
+            return eval != 0 ? 1.0/eval : 0; 
+         else if (type == kAsymError) 
+            return 0.5 * (fDataColumns->Column(fPointSize-2)[ipoint] + eval); 
+         return eval; 
+      }
 
       return fDataWrapper->Error(ipoint);
    } 
@@ -278,6 +328,8 @@ public :
 //          // when error in the coordinate is stored, need to invert it 
 //          return eval != 0 ? 1.0/eval : 0; 
       }
+      if (fDataColumns) 
+         return fDataColumns->Column(fPointSize-1)[ipoint]; 
       //case data wrapper 
 
       double eval = fDataWrapper->Error(ipoint);
@@ -293,6 +345,8 @@ public :
          // error on the value is the last element in the point structure
          return  &(fDataVector->Data())[ (ipoint)*fPointSize + fDim + 1];
       }
+      if (fDataColumns) 
+         return ColumnPoint(ipoint) + fDim + 1; 
 
       return fDataWrapper->CoordErrors(ipoint);
    }
@@ -309,6 +363,10 @@ public :
          value = v[j+fDim];
          return x;
       } 
+      if (fDataColumns) { 
+         value = fDataColumns->Column(fDim)[ipoint]; 
+         return Coords(ipoint); 
+      }
       value = fDataWrapper->Value(ipoint);
       return fDataWrapper->Coords(ipoint);
    }
@@ -335,6 +393,17 @@ public :
 
          return x;
       } 
+      if (fDataColumns) { 
+         value = fDataColumns->Column(fDim)[ipoint]; 
+         if (fPointSize == fDim +1) 
+            invError = 1;
+         else if (fPointSize == fDim +2) 
+            invError = fDataColumns->Column(fDim+1)[ipoint]; 
+         else 
+            assert(0); // cannot be here
+
+         return Coords(ipoint); 
+      }
       value = fDataWrapper->Value(ipoint);
       double e = fDataWrapper->Error(ipoint);
       invError = ( e > 0 ) ? 1.0/e : 1.0; 
@@ -355,6 +424,12 @@ public :
          errvalue = v[j + 2*fDim +1];
          return ex;
       } 
+      if (fDataColumns) { 
+         assert(fPointSize > fDim + 2); 
+         const double * point = ColumnPoint(ipoint); 
+         errvalue = point[2*fDim +1]; 
+         return point + fDim + 1; 
+      }
       errvalue = fDataWrapper->Error(ipoint);
       return fDataWrapper->CoordErrors(ipoint);
    }
@@ -367,9 +442,15 @@ public :
    */
    const double * GetPointError(unsigned int ipoint, double & errlow, double & errhigh) const {
       // external data is not supported for asymmetric errors
-      assert(fDataVector); 
+      assert(fDataVector || fDataColumns); 
 
       assert(fPointSize > 2 * fDim + 2); 
+      if (fDataColumns) { 
+         const double * point = ColumnPoint(ipoint); 
+         errlow  = point[2*fDim +1]; 
+         errhigh = point[2*fDim +2]; 
+         return point + fDim + 1; 
+      }
       unsigned int j = ipoint*fPointSize;
       const std::vector<double> & v = (fDataVector->Data());
       const double * ex = &v[j+fDim+1];
@@ -516,6 +597,16 @@ protected:
 
 private: 
 
+   /// copy all the values of the point ipoint from the columns in a contiguous (cached) array
+   const double * ColumnPoint(unsigned int ipoint) const { 
+      for (unsigned int k = 0; k < fPointSize; ++k) 
+         fPointCache[k] = fDataColumns->Column(k)[ipoint]; 
+      return &fPointCache.front(); 
+   }
+
+   /// re-arrange the data stored by column in a data vector by point (needed to add points) 
+   void StoreByPoints(); 
+
 
    unsigned int fDim;       // coordinate dimension
    unsigned int fPointSize; // total point size including value and errors (= fDim + 2 for error in only Y ) 
@@ -526,6 +617,9 @@ private:
 
    DataVector * fDataVector;  // pointer to the copied in data vector
    DataWrapper * fDataWrapper;  // pointer to the external data wrapper structure
+   DataColumns * fDataColumns;  //! pointer to the copied in data stored by columns
+
+   mutable std::vector<double> fPointCache;  //! cached point returned when the data are stored by columns
 
    std::vector<double> fBinEdge;  // vector containing the bin upper edge (coordinate will contain low edge) 
 
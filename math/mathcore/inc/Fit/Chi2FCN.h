@@ -82,6 +82,7 @@ public:
       fData(data), 
       fFunc(func), 
       fNEffPoints(0),
+      fNThreads(1),
       fGrad ( std::vector<double> ( func.NPar() ) )
    { }
 
@@ -111,6 +112,7 @@ public:
    virtual BaseFunction * Clone() const { 
       // clone the function
       Chi2FCN * fcn =  new Chi2FCN(fData,fFunc); 
+      fcn->SetNThreads(fNThreads);
       return fcn; 
    }
  
@@ -132,7 +134,7 @@ public:
    // need to be virtual to be instantiated
    virtual void Gradient(const double *x, double *g) const { 
       // evaluate the chi2 gradient
-      FitUtil::EvaluateChi2Gradient(fFunc, fData, x, g, fNEffPoints);
+      FitUtil::EvaluateChi2Gradient(fFunc, fData, x, g, fNEffPoints, fNThreads);
    }
 
    /// get type of fit method function
@@ -144,6 +146,12 @@ public:
    /// access to const reference to the model function
    virtual const IModelFunction & ModelFunction() const { return fFunc; }
 
+   /// number of threads used to evaluate the chi2 and its gradient
+   unsigned int NThreads() const { return fNThreads; }
+
+   /// set the number of threads used to evaluate the chi2 and its gradient (the model function must be thread safe)
+   void SetNThreads(unsigned int n) { fNThreads = (n > 0) ? n : 1; }
+
 
 
 protected: 
@@ -163,7 +171,7 @@ private:
       return FitUtilParallel::EvaluateChi2(fFunc, fData, x, fNEffPoints); 
 #else 
       if (!fData.HaveCoordErrors() ) 
-         return FitUtil::EvaluateChi2(fFunc, fData, x, fNEffPoints); 
+         return FitUtil::EvaluateChi2(fFunc, fData, x, fNEffPoints, fNThreads); 
       else 
          return FitUtil::EvaluateChi2Effective(fFunc, fData, x, fNEffPoints); 
 #endif
@@ -180,6 +188,8 @@ private:
 
    mutable unsigned int fNEffPoints;  // number of effective points used in the fit 
 
+   unsigned int fNThreads;  // number of threads used in the evaluation
+
    mutable std::vector<double> fGrad; // for derivatives
 
 
@@ -318,6 +318,8 @@ public:
 
 
    const double * Coords(unsigned int ipoint) const { 
+      // for 1D data return directly the pointer to the external data (no need of the cache)
+      if (fDim == 1) return fCoords[0] + ipoint; 
       for (unsigned int i = 0; i < fDim; ++i) { 
          const double * x = fCoords[i];
          assert (x != 0);
@@ -332,6 +334,10 @@ public:
          return  x[ipoint]; 
    }
 
+   const double * CoordArray(unsigned int icoord) const { 
+      return fCoords[icoord];
+   }
+
 
    const double * CoordErrors(unsigned int ipoint) const { 
       for (unsigned int i = 0; i < fDim; ++i) { 
@@ -356,6 +362,14 @@ public:
       return (fErrors) ?  fErrors[ipoint]  : 0. ;
    } 
 
+   const double * ValueArray() const { 
+      return fValues; 
+   }
+
+   const double * ErrorArray() const { 
+      return fErrors; 
+   }
+
 
 
 private: 
@@ -373,6 +387,64 @@ private:
 };
 
 
+/**
+   class holding the fit data stored by columns: an array for each coordinate, for the values, 
+   the errors, etc.. The arrays are allocated in a single buffer and each of them starts 
+   at an address aligned to kAlignment bytes, so they can be streamed efficiently in vectorized loops. 
+   The data are accessed with a DataWrapper pointing to the columns. 
+
+   @ingroup FitData
+ */
+
+class DataColumns { 
+
+public: 
+
+   enum { kAlignment = 64 };  // alignment in bytes of the columns
+
+   /**
+      construct ncolumns arrays of size n (initialized to zero)
+    */
+   DataColumns(unsigned int ncolumns, unsigned int n);
+
+   /**
+      copy constructor (copy the data)
+    */
+   DataColumns(const DataColumns & rhs);
+
+   /**
+      assignment operator (copy the data)
+    */
+   DataColumns & operator= (const DataColumns & rhs);
+
+   ~DataColumns() {}
+
+   /**
+      access to the array of the column icol
+    */
+   const double * Column(unsigned int icol) const { return fColumns[icol]; }
+   double * Column(unsigned int icol) { return fColumns[icol]; }
+
+   /**
+      number of columns
+    */
+   unsigned int NColumns() const { return fColumns.size(); }
+
+   /**
+      size of each column
+    */
+   unsigned int Size() const { return fSize; }
+
+private: 
+
+   void Allocate(unsigned int ncolumns, unsigned int n); 
+
+   unsigned int fSize;              // size of each column
+   std::vector<double> fBuffer;     // buffer containing all the columns 
+   std::vector<double *> fColumns;  // pointers to the (aligned) start of each column in the buffer
+
+};
+
   
    } // end namespace Fit
 
@@ -165,6 +165,17 @@ public:
    const std::string & MinimizerAlgoType() const { return fMinimizerOpts.MinimizerAlgorithm(); }  
 
 
+   /**
+      number of threads used for evaluating the objective function (chi2 or likelihood)
+   */
+   unsigned int NThreads() const { return fMinimizerOpts.NThreads(); }
+
+   /**
+      set the number of threads used for evaluating the objective function. 
+      With n > 1 the model function must be thread safe
+   */
+   void SetNThreads(unsigned int n) { fMinimizerOpts.SetNThreads(n); }
+
    /**
       flag to check if resulting errors are be normalized according to chi2/ndf 
    */
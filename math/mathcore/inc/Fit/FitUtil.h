@@ -33,6 +33,13 @@ namespace ROOT {
    namespace defining utility free functions using in Fit for evaluating the various fit method 
    functions (chi2, likelihood, etc..)  given the data and the model function 
 
+   The chi2 and likelihood functions and their gradients can be evaluated using nthreads threads. 
+   For nthreads > 1 the data points are split in chunks which depend only on the data size and the 
+   partial sums are added in a fixed order, so the result is the same for any nthreads > 1 
+   (with a single thread the points are summed sequentially, which can differ by rounding). 
+   The threads are kept in a pool between the evaluations and created again after a fork.
+   The model function must be thread safe.
+
    @ingroup FitMain
 */ 
 namespace FitUtil {
@@ -46,7 +53,7 @@ namespace FitUtil {
        evaluate the Chi2 given a model function and the data at the point x. 
        return also nPoints as the effective number of used points in the Chi2 evaluation
    */ 
-   double EvaluateChi2(const IModelFunction & func, const BinData & data, const double * x, unsigned int & nPoints);  
+   double EvaluateChi2(const IModelFunction & func, const BinData & data, const double * x, unsigned int & nPoints, unsigned int nthreads = 1);  
 
    /** 
        evaluate the effective Chi2 given a model function and the data at the point x. 
@@ -59,32 +66,32 @@ namespace FitUtil {
        evaluate the Chi2 gradient given a model function and the data at the point x. 
        return also nPoints as the effective number of used points in the Chi2 evaluation
    */ 
-   void EvaluateChi2Gradient(const IModelFunction & func, const BinData & data, const double * x, double * grad, unsigned int & nPoints);  
+   void EvaluateChi2Gradient(const IModelFunction & func, const BinData & data, const double * x, double * grad, unsigned int & nPoints, unsigned int nthreads = 1);  
 
    /** 
        evaluate the LogL given a model function and the data at the point x. 
        return also nPoints as the effective number of used points in the LogL evaluation
    */ 
-   double EvaluateLogL(const IModelFunction & func, const UnBinData & data, const double * x, int iWeight, bool extended, unsigned int & nPoints);  
+   double EvaluateLogL(const IModelFunction & func, const UnBinData & data, const double * x, int iWeight, bool extended, unsigned int & nPoints, unsigned int nthreads = 1);  
 
    /** 
        evaluate the LogL gradient given a model function and the data at the point x. 
        return also nPoints as the effective number of used points in the LogL evaluation
    */ 
-   void EvaluateLogLGradient(const IModelFunction & func, const UnBinData & data, const double * x, double * grad, unsigned int & nPoints);  
+   void EvaluateLogLGradient(const IModelFunction & func, const UnBinData & data, const double * x, double * grad, unsigned int & nPoints, unsigned int nthreads = 1);  
 
    /** 
        evaluate the Poisson LogL given a model function and the data at the point x. 
        return also nPoints as the effective number of used points in the LogL evaluation
        By default is extended, pass extedend to false if want to be not extended (MultiNomial)
    */ 
-   double EvaluatePoissonLogL(const IModelFunction & func, const BinData & data, const double * x, int iWeight, bool extended, unsigned int & nPoints);  
+   double EvaluatePoissonLogL(const IModelFunction & func, const BinData & data, const double * x, int iWeight, bool extended, unsigned int & nPoints, unsigned int nthreads = 1);  
 
    /** 
        evaluate the Poisson LogL given a model function and the data at the point x. 
        return also nPoints as the effective number of used points in the LogL evaluation
    */ 
-   void EvaluatePoissonLogLGradient(const IModelFunction & func, const BinData & data, const double * x, double * grad);  
+   void EvaluatePoissonLogLGradient(const IModelFunction & func, const BinData & data, const double * x, double * grad, unsigned int nthreads = 1);  
 
 //    /** 
 //        Parallel evaluate the Chi2 given a model function and the data at the point x. 
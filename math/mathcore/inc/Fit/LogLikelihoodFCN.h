@@ -72,6 +72,7 @@ public:
       fData(data), 
       fFunc(func), 
       fNEffPoints(0),
+      fNThreads(1),
       fGrad ( std::vector<double> ( func.NPar() ) )
    {}
   
@@ -97,7 +98,11 @@ private:
 public: 
 
    /// clone the function (need to return Base for Windows)
-   virtual BaseFunction * Clone() const { return  new LogLikelihoodFCN(fData,fFunc,fWeight,fIsExtended); }
+   virtual BaseFunction * Clone() const { 
+      LogLikelihoodFCN * fcn = new LogLikelihoodFCN(fData,fFunc,fWeight,fIsExtended); 
+      fcn->SetNThreads(fNThreads); 
+      return fcn; 
+   }
 
 
    //using BaseObjFunction::operator();
@@ -115,7 +120,7 @@ public:
    // need to be virtual to be instantited
    virtual void Gradient(const double *x, double *g) const { 
       // evaluate the chi2 gradient
-      FitUtil::EvaluateLogLGradient(fFunc, fData, x, g, fNEffPoints);
+      FitUtil::EvaluateLogLGradient(fFunc, fData, x, g, fNEffPoints, fNThreads);
    }
 
    /// get type of fit method function
@@ -127,6 +132,12 @@ public:
    /// access to const reference to the model function
    virtual const IModelFunction & ModelFunction() const { return fFunc; }
 
+   /// number of threads used to evaluate the likelihood and its gradient
+   unsigned int NThreads() const { return fNThreads; }
+
+   /// set the number of threads used to evaluate the likelihood and its gradient (the model function must be thread safe)
+   void SetNThreads(unsigned int n) { fNThreads = (n > 0) ? n : 1; }
+
    // Use sum of the weight squared in evaluating the likelihood 
    // (this is needed for calculating the errors)
    void UseSumOfWeightSquare(bool on = true) { 
@@ -151,7 +162,7 @@ private:
 #ifdef ROOT_FIT_PARALLEL
       return FitUtilParallel::EvaluateLogL(fFunc, fData, x, fNEffPoints); 
 #else 
-      return FitUtil::EvaluateLogL(fFunc, fData, x, fWeight, fIsExtended, fNEffPoints); 
+      return FitUtil::EvaluateLogL(fFunc, fData, x, fWeight, fIsExtended, fNEffPoints, fNThreads); 
 #endif
    } 
 
@@ -171,6 +182,8 @@ private:
 
    mutable unsigned int fNEffPoints;  // number of effective points used in the fit 
 
+   unsigned int fNThreads;  // number of threads used in the evaluation
+
    mutable std::vector<double> fGrad; // for derivatives
 
 
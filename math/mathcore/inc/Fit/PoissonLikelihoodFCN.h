@@ -71,6 +71,7 @@ public:
       fData(data),
       fFunc(func),
       fNEffPoints(0),
+      fNThreads(1),
       fGrad ( std::vector<double> ( func.NPar() ) )
    { }
 
@@ -96,7 +97,11 @@ private:
 public:
 
    /// clone the function (need to return Base for Windows)
-   virtual BaseFunction * Clone() const { return new  PoissonLikelihoodFCN(fData,fFunc,fWeight,fIsExtended); }
+   virtual BaseFunction * Clone() const { 
+      PoissonLikelihoodFCN * fcn = new PoissonLikelihoodFCN(fData,fFunc,fWeight,fIsExtended); 
+      fcn->SetNThreads(fNThreads); 
+      return fcn; 
+   }
 
    // effective points used in the fit
    virtual unsigned int NFitPoints() const { return fNEffPoints; }
@@ -110,7 +115,7 @@ public:
    /// evaluate gradient
    virtual void Gradient(const double *x, double *g) const {
       // evaluate the chi2 gradient
-      FitUtil::EvaluatePoissonLogLGradient(fFunc, fData, x, g );
+      FitUtil::EvaluatePoissonLogLGradient(fFunc, fData, x, g, fNThreads );
    }
 
    /// get type of fit method function
@@ -122,6 +127,12 @@ public:
    /// access to const reference to the model function
    virtual const IModelFunction & ModelFunction() const { return fFunc; }
 
+   /// number of threads used to evaluate the likelihood and its gradient
+   unsigned int NThreads() const { return fNThreads; }
+
+   /// set the number of threads used to evaluate the likelihood and its gradient (the model function must be thread safe)
+   void SetNThreads(unsigned int n) { fNThreads = (n > 0) ? n : 1; }
+
    bool IsWeighted() const { return (fWeight != 0); }
 
    // Use the weights in evaluating the likelihood 
@@ -149,7 +160,7 @@ private:
     */
    virtual double DoEval (const double * x) const {
       this->UpdateNCalls();
-      return FitUtil::EvaluatePoissonLogL(fFunc, fData, x, fWeight, fIsExtended, fNEffPoints);
+      return FitUtil::EvaluatePoissonLogL(fFunc, fData, x, fWeight, fIsExtended, fNEffPoints, fNThreads);
    }
 
    // for derivatives
@@ -169,6 +180,8 @@ private:
 
    mutable unsigned int fNEffPoints;  // number of effective points used in the fit
 
+   unsigned int fNThreads;  // number of threads used in the evaluation
+
 
    mutable std::vector<double> fGrad; // for derivatives
 
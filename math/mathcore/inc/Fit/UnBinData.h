@@ -95,7 +95,8 @@ public :
       fDim(dim), 
       fPointSize( (isWeighted) ? dim +1 : dim),
       fNPoints(n),
-      fDataVector(0)
+      fDataVector(0),
+      fDataColumns(0)
    { 
       fDataWrapper = new DataWrapper(fPointSize, dataItr);
    } 
@@ -129,7 +130,8 @@ public :
       fPointSize( (isWeighted) ? dim +1 : dim),
       fNPoints(0),
       fDataVector(0),
-      fDataWrapper(0)
+      fDataWrapper(0),
+      fDataColumns(0)
    { 
       unsigned int n = fPointSize*maxpoints; 
       if ( n > MaxSize() ) {
@@ -183,6 +185,7 @@ public:
    virtual ~UnBinData() {
       if (fDataVector) delete fDataVector; 
       if (fDataWrapper) delete fDataWrapper; 
+      if (fDataColumns) delete fDataColumns; 
    }
 
    /**
@@ -282,20 +285,56 @@ public:
    const double * Coords(unsigned int ipoint) const { 
       if (fDataVector) 
          return &( (fDataVector->Data()) [ ipoint*fPointSize ] );
+      else if (fDataColumns) 
+         return (fDim == 1) ? fDataColumns->Column(0) + ipoint : ColumnPoint(ipoint); 
       else 
          return fDataWrapper->Coords(ipoint); 
    }
 
+   /**
+      fill x (array of size NDim()) with the pointers to the coordinates of the point ipoint. 
+      The coordinate icoord of the point ipoint+k is x[icoord][k*stride], where stride is 
+      the returned value. Used for evaluating the model function on a batch of points 
+    */
+   unsigned int CoordArrays(unsigned int ipoint, const double ** x) const { 
+      if (fDataVector) { 
+         const double * xp = &( (fDataVector->Data()) [ ipoint*fPointSize ] );
+         for (unsigned int icoord = 0; icoord < fDim; ++icoord) 
+            x[icoord] = xp + icoord; 
+         return fPointSize; 
+      }
+      for (unsigned int icoord = 0; icoord < fDim; ++icoord) 
+         x[icoord] = (fDataColumns) ? fDataColumns->Column(icoord) + ipoint : fDataWrapper->CoordArray(icoord) + ipoint; 
+      return 1; 
+   }
+
+   /**
+      re-arrange the copied data by column: an array (aligned for vectorized access) is created for each 
+      coordinate and for the weights and the data vector stored by point is released. 
+      Return false in case of external data (which are already accessed by column). 
+      Points cannot be added when the data are stored by column; Initialize and Resize 
+      re-arrange them by point.
+    */
+   bool StoreByColumns(); 
+
+   /**
+      query if the data are stored by columns
+    */
+   bool HasColumns() const { return fDataColumns != 0; }
+
    bool IsWeighted() const { 
       return (fPointSize == fDim+1); 
    }
 
    double Weight(unsigned int ipoint) const { 
       if (fPointSize == fDim) return 1; 
+      // the weight is stored after the coordinates
       if (fDataVector ) 
-         return  (fDataVector->Data()) [ ipoint*fPointSize + 1 ] ;
+         return  (fDataVector->Data()) [ ipoint*fPointSize + fDim ] ;
+      else if (fDataColumns) 
+         return fDataColumns->Column(fDim)[ipoint]; 
       else 
-         return 0; // weights are not supported for wrapper data sets 
+         return fDataWrapper->Coord(ipoint, fDim);  // the weights are wrapped as an extra coordinate
    }
 
 
@@ -332,6 +371,7 @@ public:
       return size of internal data vector (is 0 for external data) 
     */
    unsigned int DataSize() const { 
+      if (fDataColumns) return fDataColumns->Size() * fPointSize; 
       return (fDataVector) ? fDataVector->Size() : 0;
    }
 
@@ -342,12 +382,25 @@ protected:
 
 private: 
 
+   /// copy all the values of the point ipoint from the columns in a contiguous (cached) array
+   const double * ColumnPoint(unsigned int ipoint) const { 
+      for (unsigned int k = 0; k < fPointSize; ++k) 
+         fPointCache[k] = fDataColumns->Column(k)[ipoint]; 
+      return &fPointCache.front(); 
+   }
+
+   /// re-arrange the data stored by column in a data vector by point (needed to add points) 
+   void StoreByPoints(); 
+
    unsigned int fDim;         // coordinate data dimension
    unsigned int fPointSize;    // poit size dimension (coordinate + weight)
    unsigned int fNPoints;     // numer of fit points
    
    DataVector * fDataVector;     // pointer to internal data vector (null for external data)
    DataWrapper * fDataWrapper;   // pointer to structure wrapping external data (null when data are copied in)
+   DataColumns * fDataColumns;   //! pointer to the copied in data stored by columns
+
+   mutable std::vector<double> fPointCache;  //! cached point returned when the data are stored by columns
 
 }; 
 
@@ -27,6 +27,7 @@
 
 
 #include <cassert> 
+#include <vector>
 
 /**
    @defgroup ParamFunc Interfaces for parametric functions 
@@ -127,6 +128,18 @@ public:
 
    using BaseFunc::operator();
 
+   /**
+      Evaluate the function for the given parameters p on a batch of n points and store the 
+      results in fval (which must have size n). 
+      x is an array of NDim() pointers: the coordinate j of the point i is x[j][i*stride]. 
+      This allows to pass both data stored by point (stride = number of values per point) 
+      and data stored by coordinate (stride = 1) without copying them. 
+      Use the private virtual function DoEvalParVec, which by default calls DoEvalPar for each point 
+   */
+   void EvalParVec(unsigned int n, const double * const * x, unsigned int stride, const double * p, double * fval) const { 
+      DoEvalParVec(n, x, stride, p, fval); 
+   }
+
 
 private: 
 
@@ -136,6 +149,29 @@ private:
    */
    virtual double DoEvalPar(const double * x, const double * p) const = 0; 
 
+   /**
+      Implementation of the evaluation on a batch of points. 
+      Derived classes can re-implement it with a loop which can be vectorized by the compiler
+   */
+   virtual void DoEvalParVec(unsigned int n, const double * const * x, unsigned int stride, const double * p, double * fval) const { 
+      unsigned int ndim = NDim(); 
+      // coordinates of a point are contiguous in memory: no need to copy them
+      bool contiguous = true; 
+      for (unsigned int j = 1; j < ndim; ++j) 
+         contiguous &= (x[j] == x[0] + j); 
+      if (contiguous) { 
+         for (unsigned int i = 0; i < n; ++i) 
+            fval[i] = DoEvalPar(x[0] + i*stride, p); 
+         return; 
+      }
+      std::vector<double> xc(ndim); 
+      for (unsigned int i = 0; i < n; ++i) { 
+         for (unsigned int j = 0; j < ndim; ++j) 
+            xc[j] = x[j][i*stride]; 
+         fval[i] = DoEvalPar(&xc.front(), p); 
+      }
+   }
+
    /**
       Implement the ROOT::Math::IBaseFunctionMultiDim interface DoEval(x) using the cached parameter values
    */
@@ -186,6 +222,15 @@ public:
       return DoEvalPar(*x, p); 
    }
 
+   /**
+      Evaluate the function for the given parameters p on a batch of n points x[i*stride] 
+      and store the results in fval (which must have size n). 
+      Use the private virtual function DoEvalParVec, which by default calls DoEvalPar for each point 
+   */
+   void EvalParVec(unsigned int n, const double * x, unsigned int stride, const double * p, double * fval) const { 
+      DoEvalParVec(n, x, stride, p, fval); 
+   }
+
 private:
 
    /**
@@ -194,6 +239,15 @@ private:
    */
    virtual double DoEvalPar(double x, const double * p) const = 0; 
 
+   /**
+      Implementation of the evaluation on a batch of points. 
+      Derived classes can re-implement it with a loop which can be vectorized by the compiler
+   */
+   virtual void DoEvalParVec(unsigned int n, const double * x, unsigned int stride, const double * p, double * fval) const { 
+      for (unsigned int i = 0; i < n; ++i) 
+         fval[i] = DoEvalPar(x[i*stride], p); 
+   }
+
    /**
       Implement the ROOT::Math::IBaseFunctionOneDim interface DoEval(x) using the cached parameter values
    */
@@ -43,6 +43,7 @@ public:
    static void SetDefaultMaxIterations(int maxiter);
    static void SetDefaultStrategy(int strat);
    static void SetDefaultPrintLevel(int level);
+   static void SetDefaultNThreads(unsigned int nthreads);
 
    static const std::string & DefaultMinimizerType();
    static const std::string & DefaultMinimizerAlgo(); 
@@ -53,6 +54,7 @@ public:
    static int DefaultMaxIterations(); 
    static int DefaultStrategy(); 
    static int DefaultPrintLevel(); 
+   static unsigned int DefaultNThreads(); 
 
    /// retrieve extra options - if not existing create a IOptions 
    static ROOT::Math::IOptions & Default(const char * name);
@@ -103,6 +105,9 @@ public:
    /// error definition 
    double ErrorDef() const { return  fErrorDef; }
 
+   /// number of threads used for evaluating the fit objective function (1 means sequential evaluation)
+   unsigned int NThreads() const { return fNThreads; }
+
    /// return extra options (NULL pointer if they are not present)
    IOptions * ExtraOptions() const { return fExtraOptions; }
 
@@ -138,6 +143,9 @@ public:
    /// set error def
    void SetErrorDef(double err) { fErrorDef = err; }
 
+   /// set number of threads used for evaluating the fit objective function (the model function must be thread safe)
+   void SetNThreads(unsigned int nthreads) { fNThreads = (nthreads > 0) ? nthreads : 1; }
+
    /// set minimizer type
    void SetMinimizerType(const char * type) { fMinimType = type; }
 
@@ -154,6 +162,7 @@ private:
    int fMaxCalls;            // maximum number of function calls
    int fMaxIter;             // maximum number of iterations
    int fStrategy;            // minimizer strategy (used by Minuit)
+   unsigned int fNThreads;   // number of threads used in evaluating the objective function
    double fErrorDef;         // error definition (=1. for getting 1 sigma error for chi2 fits)
    double fTolerance;        // minimize tolerance to reach solution
    double fPrecision;        // precision of the objective function evaluation (value <=0 means left to default)
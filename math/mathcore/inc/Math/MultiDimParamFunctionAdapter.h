@@ -135,6 +135,11 @@ private:
       return (*fFunc)(*x, p);
    }
 
+   /// evaluation on a batch of points using the one-dim function
+   void DoEvalParVec(unsigned int n, const double * const * x, unsigned int stride, const double * p, double * fval) const { 
+      fFunc->EvalParVec(n, x[0], stride, p, fval);
+   }
+
 
 private: 
 
@@ -258,6 +263,11 @@ private:
       return (*fFunc)(*x, p);
    }
 
+   /// evaluation on a batch of points using the one-dim function
+   void DoEvalParVec(unsigned int n, const double * const * x, unsigned int stride, const double * p, double * fval) const { 
+      fFunc->EvalParVec(n, x[0], stride, p, fval);
+   }
+
 //    double DoDerivative(const double * x, unsigned int ) const { 
 //       return fFunc->Derivative(*x); 
 //    } 
@@ -35,7 +35,8 @@ BinData::BinData(unsigned int maxpoints , unsigned int dim , ErrorType err ) :
    fSumError2(0),
    fRefVolume(1.0),
    fDataVector(0),
-   fDataWrapper(0)
+   fDataWrapper(0),
+   fDataColumns(0)
 { 
    unsigned int n = fPointSize*maxpoints; 
    if ( n > MaxSize() ) 
@@ -55,7 +56,8 @@ BinData::BinData (const DataOptions & opt, unsigned int maxpoints, unsigned int
    fSumError2(0),
    fRefVolume(1.0),
    fDataVector(0),
-   fDataWrapper(0)
+   fDataWrapper(0),
+   fDataColumns(0)
 { 
    unsigned int n = fPointSize*maxpoints; 
    if ( n > MaxSize() ) 
@@ -79,7 +81,8 @@ BinData::BinData (const DataOptions & opt, const DataRange & range, unsigned int
    fSumError2(0),
    fRefVolume(1.0),
    fDataVector(0),
-   fDataWrapper(0)
+   fDataWrapper(0),
+   fDataColumns(0)
 { 
    unsigned int n = fPointSize*maxpoints; 
    if ( n > MaxSize() ) 
@@ -100,7 +103,8 @@ BinData::BinData(unsigned int n, const double * dataX, const double * val, const
    fSumContent(0),
    fSumError2(0),
    fRefVolume(1.0),
-   fDataVector(0)
+   fDataVector(0),
+   fDataColumns(0)
 { 
    if (eval != 0) { 
       fPointSize++;
@@ -121,7 +125,8 @@ BinData::BinData(unsigned int n, const double * dataX, const double * dataY, con
    fSumContent(0),
    fSumError2(0),
    fRefVolume(1.0),
-   fDataVector(0)
+   fDataVector(0),
+   fDataColumns(0)
 { 
    if (eval != 0) { 
       fPointSize++;
@@ -140,7 +145,8 @@ BinData::BinData(unsigned int n, const double * dataX, const double * dataY, con
    fSumContent(0),
    fSumError2(0),
    fRefVolume(1.0),
-   fDataVector(0)
+   fDataVector(0),
+   fDataColumns(0)
 { 
    if (eval != 0) { 
       fPointSize++;
@@ -161,11 +167,14 @@ BinData::BinData(const BinData & rhs) :
    fRefVolume(rhs.fRefVolume),
    fDataVector(0),
    fDataWrapper(0), 
+   fDataColumns(0),
+   fPointCache(rhs.fPointCache),
    fBinEdge(rhs.fBinEdge)
 {
    // copy constructor (copy data vector or just the pointer)
    if (rhs.fDataVector != 0) fDataVector = new DataVector(*rhs.fDataVector);
    else if (rhs.fDataWrapper != 0) fDataWrapper = new DataWrapper(*rhs.fDataWrapper);
+   else if (rhs.fDataColumns != 0) fDataColumns = new DataColumns(*rhs.fDataColumns);
 }
 
 
@@ -192,6 +201,7 @@ BinData & BinData::operator= (const BinData & rhs) {
    // delete previous pointers 
    if (fDataVector) delete fDataVector; 
    if (fDataWrapper) delete fDataWrapper; 
+   if (fDataColumns) delete fDataColumns; 
    if (rhs.fDataVector != 0)  
       fDataVector = new DataVector(*rhs.fDataVector);
    else 
@@ -200,6 +210,11 @@ BinData & BinData::operator= (const BinData & rhs) {
       fDataWrapper = new DataWrapper(*rhs.fDataWrapper);
    else 
       fDataWrapper = 0; 
+   if (rhs.fDataColumns != 0) 
+      fDataColumns = new DataColumns(*rhs.fDataColumns);
+   else 
+      fDataColumns = 0; 
+   fPointCache = rhs.fPointCache; 
 
    return *this; 
 } 
@@ -210,6 +225,7 @@ BinData::~BinData() {
    // destructor 
    if (fDataVector) delete fDataVector; 
    if (fDataWrapper) delete fDataWrapper; 
+   if (fDataColumns) delete fDataColumns; 
 }
 
 void BinData::Initialize(unsigned int maxpoints, unsigned int dim , ErrorType err  ) { 
@@ -217,6 +233,8 @@ void BinData::Initialize(unsigned int maxpoints, unsigned int dim , ErrorType er
 //       need to be initialized with the  right dimension before
    if (fDataWrapper) delete fDataWrapper;
    fDataWrapper = 0; 
+   // new points are added by point
+   if (fDataColumns) StoreByPoints(); 
    unsigned int pointSize = GetPointSize(err,dim);  
    if ( pointSize != fPointSize && fDataVector) { 
 //       MATH_INFO_MSGVAL("BinData::Initialize"," Reset amd re-initialize with a new fit point size of ",
@@ -251,7 +269,8 @@ void BinData::Resize(unsigned int npoints) {
    }
    int nextraPoints = npoints - DataSize()/ fPointSize;  
    if (nextraPoints == 0) return; 
-   else if (nextraPoints < 0) {
+   if (fDataColumns) StoreByPoints(); 
+   if (nextraPoints < 0) {
       // delete extra points
       if (!fDataVector) return; 
       (fDataVector->Data()).resize( npoints * fPointSize);
@@ -481,6 +500,9 @@ BinData & BinData::LogTransform() {
 
    if (fNPoints == 0) return *this; 
 
+   // the transformation is done on the data stored by point
+   if (fDataColumns) StoreByPoints(); 
+
    if (fDataVector) {       
 
       ErrorType type = GetErrorType(); 
@@ -581,6 +603,42 @@ BinData & BinData::LogTransform() {
    return *this; 
 }
 
+bool BinData::StoreByColumns() { 
+   // re-arrange the copied data in a column for each coordinate, value and error
+
+   if (fDataColumns) return true; 
+   if (!fDataVector) return false; 
+
+   // the vector can be larger than the number of inserted points 
+   fDataColumns = new DataColumns(fPointSize, fNPoints); 
+   const std::vector<double> & data = fDataVector->Data(); 
+   for (unsigned int k = 0; k < fPointSize; ++k) { 
+      double * column = fDataColumns->Column(k); 
+      for (unsigned int i = 0; i < fNPoints; ++i) 
+         column[i] = data[i*fPointSize + k]; 
+   }
+   delete fDataVector; 
+   fDataVector = 0; 
+   fPointCache.resize(fPointSize); 
+   return true; 
+}
+
+void BinData::StoreByPoints() { 
+   // re-arrange the data stored by column in a data vector by point 
+
+   if (!fDataColumns) return; 
+   assert(fDataVector == 0); 
+   fDataVector = new DataVector(fPointSize*fNPoints); 
+   std::vector<double> & data = fDataVector->Data(); 
+   for (unsigned int k = 0; k < fPointSize; ++k) { 
+      const double * column = fDataColumns->Column(k); 
+      for (unsigned int i = 0; i < fNPoints; ++i) 
+         data[i*fPointSize + k] = column[i]; 
+   }
+   delete fDataColumns; 
+   fDataColumns = 0; 
+}
+
 
    } // end namespace Fit
 
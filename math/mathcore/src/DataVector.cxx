@@ -12,11 +12,55 @@
 
 #include "Fit/DataVector.h"
 
+#include <algorithm>
+
 
 namespace ROOT { 
 
    namespace Fit { 
 
+DataColumns::DataColumns(unsigned int ncolumns, unsigned int n) : 
+   fSize(0)
+{ 
+   // construct ncolumns arrays of size n
+   Allocate(ncolumns, n); 
+}
+
+DataColumns::DataColumns(const DataColumns & rhs) : 
+   fSize(0)
+{ 
+   // copy constructor
+   Allocate(rhs.NColumns(), rhs.fSize); 
+   for (unsigned int icol = 0; icol < NColumns(); ++icol) 
+      std::copy(rhs.Column(icol), rhs.Column(icol) + fSize, Column(icol) ); 
+}
+
+DataColumns & DataColumns::operator= (const DataColumns & rhs) { 
+   // assignment operator
+   if (this == &rhs) return *this; 
+   Allocate(rhs.NColumns(), rhs.fSize); 
+   for (unsigned int icol = 0; icol < NColumns(); ++icol) 
+      std::copy(rhs.Column(icol), rhs.Column(icol) + fSize, Column(icol) ); 
+   return *this; 
+}
+
+void DataColumns::Allocate(unsigned int ncolumns, unsigned int n) { 
+   // allocate the buffer for the columns. 
+   // Each column is padded to a multiple of the alignment and an extra alignment block 
+   // is allocated to align the first column 
+   const unsigned int nalign = kAlignment/sizeof(double); 
+   unsigned int stride = ((n + nalign - 1)/nalign) * nalign; 
+   fSize = n; 
+   fBuffer.assign(ncolumns*stride + nalign, 0.); 
+   fColumns.resize(ncolumns); 
+   if (ncolumns == 0) return; 
+   double * begin = &fBuffer.front(); 
+   size_t misalign = reinterpret_cast<size_t>(begin) % kAlignment; 
+   if (misalign != 0) begin += (kAlignment - misalign)/sizeof(double); 
+   for (unsigned int icol = 0; icol < ncolumns; ++icol) 
+      fColumns[icol] = begin + icol*stride; 
+}
+
 
    } // end namespace Fit
 
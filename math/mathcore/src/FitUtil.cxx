@@ -29,8 +29,16 @@
 #include <limits>
 #include <cmath>
 #include <cassert> 
+#include <algorithm>
+#include <vector>
 //#include <memory>
 
+// use a pool of threads for the parallel evaluation (otherwise the chunks are evaluated sequentially)
+#ifndef _WIN32
+#define FITUTIL_USE_THREADS
+#include <pthread.h>
+#endif
+
 //#define DEBUG
 #ifdef DEBUG
 #define NSAMPLE 10
@@ -323,127 +331,773 @@ namespace ROOT {
 
 
 
-      } // end namespace  FitUtil      
 
 
+         // evaluation of the objective functions using multiple threads. 
+         // The data points are split in chunks whose boundaries depend only on the number 
+         // of points. The partial results are stored per chunk and summed in the chunk order, 
+         // so the result does not depend on the number of threads or on their scheduling
 
-//___________________________________________________________________________________________________________________________
-// for chi2 functions
-//___________________________________________________________________________________________________________________________
+         const unsigned int kMinChunkSize = 100;  // minimum number of points in a chunk
+         const unsigned int kMaxChunks = 256;     // maximum number of chunks
 
-double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data, const double * p, unsigned int & nPoints) {  
-   // evaluate the chi2 given a  function reference  , the data and returns the value and also in nPoints 
-   // the actual number of used points
-   // normal chi2 using only error on values (from fitting histogram)
-   // optionally the integral of function in the bin is used 
-   
-   unsigned int n = data.Size();
+         unsigned int NumberOfChunks(unsigned int n) { 
+            // number of chunks used for n data points
+            unsigned int nchunks = (n + kMinChunkSize - 1)/kMinChunkSize; 
+            return std::max(1u, std::min(nchunks, kMaxChunks) ); 
+         }
 
-   double chi2 = 0;
-   nPoints = 0; // count the effective non-zero points
-   
-   // do not cache parameter values (it is not thread safe)
-   //func.SetParameters(p); 
+         unsigned int ChunkBegin(unsigned int ichunk, unsigned int n, unsigned int nchunks) { 
+            // index of the first point of the chunk ichunk (ichunk = nchunks returns n)
+            return ichunk * (n/nchunks) + std::min(ichunk, n%nchunks); 
+         }
 
-   
-   // get fit option and check case if using integral of bins
-   const DataOptions & fitOpt = data.Opt();
-   bool useBinIntegral = fitOpt.fIntegral && data.HasBinEdges(); 
-   bool useBinVolume = (fitOpt.fBinVolume && data.HasBinEdges());
-   bool useExpErrors = (fitOpt.fExpErrors);
+         // partial result of the evaluation on a range of points
+         struct RangeResult { 
+            RangeResult() : fValue(0), fSumW(0), fSumW2(0), fNPoints(0), fNRejected(0) {}
+            double fValue;                // sum of the contributions 
+            double fSumW;                 // sum of weights (for extended weighted likelihood)
+            double fSumW2;                // sum of weight squares
+            unsigned int fNPoints;        // number of used points 
+            unsigned int fNRejected;      // number of rejected points 
+            std::vector<double> fGrad;    // sum of the gradient contributions
+         };
 
-#ifdef DEBUG
-   std::cout << "\n\nFit data size = " << n << std::endl;
-   std::cout << "evaluate chi2 using function " << &func << "  " << p << std::endl; 
-   std::cout << "use empty bins  " << fitOpt.fUseEmpty << std::endl;
-   std::cout << "use integral    " << fitOpt.fIntegral << std::endl;
-   std::cout << "use all error=1 " << fitOpt.fErrors1 << std::endl;
+         // arguments for the functions evaluating a range of points 
+         struct RangeArgs { 
+            RangeArgs(const IModelFunction & func, const double * p, int iWeight = 0, bool extended = false) : 
+               fFunc(func), fGradFunc(0), fParams(p), fBinData(0), fUnBinData(0), fWeight(iWeight), fExtended(extended) {}
+            const IModelFunction & fFunc; 
+            const IGradModelFunction * fGradFunc;  // needed for the gradient evaluation
+            const double * fParams; 
+            const BinData * fBinData; 
+            const UnBinData * fUnBinData; 
+            int fWeight; 
+            bool fExtended; 
+         };
+
+         typedef void (* RangeEvaluator)(const RangeArgs & args, unsigned int begin, unsigned int end, RangeResult & result); 
+
+         // the coordinates of the multi-dimensional points of external data or of data stored by columns 
+         // are returned using an internal cache of the data class, which cannot be shared between threads
+         template<class Data> 
+         unsigned int MaxThreads(const Data & data, unsigned int nthreads) { 
+            if (data.NDim() > 1 && (data.HasColumns() || data.DataSize() == 0) ) return 1; 
+            return nthreads; 
+         }
+
+         const unsigned int kBatchSize = 128;     // number of points evaluated in a single call to EvalParVec
+
+         // evaluate the model function on consecutive blocks of data points using IModelFunction::EvalParVec
+         template<class Data> 
+         class BatchEvaluator { 
+         public: 
+            BatchEvaluator(const IModelFunction & func, const Data & data, const double * p, unsigned int end) : 
+               fFunc(func), fData(data), fParams(p), fBegin(0), fEnd(0), fLast(end), 
+               fX(data.NDim()), fValues(kBatchSize) {}
+            // return the function value for the point i (the block containing i is evaluated when needed)
+            double operator() (unsigned int i) { 
+               if (i < fBegin || i >= fEnd) { 
+                  fBegin = i; 
+                  fEnd = std::min(i + kBatchSize, fLast); 
+                  unsigned int stride = fData.CoordArrays(i, &fX.front() ); 
+                  fFunc.EvalParVec(fEnd - fBegin, &fX.front(), stride, fParams, &fValues.front() ); 
+               }
+               return fValues[i - fBegin]; 
+            }
+         private: 
+            const IModelFunction & fFunc; 
+            const Data & fData; 
+            const double * fParams; 
+            unsigned int fBegin;                  // first point of the current block 
+            unsigned int fEnd;                    // end of the current block
+            unsigned int fLast;                   // end of the evaluated range 
+            std::vector<const double *> fX;       // pointers to the coordinates of the block
+            std::vector<double> fValues;          // function values of the block
+         };
+
+         // task evaluating a chunk of points  
+         class ChunkTask { 
+         public: 
+            ChunkTask(RangeEvaluator eval, const RangeArgs & args, unsigned int n, unsigned int nchunks, unsigned int ngrad) : 
+               fEval(eval), fArgs(args), fN(n), fResults(nchunks) 
+            { 
+               for (unsigned int i = 0; i < nchunks; ++i) fResults[i].fGrad.resize(ngrad); 
+            }
+            void EvaluateChunk(unsigned int ichunk) { 
+               unsigned int nchunks = fResults.size(); 
+               (*fEval)(fArgs, ChunkBegin(ichunk, fN, nchunks), ChunkBegin(ichunk+1, fN, nchunks), fResults[ichunk]); 
+            }
+            const std::vector<RangeResult> & Results() const { return fResults; }
+         private: 
+            RangeEvaluator fEval; 
+            const RangeArgs & fArgs; 
+            unsigned int fN; 
+            std::vector<RangeResult> fResults; 
+         };
+
+#ifdef FITUTIL_USE_THREADS
+         // persistent pool of threads used for evaluating the chunks. 
+         // The threads are created when first needed and then wait for new work, 
+         // the calling thread takes part in the evaluation. 
+         // The threads do not survive a fork: the pool is locked while forking and 
+         // emptied in the child process, where the threads are created again when needed
+         class FitThreadPool { 
+         public: 
+            static FitThreadPool & Instance() { 
+               // the pool is never deleted since its threads are never stopped
+               static FitThreadPool * pool = new FitThreadPool(); 
+               return *pool; 
+            }
+
+            void Run(ChunkTask & task, unsigned int nchunks, unsigned int nthreads) { 
+               // evaluate all the chunks of the task using at most nthreads threads
+               pthread_mutex_lock(&fRunMutex); 
+               pthread_mutex_lock(&fMutex); 
+               while (fNThreads + 1 < nthreads) { 
+                  pthread_t thread; 
+                  if (pthread_create(&thread, 0, &FitThreadPool::WorkerLoop, this) != 0) break;
+                  pthread_detach(thread); 
+                  fNThreads++; 
+               }
+               fTask = &task; 
+               fNChunks = nchunks; 
+               fNextChunk = 0; 
+               fNDone = 0; 
+               fNJoined = 0; 
+               fNWorkers = nthreads - 1; 
+               fJob++; 
+               pthread_cond_broadcast(&fStartCond); 
+               ProcessChunks(); 
+               while (fNDone < fNChunks) pthread_cond_wait(&fDoneCond, &fMutex); 
+               fTask = 0; 
+               pthread_mutex_unlock(&fMutex); 
+               pthread_mutex_unlock(&fRunMutex); 
+            }
+
+         private: 
+
+            FitThreadPool() : fNThreads(0), fTask(0), fNChunks(0), fNextChunk(0), fNDone(0), fNJoined(0), fNWorkers(0), fJob(0) { 
+               Init(); 
+               pthread_atfork(&FitThreadPool::PrepareFork, &FitThreadPool::ParentFork, &FitThreadPool::ChildFork); 
+            }
+
+            void Init() { 
+               pthread_mutex_init(&fRunMutex, 0); 
+               pthread_mutex_init(&fMutex, 0); 
+               pthread_cond_init(&fStartCond, 0); 
+               pthread_cond_init(&fDoneCond, 0); 
+            }
+
+            static void PrepareFork() { 
+               // wait for the running job and keep the pool idle while forking 
+               FitThreadPool & pool = Instance(); 
+               pthread_mutex_lock(&pool.fRunMutex); 
+               pthread_mutex_lock(&pool.fMutex); 
+            }
+
+            static void ParentFork() { 
+               FitThreadPool & pool = Instance(); 
+               pthread_mutex_unlock(&pool.fMutex); 
+               pthread_mutex_unlock(&pool.fRunMutex); 
+            }
+
+            static void ChildFork() { 
+               // only the forking thread exists in the child: start again with an empty pool
+               FitThreadPool & pool = Instance(); 
+               pool.Init(); 
+               pool.fNThreads = 0; 
+               pool.fTask = 0; 
+               pool.fNChunks = 0; 
+               pool.fNextChunk = 0; 
+               pool.fNDone = 0; 
+               pool.fNJoined = 0; 
+               pool.fNWorkers = 0; 
+            }
+
+            static void * WorkerLoop(void * arg) { 
+               // wait for a new job and take part in it if the job needs more threads
+               FitThreadPool * pool = static_cast<FitThreadPool *>(arg); 
+               unsigned long lastJob = 0; 
+               pthread_mutex_lock(&pool->fMutex); 
+               for (;;) { 
+                  while (pool->fJob == lastJob) pthread_cond_wait(&pool->fStartCond, &pool->fMutex); 
+                  lastJob = pool->fJob; 
+                  if (pool->fNJoined < pool->fNWorkers) { 
+                     pool->fNJoined++; 
+                     pool->ProcessChunks(); 
+                  }
+               }
+               return 0; 
+            }
+
+            void ProcessChunks() { 
+               // evaluate the chunks of the current job until none is left (fMutex must be locked)
+               while (fNextChunk < fNChunks) { 
+                  unsigned int ichunk = fNextChunk++; 
+                  ChunkTask * task = fTask; 
+                  pthread_mutex_unlock(&fMutex); 
+                  task->EvaluateChunk(ichunk); 
+                  pthread_mutex_lock(&fMutex); 
+                  if (++fNDone == fNChunks) pthread_cond_signal(&fDoneCond); 
+               }
+            }
+
+            pthread_mutex_t fRunMutex;   // serialize the jobs 
+            pthread_mutex_t fMutex;      // protect the job data 
+            pthread_cond_t  fStartCond;  // signal a new job to the threads
+            pthread_cond_t  fDoneCond;   // signal the end of the job 
+            unsigned int fNThreads;      // number of created threads 
+            ChunkTask * fTask;           // current task 
+            unsigned int fNChunks;       // number of chunks of the current job
+            unsigned int fNextChunk;     // next chunk to be evaluated
+            unsigned int fNDone;         // number of evaluated chunks 
+            unsigned int fNJoined;       // number of threads which joined the job
+            unsigned int fNWorkers;      // number of threads requested for the job 
+            unsigned long fJob;          // job counter 
+         };
+#endif
+
+         void EvaluateRange(RangeEvaluator eval, const RangeArgs & args, unsigned int n, unsigned int nthreads, unsigned int ngrad, RangeResult & result) { 
+            // evaluate all the n points. For nthreads <= 1 the points are evaluated sequentially, 
+            // otherwise they are split in chunks evaluated by the thread pool
+            result = RangeResult(); 
+            result.fGrad.resize(ngrad); 
+            if (nthreads <= 1) { 
+               (*eval)(args, 0, n, result); 
+               return; 
+            }
+            unsigned int nchunks = NumberOfChunks(n); 
+            ChunkTask task(eval, args, n, nchunks, ngrad); 
+#ifdef FITUTIL_USE_THREADS
+            if (nchunks > 1) 
+               FitThreadPool::Instance().Run(task, nchunks, std::min(nthreads, nchunks) ); 
+            else 
+               task.EvaluateChunk(0); 
+#else
+            for (unsigned int i = 0; i < nchunks; ++i) task.EvaluateChunk(i); 
 #endif
+            // sum the partial results in the chunk order
+            const std::vector<RangeResult> & results = task.Results(); 
+            for (unsigned int i = 0; i < nchunks; ++i) { 
+               result.fValue += results[i].fValue; 
+               result.fSumW += results[i].fSumW; 
+               result.fSumW2 += results[i].fSumW2; 
+               result.fNPoints += results[i].fNPoints; 
+               result.fNRejected += results[i].fNRejected; 
+               for (unsigned int k = 0; k < ngrad; ++k) 
+                  result.fGrad[k] += results[i].fGrad[k]; 
+            }
+         }
 
 
-   IntegralEvaluator<> igEval( func, p, useBinIntegral); 
+         void EvaluateChi2Range(const RangeArgs & args, unsigned int begin, unsigned int end, RangeResult & result) { 
+            // evaluate the chi2 contribution of the points in [begin, end) 
 
-   double maxResValue = std::numeric_limits<double>::max() /n;
-   double wrefVolume = 1.0; 
-   std::vector<double> xc; 
-   if (useBinVolume) { 
-      wrefVolume /= data.RefVolume();
-      xc.resize(data.NDim() );
-   }
+            const IModelFunction & func = args.fFunc; 
+            const BinData & data = *args.fBinData; 
+            const double * p = args.fParams; 
+            unsigned int n = data.Size();
 
-   for (unsigned int i = 0; i < n; ++ i) { 
+            // get fit option and check case if using integral of bins
+            const DataOptions & fitOpt = data.Opt();
+            bool useBinIntegral = fitOpt.fIntegral && data.HasBinEdges(); 
+            bool useBinVolume = (fitOpt.fBinVolume && data.HasBinEdges());
+            bool useExpErrors = (fitOpt.fExpErrors);
 
+            IntegralEvaluator<> igEval( func, p, useBinIntegral); 
+            BatchEvaluator<BinData> batchEval( func, data, p, end); 
+
+            double maxResValue = std::numeric_limits<double>::max() /n;
+            double wrefVolume = 1.0; 
+            std::vector<double> xc; 
+            if (useBinVolume) { 
+               wrefVolume /= data.RefVolume();
+               xc.resize(data.NDim() );
+            }
 
-      double y, invError; 
-      // in case of no error in y invError=1 is returned
-      const double * x1 = data.GetPoint(i,y, invError);
+            double chi2 = 0; 
 
-      double fval = 0;
+            for (unsigned int i = begin; i < end; ++ i) { 
 
-      double binVolume = 1.0; 
-      if (useBinVolume) { 
-         unsigned int ndim = data.NDim(); 
-         const double * x2 = data.BinUpEdge(i);  
-         for (unsigned int j = 0; j < ndim; ++j) {
-            binVolume *= std::abs( x2[j]-x1[j] );
-            xc[j] = 0.5*(x2[j]+ x1[j]);
+
+               double y, invError; 
+               // in case of no error in y invError=1 is returned
+               const double * x1 = data.GetPoint(i,y, invError);
+
+               double fval = 0;
+
+               double binVolume = 1.0; 
+               if (useBinVolume) { 
+                  unsigned int ndim = data.NDim(); 
+                  const double * x2 = data.BinUpEdge(i);  
+                  for (unsigned int j = 0; j < ndim; ++j) {
+                     binVolume *= std::abs( x2[j]-x1[j] );
+                     xc[j] = 0.5*(x2[j]+ x1[j]);
+                  }
+                  // normalize the bin volume using a reference value
+                  binVolume *= wrefVolume;
+               }
+
+               const double * x = (useBinVolume) ? &xc.front() : x1;
+
+               if (!useBinIntegral) {
+                  fval = (useBinVolume) ? func ( x, p ) : batchEval(i);
+               }
+               else {
+                  // calculate integral normalized by bin volume
+                  // need to set function and parameters here in case loop is parallelized
+                  fval = igEval( x1, data.BinUpEdge(i)) ; 
+               }
+               // normalize result if requested according to bin volume
+               if (useBinVolume) fval *= binVolume;
+
+               // expected errors
+               if (useExpErrors) {
+                  // we need first to check if a weight factor needs to be applied
+                  // weight = sumw2/sumw = error**2/content
+                  double invWeight = y * invError * invError;
+                  if (invError == 0) invWeight = (data.SumOfError2() > 0) ? data.SumOfContent()/ data.SumOfError2() : 1.0; 
+                  // compute expected error  as f(x) / weight
+                  double invError2 = (fval > 0) ? invWeight / fval : 0.0; 
+                  invError = std::sqrt(invError2); 
+               }         
+
+#ifdef DEBUG      
+               std::cout << x[0] << "  " << y << "  " << 1./invError << " params : "; 
+               for (unsigned int ipar = 0; ipar < func.NPar(); ++ipar) 
+                  std::cout << p[ipar] << "\t";
+               std::cout << "\tfval = " << fval << " bin volume " << binVolume << " ref " << wrefVolume << std::endl; 
+#endif
+
+
+               if (invError > 0) { 
+                  result.fNPoints++;
+
+                  double tmp = ( y -fval )* invError;  	  
+                  double resval = tmp * tmp;
+
+
+                  // avoid inifinity or nan in chi2 values due to wrong function values 
+                  if ( resval < maxResValue )  
+                     chi2 += resval; 
+                  else {  
+                     //nRejected++; 
+                     chi2 += maxResValue;
+                  }
+               }
+            }
+
+            result.fValue += chi2; 
          }
-         // normalize the bin volume using a reference value
-         binVolume *= wrefVolume;
-      }
 
-      const double * x = (useBinVolume) ? &xc.front() : x1;
+         void EvaluateChi2GradientRange(const RangeArgs & args, unsigned int begin, unsigned int end, RangeResult & result) { 
+            // evaluate the chi2 gradient contribution of the points in [begin, end) 
+            // the function must provide the parameter gradient
 
-      if (!useBinIntegral) {
-         fval = func ( x, p );
-      }
-      else {
-         // calculate integral normalized by bin volume
-         // need to set function and parameters here in case loop is parallelized
-         fval = igEval( x1, data.BinUpEdge(i)) ; 
-      }
-      // normalize result if requested according to bin volume
-      if (useBinVolume) fval *= binVolume;
-
-      // expected errors
-      if (useExpErrors) {
-         // we need first to check if a weight factor needs to be applied
-         // weight = sumw2/sumw = error**2/content
-         double invWeight = y * invError * invError;
-         if (invError == 0) invWeight = (data.SumOfError2() > 0) ? data.SumOfContent()/ data.SumOfError2() : 1.0; 
-         // compute expected error  as f(x) / weight
-         double invError2 = (fval > 0) ? invWeight / fval : 0.0; 
-         invError = std::sqrt(invError2); 
-      }         
+            const IGradModelFunction & func = *args.fGradFunc; 
+            const BinData & data = *args.fBinData; 
+            const double * p = args.fParams; 
+
+            const DataOptions & fitOpt = data.Opt();
+            bool useBinIntegral = fitOpt.fIntegral && data.HasBinEdges(); 
+            bool useBinVolume = (fitOpt.fBinVolume && data.HasBinEdges());
+
+            double wrefVolume = 1.0; 
+            std::vector<double> xc; 
+            if (useBinVolume) { 
+               wrefVolume /= data.RefVolume();
+               xc.resize(data.NDim() );
+            }
+
+            IntegralEvaluator<> igEval( func, p, useBinIntegral); 
+
+            unsigned int npar = func.NPar(); 
+            std::vector<double> gradFunc( npar ); 
+            std::vector<double> & g = result.fGrad; 
+
+            for (unsigned int i = begin; i < end; ++ i) { 
+
+
+               double y, invError = 0; 
+               const double * x1 = data.GetPoint(i,y, invError);
+
+               double fval = 0; 
+               const double * x2 = 0; 
+
+               double binVolume = 1; 
+               if (useBinVolume) { 
+                  unsigned int ndim = data.NDim(); 
+                  x2 = data.BinUpEdge(i);  
+                  for (unsigned int j = 0; j < ndim; ++j) {
+                     binVolume *= std::abs( x2[j]-x1[j] );
+                     xc[j] = 0.5*(x2[j]+ x1[j]);
+                  }
+                  // normalize the bin volume using a reference value
+                  binVolume *= wrefVolume;
+               }
+
+               const double * x = (useBinVolume) ? &xc.front() : x1;
+
+               if (!useBinIntegral ) {
+                  fval = func ( x, p ); 
+                  func.ParameterGradient(  x , p, &gradFunc[0] ); 
+               }
+               else { 
+                  x2 = data.BinUpEdge(i); 
+                  // calculate normalized integral and gradient (divided by bin volume)
+                  // need to set function and parameters here in case loop is parallelized 
+                  fval = igEval( x1, x2 ) ; 
+                  CalculateGradientIntegral( func, x1, x2, p, &gradFunc[0]); 
+               }
+               if (useBinVolume) fval *= binVolume;
 
-//#define DEBUG
 #ifdef DEBUG      
-      std::cout << x[0] << "  " << y << "  " << 1./invError << " params : "; 
-      for (unsigned int ipar = 0; ipar < func.NPar(); ++ipar) 
-         std::cout << p[ipar] << "\t";
-      std::cout << "\tfval = " << fval << " bin volume " << binVolume << " ref " << wrefVolume << std::endl; 
+               std::cout << x[0] << "  " << y << "  " << 1./invError << " params : "; 
+               for (unsigned int ipar = 0; ipar < npar; ++ipar) 
+                  std::cout << p[ipar] << "\t";
+               std::cout << "\tfval = " << fval << std::endl; 
 #endif
-//#undef DEBUG
+               if ( !CheckValue(fval) ) { 
+                  result.fNRejected++; 
+                  continue;
+               } 
 
+               // loop on the parameters
+               unsigned int ipar = 0; 
+               for ( ; ipar < npar ; ++ipar) { 
 
-      if (invError > 0) { 
-         nPoints++;
+                  // correct gradient for bin volumes
+                  if (useBinVolume) gradFunc[ipar] *= binVolume;
 
-         double tmp = ( y -fval )* invError;  	  
-         double resval = tmp * tmp;
-         
+                  // avoid singularity in the function (infinity and nan ) in the chi2 sum 
+                  // eventually add possibility of excluding some points (like singularity) 
+                  double dfval = gradFunc[ipar];
+                  if ( !CheckValue(dfval) ) { 
+                     break; // exit loop on parameters
+                  } 
+
+                  // calculate derivative point contribution
+                  double tmp = - 2.0 * ( y -fval )* invError * invError * gradFunc[ipar];  	  
+                  g[ipar] += tmp;
+
+               }
 
-         // avoid inifinity or nan in chi2 values due to wrong function values 
-         if ( resval < maxResValue )  
-            chi2 += resval; 
-         else {  
-            //nRejected++; 
-            chi2 += maxResValue;
+               if ( ipar < npar ) { 
+                  // case loop was broken for an overflow in the gradient calculation  
+                  result.fNRejected++; 
+                  continue;
+               } 
+            } 
          }
-      }
 
-      
-   }
+         void EvaluateLogLRange(const RangeArgs & args, unsigned int begin, unsigned int end, RangeResult & result) { 
+            // evaluate the log-likelihood contribution of the points in [begin, end) 
+            // (and the sum of weights needed for the extended term)
+
+            const IModelFunction & func = args.fFunc; 
+            const UnBinData & data = *args.fUnBinData; 
+            const double * p = args.fParams; 
+            int iWeight = args.fWeight; 
+            bool extended = args.fExtended; 
+
+            double logl = 0; 
+
+            BatchEvaluator<UnBinData> batchEval( func, data, p, end); 
+
+            for (unsigned int i = begin; i < end; ++ i) { 
+               double fval = batchEval(i); 
+
+#ifdef DEBUG      
+               std::cout << "x [ " << data.NDim() << " ] = "; 
+               for (unsigned int j = 0; j < data.NDim(); ++j)
+                  std::cout << data.Coords(i)[j] << "\t"; 
+               std::cout << "\tpar = [ " << func.NPar() << " ] =  "; 
+               for (unsigned int ipar = 0; ipar < func.NPar(); ++ipar) 
+                  std::cout << p[ipar] << "\t";
+               std::cout << "\tfval = " << fval << std::endl; 
+#endif
+               // function EvalLog protects against negative or too small values of fval
+               double logval =  ROOT::Math::Util::EvalLog( fval);       
+               if (iWeight > 0) { 
+                  double weight = data.Weight(i); 
+                  logval *= weight; 
+                  if (iWeight ==2) { 
+                     logval *= weight; // use square of weights in likelihood
+                     if (extended) { 
+                        // needed sum of weights and sum of weight square if likelkihood is extended
+                        result.fSumW += weight; 
+                        result.fSumW2 += weight*weight; 
+                     }
+                  }
+               }
+               logl += logval;
+            }
+
+            result.fValue += logl; 
+         }
+
+         void EvaluateLogLGradientRange(const RangeArgs & args, unsigned int begin, unsigned int end, RangeResult & result) { 
+            // evaluate the log-likelihood gradient contribution of the points in [begin, end) 
+
+            const IGradModelFunction & func = *args.fGradFunc; 
+            const UnBinData & data = *args.fUnBinData; 
+            const double * p = args.fParams; 
+            unsigned int n = data.Size();
+
+            unsigned int npar = func.NPar(); 
+            std::vector<double> gradFunc( npar ); 
+            std::vector<double> & g = result.fGrad; 
+
+            for (unsigned int i = begin; i < end; ++ i) { 
+               const double * x = data.Coords(i);
+               double fval = func ( x , p ); 
+               func.ParameterGradient( x, p, &gradFunc[0] );
+               for (unsigned int kpar = 0; kpar < npar; ++ kpar) { 
+                  if (fval > 0)  
+                     g[kpar] -= 1./fval * gradFunc[ kpar ]; 
+                  else if (gradFunc [ kpar] != 0) { 
+                     const double kdmax1 = std::sqrt( std::numeric_limits<double>::max() );
+                     const double kdmax2 = std::numeric_limits<double>::max() / (4*n);
+                     double gg = kdmax1 * gradFunc[ kpar ];  
+                     if ( gg > 0) gg = std::min( gg, kdmax2);
+                     else gg = std::max(gg, - kdmax2);
+                     g[kpar] -= gg;
+                  }
+                  // if func derivative is zero term is also zero so do not add in g[kpar]
+               }
+            }
+         }
+
+         void EvaluatePoissonLogLRange(const RangeArgs & args, unsigned int begin, unsigned int end, RangeResult & result) { 
+            // evaluate the Poisson log-likelihood contribution of the bins in [begin, end) 
+
+            const IModelFunction & func = args.fFunc; 
+            const BinData & data = *args.fBinData; 
+            const double * p = args.fParams; 
+            bool extended = args.fExtended; 
+
+            // get fit option and check case of using integral of bins
+            const DataOptions & fitOpt = data.Opt();
+            bool useBinIntegral = fitOpt.fIntegral && data.HasBinEdges(); 
+            bool useBinVolume = (fitOpt.fBinVolume && data.HasBinEdges());
+            bool useW2 = (args.fWeight == 2);
+
+            double wrefVolume = 1.0; 
+            std::vector<double> xc; 
+            if (useBinVolume) { 
+               wrefVolume /= data.RefVolume();
+               xc.resize(data.NDim() );
+            }
+
+            IntegralEvaluator<> igEval( func, p, fitOpt.fIntegral); 
+            BatchEvaluator<BinData> batchEval( func, data, p, end); 
+
+            double nloglike = 0; 
+
+            for (unsigned int i = begin; i < end; ++ i) { 
+               const double * x1 = data.Coords(i);
+               double y = data.Value(i);
+
+               double fval = 0;   
+               double binVolume = 1.0; 
+
+               if (useBinVolume) { 
+                  unsigned int ndim = data.NDim(); 
+                  const double * x2 = data.BinUpEdge(i);  
+                  for (unsigned int j = 0; j < ndim; ++j) {
+                     binVolume *= std::abs( x2[j]-x1[j] );
+                     xc[j] = 0.5*(x2[j]+ x1[j]);
+                  }
+                  // normalize the bin volume using a reefrence value
+                  binVolume *= wrefVolume;
+               }
+
+               const double * x = (useBinVolume) ? &xc.front() : x1;
+
+               if (!useBinIntegral) {
+                  fval = (useBinVolume) ? func ( x, p ) : batchEval(i);
+               }
+               else {
+                  // calculate integral (normalized by bin volume) 
+                  // need to set function and parameters here in case loop is parallelized
+                  fval = igEval( x1, data.BinUpEdge(i)) ; 
+               }
+               if (useBinVolume) fval *= binVolume;
+
+
+
+#ifdef DEBUG
+               int NSAMPLE = 100;
+               if (i%NSAMPLE == 0) { 
+                  std::cout << "evt " << i << " x1 = [ "; 
+                  for (unsigned int j=0; j < func.NDim(); ++j) std::cout << x[j] << " , ";
+                  std::cout << "]  ";
+                  if (fitOpt.fIntegral) { 
+                     std::cout << "x2 = [ "; 
+                     for (unsigned int j=0; j < func.NDim(); ++j) std::cout << data.BinUpEdge(i)[j] << " , ";
+                     std::cout << "] ";
+                  }
+                  std::cout << "  y = " << y << " fval = " << fval << std::endl;
+               }
+#endif
+
+
+               // EvalLog protects against 0 values of fval but don't want to add in the -log sum 
+               // negative values of fval 
+               fval = std::max(fval, 0.0);
+
+
+               double tmp = 0; 
+               if (useW2) { 
+                  // apply weight correction . Effective weight is error^2/ y
+                  // and expected events in bins is fval/weight
+                  // can apply correction only when y is not zero otherwise weight is undefined
+                  // (in case of weighted likelihood I don't care about the constant term due to 
+                  // the saturated model)
+                  if (y != 0) { 
+                     double error = data.Error(i);
+                     double weight = (error*error)/y;  // this is the bin effective weight
+                     if (extended) { 
+                        tmp = fval * weight;
+                     }
+                     tmp -= weight * y * ROOT::Math::Util::EvalLog( fval);
+                  }
+               }
+               else {
+                  // standard case no weights or iWeight=1 
+                  // this is needed for Poisson likelihood (which are extened and not for multinomial) 
+                  // the formula below  include constant term due to likelihood of saturated model (f(x) = y)
+                  // (same formula as in Baker-Cousins paper, page 439 except a factor of 2
+                  if (extended) tmp = fval -y ;
+                  if (y >  0) { 
+                     tmp +=  y *  (ROOT::Math::Util::EvalLog( y) - ROOT::Math::Util::EvalLog(fval));  
+                     result.fNPoints++;
+                  }
+               }
+
+
+               nloglike +=  tmp;  
+            }
+
+            result.fValue += nloglike; 
+         }
+
+         void EvaluatePoissonLogLGradientRange(const RangeArgs & args, unsigned int begin, unsigned int end, RangeResult & result) { 
+            // evaluate the Poisson log-likelihood gradient contribution of the bins in [begin, end) 
+
+            const IGradModelFunction & func = *args.fGradFunc; 
+            const BinData & data = *args.fBinData; 
+            const double * p = args.fParams; 
+            unsigned int n = data.Size();
+
+            const DataOptions & fitOpt = data.Opt();
+            bool useBinIntegral = fitOpt.fIntegral && data.HasBinEdges(); 
+            bool useBinVolume = (fitOpt.fBinVolume && data.HasBinEdges());
+
+            double wrefVolume = 1.0;
+            std::vector<double> xc;  
+            if (useBinVolume) {
+               wrefVolume /= data.RefVolume();
+               xc.resize(data.NDim() );
+            }
+
+            IntegralEvaluator<> igEval( func, p, useBinIntegral); 
+
+            unsigned int npar = func.NPar(); 
+            std::vector<double> gradFunc( npar ); 
+            std::vector<double> & g = result.fGrad; 
+
+            for (unsigned int i = begin; i < end; ++ i) { 
+               const double * x1 = data.Coords(i);
+               double y = data.Value(i);
+               double fval = 0; 
+               const double * x2 = 0; 
+
+               double binVolume = 1.0; 
+               if (useBinVolume) { 
+                  x2 = data.BinUpEdge(i);  
+                  unsigned int ndim = data.NDim(); 
+                  for (unsigned int j = 0; j < ndim; ++j) { 
+                     binVolume *= std::abs( x2[j]-x1[j] );
+                     xc[j] = 0.5*(x2[j]+ x1[j]);
+                  }
+                  // normalize the bin volume using a reference value
+                  binVolume *= wrefVolume;
+               }
+
+               const double * x = (useBinVolume) ? &xc.front() : x1;
+
+               if (!useBinIntegral) {
+                  fval = func ( x, p );
+                  func.ParameterGradient(  x , p, &gradFunc[0] ); 
+               }
+               else {
+                  // calculate integral (normalized by bin volume) 
+                  // need to set function and parameters here in case loop is parallelized
+                  x2 = data.BinUpEdge(i);
+                  fval = igEval( x1, x2) ; 
+                  CalculateGradientIntegral( func, x1, x2, p, &gradFunc[0]); 
+               }
+               if (useBinVolume) fval *= binVolume;
+
+               // correct the gradient
+               for (unsigned int kpar = 0; kpar < npar; ++ kpar) { 
+
+                  // correct gradient for bin volumes
+                  if (useBinVolume) gradFunc[kpar] *= binVolume; 
+
+                  // df/dp * (1.  - y/f )
+                  if (fval > 0)  
+                     g[kpar] += gradFunc[ kpar ] * ( 1. - y/fval ); 
+                  else if (gradFunc [ kpar] != 0) { 
+                     const double kdmax1 = std::sqrt( std::numeric_limits<double>::max() );
+                     const double kdmax2 = std::numeric_limits<double>::max() / (4*n);
+                     double gg = kdmax1 * gradFunc[ kpar ];  
+                     if ( gg > 0) gg = std::min( gg, kdmax2);
+                     else gg = std::max(gg, - kdmax2);
+                     g[kpar] -= gg;
+                  }
+               }            
+            }
+         }
+
+
+      } // end namespace  FitUtil      
+
+
+
+//___________________________________________________________________________________________________________________________
+// for chi2 functions
+//___________________________________________________________________________________________________________________________
+
+double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data, const double * p, unsigned int & nPoints, unsigned int nthreads) {  
+   // evaluate the chi2 given a  function reference  , the data and returns the value and also in nPoints 
+   // the actual number of used points
+   // normal chi2 using only error on values (from fitting histogram)
+   // optionally the integral of function in the bin is used 
+   // when nthreads > 1 the points are evaluated in parallel (the function must be thread safe)
+   
+   unsigned int n = data.Size();
+
+   // do not cache parameter values (it is not thread safe)
+   //func.SetParameters(p); 
+
+#ifdef DEBUG
+   const DataOptions & fitOpt = data.Opt();
+   std::cout << "\n\nFit data size = " << n << std::endl;
+   std::cout << "evaluate chi2 using function " << &func << "  " << p << std::endl; 
+   std::cout << "use empty bins  " << fitOpt.fUseEmpty << std::endl;
+   std::cout << "use integral    " << fitOpt.fIntegral << std::endl;
+   std::cout << "use all error=1 " << fitOpt.fErrors1 << std::endl;
+#endif
+
+   RangeArgs args(func, p); 
+   args.fBinData = &data; 
+   RangeResult result; 
+   EvaluateRange(&EvaluateChi2Range, args, n, MaxThreads(data, nthreads), 0, result); 
+   double chi2 = result.fValue; 
+
    nPoints=n;
 
 #ifdef DEBUG
@@ -683,7 +1337,7 @@ double FitUtil::EvaluateChi2Residual(const IModelFunction & func, const BinData
 
 }
 
-void FitUtil::EvaluateChi2Gradient(const IModelFunction & f, const BinData & data, const double * p, double * grad, unsigned int & nPoints) { 
+void FitUtil::EvaluateChi2Gradient(const IModelFunction & f, const BinData & data, const double * p, double * grad, unsigned int & nPoints, unsigned int nthreads) { 
    // evaluate the gradient of the chi2 function
    // this function is used when the model function knows how to calculate the derivative and we can  
    // avoid that the minimizer re-computes them 
@@ -694,8 +1348,6 @@ void FitUtil::EvaluateChi2Gradient(const IModelFunction & f, const BinData & dat
       MATH_ERROR_MSG("FitUtil::EvaluateChi2Residual","Error on the coordinates are not used in calculating Chi2 gradient");            return; // it will assert otherwise later in GetPoint
    }
 
-   unsigned int nRejected = 0; 
-
    const IGradModelFunction * fg = dynamic_cast<const IGradModelFunction *>( &f); 
    assert (fg != 0); // must be called by a gradient function
 
@@ -708,103 +1360,14 @@ void FitUtil::EvaluateChi2Gradient(const IModelFunction & f, const BinData & dat
    std::cout << "evaluate chi2 using function gradient " << &func << "  " << p << std::endl; 
 #endif
 
-   const DataOptions & fitOpt = data.Opt();
-   bool useBinIntegral = fitOpt.fIntegral && data.HasBinEdges(); 
-   bool useBinVolume = (fitOpt.fBinVolume && data.HasBinEdges());
-
-   double wrefVolume = 1.0; 
-   std::vector<double> xc; 
-   if (useBinVolume) { 
-      wrefVolume /= data.RefVolume();
-      xc.resize(data.NDim() );
-   }
-
-   IntegralEvaluator<> igEval( func, p, useBinIntegral); 
-
-   //int nRejected = 0; 
-   // set values of parameters 
-
    unsigned int npar = func.NPar(); 
-   //   assert (npar == NDim() );  // npar MUST be  Chi2 dimension
-   std::vector<double> gradFunc( npar ); 
-   // set all vector values to zero
-   std::vector<double> g( npar); 
-
-   for (unsigned int i = 0; i < n; ++ i) { 
-
-
-      double y, invError = 0; 
-      const double * x1 = data.GetPoint(i,y, invError);
-
-      double fval = 0; 
-      const double * x2 = 0; 
-
-      double binVolume = 1; 
-      if (useBinVolume) { 
-         unsigned int ndim = data.NDim(); 
-         x2 = data.BinUpEdge(i);  
-         for (unsigned int j = 0; j < ndim; ++j) {
-            binVolume *= std::abs( x2[j]-x1[j] );
-            xc[j] = 0.5*(x2[j]+ x1[j]);
-         }
-         // normalize the bin volume using a reference value
-         binVolume *= wrefVolume;
-      }
-
-      const double * x = (useBinVolume) ? &xc.front() : x1;
-
-      if (!useBinIntegral ) {
-         fval = func ( x, p ); 
-         func.ParameterGradient(  x , p, &gradFunc[0] ); 
-      }
-      else { 
-         x2 = data.BinUpEdge(i); 
-         // calculate normalized integral and gradient (divided by bin volume)
-         // need to set function and parameters here in case loop is parallelized 
-         fval = igEval( x1, x2 ) ; 
-         CalculateGradientIntegral( func, x1, x2, p, &gradFunc[0]); 
-      }
-      if (useBinVolume) fval *= binVolume;
 
-#ifdef DEBUG      
-      std::cout << x[0] << "  " << y << "  " << 1./invError << " params : "; 
-      for (unsigned int ipar = 0; ipar < npar; ++ipar) 
-         std::cout << p[ipar] << "\t";
-      std::cout << "\tfval = " << fval << std::endl; 
-#endif
-      if ( !CheckValue(fval) ) { 
-         nRejected++; 
-         continue;
-      } 
-
-      // loop on the parameters
-      unsigned int ipar = 0; 
-      for ( ; ipar < npar ; ++ipar) { 
-
-         // correct gradient for bin volumes
-         if (useBinVolume) gradFunc[ipar] *= binVolume;
-
-         // avoid singularity in the function (infinity and nan ) in the chi2 sum 
-         // eventually add possibility of excluding some points (like singularity) 
-         double dfval = gradFunc[ipar];
-         if ( !CheckValue(dfval) ) { 
-               break; // exit loop on parameters
-         } 
- 
-         // calculate derivative point contribution
-         double tmp = - 2.0 * ( y -fval )* invError * invError * gradFunc[ipar];  	  
-         g[ipar] += tmp;
-      
-      }
-
-      if ( ipar < npar ) { 
-          // case loop was broken for an overflow in the gradient calculation  
-         nRejected++; 
-         continue;
-      } 
-
-
-   } 
+   RangeArgs args(func, p); 
+   args.fGradFunc = &func; 
+   args.fBinData = &data; 
+   RangeResult result; 
+   EvaluateRange(&EvaluateChi2GradientRange, args, n, MaxThreads(data, nthreads), npar, result); 
+   unsigned int nRejected = result.fNRejected; 
 
    // correct the number of points
    nPoints = n; 
@@ -815,7 +1378,7 @@ void FitUtil::EvaluateChi2Gradient(const IModelFunction & f, const BinData & dat
    } 
 
    // copy result 
-   std::copy(g.begin(), g.end(), grad);
+   std::copy(result.fGrad.begin(), result.fGrad.end(), grad);
 
 }
 
@@ -876,8 +1439,9 @@ double FitUtil::EvaluatePdf(const IModelFunction & func, const UnBinData & data,
 }
 
 double FitUtil::EvaluateLogL(const IModelFunction & func, const UnBinData & data, const double * p,
-                                   int iWeight,  bool extended, unsigned int &nPoints) {  
+                             int iWeight,  bool extended, unsigned int &nPoints, unsigned int nthreads) {  
    // evaluate the LogLikelihood 
+   // when nthreads > 1 the points are evaluated in parallel (the function must be thread safe)
 
    unsigned int n = data.Size();
 
@@ -901,40 +1465,14 @@ double FitUtil::EvaluateLogL(const IModelFunction & func, const UnBinData & data
       norm = igEval.Integral(&xmin[0],&xmax[0]);
    }
 
-   // needed to compue effective global weight in case of extended likelihood 
-   double sumW = 0;
-   double sumW2 = 0;
-
-   for (unsigned int i = 0; i < n; ++ i) { 
-      const double * x = data.Coords(i);
-      double fval = func ( x, p ); 
-      if (normalizeFunc) fval = fval / norm;
-
-#ifdef DEBUG      
-      std::cout << "x [ " << data.NDim() << " ] = "; 
-      for (unsigned int j = 0; j < data.NDim(); ++j)
-         std::cout << x[j] << "\t"; 
-      std::cout << "\tpar = [ " << func.NPar() << " ] =  "; 
-      for (unsigned int ipar = 0; ipar < func.NPar(); ++ipar) 
-         std::cout << p[ipar] << "\t";
-      std::cout << "\tfval = " << fval << std::endl; 
-#endif
-      // function EvalLog protects against negative or too small values of fval
-      double logval =  ROOT::Math::Util::EvalLog( fval);       
-      if (iWeight > 0) { 
-         double weight = data.Weight(i); 
-         logval *= weight; 
-         if (iWeight ==2) { 
-            logval *= weight; // use square of weights in likelihood
-            if (extended) { 
-               // needed sum of weights and sum of weight square if likelkihood is extended
-               sumW += weight; 
-               sumW2 += weight*weight; 
-            }
-         }
-      }
-      logl += logval;
-   }
+   // sum the log of the pdf values (and the weights needed for the extended term)
+   RangeArgs args(func, p, iWeight, extended); 
+   args.fUnBinData = &data; 
+   RangeResult result; 
+   EvaluateRange(&EvaluateLogLRange, args, n, MaxThreads(data, nthreads), 0, result); 
+   logl = result.fValue; 
+   double sumW = result.fSumW;
+   double sumW2 = result.fSumW2;
 
    if (extended) { 
       // add Poisson extended term
@@ -991,7 +1529,7 @@ double FitUtil::EvaluateLogL(const IModelFunction & func, const UnBinData & data
    return -logl;
 }
 
-void FitUtil::EvaluateLogLGradient(const IModelFunction & f, const UnBinData & data, const double * p, double * grad, unsigned int & ) { 
+void FitUtil::EvaluateLogLGradient(const IModelFunction & f, const UnBinData & data, const double * p, double * grad, unsigned int &, unsigned int nthreads) { 
    // evaluate the gradient of the log likelihood function
 
    const IGradModelFunction * fg = dynamic_cast<const IGradModelFunction *>( &f); 
@@ -999,33 +1537,16 @@ void FitUtil::EvaluateLogLGradient(const IModelFunction & f, const UnBinData & d
    const IGradModelFunction & func = *fg; 
 
    unsigned int n = data.Size();
-   //int nRejected = 0; 
-
    unsigned int npar = func.NPar(); 
-   std::vector<double> gradFunc( npar ); 
-   std::vector<double> g( npar); 
 
-   for (unsigned int i = 0; i < n; ++ i) { 
-      const double * x = data.Coords(i);
-      double fval = func ( x , p); 
-      func.ParameterGradient( x, p, &gradFunc[0] );
-      for (unsigned int kpar = 0; kpar < npar; ++ kpar) { 
-         if (fval > 0)  
-            g[kpar] -= 1./fval * gradFunc[ kpar ]; 
-         else if (gradFunc [ kpar] != 0) { 
-            const double kdmax1 = std::sqrt( std::numeric_limits<double>::max() );
-            const double kdmax2 = std::numeric_limits<double>::max() / (4*n);
-            double gg = kdmax1 * gradFunc[ kpar ];  
-            if ( gg > 0) gg = std::min( gg, kdmax2);
-            else gg = std::max(gg, - kdmax2);
-            g[kpar] -= gg;
-         }
-         // if func derivative is zero term is also zero so do not add in g[kpar]
-      }
-            
-    // copy result 
-   std::copy(g.begin(), g.end(), grad);
-   }
+   RangeArgs args(func, p); 
+   args.fGradFunc = &func; 
+   args.fUnBinData = &data; 
+   RangeResult result; 
+   EvaluateRange(&EvaluateLogLGradientRange, args, n, MaxThreads(data, nthreads), npar, result); 
+
+   // copy result 
+   std::copy(result.fGrad.begin(), result.fGrad.end(), grad);
 }
 //_________________________________________________________________________________________________
 // for binned log likelihood functions      
@@ -1137,7 +1658,7 @@ double FitUtil::EvaluatePoissonBinPdf(const IModelFunction & func, const BinData
 }
 
 double FitUtil::EvaluatePoissonLogL(const IModelFunction & func, const BinData & data, 
-                                    const double * p, int iWeight, bool extended,  unsigned int &   nPoints ) {  
+                                    const double * p, int iWeight, bool extended,  unsigned int &   nPoints, unsigned int nthreads ) {  
    // evaluate the Poisson Log Likelihood
    // for binned likelihood fits
    // this is Sum ( f(x_i)  -  y_i * log( f (x_i) ) )
@@ -1153,6 +1674,7 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction & func, const BinData &
    // iWeight = 2 ==> logL = Sum( w*w * f(x_i) )
    //
    // nPoints returns the points where bin content is not zero
+   // when nthreads > 1 the bins are evaluated in parallel (the function must be thread safe)
          
 
    unsigned int n = data.Size();
@@ -1165,120 +1687,13 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction & func, const BinData &
    double nloglike = 0;  // negative loglikelihood 
    nPoints = 0;  // npoints
 
+   RangeArgs args(func, p, iWeight, extended); 
+   args.fBinData = &data; 
+   RangeResult result; 
+   EvaluateRange(&EvaluatePoissonLogLRange, args, n, MaxThreads(data, nthreads), 0, result); 
+   nloglike = result.fValue; 
+   nPoints = result.fNPoints; 
 
-   // get fit option and check case of using integral of bins
-   const DataOptions & fitOpt = data.Opt();
-   bool useBinIntegral = fitOpt.fIntegral && data.HasBinEdges(); 
-   bool useBinVolume = (fitOpt.fBinVolume && data.HasBinEdges());
-   bool useW2 = (iWeight == 2);
-
-   double wrefVolume = 1.0; 
-   std::vector<double> xc; 
-   if (useBinVolume) { 
-      wrefVolume /= data.RefVolume();
-      xc.resize(data.NDim() );
-   }
-
-   IntegralEvaluator<> igEval( func, p, fitOpt.fIntegral); 
-
-   // double nuTot = 0; // total number of expected events (needed for non-extended fits) 
-   // double wTot = 0; // sum of all weights  
-   // double w2Tot = 0; // sum of weight squared  (these are needed for useW2)
-
-
-   for (unsigned int i = 0; i < n; ++ i) { 
-      const double * x1 = data.Coords(i);
-      double y = data.Value(i);
-      
-      double fval = 0;   
-      double binVolume = 1.0; 
-
-      if (useBinVolume) { 
-         unsigned int ndim = data.NDim(); 
-         const double * x2 = data.BinUpEdge(i);  
-         for (unsigned int j = 0; j < ndim; ++j) {
-            binVolume *= std::abs( x2[j]-x1[j] );
-            xc[j] = 0.5*(x2[j]+ x1[j]);
-         }
-         // normalize the bin volume using a reefrence value
-         binVolume *= wrefVolume;
-      }
-
-      const double * x = (useBinVolume) ? &xc.front() : x1;
-
-      if (!useBinIntegral) {
-         fval = func ( x, p );
-      }
-      else {
-         // calculate integral (normalized by bin volume) 
-         // need to set function and parameters here in case loop is parallelized
-         fval = igEval( x1, data.BinUpEdge(i)) ; 
-      }
-      if (useBinVolume) fval *= binVolume;
-
-
-
-#ifdef DEBUG
-      int NSAMPLE = 100;
-      if (i%NSAMPLE == 0) { 
-         std::cout << "evt " << i << " x1 = [ "; 
-         for (unsigned int j=0; j < func.NDim(); ++j) std::cout << x[j] << " , ";
-         std::cout << "]  ";
-         if (fitOpt.fIntegral) { 
-            std::cout << "x2 = [ "; 
-            for (unsigned int j=0; j < func.NDim(); ++j) std::cout << data.BinUpEdge(i)[j] << " , ";
-            std::cout << "] ";
-         }
-         std::cout << "  y = " << y << " fval = " << fval << std::endl;
-      }
-#endif
-
-
-      // EvalLog protects against 0 values of fval but don't want to add in the -log sum 
-      // negative values of fval 
-      fval = std::max(fval, 0.0);
-
-
-      double tmp = 0; 
-      if (useW2) { 
-         // apply weight correction . Effective weight is error^2/ y
-         // and expected events in bins is fval/weight
-         // can apply correction only when y is not zero otherwise weight is undefined
-         // (in case of weighted likelihood I don't care about the constant term due to 
-         // the saturated model)
-         if (y != 0) { 
-            double error = data.Error(i);
-            double weight = (error*error)/y;  // this is the bin effective weight
-            if (extended) { 
-               tmp = fval * weight;
-               // wTot  += weight; 
-               // w2Tot += weight*weight; 
-            }
-            tmp -= weight * y * ROOT::Math::Util::EvalLog( fval);
-         }
-         
-         //  need to compute total weight and weight-square
-         // if (extended ) { 
-         //    nuTot += fval;
-         // }
-
-      }
-      else {
-         // standard case no weights or iWeight=1 
-         // this is needed for Poisson likelihood (which are extened and not for multinomial) 
-         // the formula below  include constant term due to likelihood of saturated model (f(x) = y)
-         // (same formula as in Baker-Cousins paper, page 439 except a factor of 2
-         if (extended) tmp = fval -y ;
-         if (y >  0) { 
-            tmp +=  y *  (ROOT::Math::Util::EvalLog( y) - ROOT::Math::Util::EvalLog(fval));  
-            nPoints++;
-         }
-      }
-
-
-      nloglike +=  tmp;  
-   }
-   
    // if (notExtended) { 
    //    // not extended : remove from the Likelihood the global Poisson term
    //    if (!useW2)  
@@ -1303,7 +1718,7 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction & func, const BinData &
    return nloglike;  
 }
 
-void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction & f, const BinData & data, const double * p, double * grad ) { 
+void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction & f, const BinData & data, const double * p, double * grad, unsigned int nthreads ) { 
    // evaluate the gradient of the Poisson log likelihood function
 
    const IGradModelFunction * fg = dynamic_cast<const IGradModelFunction *>( &f); 
@@ -1311,79 +1726,16 @@ void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction & f, const BinDat
    const IGradModelFunction & func = *fg; 
 
    unsigned int n = data.Size();
-
-   const DataOptions & fitOpt = data.Opt();
-   bool useBinIntegral = fitOpt.fIntegral && data.HasBinEdges(); 
-   bool useBinVolume = (fitOpt.fBinVolume && data.HasBinEdges());
-
-   double wrefVolume = 1.0;
-   std::vector<double> xc;  
-   if (useBinVolume) {
-      wrefVolume /= data.RefVolume();
-      xc.resize(data.NDim() );
-   }
-
-   IntegralEvaluator<> igEval( func, p, useBinIntegral); 
-
    unsigned int npar = func.NPar(); 
-   std::vector<double> gradFunc( npar ); 
-   std::vector<double> g( npar); 
-
-   for (unsigned int i = 0; i < n; ++ i) { 
-      const double * x1 = data.Coords(i);
-      double y = data.Value(i);
-      double fval = 0; 
-      const double * x2 = 0; 
-
-      double binVolume = 1.0; 
-      if (useBinVolume) { 
-         x2 = data.BinUpEdge(i);  
-         unsigned int ndim = data.NDim(); 
-         for (unsigned int j = 0; j < ndim; ++j) { 
-            binVolume *= std::abs( x2[j]-x1[j] );
-            xc[j] = 0.5*(x2[j]+ x1[j]);
-         }
-         // normalize the bin volume using a reference value
-         binVolume *= wrefVolume;
-      }
 
-      const double * x = (useBinVolume) ? &xc.front() : x1;
+   RangeArgs args(func, p); 
+   args.fGradFunc = &func; 
+   args.fBinData = &data; 
+   RangeResult result; 
+   EvaluateRange(&EvaluatePoissonLogLGradientRange, args, n, MaxThreads(data, nthreads), npar, result); 
 
-      if (!useBinIntegral) {
-         fval = func ( x, p );
-         func.ParameterGradient(  x , p, &gradFunc[0] ); 
-      }
-      else {
-         // calculate integral (normalized by bin volume) 
-         // need to set function and parameters here in case loop is parallelized
-         x2 = data.BinUpEdge(i);
-         fval = igEval( x1, x2) ; 
-         CalculateGradientIntegral( func, x1, x2, p, &gradFunc[0]); 
-      }
-      if (useBinVolume) fval *= binVolume;
-      
-      // correct the gradient
-      for (unsigned int kpar = 0; kpar < npar; ++ kpar) { 
-
-         // correct gradient for bin volumes
-         if (useBinVolume) gradFunc[kpar] *= binVolume; 
-
-         // df/dp * (1.  - y/f )
-         if (fval > 0)  
-            g[kpar] += gradFunc[ kpar ] * ( 1. - y/fval ); 
-         else if (gradFunc [ kpar] != 0) { 
-            const double kdmax1 = std::sqrt( std::numeric_limits<double>::max() );
-            const double kdmax2 = std::numeric_limits<double>::max() / (4*n);
-            double gg = kdmax1 * gradFunc[ kpar ];  
-            if ( gg > 0) gg = std::min( gg, kdmax2);
-            else gg = std::max(gg, - kdmax2);
-            g[kpar] -= gg;
-         }
-      }            
-
-      // copy result 
-      std::copy(g.begin(), g.end(), grad);
-   }
+   // copy result 
+   std::copy(result.fGrad.begin(), result.fGrad.end(), grad);
 }
    
 }
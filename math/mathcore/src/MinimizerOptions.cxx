@@ -34,6 +34,7 @@ namespace Math {
       static int  gDefaultMaxIter  = 0; 
       static int  gDefaultStrategy  = 1; 
       static int  gDefaultPrintLevel  = 0; 
+      static unsigned int gDefaultNThreads = 1; 
    }
 
 
@@ -70,6 +71,10 @@ void MinimizerOptions::SetDefaultPrintLevel(int level) {
    // set the default printing level 
    Minim::gDefaultPrintLevel = level; 
 }
+void MinimizerOptions::SetDefaultNThreads(unsigned int nthreads) {
+   // set the default number of threads used for evaluating the objective function
+   Minim::gDefaultNThreads = (nthreads > 0) ? nthreads : 1; 
+}
 
 const std::string & MinimizerOptions::DefaultMinimizerAlgo() { return Minim::gDefaultMinimAlgo; }
 double MinimizerOptions::DefaultErrorDef()         { return Minim::gDefaultErrorDef; }
@@ -79,6 +84,7 @@ int    MinimizerOptions::DefaultMaxFunctionCalls() { return Minim::gDefaultMaxCa
 int    MinimizerOptions::DefaultMaxIterations()    { return Minim::gDefaultMaxIter; }
 int    MinimizerOptions::DefaultStrategy()         { return Minim::gDefaultStrategy; }
 int    MinimizerOptions::DefaultPrintLevel()       { return Minim::gDefaultPrintLevel; }
+unsigned int MinimizerOptions::DefaultNThreads()   { return Minim::gDefaultNThreads; }
 
 const std::string & MinimizerOptions::DefaultMinimizerType() 
 { 
@@ -104,6 +110,7 @@ MinimizerOptions::MinimizerOptions(IOptions * extraOpts):
    fMaxCalls( Minim::gDefaultMaxCalls ), 
    fMaxIter( Minim::gDefaultMaxIter ), 
    fStrategy( Minim::gDefaultStrategy ), 
+   fNThreads( Minim::gDefaultNThreads ), 
    fErrorDef(  Minim::gDefaultErrorDef ), 
    fTolerance( Minim::gDefaultTolerance ),
    fPrecision( Minim::gDefaultPrecision ),
@@ -144,6 +151,7 @@ MinimizerOptions & MinimizerOptions::operator=(const MinimizerOptions & opt) {
    fMaxCalls = opt.fMaxCalls; 
    fMaxIter = opt.fMaxIter; 
    fStrategy = opt.fStrategy; 
+   fNThreads = opt.fNThreads; 
    fErrorDef = opt.fErrorDef;
    fTolerance = opt.fTolerance;
    fPrecision = opt.fPrecision; 
@@ -177,6 +185,8 @@ void MinimizerOptions::Print(std::ostream & os) const {
    os << std::setw(25) << "Func Precision"         << " : " << std::setw(15) << fPrecision << std::endl;
    os << std::setw(25) << "Error definition"       << " : " << std::setw(15) << fErrorDef << std::endl;
    os << std::setw(25) << "Print Level"            << " : " << std::setw(15) << fLevel << std::endl;
+   if (fNThreads > 1) 
+      os << std::setw(25) << "Number of threads"   << " : " << std::setw(15) << fNThreads << std::endl;
    
    if (ExtraOptions()) { 
       os << fMinimType << " specific options :"  << std::endl;
@@ -26,7 +26,8 @@ UnBinData::UnBinData(unsigned int maxpoints, unsigned int dim, bool isWeighted
    fPointSize( (isWeighted) ? dim +1 : dim),
    fNPoints(0),   
    fDataVector(0), 
-   fDataWrapper(0)
+   fDataWrapper(0),
+   fDataColumns(0)
 { 
    // constructor with default option and range
    unsigned int n = fPointSize*maxpoints; 
@@ -42,7 +43,8 @@ UnBinData::UnBinData (const DataRange & range,  unsigned int maxpoints , unsigne
    fPointSize( (isWeighted) ? dim +1 : dim),
    fNPoints(0), 
    fDataVector(0), 
-   fDataWrapper(0)
+   fDataWrapper(0),
+   fDataColumns(0)
 {
    // constructor from option and default range
    unsigned int n = fPointSize*maxpoints; 
@@ -58,7 +60,8 @@ UnBinData::UnBinData (const DataOptions & opt, const DataRange & range,  unsigne
    fPointSize( (isWeighted) ? dim +1 : dim),
    fNPoints(0),
    fDataVector(0), 
-   fDataWrapper(0)
+   fDataWrapper(0),
+   fDataColumns(0)
 {
    // constructor from options and range
    unsigned int n = fPointSize*maxpoints; 
@@ -73,7 +76,8 @@ UnBinData::UnBinData(unsigned int n, const double * dataX ) :
    fDim(1), 
    fPointSize(1),
    fNPoints(n),
-   fDataVector(0)
+   fDataVector(0),
+   fDataColumns(0)
 { 
    // constructor for 1D external data
    fDataWrapper = new DataWrapper(dataX);
@@ -85,7 +89,8 @@ UnBinData::UnBinData(unsigned int n, const double * dataX, const double * dataY,
    fPointSize(2),
    fNPoints(n),
    fDataVector(0),
-   fDataWrapper(0)
+   fDataWrapper(0),
+   fDataColumns(0)
 { 
    //    constructor for 2D external data
    fDataWrapper = new DataWrapper(dataX, dataY, 0, 0, 0, 0);
@@ -96,7 +101,8 @@ UnBinData::UnBinData(unsigned int n, const double * dataX, const double * dataY,
    fDim( (isWeighted) ? 2 : 3),
    fPointSize(3),
    fNPoints(n),
-   fDataVector(0)
+   fDataVector(0),
+   fDataColumns(0)
 { 
    //   constructor for 3D external data
    fDataWrapper = new DataWrapper(dataX, dataY, dataZ, 0, 0, 0, 0, 0);
@@ -108,7 +114,8 @@ UnBinData::UnBinData(unsigned int n, const double * dataX, const DataRange & ran
    fPointSize(1),
    fNPoints(0),
    fDataVector(0),
-   fDataWrapper(0)
+   fDataWrapper(0),
+   fDataColumns(0)
 { 
    // constructor for 1D array data using a range to select the data
    // copy the data inside
@@ -131,7 +138,8 @@ UnBinData::UnBinData(unsigned int n, const double * dataX, const double * dataY,
    fPointSize(2),
    fNPoints(0),
    fDataVector(0),
-   fDataWrapper(0)
+   fDataWrapper(0),
+   fDataColumns(0)
 { 
    // constructor for 2D array data using a range to select the data
    // copy the data inside
@@ -156,7 +164,8 @@ UnBinData::UnBinData(unsigned int n, const double * dataX, const double * dataY,
    fPointSize(3),
    fNPoints(0),
    fDataVector(0),
-   fDataWrapper(0)
+   fDataWrapper(0),
+   fDataColumns(0)
 { 
    // constructor for 3D array data using a range to select the data
    if ( n > MaxSize() ) 
@@ -177,6 +186,8 @@ UnBinData::UnBinData(unsigned int n, const double * dataX, const double * dataY,
 void UnBinData::Initialize(unsigned int maxpoints, unsigned int dim, bool isWeighted ) { 
    //   preallocate a data set given size and dimension
    unsigned int pointSize = (isWeighted) ? dim+1 : dim;
+   // new points are added by point
+   if (fDataColumns) StoreByPoints(); 
    if ( (dim != fDim || pointSize != fPointSize) && fDataVector) { 
 //       MATH_INFO_MSGVAL("BinData::Initialize"," Reset amd re-initialize with a new fit point size of ",
 //                        dim);
@@ -203,6 +214,7 @@ void UnBinData::Resize(unsigned int npoints) {
       MATH_ERROR_MSGVAL("BinData::Resize"," Invalid data size  ", npoints );
       return; 
    }
+   if (fDataColumns) StoreByPoints(); 
    if (fDataVector != 0)  { 
       int nextraPoints = npoints -  fDataVector->Size()/fPointSize; 
       if  (nextraPoints < 0) {
@@ -221,6 +233,41 @@ void UnBinData::Resize(unsigned int npoints) {
 }
 
 
+bool UnBinData::StoreByColumns() { 
+   // re-arrange the copied data in a column for each coordinate (and the weight)
+
+   if (fDataColumns) return true; 
+   if (!fDataVector) return false; 
+
+   fDataColumns = new DataColumns(fPointSize, fNPoints); 
+   const std::vector<double> & data = fDataVector->Data(); 
+   for (unsigned int k = 0; k < fPointSize; ++k) { 
+      double * column = fDataColumns->Column(k); 
+      for (unsigned int i = 0; i < fNPoints; ++i) 
+         column[i] = data[i*fPointSize + k]; 
+   }
+   delete fDataVector; 
+   fDataVector = 0; 
+   fPointCache.resize(fPointSize); 
+   return true; 
+}
+
+void UnBinData::StoreByPoints() { 
+   // re-arrange the data stored by column in a data vector by point 
+
+   if (!fDataColumns) return; 
+   assert(fDataVector == 0); 
+   fDataVector = new DataVector(fPointSize*fNPoints); 
+   std::vector<double> & data = fDataVector->Data(); 
+   for (unsigned int k = 0; k < fPointSize; ++k) { 
+      const double * column = fDataColumns->Column(k); 
+      for (unsigned int i = 0; i < fNPoints; ++i) 
+         data[i*fPointSize + k] = column[i]; 
+   }
+   delete fDataColumns; 
+   fDataColumns = 0; 
+}
+
 
    } // end namespace Fit
 
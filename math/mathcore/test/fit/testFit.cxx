@@ -14,6 +14,7 @@
 #include "Fit/UnBinData.h"
 #include "HFitInterface.h"
 #include "Fit/Fitter.h"
+#include "Fit/FitUtil.h"
 
 #include "Math/WrappedMultiTF1.h"
 #include "Math/WrappedParamFunction.h"
@@ -24,6 +25,12 @@
 #include <string>
 #include <iostream>
 #include <cmath>
+#include <vector>
+#include <algorithm>
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
 
 // print the data
 void printData(const ROOT::Fit::BinData & data) {
@@ -914,6 +921,303 @@ int testGraphFit() {
 }
 
 
+// gaussian model function for the evaluation using several threads (must be thread safe)
+double gausModel(const double * x, const double * p) { 
+   double z = (x[0]-p[1])/p[2]; 
+   return p[0]*std::exp(-0.5*z*z); 
+}
+
+int testThreadedEvaluation() { 
+   // the chi2 and the likelihoods evaluated using several threads must not depend on the 
+   // number of threads and agree with the sequential evaluation up to rounding
+
+   int iret = 0; 
+
+   TRandom3 rndm;
+   TH1D * h1 = new TH1D("h1mt","h1mt",1000,-5.,5.);
+   for (int i = 0; i < 100000; ++i) 
+      h1->Fill( rndm.Gaus(0,1) );
+   ROOT::Fit::BinData bd; 
+   ROOT::Fit::FillData(bd,h1);
+
+   int n = 50000;
+   ROOT::Fit::UnBinData ud(n); 
+   for (int i = 0; i < n; ++i) 
+      ud.Add( rndm.Gaus(0,1) );
+
+   ROOT::Math::WrappedParamFunction<> f(&gausModel,1,3); 
+   double p[3] = {380.,0.1,1.1}; 
+
+   unsigned int npoints = 0; 
+   double chi2seq = ROOT::Fit::FitUtil::EvaluateChi2(f, bd, p, npoints, 1); 
+   double poisseq = ROOT::Fit::FitUtil::EvaluatePoissonLogL(f, bd, p, 0, false, npoints, 1); 
+   double loglseq = ROOT::Fit::FitUtil::EvaluateLogL(f, ud, p, 0, false, npoints, 1); 
+   double chi2ref = ROOT::Fit::FitUtil::EvaluateChi2(f, bd, p, npoints, 2); 
+   double poisref = ROOT::Fit::FitUtil::EvaluatePoissonLogL(f, bd, p, 0, false, npoints, 2); 
+   double loglref = ROOT::Fit::FitUtil::EvaluateLogL(f, ud, p, 0, false, npoints, 2); 
+
+   const double tol = 1.E-10; 
+   if (std::abs(chi2ref - chi2seq) > tol*std::abs(chi2seq) || std::abs(poisref - poisseq) > tol*std::abs(poisseq) || 
+       std::abs(loglref - loglseq) > tol*std::abs(loglseq) ) { 
+      std::cerr << "Evaluation using 2 threads differs from the sequential one: chi2 = " << chi2ref << " (" << chi2seq 
+                << ") poisson logl = " << poisref << " (" << poisseq << ") logl = " << loglref << " (" << loglseq << ")" << std::endl;
+      iret |= 1; 
+   }
+
+   const int ntests = 3; 
+   unsigned int nthreads[ntests] = {3, 8, 2}; 
+   for (int i = 0; i < ntests; ++i) { 
+      double chi2 = ROOT::Fit::FitUtil::EvaluateChi2(f, bd, p, npoints, nthreads[i]); 
+      double pois = ROOT::Fit::FitUtil::EvaluatePoissonLogL(f, bd, p, 0, false, npoints, nthreads[i]); 
+      double logl = ROOT::Fit::FitUtil::EvaluateLogL(f, ud, p, 0, false, npoints, nthreads[i]); 
+      if (chi2 != chi2ref || pois != poisref || logl != loglref) { 
+         std::cerr << "Evaluation using " << nthreads[i] << " threads differs: chi2 = " << chi2 << " (" << chi2ref 
+                   << ") poisson logl = " << pois << " (" << poisref << ") logl = " << logl << " (" << loglref << ")" << std::endl;
+         iret |= 1; 
+      }
+   }
+
+#ifndef _WIN32
+   // the threads of the pool are not copied by fork: the child must start its own ones
+   pid_t pid = fork(); 
+   if (pid == 0) { 
+      double chi2 = ROOT::Fit::FitUtil::EvaluateChi2(f, bd, p, npoints, 4); 
+      _exit( (chi2 == chi2ref) ? 0 : 1 ); 
+   }
+   int status = 0; 
+   if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) { 
+      std::cerr << "Evaluation using 4 threads in a forked process failed" << std::endl;
+      iret |= 1; 
+   }
+#endif
+
+   // the fits must then give the same result for any number of threads larger than one
+   ROOT::Fit::Fitter fitter; 
+   fitter.Config().SetMinimizer("Minuit2");
+   f.SetParameters(p); 
+   fitter.Config().SetNThreads(2);
+   bool ret = fitter.Fit(bd, f);
+   if (!ret) { 
+      std::cout << "Chi2 Fit using 2 threads Failed " << std::endl;
+      return -1; 
+   }
+   ROOT::Fit::FitResult resref = fitter.Result(); 
+   f.SetParameters(p); 
+   fitter.Config().SetNThreads(4);
+   ret = fitter.Fit(bd, f);
+   if (!ret) { 
+      std::cout << "Chi2 Fit using 4 threads Failed " << std::endl;
+      return -1; 
+   }
+   fitter.Result().Print(std::cout); 
+   if (fitter.Result().MinFcnValue() != resref.MinFcnValue() || fitter.Result().Parameter(2) != resref.Parameter(2) ) { 
+      std::cerr << "Chi2 fit using 4 threads differs: chi2 = " << fitter.Result().MinFcnValue() 
+                << " it should be = " << resref.MinFcnValue() << std::endl;
+      iret |= 1; 
+   }
+
+   delete h1; 
+   return iret; 
+}
+
+// maximum relative difference between the values computed point by point with TF1::EvalPar 
+// and the values computed in a batch with EvalParVec 
+double maxBatchDifference(TF1 & func, const double * x, unsigned int n, unsigned int stride) { 
+   ROOT::Math::WrappedTF1 wf(func); 
+   ROOT::Math::WrappedMultiTF1 wmf(func, 1); 
+   std::vector<double> fval(n); 
+   std::vector<double> fvalMulti(n); 
+   const double * p = func.GetParameters(); 
+   wf.EvalParVec(n, x, stride, p, &fval.front() ); 
+   wmf.EvalParVec(n, &x, stride, p, &fvalMulti.front() ); 
+   double maxdiff = 0; 
+   for (unsigned int i = 0; i < n; ++i) { 
+      double fref = func.EvalPar(x + i*stride, p); 
+      double scale = std::max(std::abs(fref), 1.E-300); 
+      maxdiff = std::max(maxdiff, std::abs(fval[i] - fref)/scale ); 
+      maxdiff = std::max(maxdiff, std::abs(fvalMulti[i] - fref)/scale ); 
+   }
+   return maxdiff; 
+}
+
+int testBatchEvaluation() { 
+   // the evaluation on batches of points of the built-in functions and the default 
+   // implementation of EvalParVec must give the same values as the evaluation point by point 
+
+   int iret = 0; 
+
+   // points stored by coordinate (stride 1) and interleaved with a value and an error (stride 3)
+   const unsigned int n = 1000; 
+   std::vector<double> x(3*n); 
+   TRandom3 rndm(111);
+   for (unsigned int i = 0; i < 3*n; ++i) 
+      x[i] = rndm.Uniform(-5,5); 
+
+   TF1 * f1 = new TF1("fgausBatch","gaus",-5,5); 
+   f1->SetParameters(10,0.5,1.3); 
+   TF1 * f2 = new TF1("fgausnBatch","gausn",-5,5); 
+   f2->SetParameters(10,-0.5,0.7); 
+   TF1 * f3 = new TF1("fexpoBatch","expo",-5,5); 
+   f3->SetParameters(1.,-0.3); 
+   TF1 * f4 = new TF1("fpol3Batch","pol3",-5,5); 
+   f4->SetParameters(1.,-2.,0.5,0.1); 
+   TF1 * f5 = new TF1("flandauBatch","landau",-5,5); 
+   f5->SetParameters(5.,0.2,0.8); 
+   // not a built-in function: use the default implementation calling DoEvalPar 
+   TF1 * f6 = new TF1("fformBatch","[0]*sin([1]*x)+[2]",-5,5); 
+   f6->SetParameters(2.,1.5,0.3); 
+   TF1 * funcs[6] = { f1, f2, f3, f4, f5, f6 }; 
+
+   const double tol = 1.E-12; 
+   for (int i = 0; i < 6; ++i) { 
+      double d1 = maxBatchDifference(*funcs[i], &x.front(), n, 1); 
+      double d3 = maxBatchDifference(*funcs[i], &x.front(), n, 3); 
+      if (d1 > tol || d3 > tol) { 
+         std::cerr << "Batch evaluation of " << funcs[i]->GetTitle() << " differs: max relative difference = " 
+                   << std::max(d1,d3) << std::endl;
+         iret |= 1; 
+      }
+   }
+
+   // the default implementation for multi-dimensional functions must work with the 
+   // coordinates stored by point and by column 
+   TF2 * f7 = new TF2("fxyBatch","[0]*x*x+[1]*y+[2]*x*y",-5,5,-5,5); 
+   f7->SetParameters(1.,2.,3.); 
+   ROOT::Math::WrappedMultiTF1 wf7(*f7, 2); 
+   std::vector<double> xcol(2*n); 
+   for (unsigned int i = 0; i < n; ++i) { 
+      xcol[i] = x[2*i]; 
+      xcol[n+i] = x[2*i+1]; 
+   }
+   const double * xbyPoint[2] = { &x.front(), &x.front()+1 }; 
+   const double * xbyColumn[2] = { &xcol.front(), &xcol.front()+n }; 
+   std::vector<double> fvalPoint(n), fvalColumn(n); 
+   wf7.EvalParVec(n, xbyPoint, 2, f7->GetParameters(), &fvalPoint.front() ); 
+   wf7.EvalParVec(n, xbyColumn, 1, f7->GetParameters(), &fvalColumn.front() ); 
+   for (unsigned int i = 0; i < n; ++i) { 
+      double fref = f7->EvalPar(&x[2*i], f7->GetParameters() ); 
+      if (fvalPoint[i] != fref || fvalColumn[i] != fref) { 
+         std::cerr << "Batch evaluation of the 2D function differs at point " << i << " : " << fvalPoint[i] 
+                   << " , " << fvalColumn[i] << " instead of " << fref << std::endl;
+         iret |= 1; 
+         break; 
+      }
+   }
+
+   for (int i = 0; i < 6; ++i) delete funcs[i]; 
+   delete f7; 
+   return iret; 
+}
+
+// 2D gaussian model function for the unbinned likelihood 
+double gaus2DModel(const double * x, const double * p) { 
+   double z1 = (x[0]-p[0])/p[1]; 
+   double z2 = (x[1]-p[2])/p[3]; 
+   return std::exp(-0.5*(z1*z1 + z2*z2))/(2*M_PI*p[1]*p[3]); 
+}
+
+// compare the points of two bin data sets
+int compareBinData(const ROOT::Fit::BinData & d1, const ROOT::Fit::BinData & d2) { 
+   if (d1.Size() != d2.Size() || d1.NDim() != d2.NDim() || d1.GetErrorType() != d2.GetErrorType() ) return 1; 
+   for (unsigned int i = 0; i < d1.Size(); ++i) { 
+      for (unsigned int j = 0; j < d1.NDim(); ++j) 
+         if (d1.Coords(i)[j] != d2.Coords(i)[j]) return 1; 
+      if (d1.Value(i) != d2.Value(i) || d1.Error(i) != d2.Error(i) || d1.InvError(i) != d2.InvError(i) ) return 1; 
+      if (d1.GetErrorType() == ROOT::Fit::BinData::kAsymError) { 
+         double el1 = 0, eh1 = 0, el2 = 0, eh2 = 0; 
+         const double * ex1 = d1.GetPointError(i, el1, eh1); 
+         const double * ex2 = d2.GetPointError(i, el2, eh2); 
+         if (ex1[0] != ex2[0] || el1 != el2 || eh1 != eh2) return 1; 
+      }
+   }
+   return 0; 
+}
+
+int testColumnStorage() { 
+   // the data re-arranged by column must give the same points and the same 
+   // chi2 and likelihood values as the data stored by point
+
+   int iret = 0; 
+
+   TRandom3 rndm(222);
+   TH1D * h1 = new TH1D("h1col","h1col",1000,-5.,5.);
+   for (int i = 0; i < 100000; ++i) 
+      h1->Fill( rndm.Gaus(0,1) );
+   ROOT::Fit::BinData bd; 
+   ROOT::Fit::FillData(bd,h1);
+   ROOT::Fit::BinData bdcol; 
+   ROOT::Fit::FillData(bdcol,h1);
+   if (!bdcol.StoreByColumns() || !bdcol.HasColumns() ) { 
+      std::cerr << "Bin data could not be stored by column" << std::endl;
+      return -1; 
+   }
+   if (compareBinData(bd, bdcol) ) { 
+      std::cerr << "Histogram data stored by column differ from the data stored by point" << std::endl;
+      iret |= 1; 
+   }
+
+   ROOT::Math::WrappedParamFunction<> f(&gausModel,1,3); 
+   double p[3] = {380.,0.1,1.1}; 
+   unsigned int npoints = 0; 
+   double chi2ref = ROOT::Fit::FitUtil::EvaluateChi2(f, bd, p, npoints); 
+   double poisref = ROOT::Fit::FitUtil::EvaluatePoissonLogL(f, bd, p, 0, false, npoints); 
+   double chi2 = ROOT::Fit::FitUtil::EvaluateChi2(f, bdcol, p, npoints); 
+   double pois = ROOT::Fit::FitUtil::EvaluatePoissonLogL(f, bdcol, p, 0, false, npoints); 
+   if (chi2 != chi2ref || pois != poisref) { 
+      std::cerr << "Evaluation on data stored by column differs: chi2 = " << chi2 << " (" << chi2ref 
+                << ") poisson logl = " << pois << " (" << poisref << ")" << std::endl;
+      iret |= 1; 
+   }
+
+   // data with asymmetric errors
+   const int ngr = 200; 
+   TGraphAsymmErrors gr(ngr); 
+   for (int i = 0; i < ngr; ++i) { 
+      gr.SetPoint(i, -5 + 0.05*i, rndm.Gaus(10,1) ); 
+      gr.SetPointError(i, 0.025, 0.025, rndm.Uniform(0.5,1.5), rndm.Uniform(0.5,1.5) ); 
+   }
+   ROOT::Fit::BinData grd; 
+   ROOT::Fit::FillData(grd, &gr); 
+   ROOT::Fit::BinData grdcol; 
+   ROOT::Fit::FillData(grdcol, &gr); 
+   grdcol.StoreByColumns(); 
+   if (compareBinData(grd, grdcol) ) { 
+      std::cerr << "Graph data stored by column differ from the data stored by point" << std::endl;
+      iret |= 1; 
+   }
+
+   // weighted 2D unbinned data
+   int n = 20000;
+   ROOT::Fit::UnBinData ud(n, 2, true); 
+   ROOT::Fit::UnBinData udcol(n, 2, true); 
+   for (int i = 0; i < n; ++i) { 
+      double x[2] = { rndm.Gaus(0,1), rndm.Gaus(1,2) }; 
+      double w = rndm.Uniform(0.5,1.5); 
+      ud.Add(x, w); 
+      udcol.Add(x, w); 
+   }
+   udcol.StoreByColumns(); 
+   for (int i = 0; i < n; ++i) { 
+      if (ud.Coords(i)[0] != udcol.Coords(i)[0] || ud.Coords(i)[1] != udcol.Coords(i)[1] || ud.Weight(i) != udcol.Weight(i) ) { 
+         std::cerr << "Unbinned data stored by column differ from the data stored by point at " << i << std::endl;
+         iret |= 1; 
+         break; 
+      }
+   }
+   ROOT::Math::WrappedParamFunction<> f2(&gaus2DModel,2,4); 
+   double p2[4] = {0.1,1.1,0.9,2.2}; 
+   double loglref = ROOT::Fit::FitUtil::EvaluateLogL(f2, ud, p2, 1, false, npoints); 
+   double logl = ROOT::Fit::FitUtil::EvaluateLogL(f2, udcol, p2, 1, false, npoints); 
+   if (logl != loglref) { 
+      std::cerr << "Likelihood on unbinned data stored by column differs: logl = " << logl << " (" << loglref << ")" << std::endl;
+      iret |= 1; 
+   }
+
+   delete h1; 
+   return iret; 
+}
+
+
 template<typename Test> 
 int testFit(Test t, std::string name) { 
    std::cout << name << "\n\t\t";  
@@ -934,6 +1238,9 @@ int main() {
    iret |= testFit( testHisto2DFit, "Histogram2D Gradient Fit");
    iret |= testFit( testUnBin1DFit, "Unbin 1D Fit");
    iret |= testFit( testGraphFit, "Graph 1D Fit");
+   iret |= testFit( testThreadedEvaluation, "Threaded Evaluation");
+   iret |= testFit( testBatchEvaluation, "Batch Evaluation");
+   iret |= testFit( testColumnStorage, "Column Storage");
 
    std::cout << "\n******************************\n";
    if (iret) std::cerr << "\n\t testFit FAILED !!!!!!!!!!!!!!!! \n";
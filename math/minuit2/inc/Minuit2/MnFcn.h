@@ -42,6 +42,13 @@ public:
   virtual double operator()(const MnAlgebraicVector&) const;
   unsigned int NumOfCalls() const {return fNumCall;}
 
+  // evaluate the function without incrementing the call counter
+  // (used when the function is called concurrently from several threads)
+  virtual double Evaluate(const MnAlgebraicVector&) const;
+
+  // add to the call counter the calls done via Evaluate
+  void AddNumOfCalls(int ncall) const {fNumCall += ncall;}
+
   //
   //forward interface
   //
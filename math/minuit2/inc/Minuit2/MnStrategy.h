@@ -48,6 +48,8 @@ public:
    unsigned int HessianGradientNCycles() const {return fHessGradNCyc;}
 
    int StorageLevel() const { return fStoreLevel; }
+
+   unsigned int GradientNThreads() const { return fGradNThreads; }
  
    bool IsLow() const {return fStrategy == 0;}
    bool IsMedium() const {return fStrategy == 1;}
@@ -69,6 +71,10 @@ public:
    // set storage level of iteration quantities 
    // 0 = store only last iterations 1 = full storage (default)
    void SetStorageLevel(unsigned int level) { fStoreLevel = level; }
+
+   // set number of threads used to compute the numerical gradient 
+   // (1 = serial calculation (default), n > 1 requires a thread-safe FCN)
+   void SetGradientNThreads(unsigned int n) { fGradNThreads = (n > 0) ? n : 1; }
 private:
 
    unsigned int fStrategy;
@@ -81,6 +87,7 @@ private:
    double fHessTlrG2;
    unsigned int fHessGradNCyc;
    int fStoreLevel; 
+   unsigned int fGradNThreads;
 };
 
   }  // namespace Minuit2
@@ -18,6 +18,10 @@
 #include "Minuit2/GradientCalculator.h"
 #endif
 
+#ifndef ROOT_Minuit2_MnMatrix
+#include "Minuit2/MnMatrix.h"
+#endif
+
 #include <vector>
 
 namespace ROOT {
@@ -67,8 +71,17 @@ public:
   double StepTolerance() const;
   double GradTolerance() const;
 
+  // compute the derivative for the parameter i (only element i of grd, g2 and gstep are modified)
+  int ParameterDerivative(unsigned int i, MnAlgebraicVector& x, double fcnmin,
+                          MnAlgebraicVector& grd, MnAlgebraicVector& g2, MnAlgebraicVector& gstep, 
+                          bool countCalls = true) const;
+
 private:
 
+  // compute all the derivatives using the given number of threads 
+  void ParallelDerivatives(unsigned int nthreads, const MnAlgebraicVector& par, double fcnmin,
+                           MnAlgebraicVector& grd, MnAlgebraicVector& g2, MnAlgebraicVector& gstep) const;
+
   const MnFcn& fFcn;
   const MnUserTransformation& fTransformation; 
   const MnStrategy& fStrategy;
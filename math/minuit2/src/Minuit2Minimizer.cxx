@@ -427,6 +427,7 @@ bool Minuit2Minimizer::Minimize() {
       int nGradCycles = strategy.GradientNCycles();
       int nHessCycles = strategy.HessianNCycles();
       int nHessGradCycles = strategy.HessianGradientNCycles();
+      int nGradThreads = strategy.GradientNThreads();
 
       double gradTol =  strategy.GradientTolerance();
       double gradStepTol = strategy.GradientStepTolerance();
@@ -436,6 +437,7 @@ bool Minuit2Minimizer::Minimize() {
       minuit2Opt->GetValue("GradientNCycles",nGradCycles);
       minuit2Opt->GetValue("HessianNCycles",nHessCycles);
       minuit2Opt->GetValue("HessianGradientNCycles",nHessGradCycles);
+      minuit2Opt->GetValue("GradientNThreads",nGradThreads);
 
       minuit2Opt->GetValue("GradientTolerance",gradTol);
       minuit2Opt->GetValue("GradientStepTolerance",gradStepTol);
@@ -445,6 +447,7 @@ bool Minuit2Minimizer::Minimize() {
       strategy.SetGradientNCycles(nGradCycles);      
       strategy.SetHessianNCycles(nHessCycles);
       strategy.SetHessianGradientNCycles(nHessGradCycles);
+      strategy.SetGradientNThreads(nGradThreads);
 
       strategy.SetGradientTolerance(gradTol);
       strategy.SetGradientStepTolerance(gradStepTol);
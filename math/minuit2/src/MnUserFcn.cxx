@@ -16,9 +16,9 @@ namespace ROOT {
    namespace Minuit2 {
 
 
-double MnUserFcn::operator()(const MnAlgebraicVector& v) const {
+double MnUserFcn::Evaluate(const MnAlgebraicVector& v) const {
    // call Fcn function transforming from a MnAlgebraicVector of internal values to a std::vector of external ones 
-   fNumCall++;
+   // (the call counter is incremented in MnFcn::operator())
 
    // calling fTransform() like here was not thread safe because it was using a cached vector
    //return Fcn()( fTransform(v) );
@@ -30,9 +30,20 @@
 #endif
 
 #include <math.h>
+#include <algorithm>
 
 #include "Minuit2/MPIProcess.h"
 
+// use the built-in threads for the gradient when OpenMP or MPI are not used
+#if !defined(_OPENMP) && !defined(MPIPROC) && !defined(MN_USE_STACK_ALLOC) && !defined(_WIN32)
+#define MINUIT2_PARALLEL_THREADS
+#endif
+
+#ifdef MINUIT2_PARALLEL_THREADS
+#include <pthread.h>
+#include <vector>
+#endif
+
 namespace ROOT {
 
    namespace Minuit2 {
@@ -83,27 +94,12 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
    double fcnmin = par.Fval();
    //   std::cout<<"fval: "<<fcnmin<<std::endl;
    
-   double eps2 = Precision().Eps2(); 
-   double eps = Precision().Eps();
-   
-   double dfmin = 8.*eps2*(fabs(fcnmin)+Fcn().Up());
-   double vrysml = 8.*eps*eps;
-   //   double vrysml = std::max(1.e-4, eps2);
-   //    std::cout<<"dfmin= "<<dfmin<<std::endl;
-   //    std::cout<<"vrysml= "<<vrysml<<std::endl;
-   //    std::cout << " ncycle " << Ncycle() << std::endl;
-   
    unsigned int n = (par.Vec()).size();
-   unsigned int ncycle = Ncycle();
    //   MnAlgebraicVector vgrd(n), vgrd2(n), vgstp(n);
    MnAlgebraicVector grd = Gradient.Grad();
    MnAlgebraicVector g2 = Gradient.G2();
    MnAlgebraicVector gstep = Gradient.Gstep();
 
-#ifndef _OPENMP
-   MPIProcess mpiproc(n,0);
-#endif
-
 #ifdef DEBUG
    std::cout << "Calculating Gradient at x =   " << par.Vec() << std::endl;
    int pr = std::cout.precision(13);
@@ -111,7 +107,18 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
    std::cout.precision(pr);
 #endif
 
+#ifdef MINUIT2_PARALLEL_THREADS
+   // use the built-in threads when requested by the strategy 
+   unsigned int nthreads = std::min(Strategy().GradientNThreads(), n);
+   if (nthreads > 1) { 
+      ParallelDerivatives(nthreads, par.Vec(), fcnmin, grd, g2, gstep);
+      return FunctionGradient(grd, g2, gstep);
+   }
+#endif
+
 #ifndef _OPENMP
+   MPIProcess mpiproc(n,0);
+
    // for serial execution this can be outside the loop
    MnAlgebraicVector x = par.Vec();
 
@@ -142,62 +149,7 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
       MnAlgebraicVector x = par.Vec();
 #endif
 
-      double xtf = x(i);
-      double epspri = eps2 + fabs(grd(i)*eps2);
-      double stepb4 = 0.;
-      for(unsigned int j = 0; j < ncycle; j++)  {
-         double optstp = sqrt(dfmin/(fabs(g2(i))+epspri));
-         double step = std::max(optstp, fabs(0.1*gstep(i)));
-         //       std::cout<<"step: "<<step;
-         if(Trafo().Parameter(Trafo().ExtOfInt(i)).HasLimits()) {
-            if(step > 0.5) step = 0.5;
-         }
-         double stpmax = 10.*fabs(gstep(i));
-         if(step > stpmax) step = stpmax;
-         //       std::cout<<" "<<step;
-         double stpmin = std::max(vrysml, 8.*fabs(eps2*x(i)));
-         if(step < stpmin) step = stpmin;
-         //       std::cout<<" "<<step<<std::endl;
-         //       std::cout<<"step: "<<step<<std::endl;
-         if(fabs((step-stepb4)/step) < StepTolerance()) {
-            //  	std::cout<<"(step-stepb4)/step"<<std::endl;
-            //  	std::cout<<"j= "<<j<<std::endl;
-            //  	std::cout<<"step= "<<step<<std::endl;
-            break;
-         }
-         gstep(i) = step;
-         stepb4 = step;
-         //       MnAlgebraicVector pstep(n);
-         //       pstep(i) = step;
-         //       double fs1 = Fcn()(pstate + pstep);
-         //       double fs2 = Fcn()(pstate - pstep);
-         
-         x(i) = xtf + step;
-         double fs1 = Fcn()(x);
-         x(i) = xtf - step;
-         double fs2 = Fcn()(x);
-         x(i) = xtf;
-         
-         double grdb4 = grd(i);
-         grd(i) = 0.5*(fs1 - fs2)/step;
-         g2(i) = (fs1 + fs2 - 2.*fcnmin)/step/step;
-
-#ifdef DEBUG
-         pr = std::cout.precision(13);
-         std::cout << "cycle " << j << " x " << x(i) << " step " << step << " f1 " << fs1 << " f2 " << fs2 
-                   << " grd " << grd(i) << " g2 " << g2(i) << std::endl; 
-         std::cout.precision(pr);
-#endif
-         
-         if(fabs(grdb4-grd(i))/(fabs(grd(i))+dfmin/step) < GradTolerance())  {
-            //  	std::cout<<"j= "<<j<<std::endl;
-            //  	std::cout<<"step= "<<step<<std::endl;
-            //  	std::cout<<"fs1, fs2: "<<fs1<<" "<<fs2<<std::endl;
-            //  	std::cout<<"fs1-fs2: "<<fs1-fs2<<std::endl;
-            break;
-         }
-      }
-      
+      ParameterDerivative(i, x, fcnmin, grd, g2, gstep);
 
 #ifdef DEBUG_MP
 #pragma omp critical
@@ -210,13 +162,6 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
       //     vgrd2(i) = g2;
       //     vgstp(i) = gstep;
 
-
-#ifdef DEBUG
-      pr = std::cout.precision(13);
-      int iext = Trafo().ExtOfInt(i);
-      std::cout << "Parameter " << Trafo().Name(iext) << " Gradient =   " << grd(i) << " g2 = " << g2(i) << " step " << gstep(i) << std::endl;
-      std::cout.precision(pr);
-#endif
    }
 
 #ifndef _OPENMP
@@ -228,6 +173,174 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
    return FunctionGradient(grd, g2, gstep);
 }
 
+int Numerical2PGradientCalculator::ParameterDerivative(unsigned int i, MnAlgebraicVector& x, double fcnmin, 
+                                                       MnAlgebraicVector& grd, MnAlgebraicVector& g2, MnAlgebraicVector& gstep, 
+                                                       bool countCalls) const {
+   // compute the derivative with respect to the parameter i, updating only the 
+   // elements i of grd, g2 and gstep. The vector x is restored on return. 
+   // If countCalls is false the function is evaluated without incrementing the 
+   // MnFcn call counter (needed when called concurrently) and the number of 
+   // performed calls is returned
+
+   double eps2 = Precision().Eps2(); 
+   double eps = Precision().Eps();
+   
+   double dfmin = 8.*eps2*(fabs(fcnmin)+Fcn().Up());
+   double vrysml = 8.*eps*eps;
+   //   double vrysml = std::max(1.e-4, eps2);
+   //    std::cout<<"dfmin= "<<dfmin<<std::endl;
+   //    std::cout<<"vrysml= "<<vrysml<<std::endl;
+   //    std::cout << " ncycle " << Ncycle() << std::endl;
+
+   unsigned int ncycle = Ncycle();
+   int ncall = 0; 
+
+   double xtf = x(i);
+   double epspri = eps2 + fabs(grd(i)*eps2);
+   double stepb4 = 0.;
+   for(unsigned int j = 0; j < ncycle; j++)  {
+      double optstp = sqrt(dfmin/(fabs(g2(i))+epspri));
+      double step = std::max(optstp, fabs(0.1*gstep(i)));
+      //       std::cout<<"step: "<<step;
+      if(Trafo().Parameter(Trafo().ExtOfInt(i)).HasLimits()) {
+         if(step > 0.5) step = 0.5;
+      }
+      double stpmax = 10.*fabs(gstep(i));
+      if(step > stpmax) step = stpmax;
+      //       std::cout<<" "<<step;
+      double stpmin = std::max(vrysml, 8.*fabs(eps2*x(i)));
+      if(step < stpmin) step = stpmin;
+      //       std::cout<<" "<<step<<std::endl;
+      //       std::cout<<"step: "<<step<<std::endl;
+      if(fabs((step-stepb4)/step) < StepTolerance()) {
+         //  	std::cout<<"(step-stepb4)/step"<<std::endl;
+         //  	std::cout<<"j= "<<j<<std::endl;
+         //  	std::cout<<"step= "<<step<<std::endl;
+         break;
+      }
+      gstep(i) = step;
+      stepb4 = step;
+      //       MnAlgebraicVector pstep(n);
+      //       pstep(i) = step;
+      //       double fs1 = Fcn()(pstate + pstep);
+      //       double fs2 = Fcn()(pstate - pstep);
+      
+      x(i) = xtf + step;
+      double fs1 = (countCalls) ? Fcn()(x) : Fcn().Evaluate(x);
+      x(i) = xtf - step;
+      double fs2 = (countCalls) ? Fcn()(x) : Fcn().Evaluate(x);
+      x(i) = xtf;
+      ncall += 2;
+      
+      double grdb4 = grd(i);
+      grd(i) = 0.5*(fs1 - fs2)/step;
+      g2(i) = (fs1 + fs2 - 2.*fcnmin)/step/step;
+
+#ifdef DEBUG
+      int pr = std::cout.precision(13);
+      std::cout << "cycle " << j << " x " << x(i) << " step " << step << " f1 " << fs1 << " f2 " << fs2 
+                << " grd " << grd(i) << " g2 " << g2(i) << std::endl; 
+      std::cout.precision(pr);
+#endif
+      
+      if(fabs(grdb4-grd(i))/(fabs(grd(i))+dfmin/step) < GradTolerance())  {
+         //  	std::cout<<"j= "<<j<<std::endl;
+         //  	std::cout<<"step= "<<step<<std::endl;
+         //  	std::cout<<"fs1, fs2: "<<fs1<<" "<<fs2<<std::endl;
+         //  	std::cout<<"fs1-fs2: "<<fs1-fs2<<std::endl;
+         break;
+      }
+   }
+
+#ifdef DEBUG
+   int prec = std::cout.precision(13);
+   int iext = Trafo().ExtOfInt(i);
+   std::cout << "Parameter " << Trafo().Name(iext) << " Gradient =   " << grd(i) << " g2 = " << g2(i) << " step " << gstep(i) << std::endl;
+   std::cout.precision(prec);
+#endif
+
+   return ncall;
+}
+
+#ifdef MINUIT2_PARALLEL_THREADS
+
+namespace { 
+
+   // data passed to each thread computing a block of the gradient components
+   struct GradientThreadData { 
+      const Numerical2PGradientCalculator * fCalculator; 
+      MnAlgebraicVector * fX;        // own copy of the parameter vector 
+      MnAlgebraicVector * fGrd;      // shared output vectors (only elements in [fFirst,fLast) are written)
+      MnAlgebraicVector * fG2; 
+      MnAlgebraicVector * fGstep; 
+      double fFcnMin; 
+      unsigned int fFirst; 
+      unsigned int fLast; 
+      int fNCalls; 
+   };
+
+   void * GradientThreadFunction(void * arg) { 
+      // compute the derivatives for the assigned parameter range 
+      GradientThreadData * td = (GradientThreadData *) arg; 
+      for (unsigned int i = td->fFirst; i < td->fLast; ++i) 
+         td->fNCalls += td->fCalculator->ParameterDerivative(i, *td->fX, td->fFcnMin, *td->fGrd, *td->fG2, *td->fGstep, false); 
+      return 0; 
+   }
+
+}
+
+void Numerical2PGradientCalculator::ParallelDerivatives(unsigned int nthreads, const MnAlgebraicVector& par, double fcnmin, 
+                                                        MnAlgebraicVector& grd, MnAlgebraicVector& g2, MnAlgebraicVector& gstep) const {
+   // compute the gradient components using nthreads threads. 
+   // The parameters are split in contiguous blocks, one per thread, and each thread writes 
+   // only its own elements of the result vectors. The result is therefore independent of 
+   // the number of threads and of their scheduling. 
+   // The FCN must be thread safe. 
+
+   unsigned int n = par.size(); 
+   std::vector<pthread_t> threads(nthreads); 
+   std::vector<GradientThreadData> tdata(nthreads); 
+   std::vector<MnAlgebraicVector> xcopy(nthreads, par);
+   std::vector<bool> started(nthreads, false);
+   
+   unsigned int first = 0; 
+   for (unsigned int ith = 0; ith < nthreads; ++ith) { 
+      unsigned int nelem = n/nthreads + ( (ith < n%nthreads) ? 1 : 0 ); 
+      GradientThreadData & td = tdata[ith];
+      td.fCalculator = this; 
+      td.fX = &xcopy[ith];
+      td.fGrd = &grd; 
+      td.fG2 = &g2; 
+      td.fGstep = &gstep; 
+      td.fFcnMin = fcnmin; 
+      td.fFirst = first; 
+      td.fLast = first + nelem; 
+      td.fNCalls = 0; 
+      first += nelem; 
+      // the first block is computed by the calling thread 
+      if (ith == 0) continue; 
+      started[ith] = (pthread_create(&threads[ith], 0, GradientThreadFunction, &td) == 0);
+   }
+
+   GradientThreadFunction(&tdata[0]); 
+
+   int ncalls = 0; 
+   for (unsigned int ith = 0; ith < nthreads; ++ith) { 
+      if (ith > 0) { 
+         if (started[ith]) 
+            pthread_join(threads[ith], 0); 
+         else 
+            // thread could not be created: compute its block here
+            GradientThreadFunction(&tdata[ith]); 
+      }
+      ncalls += tdata[ith].fNCalls; 
+   }
+   
+   Fcn().AddNumOfCalls(ncalls); 
+}
+
+#endif
+
 const MnMachinePrecision& Numerical2PGradientCalculator::Precision() const {
    // return global precision (set in transformation)
    return fTransformation.Precision();
@@ -0,0 +1,94 @@
+// @(#)root/minuit2:$Id$
+/**
+   test that the numerical gradient computed with several threads
+   (MnStrategy::SetGradientNThreads) gives exactly the same minimization
+   as the serial calculation
+
+*/
+#include "Minuit2/FCNBase.h"
+#include "Minuit2/FunctionMinimum.h"
+#include "Minuit2/MnUserParameterState.h"
+#include "Minuit2/MnStrategy.h"
+#include "Minuit2/MnMigrad.h"
+
+#include <vector>
+#include <cmath>
+#include <iostream>
+#include <cstdio>
+
+using namespace ROOT::Minuit2;
+
+// chain of coupled Rosenbrock-like terms in many parameters
+class CoupledFCN : public FCNBase {
+
+public:
+
+   double operator() (const std::vector<double> & x) const {
+      double f = 0;
+      for (unsigned int i = 0; i + 1 < x.size(); ++i) {
+         double a = x[i+1] - x[i]*x[i];
+         double b = 1 - x[i];
+         f += 10*a*a + b*b + 0.1*std::sin(x[i]*x[i+1]);
+      }
+      return f;
+   }
+
+   double Up() const { return 1.; }
+
+};
+
+FunctionMinimum doMinimize(unsigned int nthreads, unsigned int npar) {
+
+   MnUserParameters upar;
+   for (unsigned int i = 0; i < npar; ++i) {
+      char name[16];
+      snprintf(name, 16, "x%d", i);
+      upar.Add(name, -1.2 + 0.1*i, 0.1);
+   }
+   MnStrategy strategy(1);
+   strategy.SetGradientNThreads(nthreads);
+
+   CoupledFCN fcn;
+   MnMigrad migrad(fcn, MnUserParameterState(upar), strategy);
+   return migrad();
+}
+
+int testParallelGradient() {
+
+   const unsigned int npar = 20;
+   FunctionMinimum ref = doMinimize(1, npar);
+   if (!ref.IsValid()) {
+      std::cerr << "serial minimization failed" << std::endl;
+      return 1;
+   }
+   std::cout << "serial:    fval = " << ref.Fval() << " nfcn = " << ref.NFcn() << std::endl;
+
+   int iret = 0;
+   const unsigned int nthreads[] = { 2, 3, 4, 7, 32 };
+   for (unsigned int k = 0; k < sizeof(nthreads)/sizeof(nthreads[0]); ++k) {
+      FunctionMinimum min = doMinimize(nthreads[k], npar);
+      std::cout << nthreads[k] << " threads: fval = " << min.Fval() << " nfcn = " << min.NFcn() << std::endl;
+      // the threads work on separate parameters, the result must not change
+      bool ok = min.IsValid() == ref.IsValid() && min.Fval() == ref.Fval() && min.NFcn() == ref.NFcn();
+      for (unsigned int i = 0; ok && i < npar; ++i) {
+         ok = min.UserState().Value(i) == ref.UserState().Value(i) &&
+              min.UserState().Error(i) == ref.UserState().Error(i);
+      }
+      if (!ok) {
+         std::cerr << "ERROR: result with " << nthreads[k] << " threads differs from the serial one" << std::endl;
+         iret = 2;
+      }
+   }
+   return iret;
+}
+
+#ifndef __CINT__
+int main() {
+   int iret = testParallelGradient();
+   if (iret != 0) {
+      std::cerr << "ERROR: ParallelGradient test failed !" << std::endl;
+      return iret;
+   }
+   return 0;
+}
+#endif
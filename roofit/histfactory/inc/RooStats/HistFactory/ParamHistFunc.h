@@ -110,6 +110,7 @@ protected:
   Int_t addParamSet( const RooArgList& params );
   static Int_t GetNumBins( const RooArgSet& vars );
   Double_t evaluate() const;
+  virtual Bool_t evaluateBatch(Double_t* output, RooBatchData& batch) const ;
 
   ClassDef(ParamHistFunc,4) // Sum of RooAbsReal objects
 };
@@ -89,6 +89,7 @@ protected:
   std::vector<int> _interpCode;
 
   Double_t evaluate() const;
+  virtual Bool_t evaluateBatch(Double_t* output, RooBatchData& batch) const ;
 
   ClassDef(PiecewiseInterpolation,3) // Sum of RooAbsReal objects
 };
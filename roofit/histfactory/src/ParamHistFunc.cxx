@@ -33,6 +33,7 @@
 #include "RooNLLVar.h"
 #include "RooChi2Var.h"
 #include "RooMsgService.h"
+#include "RooBatchData.h"
 
 // Forward declared:
 #include "RooRealVar.h"
@@ -708,6 +709,33 @@ Double_t ParamHistFunc::evaluate() const
 }
 
 
+//_____________________________________________________________________________
+Bool_t ParamHistFunc::evaluateBatch(Double_t* output, RooBatchData& batch) const 
+{
+
+  // Vectorized evaluate() for all events in batch. The bin
+  // of each event is looked up after loading the event, the
+  // normalization integral only depends on the parameters 
+  // and is calculated once for the whole batch
+
+  Int_t n = batch.size() ;
+  for (Int_t j=0 ; j<n ; j++) {
+    batch.loadEvent(j) ;
+    output[j] = getParameter().getVal() ;
+  }
+
+  if( !_Normalized ) return kTRUE;
+
+  Double_t scale = 1.0 / analyticalIntegralWN(0, NULL, NULL);
+  for (Int_t j=0 ; j<n ; j++) {
+    output[j] *= scale ;
+  }
+
+  return kTRUE;
+
+}
+
+
 //_____________________________________________________________________________
 Int_t ParamHistFunc::getAnalyticalIntegralWN(RooArgSet& allVars, RooArgSet& analVars, 
 						      const RooArgSet* normSet, const char* /*rangeName*/) const 
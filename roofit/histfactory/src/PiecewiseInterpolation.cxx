@@ -26,6 +26,7 @@
 #include "RooRealVar.h"
 #include "RooMsgService.h"
 #include "RooNumIntConfig.h"
+#include "RooBatchData.h"
 
 using namespace std;
 
@@ -300,6 +301,136 @@ Double_t PiecewiseInterpolation::evaluate() const
 }
 
 
+
+//_____________________________________________________________________________
+Bool_t PiecewiseInterpolation::evaluateBatch(Double_t* output, RooBatchData& batch) const 
+{
+  // Vectorized evaluate() for all events in batch. The nominal and
+  // varied histograms are evaluated in batch mode (typically these are
+  // columns precalculated by the constant term optimizer) and the
+  // interpolation of each parameter is applied to all events in turn.
+  // If the interpolation parameters depend on the observables of the
+  // data, events are evaluated one by one
+
+  if (batch.dependsOnData(_paramSet)) {
+    return kFALSE ;
+  }
+
+  Int_t n = batch.size() ;
+  Int_t j ;
+  const Double_t* nominal = _nominal.arg().getValBatch(batch,_nominal.nset()) ;
+  for (j=0 ; j<n ; j++) {
+    output[j] = nominal[j] ;
+  }
+
+  RooAbsReal* param ;
+  RooAbsReal* high ;
+  RooAbsReal* low ;
+  int i=0;
+
+  RooFIter lowIter(_lowSet.fwdIterator()) ;
+  RooFIter highIter(_highSet.fwdIterator()) ;
+  RooFIter paramIter(_paramSet.fwdIterator()) ;
+
+  while((param=(RooAbsReal*)paramIter.next())) {
+    low = (RooAbsReal*)lowIter.next() ;
+    high = (RooAbsReal*)highIter.next() ;
+
+    Int_t code = _interpCode.empty() ? 0 : _interpCode.at(i) ;
+    if (code<0 || code>5) {
+      coutE(InputArguments) << "PiecewiseInterpolation::evaluateBatch ERROR:  " << param->GetName() 
+			    << " with unknown interpolation code" << endl ;
+      ++i;
+      continue ;
+    }
+
+    double x = param->getVal() ;
+    const Double_t* lowVal = low->getValBatch(batch) ;
+    const Double_t* highVal = high->getValBatch(batch) ;
+
+    if(code==0){
+      // piece-wise linear
+      for (j=0 ; j<n ; j++) {
+	if(x>0)
+	  output[j] += x*(highVal[j] - nominal[j] );
+	else
+	  output[j] += x*(nominal[j] - lowVal[j]);
+      }
+    } else if(code==1){
+      // pice-wise log
+      for (j=0 ; j<n ; j++) {
+	if(x>=0)
+	  output[j] *= pow(highVal[j]/nominal[j], +x);
+	else
+	  output[j] *= pow(lowVal[j]/nominal[j],  -x);
+      }
+    } else if(code==2 || code==3){
+      // parabolic with linear, parabolic version of log-normal
+      for (j=0 ; j<n ; j++) {
+	double a = 0.5*(highVal[j]+lowVal[j])-nominal[j];
+	double b = 0.5*(highVal[j]-lowVal[j]);
+	double c = 0;
+	if(x>1 ){
+	  output[j] += (2*a+b)*(x-1)+highVal[j]-nominal[j];
+	} else if(x<-1 ) {
+	  output[j] += -1*(2*a-b)*(x+1)+lowVal[j]-nominal[j];
+	} else {
+	  output[j] +=  a*pow(x,2) + b*x+c;
+	}
+      }
+    } else if (code==4 || code==5){
+      // AA - 6th (4th) order poly interp + linear extrap
+      double x0 = 1.0;//boundary;
+      for (j=0 ; j<n ; j++) {
+	if (x > x0 || x < -x0) {
+	  if(x>0)
+	    output[j] += x*(highVal[j] - nominal[j] );
+	  else
+	    output[j] += x*(nominal[j] - lowVal[j]);
+	  continue ;
+	}
+	if (code==5 && nominal[j]==0) continue ;
+
+	double eps_plus = highVal[j] - nominal[j];
+	double eps_minus = nominal[j] - lowVal[j];
+	double S = (eps_plus + eps_minus)/2;
+	double A = (eps_plus - eps_minus)/2;
+
+	double val ;
+	if (code==4) {
+	  //fcns+der+2nd_der are eq at bd
+	  double a = S;
+	  double b = 15*A/(8*x0);
+	  double d = -10*A/(8*x0*x0*x0);
+	  double f = 3*A/(8*x0*x0*x0*x0*x0);
+	  val = nominal[j] + a*x + b*pow(x, 2) + d*pow(x, 4) + f*pow(x, 6);
+	} else {
+	  //fcns+der are eq at bd
+	  double a = S;
+	  double b = 3*A/(2*x0);
+	  double d = -A/(2*x0*x0*x0);
+	  val = nominal[j] + a*x + b*pow(x, 2) + d*pow(x, 4);
+	}
+	if (val < 0) val = 0;
+	output[j] += val-nominal[j];
+      }
+    }
+
+    ++i;
+  }
+
+  for (j=0 ; j<n ; j++) {
+    if(_positiveDefinite && (output[j]<0)){
+      output[j] = 0;
+    } else if(output[j]<0){
+      cout <<"sum < 0, not forcing positive definite"<<endl;
+    }
+  }
+
+  return kTRUE;
+}
+
+
 //_____________________________________________________________________________
 Bool_t PiecewiseInterpolation::setBinIntegrator(RooArgSet& allVars) 
 {
@@ -43,6 +43,7 @@ protected:
   RooRealProxy sigma ;
   
   Double_t evaluate() const ;
+  Bool_t evaluateBatch(Double_t* output, RooBatchData& batch) const ;
 
 private:
 
@@ -29,6 +29,7 @@
 
 #include "RooExponential.h"
 #include "RooRealVar.h"
+#include "RooBatchData.h"
 
 using namespace std;
 
@@ -59,6 +60,22 @@ Double_t RooExponential::evaluate() const{
 }
 
 
+//_____________________________________________________________________________
+Bool_t RooExponential::evaluateBatch(Double_t* output, RooBatchData& batch) const
+{
+  // Vectorized evaluate() for all events in batch
+
+  const Double_t* xv = x.arg().getValBatch(batch,x.nset()) ;
+  const Double_t* cv = c.arg().getValBatch(batch,c.nset()) ;
+
+  Int_t n = batch.size() ;
+  for (Int_t i=0 ; i<n ; i++) {
+    output[i] = exp(cv[i]*xv[i]) ;
+  }
+  return kTRUE ;
+}
+
+
 //_____________________________________________________________________________
 Int_t RooExponential::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const 
 {
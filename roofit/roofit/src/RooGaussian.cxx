@@ -32,6 +32,7 @@
 #include "RooRealVar.h"
 #include "RooRandom.h"
 #include "RooMath.h"
+#include "RooBatchData.h"
 
 using namespace std;
 
@@ -72,6 +73,25 @@ Double_t RooGaussian::evaluate() const
 
 
 
+//_____________________________________________________________________________
+Bool_t RooGaussian::evaluateBatch(Double_t* output, RooBatchData& batch) const
+{
+  // Vectorized evaluate() for all events in batch
+
+  const Double_t* xv = x.arg().getValBatch(batch,x.nset()) ;
+  const Double_t* mv = mean.arg().getValBatch(batch,mean.nset()) ;
+  const Double_t* sv = sigma.arg().getValBatch(batch,sigma.nset()) ;
+
+  Int_t n = batch.size() ;
+  for (Int_t i=0 ; i<n ; i++) {
+    Double_t arg = xv[i] - mv[i] ;
+    output[i] = exp(-0.5*arg*arg/(sv[i]*sv[i])) ;
+  }
+  return kTRUE ;
+}
+
+
+
 //_____________________________________________________________________________
 Int_t RooGaussian::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const 
 {
@@ -37,6 +37,7 @@
 #include "RooAbsReal.h"
 #include "RooRealVar.h"
 #include "RooArgList.h"
+#include "RooBatchData.h"
 
 using namespace std;
 
@@ -144,6 +145,39 @@ Double_t RooPolynomial::evaluate() const
 
 
 
+//_____________________________________________________________________________
+Bool_t RooPolynomial::evaluateBatch(Double_t* output, RooBatchData& batch) const 
+{
+  // Vectorized evaluate() for all events in batch. The terms are summed
+  // in the same order as in evaluate()
+
+  Int_t order(_lowestOrder) ;
+  Double_t sum0(order<1 ? 0 : 1) ;
+
+  const Double_t* xv = _x.arg().getValBatch(batch,_x.nset()) ;
+
+  Int_t n = batch.size() ;
+  Int_t i ;
+  for (i=0 ; i<n ; i++) {
+    output[i] = sum0 ;
+  }
+
+  RooFIter iter = _coefList.fwdIterator() ;
+  RooAbsReal* coef ;
+  const RooArgSet* nset = _coefList.nset() ;
+  while((coef=(RooAbsReal*)iter.next())) {
+    const Double_t* cv = coef->getValBatch(batch,nset) ;
+    for (i=0 ; i<n ; i++) {
+      output[i] += cv[i]*TMath::Power(xv[i],order) ;
+    }
+    order++ ;
+  }
+
+  return kTRUE;
+}
+
+
+
 //_____________________________________________________________________________
 Int_t RooPolynomial::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const 
 {
@@ -37,7 +37,7 @@ ROOFITCOREH1   := Roo1DTable.h RooAbsArg.h RooAbsBinning.h RooAbsCategory.h \
                   RooAcceptReject.h RooAdaptiveGaussKronrodIntegrator1D.h \
                   RooAddGenContext.h RooAddition.h RooAddModel.h \
                   RooAICRegistry.h RooArgList.h RooArgProxy.h RooArgSet.h \
-                  RooBanner.h RooBinning.h RooBinnedGenContext.h RooBrentRootFinder.h  RooCategory.h \
+                  RooBanner.h RooBatchData.h RooBinning.h RooBinnedGenContext.h RooBrentRootFinder.h  RooCategory.h \
                   RooCategoryProxy.h RooCategorySharedProperties.h \
                   RooCatType.h RooChi2Var.h RooClassFactory.h RooCmdArg.h \
                   RooCmdConfig.h RooComplex.h RooConstVar.h RooConvCoefVar.h \
@@ -58,6 +58,8 @@ public:
     // Return size of internal hash table
     return _list.getHashTableSize() ; 
   }
+  static void setDefaultHashThreshold(Int_t size) ;
+  static Int_t defaultHashThreshold() ;
 
   // List content management
   virtual Bool_t add(const RooAbsArg& var, Bool_t silent=kFALSE) ;
@@ -167,6 +169,8 @@ protected:
   TString _name;    // Our name.
   Bool_t _allRRV ; // All contents are RRV
 
+  static Int_t _defaultHashThresh ; //! Size above which new collections use a hash table for name lookups
+
   void safeDeleteList() ;
 
   // Support for snapshot method 
@@ -61,6 +61,12 @@ public:
     return "(unnamed)" ; 
   }  
 
+  virtual RooAbsFunc* cloneTree() const { 
+    // Interface to create a copy of this binding that can be evaluated concurrently
+    // with this binding, e.g. in a different thread (if supported by binding implementation)
+    return 0 ; 
+  }
+
   virtual std::list<Double_t>* binBoundaries(Int_t) const { return 0 ; }
 
   virtual std::list<Double_t>* plotSamplingHint(RooAbsRealLValue& /*obs*/, Double_t /*xlo*/, Double_t /*xhi*/) const {
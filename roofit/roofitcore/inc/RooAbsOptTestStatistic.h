@@ -25,6 +25,9 @@
 class RooArgSet ;
 class RooAbsData ;
 class RooAbsReal ;
+class RooAbsPdf ;
+class RooProdPdf ;
+class RooLinkedList ;
 
 class RooAbsOptTestStatistic : public RooAbsTestStatistic {
 public:
@@ -56,6 +59,9 @@ public:
   Bool_t isSealed() const { return _sealed ; }
   const char* sealNotice() const { return _sealNotice.Data() ; }
 
+  virtual void printCacheStatistics(std::ostream& os, const char* indent="") const ;
+  virtual void resetCacheStatistics() ;
+
 protected:
 
   Bool_t setDataSlave(RooAbsData& data, Bool_t cloneData=kTRUE, Bool_t ownNewDataAnyway=kFALSE) ;
@@ -72,6 +78,9 @@ protected:
   virtual RooArgSet requiredExtraObservables() const { return RooArgSet() ; }
   void optimizeCaching() ;
   void optimizeConstantTerms(Bool_t,Bool_t=kTRUE) ;
+  void findProdTrackNodes(RooAbsArg& node, Int_t nFloatTotal, RooArgSet& trackNodes, RooLinkedList& processedNodes) ;
+  void setTrackNormSet(const RooProdPdf& prod, RooAbsPdf& comp) ;
+  Int_t numFloatingParams(const RooAbsArg& arg) const ;
 
   RooArgSet*  _normSet ; // Pointer to set with observables used for normalization
   RooArgSet*  _funcCloneSet ; // Set owning all components of internal clone of input function
@@ -185,6 +185,7 @@ public:
   virtual Bool_t traceEvalHook(Double_t value) const ;  
   virtual Double_t getValV(const RooArgSet* set=0) const ;
   virtual Double_t getLogVal(const RooArgSet* set=0) const ;
+  void getLogValBatch(Double_t* output, RooBatchData& batch, const RooArgSet* set=0) const ;
 
   void setNormValueCaching(Int_t minNumIntDim, Int_t ipOrder=2) ;
   Int_t minDimNormValueCaching() const { return _minDimNormValueCache ; }
@@ -301,6 +302,7 @@ protected:
   static Int_t _verboseEval ;
 
   virtual Bool_t syncNormalization(const RooArgSet* dset, Bool_t adjustProxies=kTRUE) const ;
+  virtual void computeBatch(Double_t* output, RooBatchData& batch, const RooArgSet* set) const ;
 
   friend class RooAbsAnaConvPdf ;
   mutable Double_t _rawValue ;
@@ -40,6 +40,7 @@ class RooFitResult ;
 class RooMoment ;
 class RooDerivative ;
 class RooVectorDataStore ;
+class RooBatchData ;
 
 class TH1;
 class TH1F;
@@ -73,6 +74,9 @@ public:
 
   virtual Double_t getValV(const RooArgSet* set=0) const ;
 
+  // Vectorized evaluation on a batch of events
+  const Double_t* getValBatch(RooBatchData& batch, const RooArgSet* set=0) const ;
+
   Double_t getPropagatedError(const RooFitResult& fr) ;
 
   Bool_t operator==(Double_t value) const ;
@@ -364,6 +368,15 @@ protected:
   }
   virtual Double_t evaluate() const = 0 ;
 
+  // Vectorized evaluation
+  virtual void computeBatch(Double_t* output, RooBatchData& batch, const RooArgSet* set) const ;
+  virtual Bool_t evaluateBatch(Double_t* /*output*/, RooBatchData& /*batch*/) const { 
+    // Vectorized equivalent of evaluate() for all events in 'batch'. Return
+    // false if not implemented, in which case events are evaluated one by one
+    return kFALSE ; 
+  }
+  void computeBatchPerEvent(Double_t* output, RooBatchData& batch, const RooArgSet* set) const ;
+
   // Hooks for RooDataSet interface
   friend class RooRealIntegral ;
   friend class RooVectorDataStore ;
@@ -57,6 +57,15 @@ public:
 
   Bool_t setData(RooAbsData& data, Bool_t cloneData=kTRUE) ;
 
+  void setThreadedMode(Bool_t flag=kTRUE) ;
+  Bool_t threadedMode() const { 
+    // If true, parallel calculation is done in threads of this process rather than in server processes
+    return _mtMode ; 
+  }
+
+  virtual void printCacheStatistics(std::ostream& os, const char* indent="") const ;
+  virtual void resetCacheStatistics() ;
+
 protected:
 
   virtual void printCompactTreeHook(std::ostream& os, const char* indent="") ;
@@ -88,9 +97,9 @@ protected:
   
   RooSetProxy _paramSet ;          // Parameters of the test statistic (=parameters of the input function)
 
-  enum GOFOpMode { SimMaster,MPMaster,Slave } ;
+  enum GOFOpMode { SimMaster,MPMaster,Slave,MTMaster } ;
   GOFOpMode operMode() const { 
-    // Return test statistic operation mode of this instance (SimMaster, MPMaster or Slave)
+    // Return test statistic operation mode of this instance (SimMaster, MPMaster, Slave or MTMaster)
     return _gofOpMode ; 
   }
 
@@ -114,6 +123,8 @@ protected:
   Bool_t initialize() ;
   void initSimMode(RooSimultaneous* pdf, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;    
   void initMPMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;
+  void initMTMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;
+  Double_t evaluateMT() const ;
 
   mutable Bool_t _init ;          //! Is object initialized  
   GOFOpMode   _gofOpMode ;        // Operation mode of test statistic instance 
@@ -132,7 +143,12 @@ protected:
 
   Bool_t         _mpinterl ; // Use interleaving strategy rather than N-wise split for partioning of dataset for multiprocessor-split
 
-  ClassDef(RooAbsTestStatistic,1) // Abstract base class for real-valued test statistics
+  // Multi-threaded mode data
+  Bool_t         _mtMode ;     // Use threads rather than server processes in parallel calculation mode
+  pRooAbsTestStatistic* _mtArray ; //! Array of partition test statistics evaluated in worker threads
+  mutable Bool_t _mtWarm ;     //! Partitions have been evaluated once since last (re)configuration
+
+  ClassDef(RooAbsTestStatistic,2) // Abstract base class for real-valued test statistics
 };
 
 #endif
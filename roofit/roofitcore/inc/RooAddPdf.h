@@ -90,6 +90,8 @@ public:
 
 protected:
 
+  virtual Bool_t evaluateBatch(Double_t* output, RooBatchData& batch) const ;
+
   virtual void selectNormalization(const RooArgSet* depSet=0, Bool_t force=kFALSE) ;
   virtual void selectNormalizationRange(const char* rangeName=0, Bool_t force=kFALSE) ;
 
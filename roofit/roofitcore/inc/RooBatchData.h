@@ -0,0 +1,73 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ *    File: $Id$
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2005, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+#ifndef ROO_BATCH_DATA
+#define ROO_BATCH_DATA
+
+#include <map>
+#include <vector>
+#include "Rtypes.h"
+
+class TNamed ;
+class RooAbsArg ;
+class RooAbsCollection ;
+class RooVectorDataStore ;
+
+class RooBatchData {
+public:
+
+  RooBatchData(const RooVectorDataStore& store) ;
+  virtual ~RooBatchData() ;
+
+  void setRange(Int_t firstEvent, Int_t nEvents) ;
+  Int_t firstEvent() const {
+    // Return index of first event of current batch in data store
+    return _first ;
+  }
+  Int_t size() const {
+    // Return number of events in current batch
+    return _size ;
+  }
+
+  const Double_t* column(const RooAbsArg& arg) const ;
+  const Double_t* weights() const ;
+
+  Bool_t dependsOnData(const RooAbsArg& arg) ;
+  Bool_t dependsOnData(const RooAbsCollection& list) ;
+
+  void loadEvent(Int_t i) const ;
+  Double_t* makeBuffer() ;
+
+protected:
+
+  void addColumns(const RooVectorDataStore& store) ;
+
+  const RooVectorDataStore* _store ;                     // Data store with event data
+  Int_t _first ;                                         // Index of first event of current batch
+  Int_t _size ;                                          // Number of events in current batch
+  std::map<const TNamed*,const Double_t*> _columns ;     // Start of stored column of each real valued data or cache element
+  std::map<const RooAbsArg*,Bool_t> _dependsOnData ;     // Cache of dependsOnData() results
+  std::vector<std::vector<Double_t>*> _buffers ;         // Pool of output buffers of current batch
+  UInt_t _nextBuffer ;                                   // Index of next free buffer in pool
+
+private:
+
+  RooBatchData(const RooBatchData&) ;
+  RooBatchData& operator=(const RooBatchData&) ;
+
+  ClassDef(RooBatchData,0) // Event range of a vector data store for vectorized evaluation
+};
+
+#endif
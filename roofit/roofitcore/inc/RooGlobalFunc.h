@@ -136,6 +136,7 @@ RooCmdArg OwnLinked() ;
 RooCmdArg Extended(Bool_t flag=kTRUE) ;
 RooCmdArg DataError(Int_t) ;
 RooCmdArg NumCPU(Int_t nCPU, Bool_t interleave=kFALSE) ;
+RooCmdArg NumThreads(Int_t nThreads) ;
 
 // RooAbsPdf::printLatex arguments
 RooCmdArg Columns(Int_t ncol) ;
@@ -190,6 +191,7 @@ RooCmdArg PrintEvalErrors(Int_t numErrors) ;
 RooCmdArg EvalErrorWall(Bool_t flag) ;
 RooCmdArg SumW2Error(Bool_t flag) ;
 RooCmdArg CloneData(Bool_t flag) ;
+RooCmdArg BatchMode(Bool_t flag=kTRUE) ;
 RooCmdArg Integrate(Bool_t flag) ;
 RooCmdArg Minimizer(const char* type, const char* alg=0) ;
 
@@ -99,6 +99,7 @@ protected:
   RooLinkedListElem*  _last ;  //! Link to last element of list
   RooHashTable*       _htableName ; //! Hash table by name 
   RooHashTable*       _htableLink ; //! Hash table by link pointer
+  Int_t               _htableRenameCount ; //! Value of RooNameReg::renameCounter() when name hash table was filled
 
   Int_t _curStoreSize ; //!
   Int_t _curStoreUsed ; //!
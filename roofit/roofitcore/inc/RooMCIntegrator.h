@@ -20,6 +20,7 @@
 #include "RooGrid.h"
 #include "RooNumIntConfig.h"
 #include "TStopwatch.h"
+#include <vector>
 
 class RooMCIntegrator : public RooAbsIntegrator {
 public:
@@ -46,6 +47,9 @@ public:
   GeneratorType getGenType() const { return _genType; }
   void setGenType(GeneratorType type) { _genType= type; }
 
+  Int_t getNumThreads() const { return _nThreads; }
+  void setNumThreads(Int_t nThreads) { _nThreads= nThreads; }
+
   const RooGrid &grid() const { return _grid; }
 
   virtual Bool_t canIntegrate1D() const { return kTRUE ; }
@@ -58,6 +62,9 @@ protected:
   friend class RooNumIntFactory ;
   static void registerIntegrator(RooNumIntFactory& fact) ;	
 
+  Bool_t initThreadFuncs() ;
+  void evaluateParallel(const std::vector<Double_t>& x, std::vector<Double_t>& fval) ;
+
   mutable RooGrid _grid;  // Sampling grid definition
 
   // control variables
@@ -68,6 +75,9 @@ protected:
   Int_t _nRefineIter ;      // Number of refinement iterations
   Int_t _nRefinePerDim ;    // Number of refinement samplings (per dim)
   Int_t _nIntegratePerDim ; // Number of integration samplings (per dim)
+  Int_t _nThreads ;         // Number of threads for integrand evaluation
+
+  std::vector<RooAbsFunc*> _threadFuncs ; // Copies of integrand for evaluation in worker threads
 
   TStopwatch _timer;        // Timer
 
@@ -70,6 +70,7 @@ public:
   void setPrintEvalErrors(Int_t numEvalErrors) { _fcn->SetPrintEvalErrors(numEvalErrors); }
   void setVerbose(Bool_t flag=kTRUE) { _verbose = flag ; _fcn->SetVerbose(flag); }
   void setProfile(Bool_t flag=kTRUE) { _profile = flag ; }
+  void printCacheStatistics(std::ostream& os) const ;
   Bool_t setLogFile(const char* logf=0) { return _fcn->SetLogFile(logf); }
 
   void setMinimizerType(const char* type) ;
@@ -55,6 +55,10 @@ class RooMinimizerFcn : public ROOT::Math::IBaseFunctionMultiDim {
   Double_t& GetMaxFCN() { return _maxFCN; }
   Int_t GetNumInvalidNLL() { return _numBadNLL; }
 
+  Int_t GetNumEvaluations() const { return _numEval; }
+  Int_t GetNumParChanges() const { return _numParChanges; }
+  void ResetEvalCounters() { _numEval = 0; _numParChanges = 0; }
+
   Bool_t Synchronize(std::vector<ROOT::Fit::ParameterSettings>& parameters, 
 		     Bool_t optConst, Bool_t verbose);
   void BackProp(const ROOT::Fit::FitResult &results);  
@@ -83,6 +87,8 @@ private:
   mutable int _numBadNLL;
   mutable int _printEvalErrors;
   Bool_t _doEvalErrorWall;
+  mutable int _numEval;        // number of function evaluations
+  mutable int _numParChanges;  // number of parameter value changes summed over all evaluations
 
   int _nDim;
   std::ofstream *_logfile;
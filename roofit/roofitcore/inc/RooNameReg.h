@@ -32,17 +32,27 @@ public:
 
   static void cleanup() ;
 
+  static void incrementRenameCounter() { 
+    // Signal that an object registered in name based hash tables has changed its name
+    _renameCounter++ ; 
+  }
+  static Int_t renameCounter() { 
+    // Return number of name changes of existing objects
+    return _renameCounter ; 
+  }
+
 protected:
 
   static RooNameReg* _instance ;
+  static Int_t _renameCounter ;
 
-  RooNameReg() : TNamed("RooNameReg","RooFit Name Registry"), _htable(31) {} 
+  RooNameReg() : TNamed("RooNameReg","RooFit Name Registry"), _htable(new RooHashTable(31)) {} 
   RooNameReg(const RooNameReg& other) ;
 
-  RooHashTable _htable ; // Repository of registered names
+  RooHashTable* _htable ; // Repository of registered names
   RooLinkedList _list ; // 
 
-  ClassDef(RooNameReg,1) // String name registry
+  ClassDef(RooNameReg,2) // String name registry
 };
 
 #endif
@@ -98,6 +98,9 @@ public:
   
 protected:
 
+  virtual void computeBatch(Double_t* output, RooBatchData& batch, const RooArgSet* set) const ;
+  virtual Bool_t evaluateBatch(Double_t* output, RooBatchData& batch) const ;
+
 
   RooAbsReal* makeCondPdfRatioCorr(RooAbsReal& term, const RooArgSet& termNset, const RooArgSet& termImpSet, const char* normRange, const char* refRange) const ;
 
@@ -76,6 +76,7 @@ protected:
 
   Double_t calculate(const RooArgList& partIntList) const;
   Double_t evaluate() const;
+  virtual Bool_t evaluateBatch(Double_t* output, RooBatchData& batch) const ;
   const char* makeFPName(const char *pfx,const RooArgSet& terms) const ;
   ProdMap* groupProductTerms(const RooArgSet&) const;
   Int_t getPartIntList(const RooArgSet* iset, const char *rangeName=0) const;
@@ -38,12 +38,16 @@ public:
 
   virtual const char* getName() const ; 
 
+  virtual RooAbsFunc* cloneTree() const ;
+
   virtual std::list<Double_t>* binBoundaries(Int_t) const ;
   virtual std::list<Double_t>* plotSamplingHint(RooAbsRealLValue& /*obs*/, Double_t /*xlo*/, Double_t /*xhi*/) const ;
 
 protected:
 
   void loadValues(const Double_t xvector[]) const;
+  const RooAbsReal* cloneFuncTree(RooArgSet& varsClone, RooArgSet*& tree) const ;
+
   const RooAbsReal *_func;
   RooAbsRealLValue **_vars;
   const RooArgSet *_nset;
@@ -55,6 +59,7 @@ protected:
   mutable std::list<RooAbsReal*> _compList ; //!
   mutable std::list<Double_t>    _compSave ; //!
   mutable Double_t _funcSave ; //!
+  RooArgSet* _ownedTree ; //! Cloned expression tree owned by this binding
   
   ClassDef(RooRealBinding,0) // Function binding to RooAbsReal object
 };
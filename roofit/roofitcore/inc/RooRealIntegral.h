@@ -22,6 +22,8 @@
 #include "RooRealProxy.h"
 #include "RooSetProxy.h"
 #include "RooListProxy.h"
+#include <list>
+#include <vector>
 
 class RooArgSet ;
 class TH1F ;
@@ -70,6 +72,19 @@ public:
 
   static Int_t getCacheAllNumeric() ;
 
+  static void setNumCache(Int_t size, Double_t tolerance=0) ;
+  static Int_t getNumCacheSize() ;
+  static Double_t getNumCacheTolerance() ;
+
+  Int_t numCacheHits() const { 
+    // Return number of numeric integrations avoided by the numeric value cache
+    return _numCacheHits ; 
+  }
+  Int_t numCacheMisses() const { 
+    // Return number of numeric integrations performed while the numeric value cache was active
+    return _numCacheMisses ; 
+  }
+
   virtual std::list<Double_t>* plotSamplingHint(RooAbsRealLValue& obs, Double_t xlo, Double_t xhi) const {
     // Forward plot sampling hint of integrand
     return _function.arg().plotSamplingHint(obs,xlo,xhi) ;
@@ -93,6 +108,10 @@ protected:
   virtual Double_t integrate() const ;
   virtual Double_t jacobianProduct() const ;
 
+  void fillNumCacheKey(std::vector<Double_t>& key) const ;
+  Bool_t retrieveNumCache(const std::vector<Double_t>& key, Double_t& value) const ;
+  void storeNumCache(const std::vector<Double_t>& key, Double_t value) const ;
+
   // Evaluation and validation implementation
   Double_t evaluate() const ;
   virtual Bool_t isValidReal(Double_t value, Bool_t printError=kFALSE) const ;
@@ -137,6 +156,17 @@ protected:
   Bool_t _cacheNum ;           // Cache integral if numeric
   static Int_t _cacheAllNDim ; //! Cache all integrals with given numeric dimension
 
+  struct NumCacheElem {
+    std::vector<Double_t> _key ; // Parameter values and integration limits 
+    const TNamed* _range ;       // Name of the integration range
+    Double_t _value ;            // Integral value
+  } ;
+  mutable std::list<NumCacheElem> _numCache ; //! Cache of numeric integral values, most recently used first
+  mutable Int_t _numCacheHits ;               //! Number of values retrieved from numeric value cache
+  mutable Int_t _numCacheMisses ;             //! Number of values calculated while numeric value cache was active
+  static Int_t _numCacheSize ;                //! Maximum number of values in numeric value cache (zero disables cache)
+  static Double_t _numCacheTol ;              //! Relative tolerance for matching keys in numeric value cache
+
 
   virtual void operModeHook() ; // cache operation mode
 
@@ -65,6 +65,8 @@ public:
   static Bool_t getFloorGlobal() { return _doFloorGlobal ; }
 
 protected:
+
+  virtual Bool_t evaluateBatch(Double_t* output, RooBatchData& batch) const ;
   
   class CacheElem : public RooAbsCacheElement {
   public:
@@ -29,6 +29,7 @@ class RooAbsStudy ;
 #include "RooStudyPackage.h" 
 #include <list>
 #include <string>
+#include <vector>
 
 class RooStudyManager : public TNamed {
 public:
@@ -45,6 +46,9 @@ public:
   void runProof(Int_t nExperiments, const char* proofHost="", Bool_t showGui=kTRUE) ;
   static void closeProof(Option_t *option = "s") ;
 
+  // Parallel running in local worker processes
+  void runLocal(Int_t nExperiments, Int_t nWorkers, UInt_t seed=0) ;
+
   // Batch running
   void prepareBatchInput(const char* studyName, Int_t nExpPerJob, Bool_t unifiedInput) ;
   void processBatchOutput(const char* filePat) ;
@@ -56,6 +60,8 @@ protected:
 
   void aggregateData(TList* olist) ;
   void expandWildCardSpec(const char* spec, std::list<std::string>& result) ;
+  void processOutputFiles(const std::list<std::string>& flist) ;
+  static Bool_t runLocalBlock(RooStudyPackage& pkg, const std::vector<UInt_t>& seeds, Int_t firstExp, Int_t lastExp, Int_t seqno, const char* fileName) ;
 
   RooStudyPackage* _pkg ;
 
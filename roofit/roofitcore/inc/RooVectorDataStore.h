@@ -104,6 +104,9 @@ public:
 
   const RooVectorDataStore* cache() const { return _cache ; }
 
+  void printCacheStatistics(std::ostream& os, const char* indent="") const ;
+  void resetCacheStatistics() ;
+
   void loadValues(const RooAbsDataStore *tds, const RooFormulaVar* select=0, const char* rangeName=0, Int_t nStart=0, Int_t nStop=2000000000) ;
   
   void dump() ;
@@ -129,12 +132,12 @@ public:
   class RealVector {
   public:
     RealVector(UInt_t initialCapacity=100) : 
-      _nativeReal(0), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _tracker(0), _nset(0) { 
+      _nativeReal(0), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _tracker(0), _nset(0), _nRecalc(0), _nReuse(0) { 
       _vec.reserve(initialCapacity) ; 
     }
 
     RealVector(RooAbsReal* arg, UInt_t initialCapacity=100) : 
-      _nativeReal(arg), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _tracker(0), _nset(0) { 
+      _nativeReal(arg), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _tracker(0), _nset(0), _nRecalc(0), _nReuse(0) { 
       _vec.reserve(initialCapacity) ; 
     }
 
@@ -143,7 +146,8 @@ public:
     }
 
     RealVector(const RealVector& other, RooAbsReal* real=0) : 
-      _vec(other._vec), _nativeReal(real?real:other._nativeReal), _real(real?real:other._real), _buf(other._buf), _nativeBuf(other._nativeBuf)   {
+      _vec(other._vec), _nativeReal(real?real:other._nativeReal), _real(real?real:other._real), _buf(other._buf), _nativeBuf(other._nativeBuf), 
+      _nRecalc(0), _nReuse(0) {
       _vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
       if (other._tracker) {
 	_tracker = new RooChangeTracker(Form("track_%s",_nativeReal->GetName()),"tracker",other._tracker->parameters()) ;
@@ -190,9 +194,20 @@ public:
     
     Bool_t needRecalc() {
       if (!_tracker) return kFALSE ;
-      return _tracker->hasChanged(kTRUE) ;
+      Bool_t ret = _tracker->hasChanged(kTRUE) ;
+      if (ret) {
+	_nRecalc++ ;
+      } else {
+	_nReuse++ ;
+      }
+      return ret ;
     }
 
+    Bool_t isTracked() const { return _tracker!=0 ; }
+    Int_t numRecalc() const { return _nRecalc ; }
+    Int_t numReuse() const { return _nReuse ; }
+    void resetCounters() { _nRecalc = 0 ; _nReuse = 0 ; }
+
     void fill() { 
       _vec.push_back(*_buf) ; 
       _vec0 = &_vec.front() ;
@@ -218,6 +233,11 @@ public:
 
     Int_t size() const { return _vec.size() ; }
 
+    const Double_t* data() const { 
+      // Return pointer to contiguous array with stored values
+      return _vec.size()>0 ? &_vec.front() : 0 ; 
+    }
+
     void resize(Int_t siz) {
       _vec.resize(siz) ;
       _vec0 = &_vec.front() ;
@@ -235,6 +255,8 @@ public:
     Double_t* _vec0 ; //!
     RooChangeTracker* _tracker ; //
     RooArgSet* _nset ; //! 
+    Int_t _nRecalc ; //! Number of cache updates in which the column was recalculated
+    Int_t _nReuse ; //! Number of cache updates in which the column was reused
     ClassDef(RealVector,1) // STL-vector-based Data Storage class
   } ;
   
@@ -457,6 +479,7 @@ public:
   friend class RooAbsReal ;
   friend class RooAbsCategory ;
   friend class RooRealVar ;
+  friend class RooBatchData ;
   std::vector<RealVector*>& realStoreList() { return _realStoreList ; }
   std::vector<RealFullVector*>& realfStoreList() { return _realfStoreList ; }
   std::vector<CatVector*>& catStoreList() { return _catStoreList ; }
@@ -128,6 +128,10 @@ public:
   // Print function
   void Print(Option_t* opts=0) const ;
 
+  // Profiling of import 
+  void printImportStatistics() const ;
+  void resetImportStatistics() ;
+
   static void autoImportClassCode(Bool_t flag) ;
  
   static void addClassDeclImportDir(const char* dir) ;
@@ -240,6 +244,11 @@ public:
   Bool_t      _openTrans ;    //! Is there a transaction open?
   RooArgSet   _sandboxNodes ; //! Sandbox for incoming objects in a transaction
 
+  Int_t       _nImport ;         //! Number of calls to import() of functions and p.d.f.s
+  Int_t       _nImportNodes ;    //! Number of nodes added by import()
+  Int_t       _nImportRecycled ; //! Number of imported nodes connected to existing nodes
+  Double_t    _importTime ;      //! Real time spent in import() 
+
   ClassDef(RooWorkspace,7)  // Persistable project container for (composite) pdfs, functions, variables and datasets
   
 } ;
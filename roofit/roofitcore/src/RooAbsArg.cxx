@@ -142,8 +142,12 @@ RooAbsArg::RooAbsArg(const RooAbsArg& other, const char* name)
   // Copy constructor transfers all boolean and string properties of the original
   // object. Transient properties and client-server links are not copied
 
-  // Use name in argument, if supplied
-  if (name) SetName(name) ;
+  // Use name in argument, if supplied. Set directly as the new object is
+  // not yet stored in any name based hash table
+  if (name) {
+    TNamed::SetName(name) ;
+    _namePtr = (TNamed*) RooNameReg::instance().constPtr(GetName()) ;
+  }
 
   // Copy server list by hand
   RooFIter sIter = other._serverList.fwdIterator() ;
@@ -2264,8 +2268,15 @@ void RooAbsArg::wireAllCaches()
 //_____________________________________________________________________________
 void RooAbsArg::SetName(const char* name) 
 {
+  // Change name of object. Hash tables of collections containing this
+  // object are revalidated on their next lookup
+
   TNamed::SetName(name) ;
-  _namePtr = (TNamed*) RooNameReg::instance().constPtr(GetName()) ;
+  TNamed* newPtr = (TNamed*) RooNameReg::instance().constPtr(GetName()) ;
+  if (newPtr != _namePtr) {
+    RooNameReg::incrementRenameCounter() ;
+  }
+  _namePtr = newPtr ;
 }
 
 
@@ -2275,7 +2286,11 @@ void RooAbsArg::SetName(const char* name)
 void RooAbsArg::SetNameTitle(const char *name, const char *title)
 {
   TNamed::SetNameTitle(name,title) ;
-  _namePtr = (TNamed*) RooNameReg::instance().constPtr(GetName()) ;
+  TNamed* newPtr = (TNamed*) RooNameReg::instance().constPtr(GetName()) ;
+  if (newPtr != _namePtr) {
+    RooNameReg::incrementRenameCounter() ;
+  }
+  _namePtr = newPtr ;
 }
 
 
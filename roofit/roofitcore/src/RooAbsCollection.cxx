@@ -63,9 +63,11 @@ char* operator+( streampos&, char* );
 ClassImp(RooAbsCollection)
   ;
 
+Int_t RooAbsCollection::_defaultHashThresh(32) ;
+
 //_____________________________________________________________________________
 RooAbsCollection::RooAbsCollection() :
-  _list(0),
+  _list(_defaultHashThresh),
   _ownCont(kFALSE), 
   _name(),
   _allRRV(kTRUE)
@@ -79,7 +81,7 @@ RooAbsCollection::RooAbsCollection() :
 
 //_____________________________________________________________________________
 RooAbsCollection::RooAbsCollection(const char *name) :
-  _list(0),
+  _list(_defaultHashThresh),
   _ownCont(kFALSE), 
   _name(name),
   _allRRV(kTRUE)
@@ -95,7 +97,7 @@ RooAbsCollection::RooAbsCollection(const char *name) :
 RooAbsCollection::RooAbsCollection(const RooAbsCollection& other, const char *name) :
   TObject(other),
   RooPrintable(other),
-  _list(other._list.getHashTableSize()) , 
+  _list(_defaultHashThresh) , 
   _ownCont(kFALSE), 
   _name(name),
   _allRRV(other._allRRV)
@@ -106,6 +108,11 @@ RooAbsCollection::RooAbsCollection(const RooAbsCollection& other, const char *na
 
   RooTrace::create(this) ;
   if (!name) setName(other.GetName()) ;
+
+  // Presize hash table if source collection has one
+  if (other._list.getHashTableSize()>0) {
+    _list.setHashTableSize(other._list.getHashTableSize()) ;
+  }
   
   // Transfer contents (not owned)
   RooFIter iterat= other.fwdIterator();
@@ -818,6 +825,29 @@ Bool_t RooAbsCollection::overlaps(const RooAbsCollection& otherColl) const
 
 
 
+//_____________________________________________________________________________
+void RooAbsCollection::setDefaultHashThreshold(Int_t size) 
+{
+  // Set the number of elements above which collections created from now on
+  // maintain a hash table for lookups by name. A value of zero disables
+  // automatic hashing
+
+  _defaultHashThresh = size>0 ? size : 0 ;
+}
+
+
+
+//_____________________________________________________________________________
+Int_t RooAbsCollection::defaultHashThreshold() 
+{
+  // Return the number of elements above which new collections maintain
+  // a hash table for lookups by name
+
+  return _defaultHashThresh ;
+}
+
+
+
 //_____________________________________________________________________________
 RooAbsArg *RooAbsCollection::find(const char *name) const 
 {
@@ -641,22 +641,7 @@ void RooAbsOptTestStatistic::optimizeConstantTerms(Bool_t activate, Bool_t apply
 	      RooAbsArg* parg ;
 	      while ((parg=piter.next())) {
 		parg->setAttribute("CacheAndTrack") ;
-		RooArgSet* pdf_nset = prod->findPdfNSet((RooAbsPdf&)(*parg)) ;
-		
-		if (pdf_nset) {
-		  // Check if conditional normalization is specified		  
-		  if (string("nset")==pdf_nset->GetName() && pdf_nset->getSize()>0) {
-		    RooNameSet n(*pdf_nset) ;
-		    parg->setStringAttribute("CATNormSet",n.content()) ;
-		  }
-		  if (string("cset")==pdf_nset->GetName()) {
-		    RooNameSet c(*pdf_nset) ;
-		    parg->setStringAttribute("CATCondSet",c.content()) ;
-		  }
-		} else {
-		  coutW(Optimization) << "RooAbsOptTestStatistic::optimizeConstantTerms(" << GetName() << ") WARNING RooProdPdf::" << prod->GetName() 
-				      << " does not specify a normalization set for component " << parg->GetName() << endl ;
-		}
+		setTrackNormSet(*prod,(RooAbsPdf&)*parg) ;
 		trackNodes.add(*aarg) ;
 	      }
 	    } else {
@@ -688,6 +673,13 @@ void RooAbsOptTestStatistic::optimizeConstantTerms(Bool_t activate, Bool_t apply
 	  }
 	}
       }
+
+      // Also track the components of RooProdPdfs elsewhere in the expression that 
+      // depend on a strict subset of the floating parameters. These are only
+      // recalculated when one of their own parameters changes, e.g. in the numerical
+      // gradient calculation of MINUIT where one parameter is changed at a time
+      RooLinkedList processed ;
+      findProdTrackNodes(*_funcClone,numFloatingParams(*_funcClone),trackNodes,processed) ;
     }
     
     // Find all nodes that depend exclusively on constant parameters
@@ -754,6 +746,144 @@ void RooAbsOptTestStatistic::optimizeConstantTerms(Bool_t activate, Bool_t apply
 
 
 
+//_____________________________________________________________________________
+void RooAbsOptTestStatistic::setTrackNormSet(const RooProdPdf& prod, RooAbsPdf& comp) 
+{
+  // Copy the normalization specification of component 'comp' in RooProdPdf 'prod'
+  // into the CATNormSet or CATCondSet attribute of 'comp', so that the cache-and-track
+  // column of the component is calculated with the normalization it has in the product
+
+  RooArgSet* pdf_nset = prod.findPdfNSet(comp) ;
+		
+  if (pdf_nset) {
+    // Check if conditional normalization is specified		  
+    if (string("nset")==pdf_nset->GetName() && pdf_nset->getSize()>0) {
+      RooNameSet n(*pdf_nset) ;
+      comp.setStringAttribute("CATNormSet",n.content()) ;
+    }
+    if (string("cset")==pdf_nset->GetName()) {
+      RooNameSet c(*pdf_nset) ;
+      comp.setStringAttribute("CATCondSet",c.content()) ;
+    }
+  } else {
+    coutW(Optimization) << "RooAbsOptTestStatistic::optimizeConstantTerms(" << GetName() << ") WARNING RooProdPdf::" << prod.GetName() 
+			<< " does not specify a normalization set for component " << comp.GetName() << endl ;
+  }
+}
+
+
+
+//_____________________________________________________________________________
+Int_t RooAbsOptTestStatistic::numFloatingParams(const RooAbsArg& arg) const
+{
+  // Return the number of non-constant parameters of 'arg' with respect to the observables of the dataset
+
+  RooArgSet* params = arg.getParameters(*_dataClone->get()) ;
+  Int_t n(0) ;
+  RooFIter iter = params->fwdIterator() ;
+  RooAbsArg* param ;
+  while((param=iter.next())) {
+    if (!param->isConstant()) n++ ;
+  }
+  delete params ;
+  return n ;
+}
+
+
+
+//_____________________________________________________________________________
+void RooAbsOptTestStatistic::findProdTrackNodes(RooAbsArg& node, Int_t nFloatTotal, RooArgSet& trackNodes, RooLinkedList& processedNodes) 
+{
+  // Descend through the RooAddPdfs and RooProdPdfs of the expression starting at 'node'
+  // and select for cache-and-track optimization all components of RooProdPdfs that
+  // depend on the observables and on some, but not all (nFloatTotal), of the floating 
+  // parameters. Components that are RooAddPdfs or RooProdPdfs themselves are not
+  // cached but searched further
+
+  if (processedNodes.findArg(&node)) return ;
+  processedNodes.Add(&node) ;
+
+  RooAddPdf* apdf = dynamic_cast<RooAddPdf*>(&node) ;
+  if (apdf) {
+    RooFIter aiter = apdf->pdfList().fwdIterator() ;
+    RooAbsArg* aarg ;
+    while ((aarg=aiter.next())) {
+      findProdTrackNodes(*aarg,nFloatTotal,trackNodes,processedNodes) ;
+    }
+    return ;
+  }
+
+  RooProdPdf* prod = dynamic_cast<RooProdPdf*>(&node) ;
+  if (!prod) return ;
+
+  RooFIter piter = prod->pdfList().fwdIterator() ;
+  RooAbsArg* parg ;
+  while ((parg=piter.next())) {
+
+    if (dynamic_cast<RooAddPdf*>(parg) || dynamic_cast<RooProdPdf*>(parg)) {
+      findProdTrackNodes(*parg,nFloatTotal,trackNodes,processedNodes) ;
+      continue ;
+    }
+
+    // Skip components that are already tracked, cannot be tracked or do not depend on the observables
+    if (parg->getAttribute("CacheAndTrack") || parg->getAttribute("NOCacheAndTrack") || !parg->dependsOnValue(*_dataClone->get())) {
+      continue ;
+    }
+
+    // Constant components are handled by the constant term optimization
+    Int_t nFloat = numFloatingParams(*parg) ;
+    if (nFloat==0 || nFloat>=nFloatTotal) {
+      continue ;
+    }
+
+    parg->setAttribute("CacheAndTrack") ;
+    setTrackNormSet(*prod,(RooAbsPdf&)*parg) ;
+    trackNodes.add(*parg) ;
+  }
+}
+
+
+
+//_____________________________________________________________________________
+void RooAbsOptTestStatistic::printCacheStatistics(ostream& os, const char* indent) const
+{
+  // Print how often the columns of nodes in cache-and-track mode were recalculated
+  // and how often they could be reused because their parameters had not changed
+
+  if (operMode()!=Slave) {
+    RooAbsTestStatistic::printCacheStatistics(os,indent) ;
+    return ;
+  }
+
+  RooVectorDataStore* vstore = dynamic_cast<RooVectorDataStore*>(_dataClone->store()) ;
+  if (!vstore || !vstore->cache()) return ;
+
+  os << indent << "RooAbsOptTestStatistic(" << GetName() << ") cache-and-track statistics:" << endl ;
+  TString indent2(indent) ;
+  indent2 += "  " ;
+  vstore->printCacheStatistics(os,indent2) ;
+}
+
+
+
+//_____________________________________________________________________________
+void RooAbsOptTestStatistic::resetCacheStatistics() 
+{
+  // Reset the counters of the cache-and-track optimization
+
+  if (operMode()!=Slave) {
+    RooAbsTestStatistic::resetCacheStatistics() ;
+    return ;
+  }
+
+  RooVectorDataStore* vstore = dynamic_cast<RooVectorDataStore*>(_dataClone->store()) ;
+  if (vstore) {
+    vstore->resetCacheStatistics() ;
+  }
+}
+
+
+
 //_____________________________________________________________________________
 Bool_t RooAbsOptTestStatistic::setDataSlave(RooAbsData& indata, Bool_t cloneData, Bool_t ownNewData) 
 { 
@@ -152,7 +152,11 @@
 #include "RooChi2Var.h"
 #include "RooMinimizer.h"
 #include "RooRealIntegral.h"
+#include "RooBatchData.h"
 #include <string>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
 
 using namespace std;
 
@@ -163,6 +167,12 @@ ClassImp(RooAbsPdf::GenSpec)
 
 Int_t RooAbsPdf::_verboseEval = 0;
 Bool_t RooAbsPdf::_evalError = kFALSE ;
+
+#ifndef _WIN32
+// Protects the evaluation error flag, which may be raised concurrently by
+// the worker threads of multi-threaded test statistics
+static pthread_mutex_t _evalErrorMutex = PTHREAD_MUTEX_INITIALIZER ;
+#endif
 TString RooAbsPdf::_normRangeOverride ;
 
 //_____________________________________________________________________________
@@ -302,6 +312,47 @@ Double_t RooAbsPdf::getValV(const RooArgSet* nset) const
 
 
 
+//_____________________________________________________________________________
+void RooAbsPdf::computeBatch(Double_t* output, RooBatchData& batch, const RooArgSet* nset) const
+{
+  // Calculate the values of this p.d.f. for all events in 'batch', normalized
+  // over the observables in 'nset'. This is the vectorized equivalent of getValV():
+  // the unnormalized values are calculated with evaluateBatch() and divided by
+  // the normalization integral with the same error checking as in getValV().
+  // P.d.f.s that do not implement evaluateBatch() are evaluated event by event
+
+  if (!nset) {
+    computeBatchPerEvent(output,batch,nset) ;
+    return ;
+  }
+
+  if (nset!=_normSet || _norm==0) {
+    syncNormalization(nset) ;
+  }
+
+  // Evaluate numerators
+  if (!evaluateBatch(output,batch)) {
+    computeBatchPerEvent(output,batch,nset) ;
+    return ;
+  }
+
+  // Evaluate denominators. Normalization integrals that depend on
+  // conditional observables are calculated event by event
+  const Double_t* normVal = _norm->getValBatch(batch) ;
+
+  Int_t n = batch.size() ;
+  for (Int_t i=0 ; i<n ; i++) {
+    Bool_t error = traceEvalPdf(output[i]) ; // Error checking and printing
+    if (normVal[i]<=0.) {
+      error=kTRUE ;
+      logEvalError("p.d.f normalization integral is zero or negative") ;  
+    }
+    output[i] = error ? 0 : output[i] / normVal[i] ;
+  }
+}
+
+
+
 //_____________________________________________________________________________
 Double_t RooAbsPdf::analyticalIntegralWN(Int_t code, const RooArgSet* normSet, const char* rangeName) const
 {
@@ -639,6 +690,34 @@ Double_t RooAbsPdf::getLogVal(const RooArgSet* nset) const
 
 
 
+//_____________________________________________________________________________
+void RooAbsPdf::getLogValBatch(Double_t* output, RooBatchData& batch, const RooArgSet* nset) const 
+{
+  // Calculate the log of the values with given normalization for all events
+  // in 'batch' into 'output'. The same error checking as in getLogVal() is
+  // applied to each event
+
+  const Double_t* prob = getValBatch(batch,nset) ;
+
+  Int_t n = batch.size() ;
+  for (Int_t i=0 ; i<n ; i++) {
+    if(prob[i] < 0) {
+      logEvalError("getLogVal() top-level p.d.f evaluates to a negative number") ;
+      output[i] = 0 ;
+    } else if(prob[i] == 0) {
+      logEvalError("getLogVal() top-level p.d.f evaluates to zero") ;
+      output[i] = log((double)0) ;
+    } else if (TMath::IsNaN(prob[i])) {
+      logEvalError("getLogVal() top-level p.d.f evaluates to NaN") ;
+      output[i] = log((double)0) ;
+    } else {
+      output[i] = log(prob[i]) ;
+    }
+  }
+}
+
+
+
 //_____________________________________________________________________________
 Double_t RooAbsPdf::extendedTerm(Double_t observed, const RooArgSet* nset) const 
 {
@@ -709,6 +788,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooCmdArg& arg1, const
   //                                    Multiple comma separated range names can be specified.
   // SumCoefRange(const char* name)  -- Set the range in which to interpret the coefficients of RooAddPdf components 
   // NumCPU(int num)                 -- Parallelize NLL calculation on num CPUs
+  // NumThreads(int num)             -- Parallelize NLL calculation on num threads of this process
+  //                                    instead of num server processes
   // Optimize(Bool_t flag)           -- Activate constant term optimization (on by default)
   // SplitRange(Bool_t flag)         -- Use separate fit ranges in a simultaneous fit. Actual range name for each
   //                                    subsample is assumed to by rangeName_{indexState} where indexState
@@ -719,6 +800,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooCmdArg& arg1, const
   //                                        If none are specified the constrained parameters are used
   // Verbose(Bool_t flag)           -- Constrols RooFit informational messages in likelihood construction
   // CloneData(Bool flag)           -- Use clone of dataset in NLL (default is true)
+  // BatchMode(Bool_t flag)         -- Evaluate p.d.f. in batches of events, reading the observables directly
+  //                                   from the columns of the dataset (off by default)
   // 
   // 
   
@@ -756,9 +839,11 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
   pc.defineInt("splitRange","SplitRange",0,0) ;
   pc.defineInt("ext","Extended",0,2) ;
   pc.defineInt("numcpu","NumCPU",0,1) ;
+  pc.defineInt("numthreads","NumThreads",0,1) ;
   pc.defineInt("verbose","Verbose",0,0) ;
   pc.defineInt("optConst","Optimize",0,0) ;
   pc.defineInt("cloneData","CloneData",2,0) ;
+  pc.defineInt("batchMode","BatchMode",0,0) ;
   pc.defineSet("projDepSet","ProjectedObservables",0,0) ;
   pc.defineSet("cPars","Constrain",0,0) ;
   pc.defineSet("glObs","GlobalObservables",0,0) ;
@@ -767,6 +852,7 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
   pc.defineMutex("Range","RangeWithName") ;
   pc.defineMutex("Constrain","Constrained") ;
   pc.defineMutex("GlobalObservables","GlobalObservablesTag") ;
+  pc.defineMutex("NumCPU","NumThreads") ;
     
   // Process and check varargs 
   pc.process(cmdList) ;
@@ -784,6 +870,13 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
   Bool_t verbose = pc.getInt("verbose") ;
   Int_t optConst = pc.getInt("optConst") ;
   Int_t cloneData = pc.getInt("cloneData") ;
+  Bool_t batchMode = pc.getInt("batchMode") ;
+
+  // Parallel calculation in threads uses the same partitioning as in server processes
+  Bool_t threaded = pc.hasProcessed("NumThreads") ;
+  if (threaded) {
+    numcpu = pc.getInt("numthreads") ;
+  }
   
   // If no explicit cloneData command is specified, cloneData is set to true if optimization is activated
   if (cloneData==2) {
@@ -848,6 +941,8 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
     //cout<<"FK: Data test 1: "<<data.sumEntries()<<endl;
 
     nll = new RooNLLVar(baseName.c_str(),"-log(likelihood)",*this,data,projDeps,ext,rangeName,addCoefRangeName,numcpu,kFALSE,verbose,splitr,cloneData) ;
+    ((RooNLLVar*)nll)->setBatchMode(batchMode) ;
+    ((RooNLLVar*)nll)->setThreadedMode(threaded) ;
 
   } else {
     // Composite case: multiple ranges
@@ -857,7 +952,9 @@ RooAbsReal* RooAbsPdf::createNLL(RooAbsData& data, const RooLinkedList& cmdList)
     strlcpy(buf,rangeName,bufSize) ;
     char* token = strtok(buf,",") ;
     while(token) {
-      RooAbsReal* nllComp = new RooNLLVar(Form("%s_%s",baseName.c_str(),token),"-log(likelihood)",*this,data,projDeps,ext,token,addCoefRangeName,numcpu,kFALSE,verbose,splitr,cloneData) ;
+      RooNLLVar* nllComp = new RooNLLVar(Form("%s_%s",baseName.c_str(),token),"-log(likelihood)",*this,data,projDeps,ext,token,addCoefRangeName,numcpu,kFALSE,verbose,splitr,cloneData) ;
+      nllComp->setBatchMode(batchMode) ;
+      nllComp->setThreadedMode(threaded) ;
       nllList.add(*nllComp) ;
       token = strtok(0,",") ;
     }
@@ -927,6 +1024,8 @@ RooFitResult* RooAbsPdf::fitTo(RooAbsData& data, const RooCmdArg& arg1, const Ro
   //                                    Multiple comma separated range names can be specified.
   // SumCoefRange(const char* name)  -- Set the range in which to interpret the coefficients of RooAddPdf components 
   // NumCPU(int num)                 -- Parallelize NLL calculation on num CPUs
+  // NumThreads(int num)             -- Parallelize NLL calculation on num threads of this process
+  //                                    instead of num server processes
   // SplitRange(Bool_t flag)         -- Use separate fit ranges in a simultaneous fit. Actual range name for each
   //                                    subsample is assumed to by rangeName_{indexState} where indexState
   //                                    is the state of the master index category of the simultaneous fit
@@ -935,6 +1034,8 @@ RooFitResult* RooAbsPdf::fitTo(RooAbsData& data, const RooCmdArg& arg1, const Ro
   // GlobalObservables(const RooArgSet&) -- Define the set of normalization observables to be used for the constraint terms.
   //                                        If none are specified the constrained parameters are used
   // ExternalConstraints(const RooArgSet& ) -- Include given external constraints to likelihood
+  // BatchMode(Bool_t flag)          -- Evaluate p.d.f. in batches of events, reading the observables directly
+  //                                    from the columns of the dataset (off by default)
   //
   // Options to control flow of fit procedure
   // ----------------------------------------
@@ -1008,7 +1109,7 @@ RooFitResult* RooAbsPdf::fitTo(RooAbsData& data, const RooLinkedList& cmdList)
   RooCmdConfig pc(Form("RooAbsPdf::fitTo(%s)",GetName())) ;
 
   RooLinkedList fitCmdList(cmdList) ;
-  RooLinkedList nllCmdList = pc.filterCmdList(fitCmdList,"ProjectedObservables,Extended,Range,RangeWithName,SumCoefRange,NumCPU,SplitRange,Constrained,Constrain,ExternalConstraints,CloneData,GlobalObservables,GlobalObservablesTag") ;
+  RooLinkedList nllCmdList = pc.filterCmdList(fitCmdList,"ProjectedObservables,Extended,Range,RangeWithName,SumCoefRange,NumCPU,SplitRange,Constrained,Constrain,ExternalConstraints,CloneData,GlobalObservables,GlobalObservablesTag,BatchMode,NumThreads") ;
 
   pc.defineString("fitOpt","FitOptions",0,"") ;
   pc.defineInt("optConst","Optimize",0,2) ;
@@ -3109,7 +3210,13 @@ RooArgSet* RooAbsPdf::getAllConstraints(const RooArgSet& observables, RooArgSet&
 void RooAbsPdf::clearEvalError() 
 { 
   // Clear the evaluation error flag
+#ifndef _WIN32
+  pthread_mutex_lock(&_evalErrorMutex) ;
+#endif
   _evalError = kFALSE ; 
+#ifndef _WIN32
+  pthread_mutex_unlock(&_evalErrorMutex) ;
+#endif
 }
 
 
@@ -3118,7 +3225,14 @@ void RooAbsPdf::clearEvalError()
 Bool_t RooAbsPdf::evalError() 
 { 
   // Return the evaluation error flag
-  return _evalError ; 
+#ifndef _WIN32
+  pthread_mutex_lock(&_evalErrorMutex) ;
+#endif
+  Bool_t ret = _evalError ; 
+#ifndef _WIN32
+  pthread_mutex_unlock(&_evalErrorMutex) ;
+#endif
+  return ret ; 
 }
 
 
@@ -3127,7 +3241,13 @@ Bool_t RooAbsPdf::evalError()
 void RooAbsPdf::raiseEvalError() 
 { 
   // Raise the evaluation error flag
+#ifndef _WIN32
+  pthread_mutex_lock(&_evalErrorMutex) ;
+#endif
   _evalError = kTRUE ; 
+#ifndef _WIN32
+  pthread_mutex_unlock(&_evalErrorMutex) ;
+#endif
 }
 
 
@@ -74,6 +74,7 @@
 #include "RooMoment.h"
 #include "RooBrentRootFinder.h"
 #include "RooVectorDataStore.h"
+#include "RooBatchData.h"
 #include "RooCachedReal.h"
 
 #include "Riostream.h"
@@ -96,6 +97,10 @@
 
 #include <sstream>
 
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
 using namespace std ;
  
 ClassImp(RooAbsReal)
@@ -108,6 +113,37 @@ RooAbsReal::ErrorLoggingMode RooAbsReal::_evalErrorMode = RooAbsReal::PrintError
 Int_t RooAbsReal::_evalErrorCount = 0 ;
 map<const RooAbsArg*,pair<string,list<RooAbsReal::EvalError> > > RooAbsReal::_evalErrorList ;
 
+namespace {
+
+  // Lock serializing access to the evaluation error log, which may be
+  // filled concurrently by the worker threads of a RooAbsTestStatistic in
+  // multi-threaded mode. The mutex is recursive as printing the server
+  // values of a node may log further evaluation errors in the same thread
+  class EvalErrorLock {
+  public:
+#ifndef _WIN32
+    EvalErrorLock() { pthread_once(&fgOnce,Init) ; pthread_mutex_lock(&fgMutex) ; }
+    ~EvalErrorLock() { pthread_mutex_unlock(&fgMutex) ; }
+  private:
+    static void Init() {
+      pthread_mutexattr_t attr ;
+      pthread_mutexattr_init(&attr) ;
+      pthread_mutexattr_settype(&attr,PTHREAD_MUTEX_RECURSIVE) ;
+      pthread_mutex_init(&fgMutex,&attr) ;
+      pthread_mutexattr_destroy(&attr) ;
+    }
+    static pthread_once_t fgOnce ;
+    static pthread_mutex_t fgMutex ;
+#endif
+  } ;
+
+#ifndef _WIN32
+  pthread_once_t EvalErrorLock::fgOnce = PTHREAD_ONCE_INIT ;
+  pthread_mutex_t EvalErrorLock::fgMutex ;
+#endif
+
+}
+
 
 //_____________________________________________________________________________
 RooAbsReal::RooAbsReal() : _specIntegratorConfig(0), _treeVar(kFALSE), _selectComp(kTRUE), _lastNSet(0)
@@ -233,6 +269,81 @@ Double_t RooAbsReal::getValV(const RooArgSet* nset) const
 }
 
 
+
+//_____________________________________________________________________________
+const Double_t* RooAbsReal::getValBatch(RooBatchData& batch, const RooArgSet* nset) const
+{
+  // Return the values of this object for all events in 'batch', normalized
+  // over the observables in 'nset' as in getVal(). If the values are stored 
+  // in the data (as observable or as precalculated node of the constant term
+  // optimizer) the stored column is returned. If the object does not depend
+  // on any of the observables, the single value is broadcast to all events.
+  // Otherwise the values are calculated through computeBatch(). The returned
+  // array is valid until the next change of the event range of 'batch'
+
+  const Double_t* col = batch.column(*this) ;
+  if (col) {
+    return col ;
+  }
+
+  Double_t* output = batch.makeBuffer() ;
+  Int_t n = batch.size() ;
+
+  if (!batch.dependsOnData(*this)) {
+    Double_t val = getVal(nset) ;
+    for (Int_t i=0 ; i<n ; i++) {
+      output[i] = val ;
+    }
+    return output ;
+  }
+
+  computeBatch(output,batch,nset) ;
+  return output ;
+}
+
+
+
+//_____________________________________________________________________________
+void RooAbsReal::computeBatch(Double_t* output, RooBatchData& batch, const RooArgSet* nset) const
+{
+  // Calculate the values of this object for all events in 'batch' into 'output'.
+  // The vectorized evaluateBatch() is used if implemented by the derived class,
+  // otherwise all events are loaded and evaluated one by one
+
+  if (nset && nset!=_lastNSet) {
+    ((RooAbsReal*) this)->setProxyNormSet(nset) ;    
+    _lastNSet = (RooArgSet*) nset ;
+  }
+
+  if (!evaluateBatch(output,batch)) {
+    computeBatchPerEvent(output,batch,nset) ;
+    return ;
+  }
+
+  Int_t n = batch.size() ;
+  for (Int_t i=0 ; i<n ; i++) {
+    if (TMath::IsNaN(output[i])) {
+      logEvalError("function value is NAN") ;
+    }
+  }
+}
+
+
+
+//_____________________________________________________________________________
+void RooAbsReal::computeBatchPerEvent(Double_t* output, RooBatchData& batch, const RooArgSet* nset) const
+{
+  // Calculate the values of this object for all events in 'batch' into 'output'
+  // by loading each event in turn and calling getVal()
+
+  Int_t n = batch.size() ;
+  for (Int_t i=0 ; i<n ; i++) {
+    batch.loadEvent(i) ;
+    output[i] = getVal(nset) ;
+  }
+}
+
+
 //_____________________________________________________________________________
 Int_t RooAbsReal::numEvalErrorItems() 
 { 
@@ -3348,6 +3459,8 @@ void RooAbsReal::logEvalError(const RooAbsReal* originator, const char* origName
     return ;
   }
 
+  EvalErrorLock lock ;
+
   if (_evalErrorMode==CountErrors) {
     _evalErrorCount++ ;
     return ;
@@ -3403,6 +3516,8 @@ void RooAbsReal::logEvalError(const char* message, const char* serverValueString
     return ;
   }
 
+  EvalErrorLock lock ;
+
   if (_evalErrorMode==CountErrors) {
     _evalErrorCount++ ;
     return ;
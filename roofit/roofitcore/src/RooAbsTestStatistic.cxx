@@ -29,7 +29,8 @@
 // organizes multi-processor parallel calculation of test statistic
 // values. For the latter, the test statistic value is calculated in
 // partitions in parallel executing processes and a posteriori
-// combined in the main thread.
+// combined in the main thread. Alternatively the partitions can be
+// calculated in parallel threads of the same process, see setThreadedMode()
 // END_HTML
 //
 
@@ -50,6 +51,10 @@
 
 #include <string>
 
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
 using namespace std;
 
 ClassImp(RooAbsTestStatistic)
@@ -77,6 +82,9 @@ RooAbsTestStatistic::RooAbsTestStatistic()
   _simCount = 0 ;
   _splitRange = 0 ;
   _verbose = kFALSE ;
+  _mtMode = kFALSE ;
+  _mtArray = 0 ;
+  _mtWarm = kFALSE ;
 }
 
 
@@ -99,7 +107,10 @@ RooAbsTestStatistic::RooAbsTestStatistic(const char *name, const char *title, Ro
   _gofArray(0),
   _nCPU(nCPU),
   _mpfeArray(0),
-  _mpinterl(interleave)
+  _mpinterl(interleave),
+  _mtMode(kFALSE),
+  _mtArray(0),
+  _mtWarm(kFALSE)
 {
   // Constructor taking function (real), a dataset (data), a set of projected observables (projSet). If
   // rangeName is not null, only events in the dataset inside the range will be used in the test
@@ -164,7 +175,10 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
   _gofArray(0),
   _nCPU(other._nCPU),
   _mpfeArray(0),
-  _mpinterl(other._mpinterl)
+  _mpinterl(other._mpinterl),
+  _mtMode(other._mtMode),
+  _mtArray(0),
+  _mtWarm(kFALSE)
 {
   // Copy constructor
 
@@ -177,7 +191,7 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
       _nCPU=1 ;
     }
       
-    _gofOpMode = MPMaster ;
+    _gofOpMode = _mtMode ? MTMaster : MPMaster ;
 
   } else {
 
@@ -214,6 +228,14 @@ RooAbsTestStatistic::~RooAbsTestStatistic()
     delete[] _mpfeArray ;
   }
 
+  if (_gofOpMode==MTMaster && _init) {
+    Int_t i ;
+    for (i=0 ; i<_nCPU ; i++) {
+      delete _mtArray[i] ;
+    }
+    delete[] _mtArray ;
+  }
+
   if (_gofOpMode==SimMaster && _init) {
     Int_t i ;
     for (i=0 ; i<_nGof ; i++) {
@@ -236,7 +258,7 @@ Double_t RooAbsTestStatistic::evaluate() const
   // is calculated from on a RooSimultaneous, the test statistic calculation
   // is performed separately on each simultaneous p.d.f component and associated
   // data and then combined. If the test statistic calculation is parallelized
-  // partitions are calculated in nCPU processes and a posteriori combined.
+  // partitions are calculated in nCPU processes (or threads) and a posteriori combined.
 
   // One-time Initialization
   if (!_init) {
@@ -266,6 +288,11 @@ Double_t RooAbsTestStatistic::evaluate() const
     Double_t ret = combinedValue((RooAbsReal**)_mpfeArray,_nCPU)/globalNormalization() ;
     return ret ;
 
+  } else if (_gofOpMode==MTMaster) {
+
+    // Calculate partitions in parallel threads
+    return evaluateMT()/globalNormalization() ;
+
   } else {
 
     // Evaluate as straight FUNC
@@ -307,6 +334,8 @@ Bool_t RooAbsTestStatistic::initialize()
   
   if (_gofOpMode==MPMaster) {
     initMPMode(_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
+  } else if (_gofOpMode==MTMaster) {
+    initMTMode(_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
   } else if (_gofOpMode==SimMaster) {
     initSimMode((RooSimultaneous*)_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
   }
@@ -340,6 +369,17 @@ Bool_t RooAbsTestStatistic::redirectServersHook(const RooAbsCollection& newServe
       }
     }
 
+  } else if (_gofOpMode==MTMaster && _mtArray) {
+
+    // Forward to partitions
+    Int_t i ;
+    for (i=0 ; i<_nCPU ; i++) {
+      if (_mtArray[i]) {
+	_mtArray[i]->recursiveRedirectServers(newServerList,mustReplaceAll,nameChange) ;
+      }
+    }
+    _mtWarm = kFALSE ;
+
   }
   return kFALSE ;
 }
@@ -364,6 +404,16 @@ void RooAbsTestStatistic::printCompactTreeHook(ostream& os, const char* indent)
       }
     }
     os << indent << "RooAbsTestStatistic end GOF contents" << endl ;
+  } else if (_gofOpMode==MTMaster && _mtArray) {
+    // Forward to partitions
+    Int_t i ;
+    os << indent << "RooAbsTestStatistic begin partition contents" << endl ;
+    for (i=0 ; i<_nCPU ; i++) {
+      TString indent2(indent) ;
+      indent2 += Form("[%d] ",i) ;
+      _mtArray[i]->printCompactTreeHook(os,indent2) ;
+    }
+    os << indent << "RooAbsTestStatistic end partition contents" << endl ;
   } else if (_gofOpMode==MPMaster) {
     // WVE implement this
   }
@@ -387,6 +437,54 @@ void RooAbsTestStatistic::constOptimizeTestStatistic(ConstOpCode opcode, Bool_t
     for (i=0 ; i<_nCPU ; i++) {
       _mpfeArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt) ;
     }
+  } else if (_gofOpMode==MTMaster) {
+    for (i=0 ; i<_nCPU ; i++) {
+      _mtArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt) ;
+    }
+    // Caches may have been rebuilt, next evaluation is done sequentially
+    _mtWarm = kFALSE ;
+  }
+}
+
+
+
+//_____________________________________________________________________________
+void RooAbsTestStatistic::printCacheStatistics(ostream& os, const char* indent) const
+{
+  // Print the statistics of the cache-and-track optimization of the component
+  // test statistics. Not available in multi-processor mode, where the caches
+  // reside in the server processes
+
+  Int_t i ;
+  if (_gofOpMode==SimMaster && _init) {
+    for (i=0 ; i<_nGof ; i++) {
+      _gofArray[i]->printCacheStatistics(os,indent) ;
+    }
+  } else if (_gofOpMode==MTMaster && _init) {
+    for (i=0 ; i<_nCPU ; i++) {
+      _mtArray[i]->printCacheStatistics(os,indent) ;
+    }
+  } else if (_gofOpMode==MPMaster) {
+    os << indent << "RooAbsTestStatistic(" << GetName() << ") cache statistics are not available in multi-processor mode" << endl ;
+  }
+}
+
+
+
+//_____________________________________________________________________________
+void RooAbsTestStatistic::resetCacheStatistics() 
+{
+  // Reset the statistics of the cache-and-track optimization of the component test statistics
+
+  Int_t i ;
+  if (_gofOpMode==SimMaster && _init) {
+    for (i=0 ; i<_nGof ; i++) {
+      _gofArray[i]->resetCacheStatistics() ;
+    }
+  } else if (_gofOpMode==MTMaster && _init) {
+    for (i=0 ; i<_nCPU ; i++) {
+      _mtArray[i]->resetCacheStatistics() ;
+    }
   }
 }
 
@@ -443,6 +541,116 @@ void RooAbsTestStatistic::initMPMode(RooAbsReal* real, RooAbsData* data, const R
 
 
 
+#ifndef _WIN32
+//_____________________________________________________________________________
+static void* RooAbsTestStatisticMTWorker(void* gof)
+{
+  // Entry point of worker threads in multi-threaded calculation mode
+
+  ((RooAbsTestStatistic*)gof)->getVal() ;
+  return 0 ;
+}
+#endif
+
+
+
+//_____________________________________________________________________________
+void RooAbsTestStatistic::initMTMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName)
+{
+  // Initialize multi-threaded calculation mode. Create one component test statistic
+  // for each partition of the data. Each component owns its own clone of the
+  // function and of the data, only the parameters are shared with this instance.
+
+  Int_t i ;
+  _mtArray = new pRooAbsTestStatistic[_nCPU] ;
+
+  for (i=0 ; i<_nCPU ; i++) {
+    _mtArray[i] = create(Form("%s_GOF%d",GetName(),i),Form("%s_GOF%d",GetTitle(),i),*real,*data,*projDeps,rangeName,addCoefRangeName,1,_mpinterl,_verbose,_splitRange) ;
+    _mtArray[i]->recursiveRedirectServers(_paramSet) ;
+    _mtArray[i]->setMPSet(i,_nCPU) ;
+  }
+  coutI(Eval) << "RooAbsTestStatistic::initMTMode(" << GetName() << ") calculating " << _nCPU << " partitions in parallel threads" << endl ;
+
+  _mtWarm = kFALSE ;
+  return ;
+}
+
+
+
+//_____________________________________________________________________________
+Double_t RooAbsTestStatistic::evaluateMT() const
+{
+  // Calculate the partitions of the test statistic in parallel threads and
+  // return their combined value. The first calculation after initialization
+  // or constant term optimization is done sequentially, as it creates the
+  // normalization integrals and caches of the function clones on demand
+
+  Int_t i ;
+
+#ifndef _WIN32
+  if (_mtWarm) {
+
+    // Start all but the last partition in worker threads, calculate last partition inline
+    pthread_t* threads = new pthread_t[_nCPU] ;
+    Bool_t* started = new Bool_t[_nCPU] ;
+    for (i=0 ; i<_nCPU-1 ; i++) {
+      started[i] = (pthread_create(&threads[i],0,RooAbsTestStatisticMTWorker,_mtArray[i])==0) ;
+      if (!started[i]) {
+	_mtArray[i]->getVal() ;
+      }
+    }
+    _mtArray[_nCPU-1]->getVal() ;
+
+    for (i=0 ; i<_nCPU-1 ; i++) {
+      if (started[i]) {
+	pthread_join(threads[i],0) ;
+      }
+    }
+    delete[] started ;
+    delete[] threads ;
+
+  } else {
+#endif
+
+    for (i=0 ; i<_nCPU ; i++) {
+      _mtArray[i]->getVal() ;
+    }
+    _mtWarm = kTRUE ;
+
+#ifndef _WIN32
+  }
+#endif
+
+  return combinedValue((RooAbsReal**)_mtArray,_nCPU) ;
+}
+
+
+
+//_____________________________________________________________________________
+void RooAbsTestStatistic::setThreadedMode(Bool_t flag)
+{
+  // If flag is true, the partitions of the parallel calculation mode
+  // (nCPU>1) are calculated in threads of this process rather than in
+  // forked server processes. Each thread works on its own clone of the
+  // function and data, the parameters are shared. All functions in the
+  // expression must be safe to evaluate concurrently on separate clones.
+  // The mode must be chosen before the first evaluation of the test statistic.
+  // On Windows the partitions are calculated sequentially
+
+  if (_init) {
+    coutW(Eval) << "RooAbsTestStatistic::setThreadedMode(" << GetName() << ") WARNING: test statistic is already initialized, "
+		<< "parallel calculation mode can no longer be changed" << endl ;
+    return ;
+  }
+
+  _mtMode = flag ;
+  if (_gofOpMode==MPMaster || _gofOpMode==MTMaster) {
+    _gofOpMode = _mtMode ? MTMaster : MPMaster ;
+  }
+}
+
+
+
 //_____________________________________________________________________________
 void RooAbsTestStatistic::initSimMode(RooSimultaneous* simpdf, RooAbsData* data,
 				      const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName)
@@ -502,6 +710,7 @@ void RooAbsTestStatistic::initSimMode(RooSimultaneous* simpdf, RooAbsData* data,
 			      rangeName,addCoefRangeName,_nCPU,_mpinterl,_verbose,_splitRange) ;
       }
       _gofArray[n]->setSimCount(_nGof) ;
+      _gofArray[n]->setThreadedMode(_mtMode) ;
 
       // Servers may have been redirected between instantiation and (deferred) initialization
       RooArgSet* actualParams = pdf->getParameters(dset) ;
@@ -581,6 +790,17 @@ Bool_t RooAbsTestStatistic::setData(RooAbsData& indata, Bool_t cloneData)
     }
     break ;
     
+  case MTMaster:
+    // Forward to partitions. Each partition needs its own copy of the data
+    // as the observables of each function clone are attached to the dataset
+    for (Int_t i=0 ; i<_nCPU ; i++) {
+      _mtArray[i]->setData(indata,kTRUE) ;
+    }
+    setEventCount(indata.numEntries()) ;
+    _mtWarm = kFALSE ;
+    setValueDirty() ;
+    break ;
+
   case MPMaster:
     // Not supported
     coutF(DataHandling) << "RooAbsTestStatistic::setData(" << GetName() << ") FATAL: setData() is not supported in multi-processor mode" << endl ;
@@ -65,6 +65,7 @@
 #include "RooRecursiveFraction.h"
 #include "RooGlobalFunc.h"
 #include "RooRealIntegral.h"
+#include "RooBatchData.h"
 
 #include "Riostream.h"
 #include <algorithm>
@@ -843,6 +844,67 @@ Double_t RooAddPdf::evaluate() const
 }
 
 
+
+//_____________________________________________________________________________
+Bool_t RooAddPdf::evaluateBatch(Double_t* output, RooBatchData& batch) const 
+{
+  // Vectorized evaluate() for all events in batch. The component p.d.f.s
+  // are evaluated in batch mode and summed with the same coefficients as
+  // in evaluate(). If the coefficients or their projection integrals depend 
+  // on the observables of the data, events are evaluated one by one
+
+  const RooArgSet* nset = _normSet ; 
+
+  if (nset==0 || nset->getSize()==0) {
+    if (_refCoefNorm.getSize()!=0) {
+      nset = &_refCoefNorm ;
+    }
+  }
+
+  if (batch.dependsOnData(_coefList)) {
+    return kFALSE ;
+  }
+
+  CacheElem* cache = getProjCache(nset) ;
+  if (batch.dependsOnData(cache->_suppNormList) || batch.dependsOnData(cache->_projList) || 
+      batch.dependsOnData(cache->_suppProjList) || batch.dependsOnData(cache->_refRangeProjList) || 
+      batch.dependsOnData(cache->_rangeProjList)) {
+    return kFALSE ;
+  }
+
+  updateCoefficients(*cache,nset) ;
+  
+  Int_t n = batch.size() ;
+  Int_t j ;
+  for (j=0 ; j<n ; j++) {
+    output[j] = 0 ;
+  }
+
+  // Do running sum of coef/pdf pairs
+  RooAbsPdf* pdf ;
+  Int_t i(0) ;
+  RooFIter pi = _pdfList.fwdIterator() ;
+  while((pdf = (RooAbsPdf*)pi.next())) {
+    const Double_t* pdfVal = pdf->getValBatch(batch,nset) ;
+    if (pdf->isSelectedComp()) {
+      if (cache->_needSupNorm) {
+	Double_t snormVal = ((RooAbsReal*)cache->_suppNormList.at(i))->getVal() ;
+	for (j=0 ; j<n ; j++) {
+	  output[j] += pdfVal[j]*_coefCache[i]/snormVal ;
+	}
+      } else {
+	for (j=0 ; j<n ; j++) {
+	  output[j] += pdfVal[j]*_coefCache[i] ;
+	}
+      }
+    }
+    i++ ;
+  }
+
+  return kTRUE ;
+}
+
+
 //_____________________________________________________________________________
 void RooAddPdf::resetErrorCounters(Int_t resetValue)
 {
@@ -45,6 +45,9 @@
 #include <iomanip>
 #include <fstream>
 #include <list>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
 #include "TClass.h"
 #include "RooArgSet.h"
 #include "RooStreamParser.h"
@@ -78,6 +81,12 @@ struct POOLDATA
 
 static std::list<POOLDATA> _memPoolList ;
 
+#ifndef _WIN32
+// Protects the memory pool against concurrent allocations from the
+// worker threads of multi-threaded test statistics
+static pthread_mutex_t _memPoolMutex = PTHREAD_MUTEX_INITIALIZER ;
+#endif
+
 //_____________________________________________________________________________
 void RooArgSet::cleanup()
 {
@@ -106,6 +115,10 @@ void* RooArgSet::operator new (size_t bytes)
 
   //cout << " RooArgSet::operator new(" << bytes << ")" << endl ;
 
+#ifndef _WIN32
+  pthread_mutex_lock(&_memPoolMutex) ;
+#endif
+
   if (!_poolBegin || _poolCur+(sizeof(RooArgSet)) >= _poolEnd) {
 
     if (_poolBegin!=0) {
@@ -155,6 +168,10 @@ void* RooArgSet::operator new (size_t bytes)
   // Increment use counter of pool
   (*((Int_t*)_poolBegin))++ ;
 
+#ifndef _WIN32
+  pthread_mutex_unlock(&_memPoolMutex) ;
+#endif
+
   return ptr ;
 
 }
@@ -167,12 +184,18 @@ void RooArgSet::operator delete (void* ptr)
   // Memory is owned by pool, we need to do nothing to release it
 
   // Decrease use count in pool that ptr is on
+#ifndef _WIN32
+  pthread_mutex_lock(&_memPoolMutex) ;
+#endif
   for (std::list<POOLDATA>::iterator poolIter =  _memPoolList.begin() ; poolIter!=_memPoolList.end() ; ++poolIter) {
     if ((char*)ptr > (char*)poolIter->_base && (char*)ptr < (char*)poolIter->_base + POOLSIZE) {
       (*(Int_t*)(poolIter->_base))-- ;
       break ;
     }
   }
+#ifndef _WIN32
+  pthread_mutex_unlock(&_memPoolMutex) ;
+#endif
   
 }
 
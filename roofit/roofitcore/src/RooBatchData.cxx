@@ -0,0 +1,205 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ * @(#)root/roofitcore:$Id$
+ * Authors:                                                                  *
+ *   WV, Wouter Verkerke, UC Santa Barbara, verkerke@slac.stanford.edu       *
+ *   DK, David Kirkby,    UC Irvine,         dkirkby@uci.edu                 *
+ *                                                                           *
+ * Copyright (c) 2000-2005, Regents of the University of California          *
+ *                          and Stanford University. All rights reserved.    *
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// BEGIN_HTML
+// RooBatchData describes a contiguous range of events of a RooVectorDataStore
+// for the vectorized evaluation of a RooAbsReal expression tree through
+// RooAbsReal::getValBatch(). It provides direct access to the stored columns
+// of the observables and of the nodes that were precalculated in the cache
+// of the data store by the constant term optimizer, it tells which nodes
+// depend on the observables and it manages the output buffers of the
+// intermediate nodes of the expression tree. Output buffers remain valid
+// until the next call to setRange().
+// END_HTML
+//
+
+#include "RooFit.h"
+
+#include "RooBatchData.h"
+#include "RooVectorDataStore.h"
+#include "RooAbsCollection.h"
+#include "RooArgSet.h"
+#include "RooAbsArg.h"
+#include "RooRealVar.h"
+
+using namespace std ;
+
+ClassImp(RooBatchData)
+;
+
+
+
+//_____________________________________________________________________________
+RooBatchData::RooBatchData(const RooVectorDataStore& store) :
+  _store(&store), _first(0), _size(0), _nextBuffer(0)
+{
+  // Constructor for batches of events from given data store. The
+  // cache of the data store is included if present
+
+  addColumns(store) ;
+  if (store._cache) {
+    addColumns(*store._cache) ;
+  }
+}
+
+
+
+//_____________________________________________________________________________
+RooBatchData::~RooBatchData()
+{
+  // Destructor
+
+  vector<vector<Double_t>*>::iterator iter = _buffers.begin() ;
+  for (; iter!=_buffers.end() ; ++iter) {
+    delete *iter ;
+  }
+}
+
+
+
+//_____________________________________________________________________________
+void RooBatchData::addColumns(const RooVectorDataStore& store)
+{
+  // Register the stored columns of all real-valued elements of given store
+
+  vector<RooVectorDataStore::RealVector*>::const_iterator iter = store._realStoreList.begin() ;
+  for (; iter!=store._realStoreList.end() ; ++iter) {
+    _columns[(*iter)->bufArg()->namePtr()] = (*iter)->data() ;
+  }
+
+  vector<RooVectorDataStore::RealFullVector*>::const_iterator fiter = store._realfStoreList.begin() ;
+  for (; fiter!=store._realfStoreList.end() ; ++fiter) {
+    _columns[(*fiter)->bufArg()->namePtr()] = (*fiter)->data() ;
+  }
+}
+
+
+
+//_____________________________________________________________________________
+void RooBatchData::setRange(Int_t firstEvent, Int_t nEvents)
+{
+  // Select the range of events [firstEvent,firstEvent+nEvents) as the
+  // current batch. All buffers handed out by makeBuffer() are recycled
+
+  _first = firstEvent ;
+  _nextBuffer = 0 ;
+
+  if (nEvents>_size) {
+    vector<vector<Double_t>*>::iterator iter = _buffers.begin() ;
+    for (; iter!=_buffers.end() ; ++iter) {
+      (*iter)->resize(nEvents) ;
+    }
+  }
+  _size = nEvents ;
+}
+
+
+
+//_____________________________________________________________________________
+const Double_t* RooBatchData::column(const RooAbsArg& arg) const
+{
+  // Return pointer to the values of 'arg' for the events of the current
+  // batch if these are stored in the data store or in its cache. Columns
+  // are matched by name. If 'arg' is not stored a null pointer is returned
+
+  map<const TNamed*,const Double_t*>::const_iterator iter = _columns.find(arg.namePtr()) ;
+  if (iter==_columns.end() || iter->second==0) {
+    return 0 ;
+  }
+  return iter->second + _first ;
+}
+
+
+
+//_____________________________________________________________________________
+const Double_t* RooBatchData::weights() const
+{
+  // Return pointer to the event weights of the current batch. A null
+  // pointer is returned for unweighted data, for which all weights are one
+
+  if (_store->_extWgtArray) {
+    return _store->_extWgtArray + _first ;
+  }
+  if (_store->_wgtVar) {
+    return column(*_store->_wgtVar) ;
+  }
+  return 0 ;
+}
+
+
+
+//_____________________________________________________________________________
+Bool_t RooBatchData::dependsOnData(const RooAbsArg& arg)
+{
+  // Return true if the value of 'arg' depends on any of the observables
+  // of the data store. The result is cached for the lifetime of this object
+
+  map<const RooAbsArg*,Bool_t>::iterator iter = _dependsOnData.find(&arg) ;
+  if (iter!=_dependsOnData.end()) {
+    return iter->second ;
+  }
+
+  Bool_t ret = arg.dependsOnValue(*_store->get()) ;
+  _dependsOnData[&arg] = ret ;
+  return ret ;
+}
+
+
+
+//_____________________________________________________________________________
+Bool_t RooBatchData::dependsOnData(const RooAbsCollection& list)
+{
+  // Return true if the value of any element of 'list' depends on any of
+  // the observables of the data store
+
+  RooFIter iter = list.fwdIterator() ;
+  RooAbsArg* arg ;
+  while((arg=iter.next())) {
+    if (dependsOnData(*arg)) {
+      return kTRUE ;
+    }
+  }
+  return kFALSE ;
+}
+
+
+
+//_____________________________________________________________________________
+void RooBatchData::loadEvent(Int_t i) const
+{
+  // Load event 'i' of the current batch into the observables (and cached
+  // nodes) of the data store. Used for event-by-event evaluation of nodes
+  // that do not implement a vectorized calculation
+
+  _store->get(_first+i) ;
+}
+
+
+
+//_____________________________________________________________________________
+Double_t* RooBatchData::makeBuffer()
+{
+  // Return an output buffer with room for the events of the current batch.
+  // The buffer is owned by this object and can be reused after the next
+  // call to setRange()
+
+  if (_nextBuffer==_buffers.size()) {
+    _buffers.push_back(new vector<Double_t>(_size)) ;
+  }
+  return &_buffers[_nextBuffer++]->front() ;
+}
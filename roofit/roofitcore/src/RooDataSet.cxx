@@ -28,6 +28,9 @@
 #include "Riostream.h"
 #include "Riostream.h"
 #include <fstream>
+#ifndef _WIN32
+#include <pthread.h>
+#endif
 #include "TTree.h"
 #include "TH2.h"
 #include "TDirectory.h"
@@ -74,6 +77,12 @@ struct POOLDATA
 
 static std::list<POOLDATA> _memPoolList ;
 
+#ifndef _WIN32
+// Protects the memory pool against concurrent allocations from the
+// worker threads of multi-threaded test statistics
+static pthread_mutex_t _memPoolMutex = PTHREAD_MUTEX_INITIALIZER ;
+#endif
+
 //_____________________________________________________________________________
 void RooDataSet::cleanup()
 {
@@ -102,6 +111,10 @@ void* RooDataSet::operator new (size_t bytes)
 
   //cout << " RooDataSet::operator new(" << bytes << ")" << endl ;
 
+#ifndef _WIN32
+  pthread_mutex_lock(&_memPoolMutex) ;
+#endif
+
   if (!_poolBegin || _poolCur+(sizeof(RooDataSet)) >= _poolEnd) {
 
     if (_poolBegin!=0) {
@@ -151,6 +164,10 @@ void* RooDataSet::operator new (size_t bytes)
   // Increment use counter of pool
   (*((Int_t*)_poolBegin))++ ;
 
+#ifndef _WIN32
+  pthread_mutex_unlock(&_memPoolMutex) ;
+#endif
+
   return ptr ;
 
 }
@@ -163,12 +180,18 @@ void RooDataSet::operator delete (void* ptr)
   // Memory is owned by pool, we need to do nothing to release it
 
   // Decrease use count in pool that ptr is on
+#ifndef _WIN32
+  pthread_mutex_lock(&_memPoolMutex) ;
+#endif
   for (std::list<POOLDATA>::iterator poolIter =  _memPoolList.begin() ; poolIter!=_memPoolList.end() ; ++poolIter) {
     if ((char*)ptr > (char*)poolIter->_base && (char*)ptr < (char*)poolIter->_base + POOLSIZE) {
       (*(Int_t*)(poolIter->_base))-- ;
       break ;
     }
   }
+#ifndef _WIN32
+  pthread_mutex_unlock(&_memPoolMutex) ;
+#endif
   
 }
 
@@ -33,6 +33,7 @@
 #include "RooLinkedListIter.h"
 #include "RooHashTable.h"
 #include "RooAbsArg.h"
+#include "RooNameReg.h"
 #include "RooMsgService.h"
 
 
@@ -46,7 +47,8 @@ ClassImp(RooLinkedList)
 
 //_____________________________________________________________________________
 RooLinkedList::RooLinkedList(Int_t htsize) : 
-  _hashThresh(htsize), _size(0), _first(0), _last(0), _htableName(0), _htableLink(0), _curStoreSize(2), _curStoreUsed(0)
+  _hashThresh(htsize), _size(0), _first(0), _last(0), _htableName(0), _htableLink(0), _htableRenameCount(RooNameReg::renameCounter()),
+  _curStoreSize(2), _curStoreUsed(0)
 {
   _curStore = new RooLinkedListElem[_curStoreSize] ;
   _storeList.push_back(pair<Int_t,RooLinkedListElem*>(0,_curStore)) ;
@@ -58,7 +60,7 @@ RooLinkedList::RooLinkedList(Int_t htsize) :
 //_____________________________________________________________________________
 RooLinkedList::RooLinkedList(const RooLinkedList& other) :
   TObject(other), _hashThresh(other._hashThresh), _size(0), _first(0), _last(0), _htableName(0), _htableLink(0), 
-  _curStoreSize(2), _curStoreUsed(0), _name(other._name)
+  _htableRenameCount(RooNameReg::renameCounter()), _curStoreSize(2), _curStoreUsed(0), _name(other._name)
 {
   // Copy constructor
   
@@ -171,6 +173,7 @@ void RooLinkedList::setHashTableSize(Int_t size)
     // (Re)create hash tables
     if (_htableName) delete _htableName ;
     _htableName = new RooHashTable(size) ;
+    _htableRenameCount = RooNameReg::renameCounter() ;
 
      if (_htableLink) delete _htableLink ;
      _htableLink = new RooHashTable(size,RooHashTable::Pointer) ;
@@ -288,9 +291,11 @@ Bool_t RooLinkedList::Remove(TObject* arg)
   RooLinkedListElem* elem = findLink(arg) ;
   if (!elem) return kFALSE ;
   
-  // Remove from hash table
+  // Remove from hash table. If the object is not found in the name hash table
+  // it was renamed after insertion and the table must be rebuilt
+  Bool_t rebuild(kFALSE) ;
   if (_htableName) {
-    _htableName->remove(arg) ;
+    rebuild = !_htableName->remove(arg) ;
   }
   if (_htableLink) {
     _htableLink->remove((TObject*)elem,arg) ;
@@ -303,6 +308,10 @@ Bool_t RooLinkedList::Remove(TObject* arg)
   // Delete and shrink
   _size-- ;
   deleteElement(elem) ;	
+
+  if (rebuild) {
+    setHashTableSize(_htableName->size()) ;
+  }
   return kTRUE ;
 }
 
@@ -340,8 +349,17 @@ Bool_t RooLinkedList::Replace(const TObject* oldArg, const TObject* newArg)
   RooLinkedListElem* elem = findLink(oldArg) ;
   if (!elem) return kFALSE ;
   
+  // Replace in name hash table. If the names differ the new object belongs in 
+  // a different slot. If the old object is not found it was renamed after
+  // insertion and the table must be rebuilt
+  Bool_t rebuild(kFALSE) ;
   if (_htableName) {
-    _htableName->replace(oldArg,newArg) ;
+    if (strcmp(oldArg->GetName(),newArg->GetName())) {
+      rebuild = !_htableName->remove((TObject*)oldArg) ;
+      _htableName->add((TObject*)newArg) ;
+    } else {
+      rebuild = !_htableName->replace(oldArg,newArg) ;
+    }
   }
   if (_htableLink) {
     // Link is hashed by contents and may change slot in hash table
@@ -350,6 +368,10 @@ Bool_t RooLinkedList::Replace(const TObject* oldArg, const TObject* newArg)
   }
 
   elem->_arg = (TObject*)newArg ;
+
+  if (rebuild) {
+    setHashTableSize(_htableName->size()) ;
+  }
   return kTRUE ;
 }
 
@@ -446,7 +468,15 @@ TObject* RooLinkedList::find(const char* name) const
   // Return pointer to object with given name in collection.
   // If no such object is found, return null pointer.
 
-  if (_htableName) return _htableName->find(name) ;
+  if (_htableName) {
+    TObject* ret = _htableName->find(name) ;
+    if (ret || _htableRenameCount==RooNameReg::renameCounter()) {
+      return ret ;
+    }
+    // Objects may have been renamed after insertion, rebuild table and try again
+    ((RooLinkedList*)this)->setHashTableSize(_htableName->size()) ;
+    return _htableName->find(name) ;
+  }
 
   RooLinkedListElem* ptr = _first ;
   while(ptr) {
@@ -467,7 +497,13 @@ RooAbsArg* RooLinkedList::findArg(const RooAbsArg* arg) const
   // If no such object is found, return null pointer.
 
   if (_htableName) {
-    return (RooAbsArg*) _htableName->findArg(arg) ;
+    RooAbsArg* ret = _htableName->findArg(arg) ;
+    if (ret || _htableRenameCount==RooNameReg::renameCounter()) {
+      return ret ;
+    }
+    // Objects may have been renamed after insertion, rebuild table and try again
+    ((RooLinkedList*)this)->setHashTableSize(_htableName->size()) ;
+    return _htableName->findArg(arg) ;
   }
 
   RooLinkedListElem* ptr = _first ;
@@ -40,6 +40,11 @@
 
 #include <math.h>
 #include <assert.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
 
 
 
@@ -77,12 +82,13 @@ void RooMCIntegrator::registerIntegrator(RooNumIntFactory& fact)
   RooRealVar nRefineIter("nRefineIter","Number of refining iterations",5) ;
   RooRealVar nRefinePerDim("nRefinePerDim","Number of refining samples (per dimension)",1000) ;
   RooRealVar nIntPerDim("nIntPerDim","Number of integration samples (per dimension)",5000) ;
+  RooRealVar nThreads("nThreads","Number of threads for integrand evaluation",1) ;
   
   // Create prototype integrator
   RooMCIntegrator* proto = new RooMCIntegrator() ;
 
   // Register prototype and default config with factory
-  fact.storeProtoIntegrator(proto,RooArgSet(samplingMode,genType,verbose,alpha,nRefineIter,nRefinePerDim,nIntPerDim)) ;
+  fact.storeProtoIntegrator(proto,RooArgSet(samplingMode,genType,verbose,alpha,nRefineIter,nRefinePerDim,nIntPerDim,nThreads)) ;
 
   // Make this method the default for all N>2-dim integrals
   RooNumIntConfig::defaultConfig().methodND().setLabel(proto->IsA()->GetName()) ;
@@ -105,7 +111,7 @@ RooMCIntegrator::RooMCIntegrator(const RooAbsFunc& function, SamplingMode mode,
 				 GeneratorType genType, Bool_t verbose) :
   RooAbsIntegrator(function), _grid(function), _verbose(verbose),
   _alpha(1.5),  _mode(mode), _genType(genType),
-  _nRefineIter(5),_nRefinePerDim(1000),_nIntegratePerDim(5000)
+  _nRefineIter(5),_nRefinePerDim(1000),_nIntegratePerDim(5000),_nThreads(1)
 {
   // Construct an integrator over 'function' with given sampling mode
   // and generator type.  The sampling mode can be 'Importance'
@@ -135,6 +141,7 @@ RooMCIntegrator::RooMCIntegrator(const RooAbsFunc& function, const RooNumIntConf
   _nRefineIter = (Int_t) configSet.getRealValue("nRefineIter",5) ;
   _nRefinePerDim = (Int_t) configSet.getRealValue("nRefinePerDim",1000) ;
   _nIntegratePerDim = (Int_t) configSet.getRealValue("nIntPerDim",5000) ;
+  _nThreads = (Int_t) configSet.getRealValue("nThreads",1) ;
 
   // check that our grid initialized without errors
   if(!(_valid= _grid.isValid())) return;
@@ -158,6 +165,10 @@ RooAbsIntegrator* RooMCIntegrator::clone(const RooAbsFunc& function, const RooNu
 RooMCIntegrator::~RooMCIntegrator() 
 {
   // Destructor
+
+  for (UInt_t i=0 ; i<_threadFuncs.size() ; i++) {
+    delete _threadFuncs[i] ;
+  }
 }
 
 
@@ -264,6 +275,12 @@ Double_t RooMCIntegrator::vegas(Stage stage, UInt_t calls, UInt_t iterations, Do
   UInt_t *bin= _grid.createIndexVector();
   Double_t *x= _grid.createPoint();
 
+  // evaluate the integrand in parallel threads if requested and supported by the integrand
+  Bool_t parallel = (_nThreads>1 && initThreadFuncs()) ;
+  UInt_t dim(_grid.getDimension());
+  vector<Double_t> xAll, volAll, fvalAll ;
+  vector<UInt_t> binAll ;
+
   // loop over iterations for this step
   Double_t cum_int(0),cum_sig(0);
   _it_start = _it_num;
@@ -276,17 +293,44 @@ Double_t RooMCIntegrator::vegas(Stage stage, UInt_t calls, UInt_t iterations, Do
     // reset the values associated with each grid cell
     _grid.resetValues();
 
+    if (parallel) {
+      // generate all points of this iteration up front, in the same order
+      // as in the sequential case, and evaluate them in parallel
+      xAll.clear() ; binAll.clear() ; volAll.clear() ;
+      _grid.firstBox(box);
+      do {
+	for(UInt_t k = 0; k < _calls_per_box; k++) {
+	  Double_t bin_vol(0);
+	  _grid.generatePoint(box, x, bin, bin_vol, _genType == QuasiRandom ? kTRUE : kFALSE);
+	  xAll.insert(xAll.end(),x,x+dim) ;
+	  binAll.insert(binAll.end(),bin,bin+dim) ;
+	  volAll.push_back(bin_vol) ;
+	}
+      } while(_grid.nextBox(box));
+      fvalAll.resize(volAll.size()) ;
+      evaluateParallel(xAll,fvalAll) ;
+    }
+    UInt_t ipt(0) ;
+
     // loop over grid boxes
     _grid.firstBox(box);
     do {
       Double_t m(0),q(0);
       // loop over integrand evaluations within this grid box
       for(UInt_t k = 0; k < _calls_per_box; k++) {
-	// generate a random point in this box
-	Double_t bin_vol(0);
-	_grid.generatePoint(box, x, bin, bin_vol, _genType == QuasiRandom ? kTRUE : kFALSE);
-	// evaluate the integrand at the generated point
-	Double_t fval= jacbin*bin_vol*integrand(x);	
+	Double_t fval(0) ;
+	if (parallel) {
+	  // retrieve point and integrand value calculated in parallel
+	  memcpy(bin,&binAll[ipt*dim],dim*sizeof(UInt_t)) ;
+	  fval= jacbin*volAll[ipt]*fvalAll[ipt] ;
+	  ipt++ ;
+	} else {
+	  // generate a random point in this box
+	  Double_t bin_vol(0);
+	  _grid.generatePoint(box, x, bin, bin_vol, _genType == QuasiRandom ? kTRUE : kFALSE);
+	  // evaluate the integrand at the generated point
+	  fval= jacbin*bin_vol*integrand(x);	
+	}
 	// update mean and variance calculations
 	Double_t d = fval - m;
 	m+= d / (k + 1.0);
@@ -363,3 +407,122 @@ Double_t RooMCIntegrator::vegas(Stage stage, UInt_t calls, UInt_t iterations, Do
   if(absError) *absError = cum_sig;
   return cum_int;
 }
+
+
+
+#ifndef _WIN32
+namespace {
+
+  struct RooMCIntegratorTask {
+    const RooAbsFunc* func ;  // Integrand binding used by this thread
+    const Double_t* x ;       // Coordinates of all points
+    Double_t* fval ;          // Integrand values of all points
+    UInt_t dim ;              // Dimension of points
+    UInt_t first ;            // First point calculated by this thread
+    UInt_t last ;             // Last point (exclusive) calculated by this thread
+  } ;
+
+  //_____________________________________________________________________________
+  void* RooMCIntegratorWorker(void* arg)
+  {
+    // Entry point of worker threads for parallel integrand evaluation
+
+    RooMCIntegratorTask* task = (RooMCIntegratorTask*) arg ;
+    for (UInt_t i=task->first ; i<task->last ; i++) {
+      task->fval[i] = (*task->func)(task->x + i*task->dim) ;
+    }
+    return 0 ;
+  }
+
+}
+#endif
+
+
+
+//_____________________________________________________________________________
+Bool_t RooMCIntegrator::initThreadFuncs() 
+{
+  // Create the copies of the integrand that are evaluated in the worker
+  // threads, if not done yet. Each copy is evaluated once, sequentially,
+  // so that all objects that are created on demand exist before the threads
+  // are started. Returns false if the integrand does not support copies
+  // for concurrent evaluation, in which case the integrand is evaluated sequentially
+
+#ifdef _WIN32
+  return kFALSE ;
+#else
+  if (_threadFuncs.size()>0) {
+    return kTRUE ;
+  }
+
+  Double_t* x = _grid.createPoint() ;
+  for (UInt_t i=0 ; i<_grid.getDimension() ; i++) {
+    x[i] = 0.5*(integrand()->getMinLimit(i)+integrand()->getMaxLimit(i)) ;
+  }
+  for (Int_t i=0 ; i<_nThreads-1 ; i++) {
+    RooAbsFunc* func = integrand()->cloneTree() ;
+    if (!func) {
+      oocoutW((TObject*)0,Integration) << "RooMCIntegrator: integrand " << integrand()->getName() 
+				       << " does not support concurrent evaluation, integrating sequentially" << endl ;
+      for (UInt_t j=0 ; j<_threadFuncs.size() ; j++) {
+	delete _threadFuncs[j] ;
+      }
+      _threadFuncs.clear() ;
+      _nThreads = 1 ;
+      delete[] x ;
+      return kFALSE ;
+    }
+    (*func)(x) ;
+    _threadFuncs.push_back(func) ;
+  }
+  delete[] x ;
+
+  oocxcoutD((TObject*)0,Integration) << "RooMCIntegrator: evaluating integrand in " << _nThreads << " threads" << endl ;
+  return kTRUE ;
+#endif
+}
+
+
+
+//_____________________________________________________________________________
+void RooMCIntegrator::evaluateParallel(const vector<Double_t>& x, vector<Double_t>& fval) 
+{
+  // Evaluate the integrand at all points in 'x' and store the values in 'fval'.
+  // The points are split in contiguous blocks, of which all but the last are
+  // calculated in worker threads on copies of the integrand. The last block
+  // is calculated in the calling thread on the integrand itself
+
+  UInt_t n = fval.size() ;
+  UInt_t dim = _grid.getDimension() ;
+
+#ifndef _WIN32
+  UInt_t nThreads = _threadFuncs.size()+1 ;
+  vector<RooMCIntegratorTask> tasks(nThreads) ;
+  vector<pthread_t> threads(nThreads) ;
+  vector<Bool_t> started(nThreads,kFALSE) ;
+  for (UInt_t i=0 ; i<nThreads ; i++) {
+    tasks[i].func = (i<nThreads-1) ? _threadFuncs[i] : integrand() ;
+    tasks[i].x = &x[0] ;
+    tasks[i].fval = &fval[0] ;
+    tasks[i].dim = dim ;
+    tasks[i].first = (UInt_t)((ULong64_t)n*i/nThreads) ;
+    tasks[i].last = (UInt_t)((ULong64_t)n*(i+1)/nThreads) ;
+  }
+  for (UInt_t i=0 ; i<nThreads-1 ; i++) {
+    started[i] = (pthread_create(&threads[i],0,RooMCIntegratorWorker,&tasks[i])==0) ;
+    if (!started[i]) {
+      RooMCIntegratorWorker(&tasks[i]) ;
+    }
+  }
+  RooMCIntegratorWorker(&tasks[nThreads-1]) ;
+  for (UInt_t i=0 ; i<nThreads-1 ; i++) {
+    if (started[i]) {
+      pthread_join(threads[i],0) ;
+    }
+  }
+#else
+  for (UInt_t i=0 ; i<n ; i++) {
+    fval[i] = integrand(&x[i*dim]) ;
+  }
+#endif
+}
@@ -68,6 +68,7 @@
 #include "RooPlot.h"
 
 
+#include "RooAbsTestStatistic.h"
 #include "RooMinimizer.h"
 #include "RooFitResult.h"
 
@@ -744,6 +745,36 @@ void RooMinimizer::profileStop()
     _cumulTimer.Stop() ;
     coutI(Minimization) << "Command timer: " ; _timer.Print() ;
     coutI(Minimization) << "Session timer: " ; _cumulTimer.Print() ;
+    printCacheStatistics(ccoutI(Minimization)) ;
+  }
+}
+
+
+
+//_____________________________________________________________________________
+void RooMinimizer::printCacheStatistics(ostream& os) const
+{
+  // Print the average number of floating parameters that changed between
+  // successive function evaluations and, for all test statistics in the
+  // minimized function, how often the cached columns of components in
+  // cache-and-track mode (optimizeConst(2)) were recalculated or reused
+
+  Int_t nEval = _fcn->GetNumEvaluations() ;
+  os << "RooMinimizer: " << nEval << " function evaluations" ;
+  if (nEval>0) {
+    os << ", on average " << Double_t(_fcn->GetNumParChanges())/nEval << " of " << getNPar() << " floating parameters changed per evaluation" ;
+  }
+  os << endl ;
+
+  RooArgSet branches ;
+  _func->branchNodeServerList(&branches) ;
+  RooFIter iter = branches.fwdIterator() ;
+  RooAbsArg* arg ;
+  while((arg=iter.next())) {
+    RooAbsTestStatistic* stat = dynamic_cast<RooAbsTestStatistic*>(arg) ;
+    if (stat) {
+      stat->printCacheStatistics(os,"  ") ;
+    }
   }
 }
 
@@ -46,6 +46,7 @@ RooMinimizerFcn::RooMinimizerFcn(RooAbsReal *funct, RooMinimizer* context,
   // Reset the *largest* negative log-likelihood value we have seen so far
   _maxFCN(-1e30), _numBadNLL(0),  
   _printEvalErrors(10), _doEvalErrorWall(kTRUE),
+  _numEval(0), _numParChanges(0),
   _nDim(0), _logfile(0),
   _verbose(verbose)
 { 
@@ -492,11 +493,13 @@ void RooMinimizerFcn::updateFloatVec()
 double RooMinimizerFcn::DoEval(const double *x) const 
 {
 
-  // Set the parameter values for this iteration
+  // Set the parameter values for this iteration, counting the parameters
+  // that actually changed since the previous call
   for (int index = 0; index < _nDim; index++) {
     if (_logfile) (*_logfile) << x[index] << " " ;
-    SetPdfParamVal(index,x[index]);
+    if (SetPdfParamVal(index,x[index])) _numParChanges++;
   }
+  _numEval++;
 
   // Calculate the function for these parameters
   double fvalue = _funct->getVal();
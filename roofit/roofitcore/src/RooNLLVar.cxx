@@ -38,6 +38,10 @@
 #include "RooRealMPFE.h"
 
 #include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooVectorDataStore.h"
+#include "RooBatchData.h"
+#include "TMath.h"
 
 
 using namespace std;
@@ -74,16 +78,19 @@ RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbs
   //  ConditionalObservables() -- Define conditional observables 
   //  Verbose()      -- Verbose output of GOF framework classes
   //  CloneData()    -- Clone input dataset for internal use (default is kTRUE)
+  //  BatchMode()    -- Evaluate p.d.f. in batches of events (default is kFALSE)
 
   RooCmdConfig pc("RooNLLVar::RooNLLVar") ;
   pc.allowUndefined() ;
   pc.defineInt("extended","Extended",0,kFALSE) ;
+  pc.defineInt("batchMode","BatchMode",0,kFALSE) ;
 
   pc.process(arg1) ;  pc.process(arg2) ;  pc.process(arg3) ;
   pc.process(arg4) ;  pc.process(arg5) ;  pc.process(arg6) ;
   pc.process(arg7) ;  pc.process(arg8) ;  pc.process(arg9) ;
 
   _extended = pc.getInt("extended") ;
+  _batchMode = pc.getInt("batchMode") ;
   _weightSq = kFALSE ;
   _first = kTRUE ;
 
@@ -98,6 +105,7 @@ RooNLLVar::RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbs
   RooAbsOptTestStatistic(name,title,pdf,indata,RooArgSet(),rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData),
   _extended(extended),
   _weightSq(kFALSE),
+  _batchMode(kFALSE),
   _first(kTRUE)
 {
   // Construct likelihood from given p.d.f and (binned or unbinned dataset)
@@ -114,6 +122,7 @@ RooNLLVar::RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbs
   RooAbsOptTestStatistic(name,title,pdf,indata,projDeps,rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData),
   _extended(extended),
   _weightSq(kFALSE),
+  _batchMode(kFALSE),
   _first(kTRUE)
 {
   // Construct likelihood from given p.d.f and (binned or unbinned dataset)
@@ -129,6 +138,7 @@ RooNLLVar::RooNLLVar(const RooNLLVar& other, const char* name) :
   RooAbsOptTestStatistic(other,name),
   _extended(other._extended),
   _weightSq(other._weightSq),
+  _batchMode(other._batchMode),
   _first(kTRUE)
 {
   // Copy constructor
@@ -159,6 +169,12 @@ void RooNLLVar::applyWeightSquared(Bool_t flag)
       _mpfeArray[i]->applyNLLWeightSquared(flag) ;
     }    
 
+  } else if ( _gofOpMode==MTMaster) {
+
+    for (Int_t i=0 ; i<_nCPU ; i++) {
+      ((RooNLLVar*)_mtArray[i])->applyWeightSquared(flag) ;
+    }
+
   } else if ( _gofOpMode==SimMaster) {
 
     for (Int_t i=0 ; i<_nGof ; i++) {
@@ -170,6 +186,33 @@ void RooNLLVar::applyWeightSquared(Bool_t flag)
 
 
 
+//_____________________________________________________________________________
+void RooNLLVar::setBatchMode(Bool_t flag) 
+{ 
+  // If flag is true, the p.d.f. is evaluated in batches of events for
+  // unbinned datasets with vector storage, see evaluatePartitionBatch().
+  // In multi-process mode the setting only reaches the server processes
+  // if it is made before the first evaluation of the likelihood
+
+  _batchMode = flag ;
+
+  if (_gofOpMode==SimMaster && _init) {
+    for (Int_t i=0 ; i<_nGof ; i++) {
+      ((RooNLLVar*)_gofArray[i])->setBatchMode(flag) ;
+    }
+  }
+
+  if (_gofOpMode==MTMaster && _init) {
+    for (Int_t i=0 ; i<_nCPU ; i++) {
+      ((RooNLLVar*)_mtArray[i])->setBatchMode(flag) ;
+    }
+  }
+
+  setValueDirty() ;
+} 
+
+
+
 //_____________________________________________________________________________
 Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t stepSize) const 
 {
@@ -188,32 +231,39 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
   _dataClone->store()->recalculateCache( _projDeps, firstEvent, lastEvent, stepSize ) ;
 
   Double_t sumWeight(0) ;
-  for (i=firstEvent ; i<lastEvent ; i+=stepSize) {
+
+  // Contiguous partitions of unbinned datasets with vector storage can be evaluated in batch mode
+  if (_batchMode && stepSize==1 && dynamic_cast<RooDataSet*>(_dataClone) && dynamic_cast<RooVectorDataStore*>(_dataClone->store())) {
+    result = evaluatePartitionBatch(firstEvent,lastEvent,sumWeight) ;
+  } else {
+
+    for (i=firstEvent ; i<lastEvent ; i+=stepSize) {
     
-    // get the data values for this event
-    //Double_t wgt = _dataClone->weight(i) ;
-    //if (wgt==0) continue ;
+      // get the data values for this event
+      //Double_t wgt = _dataClone->weight(i) ;
+      //if (wgt==0) continue ;
 
-    _dataClone->get(i) ;
-    //cout << "NLL - now loading event #" << i << endl ;
+      _dataClone->get(i) ;
+      //cout << "NLL - now loading event #" << i << endl ;
 //     _funcObsSet->Print("v") ;
     
 
-    if (!_dataClone->valid()) {
-      continue ;
-    }
+      if (!_dataClone->valid()) {
+        continue ;
+      }
 
-    if (_dataClone->weight()==0) continue ;
+      if (_dataClone->weight()==0) continue ;
 
 
-    Double_t eventWeight = _dataClone->weight() ;
-    if (_weightSq) eventWeight *= eventWeight ;
+      Double_t eventWeight = _dataClone->weight() ;
+      if (_weightSq) eventWeight *= eventWeight ;
 
-    Double_t term = eventWeight * pdfClone->getLogVal(_normSet);
+      Double_t term = eventWeight * pdfClone->getLogVal(_normSet);
 //     cout << "term[" << i << "] = " << term << endl ;
-    sumWeight += eventWeight ;
+      sumWeight += eventWeight ;
 
-    result-= term;
+      result-= term;
+    }
   }
   
   // include the extended maximum likelihood term, if requested
@@ -256,3 +306,48 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
 
 
 
+//_____________________________________________________________________________
+Double_t RooNLLVar::evaluatePartitionBatch(Int_t firstEvent, Int_t lastEvent, Double_t& sumWeight) const 
+{
+  // Calculate and return the sum of the weighted -log(p) terms of events
+  // firstEvent to lastEvent and add the sum of the event weights to 'sumWeight'.
+  // The p.d.f. is evaluated with RooAbsPdf::getLogValBatch() on batches of
+  // consecutive events, which reads the observables and precalculated cache
+  // elements directly from the columns of the data store. Components that do 
+  // not provide a vectorized evaluation are evaluated event by event. Terms 
+  // are accumulated in the same order as in evaluatePartition()
+
+  const Int_t batchSize(1024) ;
+
+  RooAbsPdf* pdfClone = (RooAbsPdf*) _funcClone ;
+  RooBatchData batch(*(RooVectorDataStore*)_dataClone->store()) ;
+  std::vector<Double_t> logVal(batchSize) ;
+
+  lastEvent = TMath::Min(lastEvent,_dataClone->numEntries()) ;
+
+  Double_t result(0) ;
+  for (Int_t first=firstEvent ; first<lastEvent ; first+=batchSize) {
+
+    Int_t n = TMath::Min(batchSize,lastEvent-first) ;
+    batch.setRange(first,n) ;
+    pdfClone->getLogValBatch(&logVal[0],batch,_normSet) ;
+
+    const Double_t* wgt = batch.weights() ;
+    for (Int_t i=0 ; i<n ; i++) {
+
+      Double_t eventWeight = wgt ? wgt[i] : 1.0 ;
+      if (eventWeight==0) continue ;
+      if (_weightSq) eventWeight *= eventWeight ;
+
+      Double_t term = eventWeight * logVal[i] ;
+      sumWeight += eventWeight ;
+
+      result-= term;
+    }
+  }
+
+  return result ;
+}
+
+
+
@@ -29,6 +29,7 @@
 
 #include "RooNameReg.h"
 #include "RooNameReg.h"
+#include "TIterator.h"
 #include <iostream>
 using namespace std ;
 
@@ -36,6 +37,7 @@ ClassImp(RooNameReg)
 ;
 
 RooNameReg* RooNameReg::_instance = 0 ;
+Int_t RooNameReg::_renameCounter = 0 ;
 
 
 
@@ -44,12 +46,13 @@ RooNameReg::~RooNameReg()
 {
   // Destructor
 
+  delete _htable ;
   _list.Delete() ;
 }
 
 
 //_____________________________________________________________________________
-RooNameReg::RooNameReg(const RooNameReg& other) : TNamed(other)
+RooNameReg::RooNameReg(const RooNameReg& other) : TNamed(other), _htable(new RooHashTable(31))
 {
   // Copy constructor
 }
@@ -92,12 +95,25 @@ const TNamed* RooNameReg::constPtr(const char* inStr)
 //   cout << "RooNameReg::constPtr(inStr=" << inStr << ") _htable entries = " << _htable.entries() << endl ;
 
   // See if name is already registered ;
-  TNamed* t = (TNamed*) _htable.find(inStr) ;
+  TNamed* t = (TNamed*) _htable->find(inStr) ;
   if (t) return t ;
 
+  // Grow hash table if number of registered names exceeds number of slots 
+  if (_htable->entries() >= _htable->size()) {
+    RooHashTable* htable = new RooHashTable(2*_htable->size()) ;
+    TIterator* iter = _list.MakeIterator() ;
+    TObject* obj ;
+    while((obj=iter->Next())) {
+      htable->add(obj) ;
+    }
+    delete iter ;
+    delete _htable ;
+    _htable = htable ;
+  }
+
   // If not, register now
   t = new TNamed(inStr,inStr) ;
-  _htable.add(t) ;
+  _htable->add(t) ;
   _list.Add(t) ;
   
   return t ;
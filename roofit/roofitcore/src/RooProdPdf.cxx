@@ -62,6 +62,7 @@
 #include "RooRangeBoolean.h"
 #include "RooCustomizer.h"
 #include "RooRealIntegral.h"
+#include "RooBatchData.h"
 
 #include <string.h>
 #include <sstream>
@@ -533,6 +534,72 @@ Double_t RooProdPdf::evaluate() const
 
 
 
+//_____________________________________________________________________________
+void RooProdPdf::computeBatch(Double_t* output, RooBatchData& batch, const RooArgSet* set) const 
+{
+  // Overload computeBatch() to intercept normalization set for use in evaluateBatch()
+  _curNormSet = (RooArgSet*)set ;
+  RooAbsPdf::computeBatch(output,batch,set) ;
+}
+
+
+
+//_____________________________________________________________________________
+Bool_t RooProdPdf::evaluateBatch(Double_t* output, RooBatchData& batch) const 
+{
+  // Vectorized evaluate() for all events in batch. The terms of the product
+  // are evaluated in batch mode and multiplied in the same order as in calculate()
+
+  Int_t code ;
+  CacheElem* cache = (CacheElem*) _cacheMgr.getObj(_curNormSet,0,&code) ;
+  
+  // If cache doesn't have our configuration, recalculate here
+  if (!cache) {
+    RooArgList *plist(0) ;
+    RooLinkedList *nlist(0) ;
+    getPartIntList(_curNormSet,0,plist,nlist,code) ;
+    cache = (CacheElem*) _cacheMgr.getObj(_curNormSet,0,&code) ;
+  }
+
+  Int_t nevt = batch.size() ;
+  Int_t j ;
+
+  if (cache->_isRearranged) {
+    const Double_t* num = cache->_rearrangedNum->getValBatch(batch) ;
+    const Double_t* den = cache->_rearrangedDen->getValBatch(batch) ;
+    for (j=0 ; j<nevt ; j++) {
+      output[j] = num[j] / den[j] ;
+    }
+    return kTRUE ;
+  }
+
+  for (j=0 ; j<nevt ; j++) {
+    output[j] = 1.0 ;
+  }
+
+  // Terms are not multiplied into events whose running product has dropped
+  // below the cutoff, as in calculate()
+  RooAbsReal* partInt ;
+  RooArgSet* normSet ;
+  Int_t n = cache->_partList.getSize() ;
+  RooFIter plIter = cache->_partList.fwdIterator() ;
+  RooFIter nlIter = cache->_normList.fwdIterator() ;
+  for (Int_t i=0 ; i<n ; i++) {
+    partInt = (RooAbsReal*) plIter.next() ;
+    normSet = (RooArgSet*) nlIter.next() ;
+    const Double_t* piVal = partInt->getValBatch(batch,normSet->getSize()>0 ? normSet : 0) ;
+    for (j=0 ; j<nevt ; j++) {
+      if (i==0 || output[j]>_cutOff) {
+	output[j] *= piVal[j] ;
+      }
+    }
+  }
+
+  return kTRUE ;
+}
+
+
+
 //_____________________________________________________________________________
 Double_t RooProdPdf::calculate(const RooArgList* partIntList, const RooLinkedList* normSetList) const
 {
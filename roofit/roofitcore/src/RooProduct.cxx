@@ -41,6 +41,7 @@
 #include "RooAbsCategory.h"
 #include "RooErrorHandler.h"
 #include "RooMsgService.h"
+#include "RooBatchData.h"
 
 using namespace std ;
 
@@ -383,6 +384,47 @@ Double_t RooProduct::evaluate() const
 
 
 
+//_____________________________________________________________________________
+Bool_t RooProduct::evaluateBatch(Double_t* output, RooBatchData& batch) const 
+{
+  // Vectorized evaluate() for all events in batch. The real-valued terms
+  // are evaluated in batch mode, category terms must not depend on the
+  // observables of the data
+
+  if (batch.dependsOnData(_compCSet)) {
+    return kFALSE ;
+  }
+
+  Int_t n = batch.size() ;
+  Int_t j ;
+  for (j=0 ; j<n ; j++) {
+    output[j] = 1 ;
+  }
+
+  RooFIter compRIter = _compRSet.fwdIterator() ;
+  RooAbsReal* rcomp ;
+  const RooArgSet* nset = _compRSet.nset() ;
+  while((rcomp=(RooAbsReal*)compRIter.next())) {
+    const Double_t* compVal = rcomp->getValBatch(batch,nset) ;
+    for (j=0 ; j<n ; j++) {
+      output[j] *= compVal[j] ;
+    }
+  }
+
+  RooFIter compCIter = _compCSet.fwdIterator() ;
+  RooAbsCategory* ccomp ;
+  while((ccomp=(RooAbsCategory*)compCIter.next())) {
+    Int_t index = ccomp->getIndex() ;
+    for (j=0 ; j<n ; j++) {
+      output[j] *= index ;
+    }
+  }
+
+  return kTRUE ;
+}
+
+
+
 //_____________________________________________________________________________
 std::list<Double_t>* RooProduct::binBoundaries(RooAbsRealLValue& obs, Double_t xlo, Double_t xhi) const
 {
@@ -28,6 +28,7 @@
 #include "RooRealAnalytic.h"
 #include "RooRealAnalytic.h"
 #include "RooAbsReal.h"
+#include "RooArgSet.h"
 
 #include <assert.h>
 
@@ -47,3 +48,23 @@ Double_t RooRealAnalytic::operator()(const Double_t xvector[]) const
   _ncall++ ;
   return _code ? _func->analyticalIntegralWN(_code,_nset,_rangeName?_rangeName->GetName():0):_func->getVal(_nset) ;
 }
+
+
+
+//_____________________________________________________________________________
+RooAbsFunc* RooRealAnalytic::cloneTree() const
+{
+  // Return a binding to the analytic integral of a clone of the expression 
+  // tree of the bound function that shares only the parameters with this binding
+
+  RooArgSet varsClone ;
+  RooArgSet* tree(0) ;
+  const RooAbsReal* funcClone = cloneFuncTree(varsClone,tree) ;
+  if (!funcClone) {
+    return 0 ;
+  }
+
+  RooRealAnalytic* ret = new RooRealAnalytic(*funcClone,varsClone,_code,_nset,_rangeName) ;
+  ret->_ownedTree = tree ;
+  return ret ;
+}
@@ -45,7 +45,7 @@ ClassImp(RooRealBinding)
 
 //_____________________________________________________________________________
 RooRealBinding::RooRealBinding(const RooAbsReal& func, const RooArgSet &vars, const RooArgSet* nset, Bool_t clipInvalid, const TNamed* rangeName) :
-  RooAbsFunc(vars.getSize()), _func(&func), _vars(0), _nset(nset), _clipInvalid(clipInvalid), _xsave(0), _rangeName(rangeName), _funcSave(0)
+  RooAbsFunc(vars.getSize()), _func(&func), _vars(0), _nset(nset), _clipInvalid(clipInvalid), _xsave(0), _rangeName(rangeName), _funcSave(0), _ownedTree(0)
 {
   // Construct a lightweight function binding of RooAbsReal func to
   // variables 'vars'.  Use the provided nset as normalization set to
@@ -82,7 +82,7 @@ RooRealBinding::RooRealBinding(const RooAbsReal& func, const RooArgSet &vars, co
 //_____________________________________________________________________________
 RooRealBinding::RooRealBinding(const RooRealBinding& other, const RooArgSet* nset) :
   RooAbsFunc(other), _func(other._func), _nset(nset?nset:other._nset), _xvecValid(other._xvecValid),
-  _clipInvalid(other._clipInvalid), _xsave(0), _rangeName(other._rangeName), _funcSave(other._funcSave)
+  _clipInvalid(other._clipInvalid), _xsave(0), _rangeName(other._rangeName), _funcSave(other._funcSave), _ownedTree(0)
 {
   // Construct a lightweight function binding of RooAbsReal func to
   // variables 'vars'.  Use the provided nset as normalization set to
@@ -109,6 +109,66 @@ RooRealBinding::~RooRealBinding()
 
   if(0 != _vars) delete[] _vars;
   if (_xsave) delete[] _xsave ;
+  if (_ownedTree) delete _ownedTree ;
+}
+
+
+
+//_____________________________________________________________________________
+const RooAbsReal* RooRealBinding::cloneFuncTree(RooArgSet& varsClone, RooArgSet*& tree) const
+{
+  // Clone the expression tree of the bound function. The clone shares the parameters
+  // of the original tree, but has its own copies of all other nodes and of the
+  // bound variables, which are returned in 'varsClone'. The cloned tree, which
+  // must be deleted by the caller, is returned in 'tree'. Returns the cloned function
+  // or zero if the bound variables are not part of the expression tree
+
+  tree = (RooArgSet*) RooArgSet(*_func).snapshot(kTRUE) ;
+  if (!tree) {
+    return 0 ;
+  }
+
+  RooArgSet vars ;
+  for (UInt_t i=0 ; i<getDimension() ; i++) {
+    RooAbsArg* varClone = tree->find(_vars[i]->GetName()) ;
+    if (!varClone) {
+      delete tree ;
+      tree = 0 ;
+      return 0 ;
+    }
+    vars.add(*_vars[i]) ;
+    varsClone.add(*varClone) ;
+  }
+
+  // Share parameters with the original expression tree
+  RooAbsReal* funcClone = (RooAbsReal*) tree->find(_func->GetName()) ;
+  RooArgSet* params = _func->getParameters(vars) ;
+  funcClone->recursiveRedirectServers(*params) ;
+  delete params ;
+
+  return funcClone ;
+}
+
+
+
+//_____________________________________________________________________________
+RooAbsFunc* RooRealBinding::cloneTree() const
+{
+  // Return a binding to a clone of the expression tree of the bound function
+  // that shares only the parameters with this binding. The returned binding
+  // can be evaluated concurrently with this binding as long as the parameters
+  // are not modified. Returns zero if the function cannot be cloned
+
+  RooArgSet varsClone ;
+  RooArgSet* tree(0) ;
+  const RooAbsReal* funcClone = cloneFuncTree(varsClone,tree) ;
+  if (!funcClone) {
+    return 0 ;
+  }
+
+  RooRealBinding* ret = new RooRealBinding(*funcClone,varsClone,_nset,_clipInvalid,_rangeName) ;
+  ret->_ownedTree = tree ;
+  return ret ;
 }
 
 
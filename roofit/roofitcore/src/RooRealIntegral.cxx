@@ -50,6 +50,9 @@
 #include "RooConstVar.h"
 #include "RooDouble.h"
 
+#include <math.h>
+#include <algorithm>
+
 using namespace std;
 
 ClassImp(RooRealIntegral) 
@@ -57,6 +60,8 @@ ClassImp(RooRealIntegral)
 
 
 Int_t RooRealIntegral::_cacheAllNDim(2) ;
+Int_t RooRealIntegral::_numCacheSize(0) ;
+Double_t RooRealIntegral::_numCacheTol(0) ;
 
 
 //_____________________________________________________________________________
@@ -72,7 +77,9 @@ RooRealIntegral::RooRealIntegral() :
   _numIntegrand(0),
   _rangeName(0),
   _params(0),
-  _cacheNum(kFALSE)
+  _cacheNum(kFALSE),
+  _numCacheHits(0),
+  _numCacheMisses(0)
 {
   _facListIter = _facList.createIterator() ;
   _jacListIter = _jacList.createIterator() ;
@@ -106,7 +113,9 @@ RooRealIntegral::RooRealIntegral(const char *name, const char *title,
   _numIntegrand(0),
   _rangeName((TNamed*)RooNameReg::ptr(rangeName)),
   _params(0),
-  _cacheNum(kFALSE)
+  _cacheNum(kFALSE),
+  _numCacheHits(0),
+  _numCacheMisses(0)
 {
   // Construct integral of 'function' over observables in 'depList'
   // in range 'rangeName'  with normalization observables 'funcNormSet' 
@@ -729,7 +738,9 @@ RooRealIntegral::RooRealIntegral(const RooRealIntegral& other, const char* name)
   _numIntegrand(0),
   _rangeName(other._rangeName),
   _params(0),
-  _cacheNum(kFALSE)
+  _cacheNum(kFALSE),
+  _numCacheHits(0),
+  _numCacheMisses(0)
 {
   // Copy constructor
 
@@ -844,6 +855,16 @@ Double_t RooRealIntegral::evaluate() const
     
   case Hybrid: 
     {      
+      // Look up numeric integrals in cache of recently calculated values
+      vector<Double_t> numKey ;
+      Bool_t useNumCache = (_numCacheSize>0 && _intList.getSize()>0) ;
+      if (useNumCache) {
+	fillNumCacheKey(numKey) ;
+	if (retrieveNumCache(numKey,retVal)) {
+	  break ;
+	}
+      }
+
       // Cache numeric integrals in >1d expensive object cache
       RooDouble* cacheVal(0) ;
       if ((_cacheNum && _intList.getSize()>0) || _intList.getSize()>=_cacheAllNDim) {
@@ -890,6 +911,10 @@ Double_t RooRealIntegral::evaluate() const
 	}
 	
       }
+
+      if (useNumCache) {
+	storeNumCache(numKey,retVal) ;
+      }
       break ;
     }
   case Analytic:
@@ -949,6 +974,101 @@ Double_t RooRealIntegral::evaluate() const
 
 
 
+//_____________________________________________________________________________
+void RooRealIntegral::fillNumCacheKey(vector<Double_t>& key) const 
+{
+  // Fill key for numeric value cache with current values of the
+  // parameters of this integral and the limits of the numerically
+  // and analytically integrated observables in the integration range
+
+  key.clear() ;
+  RooFIter iter = parameters().fwdIterator() ;
+  RooAbsArg* arg ;
+  while((arg=iter.next())) {
+    RooAbsReal* real = dynamic_cast<RooAbsReal*>(arg) ;
+    if (real) {
+      key.push_back(real->getVal()) ;
+      continue ;
+    }
+    RooAbsCategory* cat = dynamic_cast<RooAbsCategory*>(arg) ;
+    if (cat) {
+      key.push_back(cat->getIndex()) ;
+    }
+  }
+
+  const char* rangeName = RooNameReg::str(_rangeName) ;
+  iter = _intList.fwdIterator() ;
+  while((arg=iter.next())) {
+    RooAbsRealLValue* lval = dynamic_cast<RooAbsRealLValue*>(arg) ;
+    if (lval) {
+      key.push_back(lval->getMin(rangeName)) ;
+      key.push_back(lval->getMax(rangeName)) ;
+    }
+  }
+  iter = _anaList.fwdIterator() ;
+  while((arg=iter.next())) {
+    RooAbsRealLValue* lval = dynamic_cast<RooAbsRealLValue*>(arg) ;
+    if (lval) {
+      key.push_back(lval->getMin(rangeName)) ;
+      key.push_back(lval->getMax(rangeName)) ;
+    }
+  }
+}
+
+
+
+//_____________________________________________________________________________
+Bool_t RooRealIntegral::retrieveNumCache(const vector<Double_t>& key, Double_t& value) const 
+{
+  // Look for a cached integral value over the same range with a key that
+  // matches the given key within the relative tolerance set with
+  // setNumCache(). If found, return true, store the cached value in 'value'
+  // and mark it as most recently used
+
+  list<NumCacheElem>::iterator iter = _numCache.begin() ;
+  for (; iter!=_numCache.end() ; ++iter) {
+    if (iter->_range!=_rangeName || iter->_key.size()!=key.size()) continue ;
+    Bool_t match(kTRUE) ;
+    for (UInt_t i=0 ; i<key.size() ; i++) {
+      Double_t a = key[i] ;
+      Double_t b = iter->_key[i] ;
+      if (a!=b && fabs(a-b) > _numCacheTol*max(fabs(a),fabs(b))) {
+	match = kFALSE ;
+	break ;
+      }
+    }
+    if (match) {
+      value = iter->_value ;
+      _numCache.splice(_numCache.begin(),_numCache,iter) ;
+      _numCacheHits++ ;
+      return kTRUE ;
+    }
+  }
+
+  return kFALSE ;
+}
+
+
+
+//_____________________________________________________________________________
+void RooRealIntegral::storeNumCache(const vector<Double_t>& key, Double_t value) const 
+{
+  // Store integral value with given key as most recently used element
+  // of the numeric value cache, removing the least recently used elements
+  // if the cache exceeds the size set with setNumCache()
+
+  _numCacheMisses++ ;
+  _numCache.push_front(NumCacheElem()) ;
+  _numCache.front()._key = key ;
+  _numCache.front()._range = _rangeName ;
+  _numCache.front()._value = value ;
+  while (_numCache.size()>(UInt_t)_numCacheSize) {
+    _numCache.pop_back() ;
+  }
+}
+
+
+
 //_____________________________________________________________________________
 Double_t RooRealIntegral::jacobianProduct() const 
 {
@@ -1043,6 +1163,9 @@ Bool_t RooRealIntegral::redirectServersHook(const RooAbsCollection& /*newServerL
     _params = 0 ;
   }
 
+  // Clear numeric value cache
+  _numCache.clear() ;
+
   return kFALSE ;
 }
 
@@ -1154,6 +1277,11 @@ void RooRealIntegral::printMultiline(ostream& os, Int_t contents, Bool_t verbose
     os << "<none>" ;
   
   os << endl ;
+
+  if (_numCacheHits>0 || _numCacheMisses>0) {
+    os << indent << "  Numeric value cache contains " << _numCache.size() << " values, " 
+       << _numCacheHits << " hits, " << _numCacheMisses << " misses" << endl ;
+  }
 } 
 
 
@@ -1173,3 +1301,33 @@ Int_t RooRealIntegral::getCacheAllNumeric()
 }
 
 
+//_____________________________________________________________________________
+void RooRealIntegral::setNumCache(Int_t size, Double_t tolerance) 
+{
+  // Global switch to cache the last 'size' values of each (partially) numeric
+  // integral, keyed by the values of its parameters and its integration limits.
+  // A value is reused if all keys match within the relative 'tolerance'. 
+  // A non-zero tolerance trades precision for speed, e.g. for normalization
+  // integrals in fits where MINUIT revisits nearby parameter values. A size of
+  // zero disables the cache (default)
+  _numCacheSize = size>0 ? size : 0 ;
+  _numCacheTol = tolerance>0 ? tolerance : 0 ;
+}
+
+
+//_____________________________________________________________________________
+Int_t RooRealIntegral::getNumCacheSize() 
+{
+  // Return maximum number of values in numeric value cache of each integral
+  return _numCacheSize ;
+}
+
+
+//_____________________________________________________________________________
+Double_t RooRealIntegral::getNumCacheTolerance() 
+{
+  // Return relative tolerance for matching keys in numeric value cache
+  return _numCacheTol ;
+}
+
+
@@ -42,6 +42,7 @@
 #include "RooRealIntegral.h"
 #include "RooMsgService.h"
 #include "RooNameReg.h"
+#include "RooBatchData.h"
 #include <memory>
 #include <algorithm>
 
@@ -266,6 +267,77 @@ Double_t RooRealSumPdf::evaluate() const
 
 
 
+//_____________________________________________________________________________
+Bool_t RooRealSumPdf::evaluateBatch(Double_t* output, RooBatchData& batch) const 
+{
+  // Vectorized evaluate() for all events in batch. The functions are
+  // evaluated in batch mode and summed in the same order and with the
+  // same coefficients as in evaluate(). If any coefficient depends on
+  // the observables of the data, events are evaluated one by one
+
+  if (batch.dependsOnData(_coefList)) {
+    return kFALSE ;
+  }
+
+  Int_t n = batch.size() ;
+  Int_t j ;
+  for (j=0 ; j<n ; j++) {
+    output[j] = 0 ;
+  }
+
+  // Do running sum of coef/func pairs, calculate lastCoef.
+  RooFIter funcIter = _funcList.fwdIterator() ;
+  RooFIter coefIter = _coefList.fwdIterator() ;
+  RooAbsReal* coef ;
+  RooAbsReal* func ;
+
+  // N funcs, N-1 coefficients 
+  Double_t lastCoef(1) ;
+  while((coef=(RooAbsReal*)coefIter.next())) {
+    func = (RooAbsReal*)funcIter.next() ;
+    Double_t coefVal = coef->getVal() ;
+    if (coefVal) {
+      if (func->isSelectedComp()) {
+	const Double_t* funcVal = func->getValBatch(batch) ;
+	for (j=0 ; j<n ; j++) {
+	  output[j] += funcVal[j]*coefVal ;
+	}
+      }
+      lastCoef -= coefVal ;
+    }
+  }
+
+  if (!_haveLastCoef) {
+    // Add last func with correct coefficient
+    func = (RooAbsReal*) funcIter.next() ;
+    if (func->isSelectedComp()) {
+      const Double_t* funcVal = func->getValBatch(batch) ;
+      for (j=0 ; j<n ; j++) {
+	output[j] += funcVal[j]*lastCoef ;
+      }
+    }
+
+    // Warn about coefficient degeneration
+    if (lastCoef<0 || lastCoef>1) {
+      coutW(Eval) << "RooRealSumPdf::evaluateBatch(" << GetName() 
+		  << " WARNING: sum of FUNC coefficients not in range [0-1], value=" 
+		  << 1-lastCoef << endl ;
+    } 
+  }
+
+  // Introduce floor if so requested
+  if (_doFloor || _doFloorGlobal) {
+    for (j=0 ; j<n ; j++) {
+      if (output[j]<0) output[j] = 0 ;
+    }
+  }
+
+  return kTRUE ;
+}
+
+
+
+
 //_____________________________________________________________________________
 Bool_t RooRealSumPdf::checkObservables(const RooArgSet* nset) const 
 {
@@ -34,14 +34,22 @@
 #include "RooDataSet.h"
 #include "RooMsgService.h"
 #include "RooStudyPackage.h"
+#include "RooRandom.h"
 #include "TTree.h"
 #include "TFile.h"
 #include "TRegexp.h"
 #include "TKey.h"
+#include "TRandom3.h"
 #include <string>
 #include "TROOT.h"
 #include "TSystem.h"
 
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
 using namespace std ;
 
 ClassImp(RooStudyManager)
@@ -158,6 +166,125 @@ void RooStudyManager::closeProof(Option_t *option)
 
 
 
+//_____________________________________________________________________________
+void RooStudyManager::runLocal(Int_t nExperiments, Int_t nWorkers, UInt_t seed) 
+{
+  // Run nExperiments in nWorkers forked processes on the local host, without PROOF.
+  // Each worker runs a contiguous block of experiments on its own copy of the
+  // workspace and studies and writes its results to a temporary file, which
+  // are aggregated in worker order once all workers have finished.
+  //
+  // The random generators of RooRandom and gRandom are seeded at the start of
+  // each experiment with a seed that only depends on 'seed' and on the sequence
+  // number of the experiment. Results are therefore reproducible and independent
+  // of the number of workers. If seed is zero a master seed is chosen at random
+  // and printed. On Windows all experiments are run sequentially in this process.
+
+  if (nExperiments<1) return ;
+  if (nWorkers<1) nWorkers=1 ;
+  if (nWorkers>nExperiments) nWorkers=nExperiments ;
+
+  if (seed==0) {
+    TRandom3 tmp(0) ;
+    seed = tmp.Integer(1000000)+1 ;
+  }
+  coutI(Generation) << "RooStudyManager::runLocal(" << GetName() << ") running " << nExperiments << " experiments in " 
+		    << nWorkers << " worker processes with master seed " << seed << endl ;
+
+  // Draw the seeds of all experiments from the master seed
+  vector<UInt_t> seeds(nExperiments) ;
+  TRandom3 master(seed) ;
+  for (Int_t i=0 ; i<nExperiments ; i++) {
+    seeds[i] = master.Integer(2147483647)+1 ;
+  }
+
+  list<string> flist ;
+  vector<Int_t> pids(nWorkers,0) ;
+  for (Int_t iw=0 ; iw<nWorkers ; iw++) {
+
+    Int_t firstExp = Int_t((Long64_t)nExperiments*iw/nWorkers) ;
+    Int_t lastExp  = Int_t((Long64_t)nExperiments*(iw+1)/nWorkers) ;
+    string fileName = Form("%s/roostudy_%d_%d.root",gSystem->TempDirectory(),gSystem->GetPid(),iw) ;
+    flist.push_back(fileName) ;
+
+#ifndef _WIN32
+    pids[iw] = fork() ;
+    if (pids[iw]==0) {
+      // Worker process
+      Bool_t ok = runLocalBlock(*_pkg,seeds,firstExp,lastExp,iw,fileName.c_str()) ;
+      _exit(ok ? 0 : 1) ;
+    } 
+    if (pids[iw]>0) {
+      coutI(Generation) << "RooStudyManager::runLocal(" << GetName() << ") started worker process " << pids[iw] 
+			<< " for experiments " << firstExp << "-" << lastExp-1 << endl ;
+      continue ;
+    }
+    coutE(Generation) << "RooStudyManager::runLocal(" << GetName() << ") ERROR fork() failed, running experiments " 
+		      << firstExp << "-" << lastExp-1 << " in this process" << endl ;
+#endif
+
+    // Run block in this process on a copy of the study package
+    RooStudyPackage* pkg = (RooStudyPackage*) _pkg->Clone() ;
+    runLocalBlock(*pkg,seeds,firstExp,lastExp,iw,fileName.c_str()) ;
+    delete pkg ;
+  }
+
+#ifndef _WIN32
+  // Wait for all workers to finish
+  for (Int_t iw=0 ; iw<nWorkers ; iw++) {
+    if (pids[iw]<=0) continue ;
+    int status(0) ;
+    waitpid(pids[iw],&status,0) ;
+    if (!WIFEXITED(status) || WEXITSTATUS(status)!=0) {
+      coutE(Generation) << "RooStudyManager::runLocal(" << GetName() << ") ERROR worker process " << pids[iw] 
+			<< " did not terminate normally, its results will be missing" << endl ;
+    }
+  }
+#endif
+
+  // Aggregate results data and remove temporary files
+  coutP(Generation) << "RooStudyManager::runLocal(" << GetName() << ") aggregating results data" << endl ;
+  list<string> foundList ;
+  for (list<string>::iterator iter = flist.begin() ; iter!=flist.end() ; ++iter) {
+    if (!gSystem->AccessPathName(iter->c_str())) {
+      foundList.push_back(*iter) ;
+    }
+  }
+  processOutputFiles(foundList) ;
+  for (list<string>::iterator iter = foundList.begin() ; iter!=foundList.end() ; ++iter) {
+    gSystem->Unlink(iter->c_str()) ;
+  }
+}
+
+
+
+//_____________________________________________________________________________
+Bool_t RooStudyManager::runLocalBlock(RooStudyPackage& pkg, const vector<UInt_t>& seeds, Int_t firstExp, Int_t lastExp, Int_t seqno, const char* fileName) 
+{
+  // Run experiments [firstExp,lastExp) of study package 'pkg', seeding the random
+  // generators before each experiment, and write the results to file 'fileName'
+
+  pkg.initialize() ;
+  for (Int_t i=firstExp ; i<lastExp ; i++) {
+    RooRandom::randomGenerator()->SetSeed(seeds[i]) ;
+    gRandom->SetSeed(seeds[i]) ;
+    pkg.runOne() ;
+  }
+
+  TList res ;
+  pkg.exportData(&res,seqno) ;
+  TFile fout(fileName,"RECREATE") ;
+  if (fout.IsZombie()) {
+    oocoutE((TObject*)0,Generation) << "RooStudyManager::runLocalBlock() ERROR cannot open output file " << fileName << endl ;
+    return kFALSE ;
+  }
+  res.Write() ;
+  fout.Close() ;
+  return kTRUE ;
+}
+
+
+
 //_____________________________________________________________________________
 void RooStudyManager::prepareBatchInput(const char* studyName, Int_t nExpPerJob, Bool_t unifiedInput=kFALSE) 
 {
@@ -214,11 +341,20 @@ void RooStudyManager::processBatchOutput(const char* filePat)
 {
   list<string> flist ;
   expandWildCardSpec(filePat,flist) ;
+  processOutputFiles(flist) ;
+}
+
+
+
+//_____________________________________________________________________________
+void RooStudyManager::processOutputFiles(const list<string>& flist) 
+{
+  // Read the study results stored in the given files and aggregate them
 
   TList olist ;
 
-  for (list<string>::iterator iter = flist.begin() ; iter!=flist.end() ; ++iter) {
-    coutP(DataHandling) << "RooStudyManager::processBatchOutput() now reading file " << *iter << endl ;
+  for (list<string>::const_iterator iter = flist.begin() ; iter!=flist.end() ; ++iter) {
+    coutP(DataHandling) << "RooStudyManager::processOutputFiles() now reading file " << *iter << endl ;
     TFile f(iter->c_str()) ;
 
     TList* list = f.GetListOfKeys() ;
@@ -1397,6 +1397,50 @@ void RooVectorDataStore::resetBuffers()
 
 
 
+//_____________________________________________________________________________
+void RooVectorDataStore::printCacheStatistics(ostream& os, const char* indent) const
+{
+  // Print for each cached node in cache-and-track mode how often its column
+  // was recalculated and how often it was reused because none of the
+  // parameters it depends on had changed since the previous cache update
+
+  if (!_cache) return ;
+
+  Int_t nRecalc(0), nReuse(0) ;
+  for (Int_t i=0 ; i<_cache->_nReal ; i++) {
+    const RealVector* rv = *(_cache->_firstReal+i) ;
+    if (!rv->isTracked()) continue ;
+    Int_t n = rv->numRecalc()+rv->numReuse() ;
+    os << indent << rv->bufArg()->GetName() << " : recalculated " << rv->numRecalc() << " times, reused " << rv->numReuse() << " times" ;
+    if (n>0) {
+      os << " (" << 100.*rv->numReuse()/n << "% cache hits)" ;
+    }
+    os << endl ;
+    nRecalc += rv->numRecalc() ;
+    nReuse += rv->numReuse() ;
+  }
+  if (nRecalc+nReuse>0) {
+    os << indent << "total : " << nRecalc << " column recalculations, " << nReuse << " column reuses (" 
+       << 100.*nReuse/(nRecalc+nReuse) << "% cache hits)" << endl ;
+  }
+}
+
+
+
+//_____________________________________________________________________________
+void RooVectorDataStore::resetCacheStatistics()
+{
+  // Reset the recalculation and reuse counters of the cached nodes
+
+  if (!_cache) return ;
+
+  for (Int_t i=0 ; i<_cache->_nReal ; i++) {
+    (*(_cache->_firstReal+i))->resetCounters() ;
+  }
+}
+
+
+
 //_____________________________________________________________________________
 void RooVectorDataStore::dump()
 {
@@ -57,6 +57,7 @@
 #include "TROOT.h"
 #include "TFile.h"
 #include "TH1.h"
+#include "TStopwatch.h"
 #include <map>
 #include <string>
 #include <list>
@@ -87,6 +88,21 @@ string RooWorkspace::_classFileExportDir = ".wscode.%s.%s" ;
 Bool_t RooWorkspace::_autoClass = kFALSE ;
 
 
+namespace {
+
+  // Adds the real time spent in its scope to given total
+  class RooWorkspaceImportTimer {
+  public:
+    RooWorkspaceImportTimer(Double_t& total) : _total(total) { _timer.Start() ; }
+    ~RooWorkspaceImportTimer() { _total += _timer.RealTime() ; }
+  private:
+    Double_t& _total ;
+    TStopwatch _timer ;
+  } ;
+
+}
+
+
 //_____________________________________________________________________________
 void RooWorkspace::addClassDeclImportDir(const char* dir) 
 {
@@ -134,7 +150,8 @@ void RooWorkspace::autoImportClassCode(Bool_t flag)
 
 
 //_____________________________________________________________________________
-RooWorkspace::RooWorkspace() : _classes(this), _dir(0), _factory(0), _doExport(kFALSE), _openTrans(kFALSE)
+RooWorkspace::RooWorkspace() : _classes(this), _dir(0), _factory(0), _doExport(kFALSE), _openTrans(kFALSE),
+  _nImport(0), _nImportNodes(0), _nImportRecycled(0), _importTime(0)
 {
   // Default constructor
 }
@@ -143,14 +160,16 @@ RooWorkspace::RooWorkspace() : _classes(this), _dir(0), _factory(0), _doExport(k
 
 //_____________________________________________________________________________
 RooWorkspace::RooWorkspace(const char* name, const char* title) : 
-  TNamed(name,title?title:name), _classes(this), _dir(0), _factory(0), _doExport(kFALSE), _openTrans(kFALSE)
+  TNamed(name,title?title:name), _classes(this), _dir(0), _factory(0), _doExport(kFALSE), _openTrans(kFALSE),
+  _nImport(0), _nImportNodes(0), _nImportRecycled(0), _importTime(0)
 {
   // Construct empty workspace with given name and title
 }
 
 
 RooWorkspace::RooWorkspace(const char* name, Bool_t doCINTExport)  : 
-  TNamed(name,name), _classes(this), _dir(0), _factory(0), _doExport(kFALSE), _openTrans(kFALSE)
+  TNamed(name,name), _classes(this), _dir(0), _factory(0), _doExport(kFALSE), _openTrans(kFALSE),
+  _nImport(0), _nImportNodes(0), _nImportRecycled(0), _importTime(0)
 {
   // Construct empty workspace with given name and option to export reference to all workspace contents to a CINT namespace with the same name
   if (doCINTExport) {
@@ -161,7 +180,8 @@ RooWorkspace::RooWorkspace(const char* name, Bool_t doCINTExport)  :
 
 //_____________________________________________________________________________
 RooWorkspace::RooWorkspace(const RooWorkspace& other) : 
-  TNamed(other), _uuid(other._uuid), _classes(this), _dir(0), _factory(0), _doExport(kFALSE), _openTrans(kFALSE)
+  TNamed(other), _uuid(other._uuid), _classes(this), _dir(0), _factory(0), _doExport(kFALSE), _openTrans(kFALSE),
+  _nImport(0), _nImportNodes(0), _nImportRecycled(0), _importTime(0)
 {
   // Workspace copy constructor
 
@@ -326,6 +346,10 @@ Bool_t RooWorkspace::import(const RooAbsArg& inArg, const RooCmdArg& arg1, const
   //  as often as necessary to rename multiple variables. Alternatively, a single RenameVariable argument can be given with
   //  two comma separated lists.
 
+  // Update profiling counters
+  _nImport++ ;
+  RooWorkspaceImportTimer timer(_importTime) ;
+
   RooLinkedList args ;
   args.Add((TObject*)&arg1) ;
   args.Add((TObject*)&arg2) ;
@@ -598,6 +622,7 @@ Bool_t RooWorkspace::import(const RooAbsArg& inArg, const RooCmdArg& arg1, const
 			      << cloneTop2->GetName() << endl ;      
       }
       recycledNodes.add(*_allOwnedNodes.find(node->GetName())) ;
+      _nImportRecycled++ ;
 
       // Delete clone of incoming node
       nodesToBeDeleted.addOwned(*node) ;
@@ -609,6 +634,7 @@ Bool_t RooWorkspace::import(const RooAbsArg& inArg, const RooCmdArg& arg1, const
 			      << node->GetName() << endl ;
       }
       _allOwnedNodes.addOwned(*node) ;
+      _nImportNodes++ ;
       if (_openTrans) {
 	_sandboxNodes.add(*node) ;
       } else {
@@ -1928,6 +1954,38 @@ RooAbsArg* RooWorkspace::factory(const char* expr)
 
 
 
+//_____________________________________________________________________________
+void RooWorkspace::printImportStatistics() const 
+{
+  // Print profiling information on the import of functions, p.d.f.s and variables 
+  // into this workspace since its creation or the last call to resetImportStatistics()
+
+  cout << "RooWorkspace(" << GetName() << ") import statistics: " << _nImport << " calls to import(), " 
+       << _nImportNodes << " nodes imported, " << _nImportRecycled << " nodes connected to existing nodes, " 
+       << _importTime << " s real time" ;
+  if (_nImportNodes>0) {
+    cout << " (" << 1e6*_importTime/_nImportNodes << " us/node)" ;
+  }
+  cout << endl ;
+  cout << "RooWorkspace(" << GetName() << ") workspace contains " << _allOwnedNodes.getSize() << " nodes, name hash table size " 
+       << _allOwnedNodes.getHashTableSize() << endl ;
+}
+
+
+
+//_____________________________________________________________________________
+void RooWorkspace::resetImportStatistics() 
+{
+  // Reset the profiling counters of import()
+
+  _nImport = 0 ;
+  _nImportNodes = 0 ;
+  _nImportRecycled = 0 ;
+  _importTime = 0 ;
+}
+
+
+
 //_____________________________________________________________________________
 void RooWorkspace::Print(Option_t* opts) const 
 {
@@ -0,0 +1,287 @@
+#ifndef __CINT__
+#include <TROOT.h>
+#include <TMath.h>
+#include <TRandom3.h>
+#include <TString.h>
+#include <TThread.h>
+#include <TGeoManager.h>
+#include <TGeoNavigator.h>
+#include <TGeoVolume.h>
+#include <TGeoMatrix.h>
+#include <TGeoBBox.h>
+#include <TGeoTube.h>
+#include <TGeoXtru.h>
+#include <TGeoCompositeShape.h>
+#include <TBenchmark.h>
+#include <TApplication.h>
+
+void stressGeoParallel();
+
+int main(int argc, char **argv)
+{
+   TApplication theApp("App", &argc, argv);
+   stressGeoParallel();
+   return 0;
+}
+
+#endif
+//--- This program checks that the alternative navigation and closing paths
+//--- of TGeo give exactly the same navigation as the default ones. A
+//--- geometry containing divisions, assemblies, composite shapes, extruded
+//--- polygons and a grid of small boxes is closed in the default way and a
+//--- fixed set of random rays is tracked through it with
+//--- FindNextBoundaryAndStep, recording the sum of the steps and a checksum
+//--- of the crossed paths for each ray. The same rays are then tracked with
+//--- the alternative configurations and the results are compared ray by ray.
+//
+// To run this test with interactive CINT, do
+// root > .x stressGeoParallel.cxx++
+
+const Int_t kNrays    = 20000;
+const Int_t kMaxSteps = 1000;
+const Int_t kNthreads = 4;
+const Int_t kNwaves   = 8;
+
+Double_t gPoint[3*kNrays];
+Double_t gDir[3*kNrays];
+Double_t gLenRef[kNrays];
+UInt_t   gPathRef[kNrays];
+Double_t gLen[kNrays];
+UInt_t   gPath[kNrays];
+
+//______________________________________________________________________________
+void GenerateRays()
+{
+// Generate random starting points inside the top volume and isotropic
+// directions.
+   TRandom3 rndm(4357);
+   for (Int_t i=0; i<kNrays; i++) {
+      Double_t phi = 2*TMath::Pi()*rndm.Rndm();
+      Double_t theta = TMath::ACos(1.-2.*rndm.Rndm());
+      gPoint[3*i]   = -95+190*rndm.Rndm();
+      gPoint[3*i+1] = -95+190*rndm.Rndm();
+      gPoint[3*i+2] = -95+190*rndm.Rndm();
+      gDir[3*i]     = TMath::Sin(theta)*TMath::Cos(phi);
+      gDir[3*i+1]   = TMath::Sin(theta)*TMath::Sin(phi);
+      gDir[3*i+2]   = TMath::Cos(theta);
+   }
+}
+
+//______________________________________________________________________________
+void MakeGeometry(Bool_t bvh, Int_t nvoxthreads=1)
+{
+// Build and close the test geometry, voxelizing with nvoxthreads threads.
+   new TGeoManager("stressGeoParallel", "navigation equivalence");
+   gGeoManager->SetVerboseLevel(0);
+   TGeoMaterial *mat = new TGeoMaterial("Al", 26.98,13,2.7);
+   TGeoMedium *med = new TGeoMedium("Al",1,mat);
+   TGeoVolume *top = gGeoManager->MakeBox("TOP", med, 100,100,100);
+   gGeoManager->SetTopVolume(top);
+   Int_t i,j;
+   //---> slabs divided along X, with a rod in each cell
+   TGeoVolume *slab = gGeoManager->MakeBox("SLAB", med, 40,40,5);
+   TGeoVolume *cell = slab->Divide("CELL", 1, 8, -40, 10);
+   TGeoVolume *rod = gGeoManager->MakeTube("ROD", med, 0,3,4);
+   cell->AddNode(rod, 1);
+   for (i=0; i<4; i++) top->AddNode(slab, i+1, new TGeoTranslation(0,0,-75+15*i));
+   //---> grid of small boxes at different heights
+   TGeoVolume *cube = gGeoManager->MakeBox("CUBE", med, 2,2,2);
+   for (i=0; i<10; i++) {
+      for (j=0; j<10; j++) {
+         top->AddNode(cube, 10*i+j+1, new TGeoTranslation(-81+18*i, -81+18*j, 10+5*((3*i+j)%8)));
+      }
+   }
+   //---> composite shape
+   new TGeoBBox("CBOX", 20,20,10);
+   new TGeoTube("CHOLE", 0,10,11);
+   TGeoVolume *comp = new TGeoVolume("COMP", new TGeoCompositeShape("CS", "CBOX-CHOLE"), med);
+   top->AddNode(comp, 1, new TGeoTranslation(-50,-50,70));
+   //---> extruded polygon
+   TGeoVolume *xtru = gGeoManager->MakeXtru("XTRU", med, 2);
+   TGeoXtru *xshape = (TGeoXtru*)xtru->GetShape();
+   Double_t xv[6] = {-15, 15, 15, -5, -5,-15};
+   Double_t yv[6] = {-15,-15, -5, -5, 15, 15};
+   xshape->DefinePolygon(6, xv, yv);
+   xshape->DefineSection(0, -10);
+   xshape->DefineSection(1, 10, 0, 0, 0.5);
+   top->AddNode(xtru, 1, new TGeoTranslation(50,-50,70));
+   //---> assemblies of plates
+   TGeoVolumeAssembly *assembly = new TGeoVolumeAssembly("ASSEMBLY");
+   TGeoVolume *plate = gGeoManager->MakeBox("PLATE", med, 10,10,1);
+   for (i=0; i<5; i++) assembly->AddNode(plate, i+1, new TGeoTranslation(0,0,-8+4*i));
+   top->AddNode(assembly, 1, new TGeoTranslation(0,50,70));
+   top->AddNode(assembly, 2, new TGeoCombiTrans(50,50,70, new TGeoRotation("rassembly",30,0,0)));
+
+   gGeoManager->SetUseBVH(bvh);
+   gGeoManager->SetVoxelizationThreads(nvoxthreads);
+   gGeoManager->CloseGeometry();
+}
+
+//______________________________________________________________________________
+void TrackRays(TGeoNavigator *nav, Int_t first, Int_t stride, Double_t *len, UInt_t *path)
+{
+// Track the rays first, first+stride, ... until they exit the geometry.
+   for (Int_t i=first; i<kNrays; i+=stride) {
+      nav->InitTrack(&gPoint[3*i], &gDir[3*i]);
+      Double_t sum = 0;
+      UInt_t checksum = 0;
+      Int_t nsteps = 0;
+      while (!nav->IsOutside() && nsteps<kMaxSteps) {
+         nav->FindNextBoundaryAndStep();
+         sum += nav->GetStep();
+         checksum = 31*checksum + TString(nav->GetPath()).Hash();
+         nsteps++;
+      }
+      len[i] = sum;
+      path[i] = checksum;
+   }
+}
+
+//______________________________________________________________________________
+void CompareRays(const char *name)
+{
+// Compare the last tracked rays with the reference ones.
+   Int_t nbad = 0;
+   for (Int_t i=0; i<kNrays; i++) {
+      if (gPath[i]!=gPathRef[i] ||
+          TMath::Abs(gLen[i]-gLenRef[i]) > 1E-6*(1.+gLenRef[i])) nbad++;
+   }
+   char result[16];
+   snprintf(result,16, "FAILED");
+   if (!nbad) snprintf(result,16, "OK");
+   printf("---> testing %-28s ............... %s\n", name, result);
+   if (nbad) printf("     %d of %d rays differ from the reference\n", nbad, kNrays);
+}
+
+//______________________________________________________________________________
+void TestBVH()
+{
+// Navigation with bounding volume hierarchies instead of slice voxels.
+   MakeGeometry(kTRUE);
+   TrackRays(gGeoManager->GetCurrentNavigator(), 0, 1, gLen, gPath);
+   CompareRays("BVH voxel finder");
+   delete gGeoManager;
+}
+
+//______________________________________________________________________________
+void TestVoxelThreads()
+{
+// Navigation in a geometry voxelized in parallel when closing it.
+   MakeGeometry(kFALSE, kNthreads);
+   TrackRays(gGeoManager->GetCurrentNavigator(), 0, 1, gLen, gPath);
+   CompareRays("parallel voxelization");
+   delete gGeoManager;
+}
+
+//______________________________________________________________________________
+void TestHistory()
+{
+// Navigation relocating exiting tracks from the history of visited states.
+// The rays cross many cells of the divided slabs, so the history holds
+// states differing only by the division cell.
+   MakeGeometry(kFALSE);
+   TGeoNavigator *nav = gGeoManager->GetCurrentNavigator();
+   nav->SetHistorySize(16);
+   TrackRays(nav, 0, 1, gLen, gPath);
+   CompareRays("navigation history");
+   printf("     history hits=%lld misses=%lld\n", nav->GetHistoryHits(), nav->GetHistoryMisses());
+   delete gGeoManager;
+}
+
+//______________________________________________________________________________
+void *TrackRaysThread(void *arg)
+{
+// Track every kNthreads-th ray with a navigator private to this thread.
+   Long_t ithread = (Long_t)arg;
+   TGeoNavigator *nav = gGeoManager->AddNavigator();
+   TrackRays(nav, ithread, kNthreads, gLen, gPath);
+   return 0;
+}
+
+//______________________________________________________________________________
+void *TrackRaysWave(void *arg)
+{
+// Track every (kNwaves*kNthreads)-th ray. A thread started in a later wave
+// may find the navigator left by an exited thread with the same system id.
+   Long_t ithread = (Long_t)arg;
+   TGeoNavigator *nav = gGeoManager->GetCurrentNavigator();
+   if (!nav) nav = gGeoManager->AddNavigator();
+   TrackRays(nav, ithread, kNwaves*kNthreads, gLen, gPath);
+   return 0;
+}
+
+//______________________________________________________________________________
+void TestThreadTurnover()
+{
+// Navigation by successive waves of threads, many more than declared with
+// SetMaxThreads. The ordinals of exited threads are reused by the next waves
+// and the thread data of further ordinals is added on demand.
+   MakeGeometry(kFALSE);
+   gGeoManager->SetMaxThreads(2);
+   TThread *threads[kNthreads];
+   Int_t i, iwave;
+   for (iwave=0; iwave<kNwaves; iwave++) {
+      for (i=0; i<kNthreads; i++) {
+         threads[i] = new TThread(Form("wave%d_%d",iwave,i), TrackRaysWave, (void*)(Long_t)(iwave*kNthreads+i));
+         threads[i]->Run();
+      }
+      for (i=0; i<kNthreads; i++) {
+         threads[i]->Join();
+         delete threads[i];
+      }
+   }
+   CompareRays("thread turnover");
+   // Only kNthreads threads ran at the same time (one more in case the main
+   // thread registers)
+   Int_t nordinals = TGeoManager::GetNumThreads();
+   printf("---> testing %-28s ............... %s\n", "reuse of thread ordinals", (nordinals<=kNthreads+1) ? "OK" : "FAILED");
+   if (nordinals > kNthreads+1)
+      printf("     %d thread ordinals for %d threads running at the same time\n", nordinals, kNthreads);
+   delete gGeoManager;
+}
+
+//______________________________________________________________________________
+void TestThreads()
+{
+// Navigation of the rays shared among several threads.
+   MakeGeometry(kFALSE);
+   // One more slot in case the main thread also registers
+   gGeoManager->SetMaxThreads(kNthreads+1);
+   TThread *threads[kNthreads];
+   Int_t i;
+   for (i=0; i<kNthreads; i++) {
+      threads[i] = new TThread(Form("nav%d",i), TrackRaysThread, (void*)(Long_t)i);
+      threads[i]->Run();
+   }
+   for (i=0; i<kNthreads; i++) {
+      threads[i]->Join();
+      delete threads[i];
+   }
+   CompareRays("multi-threaded navigation");
+   delete gGeoManager;
+}
+
+//______________________________________________________________________________
+void stressGeoParallel()
+{
+#ifdef __CINT__
+   gSystem->Load("libGeom");
+   gSystem->Load("libThread");
+#endif
+   gBenchmark = new TBenchmark();
+   gBenchmark->Start("stressGeoParallel");
+
+   GenerateRays();
+   MakeGeometry(kFALSE);
+   TrackRays(gGeoManager->GetCurrentNavigator(), 0, 1, gLenRef, gPathRef);
+   delete gGeoManager;
+
+   TestBVH();
+   TestVoxelThreads();
+   TestHistory();
+   TestThreads();
+   TestThreadTurnover();
+
+   gBenchmark->Stop("stressGeoParallel");
+   gBenchmark->Print("stressGeoParallel");
+}
@@ -6453,3 +6453,644 @@ public:
   }
 } ;
 
+//////////////////////////////////////////////////////////////////////////
+//
+// 'PERFORMANCE' RooFit test #901
+// 
+// Likelihood evaluated in batches of events must be identical to the
+// likelihood evaluated event by event
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooExponential.h"
+#include "RooPolynomial.h"
+#include "RooProdPdf.h"
+#include "RooAddPdf.h"
+#include "RooFitResult.h"
+#include "TMath.h"
+
+using namespace RooFit ;
+
+
+class TestBasic901 : public RooUnitTest
+{
+public: 
+  TestBasic901(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Batch evaluation of likelihood",refFile,writeRef,verbose) {} ;
+  Bool_t testCode() {
+
+  // C r e a t e   m o d e l
+  // -----------------------
+
+  RooRealVar x("x","x",-10,10) ;
+  RooRealVar y("y","y",-10,10) ;
+
+  // Signal: product of gaussians in x and y
+  RooRealVar mx("mx","mx",1,-10,10) ;
+  RooRealVar sx("sx","sx",2,0.1,10) ;
+  RooGaussian gx("gx","gx",x,mx,sx) ;
+  RooRealVar my("my","my",-1,-10,10) ;
+  RooRealVar sy("sy","sy",3,0.1,10) ;
+  RooGaussian gy("gy","gy",y,my,sy) ;
+  RooProdPdf sig("sig","sig",RooArgSet(gx,gy)) ;
+
+  // Background: exponential in x times polynomial in y
+  RooRealVar c("c","c",-0.1,-1,1) ;
+  RooExponential ex("ex","ex",x,c) ;
+  RooRealVar a1("a1","a1",0.01,-0.1,0.1) ;
+  RooRealVar a2("a2","a2",0.005,0,0.1) ;
+  RooPolynomial py("py","py",y,RooArgList(a1,a2)) ;
+  RooProdPdf bkg("bkg","bkg",RooArgSet(ex,py)) ;
+
+  RooRealVar f("f","f",0.4,0.,1.) ;
+  RooAddPdf model("model","model",RooArgList(sig,bkg),f) ;
+
+  RooDataSet* data = model.generate(RooArgSet(x,y),5000) ;
+
+
+  // C o m p a r e   l i k e l i h o o d s
+  // ---------------------------------------
+
+  RooAbsReal* nll = model.createNLL(*data) ;
+  RooAbsReal* nllBatch = model.createNLL(*data,BatchMode()) ;
+
+  // Change the parameters one at a time, as MINUIT does
+  RooRealVar* pars[8] = { &mx, &sx, &my, &sy, &c, &a1, &a2, &f } ;
+  Double_t shifts[8] = { 0.3, -0.5, 0.2, 0.4, -0.05, 0.02, 0.01, 0.15 } ;
+  Bool_t ok = compare(*nll,*nllBatch,"nominal") ;
+  for (Int_t i=0 ; i<8 ; i++) {
+    pars[i]->setVal(pars[i]->getVal()+shifts[i]) ;
+    ok &= compare(*nll,*nllBatch,pars[i]->GetName()) ;
+  }
+
+  // The fits must then give the same results
+  RooArgSet* params = model.getParameters(*data) ;
+  RooArgSet* init = (RooArgSet*) params->snapshot() ;
+  RooFitResult* r = model.fitTo(*data,Save(),PrintLevel(-1)) ;
+  *params = *init ;
+  RooFitResult* rBatch = model.fitTo(*data,Save(),PrintLevel(-1),BatchMode()) ;
+  if (!rBatch->isIdentical(*r,1e-6,1e-4)) {
+    cout << "TestBasic901 ERROR: fit results in batch mode differ" << endl ;
+    ok = kFALSE ;
+  }
+
+  delete r ;
+  delete rBatch ;
+  delete init ;
+  delete params ;
+  delete nll ;
+  delete nllBatch ;
+  delete data ;
+
+  return ok ;
+  }
+
+  Bool_t compare(RooAbsReal& ref, RooAbsReal& test, const char* label) {
+    Double_t vref = ref.getVal() ;
+    Double_t v = test.getVal() ;
+    if (TMath::Abs(v-vref)>1e-12*TMath::Abs(vref)) {
+      cout << "TestBasic901 ERROR: likelihood after changing " << label << " is " << v << " in batch mode, " << vref << " otherwise" << endl ;
+      return kFALSE ;
+    }
+    return kTRUE ;
+  }
+} ;
+//////////////////////////////////////////////////////////////////////////
+//
+// 'PERFORMANCE' RooFit test #902
+// 
+// Likelihood evaluated in several threads must agree with the likelihood
+// evaluated in a single thread
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooCategory.h"
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooPolynomial.h"
+#include "RooAddPdf.h"
+#include "RooSimultaneous.h"
+#include "TMath.h"
+
+using namespace RooFit ;
+
+
+class TestBasic902 : public RooUnitTest
+{
+public: 
+  TestBasic902(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Multi-threaded likelihood",refFile,writeRef,verbose) {} ;
+  Bool_t testCode() {
+
+  // C r e a t e   s i m u l t a n e o u s   m o d e l
+  // ---------------------------------------------------
+
+  RooRealVar x("x","x",-8,8) ;
+
+  RooRealVar mean("mean","mean",0,-8,8) ;
+  RooRealVar sigma("sigma","sigma",0.3,0.1,10) ;
+  RooGaussian gx("gx","gx",x,mean,sigma) ;
+  RooRealVar a0("a0","a0",-0.1,-1,1) ;
+  RooPolynomial px("px","px",x,a0) ;
+  RooRealVar f("f","f",0.2,0.,1.) ;
+  RooAddPdf model("model","model",RooArgList(gx,px),f) ;
+
+  RooRealVar sigma_ctl("sigma_ctl","sigma_ctl",0.5,0.1,10) ;
+  RooGaussian gx_ctl("gx_ctl","gx_ctl",x,mean,sigma_ctl) ;
+  RooRealVar a0_ctl("a0_ctl","a0_ctl",-0.1,-1,1) ;
+  RooPolynomial px_ctl("px_ctl","px_ctl",x,a0_ctl) ;
+  RooRealVar f_ctl("f_ctl","f_ctl",0.5,0.,1.) ;
+  RooAddPdf model_ctl("model_ctl","model_ctl",RooArgList(gx_ctl,px_ctl),f_ctl) ;
+
+  RooCategory sample("sample","sample") ;
+  sample.defineType("physics") ;
+  sample.defineType("control") ;
+
+  RooSimultaneous simPdf("simPdf","simPdf",sample) ;
+  simPdf.addPdf(model,"physics") ;
+  simPdf.addPdf(model_ctl,"control") ;
+
+  RooDataSet* data = model.generate(x,5000) ;
+  RooDataSet* data_ctl = model_ctl.generate(x,2000) ;
+  RooDataSet combData("combData","combData",x,Index(sample),Import("physics",*data),Import("control",*data_ctl)) ;
+
+
+  // C o m p a r e   l i k e l i h o o d s
+  // ---------------------------------------
+
+  // The partition sums are added in a different order, allow for rounding
+  RooAbsReal* nll = model.createNLL(*data) ;
+  RooAbsReal* nllMT = model.createNLL(*data,NumThreads(4)) ;
+  RooAbsReal* nllMTBatch = model.createNLL(*data,NumThreads(3),BatchMode()) ;
+  RooAbsReal* nllSim = simPdf.createNLL(combData) ;
+  RooAbsReal* nllSimMT = simPdf.createNLL(combData,NumThreads(3)) ;
+
+  RooRealVar* pars[6] = { &mean, &sigma, &a0, &f, &sigma_ctl, &f_ctl } ;
+  Double_t shifts[6] = { 0.1, 0.05, 0.05, 0.1, -0.1, -0.2 } ;
+  Bool_t ok(kTRUE) ;
+  for (Int_t i=-1 ; i<6 ; i++) {
+    if (i>=0) pars[i]->setVal(pars[i]->getVal()+shifts[i]) ;
+    const char* label = (i>=0) ? pars[i]->GetName() : "nominal" ;
+    ok &= compare(*nll,*nllMT,label) ;
+    ok &= compare(*nll,*nllMTBatch,label) ;
+    ok &= compare(*nllSim,*nllSimMT,label) ;
+  }
+
+  delete nll ;
+  delete nllMT ;
+  delete nllMTBatch ;
+  delete nllSim ;
+  delete nllSimMT ;
+  delete data ;
+  delete data_ctl ;
+
+  return ok ;
+  }
+
+  Bool_t compare(RooAbsReal& ref, RooAbsReal& test, const char* label) {
+    Double_t vref = ref.getVal() ;
+    Double_t v = test.getVal() ;
+    if (TMath::Abs(v-vref)>1e-10*TMath::Abs(vref)) {
+      cout << "TestBasic902 ERROR: likelihood " << test.GetName() << " after changing " << label << " is " << v 
+	   << " in multi-threaded mode, " << vref << " in a single thread" << endl ;
+      return kFALSE ;
+    }
+    return kTRUE ;
+  }
+} ;
+//////////////////////////////////////////////////////////////////////////
+//
+// 'PERFORMANCE' RooFit test #903
+// 
+// Likelihood with cached and tracked product components must be identical
+// to the likelihood without constant term optimization
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooExponential.h"
+#include "RooPolynomial.h"
+#include "RooProdPdf.h"
+#include "RooAddPdf.h"
+#include "RooAbsTestStatistic.h"
+#include "TMath.h"
+
+using namespace RooFit ;
+
+
+class TestBasic903 : public RooUnitTest
+{
+public: 
+  TestBasic903(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Cache-and-track optimization of likelihood",refFile,writeRef,verbose) {} ;
+  Bool_t testCode() {
+
+  // C r e a t e   m o d e l
+  // -----------------------
+
+  // The signal and background products depend on the observables and on some,
+  // but not all, of the floating parameters: they are tracked by Optimize(2)
+  RooRealVar x("x","x",-10,10) ;
+  RooRealVar y("y","y",-10,10) ;
+
+  RooRealVar mx("mx","mx",1,-10,10) ;
+  RooRealVar sx("sx","sx",2,0.1,10) ;
+  RooGaussian gx("gx","gx",x,mx,sx) ;
+  RooRealVar my("my","my",-1,-10,10) ;
+  RooRealVar sy("sy","sy",3,0.1,10) ;
+  RooGaussian gy("gy","gy",y,my,sy) ;
+  RooProdPdf sig("sig","sig",RooArgSet(gx,gy)) ;
+
+  RooRealVar c("c","c",-0.1,-1,1) ;
+  RooExponential ex("ex","ex",x,c) ;
+  RooRealVar a1("a1","a1",0.01,-0.1,0.1) ;
+  RooPolynomial py("py","py",y,a1) ;
+  RooProdPdf bkg("bkg","bkg",RooArgSet(ex,py)) ;
+
+  RooRealVar f("f","f",0.4,0.,1.) ;
+  RooAddPdf model("model","model",RooArgList(sig,bkg),f) ;
+
+  RooDataSet* data = model.generate(RooArgSet(x,y),5000) ;
+
+
+  // C o m p a r e   l i k e l i h o o d s
+  // ---------------------------------------
+
+  RooAbsReal* nll0 = model.createNLL(*data,Optimize(0)) ;
+  RooAbsReal* nll1 = model.createNLL(*data,Optimize(1)) ;
+  RooAbsReal* nll2 = model.createNLL(*data,Optimize(2)) ;
+
+  // Change the parameters one at a time as in the numerical gradient, then
+  // all together, then go back to the nominal values
+  RooRealVar* pars[7] = { &mx, &sx, &my, &sy, &c, &a1, &f } ;
+  Double_t shifts[7] = { 0.3, -0.5, 0.2, 0.4, -0.05, 0.02, 0.15 } ;
+  Bool_t ok(kTRUE) ;
+  Int_t i ;
+  for (i=0 ; i<7 ; i++) {
+    pars[i]->setVal(pars[i]->getVal()+shifts[i]) ;
+    ok &= compare(*nll0,*nll1,*nll2,pars[i]->GetName()) ;
+    pars[i]->setVal(pars[i]->getVal()-shifts[i]) ;
+    ok &= compare(*nll0,*nll1,*nll2,"nominal") ;
+  }
+  for (i=0 ; i<7 ; i++) {
+    pars[i]->setVal(pars[i]->getVal()+shifts[i]) ;
+  }
+  ok &= compare(*nll0,*nll1,*nll2,"all parameters") ;
+
+  if (_verb>0) {
+    ((RooAbsTestStatistic*)nll2)->printCacheStatistics(cout) ;
+  }
+
+  delete nll0 ;
+  delete nll1 ;
+  delete nll2 ;
+  delete data ;
+
+  return ok ;
+  }
+
+  Bool_t compare(RooAbsReal& nll0, RooAbsReal& nll1, RooAbsReal& nll2, const char* label) {
+    Double_t v0 = nll0.getVal() ;
+    Double_t v1 = nll1.getVal() ;
+    Double_t v2 = nll2.getVal() ;
+    if (TMath::Abs(v1-v0)>1e-12*TMath::Abs(v0) || TMath::Abs(v2-v0)>1e-12*TMath::Abs(v0)) {
+      cout << "TestBasic903 ERROR: likelihood after changing " << label << " is " << v0 << " without optimization, " 
+	   << v1 << " with constant term caching and " << v2 << " with cache-and-track" << endl ;
+      return kFALSE ;
+    }
+    return kTRUE ;
+  }
+} ;
+//////////////////////////////////////////////////////////////////////////
+//
+// 'PERFORMANCE' RooFit test #904
+// 
+// Studies run in local worker processes must give the same results for
+// any number of workers
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooWorkspace.h"
+#include "RooGenFitStudy.h"
+#include "RooStudyManager.h"
+
+using namespace RooFit ;
+
+
+class TestBasic904 : public RooUnitTest
+{
+public: 
+  TestBasic904(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Parallel studies in local processes",refFile,writeRef,verbose) {} ;
+  Bool_t testCode() {
+
+  // C r e a t e   m o d e l
+  // -----------------------
+
+  RooWorkspace w("w") ;
+  w.factory("Gaussian::g(x[-10,10],m[0,-10,10],s[2,0.1,10])") ;
+  w.factory("Polynomial::p(x,{a0[-0.05,-0.1,0.1]})") ;
+  w.factory("SUM::model(f[0.5,0,1]*g,p)") ;
+
+
+  // R u n   s t u d i e s
+  // ---------------------
+
+  // Same master seed with one and with three worker processes
+  RooGenFitStudy gfs1("gfs","gfs") ;
+  gfs1.setGenConfig("model","x",NumEvents(1000)) ;
+  gfs1.setFitConfig("model","x",PrintLevel(-1)) ;
+  RooStudyManager mgr1(w,gfs1) ;
+  mgr1.runLocal(9,1,4357) ;
+
+  RooGenFitStudy gfs3("gfs","gfs") ;
+  gfs3.setGenConfig("model","x",NumEvents(1000)) ;
+  gfs3.setFitConfig("model","x",PrintLevel(-1)) ;
+  RooStudyManager mgr3(w,gfs3) ;
+  mgr3.runLocal(9,3,4357) ;
+
+
+  // C o m p a r e   r e s u l t s
+  // -----------------------------
+
+  RooDataSet* d1 = gfs1.summaryData() ;
+  RooDataSet* d3 = gfs3.summaryData() ;
+  // Only converged fits are stored, but these must be the same experiments
+  if (!d1 || !d3 || d1->numEntries()==0 || d1->numEntries()!=d3->numEntries()) {
+    cout << "TestBasic904 ERROR: missing study results" << endl ;
+    return kFALSE ;
+  }
+  for (Int_t i=0 ; i<d1->numEntries() ; i++) {
+    const RooArgSet* row1 = d1->get(i) ;
+    const RooArgSet* row3 = d3->get(i) ;
+    TIterator* iter = row1->createIterator() ;
+    RooAbsArg* arg ;
+    while((arg=(RooAbsArg*)iter->Next())) {
+      RooRealVar* v1 = dynamic_cast<RooRealVar*>(arg) ;
+      RooRealVar* v3 = (RooRealVar*) row3->find(arg->GetName()) ;
+      if (v1 && (!v3 || v1->getVal()!=v3->getVal())) {
+	cout << "TestBasic904 ERROR: experiment " << i << " result " << arg->GetName() << " is " << v1->getVal()  
+	     << " with one worker, " << (v3 ? v3->getVal() : 0.) << " with three workers" << endl ;
+	delete iter ;
+	return kFALSE ;
+      }
+    }
+    delete iter ;
+  }
+
+  return kTRUE ;
+  }
+} ;
+//////////////////////////////////////////////////////////////////////////
+//
+// 'PERFORMANCE' RooFit test #905
+// 
+// Numeric integrals retrieved from the value cache and VEGAS integrals
+// evaluated in several threads must be identical to the ones calculated
+// without cache in a single thread
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooGenericPdf.h"
+#include "RooFormulaVar.h"
+#include "RooRealIntegral.h"
+#include "RooNumIntConfig.h"
+#include "RooRandom.h"
+
+using namespace RooFit ;
+
+
+class TestBasic905 : public RooUnitTest
+{
+public: 
+  TestBasic905(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Numeric integral cache and parallel VEGAS",refFile,writeRef,verbose) {} ;
+  Bool_t testCode() {
+
+  // C a c h e   o f   n u m e r i c   i n t e g r a l s
+  // ----------------------------------------------------
+
+  // p.d.f. without analytical integral
+  RooRealVar x("x","x",-5,5) ;
+  RooRealVar m("m","m",0,-5,5) ;
+  RooRealVar s("s","s",1,0.1,5) ;
+  RooRealVar a("a","a",0.1,0,1) ;
+  RooGenericPdf gp("gp","gp","exp(-0.5*(x-m)*(x-m)/(s*s))*(1+a*x*x)",RooArgList(x,m,s,a)) ;
+  x.setRange("low",-5,0) ;
+  x.setRange("high",0,5) ;
+
+  // Parameter values visited twice, as MINUIT does around the minimum
+  const Int_t nset = 4 ;
+  Double_t mvals[nset] = { 0, 0.5, 0, -0.3 } ;
+  Double_t svals[nset] = { 1, 1, 1.2, 0.8 } ;
+
+  Double_t ref[2*nset][2], val[2*nset][2] ;
+  RooRealIntegral::setNumCache(0) ;
+  evalIntegrals(gp,x,m,s,mvals,svals,nset,ref) ;
+  RooRealIntegral::setNumCache(10) ;
+  Int_t nhits = evalIntegrals(gp,x,m,s,mvals,svals,nset,val) ;
+  RooRealIntegral::setNumCache(0) ;
+
+  Bool_t ok(kTRUE) ;
+  for (Int_t i=0 ; i<2*nset ; i++) {
+    for (Int_t j=0 ; j<2 ; j++) {
+      if (val[i][j]!=ref[i][j]) {
+	cout << "TestBasic905 ERROR: integral " << j << " at step " << i << " is " << val[i][j] 
+	     << " with numeric value cache, " << ref[i][j] << " without" << endl ;
+	ok = kFALSE ;
+      }
+    }
+  }
+  if (nhits==0) {
+    cout << "TestBasic905 ERROR: numeric value cache was not used" << endl ;
+    ok = kFALSE ;
+  }
+
+
+  // V E G A S   w i t h   s e v e r a l   t h r e a d s
+  // ----------------------------------------------------
+
+  RooRealVar y("y","y",-5,5) ;
+  RooFormulaVar f2("f2","f2","exp(-(x*x+y*y)/4)*(1+0.3*x*y)",RooArgList(x,y)) ;
+  Double_t vegas1 = vegasIntegral(f2,x,y,1) ;
+  Double_t vegas4 = vegasIntegral(f2,x,y,4) ;
+  if (vegas4!=vegas1) {
+    cout << "TestBasic905 ERROR: VEGAS integral is " << vegas4 << " in 4 threads, " << vegas1 << " in a single thread" << endl ;
+    ok = kFALSE ;
+  }
+
+  return ok ;
+  }
+
+  Int_t evalIntegrals(RooAbsPdf& pdf, RooRealVar& x, RooRealVar& m, RooRealVar& s, 
+		      const Double_t* mvals, const Double_t* svals, Int_t nset, Double_t values[][2]) {
+    // Evaluate the integrals over two ranges for the parameter values, twice, and return the number of cache hits
+    RooAbsReal* ilow = pdf.createIntegral(x,"low") ;
+    RooAbsReal* ihigh = pdf.createIntegral(x,"high") ;
+    for (Int_t i=0 ; i<2*nset ; i++) {
+      m.setVal(mvals[i%nset]) ;
+      s.setVal(svals[i%nset]) ;
+      values[i][0] = ilow->getVal() ;
+      values[i][1] = ihigh->getVal() ;
+    }
+    Int_t nhits(0) ;
+    RooRealIntegral* rilow = dynamic_cast<RooRealIntegral*>(ilow) ;
+    RooRealIntegral* rihigh = dynamic_cast<RooRealIntegral*>(ihigh) ;
+    if (rilow) nhits += rilow->numCacheHits() ;
+    if (rihigh) nhits += rihigh->numCacheHits() ;
+    delete ilow ;
+    delete ihigh ;
+    return nhits ;
+  }
+
+  Double_t vegasIntegral(RooAbsReal& func, RooRealVar& x, RooRealVar& y, Int_t nThreads) {
+    // Integrate func over x and y with VEGAS using nThreads threads
+    RooNumIntConfig cfg(*RooAbsReal::defaultIntegratorConfig()) ;
+    cfg.method2D().setLabel("RooMCIntegrator") ;
+    cfg.getConfigSection("RooMCIntegrator").setCatLabel("genType","PseudoRandom") ;
+    cfg.getConfigSection("RooMCIntegrator").setRealValue("nThreads",nThreads) ;
+    RooRandom::randomGenerator()->SetSeed(4357) ;
+    RooAbsReal* integral = func.createIntegral(RooArgSet(x,y),cfg) ;
+    Double_t val = integral->getVal() ;
+    delete integral ;
+    return val ;
+  }
+} ;
+//////////////////////////////////////////////////////////////////////////
+//
+// 'PERFORMANCE' RooFit test #906
+// 
+// Hashed name lookups in large collections and workspaces must find the
+// same objects as a linear search, also after renaming and removing
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooArgSet.h"
+#include "RooWorkspace.h"
+#include <vector>
+
+using namespace RooFit ;
+
+
+class TestBasic906 : public RooUnitTest
+{
+public: 
+  TestBasic906(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Hashed lookups in large collections",refFile,writeRef,verbose) {} ;
+  Bool_t testCode() {
+
+  // L a r g e   c o l l e c t i o n
+  // -------------------------------
+
+  // Well above the size at which the collection starts hashing
+  const Int_t nvar = 200 ;
+  std::vector<RooRealVar*> vars ;
+  RooArgSet big("big") ;
+  Int_t i ;
+  for (i=0 ; i<nvar ; i++) {
+    vars.push_back(new RooRealVar(Form("v%d",i),Form("v%d",i),i)) ;
+    big.add(*vars.back()) ;
+  }
+  Bool_t ok = compareLookups(big,"initial") ;
+
+  // Rename some members
+  for (i=0 ; i<nvar ; i+=17) {
+    vars[i]->SetName(Form("renamed%d",i)) ;
+  }
+  ok &= compareLookups(big,"after renaming") ;
+
+  // Copy
+  RooArgSet copy(big,"copy") ;
+  ok &= compareLookups(copy,"copy") ;
+
+  // Remove some members
+  for (i=5 ; i<nvar ; i+=11) {
+    big.remove(*vars[i]) ;
+  }
+  ok &= compareLookups(big,"after removing") ;
+
+  // Adding an object with the name of a member must be refused
+  RooRealVar dup("v1","duplicate",0) ;
+  Int_t size = big.getSize() ;
+  big.add(dup,kTRUE) ;
+  if (big.getSize()!=size || big.find("v1")!=vars[1]) {
+    cout << "TestBasic906 ERROR: duplicate name was added to the collection" << endl ;
+    ok = kFALSE ;
+  }
+
+
+  // L a r g e   w o r k s p a c e
+  // -----------------------------
+
+  RooWorkspace w("w") ;
+  for (i=0 ; i<nvar ; i++) {
+    w.import(RooRealVar(Form("w%d",i),Form("w%d",i),i),Silence()) ;
+  }
+  for (i=0 ; i<nvar ; i++) {
+    RooRealVar* v = w.var(Form("w%d",i)) ;
+    if (!v || v->getVal()!=i) {
+      cout << "TestBasic906 ERROR: workspace lookup of w" << i << " failed" << endl ;
+      ok = kFALSE ;
+    }
+  }
+  if (w.var("w-1") || w.var("v0")) {
+    cout << "TestBasic906 ERROR: workspace lookup found an object that was not imported" << endl ;
+    ok = kFALSE ;
+  }
+
+  for (i=0 ; i<nvar ; i++) {
+    delete vars[i] ;
+  }
+
+  return ok ;
+  }
+
+  RooAbsArg* linearFind(const RooAbsCollection& coll, const char* name) {
+    // Reference lookup by linear search
+    TIterator* iter = coll.createIterator() ;
+    RooAbsArg* arg ;
+    while((arg=(RooAbsArg*)iter->Next())) {
+      if (!strcmp(arg->GetName(),name)) break ;
+    }
+    delete iter ;
+    return arg ;
+  }
+
+  Bool_t compareLookups(const RooAbsCollection& coll, const char* label) {
+    // Compare the lookups of all original and renamed names with a linear search
+    for (Int_t i=0 ; i<200 ; i++) {
+      TString vname(Form("v%d",i)) ;
+      TString rname(Form("renamed%d",i)) ;
+      const char* lookup[2] = { vname.Data(), rname.Data() } ;
+      for (Int_t j=0 ; j<2 ; j++) {
+	if (coll.find(lookup[j])!=linearFind(coll,lookup[j])) {
+	  cout << "TestBasic906 ERROR: lookup of " << lookup[j] << " " << label << " differs from linear search" << endl ;
+	  return kFALSE ;
+	}
+      }
+    }
+    return kTRUE ;
+  }
+} ;
@@ -185,6 +185,11 @@ Int_t stressRooStats(const char* refFile, Bool_t writeRef, Int_t verbose, Bool_t
    testList.push_back(new TestHypoTestInverter2(fref, writeRef, verbose, kFrequentist, kRatioLR));
    testList.push_back(new TestHypoTestInverter2(fref, writeRef, verbose, kFrequentist, kProfileLROneSided));
    testList.push_back(new TestHypoTestInverter2(fref, writeRef, verbose, kHybrid, kSimpleLR));
+
+   // TEST HISTFACTORY BATCH EVALUATION : interpolation codes 0 to 5 of PiecewiseInterpolation
+   for (Int_t code = 0; code <= 5; ++code) {
+      testList.push_back(new TestHistFactoryBatch(fref, writeRef, verbose, code));
+   }
  
    
    TString suiteType = TString::Format(" Starting S.T.R.E.S.S. %s",
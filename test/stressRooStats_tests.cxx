@@ -1708,6 +1708,153 @@ public:
 
 
 
+//_____________________________________________________________________________
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+//
+// PART SIX:
+//    HISTFACTORY BATCH EVALUATION UNIT TESTS
+//
+
+#include "TH1.h"
+#include "RooDataHist.h"
+#include "RooHistFunc.h"
+#include "RooProduct.h"
+#include "RooRealSumPdf.h"
+#include "RooWorkspace.h"
+#include "RooStats/HistFactory/PiecewiseInterpolation.h"
+#include "RooStats/HistFactory/ParamHistFunc.h"
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// HISTFACTORY MODEL - BATCH EVALUATION OF THE LIKELIHOOD
+//
+// Test that the likelihood of a HistFactory-like model evaluated in batches
+// of events is identical to the likelihood evaluated event by event. The
+// model is the sum of a signal template with a shape systematic, scaled by
+// the signal strength, and a background template with a shape systematic
+// and one statistical uncertainty parameter per bin.
+//
+// ModelConfig (implicit) :
+//    Observable -> x
+//    Parameters -> mu, alpha_sig, alpha_bkg, gamma_stat_bin_i
+//
+// Input Parameters:
+//    interpCode -> interpolation code of the shape systematics
+//
+///////////////////////////////////////////////////////////////////////////////
+
+class TestHistFactoryBatch : public RooUnitTest {
+private:
+   Int_t fInterpCode;
+
+public:
+   TestHistFactoryBatch(
+      TFile* refFile,
+      Bool_t writeRef,
+      Int_t verbose,
+      Int_t interpCode
+   ) :
+      RooUnitTest(TString::Format("HistFactory Batch Evaluation - Interpolation Code %d", interpCode), refFile, writeRef, verbose),
+      fInterpCode(interpCode)
+   {};
+
+   Bool_t testCode() {
+
+      const Int_t nbins = 20;
+      RooRealVar x("x", "x", 0, 20);
+      x.setBins(nbins);
+
+      // Nominal and varied templates
+      TH1D hsig("hsig", "hsig", nbins, 0, 20), hsigLow("hsigLow", "hsigLow", nbins, 0, 20), hsigHigh("hsigHigh", "hsigHigh", nbins, 0, 20);
+      TH1D hbkg("hbkg", "hbkg", nbins, 0, 20), hbkgLow("hbkgLow", "hbkgLow", nbins, 0, 20), hbkgHigh("hbkgHigh", "hbkgHigh", nbins, 0, 20);
+      for (Int_t i = 1; i <= nbins; ++i) {
+         Double_t c = hsig.GetBinCenter(i);
+         hsig.SetBinContent(i, 100 * TMath::Gaus(c, 10, 2));
+         hsigLow.SetBinContent(i, 90 * TMath::Gaus(c, 9.5, 2));
+         hsigHigh.SetBinContent(i, 115 * TMath::Gaus(c, 10.5, 2.2));
+         hbkg.SetBinContent(i, 50 - c);
+         hbkgLow.SetBinContent(i, 45 - 0.8 * c);
+         hbkgHigh.SetBinContent(i, 52 - 1.1 * c);
+      }
+      TH1D* hists[6] = { &hsig, &hsigLow, &hsigHigh, &hbkg, &hbkgLow, &hbkgHigh };
+      RooDataHist* dhists[6];
+      RooHistFunc* hfuncs[6];
+      for (Int_t j = 0; j < 6; ++j) {
+         dhists[j] = new RooDataHist(TString::Format("d%s", hists[j]->GetName()), "", x, hists[j]);
+         hfuncs[j] = new RooHistFunc(TString::Format("f%s", hists[j]->GetName()), "", x, *dhists[j]);
+      }
+
+      // Shape systematics
+      RooRealVar alpha_sig("alpha_sig", "alpha_sig", 0, -5, 5);
+      RooRealVar alpha_bkg("alpha_bkg", "alpha_bkg", 0, -5, 5);
+      PiecewiseInterpolation sigInterp("sigInterp", "sigInterp", *hfuncs[0], RooArgList(*hfuncs[1]), RooArgList(*hfuncs[2]), RooArgList(alpha_sig));
+      PiecewiseInterpolation bkgInterp("bkgInterp", "bkgInterp", *hfuncs[3], RooArgList(*hfuncs[4]), RooArgList(*hfuncs[5]), RooArgList(alpha_bkg));
+      sigInterp.setPositiveDefinite();
+      bkgInterp.setPositiveDefinite();
+      sigInterp.setAllInterpCodes(fInterpCode);
+      bkgInterp.setAllInterpCodes(fInterpCode);
+
+      // Statistical uncertainties of the background
+      RooWorkspace w("w");
+      RooArgList gammas = ParamHistFunc::createParamSet(w, "gamma_stat", RooArgList(x), 0, 5);
+      ParamHistFunc bkgStat("bkgStat", "bkgStat", RooArgList(x), gammas);
+      RooProduct bkgShape("bkgShape", "bkgShape", RooArgList(bkgInterp, bkgStat));
+
+      RooRealVar mu("mu", "mu", 1, 0, 10);
+      RooRealVar one("one", "one", 1);
+      RooRealSumPdf model("model", "model", RooArgList(sigInterp, bkgShape), RooArgList(mu, one));
+
+      RooDataSet* data = model.generate(x, 2000);
+
+      RooAbsReal* nll = model.createNLL(*data);
+      RooAbsReal* nllBatch = model.createNLL(*data, BatchMode());
+
+      // Change the parameters one at a time, with the shape parameters on both
+      // sides of the nominal value and beyond the variations
+      RooRealVar* pars[7] = { &mu, &alpha_sig, &alpha_bkg, &alpha_sig, &alpha_bkg, (RooRealVar*)gammas.at(3), (RooRealVar*)gammas.at(12) };
+      Double_t vals[7] = { 1.5, 0.6, -0.4, -1.7, 2.3, 1.2, 0.8 };
+      Bool_t ok = compare(*nll, *nllBatch, "nominal");
+      for (Int_t i = 0; i < 7; ++i) {
+         pars[i]->setVal(vals[i]);
+         ok &= compare(*nll, *nllBatch, pars[i]->GetName());
+      }
+
+      delete nll;
+      delete nllBatch;
+      delete data;
+      for (Int_t j = 0; j < 6; ++j) {
+         delete hfuncs[j];
+         delete dhists[j];
+      }
+
+      return ok;
+   }
+
+   Bool_t compare(RooAbsReal &ref, RooAbsReal &test, const char *label) {
+      Double_t vref = ref.getVal();
+      Double_t v = test.getVal();
+      if (TMath::Abs(v - vref) > 1e-12 * TMath::Abs(vref)) {
+         std::cout << "TestHistFactoryBatch ERROR: likelihood after changing " << label << " is " << v
+              << " in batch mode, " << vref << " otherwise" << std::endl;
+         return kFALSE;
+      }
+      return kTRUE;
+   }
+};
+
+
+//
+// END OF PART SIX
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+//_____________________________________________________________________________
+
+
+
+
+
 
 
 
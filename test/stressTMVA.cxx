@@ -1288,6 +1288,610 @@ void utReader::run()
    reader[2]->EvaluateMVA( "LD method");
    test_(1>0);
 }
+// including file tmvaut/utModulekNN.h
+#ifndef UTMODULEKNN_H
+#define UTMODULEKNN_H
+
+// TMVA unit tests
+//
+// this class compares the nearest neighbours found in the kd-tree of
+// kNN::ModulekNN, built and searched with several threads, with a
+// linear search over all events
+
+#include <vector>
+
+#include "TMVA/ModulekNN.h"
+
+namespace UnitTesting
+{
+   class utModulekNN : public UnitTest
+   {
+   public:
+      utModulekNN();
+      virtual ~utModulekNN();
+
+      virtual void run();
+
+   private:
+      // sorted distances of the neighbours in a search result
+      void getDistances(const TMVA::kNN::List& list, std::vector<TMVA::kNN::VarType>& dist) const;
+
+      // disallow copy constructor and assignment
+      utModulekNN(const utModulekNN&);
+      utModulekNN& operator=(const utModulekNN&);
+   };
+} // namespace UnitTesting
+#endif // UTMODULEKNN_H
+// including file tmvaut/utModulekNN.cxx
+
+#include <algorithm>
+
+#include "TRandom3.h"
+#include "TMVA/MsgLogger.h"
+
+using namespace std;
+using namespace UnitTesting;
+using namespace TMVA;
+
+utModulekNN::utModulekNN()
+   : UnitTest(string("ModulekNN"))
+{
+}
+
+utModulekNN::~utModulekNN()
+{
+}
+
+void utModulekNN::getDistances(const kNN::List& list, std::vector<kNN::VarType>& dist) const
+{
+   dist.clear();
+   for (kNN::List::const_iterator it = list.begin(); it != list.end(); ++it) dist.push_back( it->second );
+   std::sort( dist.begin(), dist.end() );
+}
+
+void utModulekNN::run()
+{
+   MsgLogger::InhibitOutput();
+
+   // more than 10000 events, such that the kd-tree is built in threads
+   const UInt_t nvar = 3, nevents = 30000, nquery = 200, nfind = 20;
+   TRandom3 rndm( 4357 );
+   kNN::EventVec events, queries;
+   kNN::VarVec vars( nvar );
+   for (UInt_t ievt=0; ievt<nevents+nquery; ievt++) {
+      for (UInt_t ivar=0; ivar<nvar; ivar++) vars[ivar] = rndm.Gaus( 0., 1.+ivar );
+      if (ievt < nevents) events.push_back( kNN::Event( vars, 1., ievt%2 ) );
+      else                queries.push_back( kNN::Event( vars, 1., 0 ) );
+   }
+
+   kNN::ModulekNN knn;
+   knn.SetNThreads( 4 );
+   for (UInt_t ievt=0; ievt<nevents; ievt++) knn.Add( events[ievt] );
+   test_( knn.Fill( 6, 0 ) );
+
+   // the single event search must find the events closest to the query
+   Int_t nbad = 0;
+   std::vector< std::vector<kNN::VarType> > found( nquery );
+   std::vector<kNN::VarType> all( nevents );
+   for (UInt_t iq=0; iq<nquery; iq++) {
+      knn.Find( queries[iq], nfind );
+      getDistances( knn.GetkNNList(), found[iq] );
+      for (UInt_t ievt=0; ievt<nevents; ievt++) all[ievt] = queries[iq].GetDist( events[ievt] );
+      std::partial_sort( all.begin(), all.begin()+nfind, all.end() );
+      if (found[iq].size() != nfind || !std::equal( found[iq].begin(), found[iq].end(), all.begin() )) nbad++;
+   }
+   test_( nbad == 0 );
+
+   // the search for all events at once in threads must find the same neighbours
+   std::vector<kNN::List> results;
+   test_( knn.Find( queries, nfind, results ) );
+   test_( results.size() == nquery );
+   nbad = 0;
+   std::vector<kNN::VarType> dist;
+   for (UInt_t iq=0; iq<results.size(); iq++) {
+      getDistances( results[iq], dist );
+      if (dist != found[iq]) nbad++;
+   }
+   test_( nbad == 0 );
+}
+// including file tmvaut/utTransformationHandler.h
+#ifndef UTTRANSFORMATIONHANDLER_H
+#define UTTRANSFORMATIONHANDLER_H
+
+// TMVA unit tests
+//
+// this class checks that the events returned by
+// TransformationHandler::CalcTransformations are new copies, transformed
+// in the same way as single events, and that the input events are left
+// unchanged
+
+#include <vector>
+
+#include "TMVA/Event.h"
+
+namespace UnitTesting
+{
+   class utTransformationHandler : public UnitTest
+   {
+   public:
+      utTransformationHandler();
+      virtual ~utTransformationHandler();
+
+      virtual void run();
+
+   private:
+      // true if both events have the same variable values
+      bool equalValues(const TMVA::Event& ev1, const TMVA::Event& ev2) const;
+      void deleteEvents(const std::vector<TMVA::Event*>* events) const;
+
+      // disallow copy constructor and assignment
+      utTransformationHandler(const utTransformationHandler&);
+      utTransformationHandler& operator=(const utTransformationHandler&);
+   };
+} // namespace UnitTesting
+#endif // UTTRANSFORMATIONHANDLER_H
+// including file tmvaut/utTransformationHandler.cxx
+
+#include "TRandom3.h"
+#include "TMVA/DataSetInfo.h"
+#include "TMVA/MsgLogger.h"
+#include "TMVA/TransformationHandler.h"
+#include "TMVA/VariableNormalizeTransform.h"
+#include "TMVA/VariableDecorrTransform.h"
+#include "TMVA/VariablePCATransform.h"
+
+using namespace std;
+using namespace UnitTesting;
+using namespace TMVA;
+
+utTransformationHandler::utTransformationHandler()
+   : UnitTest(string("TransformationHandler"))
+{
+}
+
+utTransformationHandler::~utTransformationHandler()
+{
+}
+
+bool utTransformationHandler::equalValues(const Event& ev1, const Event& ev2) const
+{
+   if (ev1.GetNVariables() != ev2.GetNVariables()) return false;
+   for (UInt_t ivar=0; ivar<ev1.GetNVariables(); ivar++) {
+      if (ev1.GetValue(ivar) != ev2.GetValue(ivar)) return false;
+   }
+   return true;
+}
+
+void utTransformationHandler::deleteEvents(const std::vector<Event*>* events) const
+{
+   if (!events) return;
+   for (UInt_t ievt=0; ievt<events->size(); ievt++) delete (*events)[ievt];
+   delete events;
+}
+
+void utTransformationHandler::run()
+{
+   MsgLogger::InhibitOutput();
+
+   const UInt_t nvar = 3, nevents = 1000;
+   DataSetInfo dsi( "utTransformationHandler" );
+   dsi.AddVariable( "var0" );
+   dsi.AddVariable( "var1" );
+   dsi.AddVariable( "var2" );
+   dsi.AddClass( "Signal" );
+   dsi.AddClass( "Background" );
+
+   // correlated variables with different offsets for the two classes
+   TRandom3 rndm( 4357 );
+   std::vector<Event*> events, originals;
+   std::vector<Float_t> vars( nvar );
+   for (UInt_t ievt=0; ievt<nevents; ievt++) {
+      Float_t x = rndm.Gaus( ievt%2 ? -0.5 : 0.5, 1. );
+      for (UInt_t ivar=0; ivar<nvar; ivar++) vars[ivar] = (ivar+1)*x + rndm.Gaus( 0., 0.5+ivar );
+      events.push_back( new Event( vars, ievt%2 ) );
+      originals.push_back( new Event( vars, ievt%2 ) );
+   }
+
+   // without transformations the input events are returned
+   TransformationHandler empty( dsi, "utEmpty" );
+   test_( empty.CalcTransformations( events, kTRUE ) == &events );
+
+   TransformationHandler handler( dsi, "utTransformationHandler" );
+   VariableTransformBase* trf = handler.AddTransformation( new VariableNormalizeTransform( dsi ), -1 );
+   trf->SelectInput( "_V_" );
+   trf = handler.AddTransformation( new VariableDecorrTransform( dsi ), -1 );
+   trf->SelectInput( "_V_" );
+   trf = handler.AddTransformation( new VariablePCATransform( dsi ), -1 );
+   trf->SelectInput( "_V_" );
+
+   const std::vector<Event*>* transformed = handler.CalcTransformations( events, kTRUE );
+   test_( transformed != 0 && transformed != &events );
+   if (!transformed || transformed == &events) return;
+   test_( transformed->size() == nevents );
+
+   // the returned events are copies, the input events are not modified and the
+   // values are those of the transformation of the single events
+   Int_t nshared = 0, nmodified = 0, nbad = 0;
+   for (UInt_t ievt=0; ievt<nevents && ievt<transformed->size(); ievt++) {
+      const Event* ev = (*transformed)[ievt];
+      for (UInt_t jevt=0; jevt<nevents; jevt++) {
+         if (ev == events[jevt]) { nshared++; break; }
+      }
+      if (!equalValues( *events[ievt], *originals[ievt] )) nmodified++;
+      if (!equalValues( *ev, *handler.Transform( originals[ievt] ) )) nbad++;
+      if (ev->GetClass() != events[ievt]->GetClass()) nbad++;
+   }
+   test_( nshared == 0 );
+   test_( nmodified == 0 );
+   test_( nbad == 0 );
+
+   // the transformations are created only once, a second call gives the same events
+   const std::vector<Event*>* again = handler.CalcTransformations( events, kTRUE );
+   test_( again != 0 && again != transformed && again->size() == transformed->size() );
+   nbad = 0;
+   for (UInt_t ievt=0; again && ievt<again->size() && ievt<transformed->size(); ievt++) {
+      if ((*again)[ievt] == (*transformed)[ievt] || !equalValues( *(*again)[ievt], *(*transformed)[ievt] )) nbad++;
+   }
+   test_( nbad == 0 );
+
+   // without a new vector nothing is returned
+   test_( handler.CalcTransformations( events, kFALSE ) == 0 );
+
+   deleteEvents( again );
+   deleteEvents( transformed );
+   for (UInt_t ievt=0; ievt<nevents; ievt++) {
+      delete events[ievt];
+      delete originals[ievt];
+   }
+}
+// including file tmvaut/utEventStore.h
+#ifndef UTEVENTSTORE_H
+#define UTEVENTSTORE_H
+
+// TMVA unit tests
+//
+// this class checks that events viewing an EventStore return the values
+// they had before being moved into the store (exactly in single precision,
+// rounded to half precision otherwise), that they keep viewing the store
+// when values are set or assigned, and that the transformations of such
+// events are stored in a new store
+
+#include <vector>
+
+#include "TMVA/Event.h"
+
+namespace UnitTesting
+{
+   class utEventStore : public UnitTest
+   {
+   public:
+      utEventStore();
+      virtual ~utEventStore();
+
+      virtual void run();
+
+   private:
+      // true if both events have the same variables, targets and spectators
+      bool equalEvents(const TMVA::Event& ev1, const TMVA::Event& ev2) const;
+      // the value x stored in half precision
+      Float_t half(Float_t x) const;
+
+      // disallow copy constructor and assignment
+      utEventStore(const utEventStore&);
+      utEventStore& operator=(const utEventStore&);
+   };
+} // namespace UnitTesting
+#endif // UTEVENTSTORE_H
+// including file tmvaut/utEventStore.cxx
+
+#include "TRandom3.h"
+#include "TMVA/DataSetInfo.h"
+#include "TMVA/EventStore.h"
+#include "TMVA/MsgLogger.h"
+#include "TMVA/TransformationHandler.h"
+#include "TMVA/VariableNormalizeTransform.h"
+#include "TMVA/VariableDecorrTransform.h"
+
+using namespace std;
+using namespace UnitTesting;
+using namespace TMVA;
+
+utEventStore::utEventStore()
+   : UnitTest(string("EventStore"))
+{
+}
+
+utEventStore::~utEventStore()
+{
+}
+
+bool utEventStore::equalEvents(const Event& ev1, const Event& ev2) const
+{
+   if (ev1.GetNVariables() != ev2.GetNVariables() || ev1.GetNTargets() != ev2.GetNTargets() ||
+       ev1.GetNSpectators() != ev2.GetNSpectators()) return false;
+   if (ev1.GetValues() != ev2.GetValues() || ev1.GetTargets() != ev2.GetTargets() ||
+       ev1.GetSpectators() != ev2.GetSpectators()) return false;
+   for (UInt_t ivar=0; ivar<ev1.GetNVariables(); ivar++) {
+      if (ev1.GetValue(ivar) != ev2.GetValue(ivar)) return false;
+   }
+   for (UInt_t itgt=0; itgt<ev1.GetNTargets(); itgt++) {
+      if (ev1.GetTarget(itgt) != ev2.GetTarget(itgt)) return false;
+   }
+   for (UInt_t ispc=0; ispc<ev1.GetNSpectators(); ispc++) {
+      if (ev1.GetSpectator(ispc) != ev2.GetSpectator(ispc)) return false;
+   }
+   return ev1.GetClass() == ev2.GetClass() && ev1.GetWeight() == ev2.GetWeight();
+}
+
+Float_t utEventStore::half(Float_t x) const
+{
+   return EventStore::HalfToFloat( EventStore::FloatToHalf( x ) );
+}
+
+void utEventStore::run()
+{
+   MsgLogger::InhibitOutput();
+
+   // half precision conversions
+   test_( EventStore::FloatToHalf( 1.f ) == 0x3c00 );
+   test_( EventStore::FloatToHalf( -2.f ) == 0xc000 );
+   test_( EventStore::FloatToHalf( 65504.f ) == 0x7bff );
+   test_( EventStore::FloatToHalf( 65520.f ) == 0x7c00 );
+   test_( EventStore::FloatToHalf( 1.f + 1.f/2048 ) == 0x3c00 );   // tie, rounded to even
+   test_( EventStore::FloatToHalf( 1.f + 3.f/2048 ) == 0x3c02 );   // tie, rounded to even
+   test_( EventStore::HalfToFloat( 0x0001 ) == TMath::Power( 2., -24 ) );
+   test_( EventStore::HalfToFloat( 0x3555 ) == Float_t(0x155 + 0x400)/0x400/4 );
+   Int_t nbad = 0;
+   for (UInt_t h=0; h<0x10000; h++) {
+      if ((h & 0x7c00) == 0x7c00 && (h & 0x3ff)) continue; // nan
+      if (EventStore::FloatToHalf( EventStore::HalfToFloat( h ) ) != h) nbad++;
+   }
+   test_( nbad == 0 );
+
+   const UInt_t nvar = 3, ntgt = 1, nspc = 2, nevents = 1000;
+   TRandom3 rndm( 4357 );
+   std::vector<Event*> events, originals;
+   std::vector<Float_t> vars( nvar ), tgts( ntgt ), spcs( nspc );
+   for (UInt_t ievt=0; ievt<nevents; ievt++) {
+      Float_t x = rndm.Gaus( ievt%2 ? -0.5 : 0.5, 1. );
+      for (UInt_t ivar=0; ivar<nvar; ivar++) vars[ivar] = (ivar+1)*x + rndm.Gaus( 0., 0.5+ivar );
+      tgts[0] = 100*x;
+      spcs[0] = ievt;
+      spcs[1] = rndm.Uniform();
+      events.push_back( new Event( vars, tgts, spcs, ievt%2, 0.5+rndm.Uniform() ) );
+      originals.push_back( new Event( *events.back() ) );
+   }
+
+   // single precision: the events give back the same values
+   EventStore* store = new EventStore( nevents, nvar, ntgt, nspc );
+   for (UInt_t ievt=0; ievt<nevents; ievt++) events[ievt]->MoveToStore( store, ievt );
+   test_( store->GetNBytes() == nevents*(nvar+ntgt+nspc)*sizeof(Float_t) );
+   Int_t nview = 0;
+   nbad = 0;
+   for (UInt_t ievt=0; ievt<nevents; ievt++) {
+      if (events[ievt]->IsView()) nview++;
+      if (!equalEvents( *events[ievt], *originals[ievt] )) nbad++;
+      if (store->GetColumn( 1 )[ievt] != originals[ievt]->GetValue( 1 )) nbad++;
+   }
+   test_( nview == Int_t(nevents) );
+   test_( nbad == 0 );
+
+   // setting values inside the store keeps the view, other changes leave the store
+   events[0]->SetVal( 1, 42.f );
+   events[0]->SetTarget( 0, -1.f );
+   test_( events[0]->IsView() && store->GetVariable( 0, 1 ) == 42.f && store->GetTarget( 0, 0 ) == -1.f );
+   *events[0] = *originals[0];
+   test_( events[0]->IsView() && equalEvents( *events[0], *originals[0] ) );
+   events[1]->SetTarget( 1, 3.f );
+   test_( !events[1]->IsView() && events[1]->GetNTargets() == 2 && events[1]->GetTarget( 1 ) == 3.f );
+   events[1]->SetTarget( 0, originals[1]->GetTarget( 0 ) );
+   test_( events[1]->GetValues() == originals[1]->GetValues() );
+
+   // the copy of a view holds its own values
+   Event copy( *events[2] );
+   test_( !copy.IsView() && equalEvents( copy, *originals[2] ) );
+   events[3]->GetValues()[0] = 7.f;
+   test_( !events[3]->IsView() && events[3]->GetValue( 0 ) == 7.f && store->GetVariable( 3, 0 ) == originals[3]->GetValue( 0 ) );
+
+   // the transformed events of views are views of a new store
+   DataSetInfo dsi( "utEventStore" );
+   dsi.AddVariable( "var0" );
+   dsi.AddVariable( "var1" );
+   dsi.AddVariable( "var2" );
+   dsi.AddTarget( "tgt0", "", "", 0, 0 );
+   dsi.AddSpectator( "spc0", "", "", 0, 0 );
+   dsi.AddSpectator( "spc1", "", "", 0, 0 );
+   dsi.AddClass( "Signal" );
+   dsi.AddClass( "Background" );
+   TransformationHandler handler( dsi, "utEventStore" );
+   VariableTransformBase* trf = handler.AddTransformation( new VariableNormalizeTransform( dsi ), -1 );
+   trf->SelectInput( "_V_" );
+   trf = handler.AddTransformation( new VariableDecorrTransform( dsi ), -1 );
+   trf->SelectInput( "_V_" );
+   std::vector<Event*> views( events.begin()+4, events.end() );
+   const std::vector<Event*>* transformed = handler.CalcTransformations( views, kTRUE );
+   test_( transformed != 0 && transformed->size() == views.size() );
+   nview = 0;
+   nbad = 0;
+   for (UInt_t ievt=0; transformed && ievt<transformed->size(); ievt++) {
+      if ((*transformed)[ievt]->IsView()) nview++;
+      if (!equalEvents( *(*transformed)[ievt], *handler.Transform( originals[ievt+4] ) )) nbad++;
+   }
+   test_( nview == Int_t(views.size()) );
+   test_( nbad == 0 );
+   for (UInt_t ievt=0; transformed && ievt<transformed->size(); ievt++) delete (*transformed)[ievt];
+   delete transformed;
+
+   for (UInt_t ievt=0; ievt<nevents; ievt++) delete events[ievt];
+   events.clear();
+
+   // half precision: the values are rounded, large values are counted as overflows
+   EventStore* halfStore = new EventStore( nevents, nvar, ntgt, nspc, kTRUE );
+   test_( halfStore->IsHalfPrecision() && halfStore->GetColumn( 0 ) == 0 );
+   test_( halfStore->GetNBytes() == nevents*(nvar+ntgt+nspc)*sizeof(UShort_t) );
+   nbad = 0;
+   for (UInt_t ievt=0; ievt<nevents; ievt++) {
+      Event* ev = new Event( *originals[ievt] );
+      ev->MoveToStore( halfStore, ievt );
+      for (UInt_t ivar=0; ivar<nvar; ivar++) {
+         Float_t x = originals[ievt]->GetValue( ivar );
+         if (ev->GetValue( ivar ) != half( x ) || TMath::Abs( ev->GetValue( ivar ) - x ) > TMath::Abs( x )/2048) nbad++;
+      }
+      if (ev->GetTarget( 0 ) != half( originals[ievt]->GetTarget( 0 ) )) nbad++;
+      if (ev->GetSpectator( 0 ) != half( ievt )) nbad++;
+      events.push_back( ev );
+   }
+   test_( nbad == 0 );
+   test_( halfStore->GetNOverflows() == 0 );
+   events[0]->SetSpectator( 1, 1.e5 );
+   test_( halfStore->GetNOverflows() == 1 && !TMath::Finite( events[0]->GetSpectator( 1 ) ) );
+
+   for (UInt_t ievt=0; ievt<nevents; ievt++) {
+      delete events[ievt];
+      delete originals[ievt];
+   }
+}
+// including file tmvaut/utPDEFoamDensity.h
+#ifndef UTPDEFOAMDENSITY_H
+#define UTPDEFOAMDENSITY_H
+
+// TMVA unit tests
+//
+// this class compares the densities of the PDEFoam density classes, found
+// by range searching in their kd-tree, with a linear search over all
+// events, and checks that the densities of many points evaluated at once
+// are the same as those of single points
+
+#include <vector>
+
+#include "TMVA/Event.h"
+
+namespace UnitTesting
+{
+   class utPDEFoamDensity : public UnitTest
+   {
+   public:
+      utPDEFoamDensity();
+      virtual ~utPDEFoamDensity();
+
+      virtual void run();
+
+   private:
+      // true if the event is inside the box placed at x
+      bool inBox(const TMVA::Event& ev, const std::vector<Double_t>& x, const std::vector<Double_t>& box) const;
+
+      // disallow copy constructor and assignment
+      utPDEFoamDensity(const utPDEFoamDensity&);
+      utPDEFoamDensity& operator=(const utPDEFoamDensity&);
+   };
+} // namespace UnitTesting
+#endif // UTPDEFOAMDENSITY_H
+// including file tmvaut/utPDEFoamDensity.cxx
+
+#include "TRandom3.h"
+#include "TMath.h"
+#include "TMVA/MsgLogger.h"
+#include "TMVA/PDEFoamEventDensity.h"
+#include "TMVA/PDEFoamDiscriminantDensity.h"
+#include "TMVA/PDEFoamTargetDensity.h"
+
+using namespace std;
+using namespace UnitTesting;
+using namespace TMVA;
+
+utPDEFoamDensity::utPDEFoamDensity()
+   : UnitTest(string("PDEFoamDensity"))
+{
+}
+
+utPDEFoamDensity::~utPDEFoamDensity()
+{
+}
+
+bool utPDEFoamDensity::inBox(const Event& ev, const std::vector<Double_t>& x, const std::vector<Double_t>& box) const
+{
+   // same bounds as the range searching: lower < value <= upper
+   for (UInt_t ivar=0; ivar<box.size(); ivar++) {
+      if (!(x[ivar] - box[ivar]/2.0 < ev.GetValue( ivar ) && x[ivar] + box[ivar]/2.0 >= ev.GetValue( ivar ))) return false;
+   }
+   return true;
+}
+
+void utPDEFoamDensity::run()
+{
+   MsgLogger::InhibitOutput();
+
+   // values on a grid, such that many events lie on the box boundaries
+   const UInt_t nvar = 3, nevents = 20000, npoints = 300;
+   TRandom3 rndm( 4357 );
+   std::vector<Double_t> box( nvar );
+   for (UInt_t ivar=0; ivar<nvar; ivar++) box[ivar] = 0.3 + 0.1*ivar;
+
+   PDEFoamEventDensity        eventDensity( box );
+   PDEFoamDiscriminantDensity discrDensity( box, 1 );
+   PDEFoamTargetDensity       targetDensity( box, 1 );
+   std::vector<Event*> events;
+   std::vector<Float_t> vars( nvar ), tgts( 2 );
+   for (UInt_t ievt=0; ievt<nevents; ievt++) {
+      for (UInt_t ivar=0; ivar<nvar; ivar++) vars[ivar] = rndm.Integer( 100 )/100.;
+      for (UInt_t itgt=0; itgt<tgts.size(); itgt++) tgts[itgt] = rndm.Uniform();
+      events.push_back( new Event( vars, tgts, ievt%2, 0.5 + rndm.Uniform() ) );
+      eventDensity.FillBinarySearchTree( events.back() );
+      discrDensity.FillBinarySearchTree( events.back() );
+      targetDensity.FillBinarySearchTree( events.back() );
+   }
+   test_( eventDensity.GetNEvents() == nevents );
+
+   // the first points are placed such that the box boundaries lie on the grid
+   std::vector<Double_t> points( npoints*nvar );
+   for (UInt_t ipt=0; ipt<npoints; ipt++) {
+      for (UInt_t ivar=0; ivar<nvar; ivar++) {
+         points[ipt*nvar+ivar] = ipt < 20 ? Float_t(rndm.Integer( 100 )/100.) + box[ivar]/2.0 : rndm.Uniform();
+      }
+   }
+   std::vector<Double_t> density( 3*npoints ), eventDens( 3*npoints );
+   eventDensity.DensityBatch( npoints, &points[0], &density[0], &eventDens[0] );
+   discrDensity.DensityBatch( npoints, &points[0], &density[npoints], &eventDens[npoints] );
+   targetDensity.DensityBatch( npoints, &points[0], &density[2*npoints], &eventDens[2*npoints] );
+
+   const Double_t volume_inv = 1.0/(box[0]*box[1]*box[2]);
+   Int_t nbadCount = 0, nbadDensity = 0, nbadBatch = 0;
+   for (UInt_t ipt=0; ipt<npoints; ipt++) {
+      std::vector<Double_t> x( points.begin() + ipt*nvar, points.begin() + (ipt+1)*nvar );
+
+      // linear search
+      UInt_t n = 0;
+      Double_t sumw = 0, sumsig = 0, sumtgt = 0;
+      for (UInt_t ievt=0; ievt<nevents; ievt++) {
+         if (!inBox( *events[ievt], x, box )) continue;
+         const Float_t w = events[ievt]->GetWeight();
+         n++;
+         sumw += w;
+         if (events[ievt]->GetClass() == 1) sumsig += w;
+         sumtgt += events[ievt]->GetTarget( 1 )*w;
+      }
+      const Double_t expected[3] = { (sumw + 0.1)*volume_inv,
+                                     (sumsig/(sumw + 0.1))*volume_inv,
+                                     (sumtgt/(sumw + 0.1))*volume_inv };
+
+      // single points
+      Double_t single[3], singleEvents[3];
+      single[0] = eventDensity.Density( x, singleEvents[0] );
+      single[1] = discrDensity.Density( x, singleEvents[1] );
+      single[2] = targetDensity.Density( x, singleEvents[2] );
+
+      for (UInt_t i=0; i<3; i++) {
+         if (singleEvents[i] != n*volume_inv) nbadCount++;
+         if (TMath::Abs( single[i] - expected[i] ) > 1.e-10*TMath::Abs( expected[i] )) nbadDensity++;
+         if (single[i] != density[i*npoints+ipt] || singleEvents[i] != eventDens[i*npoints+ipt]) nbadBatch++;
+      }
+   }
+   test_( nbadCount == 0 );
+   test_( nbadDensity == 0 );
+   test_( nbadBatch == 0 );
+
+   for (UInt_t ievt=0; ievt<nevents; ievt++) delete events[ievt];
+}
 // including file tmvaut/utFactory.h
 #ifndef UTFACTORY_H
 #define UTFACTORY_H
@@ -2480,6 +3084,9 @@ namespace UnitTesting
       virtual ~MethodUnitTestWithComplexData();
       
       virtual void run();
+
+      // writes the trees of the complex data set, also used by other tests
+      static bool create_data(const char* filename, int nmax=20000);
       
    protected:
       TTree*  theTree;
@@ -2498,7 +3105,6 @@ namespace UnitTesting
       double _ROCValue;
       
       bool ROCIntegralWithinInterval();
-      bool create_data(const char* filename, int nmax=20000);
       // disallow copy constructor and assignment
       MethodUnitTestWithComplexData(const MethodUnitTestWithComplexData&);
       MethodUnitTestWithComplexData& operator=(const MethodUnitTestWithComplexData&);
@@ -2690,6 +3296,540 @@ bool MethodUnitTestWithComplexData::create_data(const char* filename, int nmax)
    dataFile->Close();
    return true;
 }
+// including file tmvaut/MethodUnitTestWithEquivalence.h
+#ifndef METHODUNITTESTWITHEQUIVALENCE_H
+#define METHODUNITTESTWITHEQUIVALENCE_H
+
+// TMVA unit tests
+//
+// this class trains the method specified in the constructor twice on the
+// same events, once with a reference option string and once with the
+// option string to be tested (e.g. a different number of threads), and
+// checks that both give the same responses on the test sample; further
+// methods and different factory options can be given for options that
+// concern the training of several methods; for rectangular cuts, which
+// have no response, the optimised cuts and background efficiencies of
+// all signal efficiency bins are compared, and the background and
+// signal efficiencies of the cuts are recounted on the training sample
+
+#include <string>
+#include <vector>
+
+#include "TString.h"
+
+#include "TMVA/Types.h"
+
+namespace UnitTesting
+{
+   class MethodUnitTestWithEquivalence : public UnitTest
+   {
+   public:
+      MethodUnitTestWithEquivalence(const TMVA::Types::EMVA& theMethod, const TString& methodTitle,
+                                    const TString& refOption, const TString& theOption,
+                                    double maxDeviation = 0., const TString& prepareString = "",
+                                    const std::string & name="", const std::string & filename="", std::ostream* osptr = &std::cout);
+      virtual ~MethodUnitTestWithEquivalence();
+
+      // books a further method, with the same options in both trainings
+      void AddMethod(const TMVA::Types::EMVA& theMethod, const TString& methodTitle, const TString& theOption);
+      // options added to the factory options of the reference and the tested training
+      void SetFactoryOptions(const TString& refOption, const TString& theOption);
+
+      virtual void run();
+
+   private:
+      std::vector<TMVA::Types::EMVA> _methodTypes;
+      std::vector<TString> _methodTitles;
+      std::vector<TString> _refOptions;
+      std::vector<TString> _methodOptions;
+      TString _refFactoryOption;
+      TString _factoryOption;
+      TString _prepareString;
+      double  _maxDeviation;
+
+      // trains and tests the methods in a factory with the given job name
+      bool train(const TString& jobName, const TString& factoryOption, const std::vector<TString>& methodOptions);
+      // reads the responses of a method on the test sample
+      bool getResponses(const TString& jobName, UInt_t imethod, std::vector<Double_t>& responses);
+      // reads the background efficiencies and the cuts of all signal efficiency bins of a cut method
+      bool getCuts(const TString& jobName, UInt_t imethod, std::vector<Double_t>& cuts);
+      // recounts the efficiencies of the optimised cuts on the training sample
+      bool checkCutEfficiencies(const TString& jobName, UInt_t imethod);
+
+      // disallow copy constructor and assignment
+      MethodUnitTestWithEquivalence(const MethodUnitTestWithEquivalence&);
+      MethodUnitTestWithEquivalence& operator=(const MethodUnitTestWithEquivalence&);
+   };
+} // namespace UnitTesting
+#endif // METHODUNITTESTWITHEQUIVALENCE_H
+// including file tmvaut/MethodUnitTestWithEquivalence.cxx
+
+#include "TFile.h"
+#include "TTree.h"
+#include "TMath.h"
+#include "TH1.h"
+#include "TMVA/Factory.h"
+#include "TMVA/Reader.h"
+#include "TMVA/MethodCuts.h"
+
+using namespace std;
+using namespace UnitTesting;
+using namespace TMVA;
+
+MethodUnitTestWithEquivalence::MethodUnitTestWithEquivalence(const Types::EMVA& theMethod, const TString& methodTitle,
+                                                             const TString& refOption, const TString& theOption,
+                                                             double maxDeviation, const TString& prepareString,
+                                                             const std::string & /* xname */ ,const std::string & /* filename */ , std::ostream* /* sptr */) :
+   UnitTest(string("Equivalence_")+(string)methodTitle, __FILE__), _prepareString(prepareString), _maxDeviation(maxDeviation)
+{
+   _methodTypes.push_back(theMethod);
+   _methodTitles.push_back(methodTitle);
+   _refOptions.push_back(refOption);
+   _methodOptions.push_back(theOption);
+   if (_prepareString=="") _prepareString = "nTrain_Signal=2000:nTrain_Background=2000:nTest_Signal=2000:nTest_Background=2000:SplitMode=Random:NormMode=NumEvents:!V";
+}
+
+
+MethodUnitTestWithEquivalence::~MethodUnitTestWithEquivalence()
+{
+}
+
+void MethodUnitTestWithEquivalence::AddMethod(const Types::EMVA& theMethod, const TString& methodTitle, const TString& theOption)
+{
+   _methodTypes.push_back(theMethod);
+   _methodTitles.push_back(methodTitle);
+   _refOptions.push_back(theOption);
+   _methodOptions.push_back(theOption);
+}
+
+void MethodUnitTestWithEquivalence::SetFactoryOptions(const TString& refOption, const TString& theOption)
+{
+   _refFactoryOption = refOption;
+   _factoryOption = theOption;
+}
+
+bool MethodUnitTestWithEquivalence::train(const TString& jobName, const TString& factoryOption, const std::vector<TString>& methodOptions)
+{
+   TFile* outputFile = TFile::Open( "weights/"+jobName+".root", "RECREATE" );
+   if (!outputFile) return false;
+
+   TString factoryOptions( "!V:Silent:AnalysisType=Classification:!Color:!DrawProgressBar" );
+   if (factoryOption!="") factoryOptions += ":"+factoryOption;
+   Factory* factory = new Factory( jobName, outputFile, factoryOptions );
+
+   factory->AddVariable( "var0",  "Variable 0", 'F' );
+   factory->AddVariable( "var1",  "Variable 1", 'F' );
+   factory->AddVariable( "var2",  "Variable 2", 'F' );
+   factory->AddVariable( "var3",  "Variable 3", 'F' );
+
+   // the complex data set provides enough events for the multi-threaded paths
+   TString fname = "weights/tmva_complex_data.root";
+   TFile* input = TFile::Open( fname );
+   if (input == NULL) {
+      MethodUnitTestWithComplexData::create_data( fname );
+      input = TFile::Open( fname );
+   }
+   if (input == NULL) {
+      cerr << "broken/inaccessible input file" << endl;
+      delete factory;
+      delete outputFile;
+      return false;
+   }
+
+   factory->AddSignalTree( (TTree*)input->Get("TreeSFull") );
+   factory->AddBackgroundTree( (TTree*)input->Get("TreeBFull") );
+   factory->SetSignalWeightExpression("weight");
+   factory->SetBackgroundWeightExpression("weight");
+
+   // the random split has a fixed seed, so both trainings use the same events
+   TCut mycuts = "";
+   TCut mycutb = "";
+   factory->PrepareTrainingAndTestTree( mycuts, mycutb, _prepareString );
+
+   for (UInt_t i=0; i<_methodTypes.size(); i++) factory->BookMethod( _methodTypes[i], _methodTitles[i], methodOptions[i] );
+
+   factory->TrainAllMethods();
+   factory->TestAllMethods();
+   factory->EvaluateAllMethods();
+
+   outputFile->Close();
+   delete factory;
+   delete outputFile;
+   input->Close();
+   delete input;
+   return true;
+}
+
+bool MethodUnitTestWithEquivalence::getResponses(const TString& jobName, UInt_t imethod, std::vector<Double_t>& responses)
+{
+   if (_methodTypes[imethod] == Types::kCuts) return getCuts( jobName, imethod, responses );
+
+   const TString& methodTitle = _methodTitles[imethod];
+   responses.clear();
+   TFile* file = TFile::Open( "weights/"+jobName+".root" );
+   if (!file) return false;
+   TTree* testTree = (TTree*)file->Get("TestTree");
+   if (!testTree || !testTree->GetBranch(methodTitle)) {
+      delete file;
+      return false;
+   }
+   Float_t value = 0;
+   testTree->SetBranchAddress( methodTitle, &value );
+   for (Long64_t ievt=0; ievt<testTree->GetEntries(); ievt++) {
+      testTree->GetEntry(ievt);
+      responses.push_back( value );
+   }
+   file->Close();
+   delete file;
+   return true;
+}
+
+bool MethodUnitTestWithEquivalence::getCuts(const TString& jobName, UInt_t imethod, std::vector<Double_t>& cuts)
+{
+   const TString& methodTitle = _methodTitles[imethod];
+   cuts.clear();
+
+   // the background efficiencies of the bins are in the monitoring histogram
+   TFile* file = TFile::Open( "weights/"+jobName+".root" );
+   if (!file) return false;
+   TH1* effBvsS = (TH1*)file->Get( "Method_Cuts/"+methodTitle+"/MVA_"+methodTitle+"_effBvsSLocal" );
+   if (!effBvsS) {
+      delete file;
+      return false;
+   }
+   for (Int_t ibin=1; ibin<=effBvsS->GetNbinsX(); ibin++) cuts.push_back( effBvsS->GetBinContent(ibin) );
+
+   // the cuts are read back from the weight file
+   const UInt_t nvar = 4;
+   std::vector<Float_t> vars( nvar );
+   Reader* reader = new Reader( "!Color:Silent" );
+   for (UInt_t ivar=0; ivar<nvar; ivar++) reader->AddVariable( Form( "var%i", ivar ), &vars[ivar] );
+   MethodCuts* method = dynamic_cast<MethodCuts*>( reader->BookMVA( methodTitle, "weights/"+jobName+"_"+methodTitle+".weights.xml" ) );
+   if (method) {
+      std::vector<Double_t> cutMin, cutMax;
+      for (Int_t ibin=1; ibin<=effBvsS->GetNbinsX(); ibin++) {
+         method->GetCuts( effBvsS->GetBinCenter(ibin), cutMin, cutMax );
+         cuts.insert( cuts.end(), cutMin.begin(), cutMin.end() );
+         cuts.insert( cuts.end(), cutMax.begin(), cutMax.end() );
+      }
+   }
+   delete reader;
+   file->Close();
+   delete file;
+   return method != 0;
+}
+
+bool MethodUnitTestWithEquivalence::checkCutEfficiencies(const TString& jobName, UInt_t imethod)
+{
+   const TString& methodTitle = _methodTitles[imethod];
+   TFile* file = TFile::Open( "weights/"+jobName+".root" );
+   if (!file) return false;
+   TH1* effBvsS = (TH1*)file->Get( "Method_Cuts/"+methodTitle+"/MVA_"+methodTitle+"_effBvsSLocal" );
+   TTree* trainTree = (TTree*)file->Get("TrainTree");
+   if (!effBvsS || !trainTree) {
+      delete file;
+      return false;
+   }
+
+   // the training events, signal is the first class
+   const UInt_t nvar = 4;
+   std::vector<Float_t> vars( nvar );
+   Int_t classID = 0;
+   Float_t weight = 0;
+   trainTree->SetBranchAddress( "classID", &classID );
+   trainTree->SetBranchAddress( "weight", &weight );
+   for (UInt_t ivar=0; ivar<nvar; ivar++) trainTree->SetBranchAddress( Form( "var%i", ivar ), &vars[ivar] );
+   std::vector< std::vector<Float_t> > events;
+   std::vector<Float_t> weights;
+   std::vector<Bool_t> isSignal;
+   Double_t sumS = 0, sumB = 0;
+   for (Long64_t ievt=0; ievt<trainTree->GetEntries(); ievt++) {
+      trainTree->GetEntry(ievt);
+      events.push_back( vars );
+      weights.push_back( weight );
+      isSignal.push_back( classID == 0 );
+      if (classID == 0) sumS += weight;
+      else              sumB += weight;
+   }
+
+   Reader* reader = new Reader( "!Color:Silent" );
+   for (UInt_t ivar=0; ivar<nvar; ivar++) reader->AddVariable( Form( "var%i", ivar ), &vars[ivar] );
+   MethodCuts* method = dynamic_cast<MethodCuts*>( reader->BookMVA( methodTitle, "weights/"+jobName+"_"+methodTitle+".weights.xml" ) );
+   Int_t nfilled = 0, nbad = 0;
+   if (method && sumS > 0 && sumB > 0) {
+      // the cuts of each filled bin must select the background efficiency of the
+      // bin and a signal efficiency inside the bin (cutMin < x <= cutMax)
+      std::vector<Double_t> cutMin, cutMax;
+      for (Int_t ibin=1; ibin<=effBvsS->GetNbinsX(); ibin++) {
+         if (effBvsS->GetBinContent(ibin) < 0) continue;
+         nfilled++;
+         method->GetCuts( effBvsS->GetBinCenter(ibin), cutMin, cutMax );
+         Double_t selS = 0, selB = 0;
+         for (UInt_t ievt=0; ievt<events.size(); ievt++) {
+            UInt_t ivar = 0;
+            while (ivar < nvar && cutMin[ivar] < events[ievt][ivar] && cutMax[ivar] >= events[ievt][ivar]) ivar++;
+            if (ivar < nvar) continue;
+            if (isSignal[ievt]) selS += weights[ievt];
+            else                selB += weights[ievt];
+         }
+         Double_t effS = selS/sumS, effB = selB/sumB;
+         if (TMath::Abs( effB-effBvsS->GetBinContent(ibin) ) > 1.e-4 ||
+             effS < effBvsS->GetBinLowEdge(ibin)-1.e-4 || effS > effBvsS->GetBinLowEdge(ibin+1)+1.e-4) {
+            std::cout << "failure in " << methodTitle << ", bin " << ibin << ": recounted effS=" << effS << " effB=" << effB
+                      << ", stored effB=" << effBvsS->GetBinContent(ibin) << std::endl;
+            nbad++;
+         }
+      }
+   }
+   delete reader;
+   file->Close();
+   delete file;
+   return method != 0 && nfilled > 0 && nbad == 0;
+}
+
+void MethodUnitTestWithEquivalence::run()
+{
+   test_( train( "TMVAEquivalenceRef", _refFactoryOption, _refOptions ) );
+   test_( train( "TMVAEquivalenceTest", _factoryOption, _methodOptions ) );
+
+   for (UInt_t imethod=0; imethod<_methodTitles.size(); imethod++) {
+      std::vector<Double_t> refResponses, responses;
+      test_( getResponses( "TMVAEquivalenceRef", imethod, refResponses ) );
+      test_( getResponses( "TMVAEquivalenceTest", imethod, responses ) );
+      if (_methodTypes[imethod] == Types::kCuts) test_( checkCutEfficiencies( "TMVAEquivalenceTest", imethod ) );
+      test_( refResponses.size() > 0 && refResponses.size() == responses.size() );
+      if (refResponses.size() != responses.size()) continue;
+
+      double maxdiff = 0.;
+      for (UInt_t i=0; i<responses.size(); i++) {
+         double diff = TMath::Abs( responses[i]-refResponses[i] )/TMath::Max( 1., (double)TMath::Abs( refResponses[i] ) );
+         maxdiff = diff > maxdiff ? diff : maxdiff;
+      }
+      if (maxdiff > _maxDeviation) {
+         std::cout << "failure in " << _methodTitles[imethod] << " with \"" << _factoryOption << ":" << _methodOptions[imethod]
+                   << "\" compared to \"" << _refFactoryOption << ":" << _refOptions[imethod]
+                   << "\": maximum deviation " << maxdiff << " allowed " << _maxDeviation << std::endl;
+      }
+      test_( maxdiff <= _maxDeviation );
+   }
+}
+// including file tmvaut/ReaderUnitTestWithBatch.h
+#ifndef READERUNITTESTWITHBATCH_H
+#define READERUNITTESTWITHBATCH_H
+
+// TMVA unit tests
+//
+// this class trains the method specified in the constructor and checks
+// that the Reader gives the same responses for a set of events evaluated
+// at once, stored by event or column-wise, as for the events evaluated
+// one by one; for BDTs the flat
+// forest used in the evaluation is compared tree by tree with the trees
+
+#include <string>
+#include <vector>
+
+#include "TString.h"
+
+#include "TMVA/Types.h"
+
+namespace UnitTesting
+{
+   class ReaderUnitTestWithBatch : public UnitTest
+   {
+   public:
+      ReaderUnitTestWithBatch(const TMVA::Types::EMVA& theMethod, const TString& methodTitle, const TString& theOption,
+                              double maxDeviation = 0.,
+                              const std::string & name="", const std::string & filename="", std::ostream* osptr = &std::cout);
+      virtual ~ReaderUnitTestWithBatch();
+
+      virtual void run();
+
+   private:
+      TMVA::Types::EMVA _methodType;
+      TString _methodTitle;
+      TString _methodOption;
+      double  _maxDeviation;
+
+      bool train();
+      double maxDeviation(const std::vector<Double_t>& ref, const std::vector<Double_t>& values) const;
+
+      // disallow copy constructor and assignment
+      ReaderUnitTestWithBatch(const ReaderUnitTestWithBatch&);
+      ReaderUnitTestWithBatch& operator=(const ReaderUnitTestWithBatch&);
+   };
+} // namespace UnitTesting
+#endif // READERUNITTESTWITHBATCH_H
+// including file tmvaut/ReaderUnitTestWithBatch.cxx
+
+#include "TFile.h"
+#include "TTree.h"
+#include "TMath.h"
+#include "TMVA/Factory.h"
+#include "TMVA/Reader.h"
+#include "TMVA/Event.h"
+#include "TMVA/MethodBDT.h"
+#include "TMVA/DecisionTree.h"
+#include "TMVA/DecisionTreeForest.h"
+
+using namespace std;
+using namespace UnitTesting;
+using namespace TMVA;
+
+ReaderUnitTestWithBatch::ReaderUnitTestWithBatch(const Types::EMVA& theMethod, const TString& methodTitle, const TString& theOption,
+                                                 double maxDeviation,
+                                                 const std::string & /* xname */ ,const std::string & /* filename */ , std::ostream* /* sptr */) :
+   UnitTest(string("ReaderBatch_")+(string)methodTitle, __FILE__), _methodType(theMethod), _methodTitle(methodTitle),
+   _methodOption(theOption), _maxDeviation(maxDeviation)
+{
+}
+
+
+ReaderUnitTestWithBatch::~ReaderUnitTestWithBatch()
+{
+}
+
+bool ReaderUnitTestWithBatch::train()
+{
+   TFile* outputFile = TFile::Open( "weights/TMVABatchTest.root", "RECREATE" );
+   if (!outputFile) return false;
+
+   string factoryOptions( "!V:Silent:AnalysisType=Classification:!Color:!DrawProgressBar" );
+   Factory* factory = new Factory( "TMVABatchTest", outputFile, factoryOptions );
+
+   factory->AddVariable( "var0",  "Variable 0", 'F' );
+   factory->AddVariable( "var1",  "Variable 1", 'F' );
+   factory->AddVariable( "var2",  "Variable 2", 'F' );
+   factory->AddVariable( "var3",  "Variable 3", 'F' );
+
+   TString fname = "weights/tmva_complex_data.root";
+   TFile* input = TFile::Open( fname );
+   if (input == NULL) {
+      MethodUnitTestWithComplexData::create_data( fname );
+      input = TFile::Open( fname );
+   }
+   if (input == NULL) {
+      cerr << "broken/inaccessible input file" << endl;
+      delete factory;
+      delete outputFile;
+      return false;
+   }
+
+   factory->AddSignalTree( (TTree*)input->Get("TreeSFull") );
+   factory->AddBackgroundTree( (TTree*)input->Get("TreeBFull") );
+   factory->SetSignalWeightExpression("weight");
+   factory->SetBackgroundWeightExpression("weight");
+
+   TCut mycuts = "";
+   TCut mycutb = "";
+   factory->PrepareTrainingAndTestTree( mycuts, mycutb,
+                                        "nTrain_Signal=2000:nTrain_Background=2000:nTest_Signal=1000:nTest_Background=1000:SplitMode=Random:NormMode=NumEvents:!V" );
+
+   factory->BookMethod( _methodType, _methodTitle, _methodOption );
+
+   factory->TrainAllMethods();
+   factory->TestAllMethods();
+
+   outputFile->Close();
+   delete factory;
+   delete outputFile;
+   input->Close();
+   delete input;
+   return true;
+}
+
+double ReaderUnitTestWithBatch::maxDeviation(const std::vector<Double_t>& ref, const std::vector<Double_t>& values) const
+{
+   if (ref.size() != values.size()) return 1.e30;
+   double maxdiff = 0.;
+   for (UInt_t i=0; i<ref.size(); i++) {
+      double diff = TMath::Abs( values[i]-ref[i] )/TMath::Max( 1., TMath::Abs( ref[i] ) );
+      maxdiff = diff > maxdiff ? diff : maxdiff;
+   }
+   return maxdiff;
+}
+
+void ReaderUnitTestWithBatch::run()
+{
+   test_( train() );
+
+   const UInt_t nvar = 4;
+   std::vector<Float_t> vars( nvar );
+   TMVA::Reader* reader = new TMVA::Reader( "!Color:Silent" );
+   for (UInt_t ivar=0; ivar<nvar; ivar++) reader->AddVariable( Form( "var%i", ivar ), &vars[ivar] );
+   IMethod* method = reader->BookMVA( _methodTitle, "weights/TMVABatchTest_"+_methodTitle+".weights.xml" );
+   test_( method != 0 );
+   if (method == 0) {
+      delete reader;
+      return;
+   }
+
+   // events of the test sample
+   std::vector< std::vector<Float_t> > events;
+   TFile* testFile = TFile::Open( "weights/TMVABatchTest.root" );
+   TTree* testTree = testFile ? (TTree*)testFile->Get("TestTree") : 0;
+   test_( testTree != 0 );
+   if (testTree) {
+      for (UInt_t ivar=0; ivar<nvar; ivar++) testTree->SetBranchAddress( Form( "var%i", ivar ), &vars[ivar] );
+      for (Long64_t ievt=0; ievt<testTree->GetEntries(); ievt++) {
+         testTree->GetEntry(ievt);
+         events.push_back( vars );
+      }
+   }
+   delete testFile;
+   test_( events.size() > 0 );
+
+   // the events one by one
+   std::vector<Double_t> single( events.size() );
+   for (UInt_t ievt=0; ievt<events.size(); ievt++) {
+      vars = events[ievt];
+      single[ievt] = reader->EvaluateMVA( _methodTitle );
+   }
+
+   // all events at once
+   std::vector<Double_t> batch;
+   reader->EvaluateMVA( events, _methodTitle, batch );
+   double maxdiff = maxDeviation( single, batch );
+   if (maxdiff > _maxDeviation) {
+      std::cout << "failure in " << _methodTitle << ", batch evaluation: maximum deviation " << maxdiff
+                << " allowed " << _maxDeviation << std::endl;
+   }
+   test_( maxdiff <= _maxDeviation );
+
+   // all events at once, stored column-wise
+   std::vector<Float_t> columns( nvar*events.size() );
+   for (UInt_t ievt=0; ievt<events.size(); ievt++) {
+      for (UInt_t ivar=0; ivar<nvar; ivar++) columns[ivar*events.size()+ievt] = events[ievt][ivar];
+   }
+   std::vector<Double_t> columnBatch( events.size() );
+   if (events.size() > 0) reader->EvaluateMVA( &columns[0], events.size(), _methodTitle, &columnBatch[0] );
+   maxdiff = maxDeviation( single, columnBatch );
+   if (maxdiff > _maxDeviation) {
+      std::cout << "failure in " << _methodTitle << ", column-wise batch evaluation: maximum deviation " << maxdiff
+                << " allowed " << _maxDeviation << std::endl;
+   }
+   test_( maxdiff <= _maxDeviation );
+
+   // the flat forest of a BDT must give the same response as each tree (the
+   // BDTs are trained without variable transformation)
+   MethodBDT* bdt = dynamic_cast<MethodBDT*>( method );
+   if (bdt) {
+      const std::vector<DecisionTree*>& trees = bdt->GetForest();
+      DecisionTreeForest forest( trees );
+      test_( forest.GetNTrees() == trees.size() );
+      Int_t nbad = 0;
+      for (UInt_t ievt=0; ievt<events.size(); ievt++) {
+         Event ev( events[ievt], 0 );
+         for (UInt_t itree=0; itree<trees.size(); itree++) {
+            if (forest.CheckEvent( itree, &events[ievt][0], kFALSE ) != trees[itree]->CheckEvent( &ev, kFALSE )) nbad++;
+            if (forest.CheckEvent( itree, &events[ievt][0], kTRUE  ) != trees[itree]->CheckEvent( &ev, kTRUE  )) nbad++;
+         }
+      }
+      if (nbad > 0) std::cout << "failure in " << _methodTitle << ": " << nbad << " responses of the flat forest differ from the trees" << std::endl;
+      test_( nbad == 0 );
+   }
+
+   delete reader;
+}
 // including file stressTMVA.cxx
 // Authors: Christoph Rosemann, Eckhard von Toerne   July 2010
 // TMVA unit tests
@@ -2853,6 +3993,69 @@ void addComplexClassificationTests( UnitTestSuite& TMVA_test, bool full=true )
    TMVA_test.addTest(new MethodUnitTestWithComplexData(trees, prep, TMVA::Types::kSVM, "SVM", "Gamma=0.4:Tol=0.001" , 0.955, 0.975) );
 }
 
+void addEquivalenceTests( UnitTestSuite& TMVA_test, bool full=true )
+{
+   // the same method trained with the reference and the tested options must give the same responses
+   // BDT: the cut scan of nodes with 25000 events and more is filled in threads
+   TString prepBDT="nTrain_Signal=18000:nTrain_Background=18000:nTest_Signal=2000:nTest_Background=2000:SplitMode=Random:NormMode=NumEvents:!V";
+   TMVA_test.addTest(new MethodUnitTestWithEquivalence( TMVA::Types::kBDT, "BDTThreads",
+                     "!H:!V:NTrees=50:BoostType=AdaBoost:nCuts=20:MaxDepth=3:NThreads=1",
+                     "!H:!V:NTrees=50:BoostType=AdaBoost:nCuts=20:MaxDepth=3:NThreads=4", 0., prepBDT) );
+   if (full) TMVA_test.addTest(new MethodUnitTestWithEquivalence( TMVA::Types::kBDT, "BDTGThreads",
+                     "!H:!V:NTrees=50:BoostType=Grad:Shrinkage=0.30:nCuts=20:MaxDepth=3:NThreads=1",
+                     "!H:!V:NTrees=50:BoostType=Grad:Shrinkage=0.30:nCuts=20:MaxDepth=3:NThreads=4", 0., prepBDT) );
+   // MLP: minibatch mode follows batch mode (batches of 500 of the 4000 training events); with several
+   // threads only the summation order of the error fields changes
+   TString optMLP="H:!V:NeuronType=tanh:VarTransform=N:NCycles=100:HiddenLayers=N+5:TestRate=5:!UseRegulator:BatchSize=500";
+   TMVA_test.addTest(new MethodUnitTestWithEquivalence( TMVA::Types::kMLP, "MLPMiniBatch",
+                     optMLP+":BPMode=batch", optMLP+":BPMode=minibatch:NThreads=1", 1.e-4) );
+   TMVA_test.addTest(new MethodUnitTestWithEquivalence( TMVA::Types::kMLP, "MLPMiniBatchThreads",
+                     optMLP+":BPMode=minibatch:NThreads=1", optMLP+":BPMode=minibatch:NThreads=4", 1.e-4) );
+   // SVM: kernel matrix rows recomputed from a small cache in threads give the same solution as the full cache
+   TString optSVM="Gamma=0.25:Tol=0.001:VarTransform=Norm";
+   TMVA_test.addTest(new MethodUnitTestWithEquivalence( TMVA::Types::kSVM, "SVMCache",
+                     optSVM+":CacheSize=1000:NThreads=1", optSVM+":CacheSize=1:NThreads=4", 0.) );
+   // PDEFoam: the sampling points of a cell are drawn in the serial order and evaluated in threads
+   TString optPDEFoam="H:!V:TailCut=0.001:VolFrac=0.0333:nActiveCells=500:nSampl=2000:nBin=5:Nmin=100:Kernel=None:Compress=T";
+   TMVA_test.addTest(new MethodUnitTestWithEquivalence( TMVA::Types::kPDEFoam, "PDEFoamThreads",
+                     optPDEFoam+":SigBgSeparate=F:NThreads=1", optPDEFoam+":SigBgSeparate=F:NThreads=4", 0.) );
+   if (full) TMVA_test.addTest(new MethodUnitTestWithEquivalence( TMVA::Types::kPDEFoam, "PDEFoamSeparateThreads",
+                     optPDEFoam+":SigBgSeparate=T:NThreads=1", optPDEFoam+":SigBgSeparate=T:NThreads=4", 0.) );
+   // Cuts: the efficiencies of a GA population are computed from presorted events in threads
+   TString optCuts="!H:!V:FitMethod=GA:EffSel:Steps=20:Cycles=2:PopSize=100:SC_steps=10:SC_rate=5:SC_factor=0.95";
+   TMVA_test.addTest(new MethodUnitTestWithEquivalence( TMVA::Types::kCuts, "CutsGAThreads",
+                     optCuts+":NThreads=1", optCuts+":NThreads=4", 0.) );
+   // Factory: the methods trained in parallel jobs are read back from their weight files
+   TString optJobs="!H:!V:NTrees=50:BoostType=AdaBoost:nCuts=20:MaxDepth=3";
+   MethodUnitTestWithEquivalence* jobsTest = new MethodUnitTestWithEquivalence( TMVA::Types::kBDT, "BDTJobs", optJobs, optJobs );
+   jobsTest->AddMethod( TMVA::Types::kFisher, "FisherJobs", "H:!V" );
+   jobsTest->AddMethod( TMVA::Types::kLikelihood, "LikelihoodJobs", "H:!V:!TransformOutput:PDFInterpol=Spline2:NSmooth=5:NAvEvtPerBin=50" );
+   jobsTest->SetFactoryOptions( "NJobs=1", "NJobs=2" );
+   TMVA_test.addTest(jobsTest);
+}
+
+void addReaderBatchTests( UnitTestSuite& TMVA_test, bool full=true )
+{
+   // the Reader must give the same responses for a set of events as for single events
+   TMVA_test.addTest(new ReaderUnitTestWithBatch( TMVA::Types::kBDT, "BDT", "!H:!V:NTrees=100:BoostType=AdaBoost:nCuts=20:MaxDepth=3" ) );
+   TMVA_test.addTest(new ReaderUnitTestWithBatch( TMVA::Types::kBDT, "BDTG", "!H:!V:NTrees=100:BoostType=Grad:Shrinkage=0.30:nCuts=20:MaxDepth=3" ) );
+   if (full) TMVA_test.addTest(new ReaderUnitTestWithBatch( TMVA::Types::kBDT, "BDTPurity", "!H:!V:NTrees=100:BoostType=AdaBoost:nCuts=20:MaxDepth=3:UseYesNoLeaf=False" ) );
+   if (full) TMVA_test.addTest(new ReaderUnitTestWithBatch( TMVA::Types::kBDT, "BDTF", "!H:!V:NTrees=50:BoostType=AdaBoost:nCuts=20:MaxDepth=3:UseFisherCuts:MinLinCorrForFisher=0.8" ) );
+   // methods with their own column-wise evaluation, with and without variable transformations
+   TMVA_test.addTest(new ReaderUnitTestWithBatch( TMVA::Types::kBDT, "BDTN", "!H:!V:NTrees=100:BoostType=AdaBoost:nCuts=20:MaxDepth=3:VarTransform=N" ) );
+   TMVA_test.addTest(new ReaderUnitTestWithBatch( TMVA::Types::kFisher, "Fisher", "H:!V" ) );
+   TMVA_test.addTest(new ReaderUnitTestWithBatch( TMVA::Types::kFisher, "FisherD", "H:!V:VarTransform=D" ) );
+   TMVA_test.addTest(new ReaderUnitTestWithBatch( TMVA::Types::kLikelihood, "Likelihood",
+                     "H:!V:TransformOutput:PDFInterpol=Spline2:NSmoothSig[0]=20:NSmoothBkg[0]=20:NSmoothBkg[1]=10:NSmooth=1:NAvEvtPerBin=50" ) );
+   TMVA_test.addTest(new ReaderUnitTestWithBatch( TMVA::Types::kLikelihood, "LikelihoodPCA", "!H:!V:!TransformOutput:PDFInterpol=Spline2:NSmooth=5:NAvEvtPerBin=50:VarTransform=PCA" ) );
+   TMVA_test.addTest(new ReaderUnitTestWithBatch( TMVA::Types::kMLP, "MLP", "H:!V:NeuronType=tanh:VarTransform=N:NCycles=50:HiddenLayers=N+5:TestRate=5:!UseRegulator" ) );
+   if (full) TMVA_test.addTest(new ReaderUnitTestWithBatch( TMVA::Types::kMLP, "MLPND", "H:!V:NeuronType=sigmoid:VarTransform=N,D:NCycles=50:HiddenLayers=N+5,N:TestRate=5:!UseRegulator" ) );
+   // kNN searches the events in threads
+   TMVA_test.addTest(new ReaderUnitTestWithBatch( TMVA::Types::kKNN, "KNN", "H:nkNN=20:ScaleFrac=0.8:SigmaFact=1.0:Kernel=Gaus:UseKernel=F:UseWeight=T:!Trim:NThreads=4" ) );
+   // the Gauss transformation is not available column-wise, the events are evaluated one by one
+   if (full) TMVA_test.addTest(new ReaderUnitTestWithBatch( TMVA::Types::kFisher, "FisherG", "H:!V:VarTransform=G" ) );
+}
+
 
 int main(int argc, char **argv)
 {
@@ -2876,11 +4079,17 @@ int main(int argc, char **argv)
    TMVA_test.addTest(new utDataSet);
    TMVA_test.addTest(new utFactory);
    TMVA_test.addTest(new utReader);
+   TMVA_test.addTest(new utModulekNN);
+   TMVA_test.addTest(new utTransformationHandler);
+   TMVA_test.addTest(new utEventStore);
+   TMVA_test.addTest(new utPDEFoamDensity);
 
    addClassificationTests(TMVA_test, full);
    addRegressionTests(TMVA_test, full);
    addDataInputTests(TMVA_test, full);
    addComplexClassificationTests(TMVA_test, full);
+   addEquivalenceTests(TMVA_test, full);
+   addReaderBatchTests(TMVA_test, full);
 
    // run all
    TMVA_test.run();
@@ -67,6 +67,9 @@ namespace TMVA {
       Bool_t DrawProgressBar() const { return fDrawProgressBar; }
       void   SetDrawProgressBar( Bool_t d ) { fDrawProgressBar = d; }
 
+      Int_t  NJobs() const { return fNJobs; }
+      void   SetNJobs( Int_t n ) { fNJobs = n; }
+
    public:
 
       class VariablePlotting;
@@ -112,6 +115,7 @@ namespace TMVA {
       Bool_t fSilent;                // no output at all
       Bool_t fWriteOptionsReference; // if set true: Configurable objects write file with option reference
       Bool_t fDrawProgressBar;       // draw progress bar to indicate training evolution
+      Int_t  fNJobs;                 // number of parallel processes for training and parameter optimisation
 
       mutable MsgLogger* fLogger;   // message logger
       MsgLogger& Log() const { return *fLogger; }
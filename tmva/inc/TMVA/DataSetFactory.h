@@ -283,6 +283,10 @@ namespace TMVA {
                                    const EvtStatsPerClass& eventCounts,
                                    const TString& normMode );
 
+      void      BuildEventStore  ( DataSetInfo& dsi,
+                                   EventVector& trainingEvents,
+                                   EventVector& testingEvents );
+
       void      InitOptions      ( DataSetInfo& dsi,
                                    EvtStatsPerClass& eventsmap,
                                    TString& normMode, UInt_t& splitSeed,
@@ -310,6 +314,7 @@ namespace TMVA {
       // verbosity
       Bool_t                     fVerbose;           //! Verbosity
       TString                    fVerboseLevel;      //! VerboseLevel
+      TString                    fEventStorage;      //! storage of the event values (Float/Float16/Vector)
 
       // the event
       mutable TTree*             fCurrentTree;       //! the tree, events are currently read from
@@ -68,6 +68,7 @@ class TRandom3;
 namespace TMVA {
 
    class Event;
+   class DecisionTreeBinning;
 
    class DecisionTree : public BinaryTree {
 
@@ -198,6 +199,14 @@ namespace TMVA {
       inline void SetUseExclusiveVars(Bool_t t=kTRUE){fUseExclusiveVars = t;}
       inline void SetPairNegWeightsInNode(){fPairNegWeightsInNode=kTRUE;}
 
+      // number of threads used to fill the cut scan histograms of the variables in TrainNodeFast
+      inline void SetNThreads(UInt_t n){fNThreads = (n>0) ? n : 1;}
+      UInt_t GetNThreads() const { return fNThreads; }
+
+      // use the bin indices of a pre-binned training sample (not owned) in TrainNodeFast
+      inline void SetBinning(const DecisionTreeBinning* b){fBinning = b;}
+      const DecisionTreeBinning* GetBinning() const { return fBinning; }
+
    private:
       // utility functions
      
@@ -241,6 +250,8 @@ namespace TMVA {
       Bool_t     fPairNegWeightsInNode;  // randomly pair miscl. ev. with neg. and pos. weights in node and don't boost them
       static const Int_t  fgDebugLevel = 0;     // debug level determining some printout/control plots etc.
       Int_t     fTreeID;        // just an ID number given to the tree.. makes debugging easier as tree knows who he is.
+      UInt_t    fNThreads;      // number of threads used to fill the cut scan histograms
+      const DecisionTreeBinning* fBinning; // pre-binned training sample used in the cut scan (not owned)
 
       Types::EAnalysisType  fAnalysisType;   // kClassification(=0=false) or kRegression(=1=true)
 
@@ -0,0 +1,95 @@
+// @(#)root/tmva $Id$
+// Author: Andreas Hoecker, Joerg Stelzer, Helge Voss, Kai Voss, Jan Therhaag, Eckhard von Toerne
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : DecisionTreeBinning                                                   *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Input variables of a training sample converted once into compact bin     *
+ *      indices, shared by the node splitting of all trees of a forest           *
+ *                                                                                *
+ * Authors (alphabetical):                                                        *
+ *      Andreas Hoecker <Andreas.Hocker@cern.ch> - CERN, Switzerland              *
+ *      Helge Voss      <Helge.Voss@cern.ch>     - MPI-K Heidelberg, Germany      *
+ *      Kai Voss        <Kai.Voss@cern.ch>       - U. of Victoria, Canada         *
+ *      Jan Therhaag       <Jan.Therhaag@cern.ch>     - U of Bonn, Germany        *
+ *      Eckhard v. Toerne  <evt@uni-bonn.de>          - U of Bonn, Germany        *
+ *                                                                                *
+ * Copyright (c) 2005-2011:                                                       *
+ *      CERN, Switzerland                                                         *
+ *      U. of Victoria, Canada                                                    *
+ *      MPI-K Heidelberg, Germany                                                 *
+ *      U. of Bonn, Germany                                                       *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://mva.sourceforge.net/license.txt)                                       *
+ *                                                                                *
+ **********************************************************************************/
+
+#ifndef ROOT_TMVA_DecisionTreeBinning
+#define ROOT_TMVA_DecisionTreeBinning
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// DecisionTreeBinning                                                  //
+//                                                                      //
+// Input variables of a training sample converted once into compact     //
+// bin indices, shared by the node splitting of all trees of a forest   //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#ifndef ROOT_TExMap
+#include "TExMap.h"
+#endif
+
+namespace TMVA {
+
+   class Event;
+
+   class DecisionTreeBinning {
+
+   public:
+
+      // bin the variables of all events of the sample into nBins equidistant bins
+      DecisionTreeBinning( const std::vector<const TMVA::Event*>& eventSample, UInt_t nBins );
+      ~DecisionTreeBinning();
+
+      UInt_t GetNVariables() const { return fNvars; }
+      UInt_t GetNBins() const { return fNBins; }
+
+      // the cut between bin icut and bin icut+1 of variable ivar
+      Double_t GetCutValue( UInt_t ivar, UInt_t icut ) const { return fCutValues[ivar][icut]; }
+
+      // the bin of value x of variable ivar
+      UInt_t GetBin( UInt_t ivar, Double_t x ) const;
+
+      // the row of an event of the binned sample, or -1 if it is not part of it
+      Long64_t GetRow( const TMVA::Event* ev ) const;
+
+      // the bin of variable ivar of the event in the given row
+      UInt_t GetBin( Long64_t row, UInt_t ivar ) const {
+         return fBins8.empty() ? fBins16[row*fNvars+ivar] : fBins8[row*fNvars+ivar];
+      }
+
+   private:
+
+      DecisionTreeBinning( const DecisionTreeBinning& );
+      DecisionTreeBinning& operator=( const DecisionTreeBinning& );
+
+      UInt_t                              fNvars;      // number of variables
+      UInt_t                              fNBins;      // number of bins per variable
+      std::vector< std::vector<Double_t> > fCutValues; // bin boundaries (nBins-1 per variable)
+      std::vector<UChar_t>                fBins8;      // bin indices per event and variable if nBins <= 256
+      std::vector<UShort_t>               fBins16;     // bin indices per event and variable otherwise
+      mutable TExMap                      fRows;       // map of event pointers to rows
+   };
+
+} // namespace TMVA
+
+#endif
@@ -0,0 +1,108 @@
+// @(#)root/tmva $Id$
+// Author: Andreas Hoecker, Joerg Stelzer, Helge Voss, Kai Voss, Jan Therhaag, Eckhard von Toerne
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : DecisionTreeForest                                                    *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Forest of decision trees compiled into flat node arrays for fast          *
+ *      evaluation                                                                *
+ *                                                                                *
+ * Authors (alphabetical):                                                        *
+ *      Andreas Hoecker <Andreas.Hocker@cern.ch> - CERN, Switzerland              *
+ *      Helge Voss      <Helge.Voss@cern.ch>     - MPI-K Heidelberg, Germany      *
+ *      Kai Voss        <Kai.Voss@cern.ch>       - U. of Victoria, Canada         *
+ *      Jan Therhaag       <Jan.Therhaag@cern.ch>     - U of Bonn, Germany        *
+ *      Eckhard v. Toerne  <evt@uni-bonn.de>          - U of Bonn, Germany        *
+ *                                                                                *
+ * Copyright (c) 2005-2011:                                                       *
+ *      CERN, Switzerland                                                         *
+ *      U. of Victoria, Canada                                                    *
+ *      MPI-K Heidelberg, Germany                                                 *
+ *      U. of Bonn, Germany                                                       *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://mva.sourceforge.net/license.txt)                                       *
+ *                                                                                *
+ **********************************************************************************/
+
+#ifndef ROOT_TMVA_DecisionTreeForest
+#define ROOT_TMVA_DecisionTreeForest
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// DecisionTreeForest                                                   //
+//                                                                      //
+// Forest of decision trees compiled into flat node arrays for fast     //
+// evaluation                                                           //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#ifndef ROOT_Rtypes
+#include "Rtypes.h"
+#endif
+
+namespace TMVA {
+
+   class DecisionTree;
+   class DecisionTreeNode;
+   class MsgLogger;
+
+   class DecisionTreeForest {
+
+   public:
+
+      // compile the given trees (which are not modified or kept)
+      DecisionTreeForest( const std::vector<TMVA::DecisionTree*>& forest );
+      ~DecisionTreeForest();
+
+      UInt_t GetNTrees() const { return fTreeRoot.size(); }
+      UInt_t GetNNodes() const { return fSelector.size(); }
+
+      // response of tree itree for an event with the given input values,
+      // identical to DecisionTree::CheckEvent
+      Double_t CheckEvent( UInt_t itree, const Float_t* values, Bool_t useYesNoLeaf ) const;
+
+      // responses of tree itree for nEvents events, variable ivar of event
+      // i is values[i*eventStride+ivar*varStride] (row- or column-wise)
+      void CheckEvents( UInt_t itree, const Float_t* values, UInt_t nEvents, UInt_t eventStride, UInt_t varStride,
+                        Bool_t useYesNoLeaf, Double_t* response ) const;
+
+   private:
+
+      DecisionTreeForest( const DecisionTreeForest& );
+      DecisionTreeForest& operator=( const DecisionTreeForest& );
+
+      Int_t AddNode( const TMVA::DecisionTreeNode* node, Bool_t regression, UInt_t depth,
+                     UInt_t& maxDepth, Bool_t& hasFisher );
+
+      // index of the leaf node reached by an event in tree itree
+      inline Int_t GetLeaf( UInt_t itree, const Float_t* values ) const;
+
+      std::vector<Int_t>    fSelector;     // variable of the cut of each node (0 for leaves)
+      std::vector<Float_t>  fCutValue;     // cut value of each node
+      std::vector<Int_t>    fChildren;     // per node the next node for values below and above the cut (leaves point to themselves)
+      std::vector<Int_t>    fFisherOffset; // first Fisher coefficient of each node, -1 for simple cuts
+      std::vector<Int_t>    fFisherNCoeff; // number of Fisher coefficients of each node (including offset)
+      std::vector<Double_t> fFisherCoeff;  // Fisher coefficients of all nodes (offset last)
+      std::vector<UChar_t>  fIsLeaf;       // leaf flag of each node
+      std::vector<Double_t> fValue;        // response of each leaf (purity or regression response)
+      std::vector<Double_t> fValueYesNo;   // response of each leaf with yes/no leaves (node type or regression response)
+      std::vector<Int_t>    fTreeRoot;     // root node of each tree
+      std::vector<UInt_t>   fTreeDepth;    // depth of each tree
+      std::vector<UChar_t>  fTreeFisher;   // flag for trees with Fisher cuts
+      UInt_t                fNVars;        // number of input variables used by the cuts
+
+      mutable MsgLogger*    fLogger;       //! message logger
+      MsgLogger& Log() const { return *fLogger; }
+   };
+
+} // namespace TMVA
+
+#endif
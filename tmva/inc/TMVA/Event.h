@@ -46,6 +46,7 @@ class TCut;
 namespace TMVA {
 
    class Event;
+   class EventStore;
 
    std::ostream& operator<<( std::ostream& os, const Event& event );
 
@@ -68,9 +69,19 @@ namespace TMVA {
       explicit Event( const std::vector<Float_t>&, 
                       UInt_t theClass, Double_t weight = 1.0, Double_t boostweight = 1.0 );
       explicit Event( const std::vector<Float_t*>*&, UInt_t nvar );
+      explicit Event( EventStore* store, UInt_t ievt );
 
       ~Event();
 
+      Event& operator=( const Event& );
+
+      // an event viewing an EventStore reads its values from the store; the const vector
+      // accessors fill copies cached in the event (like for dynamic events, this must not
+      // be done for the same event by several threads at once), the non-const ones first
+      // move the values out of the store into the event
+      Bool_t  IsView()            const { return fStore != 0; }
+      void    MoveToStore( EventStore* store, UInt_t ievt );
+
       // accessors
       Bool_t  IsDynamic()         const {return fDynamic; }
 
@@ -91,17 +102,18 @@ namespace TMVA {
       {
 	  //For a detailed explanation, please see the heading "Avoid Duplication in const and Non-const Member Function," on p. 23, in Item 3 "Use const whenever possible," in Effective C++, 3d ed by Scott Meyers, ISBN-13: 9780321334879.
 	  // http://stackoverflow.com/questions/123758/how-do-i-remove-code-duplication-between-similar-const-and-non-const-member-func
+	  if (fStore) LeaveStore();
 	  return const_cast<std::vector<Float_t>&>( static_cast<const Event&>(*this).GetValues() );
       }
       const std::vector<Float_t>& GetValues() const;
 
-      Float_t  GetTarget( UInt_t itgt ) const { return fTargets.at(itgt); }
-      std::vector<Float_t>& GetTargets()  { return fTargets; }
-      const std::vector<Float_t>& GetTargets() const { return fTargets; }
+      Float_t  GetTarget( UInt_t itgt ) const;
+      std::vector<Float_t>& GetTargets()  { if (fStore) LeaveStore(); return fTargets; }
+      const std::vector<Float_t>& GetTargets() const;
 
       Float_t  GetSpectator( UInt_t ivar) const;
-      std::vector<Float_t>& GetSpectators()  { return fSpectators; }
-      const std::vector<Float_t>& GetSpectators() const { return fSpectators; }
+      std::vector<Float_t>& GetSpectators()  { if (fStore) LeaveStore(); return fSpectators; }
+      const std::vector<Float_t>& GetSpectators() const;
 
       void     SetWeight             ( Double_t w ) { fWeight=w; }
       void     SetBoostWeight        ( Double_t w ) const { fDoNotBoost ? fDoNotBoost = kFALSE : fBoostWeight=w; }
@@ -122,9 +134,12 @@ namespace TMVA {
 
    private:
 
+      void     LeaveStore();
+      void     CopyValues( const Event& other );
+
       mutable std::vector<Float_t>   fValues;          // the event values ; mutable, to be able to copy the dynamic values in there
       mutable std::vector<Float_t*>* fValuesDynamic;   // the event values
-      std::vector<Float_t>   fTargets;         // target values for regression
+      mutable std::vector<Float_t>   fTargets;         // target values for regression ; mutable, to be able to copy the values of a store in there
       mutable std::vector<Float_t>   fSpectators;      // "visisting" variables not used in MVAs ; mutable, to be able to copy the dynamic values in there
 
       UInt_t                         fClass;           // class number
@@ -132,6 +147,8 @@ namespace TMVA {
       mutable Double_t               fBoostWeight;     // internal weight to be set by boosting algorithm
       Bool_t                         fDynamic;         // is set when the dynamic values are taken
       mutable Bool_t                 fDoNotBoost;       // mark event as not to be boosted (used to compensate for events with negative event weights
+      EventStore*                    fStore;           //! store holding the values of the event (0 if the event holds its own values)
+      UInt_t                         fStoreIndex;      //! index of the event in fStore
    };
 }
 
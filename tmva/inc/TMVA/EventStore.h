@@ -0,0 +1,117 @@
+// @(#)root/tmva $Id$
+// Author: Andreas Hoecker, Peter Speckmayer, Joerg Stelzer, Helge Voss
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : EventStore                                                            *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Columnar storage of the values, targets and spectators of a collection    *
+ *      of events in a single contiguous block (single or half precision)         *
+ *                                                                                *
+ * Authors (alphabetical):                                                        *
+ *      Andreas Hoecker <Andreas.Hocker@cern.ch> - CERN, Switzerland              *
+ *      Peter Speckmayer <Peter.Speckmayer@cern.ch>  - CERN, Switzerland          *
+ *      Joerg Stelzer   <Joerg.Stelzer@cern.ch>  - CERN, Switzerland              *
+ *      Helge Voss      <Helge.Voss@cern.ch>     - MPI-K Heidelberg, Germany      *
+ *                                                                                *
+ * Copyright (c) 2005-2011:                                                       *
+ *      CERN, Switzerland                                                         *
+ *      MPI-K Heidelberg, Germany                                                 *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+#ifndef ROOT_TMVA_EventStore
+#define ROOT_TMVA_EventStore
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// EventStore                                                           //
+//                                                                      //
+// Stores the variables, targets and spectators of nevents events in    //
+// one allocation, column after column: all values of variable 0, then  //
+// all values of variable 1, ..., followed by the targets and the       //
+// spectators. The values are kept either as Float_t or as IEEE 754     //
+// half precision numbers (UShort_t).                                   //
+//                                                                      //
+// The store is shared by the events viewing it (see Event(EventStore*, //
+// UInt_t)) and deletes itself when the last of them is deleted. The    //
+// views must be created and deleted by one thread at a time.           //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef ROOT_Rtypes
+#include "Rtypes.h"
+#endif
+
+namespace TMVA {
+
+   class EventStore {
+
+   public:
+
+      EventStore( UInt_t nevents, UInt_t nvar, UInt_t ntgt, UInt_t nspec, Bool_t halfPrecision = kFALSE );
+
+      UInt_t   GetNEvents()      const { return fNEvents; }
+      UInt_t   GetNVariables()   const { return fNVariables; }
+      UInt_t   GetNTargets()     const { return fNTargets; }
+      UInt_t   GetNSpectators()  const { return fNSpectators; }
+      Bool_t   IsHalfPrecision() const { return fHalfValues != 0; }
+
+      // number of stored values which were too large for half precision (stored as +-inf)
+      ULong64_t GetNOverflows()  const { return fNOverflows; }
+
+      // columns 0..nvar-1 are the variables, followed by the targets and the spectators
+      Float_t  GetValue    ( UInt_t ievt, UInt_t icol ) const;
+      void     SetValue    ( UInt_t ievt, UInt_t icol, Float_t value );
+
+      Float_t  GetVariable ( UInt_t ievt, UInt_t ivar ) const { return GetValue( ievt, ivar ); }
+      Float_t  GetTarget   ( UInt_t ievt, UInt_t itgt ) const { return GetValue( ievt, fNVariables + itgt ); }
+      Float_t  GetSpectator( UInt_t ievt, UInt_t ispc ) const { return GetValue( ievt, fNVariables + fNTargets + ispc ); }
+
+      // contiguous values of a column (single precision only, 0 otherwise)
+      const Float_t* GetColumn( UInt_t icol ) const { return fValues ? fValues + ULong64_t(icol)*fNEvents : 0; }
+
+      // memory used by the stored values
+      ULong64_t GetNBytes() const;
+
+      // reference counting of the events viewing the store
+      void     AddView()    { ++fNViews; }
+      void     RemoveView() { if (--fNViews == 0) delete this; }
+
+      // conversion between single and half precision (rounding to nearest even)
+      static UShort_t FloatToHalf( Float_t value );
+      static Float_t  HalfToFloat( UShort_t value );
+
+   private:
+
+      ~EventStore();
+      EventStore( const EventStore& );
+      EventStore& operator=( const EventStore& );
+
+      ULong64_t Index( UInt_t ievt, UInt_t icol ) const { return ULong64_t(icol)*fNEvents + ievt; }
+
+      UInt_t     fNEvents;      // number of events
+      UInt_t     fNVariables;   // number of variables
+      UInt_t     fNTargets;     // number of targets
+      UInt_t     fNSpectators;  // number of spectators
+      Float_t*   fValues;       // values in single precision (0 if half precision is used)
+      UShort_t*  fHalfValues;   // values in half precision (0 if single precision is used)
+      ULong64_t  fNOverflows;   // number of values too large for half precision
+      UInt_t     fNViews;       // number of events viewing the store
+   };
+}
+
+//_______________________________________________________________________
+inline Float_t TMVA::EventStore::GetValue( UInt_t ievt, UInt_t icol ) const
+{
+   if (fValues) return fValues[Index( ievt, icol )];
+   return HalfToFloat( fHalfValues[Index( ievt, icol )] );
+}
+
+#endif
@@ -234,6 +234,9 @@ namespace TMVA {
 
       void WriteDataInformation();
 
+      // train independent methods in parallel processes
+      void TrainMethodsInJobs( std::vector<Bool_t>& trainedInJob );
+
       DataInputHandler&        DataInput() { return *fDataInputHandler; }
       DataSetInfo&             DefaultDataSetInfo();
       void                     SetInputTreesFromEventAssignTrees();
@@ -53,6 +53,12 @@ namespace TMVA {
 
       virtual Double_t EstimatorFunction( std::vector<Double_t>& parameters ) = 0;
 
+      // estimators of several parameter sets at once (e.g. all individuals of
+      // a genetic algorithm population); the default calls EstimatorFunction
+      // for each set in the given order
+      virtual void     EstimatorFunctions( const std::vector< std::vector<Double_t>* >& parameters,
+                                           std::vector<Double_t>& estimators );
+
       // function to notify the FitterTarget of the progress status of the fitter
       // sender : "GA", "MC", ...
       // progress : "init", "iteration", "last", "stop"
@@ -126,6 +126,10 @@ namespace TMVA {
       // calculate the MVA value
       virtual Double_t GetMvaValue( Double_t* err = 0, Double_t* errUpper = 0 );
 
+      // calculate the MVA values of a set of events stored column-wise
+      using MethodBase::GetMvaValues;
+      virtual void GetMvaValues( const Float_t* values, UInt_t nEvents, Double_t* mvaValues );
+
       virtual const std::vector<Float_t> &GetRegressionValues();
 
       virtual const std::vector<Float_t> &GetMulticlassValues();
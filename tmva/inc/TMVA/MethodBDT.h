@@ -59,6 +59,8 @@
 namespace TMVA {
 
    class SeparationBase;
+   class DecisionTreeBinning;
+   class DecisionTreeForest;
 
    class MethodBDT : public MethodBase {
 
@@ -109,10 +111,18 @@ namespace TMVA {
       // calculate the MVA value
       Double_t GetMvaValue( Double_t* err = 0, Double_t* errUpper = 0);
 
+      // calculate the MVA values of a set of events at once
+      void GetMvaValues( const std::vector<const TMVA::Event*>& events, std::vector<Double_t>& mvaValues );
+      void GetMvaValues( const Float_t* values, UInt_t nEvents, Double_t* mvaValues );
+
    private:
       Double_t GetMvaValue( Double_t* err, Double_t* errUpper, UInt_t useNTrees );
       Double_t PrivateGetMvaValue( const TMVA::Event *ev, Double_t* err=0, Double_t* errUpper=0, UInt_t useNTrees=0 );
       void     BoostMonitor(Int_t iTree);
+      void     CompileForest();
+      Bool_t   UseFlatForest() const;
+      void     GetFlatForestMvaValues( const Float_t* values, UInt_t nEvents, UInt_t eventStride, UInt_t varStride,
+                                       Double_t* mvaValues );
 
    public:
       const std::vector<Float_t>& GetMulticlassValues();
@@ -256,6 +266,10 @@ namespace TMVA {
       Bool_t                           fPairNegWeightsInNode;   // randomly pair miscl. ev. with neg. and pos. weights in node and don't boost them
       Bool_t                           fTrainWithNegWeights; // yes there are negative event weights and we don't ignore them
       Bool_t                           fDoBoostMonitor; //create control plot with ROC integral vs tree number
+      Int_t                            fNThreads;       // number of threads used in the node splitting
+      Bool_t                           fUsePreBinning;  // bin the input variables once for all nodes and trees
+      DecisionTreeBinning*             fBinning;        // pre-binned training sample
+      DecisionTreeForest*              fFlatForest;     // the forest compiled into flat node arrays for the evaluation
 
 
       //some histograms for monitoring
@@ -276,6 +290,7 @@ namespace TMVA {
 
       void                             DeterminePreselectionCuts(const std::vector<const TMVA::Event*>& eventSample);
       Double_t                         ApplyPreselectionCuts(const Event* ev);
+      Double_t                         ApplyPreselectionCuts(const Float_t* values, UInt_t stride = 1);
       
       std::vector<Double_t> fLowSigCut;
       std::vector<Double_t> fLowBkgCut;
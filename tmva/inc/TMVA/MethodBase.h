@@ -176,10 +176,24 @@ namespace TMVA {
       // signal/background classification response
       Double_t GetMvaValue( const TMVA::Event* const ev, Double_t* err = 0, Double_t* errUpper = 0 );
 
+      // signal/background classification response for a set of events
+      virtual void GetMvaValues( const std::vector<const TMVA::Event*>& events, std::vector<Double_t>& mvaValues );
+
+      // the same for events stored column-wise, i.e. input variable ivar of
+      // event ievt is values[ivar*nEvents+ievt]
+      virtual void GetMvaValues( const Float_t* values, UInt_t nEvents, Double_t* mvaValues );
+
    protected:
       // helper function to set errors to -1
       void NoErrorCalc(Double_t* const err, Double_t* const errUpper);
 
+      // copy the input variables of a set of events stored column-wise and
+      // apply the variable transformations to all of them at once (with
+      // the reference classes of the transformations or the given class);
+      // returns kFALSE if the transformations cannot be applied this way
+      Bool_t GetTransformedColumns( const Float_t* input, UInt_t nEvents, std::vector<Float_t>& values ) const;
+      Bool_t GetTransformedColumns( const Float_t* input, UInt_t nEvents, std::vector<Float_t>& values, Int_t cls ) const;
+
    public:
       // regression response
       const std::vector<Float_t>& GetRegressionValues(const TMVA::Event* const ev){
@@ -128,6 +128,7 @@ namespace TMVA {
       
       Double_t EstimatorFunction( std::vector<Double_t> & );
       Double_t EstimatorFunction( Int_t ievt1, Int_t ievt2 );
+      void     EstimatorFunctions( const std::vector< std::vector<Double_t>* >&, std::vector<Double_t>& );
 
       void     SetTestSignalEfficiency( Double_t effS ) { fTestSignalEff = effS; }
 
@@ -228,6 +229,13 @@ namespace TMVA {
       // negative efficiencies
       Bool_t                  fNegEffWarning;      // flag risen in case of negative efficiency warning
 
+      // training events presorted by the first variable (EffSel during the training)
+      std::vector<Float_t>    fSortedEventsS;      // variables of the signal events
+      std::vector<Float_t>    fSortedWeightsS;     // weights of the signal events
+      std::vector<Float_t>    fSortedEventsB;      // variables of the background events
+      std::vector<Float_t>    fSortedWeightsB;     // weights of the background events
+      Int_t                   fNThreads;           // number of threads for the efficiencies of a GA population
+
 
       // the definition of fit parameters can be different from the actual 
       // cut requirements; these functions provide the matching
@@ -244,6 +252,13 @@ namespace TMVA {
       // returns signal and background efficiencies for given cuts - using event counting
       void     GetEffsfromSelection( Double_t* cutMin, Double_t* cutMax,
                                      Double_t& effS, Double_t& effB );
+      // returns signal and background efficiencies for given selected sums of weights
+      void     GetEffsfromSelectedWeights( Float_t nSelS, Float_t nSelB,
+                                           Double_t& effS, Double_t& effB );
+      // copies the training events of a class into the presorted arrays
+      void     FillSortedEvents( Int_t cls, std::vector<Float_t>& values, std::vector<Float_t>& weights );
+      // estimator for the given efficiencies of the cuts in fTmpCutMin, fTmpCutMax
+      Double_t ComputeEstimator( Double_t effS, Double_t effB );
       // returns signal and background efficiencies for given cuts - using PDFs
       void     GetEffsfromPDFs( Double_t* cutMin, Double_t* cutMax,
                                 Double_t& effS, Double_t& effB );
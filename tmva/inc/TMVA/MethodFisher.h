@@ -89,6 +89,10 @@ namespace TMVA {
       // calculate the MVA value
       Double_t GetMvaValue( Double_t* err = 0, Double_t* errUpper = 0 );
 
+      // calculate the MVA values of a set of events stored column-wise
+      using MethodBase::GetMvaValues;
+      void GetMvaValues( const Float_t* values, UInt_t nEvents, Double_t* mvaValues );
+
       enum EFisherMethod { kFisher, kMahalanobis };
       EFisherMethod GetFisherMethod( void ) { return fFisherMethod; }
 
@@ -78,6 +78,10 @@ namespace TMVA
       void Train( void );
 
       Double_t GetMvaValue( Double_t* err = 0, Double_t* errUpper = 0 );
+
+      // classifier response of many events at once
+      void GetMvaValues( const std::vector<const TMVA::Event*>& events, std::vector<Double_t>& mvaValues );
+      void GetMvaValues( const Float_t* values, UInt_t nEvents, Double_t* mvaValues );
       const std::vector<Float_t>& GetRegressionValues();
 
       using MethodBase::ReadWeightsFromStream;
@@ -121,6 +125,10 @@ namespace TMVA
       
       double getLDAValue(const kNN::List &rlist, const kNN::Event &event_knn);
 
+      // classifier response from the list of nearest neighbors of an event
+      Double_t getkNNValue(const kNN::List &rlist, const kNN::Event &event_knn);
+      void getkNNValues(const kNN::EventVec &events_knn, Double_t* mvaValues);
+
    private:
 
       // number of events (sumOfWeights)
@@ -142,6 +150,8 @@ namespace TMVA
       Bool_t fUseWeight;      // use weights to count kNN
       Bool_t fUseLDA;         // use local linear discriminat analysis to compute MVA
 
+      Int_t fNThreads;        // number of threads used to build and search the kd-tree
+
       kNN::EventVec fEvent;   //! (untouched) events used for learning
 
       LDA fLDA;               //! Experimental feature for local knn analysis
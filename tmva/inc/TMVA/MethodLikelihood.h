@@ -95,6 +95,10 @@ namespace TMVA {
       // the argument is used for internal ranking tests
       Double_t GetMvaValue( Double_t* err = 0, Double_t* errUpper = 0 );
 
+      // calculate the MVA values of a set of events stored column-wise
+      using MethodBase::GetMvaValues;
+      void GetMvaValues( const Float_t* values, UInt_t nEvents, Double_t* mvaValues );
+
       // write method specific histos to target file
       void WriteMonitoringHistosToFile() const;
 
@@ -121,6 +125,9 @@ namespace TMVA {
       // returns transformed or non-transformed output
       Double_t TransformLikelihoodOutput( Double_t ps, Double_t pb ) const;
 
+      // the (interpolated) signal (itype=0) or background PDF of variable ivar at x
+      Double_t GetPDFValue( UInt_t ivar, UInt_t itype, Double_t x ) const;
+
       // the option handling methods
       void Init();
       void DeclareOptions();
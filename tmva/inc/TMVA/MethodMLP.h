@@ -116,7 +116,7 @@ namespace TMVA {
       Double_t EstimatorFunction( std::vector<Double_t>& parameters );
 
       enum ETrainingMethod { kBP=0, kBFGS, kGA };
-      enum EBPTrainingMode { kSequential=0, kBatch };
+      enum EBPTrainingMode { kSequential=0, kBatch, kMiniBatch };
 
       bool     HasInverseHessian() { return fCalculateErrors; }
       Double_t GetMvaValue( Double_t* err=0, Double_t* errUpper=0 );
@@ -162,6 +162,7 @@ namespace TMVA {
       // backpropagation functions
       void     BackPropagationMinimize( Int_t nEpochs );
       void     TrainOneEpoch();
+      void     TrainOneEpochMiniBatch();
       void     Shuffle( Int_t* index, Int_t n );
       void     DecaySynapseWeights(Bool_t lateEpoch );
       void     TrainOneEvent( Int_t ievt);
@@ -214,9 +215,10 @@ namespace TMVA {
       // backpropagation variable
       Double_t        fLearnRate;      // learning rate for synapse weight adjustments
       Double_t        fDecayRate;      // decay rate for above learning rate
-      EBPTrainingMode fBPMode;         // backprop learning mode (sequential or batch)
-      TString         fBpModeS;        // backprop learning mode option string (sequential or batch)
-      Int_t           fBatchSize;      // batch size, only matters if in batch learning mode
+      EBPTrainingMode fBPMode;         // backprop learning mode (sequential, batch or minibatch)
+      TString         fBpModeS;        // backprop learning mode option string (sequential, batch or minibatch)
+      Int_t           fBatchSize;      // batch size, only matters if in batch or minibatch learning mode
+      Int_t           fNThreads;       // number of threads used in minibatch learning mode
       Int_t           fTestRate;       // test for overtraining performed at each #th epochs
       Bool_t          fEpochMon;       // create and fill epoch-wise monitoring histograms (makes outputfile big!)
       
@@ -222,6 +222,7 @@ namespace TMVA {
       UInt_t        fNmin;            // minimal number of events in cell necessary to split cell"
       Bool_t        fCutNmin;         // Keep for bw compatibility: Grabbing cell with maximal RMS to split next (TFoam default)
       UInt_t        fMaxDepth;        // maximum depth of cell tree
+      Int_t         fNThreads;        // number of threads for the cell exploration
 
       TString       fKernelStr;       // Kernel for GetMvaValue() (option string)
       EKernel       fKernel;          // Kernel for GetMvaValue()
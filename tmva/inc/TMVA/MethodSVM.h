@@ -116,6 +116,8 @@ namespace TMVA
       Float_t                       fTolerance;           // tolerance parameter
       UInt_t                        fMaxIter;             // max number of iteration
       UShort_t                      fNSubSets;            // nr of subsets, default 1
+      UInt_t                        fCacheSize;           // size of the kernel matrix row cache in MB
+      Int_t                         fNThreads;            // number of threads for the kernel evaluation
       Float_t                       fBparm;               // free plane coefficient 
       Float_t                       fGamma;               // RBF Kernel parameter
       SVWorkingSet*                 fWgSet;               // svm working set 
@@ -125,6 +125,12 @@ namespace TMVA {
 
          Bool_t Find(Event event, UInt_t nfind = 100, const std::string &option = "count") const;
          Bool_t Find(UInt_t nfind, const std::string &option) const;
+
+         // search for the nfind nearest neighbors of many events at once
+         Bool_t Find(const EventVec &events, UInt_t nfind, std::vector<List> &results) const;
+
+         // number of threads used to build the kd-tree and to search it
+         void SetNThreads(UInt_t nthreads);
       
          const EventVec& GetEventVec() const;
 
@@ -140,7 +146,11 @@ namespace TMVA {
 
       private:
 
-         Node<Event>* Optimize(UInt_t optimize_depth);
+         Node<Event>* Optimize(UInt_t optimize_depth) const;
+
+         void MakeTree() const;
+
+         void MakeFlatTree();
 
          void ComputeMetric(UInt_t ifrac);
 
@@ -152,7 +162,17 @@ namespace TMVA {
 
          UInt_t fDimn;
 
-         Node<Event> *fTree;
+         mutable Node<Event> *fTree; // linked kd-tree, only created for searches with option "weight"
+
+         UInt_t fODepth;   // balance depth of the linked kd-tree
+
+         UInt_t fNThreads; // number of threads used to build and search the flat kd-tree
+
+         std::vector<Node<Event> *> fNode; // one (unlinked) node per event, referred to by search results
+
+         std::vector<VarType> fFlatVar;   // flat kd-tree: variables of the events in tree order
+         std::vector<UInt_t>  fFlatEvent; // flat kd-tree: index of the events in tree order
+         std::vector<UInt_t>  fFlatSplit; // flat kd-tree: split variable of each node
 
          std::map<Int_t, Double_t> fVarScale;
 
@@ -225,6 +245,10 @@ namespace TMVA {
       {
          return fVarScale;
       }
+      inline void ModulekNN::SetNThreads(const UInt_t nthreads)
+      {
+         fNThreads = (nthreads > 0 ? nthreads : 1);
+      }
 
    } // end of kNN namespace
 } // end of TMVA namespace
@@ -76,6 +76,8 @@ namespace TMVA {
    private:
       std::vector< int > GetScanIndices( int val, std::vector<int> base);
       void optimizeScan();
+      void ScanInJobs( const std::vector< std::map<TString,Double_t> >& settings,
+                       std::vector<Double_t>& fom, std::vector<Bool_t>& done );
       void optimizeFit();
 
       Double_t EstimatorFunction( std::vector<Double_t> & );
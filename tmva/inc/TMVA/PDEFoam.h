@@ -141,6 +141,8 @@ namespace TMVA {
       Timer *fTimer;           //! timer for graphical output
       TObjArray *fVariableNames;// collection of all variable names
       mutable MsgLogger* fLogger;                     //! message logger
+      UInt_t fNThreads;        //! number of threads for the cell exploration
+      std::vector<Double_t> fCellSplit; //! division point of each divided cell, for FindCell()
 
       /////////////////////////////////////////////////////////////////
       //                            METHODS                          //
@@ -163,6 +165,9 @@ namespace TMVA {
       Long_t PeekMax();             // peek cell with max. driver integral
       Int_t  Divide(PDEFoamCell *); // Divide iCell into two daughters; iCell retained, taged as inactive
       Double_t Eval(Double_t *xRand, Double_t &event_density); // evaluate distribution on point 'xRand'
+      void EvalBatch(PDEFoamVect&, PDEFoamVect&, Double_t, Int_t, std::vector<Double_t>&,
+                     std::vector<Double_t>&, std::vector<Double_t>&); // sample and evaluate n points in parallel
+      static void* EvalBatchWorker(void*); // thread function of EvalBatch()
 
       // ---------- Cell value access functions
 
@@ -196,8 +201,9 @@ namespace TMVA {
       // ---------- Foam creation functions
 
       void Initialize() {}        // initialize the PDEFoam
-      void FillBinarySearchTree( const Event* ev ); // fill event into BST
+      void FillBinarySearchTree( const Event* ev ); // fill event into the search tree
       void Create();              // build-up foam
+      void BuildCellSplits();     // cache the division points of the cells for FindCell()
 
       // function to fill created cell with given value
       virtual void FillFoamCells(const Event* ev, Float_t wt);
@@ -231,6 +237,8 @@ namespace TMVA {
       UInt_t   GetNmin()               { return fNmin;   }
       void     SetMaxDepth(UInt_t maxdepth) { fMaxDepth = maxdepth; }
       UInt_t   GetMaxDepth() const { return fMaxDepth; }
+      void     SetNThreads(UInt_t n) { fNThreads = (n > 0 ? n : 1); }
+      UInt_t   GetNThreads() const { return fNThreads; }
 
       // Getters and Setters for foam boundaries
       void SetXmin(Int_t idim, Double_t wmin);
@@ -243,8 +251,7 @@ namespace TMVA {
       void AddVariableName(TObjString *s) { fVariableNames->Add(s); }
       TObjString* GetVariableName(Int_t idx) {return dynamic_cast<TObjString*>(fVariableNames->At(idx));}
 
-      // Delete the fDistr object, which contains the binary search
-      // tree
+      // Delete the fDistr object, which contains the search tree
       void DeleteBinarySearchTree();
 
       // ---------- Transformation functions for event variables into foam boundaries
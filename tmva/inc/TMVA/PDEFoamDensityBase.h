@@ -36,9 +36,8 @@
 #include "TObject.h"
 #endif
 
-#ifndef ROOT_TMVA_BinarySearchTree
-#include "TMVA/BinarySearchTree.h"
-#endif
+#include <vector>
+
 #ifndef ROOT_TMVA_Event
 #include "TMVA/Event.h"
 #endif
@@ -57,8 +56,23 @@ namespace TMVA
       Double_t fBoxVolume;        // volume of range searching box
       Bool_t fBoxHasChanged;      // range searching box has changed
 
+      // flat kd-tree of the filled events: the node of the events
+      // first..last-1 is the event (first+last)/2, the events before
+      // it form the left and the events after it the right subtree
+      std::vector<Float_t> fEventVars;    //! variables of the events (fBox.size() per event)
+      std::vector<Float_t> fEventTargets; //! targets of the events (fNTargets per event)
+      std::vector<Float_t> fEventWeights; //! weights of the events
+      std::vector<UInt_t>  fEventClasses; //! classes of the events
+      std::vector<UInt_t>  fSplit;        //! split variable of each node
+      UInt_t fNTargets;                   //! number of targets per event
+      Bool_t fTreeIsBuilt;                //! the events are in kd-tree order
+
+      // search the subtree first..last-1 for the queries active[begin..end-1]
+      void SearchNode(UInt_t first, UInt_t last, const Double_t *lower, const Double_t *upper,
+                      std::vector<UInt_t> &active, UInt_t begin, UInt_t end,
+                      std::vector< std::vector<UInt_t> > &found) const;
+
    protected:
-      BinarySearchTree *fBst;     // Binary tree to find events within a volume
       mutable MsgLogger *fLogger; //! message logger
 
       MsgLogger& Log() const { return *fLogger; }
@@ -66,15 +80,38 @@ namespace TMVA
       // calculate volume of fBox
       Double_t GetBoxVolume();
 
+      // range searching: indices of the events found in the boxes
+      // (lower, upper] of n queries, dim = fBox.size() values per query
+      void SearchVolumes(UInt_t n, const Double_t *lower, const Double_t *upper,
+                         std::vector< std::vector<UInt_t> > &found) const;
+
+      // range searching in the boxes fBox placed at the n points xev
+      void SearchBoxes(UInt_t n, const Double_t *xev,
+                       std::vector< std::vector<UInt_t> > &found);
+
+      // access to the events found
+      Float_t GetEventValue (UInt_t iev, UInt_t ivar) const { return fEventVars[iev*fBox.size() + ivar]; }
+      Float_t GetEventTarget(UInt_t iev, UInt_t itgt) const { return fEventTargets[iev*fNTargets + itgt]; }
+      Float_t GetEventWeight(UInt_t iev) const { return fEventWeights[iev]; }
+      UInt_t  GetEventClass (UInt_t iev) const { return fEventClasses[iev]; }
+      UInt_t  GetNTargets() const { return fNTargets; }
+
    public:
       PDEFoamDensityBase();
       PDEFoamDensityBase(std::vector<Double_t> box);
       PDEFoamDensityBase(const PDEFoamDensityBase&);
       virtual ~PDEFoamDensityBase();
 
-      // fill event into binary search tree
+      // fill event into the search tree
       void FillBinarySearchTree(const Event* ev);
 
+      // build the search tree of the filled events and calculate the
+      // box volume, done lazily by the first density evaluation
+      void BuildTree();
+
+      // number of filled events
+      UInt_t GetNEvents() const { return fEventWeights.size(); }
+
       // set the range-searching box
       void SetBox(std::vector<Double_t> box) { fBox = box; fBoxHasChanged = kTRUE; }
 
@@ -82,10 +119,14 @@ namespace TMVA
       const std::vector<Double_t>& GetBox() const { return fBox; }
 
       // main function used by PDEFoam
-      // returns density at a given point by range searching in BST
+      // returns density at a given point by range searching
       virtual Double_t Density(std::vector<Double_t> &Xarg, Double_t &event_density) = 0;
 
-      ClassDef(PDEFoamDensityBase, 1) // PDEFoam event density interface
+      // densities at n points xev (fBox.size() values per point),
+      // thread safe after BuildTree()
+      virtual void DensityBatch(UInt_t n, const Double_t *xev, Double_t *density, Double_t *event_density);
+
+      ClassDef(PDEFoamDensityBase, 2) // PDEFoam event density interface
    };  //end of PDEFoamDensityBase
 
 }  // namespace TMVA
@@ -54,9 +54,12 @@ namespace TMVA
 
       // main function used by PDEFoam
       // returns discriminant density N_class/N_total at a given point
-      // by range searching in BST
+      // by range searching
       virtual Double_t Density(std::vector<Double_t> &Xarg, Double_t &event_density);
 
+      // discriminant densities at n points
+      virtual void DensityBatch(UInt_t n, const Double_t *xev, Double_t *density, Double_t *event_density);
+
       ClassDef(PDEFoamDiscriminantDensity, 1) //Class for Discriminant density
    };  //end of PDEFoamDiscriminantDensity
 
@@ -50,9 +50,12 @@ namespace TMVA
       virtual ~PDEFoamEventDensity() {}
 
       // main function used by PDEFoam
-      // returns event density at a given point by range searching in BST
+      // returns event density at a given point by range searching
       virtual Double_t Density(std::vector<Double_t> &Xarg, Double_t &event_density);
 
+      // event densities at n points
+      virtual void DensityBatch(UInt_t n, const Double_t *xev, Double_t *density, Double_t *event_density);
+
       ClassDef(PDEFoamEventDensity, 1) //Class for Event density
    };  //end of PDEFoamEventDensity
 
@@ -53,9 +53,12 @@ namespace TMVA
       virtual ~PDEFoamTargetDensity() {}
 
       // main function used by PDEFoam
-      // returns event density at a given point by range searching in BST
+      // returns event density at a given point by range searching
       virtual Double_t Density(std::vector<Double_t> &Xarg, Double_t &event_density);
 
+      // target densities at n points
+      virtual void DensityBatch(UInt_t n, const Double_t *xev, Double_t *density, Double_t *event_density);
+
       ClassDef(PDEFoamTargetDensity, 1) //Class for Target density
    };  //end of PDEFoamTargetDensity
 
@@ -102,6 +102,14 @@ namespace TMVA {
       Double_t EvaluateMVA( MethodBase* method,           Double_t aux = 0 );
       Double_t EvaluateMVA( const TString& methodTag,     Double_t aux = 0 );
 
+      // MVA responses for a set of events (no errors are calculated)
+      void     EvaluateMVA( const std::vector< std::vector<Float_t> >&, const TString& methodTag,
+                            std::vector<Double_t>& mvaValues, Double_t aux = 0 );
+      // the same for nEvents events stored column-wise, input variable ivar of
+      // event ievt is inputs[ivar*nEvents+ievt]
+      void     EvaluateMVA( const Float_t* inputs, UInt_t nEvents, const TString& methodTag,
+                            Double_t* mvaValues, Double_t aux = 0 );
+
       // returns error on MVA response for given event
       // NOTE: must be called AFTER "EvaluateMVA(...)" call !
       Double_t GetMVAError() const { return fMvaEventError; }
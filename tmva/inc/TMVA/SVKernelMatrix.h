@@ -33,6 +33,7 @@
 #endif
 
 #include <vector>
+#include <list>
 
 namespace TMVA {
 
@@ -46,21 +47,31 @@ namespace TMVA {
 
       //constructors
       SVKernelMatrix();
-      SVKernelMatrix( std::vector<TMVA::SVEvent*>*, SVKernelFunction* );
+      SVKernelMatrix( std::vector<TMVA::SVEvent*>*, SVKernelFunction*, UInt_t cacheSize = 1000, UInt_t nThreads = 1 );
       
       //destructor
       ~SVKernelMatrix();
       
       //functions
+      // the returned row is owned by the cache and stays valid until the
+      // next call of GetLine (the two most recently used rows always stay valid)
       Float_t* GetLine   ( UInt_t );
       Float_t* GetColumn ( UInt_t col ) { return this->GetLine(col);}
       Float_t  GetElement( UInt_t i, UInt_t j );
 
    private:
 
-      UInt_t               fSize;              // matrix size
-      SVKernelFunction*    fKernelFunction;    // kernel function
-      Float_t**            fSVKernelMatrix;    // kernel matrix
+      void     ComputeLine( UInt_t line, Float_t* row );
+
+      UInt_t                        fSize;           // matrix size
+      SVKernelFunction*             fKernelFunction; // kernel function
+      std::vector<TMVA::SVEvent*>*  fInputVectors;   // events the matrix is built of
+      std::vector<Float_t>          fDiagonal;       // diagonal elements of the kernel matrix
+      UInt_t                        fMaxLines;       // maximum number of rows kept in the cache
+      UInt_t                        fNThreads;       // number of threads for computing a row
+      std::vector<Float_t*>         fLines;          // cached rows (0 if not cached)
+      std::list<UInt_t>             fLRU;            // cached rows, most recently used first
+      std::vector< std::list<UInt_t>::iterator > fLRUPos; // position of the cached rows in fLRU
 
       mutable MsgLogger* fLogger;                     //! message logger
       MsgLogger& Log() const { return *fLogger; }
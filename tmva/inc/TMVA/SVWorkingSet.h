@@ -46,7 +46,7 @@ namespace TMVA {
    public:
 
       SVWorkingSet();
-      SVWorkingSet( std::vector<TMVA::SVEvent*>*, SVKernelFunction*, Float_t , Bool_t);
+      SVWorkingSet( std::vector<TMVA::SVEvent*>*, SVKernelFunction*, Float_t , Bool_t, UInt_t cacheSize = 1000, UInt_t nThreads = 1 );
       ~SVWorkingSet();
                 
       Bool_t  ExamineExample( SVEvent*);
@@ -77,6 +77,14 @@ namespace TMVA {
       const Event* Transform(const Event*) const;
       const Event* InverseTransform(const Event*, Bool_t suppressIfNoTargets=true  ) const;
 
+      // transformation of the variables of a set of events stored column-wise
+      // (variable ivar of event ievt at values[ivar*nEvents+ievt]), with the
+      // reference classes of the transformations or with the given class;
+      // returns kFALSE without changing the values if a transformation does
+      // not support this
+      Bool_t       TransformColumns( Float_t* values, UInt_t nEvents ) const;
+      Bool_t       TransformColumns( Float_t* values, UInt_t nEvents, Int_t cls ) const;
+
       // overrides the reference classes of all added transformations. Handle with care!!!
       void         SetTransformationReferenceClass( Int_t cls ); 
 
@@ -119,6 +127,8 @@ namespace TMVA {
 
    private:
       
+      Bool_t TransformColumns( Float_t* values, UInt_t nEvents, const std::vector<Int_t>& classes ) const;
+
       std::vector<TMVA::Event*>* TransformCollection( VariableTransformBase* trf,
                                                       Int_t cls,
                                                       std::vector<TMVA::Event*>* events,
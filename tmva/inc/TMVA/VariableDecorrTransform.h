@@ -64,6 +64,9 @@ namespace TMVA {
       virtual const Event* Transform(const Event* const, Int_t cls ) const;
       virtual const Event* InverseTransform(const Event* const, Int_t cls ) const;
 
+      virtual Bool_t CanTransformColumns() const;
+      virtual void   TransformColumns( Float_t* values, UInt_t nEvents, Int_t cls ) const;
+
       void WriteTransformationToStream ( std::ostream& ) const;
       void ReadTransformationFromStream( std::istream&, const TString& );
 
@@ -61,6 +61,9 @@ namespace TMVA {
       virtual const Event* Transform(const Event* const, Int_t cls ) const;
       virtual const Event* InverseTransform(const Event* const ev, Int_t cls ) const { return Transform( ev, cls ); }
 
+      virtual Bool_t CanTransformColumns() const { return kTRUE; }
+      virtual void   TransformColumns( Float_t*, UInt_t, Int_t ) const {}
+
       // writer of function code
       virtual void MakeFunction(std::ostream& fout, const TString& fncName, Int_t part, UInt_t trCounter, Int_t cls );
 
@@ -80,6 +80,11 @@ namespace TMVA {
       virtual const Event* Transform       ( const Event* const, Int_t cls ) const = 0;
       virtual const Event* InverseTransform( const Event* const, Int_t cls ) const = 0;
 
+      // transformation of the variables of a set of events stored column-wise,
+      // i.e. variable ivar of event ievt is values[ivar*nEvents+ievt]
+      virtual Bool_t       CanTransformColumns() const { return kFALSE; }
+      virtual void         TransformColumns( Float_t* /*values*/, UInt_t /*nEvents*/, Int_t /*cls*/ ) const {}
+
       // accessors
       void   SetEnabled  ( Bool_t e ) { fEnabled = e; }
       void   SetNormalise( Bool_t n ) { fNormalise = n; }
@@ -132,6 +137,9 @@ namespace TMVA {
 
       void CalcNorm( const std::vector<const Event*>& );
 
+      // true if only input variables are transformed (in place)
+      Bool_t SelectsOnlyVariables() const;
+
       void SetCreated( Bool_t c = kTRUE ) { fCreated = c; }
       void SetNVariables( UInt_t i )      { fNVars = i; }
       void SetName( const TString& c )    { fTransformName = c; }
@@ -41,6 +41,7 @@ TMVA::Config::Config() :
    fSilent               ( kFALSE ),
    fWriteOptionsReference( kFALSE ),
    fDrawProgressBar      ( kTRUE ),
+   fNJobs                ( 1 ),
    fLogger               ( new MsgLogger("Config") )
 {
    // constructor - set defaults
@@ -77,6 +77,9 @@
 #ifndef ROOT_TMVA_Event
 #include "TMVA/Event.h"
 #endif
+#ifndef ROOT_TMVA_EventStore
+#include "TMVA/EventStore.h"
+#endif
 
 using namespace std;
 
@@ -98,6 +101,7 @@ namespace TMVA {
 TMVA::DataSetFactory::DataSetFactory() :
    fVerbose(kFALSE),
    fVerboseLevel(TString("Info")),
+   fEventStorage(TString("Float")),
    fCurrentTree(0),
    fCurrentEvtIdx(0),
    fInputFormulas(0),
@@ -625,6 +629,13 @@ TMVA::DataSetFactory::InitOptions( TMVA::DataSetInfo& dsi,
       splitSpecs.DeclareOptionRef( nEventRequests.at(cl).nTestingEventsRequested , TString("nTest_")+clName , titleTest  );
    }
 
+   fEventStorage = "Float";  // the storage of the event values
+   splitSpecs.DeclareOptionRef( fEventStorage, "EventStorage",
+                                "Storage of the event values (Float: one contiguous block of columns for all events; Float16: the same in half precision, for values within +-65504; Vector: separate vectors for each event)" );
+   splitSpecs.AddPreDefVal(TString("Float"));
+   splitSpecs.AddPreDefVal(TString("Float16"));
+   splitSpecs.AddPreDefVal(TString("Vector"));
+
    splitSpecs.DeclareOptionRef( fVerbose, "V", "Verbosity (default: true)" );
 
    splitSpecs.DeclareOptionRef( fVerboseLevel=TString("Info"), "VerboseLevel", "VerboseLevel (Debug/Verbose/Info)" );
@@ -1320,6 +1331,9 @@ TMVA::DataSetFactory::MixEvents( DataSetInfo& dsi,
    Log() << kDEBUG << "trainingEventVector " << trainingEventVector->size() << Endl;
    Log() << kDEBUG << "testingEventVector  " << testingEventVector->size() << Endl;
 
+   // move the event values into the columnar store
+   BuildEventStore( dsi, *trainingEventVector, *testingEventVector );
+
    // create dataset
    DataSet* ds = new DataSet(dsi);
 
@@ -1333,6 +1347,37 @@ TMVA::DataSetFactory::MixEvents( DataSetInfo& dsi,
 
 }
 
+//_______________________________________________________________________
+void
+TMVA::DataSetFactory::BuildEventStore( DataSetInfo& dsi,
+                                       EventVector& trainingEvents,
+                                       EventVector& testingEvents )
+{
+   // moves the values of the training and testing events into a single
+   // EventStore, in which the values of each variable, target and spectator
+   // are contiguous (first the training events, in their order, then the
+   // testing events); the events then view the store instead of holding
+   // their own vectors
+   if (fEventStorage == "Vector") return;
+
+   UInt_t nevents = trainingEvents.size() + testingEvents.size();
+   if (nevents == 0) return;
+
+   EventStore* store = new EventStore( nevents, dsi.GetNVariables(), dsi.GetNTargets(), dsi.GetNSpectators(),
+                                       fEventStorage == "Float16" );
+   UInt_t ievt = 0;
+   for (EventVector::iterator it = trainingEvents.begin(), itEnd = trainingEvents.end(); it != itEnd; ++it)
+      (*it)->MoveToStore( store, ievt++ );
+   for (EventVector::iterator it = testingEvents.begin(), itEnd = testingEvents.end(); it != itEnd; ++it)
+      (*it)->MoveToStore( store, ievt++ );
+
+   Log() << kINFO << "Event values stored in " << (store->IsHalfPrecision() ? "half" : "single")
+         << " precision: " << store->GetNBytes()/1024 << " kB" << Endl;
+   if (store->GetNOverflows() > 0)
+      Log() << kWARNING << store->GetNOverflows() << " values exceed the half precision range (+-65504)"
+            << " and are stored as infinity; use EventStorage=Float for these data" << Endl;
+}
+
 //_______________________________________________________________________
 void
 TMVA::DataSetFactory::RenormEvents( TMVA::DataSetInfo& dsi,
@@ -63,6 +63,10 @@
 #include <algorithm>
 #include <cassert>
 
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
 #include "TRandom3.h"
 #include "TMath.h"
 #include "TMatrix.h"
@@ -70,6 +74,7 @@
 #include "TMVA/MsgLogger.h"
 #include "TMVA/DecisionTree.h"
 #include "TMVA/DecisionTreeNode.h"
+#include "TMVA/DecisionTreeBinning.h"
 #include "TMVA/BinarySearchTree.h"
 
 #include "TMVA/Tools.h"
@@ -115,6 +120,8 @@ TMVA::DecisionTree::DecisionTree():
    fSigClass       (0),
    fPairNegWeightsInNode(kFALSE),
    fTreeID         (0),
+   fNThreads       (1),
+   fBinning        (NULL),
    fAnalysisType   (Types::kClassification)
 {
    // default constructor using the GiniIndex as separation criterion,
@@ -149,7 +156,9 @@ TMVA::DecisionTree::DecisionTree( TMVA::SeparationBase *sepType, Float_t minSize
    fMaxDepth       (nMaxDepth),
    fSigClass       (cls),
    fPairNegWeightsInNode(kFALSE),
-   fTreeID         (treeID)
+   fTreeID         (treeID),
+   fNThreads       (1),
+   fBinning        (NULL)
 {
    // constructor specifying the separation type, the min number of
    // events in a no that is still subjected to further splitting, the
@@ -199,6 +208,8 @@ TMVA::DecisionTree::DecisionTree( const DecisionTree &d ):
    fSigClass   (d.fSigClass),
    fPairNegWeightsInNode(d.fPairNegWeightsInNode),
    fTreeID     (d.fTreeID),
+   fNThreads   (d.fNThreads),
+   fBinning    (d.fBinning),
    fAnalysisType(d.fAnalysisType)
 {
    // copy constructor that creates a true copy, i.e. a completely independent tree
@@ -925,6 +936,92 @@ void TMVA::DecisionTree::GetRandomisedVariables(Bool_t *useVariable, UInt_t *map
    if (nSelectedVars != useNvars) { std::cout << "Bug in TrainNode - GetRandisedVariables()... sorry" << std::endl; std::exit(1);}
 }
 
+namespace {
+
+   // the cut scan histograms of one node, filled per variable in
+   // TMVA::DecisionTree::TrainNodeFast (possibly in parallel threads)
+   struct DecisionTreeCutScan {
+      const std::vector<const TMVA::Event*>* eventSample;
+      const TMVA::DecisionTreeBinning* binning; // pre-binned sample, NULL if not used
+      const Long64_t* rows;                     // rows of the events in the pre-binned sample
+      const UInt_t*   firstBin;                 // first bin of the pre-binning inside the node range
+      const Bool_t*   useVariable;
+      const Double_t* fisherCoeff;
+      const Double_t* xmin;
+      const Double_t* xmax;
+      UInt_t   nvars;                           // number of input variables (the Fisher variable is nvars)
+      UInt_t   nBins;
+      UInt_t   sigClass;
+      Bool_t   regression;
+      Double_t** nSelS;
+      Double_t** nSelB;
+      Double_t** nSelS_unWeighted;
+      Double_t** nSelB_unWeighted;
+      Double_t** target;
+      Double_t** target2;
+   };
+
+   struct DecisionTreeCutScanTask {
+      const DecisionTreeCutScan* scan;
+      const UInt_t* vars;                       // the variables to fill
+      UInt_t nVars;
+   };
+
+   //_______________________________________________________________________
+   void FillCutScan( const DecisionTreeCutScan& s, UInt_t ivar )
+   {
+      // fill the cut scan histograms of variable ivar with all events of the node.
+      // The events are filled in the order of the sample, as in the serial case
+
+      const std::vector<const TMVA::Event*>& eventSample = *s.eventSample;
+      const UInt_t nevents = eventSample.size();
+      const UInt_t nBins = s.nBins;
+      const Bool_t binned = (s.binning != NULL && ivar < s.nvars);
+
+      for (UInt_t iev=0; iev<nevents; iev++) {
+         const TMVA::Event* ev = eventSample[iev];
+         Double_t eventWeight = ev->GetWeight();
+         Int_t iBin;
+         if (binned) {
+            iBin = s.binning->GetBin(s.rows[iev],ivar) - s.firstBin[ivar];
+         } else {
+            Double_t eventData;
+            if (ivar < s.nvars) eventData = ev->GetValue(ivar);
+            else { // the fisher variable
+               eventData = s.fisherCoeff[s.nvars];
+               for (UInt_t jvar=0; jvar<s.nvars; jvar++)
+                  eventData += s.fisherCoeff[jvar]*ev->GetValue(jvar);
+            }
+            // "maximum" is nbins-1 (the "-1" because we start counting from 0 !!
+            iBin = TMath::Min(Int_t(nBins-1),TMath::Max(0,int (nBins*(eventData-s.xmin[ivar])/(s.xmax[ivar]-s.xmin[ivar]) ) ));
+         }
+         if (ev->GetClass() == s.sigClass) {
+            s.nSelS[ivar][iBin]+=eventWeight;
+            s.nSelS_unWeighted[ivar][iBin]++;
+         }
+         else {
+            s.nSelB[ivar][iBin]+=eventWeight;
+            s.nSelB_unWeighted[ivar][iBin]++;
+         }
+         if (s.regression) {
+            s.target[ivar][iBin] +=eventWeight*ev->GetTarget(0);
+            s.target2[ivar][iBin]+=eventWeight*ev->GetTarget(0)*ev->GetTarget(0);
+         }
+      }
+   }
+
+   //_______________________________________________________________________
+   void* FillCutScanWorker( void* arg )
+   {
+      // thread function filling the cut scan histograms of the variables of a task
+
+      DecisionTreeCutScanTask* task = (DecisionTreeCutScanTask*) arg;
+      for (UInt_t i=0; i<task->nVars; i++) FillCutScan(*task->scan, task->vars[i]);
+      return 0;
+   }
+
+}
+
 //_______________________________________________________________________
 Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
                                            TMVA::DecisionTreeNode *node )
@@ -936,6 +1033,11 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
    // in addition to the individual variables, one can also ask for a fisher
    // discriminant being built out of (some) of the variables and used as a
    // possible multivariate split.
+   // The histograms of the different variables are filled in parallel
+   // threads if SetNThreads() was called with more than one thread, and
+   // from the bin indices of a pre-binned sample if one was given with
+   // SetBinning(); the candidate cuts are then the bin boundaries of the
+   // pre-binning inside the range of the node.
 
    Double_t  separationGainTotal = -1, sepTmp;
    Double_t *separationGain    = new Double_t[fNvars+1];
@@ -1074,10 +1176,35 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
       }
    }
 
+   // with a pre-binned sample the histogram of each variable covers the
+   // bins of the pre-binning inside the range of the node
+   std::vector<UInt_t> nBinsVar(cNvars, nBins);
+   std::vector<UInt_t> firstBin(cNvars, 0);
+   std::vector<Long64_t> rows;
+   Bool_t useBinning = (fBinning != NULL && fBinning->GetNBins() == nBins && fBinning->GetNVariables() == fNvars);
+   if (useBinning) {
+      rows.resize(nevents);
+      for (UInt_t iev=0; iev<nevents && useBinning; iev++) {
+         rows[iev] = fBinning->GetRow(eventSample[iev]);
+         if (rows[iev] < 0) useBinning = kFALSE; // event not in the pre-binned sample
+      }
+   }
+   if (useBinning) {
+      for (UInt_t ivar=0; ivar < fNvars; ivar++) {
+         firstBin[ivar] = fBinning->GetBin(ivar, xmin[ivar]);
+         nBinsVar[ivar] = fBinning->GetBin(ivar, xmax[ivar]) - firstBin[ivar] + 1;
+      }
+   }
+
    // fill the cut values for the scan:
    for (UInt_t ivar=0; ivar < cNvars; ivar++) {
 
-      if ( useVariable[ivar] ) {
+      if ( useVariable[ivar] && useBinning && ivar < fNvars ) {
+         for (UInt_t icut=0; icut+1<nBinsVar[ivar]; icut++) {
+            cutValues[ivar][icut]=fBinning->GetCutValue(ivar, firstBin[ivar]+icut);
+         }
+      }
+      else if ( useVariable[ivar] ) {
          
          //set the grid for the cut scan on the variables like this:
          // 
@@ -1115,41 +1242,73 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
          nTotB+=eventWeight;
          nTotB_unWeighted++;
       }
-      
-      Int_t iBin=-1;
-      for (UInt_t ivar=0; ivar < cNvars; ivar++) {
-         // now scan trough the cuts for each varable and find which one gives
-         // the best separationGain at the current stage.
-         if ( useVariable[ivar] ) {
-            Double_t eventData;
-            if (ivar < fNvars) eventData = eventSample[iev]->GetValue(ivar); 
-            else { // the fisher variable
-               eventData = fisherCoeff[fNvars];
-               for (UInt_t jvar=0; jvar<fNvars; jvar++)
-                  eventData += fisherCoeff[jvar]*(eventSample[iev])->GetValue(jvar);
-               
-            }
-            // "maximum" is nbins-1 (the "-1" because we start counting from 0 !!
-            iBin = TMath::Min(Int_t(nBins-1),TMath::Max(0,int (nBins*(eventData-xmin[ivar])/(xmax[ivar]-xmin[ivar]) ) ));
-            if (eventSample[iev]->GetClass() == fSigClass) {
-               nSelS[ivar][iBin]+=eventWeight;
-               nSelS_unWeighted[ivar][iBin]++;
-            } 
-            else {
-               nSelB[ivar][iBin]+=eventWeight;
-               nSelB_unWeighted[ivar][iBin]++;
-            }
-            if (DoRegression()) {
-               target[ivar][iBin] +=eventWeight*eventSample[iev]->GetTarget(0);
-               target2[ivar][iBin]+=eventWeight*eventSample[iev]->GetTarget(0)*eventSample[iev]->GetTarget(0);
-            }
+   }
+
+   // now fill the histograms of each variable, which are later scanned for
+   // the cut that gives the best separationGain at the current stage.
+   DecisionTreeCutScan scan;
+   scan.eventSample = &eventSample;
+   scan.binning = useBinning ? fBinning : NULL;
+   scan.rows = useBinning ? &rows[0] : NULL;
+   scan.firstBin = &firstBin[0];
+   scan.useVariable = useVariable;
+   scan.fisherCoeff = fisherCoeff.empty() ? NULL : &fisherCoeff[0];
+   scan.xmin = xmin;
+   scan.xmax = xmax;
+   scan.nvars = fNvars;
+   scan.nBins = nBins;
+   scan.sigClass = fSigClass;
+   scan.regression = DoRegression();
+   scan.nSelS = nSelS;
+   scan.nSelB = nSelB;
+   scan.nSelS_unWeighted = nSelS_unWeighted;
+   scan.nSelB_unWeighted = nSelB_unWeighted;
+   scan.target = target;
+   scan.target2 = target2;
+
+   std::vector<UInt_t> usedVars;
+   for (UInt_t ivar=0; ivar < cNvars; ivar++) {
+      if (useVariable[ivar]) usedVars.push_back(ivar);
+   }
+
+   // threads are only worth their start-up cost for large nodes
+   UInt_t nThreads = TMath::Min(fNThreads, UInt_t(usedVars.size()));
+   if (nThreads > 1 && nevents*usedVars.size() < 100000) nThreads = 1;
+
+#ifndef _WIN32
+   if (nThreads > 1) {
+      // distribute the variables in contiguous blocks over the threads, the
+      // last block is filled in the calling thread
+      std::vector<DecisionTreeCutScanTask> tasks(nThreads);
+      std::vector<pthread_t> threads(nThreads);
+      std::vector<Bool_t> started(nThreads, kFALSE);
+      UInt_t nUsed = usedVars.size();
+      for (UInt_t i=0; i<nThreads; i++) {
+         UInt_t first = (i*nUsed)/nThreads;
+         UInt_t last  = ((i+1)*nUsed)/nThreads;
+         tasks[i].scan  = &scan;
+         tasks[i].vars  = &usedVars[first];
+         tasks[i].nVars = last-first;
+         if (i<nThreads-1) {
+            started[i] = (pthread_create(&threads[i],0,FillCutScanWorker,&tasks[i])==0);
          }
+         if (!started[i]) FillCutScanWorker(&tasks[i]);
+      }
+      for (UInt_t i=0; i<nThreads; i++) {
+         if (started[i]) pthread_join(threads[i],0);
       }
-   }   
+   }
+   else
+#endif
+   {
+      for (UInt_t i=0; i<usedVars.size(); i++) FillCutScan(scan, usedVars[i]);
+   }
+
    // now turn the "histogram" into a cummulative distribution
    for (UInt_t ivar=0; ivar < cNvars; ivar++) {
       if (useVariable[ivar]) {
-         for (UInt_t ibin=1; ibin < nBins; ibin++) {
+         const UInt_t nVarBins = nBinsVar[ivar];
+         for (UInt_t ibin=1; ibin < nVarBins; ibin++) {
             nSelS[ivar][ibin]+=nSelS[ivar][ibin-1];
             nSelS_unWeighted[ivar][ibin]+=nSelS_unWeighted[ivar][ibin-1];
             nSelB[ivar][ibin]+=nSelB[ivar][ibin-1];
@@ -1159,13 +1318,13 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
                target2[ivar][ibin]+=target2[ivar][ibin-1];
             }
          }
-         if (nSelS_unWeighted[ivar][nBins-1] +nSelB_unWeighted[ivar][nBins-1] != eventSample.size()) {
+         if (nSelS_unWeighted[ivar][nVarBins-1] +nSelB_unWeighted[ivar][nVarBins-1] != eventSample.size()) {
             Log() << kFATAL << "Helge, you have a bug ....nSelS_unw..+nSelB_unw..= "
-                  << nSelS_unWeighted[ivar][nBins-1] +nSelB_unWeighted[ivar][nBins-1] 
+                  << nSelS_unWeighted[ivar][nVarBins-1] +nSelB_unWeighted[ivar][nVarBins-1] 
                   << " while eventsample size = " << eventSample.size()
                   << Endl;
          }
-         double lastBins=nSelS[ivar][nBins-1] +nSelB[ivar][nBins-1];
+         double lastBins=nSelS[ivar][nVarBins-1] +nSelB[ivar][nVarBins-1];
          double totalSum=nTotS+nTotB;
          if (TMath::Abs(lastBins-totalSum)/totalSum>0.01) {
             Log() << kFATAL << "Helge, you have another bug ....nSelS+nSelB= "
@@ -1179,7 +1338,8 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
    // the best separationGain at the current stage
    for (UInt_t ivar=0; ivar < cNvars; ivar++) {
       if (useVariable[ivar]) {
-         for (UInt_t iBin=0; iBin<nBins-1; iBin++) { // the last bin contains "all events" -->skip
+         const UInt_t nVarBins = nBinsVar[ivar];
+         for (UInt_t iBin=0; iBin<nVarBins-1; iBin++) { // the last bin contains "all events" -->skip
             // the separationGain is defined as the various indices (Gini, CorssEntropy, e.t.c)
             // calculated by the "SamplePurities" fom the branches that would go to the
             // left or the right from this node if "these" cuts were used in the Node:
@@ -1210,7 +1370,7 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
                   sepTmp = fRegType->GetSeparationGain(nSelS[ivar][iBin]+nSelB[ivar][iBin], 
                                                        target[ivar][iBin],target2[ivar][iBin],
                                                        nTotS+nTotB,
-                                                       target[ivar][nBins-1],target2[ivar][nBins-1]);
+                                                       target[ivar][nVarBins-1],target2[ivar][nVarBins-1]);
                } else {
                   sepTmp = fSepType->GetSeparationGain(nSelS[ivar][iBin], nSelB[ivar][iBin], nTotS, nTotB);
                }
@@ -1229,9 +1389,10 @@ Double_t TMVA::DecisionTree::TrainNodeFast( const EventConstList & eventSample,
    }
    
    if (DoRegression()) {
-      node->SetSeparationIndex(fRegType->GetSeparationIndex(nTotS+nTotB,target[0][nBins-1],target2[0][nBins-1]));
-      node->SetResponse(target[0][nBins-1]/(nTotS+nTotB));
-      node->SetRMS(TMath::Sqrt(target2[0][nBins-1]/(nTotS+nTotB) - target[0][nBins-1]/(nTotS+nTotB)*target[0][nBins-1]/(nTotS+nTotB)));
+      const UInt_t nVarBins = nBinsVar[0];
+      node->SetSeparationIndex(fRegType->GetSeparationIndex(nTotS+nTotB,target[0][nVarBins-1],target2[0][nVarBins-1]));
+      node->SetResponse(target[0][nVarBins-1]/(nTotS+nTotB));
+      node->SetRMS(TMath::Sqrt(target2[0][nVarBins-1]/(nTotS+nTotB) - target[0][nVarBins-1]/(nTotS+nTotB)*target[0][nVarBins-1]/(nTotS+nTotB)));
    }
    else {
       node->SetSeparationIndex(fSepType->GetSeparationIndex(nTotS,nTotB));
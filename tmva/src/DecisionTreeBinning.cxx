@@ -0,0 +1,126 @@
+// @(#)root/tmva $Id$
+// Author: Andreas Hoecker, Joerg Stelzer, Helge Voss, Kai Voss, Jan Therhaag, Eckhard von Toerne
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : TMVA::DecisionTreeBinning                                             *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Implementation (see header for description)                               *
+ *                                                                                *
+ * Authors (alphabetical):                                                        *
+ *      Andreas Hoecker <Andreas.Hocker@cern.ch> - CERN, Switzerland              *
+ *      Helge Voss      <Helge.Voss@cern.ch>     - MPI-K Heidelberg, Germany      *
+ *      Kai Voss        <Kai.Voss@cern.ch>       - U. of Victoria, Canada         *
+ *      Eckhard v. Toerne  <evt@uni-bonn.de>          - U of Bonn, Germany        *
+ *      Jan Therhaag          <Jan.Therhaag@cern.ch>   - U of Bonn, Germany       *
+ *                                                                                *
+ * Copyright (c) 2005-2011:                                                       *
+ *      CERN, Switzerland                                                         *
+ *      U. of Victoria, Canada                                                    *
+ *      MPI-K Heidelberg, Germany                                                 *
+ *      U. of Bonn, Germany                                                       *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://mva.sourceforge.net/license.txt)                                       *
+ *                                                                                *
+ **********************************************************************************/
+
+//_______________________________________________________________________
+//
+// Pre-binned training sample for the decision tree node splitting
+//
+// The range of each input variable over the full training sample is
+// divided once into nBins equidistant bins and the bin index of every
+// variable of every event is stored in one byte (up to 256 bins) or
+// two bytes. The node splitting (DecisionTree::TrainNodeFast) then only
+// looks up these indices instead of recalculating the bin of each value
+// in each node, and the same table is reused for all trees of a boosted
+// forest. The candidate cuts of a node are the bin boundaries inside the
+// range of the node. The bins are defined consistently with the cut
+// (DecisionTreeNode::GoesRight), i.e. a value x is in bin i if exactly
+// i bin boundaries are smaller than x.
+//_______________________________________________________________________
+
+#include <algorithm>
+
+#include "TMVA/DecisionTreeBinning.h"
+#include "TMVA/Event.h"
+
+//_______________________________________________________________________
+TMVA::DecisionTreeBinning::DecisionTreeBinning( const std::vector<const TMVA::Event*>& eventSample, UInt_t nBins ):
+   fNvars ( eventSample.empty() ? 0 : eventSample[0]->GetNVariables() ),
+   fNBins ( std::max(UInt_t(1),std::min(nBins,UInt_t(65536))) ),
+   fRows  ( 2*eventSample.size()+100 )
+{
+   // constructor, bins all variables of all events of the sample into
+   // nBins equidistant bins between the minimum and maximum value of
+   // the variable in the sample (at most 65536 bins)
+
+   UInt_t nevents = eventSample.size();
+
+   std::vector<Double_t> xmin(fNvars,0), xmax(fNvars,0);
+   for (UInt_t iev=0; iev<nevents; iev++) {
+      for (UInt_t ivar=0; ivar<fNvars; ivar++) {
+         const Double_t val = eventSample[iev]->GetValue(ivar);
+         if (iev==0) xmin[ivar]=xmax[ivar]=val;
+         if (val < xmin[ivar]) xmin[ivar]=val;
+         if (val > xmax[ivar]) xmax[ivar]=val;
+      }
+   }
+
+   // the cuts are stored with the precision of the node cut values
+   fCutValues.resize(fNvars);
+   for (UInt_t ivar=0; ivar<fNvars; ivar++) {
+      Double_t istepSize = ( xmax[ivar] - xmin[ivar] ) / Double_t(fNBins);
+      fCutValues[ivar].resize(fNBins-1);
+      for (UInt_t icut=0; icut<fNBins-1; icut++) {
+         fCutValues[ivar][icut] = Float_t(xmin[ivar]+(Double_t(icut+1))*istepSize);
+      }
+   }
+
+   if (fNBins <= 256) fBins8.resize(nevents*fNvars);
+   else               fBins16.resize(nevents*fNvars);
+
+   for (UInt_t iev=0; iev<nevents; iev++) {
+      const TMVA::Event* ev = eventSample[iev];
+      const Long64_t key = (Long64_t)(Long_t)ev;
+      UInt_t slot;
+      if (fRows.GetValue( key, key, slot ) == 0) fRows.AddAt( slot, key, key, Long64_t(iev)+1 );
+      for (UInt_t ivar=0; ivar<fNvars; ivar++) {
+         UInt_t ibin = GetBin(ivar, ev->GetValue(ivar));
+         if (fBins8.empty()) fBins16[iev*fNvars+ivar] = ibin;
+         else                fBins8[iev*fNvars+ivar]  = ibin;
+      }
+   }
+}
+
+//_______________________________________________________________________
+TMVA::DecisionTreeBinning::~DecisionTreeBinning()
+{
+   // destructor
+}
+
+//_______________________________________________________________________
+UInt_t TMVA::DecisionTreeBinning::GetBin( UInt_t ivar, Double_t x ) const
+{
+   // return the bin of value x of variable ivar, i.e. the number of bin
+   // boundaries that are smaller than x
+
+   const std::vector<Double_t>& cuts = fCutValues[ivar];
+   return std::lower_bound(cuts.begin(), cuts.end(), x) - cuts.begin();
+}
+
+//_______________________________________________________________________
+Long64_t TMVA::DecisionTreeBinning::GetRow( const TMVA::Event* ev ) const
+{
+   // return the row of the event in the binned sample, or -1 if the
+   // event was not part of the sample (rows are stored with offset one,
+   // as zero is returned for unknown keys)
+
+   const Long64_t key = (Long64_t)(Long_t)ev;
+   return fRows.GetValue( key, key ) - 1;
+}
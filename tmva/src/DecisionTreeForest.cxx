@@ -0,0 +1,232 @@
+// @(#)root/tmva $Id$
+// Author: Andreas Hoecker, Joerg Stelzer, Helge Voss, Kai Voss, Jan Therhaag, Eckhard von Toerne
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : TMVA::DecisionTreeForest                                              *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Implementation (see header for description)                               *
+ *                                                                                *
+ * Authors (alphabetical):                                                        *
+ *      Andreas Hoecker <Andreas.Hocker@cern.ch> - CERN, Switzerland              *
+ *      Helge Voss      <Helge.Voss@cern.ch>     - MPI-K Heidelberg, Germany      *
+ *      Kai Voss        <Kai.Voss@cern.ch>       - U. of Victoria, Canada         *
+ *      Eckhard v. Toerne  <evt@uni-bonn.de>          - U of Bonn, Germany        *
+ *      Jan Therhaag          <Jan.Therhaag@cern.ch>   - U of Bonn, Germany       *
+ *                                                                                *
+ * Copyright (c) 2005-2011:                                                       *
+ *      CERN, Switzerland                                                         *
+ *      U. of Victoria, Canada                                                    *
+ *      MPI-K Heidelberg, Germany                                                 *
+ *      U. of Bonn, Germany                                                       *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://mva.sourceforge.net/license.txt)                                       *
+ *                                                                                *
+ **********************************************************************************/
+
+//_______________________________________________________________________
+//
+// Forest of decision trees compiled into flat node arrays
+//
+// The nodes of all trees are stored in contiguous arrays (cut variable,
+// cut value, the two daughters and the leaf responses), in depth-first
+// order per tree, instead of being linked DecisionTreeNode objects. The
+// daughters of each node are ordered such that the second one is taken
+// if the value is above the cut, so the descent needs no branch on the
+// cut type. Leaves point to themselves, which allows to descend trees
+// without Fisher cuts with a fixed number of steps (the depth of the tree)
+// without any data dependent branch; in CheckEvents() the descents of a
+// block of events are interleaved in this way. The responses are identical
+// to DecisionTree::CheckEvent.
+//_______________________________________________________________________
+
+#include <algorithm>
+
+#include "TMVA/DecisionTreeForest.h"
+#include "TMVA/DecisionTree.h"
+#include "TMVA/DecisionTreeNode.h"
+#include "TMVA/MsgLogger.h"
+
+//_______________________________________________________________________
+TMVA::DecisionTreeForest::DecisionTreeForest( const std::vector<TMVA::DecisionTree*>& forest ):
+   fNVars ( 0 ),
+   fLogger( new MsgLogger("DecisionTreeForest") )
+{
+   // constructor, compiles the given trees into the flat node arrays
+
+   for (UInt_t itree=0; itree<forest.size(); itree++) {
+      const TMVA::DecisionTreeNode* root = forest[itree]->GetRoot();
+      if (!root) Log() << kFATAL << "Tree " << itree << " has no root node" << Endl;
+      UInt_t maxDepth = 0;
+      Bool_t hasFisher = kFALSE;
+      fTreeRoot.push_back( AddNode(root, forest[itree]->DoRegression(), 0, maxDepth, hasFisher) );
+      fTreeDepth.push_back( maxDepth );
+      fTreeFisher.push_back( hasFisher );
+   }
+}
+
+//_______________________________________________________________________
+TMVA::DecisionTreeForest::~DecisionTreeForest()
+{
+   // destructor
+   delete fLogger;
+}
+
+//_______________________________________________________________________
+Int_t TMVA::DecisionTreeForest::AddNode( const TMVA::DecisionTreeNode* node, Bool_t regression, UInt_t depth,
+                                         UInt_t& maxDepth, Bool_t& hasFisher )
+{
+   // append the node and (recursively) its daughters, return its index
+
+   Int_t inode = fSelector.size();
+   fSelector.push_back(0);
+   fCutValue.push_back(0);
+   fChildren.push_back(inode);
+   fChildren.push_back(inode);
+   fFisherOffset.push_back(-1);
+   fFisherNCoeff.push_back(0);
+   fIsLeaf.push_back(1);
+   fValue.push_back(0);
+   fValueYesNo.push_back(0);
+
+   if (node->GetNodeType() != 0) { // leaf node (possibly of a pruned tree)
+      if (regression) {
+         fValue[inode] = fValueYesNo[inode] = node->GetResponse();
+      }
+      else {
+         fValue[inode] = node->GetPurity();
+         fValueYesNo[inode] = node->GetNodeType();
+      }
+      maxDepth = std::max(maxDepth, depth);
+      return inode;
+   }
+
+   const TMVA::DecisionTreeNode* left  = (const TMVA::DecisionTreeNode*) node->GetLeft();
+   const TMVA::DecisionTreeNode* right = (const TMVA::DecisionTreeNode*) node->GetRight();
+   if (!left || !right) {
+      Log() << kFATAL << "DecisionTreeForest: inconsistent tree structure" << Endl;
+   }
+
+   fIsLeaf[inode]   = 0;
+   fSelector[inode] = node->GetSelector();
+   fCutValue[inode] = node->GetCutValue();
+   fNVars = std::max(fNVars, UInt_t(fSelector[inode]+1));
+   if (node->GetNFisherCoeff() > 0) {
+      fFisherOffset[inode] = fFisherCoeff.size();
+      fFisherNCoeff[inode] = node->GetNFisherCoeff();
+      for (UInt_t ivar=0; ivar<node->GetNFisherCoeff(); ivar++) fFisherCoeff.push_back(node->GetFisherCoeff(ivar));
+      fNVars = std::max(fNVars, node->GetNFisherCoeff()-1);
+      hasFisher = kTRUE;
+   }
+
+   Int_t ileft  = AddNode(left,  regression, depth+1, maxDepth, hasFisher);
+   Int_t iright = AddNode(right, regression, depth+1, maxDepth, hasFisher);
+
+   // events above the cut go right if the cut selects signal (see DecisionTreeNode::GoesRight)
+   if (node->GetCutType()) {
+      fChildren[2*inode]   = ileft;
+      fChildren[2*inode+1] = iright;
+   }
+   else {
+      fChildren[2*inode]   = iright;
+      fChildren[2*inode+1] = ileft;
+   }
+   return inode;
+}
+
+//_______________________________________________________________________
+inline Int_t TMVA::DecisionTreeForest::GetLeaf( UInt_t itree, const Float_t* values ) const
+{
+   // descend tree itree with the given input values and return the leaf
+
+   Int_t inode = fTreeRoot[itree];
+   if (!fTreeFisher[itree]) {
+      const Int_t*   selector = &fSelector[0];
+      const Float_t* cutValue = &fCutValue[0];
+      const Int_t*   children = &fChildren[0];
+      for (UInt_t idepth=0; idepth<fTreeDepth[itree]; idepth++) {
+         inode = children[2*inode + (values[selector[inode]] > cutValue[inode])];
+      }
+      return inode;
+   }
+
+   while (!fIsLeaf[inode]) {
+      Bool_t above;
+      if (fFisherOffset[inode] < 0) {
+         above = values[fSelector[inode]] > fCutValue[inode];
+      }
+      else {
+         const Double_t* coeff = &fFisherCoeff[fFisherOffset[inode]];
+         const Int_t nvars = fFisherNCoeff[inode]-1;
+         Double_t fisher = coeff[nvars]; // the offset
+         for (Int_t ivar=0; ivar<nvars; ivar++) fisher += coeff[ivar]*values[ivar];
+         above = fisher > fCutValue[inode];
+      }
+      inode = fChildren[2*inode + (above ? 1 : 0)];
+   }
+   return inode;
+}
+
+//_______________________________________________________________________
+Double_t TMVA::DecisionTreeForest::CheckEvent( UInt_t itree, const Float_t* values, Bool_t useYesNoLeaf ) const
+{
+   // return the response of tree itree for an event with the given input
+   // values: the regression response, or the node type (useYesNoLeaf) or
+   // purity of the leaf in which the event ends up
+
+   Int_t ileaf = GetLeaf(itree, values);
+   return useYesNoLeaf ? fValueYesNo[ileaf] : fValue[ileaf];
+}
+
+//_______________________________________________________________________
+void TMVA::DecisionTreeForest::CheckEvents( UInt_t itree, const Float_t* values, UInt_t nEvents,
+                                            UInt_t eventStride, UInt_t varStride,
+                                            Bool_t useYesNoLeaf, Double_t* response ) const
+{
+   // fill the responses of tree itree for nEvents events, variable ivar of
+   // event i is values[i*eventStride+ivar*varStride], i.e. the events can be
+   // stored row-wise (eventStride=nvar, varStride=1) or column-wise
+   // (eventStride=1, varStride=nEvents). For trees without Fisher cuts the
+   // descents of blocks of events are done step by step in parallel, which
+   // hides the memory latency of the node lookups
+
+   const std::vector<Double_t>& leafValue = useYesNoLeaf ? fValueYesNo : fValue;
+
+   if (fTreeFisher[itree]) {
+      std::vector<Float_t> row( varStride==1 ? 0 : fNVars );
+      for (UInt_t iev=0; iev<nEvents; iev++) {
+         const Float_t* x = values + iev*eventStride;
+         if (varStride != 1) {
+            for (UInt_t ivar=0; ivar<fNVars; ivar++) row[ivar] = x[ivar*varStride];
+            x = &row[0];
+         }
+         response[iev] = leafValue[GetLeaf(itree, x)];
+      }
+      return;
+   }
+
+   const Int_t*   selector = &fSelector[0];
+   const Float_t* cutValue = &fCutValue[0];
+   const Int_t*   children = &fChildren[0];
+   const UInt_t   depth    = fTreeDepth[itree];
+
+   const UInt_t kBlockSize = 64;
+   Int_t inode[kBlockSize];
+   for (UInt_t first=0; first<nEvents; first+=kBlockSize) {
+      const UInt_t n = std::min(kBlockSize, nEvents-first);
+      const Float_t* x = values + first*eventStride;
+      for (UInt_t i=0; i<n; i++) inode[i] = fTreeRoot[itree];
+      for (UInt_t idepth=0; idepth<depth; idepth++) {
+         for (UInt_t i=0; i<n; i++) {
+            const Int_t k = inode[i];
+            inode[i] = children[2*k + (x[i*eventStride+selector[k]*varStride] > cutValue[k])];
+         }
+      }
+      for (UInt_t i=0; i<n; i++) response[first+i] = leafValue[inode[i]];
+   }
+}
@@ -29,6 +29,7 @@
  **********************************************************************************/
 
 #include "TMVA/Event.h"
+#include "TMVA/EventStore.h"
 #include "TMVA/Tools.h"
 #include <iostream>
 #include "assert.h"
@@ -49,7 +50,9 @@ TMVA::Event::Event()
      fWeight(1.0),
      fBoostWeight(1.0),
      fDynamic(kFALSE),
-     fDoNotBoost(kFALSE)
+     fDoNotBoost(kFALSE),
+     fStore(0),
+     fStoreIndex(0)
 {
    // copy constructor
 }
@@ -68,7 +71,9 @@ TMVA::Event::Event( const std::vector<Float_t>& ev,
      fWeight(weight),
      fBoostWeight(boostweight),
      fDynamic(kFALSE),
-     fDoNotBoost(kFALSE)
+     fDoNotBoost(kFALSE),
+     fStore(0),
+     fStoreIndex(0)
 {
    // constructor
 }
@@ -88,7 +93,9 @@ TMVA::Event::Event( const std::vector<Float_t>& ev,
      fWeight(weight),
      fBoostWeight(boostweight),
      fDynamic(kFALSE),
-     fDoNotBoost(kFALSE)
+     fDoNotBoost(kFALSE),
+     fStore(0),
+     fStoreIndex(0)
 {
    // constructor
 }
@@ -106,7 +113,9 @@ TMVA::Event::Event( const std::vector<Float_t>& ev,
      fWeight(weight),
      fBoostWeight(boostweight),
      fDynamic(kFALSE),
-     fDoNotBoost(kFALSE)
+     fDoNotBoost(kFALSE),
+     fStore(0),
+     fStoreIndex(0)
 {
    // constructor
 }
@@ -121,12 +130,32 @@ TMVA::Event::Event( const std::vector<Float_t*>*& evdyn, UInt_t nvar )
      fWeight(0),
      fBoostWeight(0),
      fDynamic(true),
-     fDoNotBoost(kFALSE)
+     fDoNotBoost(kFALSE),
+     fStore(0),
+     fStoreIndex(0)
 {
    // constructor for single events
    fValuesDynamic = (std::vector<Float_t*>*) evdyn;
 }
 
+//____________________________________________________________
+TMVA::Event::Event( EventStore* store, UInt_t ievt )
+   : fValues(),
+     fValuesDynamic(0),
+     fTargets(),
+     fSpectators(),
+     fClass(0),
+     fWeight(1.0),
+     fBoostWeight(1.0),
+     fDynamic(kFALSE),
+     fDoNotBoost(kFALSE),
+     fStore(store),
+     fStoreIndex(ievt)
+{
+   // constructor of an event viewing the values of event ievt of the store
+   fStore->AddView();
+}
+
 //____________________________________________________________
 TMVA::Event::Event( const Event& event ) 
    : fValues(event.fValues),
@@ -137,9 +166,12 @@ TMVA::Event::Event( const Event& event )
      fWeight(event.fWeight),
      fBoostWeight(event.fBoostWeight),
      fDynamic(event.fDynamic),
-     fDoNotBoost(kFALSE)
+     fDoNotBoost(kFALSE),
+     fStore(0),
+     fStoreIndex(0)
 {
-   // copy constructor
+   // copy constructor; the copy of an event viewing a store holds its own values
+   if (event.fStore) CopyValues( event );
    if (event.fDynamic){
       fValues.clear();
       UInt_t nvar = event.GetNVariables();
@@ -166,12 +198,53 @@ TMVA::Event::Event( const Event& event )
 TMVA::Event::~Event()
 {
    // Event destructor
+   if (fStore) fStore->RemoveView();
 }
 
 //____________________________________________________________
-void TMVA::Event::CopyVarValues( const Event& other )
+TMVA::Event& TMVA::Event::operator=( const Event& other )
 {
-   // copies only the variable values
+   // assignment; an event viewing a store keeps viewing it if the
+   // numbers of variables, targets and spectators of both events agree
+   if (this == &other) return *this;
+   if (fStore && !other.fDynamic) {
+      CopyVarValues( other );
+   }
+   else {
+      if (fStore) { fStore->RemoveView(); fStore = 0; }
+      if (other.fStore) {
+         CopyValues( other );
+      }
+      else {
+         fValues      = other.fValues;
+         fTargets     = other.fTargets;
+         fSpectators  = other.fSpectators;
+      }
+      fValuesDynamic = other.fValuesDynamic;
+      fDynamic       = other.fDynamic;
+      fClass         = other.fClass;
+      fWeight        = other.fWeight;
+      fBoostWeight   = other.fBoostWeight;
+   }
+   fDoNotBoost = other.fDoNotBoost;
+   return *this;
+}
+
+//____________________________________________________________
+void TMVA::Event::CopyValues( const Event& other )
+{
+   // copies the variables, targets and spectators of other into the vectors of this event
+   if (other.fStore) {
+      EventStore* store = other.fStore;
+      UInt_t      ievt  = other.fStoreIndex;
+      fValues.resize( store->GetNVariables() );
+      for (UInt_t ivar=0; ivar<fValues.size(); ivar++) fValues[ivar] = store->GetVariable( ievt, ivar );
+      fTargets.resize( store->GetNTargets() );
+      for (UInt_t itgt=0; itgt<fTargets.size(); itgt++) fTargets[itgt] = store->GetTarget( ievt, itgt );
+      fSpectators.resize( store->GetNSpectators() );
+      for (UInt_t ispc=0; ispc<fSpectators.size(); ispc++) fSpectators[ispc] = store->GetSpectator( ievt, ispc );
+      return;
+   }
    fValues      = other.fValues;
    fTargets     = other.fTargets;
    fSpectators  = other.fSpectators;
@@ -192,6 +265,27 @@ void TMVA::Event::CopyVarValues( const Event& other )
          ++idx;
       }
    }
+}
+
+//____________________________________________________________
+void TMVA::Event::CopyVarValues( const Event& other )
+{
+   // copies only the variable values
+   if (fStore && other.GetNVariables()  == fStore->GetNVariables() &&
+       other.GetNTargets()    == fStore->GetNTargets() &&
+       other.GetNSpectators() == fStore->GetNSpectators()) {
+      // write the values into the store
+      for (UInt_t ivar=0; ivar<fStore->GetNVariables(); ivar++)
+         fStore->SetValue( fStoreIndex, ivar, other.GetValue(ivar) );
+      for (UInt_t itgt=0; itgt<fStore->GetNTargets(); itgt++)
+         fStore->SetValue( fStoreIndex, fStore->GetNVariables()+itgt, other.GetTarget(itgt) );
+      for (UInt_t ispc=0; ispc<fStore->GetNSpectators(); ispc++)
+         fStore->SetValue( fStoreIndex, fStore->GetNVariables()+fStore->GetNTargets()+ispc, other.GetSpectator(ispc) );
+   }
+   else {
+      if (fStore) { fStore->RemoveView(); fStore = 0; }
+      CopyValues( other );
+   }
    fDynamic     = kFALSE;
    fValuesDynamic = NULL;
 
@@ -200,13 +294,50 @@ void TMVA::Event::CopyVarValues( const Event& other )
    fBoostWeight = other.fBoostWeight;
 }
 
+//____________________________________________________________
+void TMVA::Event::MoveToStore( EventStore* store, UInt_t ievt )
+{
+   // copies the values of the event to event ievt of the store, which
+   // must have the same numbers of variables, targets and spectators;
+   // the event then views the store and releases its own vectors
+   if (store == fStore && ievt == fStoreIndex) return;
+   for (UInt_t ivar=0; ivar<store->GetNVariables(); ivar++)
+      store->SetValue( ievt, ivar, GetValue(ivar) );
+   for (UInt_t itgt=0; itgt<store->GetNTargets(); itgt++)
+      store->SetValue( ievt, store->GetNVariables()+itgt, GetTarget(itgt) );
+   for (UInt_t ispc=0; ispc<store->GetNSpectators(); ispc++)
+      store->SetValue( ievt, store->GetNVariables()+store->GetNTargets()+ispc, GetSpectator(ispc) );
+
+   store->AddView();
+   if (fStore) fStore->RemoveView();
+   fStore      = store;
+   fStoreIndex = ievt;
+   std::vector<Float_t>().swap( fValues );
+   std::vector<Float_t>().swap( fTargets );
+   std::vector<Float_t>().swap( fSpectators );
+   fDynamic       = kFALSE;
+   fValuesDynamic = NULL;
+}
+
+//____________________________________________________________
+void TMVA::Event::LeaveStore()
+{
+   // moves the values of the event out of the store into its own vectors
+   CopyValues( *this );
+   fStore->RemoveView();
+   fStore = 0;
+}
+
 //____________________________________________________________
 Float_t TMVA::Event::GetValue( UInt_t ivar ) const
 {
    // return value of i'th variable
    Float_t retval;
    //   std::cout<< fDynamic ; 
-   if (fDynamic){
+   if (fStore) {
+      retval = fStore->GetVariable( fStoreIndex, ivar );
+   }
+   else if (fDynamic){
      //     std::cout<< " " << (*fValuesDynamic).size() << " " << fValues.size() << std::endl;
       retval = *((*fValuesDynamic).at(ivar));
    }
@@ -221,6 +352,7 @@ Float_t TMVA::Event::GetValue( UInt_t ivar ) const
 Float_t TMVA::Event::GetSpectator( UInt_t ivar) const 
 {
    // return spectator content
+   if (fStore)   return fStore->GetSpectator( fStoreIndex, ivar );
    if (fDynamic) return *(fValuesDynamic->at(GetNVariables()+ivar));
    else          return fSpectators.at(ivar);
 }
@@ -229,7 +361,11 @@ Float_t TMVA::Event::GetSpectator( UInt_t ivar) const
 const std::vector<Float_t>& TMVA::Event::GetValues() const
 {
    // return value vector
-   if (fDynamic) {
+   if (fStore) {
+      fValues.resize( fStore->GetNVariables() );
+      for (UInt_t ivar=0; ivar<fValues.size(); ivar++) fValues[ivar] = fStore->GetVariable( fStoreIndex, ivar );
+   }
+   else if (fDynamic) {
       fValues.clear();
       for (std::vector<Float_t*>::const_iterator it = fValuesDynamic->begin(), itEnd=fValuesDynamic->end()-GetNSpectators(); 
            it != itEnd; ++it) { 
@@ -240,10 +376,41 @@ const std::vector<Float_t>& TMVA::Event::GetValues() const
    return fValues;
 }
 
+//____________________________________________________________
+Float_t TMVA::Event::GetTarget( UInt_t itgt ) const
+{
+   // return target content
+   if (fStore) return fStore->GetTarget( fStoreIndex, itgt );
+   return fTargets.at(itgt);
+}
+
+//____________________________________________________________
+const std::vector<Float_t>& TMVA::Event::GetTargets() const
+{
+   // return target vector
+   if (fStore) {
+      fTargets.resize( fStore->GetNTargets() );
+      for (UInt_t itgt=0; itgt<fTargets.size(); itgt++) fTargets[itgt] = fStore->GetTarget( fStoreIndex, itgt );
+   }
+   return fTargets;
+}
+
+//____________________________________________________________
+const std::vector<Float_t>& TMVA::Event::GetSpectators() const
+{
+   // return spectator vector
+   if (fStore) {
+      fSpectators.resize( fStore->GetNSpectators() );
+      for (UInt_t ispc=0; ispc<fSpectators.size(); ispc++) fSpectators[ispc] = fStore->GetSpectator( fStoreIndex, ispc );
+   }
+   return fSpectators;
+}
+
 //____________________________________________________________
 UInt_t TMVA::Event::GetNVariables() const 
 {
    // accessor to the number of variables 
+   if (fStore) return fStore->GetNVariables();
    return fValues.size();
 }
 
@@ -251,6 +418,7 @@ UInt_t TMVA::Event::GetNVariables() const
 UInt_t TMVA::Event::GetNTargets() const 
 {
    // accessor to the number of targets
+   if (fStore) return fStore->GetNTargets();
    return fTargets.size();
 }
 
@@ -259,6 +427,7 @@ UInt_t TMVA::Event::GetNSpectators() const
 {
    // accessor to the number of spectators 
 
+   if (fStore) return fStore->GetNSpectators();
    return fSpectators.size();
 }
 
@@ -267,6 +436,13 @@ UInt_t TMVA::Event::GetNSpectators() const
 void TMVA::Event::SetVal( UInt_t ivar, Float_t val ) 
 {
    // set variable ivar to val
+   if (fStore) {
+      if (ivar < fStore->GetNVariables()) {
+         fStore->SetValue( fStoreIndex, ivar, val );
+         return;
+      }
+      LeaveStore();
+   }
    if ((fDynamic ?( (*fValuesDynamic).size() ) : fValues.size())<=ivar)
       (fDynamic ?( (*fValuesDynamic).resize(ivar+1) ) : fValues.resize(ivar+1));
 
@@ -285,6 +461,13 @@ void TMVA::Event::SetTarget( UInt_t itgt, Float_t value )
 { 
    // set the target value (dimension itgt) to value
 
+   if (fStore) {
+      if (itgt < fStore->GetNTargets()) {
+         fStore->SetValue( fStoreIndex, fStore->GetNVariables()+itgt, value );
+         return;
+      }
+      LeaveStore();
+   }
    if (fTargets.size() <= itgt) fTargets.resize( itgt+1 );
    fTargets.at(itgt) = value;
 }
@@ -294,6 +477,13 @@ void TMVA::Event::SetSpectator( UInt_t ivar, Float_t value )
 { 
    // set spectator value (dimension ivar) to value
 
+   if (fStore) {
+      if (ivar < fStore->GetNSpectators()) {
+         fStore->SetValue( fStoreIndex, fStore->GetNVariables()+fStore->GetNTargets()+ivar, value );
+         return;
+      }
+      LeaveStore();
+   }
    if (fSpectators.size() <= ivar) fSpectators.resize( ivar+1 );
    fSpectators.at(ivar) = value;
 }
@@ -302,14 +492,14 @@ void TMVA::Event::SetSpectator( UInt_t ivar, Float_t value )
 std::ostream& TMVA::operator << ( std::ostream& os, const TMVA::Event& event )
 { 
    // Outputs the data of an event
-   os << "Variables [" << event.fValues.size() << "]:";
-   for (UInt_t ivar=0; ivar<event.fValues.size(); ++ivar)
+   os << "Variables [" << event.GetNVariables() << "]:";
+   for (UInt_t ivar=0; ivar<event.GetNVariables(); ++ivar)
       os << " " << std::setw(10) << event.GetValue(ivar);
-   os << ", targets [" << event.fTargets.size() << "]:";
-   for (UInt_t ivar=0; ivar<event.fTargets.size(); ++ivar)
+   os << ", targets [" << event.GetNTargets() << "]:";
+   for (UInt_t ivar=0; ivar<event.GetNTargets(); ++ivar)
       os << " " << std::setw(10) << event.GetTarget(ivar);
-   os << ", spectators ["<< event.fSpectators.size() << "]:";
-   for (UInt_t ivar=0; ivar<event.fSpectators.size(); ++ivar)
+   os << ", spectators ["<< event.GetNSpectators() << "]:";
+   for (UInt_t ivar=0; ivar<event.GetNSpectators(); ++ivar)
       os << " " << std::setw(10) << event.GetSpectator(ivar);
    os << ", weight: " << event.GetWeight();
    os << ", class: " << event.GetClass();
@@ -0,0 +1,129 @@
+// @(#)root/tmva $Id$
+// Author: Andreas Hoecker, Peter Speckmayer, Joerg Stelzer, Helge Voss
+
+/**********************************************************************************
+ * Project: TMVA - a Root-integrated toolkit for multivariate data analysis       *
+ * Package: TMVA                                                                  *
+ * Class  : EventStore                                                            *
+ * Web    : http://tmva.sourceforge.net                                           *
+ *                                                                                *
+ * Description:                                                                   *
+ *      Implementation (see header for description)                               *
+ *                                                                                *
+ * Authors (alphabetical):                                                        *
+ *      Andreas Hoecker <Andreas.Hocker@cern.ch> - CERN, Switzerland              *
+ *      Peter Speckmayer <Peter.Speckmayer@cern.ch>  - CERN, Switzerland          *
+ *      Joerg Stelzer   <Joerg.Stelzer@cern.ch>  - CERN, Switzerland              *
+ *      Helge Voss      <Helge.Voss@cern.ch>     - MPI-K Heidelberg, Germany      *
+ *                                                                                *
+ * Copyright (c) 2005-2011:                                                       *
+ *      CERN, Switzerland                                                         *
+ *      MPI-K Heidelberg, Germany                                                 *
+ *                                                                                *
+ * Redistribution and use in source and binary forms, with or without             *
+ * modification, are permitted according to the terms listed in LICENSE           *
+ * (http://tmva.sourceforge.net/LICENSE)                                          *
+ **********************************************************************************/
+
+#include "TMath.h"
+
+#include "TMVA/EventStore.h"
+
+//_______________________________________________________________________
+TMVA::EventStore::EventStore( UInt_t nevents, UInt_t nvar, UInt_t ntgt, UInt_t nspec, Bool_t halfPrecision )
+   : fNEvents( nevents ),
+     fNVariables( nvar ),
+     fNTargets( ntgt ),
+     fNSpectators( nspec ),
+     fValues( 0 ),
+     fHalfValues( 0 ),
+     fNOverflows( 0 ),
+     fNViews( 0 )
+{
+   // allocate the (zero initialised) values of all events in a single block
+   ULong64_t n = ULong64_t(nevents)*(nvar + ntgt + nspec);
+   if (halfPrecision) fHalfValues = new UShort_t[n]();
+   else               fValues     = new Float_t[n]();
+}
+
+//_______________________________________________________________________
+TMVA::EventStore::~EventStore()
+{
+   // destructor, called when the last event viewing the store is deleted
+   delete [] fValues;
+   delete [] fHalfValues;
+}
+
+//_______________________________________________________________________
+void TMVA::EventStore::SetValue( UInt_t ievt, UInt_t icol, Float_t value )
+{
+   // set the value of column icol of event ievt
+   if (fValues) {
+      fValues[Index( ievt, icol )] = value;
+      return;
+   }
+   UShort_t half = FloatToHalf( value );
+   if ((half & 0x7fff) == 0x7c00 && TMath::Finite( value )) ++fNOverflows;
+   fHalfValues[Index( ievt, icol )] = half;
+}
+
+//_______________________________________________________________________
+ULong64_t TMVA::EventStore::GetNBytes() const
+{
+   // memory used by the stored values
+   ULong64_t n = ULong64_t(fNEvents)*(fNVariables + fNTargets + fNSpectators);
+   return n*(fValues ? sizeof(Float_t) : sizeof(UShort_t));
+}
+
+//_______________________________________________________________________
+UShort_t TMVA::EventStore::FloatToHalf( Float_t value )
+{
+   // convert value to an IEEE 754 half precision number, rounding to the
+   // nearest even number; values beyond the half precision range become +-inf
+   union { Float_t f; UInt_t u; } bits;
+   bits.f = value;
+   UInt_t sign = (bits.u >> 16) & 0x8000;
+   UInt_t abs  = bits.u & 0x7fffffff;
+
+   if (abs >= 0x7f800000)                          // inf or nan
+      return sign | 0x7c00 | (abs > 0x7f800000 ? 0x200 : 0);
+   if (abs >= 0x477ff000) return sign | 0x7c00;    // rounds beyond 65504
+   if (abs < 0x38800000) {                         // below 2^-14: subnormal half
+      if (abs < 0x33000000) return sign;           // below 2^-25: zero
+      UInt_t mant  = (abs & 0x7fffff) | 0x800000;
+      UInt_t shift = 126 - (abs >> 23);
+      UInt_t half  = mant >> shift;
+      UInt_t rest  = mant & ((1u << shift) - 1);
+      UInt_t tie   = 1u << (shift - 1);
+      if (rest > tie || (rest == tie && (half & 1))) ++half;
+      return sign | half;
+   }
+   UInt_t half = (abs >> 13) - ((127 - 15) << 10); // rebias the exponent
+   UInt_t rest = abs & 0x1fff;
+   if (rest > 0x1000 || (rest == 0x1000 && (half & 1))) ++half;
+   return sign | half;
+}
+
+//_______________________________________________________________________
+Float_t TMVA::EventStore::HalfToFloat( UShort_t value )
+{
+   // convert an IEEE 754 half precision number to single precision (exact)
+   union { Float_t f; UInt_t u; } bits;
+   UInt_t sign = UInt_t(value & 0x8000) << 16;
+   UInt_t exp  = (value >> 10) & 0x1f;
+   UInt_t mant = value & 0x3ff;
+
+   if (exp == 0x1f) {                              // inf or nan
+      bits.u = sign | 0x7f800000 | (mant << 13);
+   }
+   else if (exp == 0) {                            // zero or subnormal
+      if (mant == 0) bits.u = sign;
+      else {
+         exp = 127 - 14;
+         while ((mant & 0x400) == 0) { mant <<= 1; --exp; }
+         bits.u = sign | (exp << 23) | ((mant & 0x3ff) << 13);
+      }
+   }
+   else bits.u = sign | ((exp + 127 - 15) << 23) | (mant << 13);
+   return bits.f;
+}
@@ -37,6 +37,13 @@
 // phases
 //_______________________________________________________________________
 
+#include <cstdio>
+#include <fstream>
+#include <string>
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
 
 #include "TROOT.h"
 #include "TFile.h"
@@ -52,6 +59,9 @@
 #include "TPrincipal.h"
 #include "TMath.h"
 #include "TObjString.h"
+#include "TKey.h"
+#include "TClass.h"
+#include "TSystem.h"
 
 #include "TMVA/Factory.h"
 #include "TMVA/ClassifierFactory.h"
@@ -86,6 +96,42 @@ ClassImp(TMVA::Factory)
 #define RECREATE_METHODS kTRUE
 #define READXML          kTRUE
 
+namespace {
+
+   //_______________________________________________________________________
+   void FactoryCopyDirectory( TDirectory* source, TDirectory* target )
+   {
+      // copy the latest cycle of all objects of the source directory and its
+      // subdirectories into the target directory, overwriting objects with
+      // the same name; used to merge the output of methods trained in
+      // separate processes into the target file
+
+      TIter next( source->GetListOfKeys() );
+      TKey* key;
+      while ((key = (TKey*)next())) {
+         if (source->GetKey( key->GetName() ) != key) continue; // older cycle
+         TClass* cl = TClass::GetClass( key->GetClassName() );
+         if (cl != 0 && cl->InheritsFrom( TDirectory::Class() )) {
+            TDirectory* dir = target->GetDirectory( key->GetName() );
+            if (dir == 0) dir = target->mkdir( key->GetName(), key->GetTitle() );
+            FactoryCopyDirectory( source->GetDirectory( key->GetName() ), dir );
+            continue;
+         }
+         TObject* obj = key->ReadObj();
+         if (obj == 0) continue;
+         if (obj->InheritsFrom( TTree::Class() )) {
+            // the baskets of a tree stay in the source file, hence copy it
+            target->cd();
+            TTree* tree = ((TTree*)obj)->CloneTree( -1, "fast" );
+            tree->Write( key->GetName(), TObject::kOverwrite );
+            delete tree;
+         }
+         else target->WriteTObject( obj, key->GetName(), "Overwrite" );
+         delete obj;
+      }
+   }
+}
+
 //_______________________________________________________________________
 TMVA::Factory::Factory( TString jobName, TFile* theTargetFile, TString theOption )
 : Configurable          ( theOption ),
@@ -124,12 +170,15 @@ TMVA::Factory::Factory( TString jobName, TFile* theTargetFile, TString theOption
    Bool_t silent          = kFALSE;
    Bool_t color           = !gROOT->IsBatch();
    Bool_t drawProgressBar = kTRUE;
+   Int_t  nJobs           = 1;
    DeclareOptionRef( fVerbose, "V", "Verbose flag" );
    DeclareOptionRef( color,    "Color", "Flag for coloured screen output (default: True, if in batch mode: False)" );
    DeclareOptionRef( fTransformations, "Transformations", "List of transformations to test; formatting example: \"Transformations=I;D;P;U;G,D\", for identity, decorrelation, PCA, Uniform and Gaussianisation followed by decorrelation transformations" );
    DeclareOptionRef( silent,   "Silent", "Batch mode: boolean silent flag inhibiting any output from TMVA after the creation of the factory class object (default: False)" );
    DeclareOptionRef( drawProgressBar,
                      "DrawProgressBar", "Draw progress bar to display training, testing and evaluation schedule (default: True)" );
+   DeclareOptionRef( nJobs,
+                     "NJobs", "Number of methods trained (and parameter settings evaluated in the optimisation) in parallel processes (default: 1)" );
 
    TString analysisType("Auto");
    DeclareOptionRef( analysisType,
@@ -149,6 +198,12 @@ TMVA::Factory::Factory( TString jobName, TFile* theTargetFile, TString theOption
    gConfig().SetSilent( silent );
    gConfig().SetDrawProgressBar( drawProgressBar );
 
+   if (nJobs < 1) {
+      Log() << kWARNING << "NJobs = " << nJobs << " is not allowed --> set to 1" << Endl;
+      nJobs = 1;
+   }
+   gConfig().SetNJobs( nJobs );
+
    analysisType.ToLower();
    if     ( analysisType == "classification" ) fAnalysisType = Types::kClassification;
    else if( analysisType == "regression" )     fAnalysisType = Types::kRegression;
@@ -936,11 +991,17 @@ void TMVA::Factory::TrainAllMethods()
 
    MVector::iterator itrMethod;
 
+   // train independent methods in parallel processes if requested (they
+   // are recreated from their weight files below)
+   std::vector<Bool_t> trainedInJob( fMethods.size(), kFALSE );
+   if (gConfig().NJobs() > 1 && RECREATE_METHODS) TrainMethodsInJobs( trainedInJob );
+
    // iterate over methods and train
    for( itrMethod = fMethods.begin(); itrMethod != fMethods.end(); ++itrMethod ) {
       Event::fIsTraining = kTRUE;
       MethodBase* mva = dynamic_cast<MethodBase*>(*itrMethod);
       if(mva==0) continue;
+      if (trainedInJob[itrMethod-fMethods.begin()]) continue;
 
       if (mva->Data()->GetNTrainingEvents() < MinNoTrainingEvents) {
          Log() << kWARNING << "Method " << mva->GetMethodName()
@@ -964,6 +1025,7 @@ void TMVA::Factory::TrainAllMethods()
       Log() << kINFO << "Ranking input variables (method specific)..." << Endl;
       for (itrMethod = fMethods.begin(); itrMethod != fMethods.end(); itrMethod++) {
          MethodBase* mva = dynamic_cast<MethodBase*>(*itrMethod);
+         if (trainedInJob[itrMethod-fMethods.begin()]) continue; // printed by the training process
          if (mva && mva->Data()->GetNTrainingEvents() >= MinNoTrainingEvents) {
 
             // create and print ranking
@@ -1017,12 +1079,143 @@ void TMVA::Factory::TrainAllMethods()
          m->ReadStateFromFile();
          m->SetTestvarName(testvarName);
 
+         // the output for the training sample of a method trained in a
+         // separate process is created with the method read back from the
+         // weight file
+         if (trainedInJob[i]) {
+            Event::fIsTraining = kTRUE;
+            m->AddOutput( Types::kTraining, m->GetAnalysisType() );
+         }
+
          // replace trained method by newly created one (from weight file) in methods vector
          fMethods[i] = m;
       }
    }
 }
 
+//_______________________________________________________________________
+void TMVA::Factory::TrainMethodsInJobs( std::vector<Bool_t>& trainedInJob )
+{
+   // trains the booked methods in up to NJobs forked processes at a time.
+   // Each process trains one method and writes its weight file; the
+   // histograms of the method go to a temporary ROOT file with the layout
+   // of the target file, which is merged into the target file once the
+   // process has finished. The screen output of each process is collected
+   // in a log file and printed in the order of booking, so that the output
+   // of different methods is not mixed. Methods that depend on the data
+   // set manager of the factory (Category, Boost) and methods whose
+   // training process failed are left for the sequential training.
+
+#ifndef _WIN32
+   std::vector<UInt_t> jobs;
+   for (UInt_t i=0; i<fMethods.size(); i++) {
+      MethodBase* mva = dynamic_cast<MethodBase*>(fMethods[i]);
+      if (mva==0) continue;
+      if (mva->GetMethodType() == Types::kCategory || mva->GetMethodType() == Types::kBoost) continue;
+      if (mva->Data()->GetNTrainingEvents() < MinNoTrainingEvents) continue;
+      jobs.push_back(i);
+   }
+   if (jobs.size() < 2) return;
+
+   const UInt_t nJobs = gConfig().NJobs();
+   Log() << kINFO << "Train " << jobs.size() << " methods in up to " << nJobs << " parallel processes" << Endl;
+
+   std::vector<TString> rootFile( jobs.size() ), logFile( jobs.size() );
+   std::vector<pid_t>   pid( jobs.size(), -1 );
+   std::vector<Bool_t>  success( jobs.size(), kFALSE );
+   UInt_t nextToWait = 0;
+
+   for (UInt_t ijob=0; ijob<=jobs.size(); ijob++) {
+
+      // wait for the oldest running process if all slots are taken (and
+      // for all of them at the end)
+      while (nextToWait < ijob && (ijob == jobs.size() || ijob-nextToWait >= nJobs)) {
+         if (pid[nextToWait] > 0) {
+            int status = 0;
+            if (waitpid( pid[nextToWait], &status, 0 ) == pid[nextToWait])
+               success[nextToWait] = (WIFEXITED(status) && WEXITSTATUS(status) == 0);
+         }
+         nextToWait++;
+      }
+      if (ijob == jobs.size()) break;
+
+      MethodBase* mva = dynamic_cast<MethodBase*>(fMethods[jobs[ijob]]);
+      gSystem->MakeDirectory( mva->GetWeightFileDir() );
+      rootFile[ijob] = mva->GetWeightFileName() + ".train.root";
+      logFile[ijob]  = mva->GetWeightFileName() + ".train.log";
+
+      // flush the output buffers, otherwise they are written twice
+      std::cout << std::flush;
+      fflush( 0 );
+
+      pid[ijob] = fork();
+      if (pid[ijob] == 0) {
+         // the training process: nothing must be written to the target
+         // file of the parent process, hence redirect the directories of
+         // the method, make sure the target file is not closed by the exit
+         // handlers of ROOT (e.g. after a fatal error) and leave via _exit
+         gROOT->GetListOfFiles()->Remove( fgTargetFile );
+         gSystem->RedirectOutput( logFile[ijob], "w" );
+         gConfig().SetDrawProgressBar( kFALSE );
+         Int_t status = 1;
+         TFile* file = TFile::Open( rootFile[ijob], "RECREATE" );
+         if (file != 0 && !file->IsZombie()) {
+            fgTargetFile = file;
+            mva->SetMethodDir( 0 );
+            Event::fIsTraining = kTRUE;
+            Log() << kINFO << "Train method: " << mva->GetMethodName() << " for "
+                  << (fAnalysisType == Types::kRegression ? "Regression" :
+                      (fAnalysisType == Types::kMulticlass ? "Multiclass classification" : "Classification")) << Endl;
+            mva->TrainMethod();
+            Log() << kINFO << "Training finished" << Endl;
+            if (fAnalysisType != Types::kRegression) {
+               const Ranking* ranking = mva->CreateRanking();
+               if (ranking != 0) ranking->Print();
+               else Log() << kINFO << "No variable ranking supplied by classifier: " << mva->GetMethodName() << Endl;
+            }
+            file->Write();
+            file->Close();
+            status = 0;
+         }
+         std::cout << std::flush;
+         fflush( 0 );
+         _exit( status );
+      }
+      if (pid[ijob] < 0)
+         Log() << kWARNING << "Could not start the training process for method " << mva->GetMethodName() << Endl;
+   }
+
+   // collect the output of the training processes in the order of booking
+   for (UInt_t ijob=0; ijob<jobs.size(); ijob++) {
+      MethodBase* mva = dynamic_cast<MethodBase*>(fMethods[jobs[ijob]]);
+
+      std::ifstream log( logFile[ijob].Data() );
+      std::string line;
+      while (std::getline( log, line )) std::cout << line << std::endl;
+      log.close();
+
+      if (success[ijob]) {
+         TFile* file = TFile::Open( rootFile[ijob], "READ" );
+         if (file != 0 && !file->IsZombie()) {
+            FactoryCopyDirectory( file, RootBaseDir() );
+            trainedInJob[jobs[ijob]] = kTRUE;
+         }
+         delete file;
+      }
+      if (!trainedInJob[jobs[ijob]])
+         Log() << kWARNING << "Training process of method " << mva->GetMethodName()
+               << " failed --> train it sequentially" << Endl;
+
+      gSystem->Unlink( rootFile[ijob] );
+      gSystem->Unlink( logFile[ijob] );
+   }
+   RootBaseDir()->cd();
+#else
+   Log() << kWARNING << "Training in parallel processes is not available on this platform"
+         << " --> train methods sequentially" << Endl;
+#endif
+}
+
 //_______________________________________________________________________
 void TMVA::Factory::TestAllMethods()
 {
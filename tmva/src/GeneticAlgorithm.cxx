@@ -150,10 +150,18 @@ Double_t TMVA::GeneticAlgorithm::CalculateFitness()
 
 #else 
 
+   // the estimators of the whole population are requested at once, such
+   // that the fitter target may evaluate the individuals in parallel
+   std::vector< std::vector<Double_t>* > factors( fPopulation.GetPopulationSize() );
+   for ( int index = 0; index < fPopulation.GetPopulationSize(); ++index )
+      factors[index] = &fPopulation.GetGenes(index)->GetFactors();
+
+   std::vector<Double_t> estimators;
+   fFitterTarget.EstimatorFunctions( factors, estimators );
+
    for ( int index = 0; index < fPopulation.GetPopulationSize(); ++index ) {
       GeneticGenes* genes = fPopulation.GetGenes(index);
-      Double_t fitness = NewFitness( genes->GetFitness(),
-                                     fFitterTarget.EstimatorFunction(genes->GetFactors()) );
+      Double_t fitness = NewFitness( genes->GetFitness(), estimators[index] );
       genes->SetFitness( fitness );
       
       if ( fBestFitness  > fitness )
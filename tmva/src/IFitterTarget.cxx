@@ -42,3 +42,15 @@ TMVA::IFitterTarget::IFitterTarget()
    // constructor
 }            
 
+//_______________________________________________________________________
+void TMVA::IFitterTarget::EstimatorFunctions( const std::vector< std::vector<Double_t>* >& parameters,
+                                              std::vector<Double_t>& estimators )
+{
+   // compute the estimators of all parameter sets, one after the other.
+   // Targets that can evaluate several parameter sets in parallel override
+   // this function; the estimators must be the same as those obtained by
+   // calling EstimatorFunction in the order of the parameter sets
+   estimators.resize( parameters.size() );
+   for (UInt_t i=0; i<parameters.size(); i++) estimators[i] = EstimatorFunction( *parameters[i] );
+}
+
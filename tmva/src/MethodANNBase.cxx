@@ -57,6 +57,7 @@
 #include "TMVA/Types.h"
 #include "TMVA/Tools.h"
 #include "TMVA/TNeuronInputChooser.h"
+#include "TMVA/TNeuronInputSum.h"
 #include "TMVA/Ranking.h"
 
 using std::vector;
@@ -592,6 +593,68 @@ Double_t TMVA::MethodANNBase::GetMvaValue( Double_t* err, Double_t* errUpper )
    return neuron->GetActivationValue();
 }
 
+//_______________________________________________________________________
+void TMVA::MethodANNBase::GetMvaValues( const Float_t* input, UInt_t nEvents, Double_t* mvaValues )
+{
+   // get the mva values of a set of events stored column-wise: the network
+   // is calculated layer by layer for all events at once, using the synapse
+   // weights but not the state of the neurons (identical to GetMvaValue)
+
+   std::vector<Float_t> values;
+   if (nEvents == 0 || dynamic_cast<TNeuronInputSum*>(fInputCalculator) == 0 ||
+       !GetTransformedColumns( input, nEvents, values )) {
+      MethodBase::GetMvaValues( input, nEvents, mvaValues );
+      return;
+   }
+
+   // activations of the neurons of the previous and current layer, neuron by neuron
+   TObjArray* layer = (TObjArray*)fNetwork->At(0);
+   Int_t numNeurons = layer->GetEntriesFast();
+   std::vector<Double_t> prevActivation( numNeurons*nEvents );
+   for (Int_t j = 0; j < numNeurons; j++) {
+      Double_t* act = &prevActivation[j*nEvents];
+      if (j < (Int_t)GetNvar()) {
+         for (UInt_t ievt = 0; ievt < nEvents; ievt++) act[ievt] = values[j*nEvents+ievt];
+      }
+      else { // bias neuron
+         TNeuron* neuron = (TNeuron*)layer->At(j);
+         for (UInt_t ievt = 0; ievt < nEvents; ievt++) act[ievt] = neuron->GetValue();
+      }
+   }
+
+   Int_t numLayers = fNetwork->GetEntriesFast();
+   std::vector<Double_t> activation;
+   std::vector<Double_t> sum( nEvents );
+   for (Int_t i = 1; i < numLayers; i++) {
+      layer = (TObjArray*)fNetwork->At(i);
+      numNeurons = layer->GetEntriesFast();
+      TActivation* activationEqn = (i == numLayers-1) ? fOutput : fActivation;
+      activation.resize( numNeurons*nEvents );
+
+      for (Int_t j = 0; j < numNeurons; j++) {
+         TNeuron* neuron = (TNeuron*)layer->At(j);
+         Double_t* act = &activation[j*nEvents];
+         Int_t npl = neuron->NumPreLinks();
+         if (npl == 0) { // bias neuron
+            for (UInt_t ievt = 0; ievt < nEvents; ievt++) act[ievt] = neuron->GetValue();
+            continue;
+         }
+         // the synapses connect to all neurons of the previous layer in order
+         sum.assign( nEvents, 0 );
+         for (Int_t k = 0; k < npl; k++) {
+            const Double_t  weight  = neuron->PreLinkAt(k)->GetWeight();
+            const Double_t* prevAct = &prevActivation[k*nEvents];
+            for (UInt_t ievt = 0; ievt < nEvents; ievt++) sum[ievt] += weight*prevAct[ievt];
+         }
+         for (UInt_t ievt = 0; ievt < nEvents; ievt++) act[ievt] = activationEqn->Eval( sum[ievt] );
+      }
+      prevActivation.swap( activation );
+   }
+
+   // the first neuron of the output layer
+   for (UInt_t ievt = 0; ievt < nEvents; ievt++) mvaValues[ievt] = prevActivation[ievt];
+}
+
 //_______________________________________________________________________
 const std::vector<Float_t> &TMVA::MethodANNBase::GetRegressionValues() 
 {
@@ -133,6 +133,8 @@
 #include "TMVA/LogInterval.h"
 #include "TMVA/PDF.h"
 #include "TMVA/BDTEventWrapper.h"
+#include "TMVA/DecisionTreeBinning.h"
+#include "TMVA/DecisionTreeForest.h"
 
 #include "TMatrixTSym.h"
 
@@ -189,6 +191,10 @@ TMVA::MethodBDT::MethodBDT( const TString& jobName,
    , fPairNegWeightsInNode(kFALSE)
    , fTrainWithNegWeights(kFALSE)
    , fDoBoostMonitor(kFALSE)
+   , fNThreads(1)
+   , fUsePreBinning(kFALSE)
+   , fBinning(NULL)
+   , fFlatForest(NULL)
    , fITree(0)
    , fBoostWeight(0)
    , fErrorFraction(0)
@@ -243,6 +249,10 @@ TMVA::MethodBDT::MethodBDT( DataSetInfo& theData,
    , fPairNegWeightsInNode(kFALSE)
    , fTrainWithNegWeights(kFALSE)
    , fDoBoostMonitor(kFALSE)
+   , fNThreads(1)
+   , fUsePreBinning(kFALSE)
+   , fBinning(NULL)
+   , fFlatForest(NULL)
    , fITree(0)
    , fBoostWeight(0)
    , fErrorFraction(0)
@@ -295,6 +305,10 @@ void TMVA::MethodBDT::DeclareOptions()
    // nCuts:           the number of steps in the optimisation of the cut for a node (if < 0, then
    //                  step size is determined by the events)
    // UseFisherCuts:   use multivariate splits using the Fisher criterion
+   // NThreads:        number of threads used to fill the cut scan histograms of the variables in the node splitting
+   // UsePreBinning:   bin the input variables once into nCuts+1 equidistant bins over the range of the training
+   //                  sample and reuse the bin indices in all nodes and trees (the candidate cuts of a node are
+   //                  then the bin boundaries inside its range, rather than a new grid for each node)
    // UseYesNoLeaf     decide if the classification is done simply by the node type, or the S/B
    //                  (from the training) in the leaf node
    // NodePurityLimit  the minimum purity to classify a node as a signal node (used in pruning and boosting to determine
@@ -381,6 +395,8 @@ void TMVA::MethodBDT::DeclareOptions()
    DeclareOptionRef(fUseFisherCuts=kFALSE, "UseFisherCuts", "Use multivariate splits using the Fisher criterion");
    DeclareOptionRef(fMinLinCorrForFisher=.8,"MinLinCorrForFisher", "The minimum linear correlation between two variables demanded for use in Fisher criterion in node splitting");
    DeclareOptionRef(fUseExclusiveVars=kFALSE,"UseExclusiveVars","Variables already used in fisher criterion are not anymore analysed individually for node splitting");
+   DeclareOptionRef(fNThreads=1, "NThreads", "Number of threads used to fill the cut scan histograms of the variables in the node splitting");
+   DeclareOptionRef(fUsePreBinning=kFALSE, "UsePreBinning", "Bin the input variables once with nCuts+1 equidistant bins over the training sample and reuse the bin indices for all nodes and trees");
 
    DeclareOptionRef(fPruneStrength, "PruneStrength", "Pruning strength");
    DeclareOptionRef(fPruneMethodS, "PruneMethod", "Method used for pruning (removal) of statistically insignificant branches");
@@ -465,6 +481,11 @@ void TMVA::MethodBDT::ProcessOptions()
    }
 
 
+   if (fNThreads < 1) {
+      Log() << kWARNING << "NThreads = " << fNThreads << " is not a valid number of threads --> set to 1" << Endl;
+      fNThreads = 1;
+   }
+
    fAdaBoostR2Loss.ToLower();
    
    if (fBoostType=="Grad") {
@@ -624,6 +645,7 @@ void TMVA::MethodBDT::Reset( void )
    // remove all the trees 
    for (UInt_t i=0; i<fForest.size();           i++) delete fForest[i];
    fForest.clear();
+   delete fFlatForest; fFlatForest = NULL;
 
    fBoostWeights.clear();
    if (fMonitorNtuple) fMonitorNtuple->Delete(); fMonitorNtuple=NULL;
@@ -644,6 +666,8 @@ TMVA::MethodBDT::~MethodBDT( void )
    //   for (UInt_t i=0; i<fEventSample.size();      i++) delete fEventSample[i];
    //   for (UInt_t i=0; i<fValidationSample.size(); i++) delete fValidationSample[i];
    for (UInt_t i=0; i<fForest.size();           i++) delete fForest[i];
+   delete fBinning;
+   delete fFlatForest;
 }
 
 //_______________________________________________________________________
@@ -996,6 +1020,20 @@ void TMVA::MethodBDT::Train()
 
    Log() << kINFO << "Training "<< fNTrees << " Decision Trees ... patience please" << Endl;
 
+   // the growing forest is evaluated with the linked trees
+   delete fFlatForest; fFlatForest = NULL;
+
+   // the pre-binned sample is shared by all trees of the forest
+   delete fBinning; fBinning = NULL;
+   if (fUsePreBinning) {
+      if (fNCuts > 0) {
+         fBinning = new DecisionTreeBinning( fEventSample, fNCuts+1 );
+         Log() << kINFO << "Pre-binned the input variables of " << fEventSample.size() 
+               << " training events with " << fNCuts+1 << " bins per variable" << Endl;
+      }
+      else Log() << kWARNING << "UsePreBinning requires nCuts > 0 --> option ignored" << Endl;
+   }
+
    Log() << kDEBUG << "Training with maximal depth = " <<fMaxDepth 
          << ", MinNodeEvents=" << fMinNodeEvents
          << ", NTrees="<<fNTrees
@@ -1103,6 +1141,8 @@ void TMVA::MethodBDT::Train()
                                                  fRandomisedTrees, fUseNvars, fUsePoissonNvars, fNNodesMax, fMaxDepth,
                                                  itree*nClasses+i, fNodePurityLimit, itree*nClasses+i));
             if (fPairNegWeightsInNode) fForest.back()->SetPairNegWeightsInNode();
+            fForest.back()->SetNThreads(fNThreads);
+            fForest.back()->SetBinning(fBinning);
             if (fUseFisherCuts) {
                fForest.back()->SetUseFisherCuts();
                fForest.back()->SetMinLinCorrForFisher(fMinLinCorrForFisher); 
@@ -1125,6 +1165,8 @@ void TMVA::MethodBDT::Train()
                                               fRandomisedTrees, fUseNvars, fUsePoissonNvars, fNNodesMax, fMaxDepth,
                                               itree, fNodePurityLimit, itree));
          if (fPairNegWeightsInNode) fForest.back()->SetPairNegWeightsInNode();
+         fForest.back()->SetNThreads(fNThreads);
+         fForest.back()->SetBinning(fBinning);
          if (fUseFisherCuts) {
             fForest.back()->SetUseFisherCuts();
             fForest.back()->SetMinLinCorrForFisher(fMinLinCorrForFisher); 
@@ -1210,6 +1252,7 @@ void TMVA::MethodBDT::Train()
    }
    TMVA::DecisionTreeNode::fgIsTraining=false;
 
+   CompileForest();
 
    // reset all previously stored/accumulated BOOST weights in the event sample
    //   for (UInt_t iev=0; iev<fEventSample.size(); iev++) fEventSample[iev]->SetBoostWeight(1.);
@@ -1239,6 +1282,11 @@ Double_t TMVA::MethodBDT::GetGradBoostMVA(const TMVA::Event* e, UInt_t nTrees)
 {
    //returns MVA value: -1 for background, 1 for signal
    Double_t sum=0;
+   if (UseFlatForest()) {
+      const Float_t* values = &e->GetValues()[0];
+      for (UInt_t itree=0; itree<nTrees; itree++) sum += fFlatForest->CheckEvent(itree,values,kFALSE);
+      return 2.0/(1.0+exp(-2.0*sum))-1;
+   }
    for (UInt_t itree=0; itree<nTrees; itree++) {
       //loop over all trees in forest
       sum += fForest[itree]->CheckEvent(e,kFALSE);
@@ -1247,6 +1295,24 @@ Double_t TMVA::MethodBDT::GetGradBoostMVA(const TMVA::Event* e, UInt_t nTrees)
    return 2.0/(1.0+exp(-2.0*sum))-1; //MVA output between -1 and 1
 }
 
+//_______________________________________________________________________
+void TMVA::MethodBDT::CompileForest()
+{
+   // compile the trees of the forest into flat node arrays, which are
+   // used instead of the linked tree nodes in the evaluation
+   delete fFlatForest;
+   fFlatForest = new DecisionTreeForest( fForest );
+   Log() << kDEBUG << "Compiled " << fFlatForest->GetNTrees() << " trees with "
+         << fFlatForest->GetNNodes() << " nodes for the evaluation" << Endl;
+}
+
+//_______________________________________________________________________
+Bool_t TMVA::MethodBDT::UseFlatForest() const
+{
+   // the flat forest is only used if it is up to date with the forest
+   return fFlatForest!=0 && fFlatForest->GetNTrees()==fForest.size();
+}
+
 //_______________________________________________________________________
 void TMVA::MethodBDT::UpdateTargets(std::vector<const TMVA::Event*>& eventSample, UInt_t cls)
 {
@@ -2128,6 +2194,8 @@ void TMVA::MethodBDT::ReadWeightsFromXML(void* parent) {
       fBoostWeights.push_back(boostWeight);
       ch = gTools().GetNextChild(ch);
    }
+
+   CompileForest();
 }
 
 //_______________________________________________________________________
@@ -2163,6 +2231,8 @@ void  TMVA::MethodBDT::ReadWeightsFromStream( std::istream& istr )
       fForest.back()->Read(istr, GetTrainingTMVAVersionCode());
       fBoostWeights.push_back(boostWeight);
    }
+
+   CompileForest();
 }
 
 //_______________________________________________________________________
@@ -2184,6 +2254,92 @@ Double_t TMVA::MethodBDT::GetMvaValue( Double_t* err, Double_t* errUpper, UInt_t
    return PrivateGetMvaValue(ev, err, errUpper, useNTrees);
 
 }
+
+//_______________________________________________________________________
+void TMVA::MethodBDT::GetMvaValues( const std::vector<const TMVA::Event*>& events, std::vector<Double_t>& mvaValues )
+{
+   // Return the MVA values of a set of events. The (transformed) input
+   // values of all events are copied into one array, which is passed
+   // through the flat forest tree by tree. The results are identical to
+   // the ones of GetMvaValue.
+
+   if (!UseFlatForest()) {
+      MethodBase::GetMvaValues( events, mvaValues );
+      return;
+   }
+
+   const UInt_t nEvents = events.size();
+   const UInt_t nvar    = GetNvar();
+   mvaValues.assign( nEvents, 0 );
+   if (nEvents == 0) return;
+
+   std::vector<Float_t> values( nEvents*nvar );
+   for (UInt_t ievt=0; ievt<nEvents; ievt++) {
+      const std::vector<Float_t>& evValues = GetEvent( events[ievt] )->GetValues();
+      std::copy( evValues.begin(), evValues.begin()+nvar, values.begin()+ievt*nvar );
+   }
+
+   GetFlatForestMvaValues( &values[0], nEvents, nvar, 1, &mvaValues[0] );
+}
+
+//_______________________________________________________________________
+void TMVA::MethodBDT::GetMvaValues( const Float_t* input, UInt_t nEvents, Double_t* mvaValues )
+{
+   // Return the MVA values of a set of events stored column-wise. The
+   // variable transformations are applied to all events at once, and
+   // the events are passed through the flat forest tree by tree.
+
+   std::vector<Float_t> values;
+   if (nEvents == 0 || !UseFlatForest() || !GetTransformedColumns( input, nEvents, values )) {
+      MethodBase::GetMvaValues( input, nEvents, mvaValues );
+      return;
+   }
+
+   GetFlatForestMvaValues( &values[0], nEvents, 1, nEvents, mvaValues );
+}
+
+//_______________________________________________________________________
+void TMVA::MethodBDT::GetFlatForestMvaValues( const Float_t* values, UInt_t nEvents, UInt_t eventStride, UInt_t varStride,
+                                              Double_t* mvaValues )
+{
+   // MVA values of a set of (transformed) events, variable ivar of event
+   // ievt is values[ievt*eventStride+ivar*varStride]; the responses of
+   // the trees are summed in the same order as in PrivateGetMvaValue
+
+   std::vector<Bool_t> preselected( nEvents, kFALSE );
+   if (fDoPreselection) {
+      for (UInt_t ievt=0; ievt<nEvents; ievt++) {
+         Double_t val = ApplyPreselectionCuts( values+ievt*eventStride, varStride );
+         if (TMath::Abs(val)>0.05) {
+            mvaValues[ievt]    = val;
+            preselected[ievt] = kTRUE;
+         }
+      }
+   }
+
+   const Bool_t grad         = (fBoostType=="Grad");
+   const Bool_t useYesNoLeaf = grad ? kFALSE : fUseYesNoLeaf;
+   std::vector<Double_t> response( nEvents );
+   std::vector<Double_t> myMVA( nEvents, 0 );
+   Double_t norm = 0;
+   for (UInt_t itree=0; itree<fForest.size(); itree++) {
+      fFlatForest->CheckEvents( itree, values, nEvents, eventStride, varStride, useYesNoLeaf, &response[0] );
+      if (!grad && fUseWeightedTrees) {
+         for (UInt_t ievt=0; ievt<nEvents; ievt++) myMVA[ievt] += fBoostWeights[itree] * response[ievt];
+         norm += fBoostWeights[itree];
+      }
+      else {
+         for (UInt_t ievt=0; ievt<nEvents; ievt++) myMVA[ievt] += response[ievt];
+         norm += 1;
+      }
+   }
+
+   for (UInt_t ievt=0; ievt<nEvents; ievt++) {
+      if (preselected[ievt]) continue;
+      if (grad) mvaValues[ievt] = 2.0/(1.0+exp(-2.0*myMVA[ievt]))-1;
+      else      mvaValues[ievt] = ( norm > std::numeric_limits<double>::epsilon() ) ? myMVA[ievt]/norm : 0;
+   }
+}
 //_______________________________________________________________________
 Double_t TMVA::MethodBDT::PrivateGetMvaValue(const TMVA::Event* ev, Double_t* err, Double_t* errUpper, UInt_t useNTrees )
 {
@@ -2204,14 +2360,16 @@ Double_t TMVA::MethodBDT::PrivateGetMvaValue(const TMVA::Event* ev, Double_t* er
    
    Double_t myMVA = 0;
    Double_t norm  = 0;
+   const Float_t* values = UseFlatForest() ? &ev->GetValues()[0] : 0;
    for (UInt_t itree=0; itree<nTrees; itree++) {
       //
+      Double_t response = values ? fFlatForest->CheckEvent(itree,values,fUseYesNoLeaf) : fForest[itree]->CheckEvent(ev,fUseYesNoLeaf);
       if (fUseWeightedTrees) {
-         myMVA += fBoostWeights[itree] * fForest[itree]->CheckEvent(ev,fUseYesNoLeaf);
+         myMVA += fBoostWeights[itree] * response;
          norm  += fBoostWeights[itree];
       }
       else {
-         myMVA += fForest[itree]->CheckEvent(ev,fUseYesNoLeaf);
+         myMVA += response;
          norm  += 1;
       }
    }
@@ -2231,10 +2389,11 @@ const std::vector<Float_t>& TMVA::MethodBDT::GetMulticlassValues()
    std::vector<double> temp;
 
    UInt_t nClasses = DataInfo().GetNClasses();
+   const Float_t* values = UseFlatForest() ? &e->GetValues()[0] : 0;
    for(UInt_t iClass=0; iClass<nClasses; iClass++){
       temp.push_back(0.0);
       for(UInt_t itree = iClass; itree<fForest.size(); itree+=nClasses){
-         temp[iClass] += fForest[itree]->CheckEvent(e,kFALSE);
+         temp[iClass] += values ? fFlatForest->CheckEvent(itree,values,kFALSE) : fForest[itree]->CheckEvent(e,kFALSE);
       }
    }    
 
@@ -2268,6 +2427,7 @@ const std::vector<Float_t> & TMVA::MethodBDT::GetRegressionValues()
 
    Double_t myMVA = 0;
    Double_t norm  = 0;
+   const Float_t* values = UseFlatForest() ? &ev->GetValues()[0] : 0;
    if (fBoostType=="AdaBoostR2") {
       // rather than using the weighted average of the tree respones in the forest
       // H.Decker(1997) proposed to use the "weighted median"
@@ -2284,7 +2444,7 @@ const std::vector<Float_t> & TMVA::MethodBDT::GetRegressionValues()
       Double_t           totalSumOfWeights = 0;
 
       for (UInt_t itree=0; itree<fForest.size(); itree++) {
-         response[itree]    = fForest[itree]->CheckEvent(ev,kFALSE);
+         response[itree]    = values ? fFlatForest->CheckEvent(itree,values,kFALSE) : fForest[itree]->CheckEvent(ev,kFALSE);
          weight[itree]      = fBoostWeights[itree];
          totalSumOfWeights += fBoostWeights[itree];
       }
@@ -2313,7 +2473,7 @@ const std::vector<Float_t> & TMVA::MethodBDT::GetRegressionValues()
    }
    else if(fBoostType=="Grad"){
       for (UInt_t itree=0; itree<fForest.size(); itree++) {
-         myMVA += fForest[itree]->CheckEvent(ev,kFALSE);
+         myMVA += values ? fFlatForest->CheckEvent(itree,values,kFALSE) : fForest[itree]->CheckEvent(ev,kFALSE);
       }
 //      fRegressionReturnVal->push_back( myMVA+fBoostWeights[0]);
       evT->SetTarget(0, myMVA+fBoostWeights[0] );
@@ -2321,12 +2481,13 @@ const std::vector<Float_t> & TMVA::MethodBDT::GetRegressionValues()
    else{
       for (UInt_t itree=0; itree<fForest.size(); itree++) {
          //
+         Double_t response = values ? fFlatForest->CheckEvent(itree,values,kFALSE) : fForest[itree]->CheckEvent(ev,kFALSE);
          if (fUseWeightedTrees) {
-            myMVA += fBoostWeights[itree] * fForest[itree]->CheckEvent(ev,kFALSE);
+            myMVA += fBoostWeights[itree] * response;
             norm  += fBoostWeights[itree];
          }
          else {
-            myMVA += fForest[itree]->CheckEvent(ev,kFALSE);
+            myMVA += response;
             norm  += 1;
          }
       }
@@ -2817,20 +2978,30 @@ Double_t TMVA::MethodBDT::ApplyPreselectionCuts(const Event* ev)
    // aply the  preselection cuts before even bothing about any 
    // Decision Trees  in the GetMVA .. --> -1 for background +1 for Signal 
    
+   return ApplyPreselectionCuts( &ev->GetValues()[0] );
+}
+
+//_______________________________________________________________________
+Double_t TMVA::MethodBDT::ApplyPreselectionCuts(const Float_t* values, UInt_t stride)
+{
+   // the preselection cuts for the input values of one event, variable
+   // ivar is values[ivar*stride]
+   
    Double_t result=0;
 
    for (UInt_t ivar=0; ivar < GetNvar(); ivar++ ) { // loop over all discriminating variables
+      const Float_t val = values[ivar*stride];
       if (fIsLowBkgCut[ivar]){
-         if (ev->GetValue(ivar) < fLowBkgCut[ivar]) result = -1;  // is background
+         if (val < fLowBkgCut[ivar]) result = -1;  // is background
       } 
       if (fIsLowSigCut[ivar]){
-         if (ev->GetValue(ivar) < fLowSigCut[ivar]) result =  1;  // is signal
+         if (val < fLowSigCut[ivar]) result =  1;  // is signal
       } 
       if (fIsHighBkgCut[ivar]){
-         if (ev->GetValue(ivar) > fHighBkgCut[ivar]) result = -1;  // is background
+         if (val > fHighBkgCut[ivar]) result = -1;  // is background
       } 
       if (fIsHighSigCut[ivar]){
-         if (ev->GetValue(ivar) > fHighSigCut[ivar]) result =  1;  // is signal
+         if (val > fHighSigCut[ivar]) result =  1;  // is signal
       }
    }
    
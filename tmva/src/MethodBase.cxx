@@ -808,6 +808,46 @@ Double_t TMVA::MethodBase::GetMvaValue( const Event* const ev, Double_t* err, Do
    return val;
 }
 
+//_______________________________________________________________________
+void TMVA::MethodBase::GetMvaValues( const std::vector<const Event*>& events, std::vector<Double_t>& mvaValues )
+{
+   // MVA values of a set of events, methods which can evaluate many events
+   // faster at once than one by one override this
+   mvaValues.resize( events.size() );
+   for (UInt_t ievt=0; ievt<events.size(); ievt++) mvaValues[ievt] = GetMvaValue( events[ievt] );
+}
+
+//_______________________________________________________________________
+void TMVA::MethodBase::GetMvaValues( const Float_t* values, UInt_t nEvents, Double_t* mvaValues )
+{
+   // MVA values of a set of events stored column-wise, the default
+   // evaluates them one by one through the event buffer of the method,
+   // so it must not be called by several threads at once
+   std::vector<Float_t> row( GetNvar() );
+   Event ev( row, 0 );
+   for (UInt_t ievt=0; ievt<nEvents; ievt++) {
+      for (UInt_t ivar=0; ivar<GetNvar(); ivar++) ev.SetVal( ivar, values[ivar*nEvents+ievt] );
+      mvaValues[ievt] = GetMvaValue( &ev );
+   }
+}
+
+//_______________________________________________________________________
+Bool_t TMVA::MethodBase::GetTransformedColumns( const Float_t* input, UInt_t nEvents, std::vector<Float_t>& values ) const
+{
+   // transformed copy of the input variables of events stored column-wise
+   values.assign( input, input+GetNvar()*nEvents );
+   return GetTransformationHandler().TransformColumns( &values[0], nEvents );
+}
+
+//_______________________________________________________________________
+Bool_t TMVA::MethodBase::GetTransformedColumns( const Float_t* input, UInt_t nEvents, std::vector<Float_t>& values, Int_t cls ) const
+{
+   // transformed copy of the input variables of events stored column-wise,
+   // using the transformations for class cls
+   values.assign( input, input+GetNvar()*nEvents );
+   return GetTransformationHandler().TransformColumns( &values[0], nEvents, cls );
+}
+
 Bool_t TMVA::MethodBase::IsSignalLike() { 
    return GetMvaValue()*GetSignalReferenceCutOrientation() > GetSignalReferenceCut()*GetSignalReferenceCutOrientation() ? kTRUE : kFALSE; 
 }
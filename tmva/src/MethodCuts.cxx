@@ -89,6 +89,11 @@ End_Html */
 
 #include <iostream>
 #include <cstdlib>
+#include <algorithm>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
 
 #include "Riostream.h"
 #include "TH1F.h"
@@ -120,6 +125,62 @@ REGISTER_METHOD(Cuts)
 
 ClassImp(TMVA::MethodCuts)
 
+namespace {
+
+   //_______________________________________________________________________
+   Double_t SumOfWeightsInCuts( const std::vector<Float_t>& values, const std::vector<Float_t>& weights,
+                                UInt_t nvar, const Double_t* cutMin, const Double_t* cutMax )
+   {
+      // sum of the weights of the events inside the cuts, with the same condition
+      // (cutMin < x <= cutMax) as BinarySearchTree::SearchVolume. The events are
+      // sorted by the first variable, so the events passing its cut are found by
+      // binary search and only these are tested further
+      const Long64_t nevents = weights.size();
+      Long64_t first = 0, last = nevents;
+      while (first < last) { // first event with x[0] > cutMin[0]
+         Long64_t mid = (first + last)/2;
+         if (values[mid*nvar] > cutMin[0]) last = mid;
+         else                              first = mid + 1;
+      }
+
+      Double_t sum = 0;
+      for (Long64_t iev=first; iev<nevents; iev++) {
+         const Float_t* x = &values[iev*nvar];
+         if (x[0] > cutMax[0]) break;
+         UInt_t ivar = 1;
+         while (ivar < nvar && cutMin[ivar] < x[ivar] && cutMax[ivar] >= x[ivar]) ivar++;
+         if (ivar == nvar) sum += weights[iev];
+      }
+      return sum;
+   }
+
+   // parameter sets of one thread in TMVA::MethodCuts::EstimatorFunctions
+   struct CutsSelectionTask {
+      const std::vector<Float_t>* valuesS;
+      const std::vector<Float_t>* weightsS;
+      const std::vector<Float_t>* valuesB;
+      const std::vector<Float_t>* weightsB;
+      UInt_t          nvar;
+      UInt_t          nSets;
+      const Double_t* cutMin;  // [nSets*nvar]
+      const Double_t* cutMax;  // [nSets*nvar]
+      Double_t*       nSelS;   // [nSets]
+      Double_t*       nSelB;   // [nSets]
+   };
+
+   //_______________________________________________________________________
+   void* CutsSelectionWorker( void* arg )
+   {
+      // sum the selected signal and background weights of the cuts of one task
+      CutsSelectionTask* t = static_cast<CutsSelectionTask*>(arg);
+      for (UInt_t i=0; i<t->nSets; i++) {
+         t->nSelS[i] = SumOfWeightsInCuts( *t->valuesS, *t->weightsS, t->nvar, t->cutMin+i*t->nvar, t->cutMax+i*t->nvar );
+         t->nSelB[i] = SumOfWeightsInCuts( *t->valuesB, *t->weightsB, t->nvar, t->cutMin+i*t->nvar, t->cutMax+i*t->nvar );
+      }
+      return 0;
+   }
+}
+
 const Double_t TMVA::MethodCuts::fgMaxAbsCutVal = 1.0e30;
 
 //_______________________________________________________________________
@@ -158,7 +219,8 @@ TMVA::MethodCuts::MethodCuts( const TString& jobName,
    fVarHistB_smooth( 0 ),
    fVarPdfS    ( 0 ),
    fVarPdfB    ( 0 ),
-   fNegEffWarning( kFALSE )
+   fNegEffWarning( kFALSE ),
+   fNThreads   ( 1 )
 { 
    // standard constructor
 }
@@ -197,7 +259,8 @@ TMVA::MethodCuts::MethodCuts( DataSetInfo& theData,
    fVarHistB_smooth( 0 ),
    fVarPdfS    ( 0 ),
    fVarPdfB    ( 0 ),
-   fNegEffWarning( kFALSE )
+   fNegEffWarning( kFALSE ),
+   fNThreads   ( 1 )
 {
    // construction from weight file
 }
@@ -345,6 +408,8 @@ void TMVA::MethodCuts::DeclareOptions()
    AddPreDefVal(TString("FMax"));
    AddPreDefVal(TString("FMin"));
    AddPreDefVal(TString("FSmart"));
+
+   DeclareOptionRef(fNThreads = 1, "NThreads", "Number of threads for the efficiencies of the GA population (EffSel only)");
 }
 
 //_______________________________________________________________________
@@ -362,6 +427,11 @@ void TMVA::MethodCuts::ProcessOptions()
       SetNormalised( kFALSE );
    }
 
+   if (fNThreads < 1) {
+      fNThreads = 1;
+      Log() << kWARNING << "NThreads must be a positive integer: set NThreads = " << fNThreads << Endl;
+   }
+
    if (IgnoreEventsWithNegWeightsInTraining()) {
       Log() << kFATAL << "Mechanism to ignore events with negative weights in training not yet available for method: "
             << GetMethodTypeName() 
@@ -583,6 +653,13 @@ void  TMVA::MethodCuts::Train( void )
    fBinaryTreeB = new BinarySearchTree();
    fBinaryTreeB->Fill( GetEventCollection(Types::kTraining), fBackgroundClass );
 
+   // the efficiencies from event selection are computed on presorted copies
+   // of the events, which are faster to scan than the binary trees
+   if (fEffMethod == kUseEventSelection) {
+      FillSortedEvents( fSignalClass,     fSortedEventsS, fSortedWeightsS );
+      FillSortedEvents( fBackgroundClass, fSortedEventsB, fSortedWeightsB );
+   }
+
    for (UInt_t ivar =0; ivar < Data()->GetNVariables(); ivar++) {
       (*fMeanS)[ivar] = fBinaryTreeS->Mean(Types::kSignal, ivar);
       (*fRmsS)[ivar]  = fBinaryTreeS->RMS (Types::kSignal, ivar);
@@ -778,6 +855,10 @@ void  TMVA::MethodCuts::Train( void )
 
    if (fBinaryTreeS != 0) { delete fBinaryTreeS; fBinaryTreeS = 0; }
    if (fBinaryTreeB != 0) { delete fBinaryTreeB; fBinaryTreeB = 0; }
+   std::vector<Float_t>().swap( fSortedEventsS );
+   std::vector<Float_t>().swap( fSortedWeightsS );
+   std::vector<Float_t>().swap( fSortedEventsB );
+   std::vector<Float_t>().swap( fSortedWeightsB );
 
    // force cut ranges within limits
    for (UInt_t ivar=0; ivar<GetNvar(); ivar++) {
@@ -884,6 +965,84 @@ Double_t TMVA::MethodCuts::ComputeEstimator( std::vector<Double_t>& pars )
       this->GetEffsfromSelection (&fTmpCutMin[0], &fTmpCutMax[0], effS, effB);
    }
 
+   return ComputeEstimator( effS, effB );
+}
+
+//_______________________________________________________________________
+void TMVA::MethodCuts::EstimatorFunctions( const std::vector< std::vector<Double_t>* >& parameters,
+                                           std::vector<Double_t>& estimators )
+{
+   // estimators for several parameter sets (the population of the GA).
+   // With NThreads > 1 and efficiencies from event selection, the selected
+   // signal and background weights of the parameter sets are summed in
+   // parallel threads. The estimators, which also update the best cuts of
+   // each signal efficiency bin, are then computed in the order of the
+   // parameter sets, such that the result does not depend on the threads
+   const UInt_t nSets = parameters.size();
+   const UInt_t nvar  = GetNvar();
+
+   // threads are only worth their start-up cost for large samples
+   UInt_t nThreads = TMath::Min( UInt_t(fNThreads), nSets );
+   if (nSets*(fSortedWeightsS.size() + fSortedWeightsB.size()) < 100000) nThreads = 1;
+   if (nThreads <= 1 || fEffMethod != kUseEventSelection) {
+      IFitterTarget::EstimatorFunctions( parameters, estimators );
+      return;
+   }
+
+   std::vector<Double_t> cutMin( nSets*nvar ), cutMax( nSets*nvar );
+   std::vector<Double_t> nSelS( nSets ), nSelB( nSets );
+   for (UInt_t i=0; i<nSets; i++) MatchParsToCuts( *parameters[i], &cutMin[i*nvar], &cutMax[i*nvar] );
+
+   // distribute the parameter sets in contiguous blocks over the threads,
+   // the last block is computed in the calling thread
+   std::vector<CutsSelectionTask> tasks( nThreads );
+   for (UInt_t i=0; i<nThreads; i++) {
+      UInt_t first = (i*nSets)/nThreads;
+      UInt_t last  = ((i+1)*nSets)/nThreads;
+      tasks[i].valuesS  = &fSortedEventsS;
+      tasks[i].weightsS = &fSortedWeightsS;
+      tasks[i].valuesB  = &fSortedEventsB;
+      tasks[i].weightsB = &fSortedWeightsB;
+      tasks[i].nvar     = nvar;
+      tasks[i].nSets    = last - first;
+      tasks[i].cutMin   = &cutMin[first*nvar];
+      tasks[i].cutMax   = &cutMax[first*nvar];
+      tasks[i].nSelS    = &nSelS[first];
+      tasks[i].nSelB    = &nSelB[first];
+   }
+#ifndef _WIN32
+   std::vector<pthread_t> threads( nThreads );
+   std::vector<Bool_t> started( nThreads, kFALSE );
+   for (UInt_t i=0; i<nThreads; i++) {
+      if (i<nThreads-1) started[i] = (pthread_create(&threads[i],0,CutsSelectionWorker,&tasks[i])==0);
+      if (!started[i]) CutsSelectionWorker(&tasks[i]);
+   }
+   for (UInt_t i=0; i<nThreads; i++) {
+      if (started[i]) pthread_join(threads[i],0);
+   }
+#else
+   for (UInt_t i=0; i<nThreads; i++) CutsSelectionWorker(&tasks[i]);
+#endif
+
+   estimators.resize( nSets );
+   for (UInt_t i=0; i<nSets; i++) {
+      for (UInt_t ivar=0; ivar<nvar; ivar++) {
+         fTmpCutMin[ivar] = cutMin[i*nvar+ivar];
+         fTmpCutMax[ivar] = cutMax[i*nvar+ivar];
+      }
+      Double_t effS = 0, effB = 0;
+      GetEffsfromSelectedWeights( nSelS[i], nSelB[i], effS, effB );
+      estimators[i] = ComputeEstimator( effS, effB );
+   }
+}
+
+//_______________________________________________________________________
+Double_t TMVA::MethodCuts::ComputeEstimator( Double_t effS, Double_t effB )
+{
+   // returns the estimator for the efficiencies effS and effB of the cuts
+   // in fTmpCutMin and fTmpCutMax, and keeps these cuts if they give the
+   // smallest background efficiency found so far in the bin of effS
+
    Double_t eta = 0;      
    
    // test for a estimator function which optimizes on the whole background-rejection signal-efficiency plot
@@ -1018,16 +1177,33 @@ void TMVA::MethodCuts::GetEffsfromSelection( Double_t* cutMin, Double_t* cutMax,
 {
    // compute signal and background efficiencies from event counting 
    // for given cut sample
-   Float_t nTotS = 0, nTotB = 0;
    Float_t nSelS = 0, nSelB = 0;  
-   
-   Volume* volume = new Volume( cutMin, cutMax, GetNvar() );
+
+   if (!fSortedWeightsS.empty() || !fSortedWeightsB.empty()) {
+      // add up the weights of the presorted events inside the cuts
+      nSelS = SumOfWeightsInCuts( fSortedEventsS, fSortedWeightsS, GetNvar(), cutMin, cutMax );
+      nSelB = SumOfWeightsInCuts( fSortedEventsB, fSortedWeightsB, GetNvar(), cutMin, cutMax );
+   }
+   else {
+      Volume* volume = new Volume( cutMin, cutMax, GetNvar() );
   
-   // search for all events lying in the volume, and add up their weights
-   nSelS = fBinaryTreeS->SearchVolume( volume );
-   nSelB = fBinaryTreeB->SearchVolume( volume );
+      // search for all events lying in the volume, and add up their weights
+      nSelS = fBinaryTreeS->SearchVolume( volume );
+      nSelB = fBinaryTreeB->SearchVolume( volume );
 
-   delete volume;
+      delete volume;
+   }
+
+   GetEffsfromSelectedWeights( nSelS, nSelB, effS, effB );
+}
+
+//_______________________________________________________________________
+void TMVA::MethodCuts::GetEffsfromSelectedWeights( Float_t nSelS, Float_t nSelB,
+                                                   Double_t& effS, Double_t& effB )
+{
+   // compute signal and background efficiencies from the sums of weights
+   // of the selected signal and background events
+   Float_t nTotS = 0, nTotB = 0;
 
    // total number of "events" (sum of weights) as reference to compute efficiency
    nTotS = fBinaryTreeS->GetSumOfWeights();
@@ -1068,6 +1244,31 @@ void TMVA::MethodCuts::GetEffsfromSelection( Double_t* cutMin, Double_t* cutMax,
    }
 }
 
+//_______________________________________________________________________
+void TMVA::MethodCuts::FillSortedEvents( Int_t cls, std::vector<Float_t>& values, std::vector<Float_t>& weights )
+{
+   // copy the variables and weights of the training events of class cls
+   // into contiguous arrays (nvar values per event), sorted by the first
+   // variable, for the efficiency calculation in GetEffsfromSelection
+   const std::vector<Event*>& events = GetEventCollection( Types::kTraining );
+   const UInt_t nvar = GetNvar();
+
+   std::vector< std::pair<Float_t,UInt_t> > order;
+   for (UInt_t ievt=0; ievt<events.size(); ievt++) {
+      if (Int_t(events[ievt]->GetClass()) == cls)
+         order.push_back( std::make_pair( Float_t(events[ievt]->GetValue(0)), ievt ) );
+   }
+   std::sort( order.begin(), order.end() );
+
+   values.resize( order.size()*nvar );
+   weights.resize( order.size() );
+   for (UInt_t i=0; i<order.size(); i++) {
+      const Event* ev = events[order[i].second];
+      for (UInt_t ivar=0; ivar<nvar; ivar++) values[i*nvar+ivar] = ev->GetValue(ivar);
+      weights[i] = ev->GetWeight();
+   }
+}
+
 //_______________________________________________________________________
 void TMVA::MethodCuts::CreateVariablePDFs( void )
 {
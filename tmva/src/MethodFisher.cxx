@@ -264,6 +264,24 @@ Double_t TMVA::MethodFisher::GetMvaValue( Double_t* err, Double_t* errUpper )
 
 }
 
+//_______________________________________________________________________
+void TMVA::MethodFisher::GetMvaValues( const Float_t* input, UInt_t nEvents, Double_t* mvaValues )
+{
+   // returns the Fisher values of a set of events stored column-wise
+   std::vector<Float_t> values;
+   if (!GetTransformedColumns( input, nEvents, values )) {
+      MethodBase::GetMvaValues( input, nEvents, mvaValues );
+      return;
+   }
+
+   for (UInt_t ievt=0; ievt<nEvents; ievt++) mvaValues[ievt] = fF0;
+   for (UInt_t ivar=0; ivar<GetNvar(); ivar++) {
+      const Double_t coeff  = (*fFisherCoeff)[ivar];
+      const Float_t* column = &values[ivar*nEvents];
+      for (UInt_t ievt=0; ievt<nEvents; ievt++) mvaValues[ievt] += coeff*column[ievt];
+   }
+}
+
 //_______________________________________________________________________
 void TMVA::MethodFisher::InitMatrices( void )
 {
@@ -69,6 +69,7 @@ TMVA::MethodKNN::MethodKNN( const TString& jobName,
    , fUseKernel(kFALSE)
    , fUseWeight(kFALSE)
    , fUseLDA(kFALSE)
+   , fNThreads(1)
    , fTreeOptDepth(0)
 {
    // standard constructor
@@ -90,6 +91,7 @@ TMVA::MethodKNN::MethodKNN( DataSetInfo& theData,
    , fUseKernel(kFALSE)
    , fUseWeight(kFALSE)
    , fUseLDA(kFALSE)
+   , fNThreads(1)
    , fTreeOptDepth(0)
 {
    // constructor from weight file
@@ -126,6 +128,7 @@ void TMVA::MethodKNN::DeclareOptions()
    DeclareOptionRef(fUseKernel    = kFALSE, "UseKernel",    "Use polynomial kernel weight");
    DeclareOptionRef(fUseWeight    = kTRUE,  "UseWeight",    "Use weight to count kNN events");
    DeclareOptionRef(fUseLDA       = kFALSE, "UseLDA",       "Use local linear discriminant - experimental feature");
+   DeclareOptionRef(fNThreads     = 1,      "NThreads",     "Number of threads used to build the kd-tree and to search it for many events at once");
 }
 
 //_______________________________________________________________________
@@ -153,6 +156,10 @@ void TMVA::MethodKNN::ProcessOptions()
       fBalanceDepth = 6;
       Log() << kWARNING << "Optimize must be a positive integer: set Optimize = " << fBalanceDepth << Endl;      
    }
+   if (fNThreads < 1) {
+      fNThreads = 1;
+      Log() << kWARNING << "NThreads must be a positive integer: set NThreads = " << fNThreads << Endl;
+   }
 
    Log() << kVERBOSE
          << "kNN options: \n" 
@@ -212,6 +219,7 @@ void TMVA::MethodKNN::MakeKNN()
    }
 
    // create binary tree
+   fModule->SetNThreads(static_cast<UInt_t>(fNThreads));
    fModule->Fill(static_cast<UInt_t>(fBalanceDepth),
                  static_cast<UInt_t>(100.0*fScaleFrac),
                  option);
@@ -309,7 +317,90 @@ Double_t TMVA::MethodKNN::GetMvaValue( Double_t* err, Double_t* errUpper )
       Log() << kFATAL << "kNN result list is empty" << Endl;
       return -100.0;  
    }
-   
+
+   return MethodKNN::getkNNValue(rlist, event_knn);
+}
+
+//_______________________________________________________________________
+void TMVA::MethodKNN::GetMvaValues( const std::vector<const Event*>& events, std::vector<Double_t>& mvaValues )
+{
+   // Compute classifier response of a set of events: the k-nearest neighbors
+   // of all events are searched at once, in NThreads parallel threads
+
+   const Int_t nvar = GetNVariables();
+
+   kNN::EventVec events_knn;
+   events_knn.reserve(events.size());
+   for (UInt_t ievt = 0; ievt < events.size(); ++ievt) {
+      const Event *ev = GetTransformationHandler().Transform(events[ievt]);
+
+      kNN::VarVec vvec(static_cast<UInt_t>(nvar), 0.0);
+      for (Int_t ivar = 0; ivar < nvar; ++ivar) {
+         vvec[ivar] = ev->GetValue(ivar);
+      }
+      events_knn.push_back(kNN::Event(vvec, ev->GetWeight(), 3));
+   }
+
+   mvaValues.resize(events.size());
+   if (!events.empty()) MethodKNN::getkNNValues(events_knn, &mvaValues[0]);
+}
+
+//_______________________________________________________________________
+void TMVA::MethodKNN::GetMvaValues( const Float_t* values, UInt_t nEvents, Double_t* mvaValues )
+{
+   // Compute classifier response of a set of events stored column-wise: the
+   // k-nearest neighbors of all events are searched at once, in NThreads
+   // parallel threads
+
+   std::vector<Float_t> input;
+   if (nEvents == 0 || !GetTransformedColumns( values, nEvents, input )) {
+      MethodBase::GetMvaValues( values, nEvents, mvaValues );
+      return;
+   }
+
+   const UInt_t nvar = GetNVariables();
+
+   kNN::EventVec events_knn;
+   events_knn.reserve(nEvents);
+   for (UInt_t ievt = 0; ievt < nEvents; ++ievt) {
+      kNN::VarVec vvec(nvar, 0.0);
+      for (UInt_t ivar = 0; ivar < nvar; ++ivar) {
+         vvec[ivar] = input[ivar*nEvents + ievt];
+      }
+      events_knn.push_back(kNN::Event(vvec, 1.0, 3));
+   }
+
+   MethodKNN::getkNNValues(events_knn, mvaValues);
+}
+
+//_______________________________________________________________________
+void TMVA::MethodKNN::getkNNValues(const kNN::EventVec &events_knn, Double_t* mvaValues)
+{
+   // search for fnkNN+2 nearest neighbors of all events at once and
+   // compute the classifier response of each event
+
+   const UInt_t knn = static_cast<UInt_t>(fnkNN);
+
+   std::vector<kNN::List> rlists;
+   fModule->Find(events_knn, knn + 2, rlists);
+
+   for (UInt_t ievt = 0; ievt < events_knn.size(); ++ievt) {
+      if (ievt >= rlists.size() || rlists[ievt].size() != knn + 2) {
+         Log() << kFATAL << "kNN result list is empty" << Endl;
+         mvaValues[ievt] = -100.0;
+         continue;
+      }
+      mvaValues[ievt] = MethodKNN::getkNNValue(rlists[ievt], events_knn[ievt]);
+   }
+}
+
+//_______________________________________________________________________
+Double_t TMVA::MethodKNN::getkNNValue(const kNN::List &rlist, const kNN::Event &event_knn)
+{
+   // compute classifier response from the list of the nearest neighbors
+
+   const UInt_t knn = static_cast<UInt_t>(fnkNN);
+
    if (fUseLDA) return MethodKNN::getLDAValue(rlist, event_knn);
 
    //
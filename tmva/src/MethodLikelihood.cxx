@@ -461,38 +461,7 @@ Double_t TMVA::MethodLikelihood::GetMvaValue( Double_t* err, Double_t* errUpper
 
       for (UInt_t itype=0; itype < 2; itype++) {
 
-         // verify limits
-         if      (x[itype] >= (*fPDFSig)[ivar]->GetXmax()) x[itype] = (*fPDFSig)[ivar]->GetXmax() - 1.0e-10;
-         else if (x[itype] <  (*fPDFSig)[ivar]->GetXmin()) x[itype] = (*fPDFSig)[ivar]->GetXmin();
-
-         // find corresponding histogram from cached indices
-         PDF* pdf = (itype == 0) ? (*fPDFSig)[ivar] : (*fPDFBgd)[ivar];
-         if (pdf == 0) Log() << kFATAL << "<GetMvaValue> Reference histograms don't exist" << Endl;
-         TH1* hist = pdf->GetPDFHist();
-
-         // interpolate linearly between adjacent bins
-         // this is not useful for discrete variables
-         Int_t bin = hist->FindBin(x[itype]);
-
-         // **** POTENTIAL BUG: PREFORMANCE IS WORSE WHEN USING TRUE TYPE ***
-         // ==> commented out at present
-         if ((*fPDFSig)[ivar]->GetInterpolMethod() == TMVA::PDF::kSpline0 ||
-             DataInfo().GetVariableInfo(ivar).GetVarType() == 'N') {
-            p = TMath::Max( hist->GetBinContent(bin), fEpsilon );
-         } else { // splined PDF
-            Int_t nextbin = bin;
-            if ((x[itype] > hist->GetBinCenter(bin) && bin != hist->GetNbinsX()) || bin == 1)
-               nextbin++;
-            else
-               nextbin--;
-
-
-            Double_t dx   = hist->GetBinCenter(bin)  - hist->GetBinCenter(nextbin);
-            Double_t dy   = hist->GetBinContent(bin) - hist->GetBinContent(nextbin);
-            Double_t like = hist->GetBinContent(bin) + (x[itype] - hist->GetBinCenter(bin)) * dy/dx;
-
-            p = TMath::Max( like, fEpsilon );
-         }
+         p = GetPDFValue( ivar, itype, x[itype] );
 
          if (itype == 0) ps *= p;
          else            pb *= p;
@@ -503,6 +472,76 @@ Double_t TMVA::MethodLikelihood::GetMvaValue( Double_t* err, Double_t* errUpper
    return TransformLikelihoodOutput( ps, pb );
 }
 
+//_______________________________________________________________________
+void TMVA::MethodLikelihood::GetMvaValues( const Float_t* input, UInt_t nEvents, Double_t* mvaValues )
+{
+   // returns the likelihood estimators of a set of events stored
+   // column-wise; the transformations for signal and background are
+   // applied to all events at once, without changing the reference class
+   // of the transformation handler
+
+   std::vector<Float_t> vs, vb;
+   if (!GetTransformedColumns( input, nEvents, vs, fSignalClass ) ||
+       !GetTransformedColumns( input, nEvents, vb, fBackgroundClass )) {
+      MethodBase::GetMvaValues( input, nEvents, mvaValues );
+      return;
+   }
+
+   std::vector<Double_t> ps( nEvents, 1 ), pb( nEvents, 1 );
+   for (UInt_t ivar=0; ivar<GetNvar(); ivar++) {
+
+      // drop one variable (this is ONLY used for internal variable ranking !)
+      if ((Int_t)ivar == fDropVariable) continue;
+
+      for (UInt_t ievt=0; ievt<nEvents; ievt++) {
+         ps[ievt] *= GetPDFValue( ivar, 0, vs[ivar*nEvents+ievt] );
+         pb[ievt] *= GetPDFValue( ivar, 1, vb[ivar*nEvents+ievt] );
+      }
+   }
+
+   for (UInt_t ievt=0; ievt<nEvents; ievt++) mvaValues[ievt] = TransformLikelihoodOutput( ps[ievt], pb[ievt] );
+}
+
+//_______________________________________________________________________
+Double_t TMVA::MethodLikelihood::GetPDFValue( UInt_t ivar, UInt_t itype, Double_t x ) const
+{
+   // returns the signal (itype=0) or background PDF of variable ivar at x,
+   // interpolated linearly between adjacent bins for splined PDFs
+
+   // verify limits
+   if      (x >= (*fPDFSig)[ivar]->GetXmax()) x = (*fPDFSig)[ivar]->GetXmax() - 1.0e-10;
+   else if (x <  (*fPDFSig)[ivar]->GetXmin()) x = (*fPDFSig)[ivar]->GetXmin();
+
+   // find corresponding histogram from cached indices
+   PDF* pdf = (itype == 0) ? (*fPDFSig)[ivar] : (*fPDFBgd)[ivar];
+   if (pdf == 0) Log() << kFATAL << "<GetMvaValue> Reference histograms don't exist" << Endl;
+   TH1* hist = pdf->GetPDFHist();
+
+   // interpolate linearly between adjacent bins
+   // this is not useful for discrete variables
+   Int_t bin = hist->FindBin(x);
+
+   // **** POTENTIAL BUG: PREFORMANCE IS WORSE WHEN USING TRUE TYPE ***
+   // ==> commented out at present
+   if ((*fPDFSig)[ivar]->GetInterpolMethod() == TMVA::PDF::kSpline0 ||
+       DataInfo().GetVariableInfo(ivar).GetVarType() == 'N') {
+      return TMath::Max( hist->GetBinContent(bin), fEpsilon );
+   } else { // splined PDF
+      Int_t nextbin = bin;
+      if ((x > hist->GetBinCenter(bin) && bin != hist->GetNbinsX()) || bin == 1)
+         nextbin++;
+      else
+         nextbin--;
+
+
+      Double_t dx   = hist->GetBinCenter(bin)  - hist->GetBinCenter(nextbin);
+      Double_t dy   = hist->GetBinContent(bin) - hist->GetBinContent(nextbin);
+      Double_t like = hist->GetBinContent(bin) + (x - hist->GetBinCenter(bin)) * dy/dx;
+
+      return TMath::Max( like, fEpsilon );
+   }
+}
+
 //_______________________________________________________________________
 Double_t TMVA::MethodLikelihood::TransformLikelihoodOutput( Double_t ps, Double_t pb ) const
 {
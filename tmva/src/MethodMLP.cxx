@@ -50,11 +50,20 @@
 #include "TMath.h"
 #include "TFile.h"
 
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
 #include "TMVA/ClassifierFactory.h"
 #include "TMVA/Interval.h"
 #include "TMVA/MethodMLP.h"
 #include "TMVA/TNeuron.h"
 #include "TMVA/TSynapse.h"
+#include "TMVA/TNeuronInputSum.h"
+#include "TMVA/TActivationIdentity.h"
+#include "TMVA/TActivationSigmoid.h"
+#include "TMVA/TActivationTanh.h"
+#include "TMVA/TActivationRadial.h"
 #include "TMVA/Timer.h"
 #include "TMVA/Types.h"
 #include "TMVA/Tools.h"
@@ -72,6 +81,199 @@ ClassImp(TMVA::MethodMLP)
 
 using std::vector;
 
+namespace {
+
+   // activation functions known to the minibatch training, which evaluates
+   // them directly instead of through the TFormula of the TActivation
+   enum EMLPDenseActivation { kMLPDenseUnknown = -1, kMLPDenseIdentity, kMLPDenseSigmoid, kMLPDenseTanh, kMLPDenseRadial };
+
+   //______________________________________________________________________________
+   Int_t MLPDenseActivationType( TMVA::TActivation* activation )
+   {
+      // the type of an activation function, kMLPDenseUnknown for other functions
+
+      if (dynamic_cast<TMVA::TActivationIdentity*>(activation) != 0) return kMLPDenseIdentity;
+      if (dynamic_cast<TMVA::TActivationSigmoid*>(activation)  != 0) return kMLPDenseSigmoid;
+      if (dynamic_cast<TMVA::TActivationTanh*>(activation)     != 0) return kMLPDenseTanh;
+      if (dynamic_cast<TMVA::TActivationRadial*>(activation)   != 0) return kMLPDenseRadial;
+      return kMLPDenseUnknown;
+   }
+
+   //______________________________________________________________________________
+   inline Double_t MLPDenseEval( Int_t type, Double_t x )
+   {
+      // evaluate the activation function (same expressions as the TActivation classes)
+
+      switch (type) {
+      case kMLPDenseSigmoid: return 1.0/(1.0+TMath::Exp(-x));
+      case kMLPDenseTanh:    return TMath::TanH(x);
+      case kMLPDenseRadial:  return TMath::Exp(-x*x/2.0);
+      default:               return x;
+      }
+   }
+
+   //______________________________________________________________________________
+   inline Double_t MLPDenseEvalDerivative( Int_t type, Double_t x )
+   {
+      // evaluate the derivative of the activation function
+
+      switch (type) {
+      case kMLPDenseSigmoid: {
+         const Double_t e = TMath::Exp(-x);
+         return e/((1.0+e)*(1.0+e));
+      }
+      case kMLPDenseTanh: {
+         const Double_t t = TMath::TanH(x);
+         return 1-t*t;
+      }
+      case kMLPDenseRadial:  return -x*TMath::Exp(-x*x/2.0);
+      default:               return 1.0;
+      }
+   }
+
+   // a layer of the network copied into dense arrays for the minibatch
+   // training. The neurons with pre-links (all but the bias neuron) come first
+   // in the layer, the weights of their synapses are stored neuron by neuron
+   // in the order of the neurons of the previous layer
+   struct MLPDenseLayer {
+      Int_t nNeurons;                        // number of neurons of the layer
+      Int_t nComputed;                       // number of neurons which are not bias neurons
+      Int_t activation;                      // activation function of the computed neurons
+      std::vector<Double_t> constants;       // values of the bias neurons
+      std::vector<Double_t> weights;         // nComputed x nNeurons(previous layer) synapse weights
+      std::vector<Double_t> learnRates;      // learning rates of the synapses
+      std::vector<TMVA::TSynapse*> synapses; // the synapses the weights belong to
+   };
+
+   // the events of one batch, row by row
+   struct MLPDenseBatch {
+      const std::vector<MLPDenseLayer>* layers;
+      const Double_t* inputs;                // nEvents x nComputed(input layer) input values
+      const Double_t* desired;               // nEvents x nComputed(output layer) desired outputs
+      const Double_t* eventWeights;          // event weights
+      Bool_t crossEntropy;                   // CE instead of MSE estimator
+   };
+
+   // a block of events of a batch and the work space of its thread
+   struct MLPDenseTask {
+      const MLPDenseBatch* batch;
+      Int_t first;                           // first event of the block
+      Int_t nEvents;                         // number of events of the block
+      std::vector< std::vector<Double_t> > values;      // per layer the neuron inputs of the events
+      std::vector< std::vector<Double_t> > activations; // per layer the activations of the events
+      std::vector< std::vector<Double_t> > deltas;      // per layer the deltas of the events
+      std::vector< std::vector<Double_t> > gradients;   // per layer the summed error fields of the synapses
+   };
+
+   //______________________________________________________________________________
+   void MLPDenseBackPropagate( MLPDenseTask& task )
+   {
+      // propagate the events of the block forward through the network layer by
+      // layer, calculate the deltas of the neurons backwards and sum the error
+      // fields of the synapses over the events. The calculation follows
+      // TNeuron::CalculateDelta and TSynapse::CalculateDelta term by term
+
+      const MLPDenseBatch& batch = *task.batch;
+      const std::vector<MLPDenseLayer>& layers = *batch.layers;
+      const Int_t numLayers = layers.size();
+      const Int_t nEvents = task.nEvents;
+
+      task.values.resize( numLayers );
+      task.activations.resize( numLayers );
+      task.deltas.resize( numLayers );
+      task.gradients.resize( numLayers );
+
+      // input layer
+      const MLPDenseLayer& inputLayer = layers[0];
+      task.activations[0].resize( nEvents*inputLayer.nNeurons );
+      for (Int_t ievt = 0; ievt < nEvents; ievt++) {
+         Double_t* act = &task.activations[0][ievt*inputLayer.nNeurons];
+         const Double_t* in = batch.inputs + (task.first+ievt)*inputLayer.nComputed;
+         for (Int_t j = 0; j < inputLayer.nComputed; j++) act[j] = in[j];
+         for (Int_t j = inputLayer.nComputed; j < inputLayer.nNeurons; j++) act[j] = inputLayer.constants[j-inputLayer.nComputed];
+      }
+
+      // forward pass
+      for (Int_t i = 1; i < numLayers; i++) {
+         const MLPDenseLayer& layer = layers[i];
+         const Int_t nIn = layers[i-1].nNeurons;
+         task.values[i].resize( nEvents*layer.nComputed );
+         task.activations[i].resize( nEvents*layer.nNeurons );
+         for (Int_t ievt = 0; ievt < nEvents; ievt++) {
+            const Double_t* prevAct = &task.activations[i-1][ievt*nIn];
+            Double_t* val = &task.values[i][ievt*layer.nComputed];
+            Double_t* act = &task.activations[i][ievt*layer.nNeurons];
+            for (Int_t j = 0; j < layer.nComputed; j++) {
+               const Double_t* w = &layer.weights[j*nIn];
+               Double_t sum = 0;
+               for (Int_t k = 0; k < nIn; k++) sum += w[k]*prevAct[k];
+               val[j] = sum;
+               act[j] = MLPDenseEval( layer.activation, sum );
+            }
+            for (Int_t j = layer.nComputed; j < layer.nNeurons; j++) act[j] = layer.constants[j-layer.nComputed];
+         }
+      }
+
+      // deltas of the output neurons
+      const MLPDenseLayer& outputLayer = layers[numLayers-1];
+      const Int_t nOut = outputLayer.nComputed;
+      task.deltas[numLayers-1].resize( nEvents*nOut );
+      for (Int_t ievt = 0; ievt < nEvents; ievt++) {
+         const Double_t* act = &task.activations[numLayers-1][ievt*outputLayer.nNeurons];
+         const Double_t* val = &task.values[numLayers-1][ievt*nOut];
+         const Double_t* desired = batch.desired + (task.first+ievt)*nOut;
+         Double_t* delta = &task.deltas[numLayers-1][ievt*nOut];
+         for (Int_t j = 0; j < nOut; j++) {
+            Double_t error;
+            if (batch.crossEntropy) error = -1./(act[j] - 1 + desired[j]);
+            else                    error = act[j] - desired[j];
+            error *= batch.eventWeights[task.first+ievt];
+            delta[j] = error * MLPDenseEvalDerivative( outputLayer.activation, val[j] );
+         }
+      }
+
+      // backward pass
+      for (Int_t i = numLayers-1; i > 0; i--) {
+         const MLPDenseLayer& layer = layers[i];
+         const Int_t nIn = layers[i-1].nNeurons;
+         std::vector<Double_t>& gradient = task.gradients[i];
+         gradient.assign( layer.weights.size(), 0 );
+         for (Int_t ievt = 0; ievt < nEvents; ievt++) {
+            const Double_t* delta = &task.deltas[i][ievt*layer.nComputed];
+            const Double_t* prevAct = &task.activations[i-1][ievt*nIn];
+            for (Int_t j = 0; j < layer.nComputed; j++) {
+               Double_t* g = &gradient[j*nIn];
+               for (Int_t k = 0; k < nIn; k++) g[k] += delta[j]*prevAct[k];
+            }
+         }
+         if (i == 1) break;
+
+         // deltas of the hidden neurons of the previous layer
+         const MLPDenseLayer& prevLayer = layers[i-1];
+         task.deltas[i-1].resize( nEvents*prevLayer.nComputed );
+         for (Int_t ievt = 0; ievt < nEvents; ievt++) {
+            const Double_t* delta = &task.deltas[i][ievt*layer.nComputed];
+            const Double_t* prevVal = &task.values[i-1][ievt*prevLayer.nComputed];
+            Double_t* prevDelta = &task.deltas[i-1][ievt*prevLayer.nComputed];
+            for (Int_t k = 0; k < prevLayer.nComputed; k++) {
+               Double_t error = 0.0;
+               for (Int_t j = 0; j < layer.nComputed; j++) error += layer.weights[j*nIn+k]*delta[j];
+               prevDelta[k] = error * MLPDenseEvalDerivative( prevLayer.activation, prevVal[k] );
+            }
+         }
+      }
+   }
+
+   //______________________________________________________________________________
+   void* MLPDenseWorker( void* arg )
+   {
+      // thread function back-propagating the events of a task
+      MLPDenseBackPropagate( *(MLPDenseTask*) arg );
+      return 0;
+   }
+
+}
+
 //______________________________________________________________________________
 TMVA::MethodMLP::MethodMLP( const TString& jobName,
                             const TString& methodTitle,
@@ -87,7 +289,7 @@ TMVA::MethodMLP::MethodMLP( const TString& jobName,
      fLastAlpha(0.0), fTau(0.),
      fResetStep(0), fLearnRate(0.0), fDecayRate(0.0),     
      fBPMode(kSequential), fBpModeS("None"),
-     fBatchSize(0), fTestRate(0), fEpochMon(false),
+     fBatchSize(0), fNThreads(1), fTestRate(0), fEpochMon(false),
      fGA_nsteps(0), fGA_preCalc(0), fGA_SC_steps(0), 
      fGA_SC_rate(0), fGA_SC_factor(0.0),
      fDeviationsFromTargets(0),
@@ -109,7 +311,7 @@ TMVA::MethodMLP::MethodMLP( DataSetInfo& theData,
      fLastAlpha(0.0), fTau(0.),
      fResetStep(0), fLearnRate(0.0), fDecayRate(0.0),     
      fBPMode(kSequential), fBpModeS("None"),
-     fBatchSize(0), fTestRate(0), fEpochMon(false),
+     fBatchSize(0), fNThreads(1), fTestRate(0), fEpochMon(false),
      fGA_nsteps(0), fGA_preCalc(0), fGA_SC_steps(0), 
      fGA_SC_rate(0), fGA_SC_factor(0.0),
      fDeviationsFromTargets(0),
@@ -190,13 +392,17 @@ void TMVA::MethodMLP::DeclareOptions()
    DeclareOptionRef(fTau      =3.0,  "Tau",          "LineSearch \"size step\"");
 
    DeclareOptionRef(fBpModeS="sequential", "BPMode",
-                    "Back-propagation learning mode: sequential or batch");
+                    "Back-propagation learning mode: sequential, batch or minibatch (batch mode on dense weight matrices, multi-threaded)");
    AddPreDefVal(TString("sequential"));
    AddPreDefVal(TString("batch"));
+   AddPreDefVal(TString("minibatch"));
 
    DeclareOptionRef(fBatchSize=-1, "BatchSize",
                     "Batch size: number of events/batch, only set if in Batch Mode, -1 for BatchSize=number_of_events");
 
+   DeclareOptionRef(fNThreads=1, "NThreads",
+                    "Number of threads used to back-propagate the events of a batch in minibatch mode");
+
    DeclareOptionRef(fImprovement=1e-30, "ConvergenceImprove",
                     "Minimum improvement which counts as improvement (<0 means automatic convergence check is turned off)");
 
@@ -235,10 +441,24 @@ void TMVA::MethodMLP::ProcessOptions()
 
    if      (fBpModeS == "sequential") fBPMode = kSequential;
    else if (fBpModeS == "batch")      fBPMode = kBatch;
+   else if (fBpModeS == "minibatch")  fBPMode = kMiniBatch;
+
+   if (fBPMode == kMiniBatch &&
+       (dynamic_cast<TNeuronInputSum*>(fInputCalculator) == 0 ||
+        MLPDenseActivationType(fActivation) == kMLPDenseUnknown ||
+        MLPDenseActivationType(fOutput) == kMLPDenseUnknown)) {
+      Log() << kWARNING << "BPMode=minibatch requires NeuronInputType=sum and a sigmoid, tanh, radial or linear"
+            << " NeuronType --> use BPMode=batch" << Endl;
+      fBPMode = kBatch;
+   }
+   if (fNThreads < 1) {
+      Log() << kWARNING << "NThreads = " << fNThreads << " is not a valid number of threads --> set to 1" << Endl;
+      fNThreads = 1;
+   }
 
    //   InitializeLearningRates();
 
-   if (fBPMode == kBatch) {
+   if (fBPMode == kBatch || fBPMode == kMiniBatch) {
       Data()->SetCurrentType(Types::kTraining);
       Int_t numEvents = Data()->GetNEvents();
       if (fBatchSize < 1 || fBatchSize > numEvents) fBatchSize = numEvents;
@@ -1026,7 +1246,8 @@ void TMVA::MethodMLP::BackPropagationMinimize(Int_t nEpochs)
       }
       Data()->SetCurrentType( Types::kTraining );
 
-      TrainOneEpoch();
+      if (fBPMode == kMiniBatch) TrainOneEpochMiniBatch();
+      else                       TrainOneEpoch();
       DecaySynapseWeights(i >= lateEpoch);
 
       // monitor convergence of training and control sample
@@ -1115,6 +1336,133 @@ void TMVA::MethodMLP::TrainOneEpoch()
    delete[] index;
 }
 
+//______________________________________________________________________________
+void TMVA::MethodMLP::TrainOneEpochMiniBatch()
+{
+   // train network over a single epoch in minibatch mode: the weights are
+   // copied into dense arrays, the events of each batch are propagated
+   // through the network layer by layer (in NThreads threads, each with a
+   // contiguous block of events) and the weights are adjusted after each
+   // batch exactly as in batch mode, with the learning rate of each synapse
+   // and the error fields averaged over the events of the batch. The events
+   // left at the end of the epoch form a last, smaller batch. At the end of
+   // the epoch the weights are copied back into the synapses.
+
+   // copy the network into dense arrays
+   Int_t numLayers = fNetwork->GetEntriesFast();
+   std::vector<MLPDenseLayer> layers( numLayers );
+   for (Int_t i = 0; i < numLayers; i++) {
+      TObjArray* curLayer = (TObjArray*)fNetwork->At(i);
+      MLPDenseLayer& layer = layers[i];
+      layer.nNeurons   = curLayer->GetEntriesFast();
+      layer.nComputed  = (i == 0) ? GetNvar() : 0;
+      layer.activation = MLPDenseActivationType( (i == numLayers-1) ? fOutput : fActivation );
+      for (Int_t j = 0; j < layer.nNeurons; j++) {
+         TNeuron* neuron = (TNeuron*)curLayer->At(j);
+         if (i > 0 && neuron->NumPreLinks() > 0) {
+            layer.nComputed++;
+            for (Int_t k = 0; k < neuron->NumPreLinks(); k++) {
+               TSynapse* synapse = neuron->PreLinkAt(k);
+               layer.synapses.push_back( synapse );
+               layer.weights.push_back( synapse->GetWeight() );
+               layer.learnRates.push_back( synapse->GetLearningRate() );
+            }
+         }
+         else if (j >= layer.nComputed) layer.constants.push_back( neuron->GetValue() ); // bias neuron
+      }
+   }
+   const Int_t nVar = layers[0].nComputed;
+   const Int_t nOut = layers[numLayers-1].nComputed;
+
+   Int_t nEvents = Data()->GetNEvents();
+
+   // randomize the order events will be presented
+   Int_t* index = new Int_t[nEvents];
+   for (Int_t i = 0; i < nEvents; i++) index[i] = i;
+   Shuffle(index, nEvents);
+
+   std::vector<Double_t> inputs, desired, eventWeights;
+   MLPDenseBatch batch;
+   batch.layers       = &layers;
+   batch.crossEntropy = (fEstimator == kCE);
+   std::vector<MLPDenseTask> tasks;
+
+   for (Int_t i = 0; i < nEvents; i++) {
+
+      const Event * ev = GetEvent(index[i]);
+      if ((ev->GetWeight() >= 0) || !IgnoreEventsWithNegWeightsInTraining()
+          || (Data()->GetCurrentType() != Types::kTraining)) {
+         for (Int_t ivar = 0; ivar < nVar; ivar++) inputs.push_back( ev->GetValue(ivar) );
+         if (DoRegression()) {
+            for (Int_t itgt = 0; itgt < nOut; itgt++) desired.push_back( ev->GetTarget(itgt) );
+         }
+         else if (DoMulticlass()) {
+            const std::vector<Float_t>& targets = *DataInfo().GetTargetsForMulticlass( ev );
+            for (Int_t icls = 0; icls < nOut; icls++) desired.push_back( targets[icls] );
+         }
+         else desired.push_back( GetDesiredOutput( ev ) );
+         eventWeights.push_back( ev->GetWeight() );
+      }
+
+      if ((i+1)%fBatchSize != 0 && i != nEvents-1) continue;
+      Int_t nBatch = eventWeights.size();
+      if (nBatch == 0) continue;
+
+      // threads are only worth their start-up cost for large batches
+      Int_t nTasks = TMath::Max( 1, TMath::Min( fNThreads, nBatch/100 ) );
+      batch.inputs       = &inputs[0];
+      batch.desired      = &desired[0];
+      batch.eventWeights = &eventWeights[0];
+      tasks.resize( nTasks );
+      for (Int_t t = 0; t < nTasks; t++) {
+         tasks[t].batch   = &batch;
+         tasks[t].first   = (t*nBatch)/nTasks;
+         tasks[t].nEvents = ((t+1)*nBatch)/nTasks - tasks[t].first;
+      }
+#ifndef _WIN32
+      if (nTasks > 1) {
+         // the last block is processed in the calling thread
+         std::vector<pthread_t> threads( nTasks );
+         std::vector<Bool_t> started( nTasks, kFALSE );
+         for (Int_t t = 0; t < nTasks; t++) {
+            if (t < nTasks-1) started[t] = (pthread_create(&threads[t],0,MLPDenseWorker,&tasks[t])==0);
+            if (!started[t]) MLPDenseBackPropagate( tasks[t] );
+         }
+         for (Int_t t = 0; t < nTasks; t++) {
+            if (started[t]) pthread_join(threads[t],0);
+         }
+      }
+      else
+#endif
+      {
+         for (Int_t t = 0; t < nTasks; t++) MLPDenseBackPropagate( tasks[t] );
+      }
+
+      // adjust the weights with the error fields summed over the blocks in a
+      // fixed order (see TSynapse::AdjustWeight)
+      for (Int_t l = 1; l < numLayers; l++) {
+         MLPDenseLayer& layer = layers[l];
+         const Int_t nWeights = layer.weights.size();
+         for (Int_t k = 0; k < nWeights; k++) {
+            Double_t delta = 0.0;
+            for (Int_t t = 0; t < nTasks; t++) delta += tasks[t].gradients[l][k];
+            layer.weights[k] += -layer.learnRates[k] * (delta / nBatch);
+         }
+      }
+
+      inputs.clear();
+      desired.clear();
+      eventWeights.clear();
+   }
+
+   delete[] index;
+
+   // copy the weights back into the synapses
+   for (Int_t l = 1; l < numLayers; l++) {
+      for (UInt_t k = 0; k < layers[l].synapses.size(); k++) layers[l].synapses[k]->SetWeight( layers[l].weights[k] );
+   }
+}
+
 //______________________________________________________________________________
 void TMVA::MethodMLP::Shuffle(Int_t* index, Int_t n)
 {
@@ -91,6 +91,7 @@ TMVA::MethodPDEFoam::MethodPDEFoam( const TString& jobName,
    , fNmin(100)
    , fCutNmin(kTRUE)
    , fMaxDepth(0)
+   , fNThreads(1)
    , fKernelStr("None")
    , fKernel(kNone)
    , fKernelEstimator(NULL)
@@ -127,6 +128,7 @@ TMVA::MethodPDEFoam::MethodPDEFoam( DataSetInfo& dsi,
    , fNmin(100)
    , fCutNmin(kTRUE)
    , fMaxDepth(0)
+   , fNThreads(1)
    , fKernelStr("None")
    , fKernel(kNone)
    , fKernelEstimator(NULL)
@@ -172,6 +174,7 @@ void TMVA::MethodPDEFoam::Init( void )
    fEvPerBin       = 10000;    // number of events per bin
    fNmin           = 100;      // minimum number of events in cell
    fMaxDepth       = 0;        // cell tree depth (default: unlimited)
+   fNThreads       = 1;        // number of threads for the cell exploration
    fFillFoamWithOrigWeights = kFALSE; // fill orig. weights into foam
    fUseYesNoCell   = kFALSE;   // return -1 or 1 for bg or signal events
    fDTLogic        = "None";   // decision tree algorithmus
@@ -208,6 +211,7 @@ void TMVA::MethodPDEFoam::DeclareOptions()
    DeclareOptionRef( fMultiTargetRegression = kFALSE,     "MultiTargetRegression", "Do regression with multiple targets");
    DeclareOptionRef( fNmin = 100,             "Nmin",     "Number of events in cell required to split cell");
    DeclareOptionRef( fMaxDepth = 0,           "MaxDepth",  "Maximum depth of cell tree (0=unlimited)");
+   DeclareOptionRef( fNThreads = 1,           "NThreads", "Number of threads used to sample the cells during the foam build-up");
    DeclareOptionRef( fFillFoamWithOrigWeights = kFALSE, "FillFoamWithOrigWeights", "Fill foam with original or boost weights");
    DeclareOptionRef( fUseYesNoCell = kFALSE, "UseYesNoCell", "Return -1 or 1 for bkg or signal like events");
    DeclareOptionRef( fDTLogic = "None", "DTLogic", "Use decision tree algorithm to split cells");
@@ -251,6 +255,11 @@ void TMVA::MethodPDEFoam::ProcessOptions()
    }
    fnCells = fnActiveCells*2-1;
 
+   if (fNThreads < 1) {
+      fNThreads = 1;
+      Log() << kWARNING << "NThreads must be a positive integer: set NThreads = " << fNThreads << Endl;
+   }
+
    // DT logic is only applicable if a single foam is trained
    if (fSigBgSeparated && fDTLogic != "None") {
       Log() << kFATAL << "Decision tree logic works only for a single foam (SigBgSeparate=F)" << Endl;
@@ -1019,6 +1028,7 @@ TMVA::PDEFoam* TMVA::MethodPDEFoam::InitFoam(TString foamcaption, EFoamType ft,
    // cuts
    pdefoam->SetNmin(fNmin);
    pdefoam->SetMaxDepth(fMaxDepth); // maximum cell tree depth
+   pdefoam->SetNThreads(fNThreads); // threads for the cell exploration
 
    // Init PDEFoam
    pdefoam->Initialize();
@@ -1370,6 +1380,8 @@ TMVA::PDEFoam* TMVA::MethodPDEFoam::ReadClonedFoamFromFile(TFile* file, const TS
             << " could not be cloned!" << Endl;
       return NULL;
    }
+   // the cached division points are not streamed
+   foam->BuildCellSplits();
 
    return foam;
 }
@@ -80,6 +80,8 @@ TMVA::MethodSVM::MethodSVM( const TString& jobName, const TString& methodTitle,
    , fTolerance(0)
    , fMaxIter(0)
    , fNSubSets(0)
+   , fCacheSize(0)
+   , fNThreads(1)
    , fBparm(0)
    , fGamma(0)
    , fWgSet(0)
@@ -103,6 +105,8 @@ TMVA::MethodSVM::MethodSVM( DataSetInfo& theData, const TString& theWeightFile,
    , fTolerance(0)
    , fMaxIter(0)
    , fNSubSets(0)
+   , fCacheSize(0)
+   , fNThreads(1)
    , fBparm(0)
    , fGamma(0)
    , fWgSet(0)
@@ -163,6 +167,8 @@ void TMVA::MethodSVM::DeclareOptions()
    DeclareOptionRef( fTolerance = 0.01, "Tol",      "Tolerance parameter" );  //should be fixed
    DeclareOptionRef( fMaxIter   = 1000, "MaxIter",  "Maximum number of training loops" );
    DeclareOptionRef( fNSubSets  = 1,    "NSubSets", "Number of training subsets" );
+   DeclareOptionRef( fCacheSize = 1000, "CacheSize", "Size of the cache of kernel matrix rows in MB" );
+   DeclareOptionRef( fNThreads  = 1,    "NThreads", "Number of threads used to compute the rows of the kernel matrix" );
 
    // for gaussian kernel parameter(s)
    DeclareOptionRef( fGamma = 1., "Gamma", "RBF kernel parameter: Gamma");
@@ -192,6 +198,10 @@ void TMVA::MethodSVM::ProcessOptions()
             << " --> please remove \"IgnoreNegWeightsInTraining\" option from booking string."
             << Endl;
    }
+   if (fNThreads < 1) {
+      fNThreads = 1;
+      Log() << kWARNING << "NThreads must be a positive integer: set NThreads = " << fNThreads << Endl;
+   }
 }
 
 //_______________________________________________________________________
@@ -209,7 +219,7 @@ void TMVA::MethodSVM::Train()
 
    Log()<< kINFO << "Building SVM Working Set..."<< Endl;
    Timer bldwstime( GetName());
-   fWgSet = new SVWorkingSet( fInputData, fSVKernelFunction,fTolerance, DoRegression() );
+   fWgSet = new SVWorkingSet( fInputData, fSVKernelFunction,fTolerance, DoRegression(), fCacheSize, fNThreads );
    Log() << kINFO <<"Elapsed time for Working Set build: "<< bldwstime.GetElapsedTime()<<Endl;
 
    // timing
@@ -31,6 +31,11 @@
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <queue>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
 
 #include "TMath.h"
 
@@ -150,8 +155,218 @@ std::ostream& TMVA::kNN::operator<<(std::ostream& os, const TMVA::kNN::Event& ev
 }
 
 
+namespace
+{
+   // flat kd-tree: the node of the events first..last-1 is the event in
+   // the middle, (first+last)/2, the events before it form the left and the
+   // events after it the right subtree
+   struct kNNFlatTree
+   {
+      const TMVA::kNN::VarType *var;                           // variables of the events in tree order
+      const UInt_t *split;                                     // split variable of each node
+      const UInt_t *event;                                     // index of the events in tree order
+      const TMVA::kNN::Node<TMVA::kNN::Event> * const *node;   // node of each event index
+      UInt_t dimn;
+   };
+
+   // flat kd-tree under construction
+   struct kNNFlatBuild
+   {
+      const TMVA::kNN::VarType *var; // variables of the events by event index
+      UInt_t *event;                 // index of the events in tree order
+      UInt_t *split;                 // split variable of each node
+      UInt_t dimn;
+   };
+
+   struct kNNFlatBuildTask
+   {
+      const kNNFlatBuild *build;
+      UInt_t first;
+      UInt_t last;
+      UInt_t nthreads;
+   };
+
+   // orders event indices by one variable
+   struct kNNVarLess
+   {
+      const TMVA::kNN::VarType *var;
+      UInt_t dimn;
+      UInt_t ivar;
+      bool operator()(UInt_t a, UInt_t b) const { return var[a*dimn + ivar] < var[b*dimn + ivar]; }
+   };
+
+   // candidate neighbor: distance and position in the flat tree
+   typedef std::pair<TMVA::kNN::VarType, UInt_t> kNNCandidate;
+
+   void kNNFlatBuildNode(const kNNFlatBuild &build, UInt_t first, UInt_t last, UInt_t nthreads);
+
+   //-------------------------------------------------------------------------------------------
+   void* kNNFlatBuildWorker(void *arg)
+   {
+      // thread function building the subtree of a task
+      const kNNFlatBuildTask *task = (const kNNFlatBuildTask *) arg;
+      kNNFlatBuildNode(*task->build, task->first, task->last, task->nthreads);
+      return 0;
+   }
+
+   //-------------------------------------------------------------------------------------------
+   void kNNFlatBuildNode(const kNNFlatBuild &build, const UInt_t first, const UInt_t last, const UInt_t nthreads)
+   {
+      // build the subtree of the events first..last-1: split at the median of
+      // the variable with the largest spread and build both halves, large
+      // subtrees in parallel threads if more than one thread is given
+
+      if (last <= first) {
+         return;
+      }
+      if (last - first == 1) {
+         build.split[first] = 0;
+         return;
+      }
+
+      UInt_t ivar = 0;
+      TMVA::kNN::VarType max_width = -1.0;
+      for (UInt_t d = 0; d < build.dimn; ++d) {
+         TMVA::kNN::VarType vmin = build.var[build.event[first]*build.dimn + d];
+         TMVA::kNN::VarType vmax = vmin;
+         for (UInt_t i = first + 1; i < last; ++i) {
+            const TMVA::kNN::VarType value = build.var[build.event[i]*build.dimn + d];
+            if (value < vmin) vmin = value;
+            if (value > vmax) vmax = value;
+         }
+         if (vmax - vmin > max_width) {
+            max_width = vmax - vmin;
+            ivar = d;
+         }
+      }
+
+      const UInt_t median = (first + last)/2;
+      kNNVarLess less;
+      less.var  = build.var;
+      less.dimn = build.dimn;
+      less.ivar = ivar;
+      std::nth_element(build.event + first, build.event + median, build.event + last, less);
+      build.split[median] = ivar;
+
+#ifndef _WIN32
+      // threads are only worth their start-up cost for large subtrees
+      if (nthreads > 1 && last - first > 10000) {
+         kNNFlatBuildTask task;
+         task.build    = &build;
+         task.first    = first;
+         task.last     = median;
+         task.nthreads = nthreads/2;
+
+         pthread_t thread;
+         const Bool_t started = (pthread_create(&thread, 0, kNNFlatBuildWorker, &task) == 0);
+         if (!started) kNNFlatBuildWorker(&task);
+
+         kNNFlatBuildNode(build, median + 1, last, nthreads - nthreads/2);
+
+         if (started) pthread_join(thread, 0);
+         return;
+      }
+#endif
+
+      kNNFlatBuildNode(build, first, median, nthreads);
+      kNNFlatBuildNode(build, median + 1, last, nthreads);
+   }
+
+   //-------------------------------------------------------------------------------------------
+   void kNNFlatSearch(const kNNFlatTree &tree, const TMVA::kNN::VarType *query,
+                      const UInt_t first, const UInt_t last, const UInt_t nfind,
+                      std::priority_queue<kNNCandidate> &queue)
+   {
+      // search the subtree of the events first..last-1 for the nfind nearest
+      // neighbors, the queue keeps the nfind closest candidates found so far
+      // with the farthest on top. The far subtree is skipped if the distance
+      // to the splitting plane exceeds the farthest candidate.
+
+      if (last <= first) {
+         return;
+      }
+
+      const UInt_t node = (first + last)/2;
+      const TMVA::kNN::VarType *var = tree.var + node*tree.dimn;
+
+      // same arithmetic as kNN::Event::GetDist
+      TMVA::kNN::VarType distance = 0.0;
+      for (UInt_t ivar = 0; ivar < tree.dimn; ++ivar) {
+         distance += (var[ivar] - query[ivar])*(var[ivar] - query[ivar]);
+      }
+
+      const kNNCandidate candidate(distance, node);
+      if (queue.size() < nfind) {
+         queue.push(candidate);
+      }
+      else if (candidate < queue.top()) {
+         queue.pop();
+         queue.push(candidate);
+      }
+
+      const UInt_t ivar = tree.split[node];
+      const TMVA::kNN::VarType diff = query[ivar] - var[ivar];
+
+      if (diff < 0.0) {
+         kNNFlatSearch(tree, query, first, node, nfind, queue);
+         if (queue.size() < nfind || !(diff*diff > queue.top().first)) {
+            kNNFlatSearch(tree, query, node + 1, last, nfind, queue);
+         }
+      }
+      else {
+         kNNFlatSearch(tree, query, node + 1, last, nfind, queue);
+         if (queue.size() < nfind || !(diff*diff > queue.top().first)) {
+            kNNFlatSearch(tree, query, first, node, nfind, queue);
+         }
+      }
+   }
+
+   //-------------------------------------------------------------------------------------------
+   void kNNFlatFind(const kNNFlatTree &tree, UInt_t nevents, const TMVA::kNN::VarType *query,
+                    const UInt_t nfind, TMVA::kNN::List &nlist)
+   {
+      // fill the nfind nearest neighbors of the query point into the list,
+      // ordered by increasing distance
 
+      std::priority_queue<kNNCandidate> queue;
+      kNNFlatSearch(tree, query, 0, nevents, nfind, queue);
 
+      std::vector<kNNCandidate> found(queue.size());
+      for (UInt_t i = found.size(); i > 0; --i) {
+         found[i - 1] = queue.top();
+         queue.pop();
+      }
+
+      nlist.clear();
+      for (UInt_t i = 0; i < found.size(); ++i) {
+         const TMVA::kNN::Node<TMVA::kNN::Event> *node = tree.node[tree.event[found[i].second]];
+         nlist.push_back(TMVA::kNN::Elem(node, found[i].first));
+      }
+   }
+
+   // search for the neighbors of a block of query points
+   struct kNNFindTask
+   {
+      const kNNFlatTree *tree;
+      UInt_t nevents;                  // number of events of the tree
+      const TMVA::kNN::VarType *query; // variables of the query points, point by point
+      UInt_t nfind;
+      TMVA::kNN::List *results;
+      UInt_t first;
+      UInt_t last;
+   };
+
+   //-------------------------------------------------------------------------------------------
+   void* kNNFindWorker(void *arg)
+   {
+      // thread function searching the neighbors of the query points of a task
+      const kNNFindTask *task = (const kNNFindTask *) arg;
+      for (UInt_t i = task->first; i < task->last; ++i) {
+         kNNFlatFind(*task->tree, task->nevents, task->query + i*task->tree->dimn, task->nfind, task->results[i]);
+      }
+      return 0;
+   }
+}
 
 TRandom3 TMVA::kNN::ModulekNN::fgRndm(1);
 
@@ -159,6 +374,8 @@ TRandom3 TMVA::kNN::ModulekNN::fgRndm(1);
 TMVA::kNN::ModulekNN::ModulekNN()
    :fDimn(0),
     fTree(0),
+    fODepth(0),
+    fNThreads(1),
     fLogger( new MsgLogger("ModulekNN") )
 {
    // default constructor
@@ -168,9 +385,7 @@ TMVA::kNN::ModulekNN::ModulekNN()
 TMVA::kNN::ModulekNN::~ModulekNN()
 {
    // destructor
-   if (fTree) {
-      delete fTree; fTree = 0;
-   }
+   Clear();
    delete fLogger;
 }
 
@@ -185,6 +400,14 @@ void TMVA::kNN::ModulekNN::Clear()
       fTree = 0;
    }
 
+   for (std::vector<Node<Event> *>::iterator nit = fNode.begin(); nit != fNode.end(); ++nit) {
+      delete *nit;
+   }
+   fNode.clear();
+   fFlatVar.clear();
+   fFlatEvent.clear();
+   fFlatSplit.clear();
+
    fVarScale.clear();
    fCount.clear();
    fEvent.clear();
@@ -195,7 +418,7 @@ void TMVA::kNN::ModulekNN::Clear()
 void TMVA::kNN::ModulekNN::Add(const Event &event)
 {   
    // add an event to tree
-   if (fTree) {
+   if (!fNode.empty()) {
       Log() << kFATAL << "<Add> Cannot add event: tree is already built" << Endl;
       return;      
    }
@@ -227,7 +450,7 @@ void TMVA::kNN::ModulekNN::Add(const Event &event)
 Bool_t TMVA::kNN::ModulekNN::Fill(const UShort_t odepth, const UInt_t ifrac, const std::string &option)
 {
    // fill the tree
-   if (fTree) {
+   if (!fNode.empty()) {
       Log() << kFATAL << "ModulekNN::Fill - tree has already been created" << Endl;
       return kFALSE;
    }   
@@ -291,20 +514,18 @@ Bool_t TMVA::kNN::ModulekNN::Fill(const UShort_t odepth, const UInt_t ifrac, con
       }
    }
 
-   // If odepth > 0 then fill first odepth levels
-   // with empty nodes that split separating variable in half for
-   // all child nodes. If odepth = 0 then split variable 0
-   // at the median (in half) and return it as root node
-   fTree = Optimize(odepth);
-   
-   if (!fTree) {
+   if (fEvent.empty()) {
       Log() << kFATAL << "ModulekNN::Fill() - failed to create tree" << Endl;
       return kFALSE;      
-   }      
+   }
+
+   // The searches counting events use a flat kd-tree, built in parallel.
+   // The linked kd-tree, needed only by the searches with option "weight",
+   // is created at the first such search with balance depth odepth
+   fODepth = odepth;
+   MakeFlatTree();
    
    for (EventVec::const_iterator event = fEvent.begin(); event != fEvent.end(); ++event) {
-      fTree->Add(*event, 0);
-      
       std::map<Short_t, UInt_t>::iterator cit = fCount.find(event->GetType());
       if (cit == fCount.end()) {
          fCount[event->GetType()] = 1;
@@ -330,7 +551,7 @@ Bool_t TMVA::kNN::ModulekNN::Find(Event event, const UInt_t nfind, const std::st
    // if metic (fVarScale map) is computed then rescale event variables
    // using previsouly computed width of variable distribution
 
-   if (!fTree) {
+   if (fNode.empty()) {
       Log() << kFATAL << "ModulekNN::Find() - tree has not been filled" << Endl;
       return kFALSE;
    }
@@ -355,6 +576,13 @@ Bool_t TMVA::kNN::ModulekNN::Find(Event event, const UInt_t nfind, const std::st
    
    if(option.find("weight") != std::string::npos)
    {
+      if (!fTree) {
+         MakeTree();
+      }
+      if (!fTree) {
+         return kFALSE;
+      }
+
       // recursive kd-tree search for nfind-nearest neighbors
       // use event weight to find all nearest events
       // that have sum of weights >= nfind
@@ -362,9 +590,16 @@ Bool_t TMVA::kNN::ModulekNN::Find(Event event, const UInt_t nfind, const std::st
    }
    else
    {
-      // recursive kd-tree search for nfind-nearest neighbors
+      // flat kd-tree search for nfind-nearest neighbors
       // count nodes and do not use event weight
-      kNN::Find<kNN::Event>(fkNNList, fTree, event, nfind);      
+      kNNFlatTree tree;
+      tree.var   = fFlatVar.empty() ? 0 : &fFlatVar[0];
+      tree.split = fFlatSplit.empty() ? 0 : &fFlatSplit[0];
+      tree.event = fFlatEvent.empty() ? 0 : &fFlatEvent[0];
+      tree.node  = &fNode[0];
+      tree.dimn  = fDimn;
+
+      kNNFlatFind(tree, fFlatEvent.size(), &(event.GetVars()[0]), nfind, fkNNList);
    }
 
    return kTRUE;
@@ -374,7 +609,7 @@ Bool_t TMVA::kNN::ModulekNN::Find(Event event, const UInt_t nfind, const std::st
 Bool_t TMVA::kNN::ModulekNN::Find(const UInt_t nfind, const std::string &option) const
 {
    // find in tree
-   if (fCount.empty() || !fTree) {
+   if (fCount.empty() || fNode.empty()) {
       return kFALSE;
    }
    
@@ -424,7 +659,92 @@ Bool_t TMVA::kNN::ModulekNN::Find(const UInt_t nfind, const std::string &option)
 }
 
 //-------------------------------------------------------------------------------------------
-TMVA::kNN::Node<TMVA::kNN::Event>* TMVA::kNN::ModulekNN::Optimize(const UInt_t odepth)
+Bool_t TMVA::kNN::ModulekNN::Find(const EventVec &events, const UInt_t nfind, std::vector<List> &results) const
+{
+   // find in tree
+   // search for the nfind closest events of each event, counting events as
+   // with option "count" of the search for a single event, and store them in
+   // results. The events are distributed over the threads set with SetNThreads.
+   // GetkNNList and GetkNNEvent are not changed, so that several threads can
+   // search at the same time
+
+   results.clear();
+
+   if (fNode.empty()) {
+      Log() << kFATAL << "ModulekNN::Find() - tree has not been filled" << Endl;
+      return kFALSE;
+   }
+   if (nfind < 1) {
+      Log() << kFATAL << "ModulekNN::Find() - requested 0 nearest neighbors" << Endl;
+      return kFALSE;
+   }
+
+   const UInt_t nquery = events.size();
+
+   // rescale the variables of the events as in the tree
+   std::vector<VarType> query(nquery*fDimn, 0.0);
+   for (UInt_t i = 0; i < nquery; ++i) {
+      if (fDimn != events[i].GetNVar()) {
+         Log() << kFATAL << "ModulekNN::Find() - number of dimension does not match training events" << Endl;
+         return kFALSE;
+      }
+
+      const Event event = (fVarScale.empty() ? events[i] : Scale(events[i]));
+      for (UInt_t ivar = 0; ivar < fDimn; ++ivar) {
+         query[i*fDimn + ivar] = event.GetVar(ivar);
+      }
+   }
+
+   results.resize(nquery);
+   if (nquery == 0) {
+      return kTRUE;
+   }
+
+   kNNFlatTree tree;
+   tree.var   = fFlatVar.empty() ? 0 : &fFlatVar[0];
+   tree.split = fFlatSplit.empty() ? 0 : &fFlatSplit[0];
+   tree.event = fFlatEvent.empty() ? 0 : &fFlatEvent[0];
+   tree.node  = &fNode[0];
+   tree.dimn  = fDimn;
+
+   const UInt_t nthreads = std::min(fNThreads, nquery);
+
+   // distribute the events in contiguous blocks over the threads, the
+   // last block is searched in the calling thread
+   std::vector<kNNFindTask> tasks(nthreads);
+   for (UInt_t i = 0; i < nthreads; ++i) {
+      tasks[i].tree    = &tree;
+      tasks[i].nevents = fFlatEvent.size();
+      tasks[i].query   = &query[0];
+      tasks[i].nfind   = nfind;
+      tasks[i].results = &results[0];
+      tasks[i].first   = (i*nquery)/nthreads;
+      tasks[i].last    = ((i + 1)*nquery)/nthreads;
+   }
+
+#ifndef _WIN32
+   std::vector<pthread_t> threads(nthreads);
+   std::vector<Bool_t> started(nthreads, kFALSE);
+   for (UInt_t i = 0; i < nthreads; ++i) {
+      if (i + 1 < nthreads) {
+         started[i] = (pthread_create(&threads[i], 0, kNNFindWorker, &tasks[i]) == 0);
+      }
+      if (!started[i]) kNNFindWorker(&tasks[i]);
+   }
+   for (UInt_t i = 0; i < nthreads; ++i) {
+      if (started[i]) pthread_join(threads[i], 0);
+   }
+#else
+   for (UInt_t i = 0; i < nthreads; ++i) {
+      kNNFindWorker(&tasks[i]);
+   }
+#endif
+
+   return kTRUE;
+}
+
+//-------------------------------------------------------------------------------------------
+TMVA::kNN::Node<TMVA::kNN::Event>* TMVA::kNN::ModulekNN::Optimize(const UInt_t odepth) const
 {
    // Optimize() balances binary tree for first odepth levels
    // for each depth we split sorted depth % dimension variables
@@ -515,6 +835,74 @@ TMVA::kNN::Node<TMVA::kNN::Event>* TMVA::kNN::ModulekNN::Optimize(const UInt_t o
    return tree;
 }
 
+//-------------------------------------------------------------------------------------------
+void TMVA::kNN::ModulekNN::MakeTree() const
+{
+   // create the linked kd-tree used by the search with option "weight":
+   // if fODepth > 0 then fill first fODepth levels with empty nodes that
+   // split separating variable in half for all child nodes, if fODepth = 0
+   // then split variable 0 at the median (in half) and return it as root
+   // node, then add all events
+
+   fTree = Optimize(fODepth);
+   
+   if (!fTree) {
+      Log() << kFATAL << "ModulekNN::MakeTree() - failed to create tree" << Endl;
+      return;
+   }      
+   
+   for (EventVec::const_iterator event = fEvent.begin(); event != fEvent.end(); ++event) {
+      fTree->Add(*event, 0);
+   }
+}
+
+//-------------------------------------------------------------------------------------------
+void TMVA::kNN::ModulekNN::MakeFlatTree()
+{
+   // create one node for each event (not linked to other nodes) and the
+   // flat kd-tree of the events with positive weight: the events are stored
+   // contiguously in tree order, the node of the events first..last-1 is the
+   // event (first+last)/2 (the median of the variable with the largest spread)
+   // with the events before it on the left and after it on the right side.
+   // Large subtrees are built in parallel threads
+
+   fNode.reserve(fEvent.size());
+   for (EventVec::const_iterator event = fEvent.begin(); event != fEvent.end(); ++event) {
+      fNode.push_back(new Node<Event>(0, *event, 0));
+   }
+
+   std::vector<VarType> var(fEvent.size()*fDimn, 0.0);
+   for (UInt_t ievent = 0; ievent < fEvent.size(); ++ievent) {
+      for (UInt_t ivar = 0; ivar < fDimn; ++ivar) {
+         var[ievent*fDimn + ivar] = fEvent[ievent].GetVar(ivar);
+      }
+      // only events with positive weights are returned by the search
+      if (fEvent[ievent].GetWeight() > 0.0) {
+         fFlatEvent.push_back(ievent);
+      }
+   }
+
+   const UInt_t nevents = fFlatEvent.size();
+   fFlatSplit.assign(nevents, 0);
+
+   if (nevents > 0) {
+      kNNFlatBuild build;
+      build.var   = &var[0];
+      build.event = &fFlatEvent[0];
+      build.split = &fFlatSplit[0];
+      build.dimn  = fDimn;
+
+      kNNFlatBuildNode(build, 0, nevents, fNThreads);
+   }
+
+   fFlatVar.resize(nevents*fDimn);
+   for (UInt_t i = 0; i < nevents; ++i) {
+      for (UInt_t ivar = 0; ivar < fDimn; ++ivar) {
+         fFlatVar[i*fDimn + ivar] = var[fFlatEvent[i]*fDimn + ivar];
+      }
+   }
+}
+
 //-------------------------------------------------------------------------------------------
 void TMVA::kNN::ModulekNN::ComputeMetric(const UInt_t ifrac)
 {
@@ -24,11 +24,18 @@
 
 #include <limits>
 #include <cstdlib>
+#include <cstdio>
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
 #include "TMath.h"
 #include "TGraph.h"
 #include "TH1.h"
 #include "TH2.h"
 #include "TDirectory.h"
+#include "TROOT.h"
+#include "TSystem.h"
 
 #include "TMVA/IMethod.h"   
 #include "TMVA/MethodBase.h"   
@@ -38,6 +45,8 @@
 #include "TMVA/PDF.h"   
 #include "TMVA/MsgLogger.h"
 #include "TMVA/Tools.h"   
+#include "TMVA/Config.h"
+#include "TMVA/Factory.h"
 
 ClassImp(TMVA::OptimizeConfigParameters)
    
@@ -183,12 +192,30 @@ void TMVA::OptimizeConfigParameters::optimizeScan()
     }
    //loop on the total number of differnt combinations
    
+   std::vector< std::map<TString,Double_t> > settings;
    for (int i=0; i<Ntot; i++){
        UInt_t index=0;
       std::vector<int> indices = GetScanIndices(i, Nindividual );
       for (it=fTuneParameters.begin(), index=0; index< indices.size(); index++, it++){
          currentParameters[it->first] = v[index][indices[index]];
       }
+      settings.push_back(currentParameters);
+   }
+
+   // evaluate the settings in parallel processes if requested, the
+   // settings for which this failed are evaluated below
+   std::vector<Double_t> jobFOM(Ntot,0);
+   std::vector<Bool_t>   jobDone(Ntot,kFALSE);
+   Bool_t transformationsDone = kFALSE;
+   if (gConfig().NJobs() > 1 && Ntot > 1) {
+      GetMethod()->BaseDir()->cd();
+      GetMethod()->GetTransformationHandler().CalcTransformations(GetMethod()->Data()->GetEventCollection());
+      transformationsDone = kTRUE;
+      ScanInJobs(settings, jobFOM, jobDone);
+   }
+
+   for (int i=0; i<Ntot; i++){
+      currentParameters = settings[i];
       Log() << kINFO << "--------------------------" << Endl;
       Log() << kINFO <<"Settings being evaluated:" << Endl;
       for (std::map<TString,Double_t>::iterator it_print=currentParameters.begin(); 
@@ -196,16 +223,22 @@ void TMVA::OptimizeConfigParameters::optimizeScan()
          Log() << kINFO << "  " << it_print->first  << " = " << it_print->second << Endl;
        }
 
-      GetMethod()->Reset();
-      GetMethod()->SetTuneParameters(currentParameters);
-      // now do the training for the current parameters:
-      GetMethod()->BaseDir()->cd();
-      if (i==0) GetMethod()->GetTransformationHandler().CalcTransformations(
+      if (jobDone[i]) {
+         currentFOM = jobFOM[i];
+         fFOMvsIter.push_back(currentFOM);
+      } else {
+         GetMethod()->Reset();
+         GetMethod()->SetTuneParameters(currentParameters);
+         // now do the training for the current parameters:
+         GetMethod()->BaseDir()->cd();
+         if (!transformationsDone) GetMethod()->GetTransformationHandler().CalcTransformations(
                                                                   GetMethod()->Data()->GetEventCollection());
-      Event::fIsTraining = kTRUE;
-      GetMethod()->Train();
-      Event::fIsTraining = kFALSE;
-      currentFOM = GetFOM(); 
+         transformationsDone = kTRUE;
+         Event::fIsTraining = kTRUE;
+         GetMethod()->Train();
+         Event::fIsTraining = kFALSE;
+         currentFOM = GetFOM(); 
+      }
       Log() << kINFO << "FOM was found : " << currentFOM << "; current best is " << bestFOM << Endl;
       
       if (currentFOM > bestFOM) {
@@ -221,6 +254,80 @@ void TMVA::OptimizeConfigParameters::optimizeScan()
    GetMethod()->SetTuneParameters(fTunedParameters);
 }
 
+//_______________________________________________________________________
+void TMVA::OptimizeConfigParameters::ScanInJobs( const std::vector< std::map<TString,Double_t> >& settings,
+                                                 std::vector<Double_t>& fom, std::vector<Bool_t>& done )
+{
+   // evaluate the FOM of the given parameter settings in up to NJobs forked
+   // processes at a time (each process trains the method with one setting
+   // and sends back the FOM through a pipe); done[i] is set for the
+   // settings that could be evaluated
+
+#ifndef _WIN32
+   const UInt_t nJobs = gConfig().NJobs();
+   const UInt_t ntot  = settings.size();
+   Log() << kINFO << "Evaluate " << ntot << " parameter settings in up to " << nJobs << " parallel processes" << Endl;
+
+   std::vector<pid_t> pid(ntot,-1);
+   std::vector<int>   fd(ntot,-1);
+   UInt_t nextToWait = 0;
+
+   for (UInt_t i=0; i<=ntot; i++) {
+
+      // collect the oldest running process if all slots are taken (and
+      // all of them at the end)
+      while (nextToWait < i && (i == ntot || i-nextToWait >= nJobs)) {
+         if (pid[nextToWait] > 0) {
+            Double_t value = 0;
+            Bool_t   ok    = (read(fd[nextToWait], &value, sizeof(value)) == (ssize_t)sizeof(value));
+            close(fd[nextToWait]);
+            int status = 0;
+            if (waitpid(pid[nextToWait], &status, 0) != pid[nextToWait] || !WIFEXITED(status) || WEXITSTATUS(status) != 0) ok = kFALSE;
+            fom[nextToWait]  = value;
+            done[nextToWait] = ok;
+         }
+         nextToWait++;
+      }
+      if (i == ntot) break;
+
+      int p[2];
+      if (pipe(p) != 0) continue;
+
+      // flush the output buffers, otherwise they are written twice
+      std::cout << std::flush;
+      fflush(0);
+
+      pid[i] = fork();
+      if (pid[i] == 0) {
+         // the evaluating process: its output is discarded (failed settings
+         // are evaluated again by the parent), the target file of the
+         // parent must not be closed by the exit handlers of ROOT
+         close(p[0]);
+         gROOT->GetListOfFiles()->Remove(Factory::RootBaseDir());
+         gSystem->RedirectOutput("/dev/null", "w");
+         gConfig().SetDrawProgressBar(kFALSE);
+         GetMethod()->Reset();
+         GetMethod()->SetTuneParameters(settings[i]);
+         GetMethod()->BaseDir()->cd();
+         Event::fIsTraining = kTRUE;
+         GetMethod()->Train();
+         Event::fIsTraining = kFALSE;
+         Double_t value = GetFOM();
+         int status = (write(p[1], &value, sizeof(value)) == (ssize_t)sizeof(value)) ? 0 : 1;
+         close(p[1]);
+         _exit(status);
+      }
+      close(p[1]);
+      if (pid[i] < 0) close(p[0]);
+      else            fd[i] = p[0];
+   }
+#else
+   Log() << kWARNING << "Parallel processes are not available on this platform"
+         << " --> parameter settings are evaluated sequentially" << Endl;
+#endif
+}
+
+//_______________________________________________________________________
 void TMVA::OptimizeConfigParameters::optimizeFit()
 {
    // ranges (intervals) in which the fit varies the parameters
@@ -72,6 +72,10 @@
 #include <cassert>
 #include <limits>
 
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
 #include "TMVA/Event.h"
 #include "TMVA/Tools.h"
 #include "TMVA/PDEFoam.h"
@@ -137,7 +141,8 @@ TMVA::PDEFoam::PDEFoam() :
    fDistr(NULL),
    fTimer(new Timer(0, "PDEFoam", kTRUE)),
    fVariableNames(new TObjArray()),
-   fLogger(new MsgLogger("PDEFoam"))
+   fLogger(new MsgLogger("PDEFoam")),
+   fNThreads(1)
 {
    // Default constructor for streamer, user should not use it.
 
@@ -176,7 +181,8 @@ TMVA::PDEFoam::PDEFoam(const TString& name) :
    fDistr(NULL),
    fTimer(new Timer(1, "PDEFoam", kTRUE)),
    fVariableNames(new TObjArray()),
-   fLogger(new MsgLogger("PDEFoam"))
+   fLogger(new MsgLogger("PDEFoam")),
+   fNThreads(1)
 {
    // User constructor, to be employed by the user
    if(strlen(name) > 128)
@@ -243,6 +249,7 @@ TMVA::PDEFoam::PDEFoam(const PDEFoam &from) :
    , fTimer(0)
    , fVariableNames(0)
    , fLogger(new MsgLogger(*from.fLogger))
+   , fNThreads(1)
 {
    // Copy Constructor  NOT IMPLEMENTED (NEVER USED)
    Log() << kFATAL << "COPY CONSTRUCTOR NOT IMPLEMENTED" << Endl;
@@ -352,8 +359,31 @@ void TMVA::PDEFoam::Create()
 
    // prepare PDEFoam for the filling with events
    ResetCellElements(); // reset all cell elements
+
+   // cache the division points for the cell search
+   BuildCellSplits();
 } // Create
 
+//_____________________________________________________________________
+void TMVA::PDEFoam::BuildCellSplits()
+{
+   // Cache the division point (upper edge of the first daughter) of
+   // every divided cell, as PDEFoamCell::GetHcub() has to walk up the
+   // cell tree to the root cell.  This is done after the foam is grown
+   // and after it is read from a file, so that FindCell() only reads
+   // the cache and can be called by several threads at once.
+
+   fCellSplit.assign(fLastCe+1, 0.0);
+   PDEFoamVect  cellPosi0(GetTotDim()), cellSize0(GetTotDim());
+   for (Long_t iCell=0; iCell<=fLastCe; iCell++) {
+      PDEFoamCell *cell=fCells[iCell];
+      if (cell->GetStat()==1) continue;
+      Int_t idim=cell->GetBest();
+      cell->GetDau0()->GetHcub(cellPosi0,cellSize0);
+      fCellSplit[iCell]=cellPosi0[idim]+cellSize0[idim];
+   }
+}
+
 //_____________________________________________________________________
 void TMVA::PDEFoam::InitCells()
 {
@@ -484,14 +514,37 @@ void TMVA::PDEFoam::Explore(PDEFoamCell *cell)
 
    for (i=0;i<fDim;i++) ((TH1D *)(*fHistEdg)[i])->Reset(); // Reset histograms
 
+   // With several threads the distribution is evaluated for batches
+   // of MC points in parallel.  The points are drawn and processed
+   // in the same order as in the serial loop and the random
+   // generator is reset to its serial state after an early exit,
+   // such that the foam does not depend on the number of threads.
+   const Long_t nBatch = (fNThreads>1 && fDim>0) ? 16*fNThreads : 0;
+   std::vector<Double_t> batchAlpha, batchWt, batchDensity;
+   TRandom3 batchRan;
+   Long_t ibatch = 0, batchSize = 0;
+
    Double_t nevEff=0.;
    // ||||||||||||||||||||||||||BEGIN MC LOOP|||||||||||||||||||||||||||||
    for (iev=0;iev<fNSampl;iev++){
-      MakeAlpha();               // generate uniformly vector inside hypercube
+      if (nBatch>0) {
+         if (ibatch==batchSize) {
+            batchRan  = *fPseRan; // generator state at the begin of the batch
+            batchSize = TMath::Min(nBatch, fNSampl-iev);
+            EvalBatch(cellPosi, cellSize, dx, batchSize, batchAlpha, batchWt, batchDensity);
+            ibatch = 0;
+         }
+         for (j=0; j<fDim; j++) fAlpha[j] = batchAlpha[ibatch*fDim+j];
+         wt            = batchWt[ibatch];
+         event_density = batchDensity[ibatch];
+         ibatch++;
+      } else {
+         MakeAlpha();               // generate uniformly vector inside hypercube
 
-      if (fDim>0) for (j=0; j<fDim; j++) xRand[j]= cellPosi[j] +fAlpha[j]*(cellSize[j]);
+         if (fDim>0) for (j=0; j<fDim; j++) xRand[j]= cellPosi[j] +fAlpha[j]*(cellSize[j]);
 
-      wt         = dx*Eval(xRand, event_density);
+         wt         = dx*Eval(xRand, event_density);
+      }
       totevents += event_density;
 
       nProj = 0;
@@ -512,6 +565,11 @@ void TMVA::PDEFoam::Explore(PDEFoamCell *cell)
       nevEff = ceSum[0]*ceSum[0]/ceSum[1];
       if ( nevEff >= fNBin*fEvPerBin) break;
    }   // ||||||||||||||||||||||||||END MC LOOP|||||||||||||||||||||||||||||
+   if (ibatch<batchSize) {
+      // discard the random numbers of the unused points of the batch
+      *fPseRan = batchRan;
+      for (Long_t ib=0; ib<ibatch; ib++) MakeAlpha();
+   }
    totevents *= dx;
    totevents /= fNSampl;
 
@@ -757,6 +815,96 @@ Double_t TMVA::PDEFoam::Eval(Double_t *xRand, Double_t &event_density)
    return GetDistr()->Density(xvec, event_density);
 }
 
+//_____________________________________________________________________
+namespace {
+   // MC points of one thread in TMVA::PDEFoam::EvalBatch()
+   struct PDEFoamEvalTask {
+      TMVA::PDEFoamDensityBase* distr;
+      const Double_t* xvec; // [n*dim] points in [fXmin,fXmax]
+      Double_t* wt;         // [n] weights
+      Double_t* density;    // [n] event densities
+      Int_t     n;
+      Double_t  dx;         // cell volume
+   };
+}
+
+//_____________________________________________________________________
+void* TMVA::PDEFoam::EvalBatchWorker(void* arg)
+{
+   // evaluate the distribution for the points of one task of EvalBatch()
+
+   PDEFoamEvalTask* task = static_cast<PDEFoamEvalTask*>(arg);
+   task->distr->DensityBatch(task->n, task->xvec, task->wt, task->density);
+   for (Int_t i=0; i<task->n; i++)
+      task->wt[i] = task->dx*task->wt[i];
+   return 0;
+}
+
+//_____________________________________________________________________
+void TMVA::PDEFoam::EvalBatch(PDEFoamVect &cellPosi, PDEFoamVect &cellSize, Double_t dx, Int_t n,
+                              std::vector<Double_t> &alpha, std::vector<Double_t> &wt,
+                              std::vector<Double_t> &density)
+{
+   // Internal subprogram used by Explore.
+   // Draws n random points inside the cell given by 'cellPosi' and
+   // 'cellSize' and evaluates the (training) distribution for them in
+   // fNThreads parallel threads.  The random parameters of the
+   // points are stored in 'alpha' (fDim per point), the weights
+   // dx*Eval() in 'wt' and the event densities in 'density'.
+   //
+   // Each thread evaluates its points with one call of
+   // PDEFoamDensityBase::DensityBatch(), which searches the events of
+   // all points in one traversal of the search tree.  The density
+   // only reads its search tree during the evaluation, the tree and
+   // the box volume are built before the threads are started.
+
+   alpha.resize(n*fDim);
+   wt.resize(n);
+   density.resize(n);
+
+   // transform the points, like in Eval(): [0, 1] --> [xmin, xmax]
+   std::vector<Double_t> xvec(n*fDim);
+   for (Int_t i=0; i<n; i++) {
+      MakeAlpha();
+      for (Int_t j=0; j<fDim; j++) {
+         alpha[i*fDim+j] = fAlpha[j];
+         xvec[i*fDim+j]  = VarTransformInvers(j, cellPosi[j] + fAlpha[j]*cellSize[j]);
+      }
+   }
+   if (n<1) return;
+
+   GetDistr()->BuildTree();
+
+   // distribute the points in contiguous blocks over the threads,
+   // the last block is evaluated in the calling thread
+   UInt_t nThreads = TMath::Max(TMath::Min(fNThreads, UInt_t(n)), UInt_t(1));
+   std::vector<PDEFoamEvalTask> tasks(nThreads);
+   for (UInt_t i=0; i<nThreads; i++) {
+      Int_t first = (i*n)/nThreads;
+      Int_t last  = ((i+1)*n)/nThreads;
+      tasks[i].distr   = GetDistr();
+      tasks[i].xvec    = &xvec[first*fDim];
+      tasks[i].wt      = &wt[first];
+      tasks[i].density = &density[first];
+      tasks[i].n       = last-first;
+      tasks[i].dx      = dx;
+   }
+#ifndef _WIN32
+   std::vector<pthread_t> threads(nThreads);
+   std::vector<Bool_t> started(nThreads, kFALSE);
+   for (UInt_t i=0; i<nThreads; i++) {
+      if (i<nThreads-1)
+         started[i] = (pthread_create(&threads[i],0,EvalBatchWorker,&tasks[i])==0);
+      if (!started[i]) EvalBatchWorker(&tasks[i]);
+   }
+   for (UInt_t i=0; i<nThreads; i++) {
+      if (started[i]) pthread_join(threads[i],0);
+   }
+#else
+   for (UInt_t i=0; i<nThreads; i++) EvalBatchWorker(&tasks[i]);
+#endif
+}
+
 //_____________________________________________________________________
 void TMVA::PDEFoam::Grow()
 {
@@ -1077,11 +1225,25 @@ TMVA::PDEFoamCell* TMVA::PDEFoam::FindCell( const std::vector<Float_t> &xvec ) c
    //
    // PDEFoam cell corresponding to 'xvec'
 
-   PDEFoamVect  cellPosi0(GetTotDim()), cellSize0(GetTotDim());
    PDEFoamCell *cell, *cell0;
 
    cell=fCells[0]; // start with root cell
    Int_t idim=0;
+
+   // use the division points cached by BuildCellSplits(), if they are
+   // up to date
+   if (Long_t(fCellSplit.size())==Long_t(fLastCe)+1) {
+      while (cell->GetStat()!=1) { //go down binary tree until cell is found
+         idim=cell->GetBest();  // dimension that changed
+         if (xvec.at(idim)<=fCellSplit[cell->GetSerial()])
+            cell=cell->GetDau0();
+         else
+            cell=(cell->GetDau1());
+      }
+      return cell;
+   }
+
+   PDEFoamVect  cellPosi0(GetTotDim()), cellSize0(GetTotDim());
    while (cell->GetStat()!=1) { //go down binary tree until cell is found
       idim=cell->GetBest();  // dimension that changed
       cell0=cell->GetDau0();
@@ -1659,7 +1821,7 @@ void TMVA::PDEFoam::FillBinarySearchTree( const Event* ev )
 //_____________________________________________________________________
 void TMVA::PDEFoam::DeleteBinarySearchTree()
 {
-   // Delete the foam's density estimator, which contains the binary
+   // Delete the foam's density estimator, which contains the
    // search tree.
    if(fDistr) delete fDistr;
    fDistr = NULL;
@@ -151,7 +151,7 @@ void TMVA::PDEFoamDecisionTree::Explore(PDEFoamCell *cell)
       Log() << kFATAL << "<PDEFoamDecisionTree::Explore>: cast failed: "
             << "PDEFoamDensityBase* --> PDEFoamDecisionTreeDensity*" << Endl;
 
-   // create TMVA::Volume object needed for searching within the BST
+   // create TMVA::Volume object needed for searching within the search tree
    TMVA::Volume volume(&lb, &ub);
 
    // fill the signal and background histograms for the given volume
@@ -102,6 +102,9 @@ void TMVA::PDEFoamDecisionTreeDensity::FillHistograms(TMVA::Volume &volume, std:
    //   unweighted signal and background events
 
    // sanity check
+   if (volume.fLower->size() != GetBox().size()
+       || volume.fUpper->size() != GetBox().size())
+      Log() << kFATAL << "<PDEFoamDistr::FillHistograms> Volume has wrong dimension!" << Endl;
    if (hsig.size() != volume.fLower->size()
        || hbkg.size() != volume.fLower->size()
        || hsig_unw.size() != volume.fLower->size()
@@ -115,21 +118,22 @@ void TMVA::PDEFoamDecisionTreeDensity::FillHistograms(TMVA::Volume &volume, std:
          Log() << kFATAL << "<PDEFoamDistr::FillHist> Histograms not initialized!" << Endl;
    }
 
-   // BST nodes found in volume
-   std::vector<const TMVA::BinarySearchTreeNode*> nodes;
+   // events found in volume
+   std::vector< std::vector<UInt_t> > found;
 
    // do range searching
-   fBst->SearchVolume(&volume, &nodes);
+   BuildTree();
+   SearchVolumes(1, &volume.fLower->at(0), &volume.fUpper->at(0), found);
+   const std::vector<UInt_t> &events = found[0];
 
    // calc xmin and xmax of events found in cell
    std::vector<Float_t> xmin(volume.fLower->size(), std::numeric_limits<float>::max());
    std::vector<Float_t> xmax(volume.fLower->size(), -std::numeric_limits<float>::max());
-   for (std::vector<const TMVA::BinarySearchTreeNode*>::const_iterator it = nodes.begin();
-        it != nodes.end(); ++it) {
-      std::vector<Float_t> ev = (*it)->GetEventV();
+   for (std::vector<UInt_t>::const_iterator it = events.begin(); it != events.end(); ++it) {
       for (UInt_t idim = 0; idim < xmin.size(); ++idim) {
-         if (ev.at(idim) < xmin.at(idim))  xmin.at(idim) = ev.at(idim);
-         if (ev.at(idim) > xmax.at(idim))  xmax.at(idim) = ev.at(idim);
+         const Float_t value = GetEventValue(*it, idim);
+         if (value < xmin.at(idim))  xmin.at(idim) = value;
+         if (value > xmax.at(idim))  xmax.at(idim) = value;
       }
    }
 
@@ -146,17 +150,16 @@ void TMVA::PDEFoamDecisionTreeDensity::FillHistograms(TMVA::Volume &volume, std:
    }
 
    // fill histograms with events found
-   for (std::vector<const TMVA::BinarySearchTreeNode*>::const_iterator it = nodes.begin();
-        it != nodes.end(); ++it) {
-      std::vector<Float_t> ev = (*it)->GetEventV();
-      Float_t              wt = (*it)->GetWeight();
-      for (UInt_t idim = 0; idim < ev.size(); ++idim) {
-         if ((*it)->GetClass() == fClass) {
-            hsig.at(idim)->Fill(ev.at(idim), wt);
-            hsig_unw.at(idim)->Fill(ev.at(idim), 1);
+   for (std::vector<UInt_t>::const_iterator it = events.begin(); it != events.end(); ++it) {
+      Float_t wt = GetEventWeight(*it);
+      for (UInt_t idim = 0; idim < hsig.size(); ++idim) {
+         const Float_t value = GetEventValue(*it, idim);
+         if (GetEventClass(*it) == fClass) {
+            hsig.at(idim)->Fill(value, wt);
+            hsig_unw.at(idim)->Fill(value, 1);
          } else {
-            hbkg.at(idim)->Fill(ev.at(idim), wt);
-            hbkg_unw.at(idim)->Fill(ev.at(idim), 1);
+            hbkg.at(idim)->Fill(value, wt);
+            hbkg_unw.at(idim)->Fill(value, 1);
          }
       }
    }
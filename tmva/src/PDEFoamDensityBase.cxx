@@ -8,12 +8,12 @@
  * Web    : http://tmva.sourceforge.net                                           *
  *                                                                                *
  * Description:                                                                   *
- *      This class provides an interface between the Binary search tree           *
- *      and the PDEFoam object.  In order to build-up the foam one needs to       *
- *      calculate the density of events at a given point (sampling during         *
- *      Foam build-up).  The function PDEFoamDensityBase::Density() does this job. It *
- *      uses a binary search tree, filled with training events, in order to       *
- *      provide this density.                                                     *
+ *      This class provides an interface between the search tree of the           *
+ *      training events and the PDEFoam object.  In order to build-up the foam    *
+ *      one needs to calculate the density of events at a given point (sampling   *
+ *      during Foam build-up).  The function PDEFoamDensityBase::Density() does   *
+ *      this job. It uses a flat kd-tree, filled with training events, in order   *
+ *      to provide this density.                                                  *
  *                                                                                *
  * Authors (alphabetical):                                                        *
  *      Tancredi Carli   - CERN, Switzerland                                      *
@@ -55,16 +55,27 @@
 //   PDEFoamDensityBase *dens = new MyDensity();
 //   pdefoam->SetDensity(dens);
 //
-// Afterwards the binary search tree should be filled with TMVA
-// events, by either using
+// Afterwards the search tree should be filled with TMVA events, by
+// either using
 //
 //   pdefoam->FillBinarySearchTree(event);
 //
 // or
 //
 //   dens->FillBinarySearchTree(event);
+//
+// The events are kept in a flat kd-tree: the variables, targets,
+// weights and classes of all events are stored in contiguous arrays,
+// ordered such that the node of the events first..last-1 is the
+// event in the middle, (first+last)/2, the events before it form the
+// left and the events after it the right subtree.  The tree is built
+// by BuildTree() after the last event is filled.  The range searching
+// (SearchVolumes()) finds the events in many boxes in one traversal
+// of the tree, which is used by DensityBatch() to evaluate the
+// density at many points at once.
 // _____________________________________________________________________
 
+#include <algorithm>
 #include <numeric>
 
 #ifndef ROOT_TMVA_PDEFoamDensityBase
@@ -79,7 +90,13 @@ TMVA::PDEFoamDensityBase::PDEFoamDensityBase()
      fBox(),
      fBoxVolume(1.0),
      fBoxHasChanged(kTRUE),
-     fBst(new TMVA::BinarySearchTree()),
+     fEventVars(),
+     fEventTargets(),
+     fEventWeights(),
+     fEventClasses(),
+     fSplit(),
+     fNTargets(0),
+     fTreeIsBuilt(kFALSE),
      fLogger(new MsgLogger("PDEFoamDensityBase"))
 {}
 
@@ -89,26 +106,28 @@ TMVA::PDEFoamDensityBase::PDEFoamDensityBase(std::vector<Double_t> box)
      fBox(box),
      fBoxVolume(1.0),
      fBoxHasChanged(kTRUE),
-     fBst(new TMVA::BinarySearchTree()),
+     fEventVars(),
+     fEventTargets(),
+     fEventWeights(),
+     fEventClasses(),
+     fSplit(),
+     fNTargets(0),
+     fTreeIsBuilt(kFALSE),
      fLogger(new MsgLogger("PDEFoamDensityBase"))
 {
    // User constructor
    //
    // - box - range-searching box, where box.size() == dimension of
-   //         the PDEFoam == periode of the binary search tree
+   //         the PDEFoam == number of variables of the search tree
 
    if (box.empty())
       Log() << kFATAL << "Dimension of PDEFoamDensityBase is zero" << Endl;
-
-   // set periode (number of variables) of binary search tree
-   fBst->SetPeriode(box.size());
 }
 
 //_____________________________________________________________________
 TMVA::PDEFoamDensityBase::~PDEFoamDensityBase()
 {
    // destructor
-   if (fBst)    delete fBst;
    if (fLogger) delete fLogger;
 }
 
@@ -118,27 +137,242 @@ TMVA::PDEFoamDensityBase::PDEFoamDensityBase(const PDEFoamDensityBase &distr)
      fBox(distr.fBox),
      fBoxVolume(distr.fBoxVolume),
      fBoxHasChanged(distr.fBoxHasChanged),
-     fBst(new BinarySearchTree(*distr.fBst)),
+     fEventVars(distr.fEventVars),
+     fEventTargets(distr.fEventTargets),
+     fEventWeights(distr.fEventWeights),
+     fEventClasses(distr.fEventClasses),
+     fSplit(distr.fSplit),
+     fNTargets(distr.fNTargets),
+     fTreeIsBuilt(distr.fTreeIsBuilt),
      fLogger(new MsgLogger(*distr.fLogger))
 {
    // Copy constructor
    //
-   // Creates a deep copy, using the copy constructor of
-   // TMVA::BinarySearchTree
+   // Creates a deep copy, including the events of the search tree
 }
 
 //_____________________________________________________________________
 void TMVA::PDEFoamDensityBase::FillBinarySearchTree(const Event* ev)
 {
-   // This method inserts the given event 'ev' it into the binary
-   // search tree.
+   // This method inserts the given event 'ev' it into the search
+   // tree.  The first fBox.size() variables, the targets, the weight
+   // and the class of the event are copied.  The tree is rebuilt by
+   // the next call of BuildTree().
+
+   if (fBox.empty())
+      Log() << kFATAL << "<PDEFoamDensityBase::FillBinarySearchTree> "
+            << "Dimension of PDEFoamDensityBase is zero" << Endl;
 
-   if (fBst == NULL)
+   if (fEventWeights.empty())
+      fNTargets = ev->GetNTargets();
+   else if (ev->GetNTargets() != fNTargets)
       Log() << kFATAL << "<PDEFoamDensityBase::FillBinarySearchTree> "
-            << "Binary tree is not set!" << Endl;
+            << "Event has " << ev->GetNTargets() << " targets instead of "
+            << fNTargets << Endl;
+
+   for (UInt_t ivar = 0; ivar < fBox.size(); ++ivar)
+      fEventVars.push_back(ev->GetValue(ivar));
+   for (UInt_t itgt = 0; itgt < fNTargets; ++itgt)
+      fEventTargets.push_back(ev->GetTarget(itgt));
+   fEventWeights.push_back(ev->GetWeight());
+   fEventClasses.push_back(ev->GetClass());
+   fTreeIsBuilt = kFALSE;
+}
+
+//_____________________________________________________________________
+namespace {
+   // orders event indices by one variable
+   struct PDEFoamVarLess {
+      const Float_t *var;
+      UInt_t dim;
+      UInt_t ivar;
+      bool operator()(UInt_t a, UInt_t b) const { return var[a*dim + ivar] < var[b*dim + ivar]; }
+   };
+
+   // reorder the values of the events (n per event) to the order 'index'
+   template <class T>
+   void PDEFoamReorder(std::vector<T> &values, const std::vector<UInt_t> &index, UInt_t n)
+   {
+      std::vector<T> sorted(values.size());
+      for (UInt_t i = 0; i < index.size(); ++i)
+         for (UInt_t j = 0; j < n; ++j)
+            sorted[i*n + j] = values[index[i]*n + j];
+      values.swap(sorted);
+   }
+
+   // build the subtree of the events index[first..last-1]: split at
+   // the median of the variable with the largest spread
+   void PDEFoamBuildNode(const Float_t *var, UInt_t dim, std::vector<UInt_t> &index,
+                         std::vector<UInt_t> &split, UInt_t first, UInt_t last)
+   {
+      if (last <= first) return;
+      if (last - first == 1) {
+         split[first] = 0;
+         return;
+      }
+
+      UInt_t ivar = 0;
+      Float_t max_width = -1.0;
+      for (UInt_t d = 0; d < dim; ++d) {
+         Float_t vmin = var[index[first]*dim + d];
+         Float_t vmax = vmin;
+         for (UInt_t i = first + 1; i < last; ++i) {
+            const Float_t value = var[index[i]*dim + d];
+            if (value < vmin) vmin = value;
+            if (value > vmax) vmax = value;
+         }
+         if (vmax - vmin > max_width) {
+            max_width = vmax - vmin;
+            ivar = d;
+         }
+      }
+
+      const UInt_t median = (first + last)/2;
+      PDEFoamVarLess less;
+      less.var  = var;
+      less.dim  = dim;
+      less.ivar = ivar;
+      std::nth_element(index.begin() + first, index.begin() + median, index.begin() + last, less);
+      split[median] = ivar;
+
+      PDEFoamBuildNode(var, dim, index, split, first, median);
+      PDEFoamBuildNode(var, dim, index, split, median + 1, last);
+   }
+}
+
+//_____________________________________________________________________
+void TMVA::PDEFoamDensityBase::BuildTree()
+{
+   // Builds the flat kd-tree of the filled events, if not done yet,
+   // and calculates the volume of the range-searching box.  After
+   // this the density may be evaluated in several threads at once.
+
+   GetBoxVolume();
+   if (fTreeIsBuilt) return;
+
+   const UInt_t dim = fBox.size();
+   std::vector<UInt_t> index(GetNEvents());
+   for (UInt_t i = 0; i < index.size(); ++i) index[i] = i;
+
+   fSplit.assign(GetNEvents(), 0);
+   if (GetNEvents() > 0)
+      PDEFoamBuildNode(&fEventVars[0], dim, index, fSplit, 0, GetNEvents());
+
+   // store the events in tree order
+   PDEFoamReorder(fEventVars,    index, dim);
+   PDEFoamReorder(fEventTargets, index, fNTargets);
+   PDEFoamReorder(fEventWeights, index, 1);
+   PDEFoamReorder(fEventClasses, index, 1);
+   fTreeIsBuilt = kTRUE;
+}
+
+//_____________________________________________________________________
+void TMVA::PDEFoamDensityBase::SearchVolumes(UInt_t n, const Double_t *lower, const Double_t *upper,
+                                             std::vector< std::vector<UInt_t> > &found) const
+{
+   // Finds the events inside the boxes of n queries, where the box of
+   // query i is given by lower[i*dim+d] < x_d <= upper[i*dim+d] for
+   // each variable d < dim = fBox.size().  The tree is traversed once
+   // for all queries.  The indices of the events found for query i
+   // are stored in found[i], in the same order as if the query was
+   // searched alone.
+
+   if (!fTreeIsBuilt)
+      Log() << kFATAL << "<PDEFoamDensityBase::SearchVolumes> "
+            << "Search tree is not built!" << Endl;
 
-   // insert into binary search tree
-   fBst->Insert(ev);
+   found.resize(n);
+   for (UInt_t i = 0; i < n; ++i) found[i].clear();
+
+   // the queries still active in the nodes of the current path
+   std::vector<UInt_t> active(n);
+   for (UInt_t i = 0; i < n; ++i) active[i] = i;
+
+   SearchNode(0, GetNEvents(), lower, upper, active, 0, n, found);
+}
+
+//_____________________________________________________________________
+void TMVA::PDEFoamDensityBase::SearchNode(UInt_t first, UInt_t last, const Double_t *lower,
+                                          const Double_t *upper, std::vector<UInt_t> &active,
+                                          UInt_t begin, UInt_t end,
+                                          std::vector< std::vector<UInt_t> > &found) const
+{
+   // Searches the subtree of the events first..last-1 for the queries
+   // active[begin..end-1].  The node event is tested first, then the
+   // left and the right subtree are searched for the queries which
+   // may contain events there.  The queries descending into a subtree
+   // are appended to 'active', which is truncated again afterwards.
+
+   if (last <= first || end <= begin) return;
+
+   const UInt_t dim  = fBox.size();
+   const UInt_t node = (first + last)/2;
+   const Float_t *var = &fEventVars[node*dim];
+
+   for (UInt_t i = begin; i < end; ++i) {
+      const UInt_t iq = active[i];
+      Bool_t inside = kTRUE;
+      for (UInt_t d = 0; d < dim && inside; ++d)
+         inside = (lower[iq*dim + d] < var[d] && upper[iq*dim + d] >= var[d]);
+      if (inside) found[iq].push_back(node);
+   }
+   if (last - first == 1) return;
+
+   const UInt_t ivar = fSplit[node];
+   const UInt_t size = active.size();
+
+   // left subtree: events with var[ivar] <= node value
+   for (UInt_t i = begin; i < end; ++i)
+      if (lower[active[i]*dim + ivar] < var[ivar]) active.push_back(active[i]);
+   SearchNode(first, node, lower, upper, active, size, active.size(), found);
+   active.resize(size);
+
+   // right subtree: events with var[ivar] >= node value
+   for (UInt_t i = begin; i < end; ++i)
+      if (upper[active[i]*dim + ivar] >= var[ivar]) active.push_back(active[i]);
+   SearchNode(node + 1, last, lower, upper, active, size, active.size(), found);
+   active.resize(size);
+}
+
+//_____________________________________________________________________
+void TMVA::PDEFoamDensityBase::SearchBoxes(UInt_t n, const Double_t *xev,
+                                           std::vector< std::vector<UInt_t> > &found)
+{
+   // Finds the events inside the range-searching boxes fBox placed
+   // at the n points xev (fBox.size() values per point), see
+   // SearchVolumes()
+
+   BuildTree();
+
+   const UInt_t dim = fBox.size();
+   std::vector<Double_t> lb(n*dim);
+   std::vector<Double_t> ub(n*dim);
+   for (UInt_t i = 0; i < n; ++i) {
+      for (UInt_t idim = 0; idim < dim; ++idim) {
+         lb[i*dim + idim] = xev[i*dim + idim] - fBox[idim] / 2.0;
+         ub[i*dim + idim] = xev[i*dim + idim] + fBox[idim] / 2.0;
+      }
+   }
+
+   if (n > 0) SearchVolumes(n, &lb[0], &ub[0], found);
+   else found.clear();
+}
+
+//_____________________________________________________________________
+void TMVA::PDEFoamDensityBase::DensityBatch(UInt_t n, const Double_t *xev, Double_t *density,
+                                            Double_t *event_density)
+{
+   // Evaluates the density at the n points xev (fBox.size() values
+   // per point) and stores the results of Density() in 'density' and
+   // 'event_density'.  Derived classes may override this function to
+   // search the events of all points at once.
+
+   const UInt_t dim = fBox.size();
+   std::vector<Double_t> x(dim);
+   for (UInt_t i = 0; i < n; ++i) {
+      std::copy(xev + i*dim, xev + (i+1)*dim, x.begin());
+      density[i] = Density(x, event_density[i]);
+   }
 }
 
 //_____________________________________________________________________
@@ -98,39 +98,38 @@ Double_t TMVA::PDEFoamDiscriminantDensity::Density(std::vector<Double_t> &xev, D
    // found in the range-searching volume at point 'xev', divided by
    // the box volume.
 
-   if (!fBst)
-      Log() << kFATAL << "<PDEFoamDiscriminantDensity::Density()> Binary tree not set!" << Endl;
+   Double_t density = 0;
+   DensityBatch(1, &xev[0], &density, &event_density);
+   return density;
+}
 
-   //create volume around point to be found
-   std::vector<Double_t> lb(GetBox().size());
-   std::vector<Double_t> ub(GetBox().size());
+//_____________________________________________________________________
+void TMVA::PDEFoamDiscriminantDensity::DensityBatch(UInt_t n, const Double_t *xev, Double_t *density,
+                                                    Double_t *event_density)
+{
+   // Evaluates Density() at the n points xev (GetBox().size() values
+   // per point), searching the events of all points at once.
+
+   // do range searching
+   std::vector< std::vector<UInt_t> > found;
+   SearchBoxes(n, xev, found);
 
    // probevolume relative to hypercube with edge length 1:
    const Double_t probevolume_inv = 1.0 / GetBoxVolume();
 
-   // set upper and lower bound for search volume
-   for (UInt_t idim = 0; idim < GetBox().size(); ++idim) {
-      lb[idim] = xev[idim] - GetBox().at(idim) / 2.0;
-      ub[idim] = xev[idim] + GetBox().at(idim) / 2.0;
-   }
-
-   TMVA::Volume volume(&lb, &ub);                        // volume to search in
-   std::vector<const TMVA::BinarySearchTreeNode*> nodes; // BST nodes found
+   for (UInt_t i = 0; i < n; ++i) {
+      Double_t sumOfWeights = 0; // weights of all events found
+      Double_t n_sig = 0;        // number of signal events found
+      for (std::vector<UInt_t>::const_iterator it = found[i].begin(); it != found[i].end(); ++it) {
+         sumOfWeights += GetEventWeight(*it);
+         if (GetEventClass(*it) == fClass) // signal event
+            n_sig += GetEventWeight(*it);
+      }
 
-   // do range searching
-   const Double_t sumOfWeights = fBst->SearchVolume(&volume, &nodes);
+      // store density based on total number of events
+      event_density[i] = found[i].size() * probevolume_inv;
 
-   // store density based on total number of events
-   event_density = nodes.size() * probevolume_inv;
-
-   Double_t n_sig = 0;           // number of signal events found
-   // calc number of signal events in nodes
-   for (std::vector<const TMVA::BinarySearchTreeNode*>::const_iterator it = nodes.begin();
-        it != nodes.end(); ++it) {
-      if ((*it)->GetClass() == fClass) // signal node
-         n_sig += (*it)->GetWeight();
+      // return:  (n_sig/n_total) / (cell_volume)
+      density[i] = (n_sig / (sumOfWeights + 0.1)) * probevolume_inv;
    }
-
-   // return:  (n_sig/n_total) / (cell_volume)
-   return (n_sig / (sumOfWeights + 0.1)) * probevolume_inv;
 }
@@ -91,31 +91,34 @@ Double_t TMVA::PDEFoamEventDensity::Density(std::vector<Double_t> &xev, Double_t
    // range-searching volume at point 'xev', divided by the box
    // volume.
 
-   if (!fBst)
-      Log() << kFATAL << "<PDEFoamEventDensity::Density()> Binary tree not found!" << Endl;
+   Double_t density = 0;
+   DensityBatch(1, &xev[0], &density, &event_density);
+   return density;
+}
 
-   //create volume around point to be found
-   std::vector<Double_t> lb(GetBox().size());
-   std::vector<Double_t> ub(GetBox().size());
+//_____________________________________________________________________
+void TMVA::PDEFoamEventDensity::DensityBatch(UInt_t n, const Double_t *xev, Double_t *density,
+                                             Double_t *event_density)
+{
+   // Evaluates Density() at the n points xev (GetBox().size() values
+   // per point), searching the events of all points at once.
+
+   // do range searching
+   std::vector< std::vector<UInt_t> > found;
+   SearchBoxes(n, xev, found);
 
    // probevolume relative to hypercube with edge length 1:
    const Double_t probevolume_inv = 1.0 / GetBoxVolume();
 
-   // set upper and lower bound for search volume
-   for (UInt_t idim = 0; idim < GetBox().size(); ++idim) {
-      lb[idim] = xev[idim] - GetBox().at(idim) / 2.0;
-      ub[idim] = xev[idim] + GetBox().at(idim) / 2.0;
-   }
-
-   TMVA::Volume volume(&lb, &ub);                        // volume to search in
-   std::vector<const TMVA::BinarySearchTreeNode*> nodes; // BST nodes found
+   for (UInt_t i = 0; i < n; ++i) {
+      Double_t sumOfWeights = 0;
+      for (std::vector<UInt_t>::const_iterator it = found[i].begin(); it != found[i].end(); ++it)
+         sumOfWeights += GetEventWeight(*it);
 
-   // do range searching
-   const Double_t sumOfWeights = fBst->SearchVolume(&volume, &nodes);
+      // store density based on total number of events
+      event_density[i] = found[i].size() * probevolume_inv;
 
-   // store density based on total number of events
-   event_density = nodes.size() * probevolume_inv;
-
-   // return:  N_total(weighted) / cell_volume
-   return (sumOfWeights + 0.1) * probevolume_inv;
+      // return:  N_total(weighted) / cell_volume
+      density[i] = (sumOfWeights + 0.1) * probevolume_inv;
+   }
 }
@@ -95,38 +95,41 @@ Double_t TMVA::PDEFoamTargetDensity::Density(std::vector<Double_t> &xev, Double_
    // Average target value in the range-searching volume at point
    // 'xev', divided by the box volume.
 
-   if (!fBst)
-      Log() << kFATAL << "<PDEFoamTargetDensity::Density()> Binary tree not found!" << Endl;
+   Double_t density = 0;
+   DensityBatch(1, &xev[0], &density, &event_density);
+   return density;
+}
 
-   //create volume around point to be found
-   std::vector<Double_t> lb(GetBox().size());
-   std::vector<Double_t> ub(GetBox().size());
+//_____________________________________________________________________
+void TMVA::PDEFoamTargetDensity::DensityBatch(UInt_t n, const Double_t *xev, Double_t *density,
+                                              Double_t *event_density)
+{
+   // Evaluates Density() at the n points xev (GetBox().size() values
+   // per point), searching the events of all points at once.
 
-   // probevolume relative to hypercube with edge length 1:
-   const Double_t probevolume_inv = 1.0 / GetBoxVolume();
+   // do range searching
+   std::vector< std::vector<UInt_t> > found;
+   SearchBoxes(n, xev, found);
 
-   // set upper and lower bound for search volume
-   for (UInt_t idim = 0; idim < GetBox().size(); ++idim) {
-      lb[idim] = xev[idim] - GetBox().at(idim) / 2.0;
-      ub[idim] = xev[idim] + GetBox().at(idim) / 2.0;
-   }
+   if (GetNEvents() > 0 && fTarget >= GetNTargets())
+      Log() << kFATAL << "<PDEFoamTargetDensity::DensityBatch()> Target " << fTarget
+            << " not found, the events have " << GetNTargets() << " targets" << Endl;
 
-   TMVA::Volume volume(&lb, &ub);                        // volume to search in
-   std::vector<const TMVA::BinarySearchTreeNode*> nodes; // BST nodes found
+   // probevolume relative to hypercube with edge length 1:
+   const Double_t probevolume_inv = 1.0 / GetBoxVolume();
 
-   // do range searching
-   const Double_t sumOfWeights = fBst->SearchVolume(&volume, &nodes);
+   for (UInt_t i = 0; i < n; ++i) {
+      Double_t sumOfWeights = 0; // weights of all events found
+      Double_t n_tar = 0;        // number of target events found
+      for (std::vector<UInt_t>::const_iterator it = found[i].begin(); it != found[i].end(); ++it) {
+         sumOfWeights += GetEventWeight(*it);
+         n_tar += GetEventTarget(*it, fTarget) * GetEventWeight(*it);
+      }
 
-   // store density based on total number of events
-   event_density = nodes.size() * probevolume_inv;
+      // store density based on total number of events
+      event_density[i] = found[i].size() * probevolume_inv;
 
-   Double_t n_tar = 0;           // number of target events found
-   // now sum over all nodes->GetTarget(0);
-   for (std::vector<const TMVA::BinarySearchTreeNode*>::const_iterator it = nodes.begin();
-        it != nodes.end(); ++it) {
-      n_tar += ((*it)->GetTargets()).at(fTarget) * ((*it)->GetWeight());
+      // return:  (n_tar/n_total) / (cell_volume)
+      density[i] = (n_tar / (sumOfWeights + 0.1)) * probevolume_inv;
    }
-
-   // return:  (n_tar/n_total) / (cell_volume)
-   return (n_tar / (sumOfWeights + 0.1)) * probevolume_inv;
 }
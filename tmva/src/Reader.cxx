@@ -484,6 +484,68 @@ Double_t TMVA::Reader::EvaluateMVA( const std::vector<Float_t>& inputVec, const
    return val;
 }
 
+//_______________________________________________________________________
+void TMVA::Reader::EvaluateMVA( const std::vector< std::vector<Float_t> >& inputVecs, const TString& methodTag,
+                                std::vector<Double_t>& mvaValues, Double_t aux )
+{
+   // Evaluate a set of events, each given by a std::vector<float> of input
+   // data, for a given method. The events are passed to the method at once,
+   // which allows methods like BDT to evaluate them much faster than one by
+   // one. The parameter aux is obligatory for the cuts method where it
+   // represents the efficiency cutoff
+
+   mvaValues.clear();
+   IMethod* imeth = FindMVA( methodTag );
+   MethodBase* meth = dynamic_cast<TMVA::MethodBase*>(imeth);
+   if(meth==0) return;
+
+   if (meth->GetMethodType() == TMVA::Types::kCuts) {
+      TMVA::MethodCuts* mc = dynamic_cast<TMVA::MethodCuts*>(meth);
+      if(mc)
+         mc->SetTestSignalEfficiency( aux );
+   }
+
+   std::vector<const Event*> events;
+   events.reserve( inputVecs.size() );
+   for (UInt_t ievt=0; ievt<inputVecs.size(); ievt++)
+      events.push_back( new Event(inputVecs[ievt], DataInfo().GetNVariables()) );
+
+   meth->GetMvaValues( events, mvaValues );
+
+   for (UInt_t ievt=0; ievt<events.size(); ievt++) delete events[ievt];
+}
+
+//_______________________________________________________________________
+void TMVA::Reader::EvaluateMVA( const Float_t* inputs, UInt_t nEvents, const TString& methodTag,
+                                Double_t* mvaValues, Double_t aux )
+{
+   // Evaluate a set of events stored column-wise (a matrix with one row
+   // per input variable, i.e. variable ivar of event ievt is
+   // inputs[ivar*nEvents+ievt]) for a given method, and fill the nEvents
+   // responses into mvaValues. Methods with a batch evaluation (BDT, MLP,
+   // Fisher, Likelihood) apply the variable transformations (if these are
+   // Normalize, Deco or PCA) to all events at once, without the event
+   // buffers of the Reader, method and transformations. Only in this case
+   // can several threads evaluate different sets of events with the same
+   // method. Other methods, and methods with other transformations,
+   // evaluate the events one by one through the event buffers of the
+   // method and are not thread safe. The parameter aux is
+   // obligatory for the cuts method where it represents the efficiency
+   // cutoff
+
+   IMethod* imeth = FindMVA( methodTag );
+   MethodBase* meth = dynamic_cast<TMVA::MethodBase*>(imeth);
+   if(meth==0) return;
+
+   if (meth->GetMethodType() == TMVA::Types::kCuts) {
+      TMVA::MethodCuts* mc = dynamic_cast<TMVA::MethodCuts*>(meth);
+      if(mc)
+         mc->SetTestSignalEfficiency( aux );
+   }
+
+   meth->GetMvaValues( inputs, nEvents, mvaValues );
+}
+
 //_______________________________________________________________________
 Double_t TMVA::Reader::EvaluateMVA( const std::vector<Double_t>& inputVec, const TString& methodTag, Double_t aux )
 {
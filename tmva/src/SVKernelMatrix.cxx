@@ -30,75 +30,176 @@
 #include "TMVA/SVEvent.h"
 #include <iostream>
 #include <stdexcept>
+#include "TMath.h"
 #include "TMVA/MsgLogger.h"
 
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+//_______________________________________________________________________
+//
+// Kernel matrix of the SVM training events
+//
+// The rows of the matrix are computed on demand and kept in a cache of
+// limited size (cacheSize in MB), the least recently used row is
+// replaced when the cache is full. The diagonal is computed once. This
+// keeps the memory bounded for large training samples, while the rows
+// of the events that are optimised repeatedly are computed only once.
+//_______________________________________________________________________
+
+namespace {
+
+   struct SVKernelLineTask {
+      TMVA::SVKernelFunction*       kernel; // kernel function
+      std::vector<TMVA::SVEvent*>*  events; // all events
+      UInt_t                        line;   // row to compute
+      UInt_t                        first;  // first column of this task
+      UInt_t                        last;   // one after the last column of this task
+      Float_t*                      row;    // output row
+   };
+
+   //_______________________________________________________________________
+   void* SVKernelLineWorker( void* arg )
+   {
+      // compute the columns [first,last) of one row of the kernel matrix
+      SVKernelLineTask* task = static_cast<SVKernelLineTask*>(arg);
+      TMVA::SVEvent* ev = (*task->events)[task->line];
+      for (UInt_t i = task->first; i < task->last; i++)
+         task->row[i] = task->kernel->Evaluate( ev, (*task->events)[i] );
+      return 0;
+   }
+}
+
 //_______________________________________________________________________
 TMVA::SVKernelMatrix::SVKernelMatrix()
    : fSize(0),
      fKernelFunction(0),
-     fSVKernelMatrix(0),
-     fLogger( new MsgLogger("ResultsRegression", kINFO) )
+     fInputVectors(0),
+     fMaxLines(0),
+     fNThreads(1),
+     fLogger( new MsgLogger("SVKernelMatrix", kINFO) )
 {
    // constructor
 }
 
 //_______________________________________________________________________
-TMVA::SVKernelMatrix::SVKernelMatrix( std::vector<TMVA::SVEvent*>* inputVectors, SVKernelFunction* kernelFunction )
+TMVA::SVKernelMatrix::SVKernelMatrix( std::vector<TMVA::SVEvent*>* inputVectors, SVKernelFunction* kernelFunction,
+                                      UInt_t cacheSize, UInt_t nThreads )
    : fSize(inputVectors->size()),
      fKernelFunction(kernelFunction),
+     fInputVectors(inputVectors),
+     fMaxLines(0),
+     fNThreads(TMath::Max(nThreads,UInt_t(1))),
      fLogger( new MsgLogger("SVKernelMatrix", kINFO) )
 {
-   // constructor
-   fSVKernelMatrix = new Float_t*[fSize];
+   // constructor, the cache holds at most cacheSize MB of matrix rows (but
+   // at least two rows)
+   Double_t maxLines = (Double_t(cacheSize)*1024*1024)/(Double_t(TMath::Max(fSize,UInt_t(1)))*sizeof(Float_t));
+   fMaxLines = UInt_t(TMath::Max(2., TMath::Min(maxLines, Double_t(fSize))));
+   Log() << kINFO << "Kernel matrix cache of " << cacheSize << " MB holds " << fMaxLines
+         << " of " << fSize << " rows" << Endl;
+
    try{
-      for (UInt_t i = 0; i < fSize; i++) fSVKernelMatrix[i] = new Float_t[i+1];
+      fDiagonal.resize(fSize);
+      fLines.assign(fSize, (Float_t*)0);
+      fLRUPos.resize(fSize);
    }catch(...){
       Log() << kFATAL << "Input data too large. Not enough memory to allocate memory for Support Vector Kernel Matrix. Please reduce the number of input events or use a different method."<<Endl;
    }
-   for (UInt_t i = 0; i < fSize; i++) {
-      fSVKernelMatrix[i][i] = 2*fKernelFunction->Evaluate((*inputVectors)[i], (*inputVectors)[i]);
-      for (UInt_t j = 0; j <=i; j++) {
-         fSVKernelMatrix[i][j] = fKernelFunction->Evaluate((*inputVectors)[i], (*inputVectors)[j]);
-      }
-   }
+   for (UInt_t i = 0; i < fSize; i++)
+      fDiagonal[i] = fKernelFunction->Evaluate((*inputVectors)[i], (*inputVectors)[i]);
 }
 
 //_______________________________________________________________________
 TMVA::SVKernelMatrix::~SVKernelMatrix()
 {
    // destructor
-   for (UInt_t i = fSize -1; i > 0; i--) {
-      delete[] fSVKernelMatrix[i];
-      fSVKernelMatrix[i] = 0;
+   for (std::list<UInt_t>::iterator it = fLRU.begin(); it != fLRU.end(); it++) {
+      delete[] fLines[*it];
+      fLines[*it] = 0;
    }
-   delete[] fSVKernelMatrix;
-   fSVKernelMatrix = 0;
+   delete fLogger;
+}
+
+//_______________________________________________________________________
+void TMVA::SVKernelMatrix::ComputeLine( UInt_t line, Float_t* row )
+{
+   // computes a row of the kernel matrix, distributed over fNThreads
+   // threads for large matrices (the last block is computed in the
+   // calling thread)
+
+   UInt_t nThreads = fNThreads;
+   if (fSize < 1000*nThreads) nThreads = 1;
+
+   std::vector<SVKernelLineTask> tasks(nThreads);
+   for (UInt_t i = 0; i < nThreads; i++) {
+      tasks[i].kernel = fKernelFunction;
+      tasks[i].events = fInputVectors;
+      tasks[i].line   = line;
+      tasks[i].first  = (UInt_t)((ULong64_t(i)*fSize)/nThreads);
+      tasks[i].last   = (UInt_t)((ULong64_t(i+1)*fSize)/nThreads);
+      tasks[i].row    = row;
+   }
+#ifndef _WIN32
+   std::vector<pthread_t> threads(nThreads);
+   std::vector<Bool_t> started(nThreads, kFALSE);
+   for (UInt_t i = 0; i < nThreads; i++) {
+      if (i < nThreads-1) started[i] = (pthread_create(&threads[i],0,SVKernelLineWorker,&tasks[i])==0);
+      if (!started[i]) SVKernelLineWorker(&tasks[i]);
+   }
+   for (UInt_t i = 0; i < nThreads; i++) {
+      if (started[i]) pthread_join(threads[i],0);
+   }
+#else
+   for (UInt_t i = 0; i < nThreads; i++) SVKernelLineWorker(&tasks[i]);
+#endif
+   row[line] = fDiagonal[line];
 }
 
 //_______________________________________________________________________
 Float_t* TMVA::SVKernelMatrix::GetLine( UInt_t line )
 {
-   // returns a row of the kernel matrix
+   // returns a row of the kernel matrix, computing it if it is not in the
+   // cache; if the cache is full, the least recently used row is replaced
 
-   Float_t* fLine = NULL;
-   if (line >= fSize) {
-      return NULL;
+   if (line >= fSize) return NULL;
+
+   if (fLines[line] != 0) {
+      fLRU.splice(fLRU.begin(), fLRU, fLRUPos[line]);
+      return fLines[line];
+   }
+
+   Float_t* row = 0;
+   if (fLRU.size() >= fMaxLines) {
+      UInt_t oldest = fLRU.back();
+      fLRU.pop_back();
+      row = fLines[oldest];
+      fLines[oldest] = 0;
    }
    else {
-      fLine = new Float_t[fSize];
-      for( UInt_t i = 0; i <line; i++)
-         fLine[i] = fSVKernelMatrix[line][i];
-      for( UInt_t i = line; i < fSize; i++)
-         fLine[i] = fSVKernelMatrix[i][line];
-      return fLine;
+      try{
+         row = new Float_t[fSize];
+      }catch(...){
+         Log() << kFATAL << "Not enough memory for the Support Vector Kernel Matrix cache. Please reduce the cache size." << Endl;
+      }
    }
+   ComputeLine(line, row);
+
+   fLRU.push_front(line);
+   fLRUPos[line] = fLRU.begin();
+   fLines[line]  = row;
+   return row;
 }
 
 //_______________________________________________________________________
 Float_t TMVA::SVKernelMatrix::GetElement(UInt_t i, UInt_t j)
 { 
-   // returns an element of the kernel matrix
+   // returns an element of the kernel matrix, from the cache if one of the
+   // two rows is cached (it's symmetric, ;)
 
-   if (i > j) return fSVKernelMatrix[i][j]; 
-   else       return fSVKernelMatrix[j][i]; // it's symmetric, ;)
+   if (i == j)         return fDiagonal[i];
+   if (fLines[i] != 0) return fLines[i][j];
+   if (fLines[j] != 0) return fLines[j][i];
+   return fKernelFunction->Evaluate((*fInputVectors)[i], (*fInputVectors)[j]);
 }
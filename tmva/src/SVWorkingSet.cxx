@@ -58,7 +58,7 @@ TMVA::SVWorkingSet::SVWorkingSet()
 
 //_______________________________________________________________________
 TMVA::SVWorkingSet::SVWorkingSet(std::vector<TMVA::SVEvent*>*inputVectors, SVKernelFunction* kernelFunction,
-                                 Float_t tol, Bool_t doreg)
+                                 Float_t tol, Bool_t doreg, UInt_t cacheSize, UInt_t nThreads)
    : fdoRegression(doreg),
      fInputData(inputVectors),
      fSupVec(0),
@@ -70,12 +70,10 @@ TMVA::SVWorkingSet::SVWorkingSet(std::vector<TMVA::SVEvent*>*inputVectors, SVKer
      fTolerance(tol),      
      fLogger( new MsgLogger( "SVWorkingSet", kINFO ) )
 {
-   // constructor
-   fKMatrix = new TMVA::SVKernelMatrix(inputVectors, kernelFunction);
-   Float_t *pt;
+   // constructor, the rows of the kernel matrix are computed on demand
+   // and cached (cacheSize in MB), in nThreads threads
+   fKMatrix = new TMVA::SVKernelMatrix(inputVectors, kernelFunction, cacheSize, nThreads);
    for( UInt_t i = 0; i < fInputData->size(); i++){ 
-      pt = fKMatrix->GetLine(i);
-      fInputData->at(i)->SetLine(pt);
       fInputData->at(i)->SetNs(i);
       if(fdoRegression) fInputData->at(i)->SetErrorCache(fInputData->at(i)->GetTarget());
    }
@@ -122,15 +120,14 @@ Bool_t TMVA::SVWorkingSet::ExamineExample( TMVA::SVEvent* jevt )
    Float_t fErrorC_J = 0.;
    if( jevt->GetIdx()==0) fErrorC_J = jevt->GetErrorCache();
    else{
-      Float_t *fKVals = jevt->GetLine();
+      // only the kernel elements of the support vectors are needed, they
+      // are taken from the cached rows if available
       fErrorC_J = 0.;
       std::vector<TMVA::SVEvent*>::iterator idIter;
       
-      UInt_t k=0;
       for(idIter = fInputData->begin(); idIter != fInputData->end(); idIter++){
          if((*idIter)->GetAlpha()>0)
-            fErrorC_J += (*idIter)->GetAlpha()*(*idIter)->GetTypeFlag()*fKVals[k];
-         k++;
+            fErrorC_J += (*idIter)->GetAlpha()*(*idIter)->GetTypeFlag()*fKMatrix->GetElement(jevt->GetNs(), (*idIter)->GetNs());
       }
       
      
@@ -297,12 +294,16 @@ Bool_t TMVA::SVWorkingSet::TakeStep(TMVA::SVEvent* ievt,TMVA::SVEvent* jevt )
    Float_t dL_I = type_I * ( newAlpha_I - alpha_I );
    Float_t dL_J = type_J * ( newAlpha_J - alpha_J );  
 
+   // the rows of both events are needed for the update of the error cache
+   const Float_t* kernelRow_I = fKMatrix->GetLine(ievt->GetNs());
+   const Float_t* kernelRow_J = fKMatrix->GetLine(jevt->GetNs());
+
    Int_t k = 0; 
    for(idIter = fInputData->begin(); idIter != fInputData->end(); idIter++){
       k++;
       if((*idIter)->GetIdx()==0){
-         Float_t ii = fKMatrix->GetElement(ievt->GetNs(), (*idIter)->GetNs());
-         Float_t jj = fKMatrix->GetElement(jevt->GetNs(), (*idIter)->GetNs());
+         Float_t ii = kernelRow_I[(*idIter)->GetNs()];
+         Float_t jj = kernelRow_J[(*idIter)->GetNs()];
          
          (*idIter)->UpdateErrorCache(dL_I * ii + dL_J * jj);       
       }
@@ -617,13 +618,15 @@ Bool_t TMVA::SVWorkingSet::TakeStepReg(TMVA::SVEvent* ievt,TMVA::SVEvent* jevt )
       const Float_t diff_alpha_j = jevt->GetDeltaAlpha()+b_alpha_j_p - jevt->GetAlpha();
 
       //update error cache
+      const Float_t* kernelRow_I = fKMatrix->GetLine(ievt->GetNs());
+      const Float_t* kernelRow_J = fKMatrix->GetLine(jevt->GetNs());
       Int_t k = 0; 
       for(idIter = fInputData->begin(); idIter != fInputData->end(); idIter++){
          k++;
          //there will be some changes in Idx notation
          if((*idIter)->GetIdx()==0){
-            Float_t k_ii = fKMatrix->GetElement(ievt->GetNs(), (*idIter)->GetNs());
-            Float_t k_jj = fKMatrix->GetElement(jevt->GetNs(), (*idIter)->GetNs());
+            Float_t k_ii = kernelRow_I[(*idIter)->GetNs()];
+            Float_t k_jj = kernelRow_J[(*idIter)->GetNs()];
          
             (*idIter)->UpdateErrorCache(diff_alpha_i * k_ii + diff_alpha_j * k_jj);
          }
@@ -668,14 +671,14 @@ Bool_t TMVA::SVWorkingSet::ExamineExampleReg(TMVA::SVEvent* jevt)
       fErrorC_J = jevt->GetErrorCache();
    }
    else{
-      Float_t *fKVals = jevt->GetLine();
+      // only the kernel elements of the support vectors are needed, they
+      // are taken from the cached rows if available
       fErrorC_J = 0.;
       std::vector<TMVA::SVEvent*>::iterator idIter;
       
-      UInt_t k=0;
       for(idIter = fInputData->begin(); idIter != fInputData->end(); idIter++){
-         fErrorC_J -= (*idIter)->GetDeltaAlpha()*fKVals[k];
-         k++;
+         if((*idIter)->GetDeltaAlpha()!=0)
+            fErrorC_J -= (*idIter)->GetDeltaAlpha()*fKMatrix->GetElement(jevt->GetNs(), (*idIter)->GetNs());
       }
       
       fErrorC_J += jevt->GetTarget();
@@ -46,6 +46,9 @@
 #ifndef ROOT_TMVA_Event
 #include "TMVA/Event.h"
 #endif
+#ifndef ROOT_TMVA_EventStore
+#include "TMVA/EventStore.h"
+#endif
 #ifndef ROOT_TMVA_MsgLogger
 #include "TMVA/MsgLogger.h"
 #endif
@@ -153,6 +156,42 @@ const TMVA::Event* TMVA::TransformationHandler::Transform( const Event* ev ) con
    return trEv;
 }
 
+//_______________________________________________________________________
+Bool_t TMVA::TransformationHandler::TransformColumns( Float_t* values, UInt_t nEvents ) const 
+{
+   // the transformation of a set of events stored column-wise
+   return TransformColumns( values, nEvents, fTransformationsReferenceClasses );
+}
+
+//_______________________________________________________________________
+Bool_t TMVA::TransformationHandler::TransformColumns( Float_t* values, UInt_t nEvents, Int_t cls ) const 
+{
+   // the transformation of a set of events stored column-wise, using the
+   // given class for all transformations
+   return TransformColumns( values, nEvents, std::vector<Int_t>( fTransformationsReferenceClasses.size(), cls ) );
+}
+
+//_______________________________________________________________________
+Bool_t TMVA::TransformationHandler::TransformColumns( Float_t* values, UInt_t nEvents, const std::vector<Int_t>& classes ) const 
+{
+   // apply the transformations one after the other to all events at once;
+   // nothing is done if one of them cannot be applied column-wise
+
+   TListIter trIt(&fTransformations);
+   while (VariableTransformBase *trf = (VariableTransformBase*) trIt()) {
+      if (!trf->CanTransformColumns()) return kFALSE;
+   }
+
+   trIt.Reset();
+   std::vector<Int_t>::const_iterator rClsIt = classes.begin();
+   while (VariableTransformBase *trf = (VariableTransformBase*) trIt()) {
+      if (rClsIt == classes.end()) Log() << kFATAL<< "invalid read in TransformationHandler::TransformColumns " <<Endl;
+      trf->TransformColumns( values, nEvents, (*rClsIt) );
+      rClsIt++;
+   }
+   return kTRUE;
+}
+
 //_______________________________________________________________________
 const TMVA::Event* TMVA::TransformationHandler::InverseTransform( const Event* ev, Bool_t suppressIfNoTargets ) const 
 {
@@ -203,34 +242,29 @@ const std::vector<TMVA::Event*>* TMVA::TransformationHandler::CalcTransformation
    if (fTransformations.GetEntries() <= 0)
       return &events;
 
-   std::vector<Event*>* tmpEvents = new std::vector<TMVA::Event*>(events.size());
-
-   for ( UInt_t ievt = 0; ievt<events.size(); ievt++)
-      tmpEvents->at(ievt) = new Event(*events.at(ievt));
-	 
-   
-
-   Bool_t replaceColl = kFALSE; // first let TransformCollection create a new vector
+   // the first transformation creates a new vector holding the transformed
+   // copies of the events, the following ones replace these by their
+   // transformed versions; hence the events exist only once in transformed
+   // form (the input events are not modified)
+   std::vector<Event*>* tmpEvents = 0;
 
    TListIter trIt(&fTransformations);
    std::vector< Int_t >::iterator rClsIt = fTransformationsReferenceClasses.begin();
    while (VariableTransformBase *trf = (VariableTransformBase*) trIt()) {
-      if (trf->PrepareTransformation(*tmpEvents)) {
-         tmpEvents = TransformCollection(trf, (*rClsIt), tmpEvents, replaceColl);
-         // we now created a new vector, so the next transformations replace the 
-         // events by their transformed versions
-         replaceColl = kTRUE;  
+      if (trf->PrepareTransformation(tmpEvents ? *tmpEvents : events)) {
+         if (tmpEvents) tmpEvents = TransformCollection(trf, (*rClsIt), tmpEvents, kTRUE);
+         else           tmpEvents = TransformCollection(trf, (*rClsIt), const_cast<std::vector<Event*>*>(&events), kFALSE);
          rClsIt++;
       }
    }
 
-   CalcStats(*tmpEvents);
+   CalcStats(tmpEvents ? *tmpEvents : events);
 
    // plot the variables once in this transformation
-   PlotVariables(*tmpEvents);
+   PlotVariables(tmpEvents ? *tmpEvents : events);
 
    if (!createNewVector) {  // if we don't want that newly created event vector to persist, then delete it
-      if (replaceColl) {    
+      if (tmpEvents) {    
          for ( UInt_t ievt = 0; ievt<tmpEvents->size(); ievt++)
             delete (*tmpEvents)[ievt];
          delete tmpEvents;
@@ -238,6 +272,13 @@ const std::vector<TMVA::Event*>* TMVA::TransformationHandler::CalcTransformation
       return 0;
    }
 
+   // the caller owns the returned events, so copy them if no transformation was applied
+   if (tmpEvents == 0) {
+      tmpEvents = new std::vector<TMVA::Event*>(events.size());
+      for ( UInt_t ievt = 0; ievt<events.size(); ievt++)
+         (*tmpEvents)[ievt] = new Event(*events[ievt]);
+   }
+
    return tmpEvents; // give back the newly created event collection (containing the transformed events)
 }
 
@@ -250,6 +291,10 @@ std::vector<TMVA::Event*>* TMVA::TransformationHandler::TransformCollection( Var
    // a collection of transformations
    std::vector<TMVA::Event*>* tmpEvents = 0;
 
+   // if the input events view an EventStore, the new transformed events view
+   // a store of their own holding all transformed values in a single block
+   EventStore* store = 0;
+
    if (replace) {   // the events should be replaced by their transformed versions
       tmpEvents = events;
    } 
@@ -257,11 +302,19 @@ std::vector<TMVA::Event*>* TMVA::TransformationHandler::TransformCollection( Var
       tmpEvents = new std::vector<TMVA::Event*>(events->size());
    }
    for (UInt_t ievt = 0; ievt<events->size(); ievt++) {  // loop through all events
-      if (replace) {  // and replace the event by its transformed version
+      if (replace) {  // and replace the event by its transformed version (in its store, if it views one)
          *(*tmpEvents)[ievt] = *trf->Transform((*events)[ievt],cls);
       } 
       else {         // and create a new event which is the transformed version of the old event
-         (*tmpEvents)[ievt] = new Event(*trf->Transform((*events)[ievt],cls));
+         const Event* trEv = trf->Transform((*events)[ievt],cls);
+         if (ievt == 0 && (*events)[0]->IsView())
+            store = new EventStore( events->size(), trEv->GetNVariables(), trEv->GetNTargets(), trEv->GetNSpectators() );
+         if (store) {
+            Event* ev = new Event( store, ievt );
+            ev->CopyVarValues( *trEv );
+            (*tmpEvents)[ievt] = ev;
+         }
+         else (*tmpEvents)[ievt] = new Event(*trEv);
       }
    }
    return tmpEvents;
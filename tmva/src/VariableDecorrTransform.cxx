@@ -220,6 +220,50 @@ const TMVA::Event* TMVA::VariableDecorrTransform::Transform( const TMVA::Event*
    return fTransformedEvent;
 }
 
+//_______________________________________________________________________
+Bool_t TMVA::VariableDecorrTransform::CanTransformColumns() const
+{
+   // the column-wise transformation is available for input variables
+   return IsCreated() && SelectsOnlyVariables();
+}
+
+//_______________________________________________________________________
+void TMVA::VariableDecorrTransform::TransformColumns( Float_t* values, UInt_t nEvents, Int_t cls ) const
+{
+   // apply the decorrelation to a set of events stored column-wise; the
+   // matrix multiplication is done for all events at once, summing in the
+   // same order as in Transform
+
+   Int_t whichMatrix = cls;
+   if (cls < 0 || cls >= (int) fDecorrMatrices.size()) whichMatrix = fDecorrMatrices.size()-1;
+
+   const TMatrixD* m = fDecorrMatrices.at(whichMatrix);
+   if (m == 0) {
+      Log() << kFATAL << "Transformation matrix for class " << whichMatrix << " is not defined" 
+            << Endl;
+   }
+
+   const UInt_t nvar = fGet.size();
+   std::vector<Float_t*> columns( nvar );
+   for (UInt_t ivar=0; ivar<nvar; ivar++) columns[ivar] = values + fGet[ivar].second*nEvents;
+
+   std::vector<Float_t>  output( nvar*nEvents );
+   std::vector<Double_t> sum( nEvents );
+   for (UInt_t ivar=0; ivar<nvar; ivar++) {
+      sum.assign( nEvents, 0 );
+      for (UInt_t jvar=0; jvar<nvar; jvar++) {
+         const Double_t  mij = (*m)(ivar,jvar);
+         const Float_t*  x   = columns[jvar];
+         for (UInt_t ievt=0; ievt<nEvents; ievt++) sum[ievt] += mij*x[ievt];
+      }
+      std::copy( sum.begin(), sum.end(), output.begin()+ivar*nEvents );
+   }
+
+   for (UInt_t ivar=0; ivar<nvar; ivar++) {
+      std::copy( output.begin()+ivar*nEvents, output.begin()+(ivar+1)*nEvents, columns[ivar] );
+   }
+}
+
 //_______________________________________________________________________
 const TMVA::Event* TMVA::VariableDecorrTransform::InverseTransform( const TMVA::Event* const /*ev*/, Int_t /*cls*/ ) const
 {
@@ -153,6 +153,34 @@ const TMVA::Event* TMVA::VariableNormalizeTransform::Transform( const TMVA::Even
    return fTransformedEvent;
 }
 
+//_______________________________________________________________________
+Bool_t TMVA::VariableNormalizeTransform::CanTransformColumns() const
+{
+   // the column-wise transformation is available for input variables
+   return IsCreated() && SelectsOnlyVariables();
+}
+
+//_______________________________________________________________________
+void TMVA::VariableNormalizeTransform::TransformColumns( Float_t* values, UInt_t nEvents, Int_t cls ) const
+{
+   // apply the normalization to a set of events stored column-wise
+   // (identical to Transform, one variable after the other)
+
+   if (cls < 0 || cls >= (int) fMin.size()) cls = fMin.size()-1;
+
+   const FloatVector& minVector = fMin.at(cls); 
+   const FloatVector& maxVector = fMax.at(cls);
+
+   UInt_t iidx = 0;
+   for (ItVarTypeIdxConst itGet = fGet.begin(), itGetEnd = fGet.end(); itGet != itGetEnd; ++itGet, ++iidx) {
+      Float_t offset = minVector.at(iidx);
+      Float_t scale  = 1.0/(maxVector.at(iidx)-offset);
+
+      Float_t* column = values + (*itGet).second*nEvents;
+      for (UInt_t ievt=0; ievt<nEvents; ievt++) column[ievt] = (column[ievt]-offset)*scale * 2 - 1;
+   }
+}
+
 //_______________________________________________________________________
 const TMVA::Event* TMVA::VariableNormalizeTransform::InverseTransform(const TMVA::Event* const ev, Int_t cls ) const
 {
@@ -157,6 +157,46 @@ const TMVA::Event* TMVA::VariablePCATransform::Transform( const Event* const ev,
    return fTransformedEvent;
 }
 
+//_______________________________________________________________________
+Bool_t TMVA::VariablePCATransform::CanTransformColumns() const
+{
+   // the column-wise transformation is available for input variables
+   return IsCreated() && SelectsOnlyVariables();
+}
+
+//_______________________________________________________________________
+void TMVA::VariablePCATransform::TransformColumns( Float_t* values, UInt_t nEvents, Int_t cls ) const
+{
+   // calculate the principal components of a set of events stored
+   // column-wise, for all events at once (summing in the same order as X2P)
+
+   if (cls < 0 || cls >= (int) fMeanValues.size()) cls = fMeanValues.size()-1;
+
+   const TVectorD& means        = *fMeanValues.at(cls);
+   const TMatrixD& eigenVectors = *fEigenVectors.at(cls);
+
+   const UInt_t nInput = fGet.size();
+   std::vector<Float_t*> columns( nInput );
+   for (UInt_t i=0; i<nInput; i++) columns[i] = values + fGet[i].second*nEvents;
+
+   std::vector<Float_t>  output( nInput*nEvents );
+   std::vector<Double_t> pv( nEvents );
+   for (UInt_t i=0; i<nInput; i++) {
+      pv.assign( nEvents, 0 );
+      for (UInt_t j=0; j<nInput; j++) {
+         const Double_t mean = means(j);
+         const Double_t ev   = eigenVectors(j,i);
+         const Float_t* x    = columns[j];
+         for (UInt_t ievt=0; ievt<nEvents; ievt++) pv[ievt] += (((Double_t)x[ievt]) - mean) * ev;
+      }
+      std::copy( pv.begin(), pv.end(), output.begin()+i*nEvents );
+   }
+
+   for (UInt_t i=0; i<nInput; i++) {
+      std::copy( output.begin()+i*nEvents, output.begin()+(i+1)*nEvents, columns[i] );
+   }
+}
+
 //_______________________________________________________________________
 const TMVA::Event* TMVA::VariablePCATransform::InverseTransform( const Event* const ev, Int_t cls ) const
 {
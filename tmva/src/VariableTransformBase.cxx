@@ -411,6 +411,19 @@ void TMVA::VariableTransformBase::SetOutput( Event* event, std::vector<Float_t>&
 }
 
 
+//_______________________________________________________________________
+Bool_t TMVA::VariableTransformBase::SelectsOnlyVariables() const
+{
+   // true if the transformation takes only input variables and puts the
+   // results back into the same variables, which is required for the
+   // column-wise transformation
+   if (!fPut.empty() && fPut != fGet) return kFALSE;
+   for (ItVarTypeIdxConst itEntry = fGet.begin(), itEntryEnd = fGet.end(); itEntry != itEntryEnd; ++itEntry) {
+      if ((*itEntry).first != 'v') return kFALSE;
+   }
+   return kTRUE;
+}
+
 //_______________________________________________________________________
 void TMVA::VariableTransformBase::CountVariableTypes( UInt_t& nvars, UInt_t& ntgts, UInt_t& nspcts ) const
 {